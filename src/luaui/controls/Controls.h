@@ -45,6 +45,7 @@
 
 // Shapes
 #include "Shapes.h"
+#include "DrawingHost.h"
 
 // Image
 #include "Image.h"
@@ -9,6 +9,8 @@
 #include "../utils/StringUtils.h"
 #include "Theme.h"
 #include "ThemeKeys.h"
+#include <algorithm>
+#include <cmath>
 
 namespace luaui {
 namespace controls {
@@ -150,6 +152,13 @@ void DataGridCell::UpdateVisualState() {
     }
 }
 
+void DataGridCell::SetIsHovered(bool hovered) {
+    if (m_isHovered != hovered) {
+        m_isHovered = hovered;
+        UpdateVisualState();
+    }
+}
+
 void DataGridCell::OnMouseEnter() {
     m_isHovered = true;
     UpdateVisualState();
@@ -653,23 +662,34 @@ void DataGrid::OnRenderChildren(rendering::IRenderContext* context) {
     float rowStartY = m_headerHeight;
     float contentHeight = rect.height - m_headerHeight;
     
-    for (size_t i = 0; i < m_rows.size(); ++i) {
-        float rowY = rowStartY + i * m_rowHeight - m_scrollOffsetY;
-        
-        // 可见性测试
-        if (rowY + m_rowHeight < rowStartY || rowY > rowStartY + contentHeight) {
-            continue;
+    // 可见行范围（与视口相交的行）
+    size_t firstRow = 0;
+    size_t endRow = m_rows.size();
+    if (m_rowHeight > 0) {
+        float first = std::ceil(m_scrollOffsetY / m_rowHeight - 1.0f);
+        float last = std::floor((m_scrollOffsetY + contentHeight) / m_rowHeight);
+        firstRow = static_cast<size_t>((std::max)(first, 0.0f));
+        endRow = (std::min)(endRow, static_cast<size_t>((std::max)(last + 1.0f, 0.0f)));
+    }
+    
+    // 交替行背景：行之间互不重叠，先一次批量填充再绘制单元格
+    if (m_alternatingRowBackground) {
+        std::vector<rendering::Rect> altRows;
+        for (size_t i = firstRow | 1; i < endRow; i += 2) {
+            float rowY = rowStartY + i * m_rowHeight - m_scrollOffsetY;
+            altRows.emplace_back(1.0f, rowY, rect.width - 2, m_rowHeight);
         }
-        
-        // 绘制交替行背景
-        if (m_alternatingRowBackground && i % 2 == 1) {
+        if (!altRows.empty()) {
             auto altBrush = context->CreateSolidColorBrush(m_alternatingRowBgColor);
             if (altBrush) {
-                context->FillRectangle(
-                    rendering::Rect(1, rowY, rect.width - 2, m_rowHeight),
-                    altBrush.get());
+                context->FillRectangles(altRows.data(), altRows.size(), altBrush.get());
             }
         }
+    }
+    
+    std::vector<rendering::Point> gridLines;
+    for (size_t i = firstRow; i < endRow; ++i) {
+        float rowY = rowStartY + i * m_rowHeight - m_scrollOffsetY;
         
         // 渲染单元格
         for (size_t j = 0; j < m_rows[i]->GetCellCount(); ++j) {
@@ -680,28 +700,25 @@ void DataGrid::OnRenderChildren(rendering::IRenderContext* context) {
             }
         }
         
-        // 绘制行分隔线
-        auto lineBrush = context->CreateSolidColorBrush(m_gridLineColor);
-        if (lineBrush) {
-            context->DrawLine(rendering::Point(0, rowY + m_rowHeight),
-                              rendering::Point(rect.width, rowY + m_rowHeight),
-                              lineBrush.get(), 1.0f);
+        // 行分隔线（收集后与列分隔线一次批量绘制）
+        gridLines.emplace_back(0.0f, rowY + m_rowHeight);
+        gridLines.emplace_back(rect.width, rowY + m_rowHeight);
+    }
+    
+    // 列分隔线
+    float x = -m_scrollOffsetX;
+    for (size_t i = 0; i < m_columns.size(); ++i) {
+        x += m_columns[i]->GetActualWidth();
+        if (x > 0 && x < rect.width) {
+            gridLines.emplace_back(x, m_headerHeight);
+            gridLines.emplace_back(x, rect.height);
         }
     }
     
-    // 绘制列分隔线
-    if (!m_columns.empty()) {
+    if (!gridLines.empty()) {
         auto lineBrush = context->CreateSolidColorBrush(m_gridLineColor);
         if (lineBrush) {
-            float x = -m_scrollOffsetX;
-            for (size_t i = 0; i < m_columns.size(); ++i) {
-                x += m_columns[i]->GetActualWidth();
-                if (x > 0 && x < rect.width) {
-                    context->DrawLine(rendering::Point(x, m_headerHeight),
-                                      rendering::Point(x, rect.height),
-                                      lineBrush.get(), 1.0f);
-                }
-            }
+            context->DrawLines(gridLines.data(), gridLines.size() / 2, lineBrush.get(), 1.0f);
         }
     }
 
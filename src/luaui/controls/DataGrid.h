@@ -120,7 +120,7 @@ public:
     luaui::Delegate<DataGridCell*, const std::wstring&, bool> EditCommitted;
     
     // Hover state (for internal use)
-    void SetIsHovered(bool hovered) { m_isHovered = hovered; }
+    void SetIsHovered(bool hovered);
 
 protected:
     void InitializeComponents() override;
@@ -0,0 +1,79 @@
+#include "DrawingHost.h"
+#include "Components/LayoutComponent.h"
+#include "Components/RenderComponent.h"
+#include "IRenderContext.h"
+#include <algorithm>
+
+namespace luaui {
+namespace controls {
+
+DrawingHost::DrawingHost() {
+    m_drawing.SetChangedHandler([this](const rendering::Rect& damage) {
+        OnDrawingChanged(damage);
+    });
+}
+
+void DrawingHost::InitializeComponents() {
+    GetComponents().AddComponent<components::LayoutComponent>(this);
+    GetComponents().AddComponent<components::RenderComponent>(this);
+
+    // 图元自带空间索引、按裁剪区域绘制，录制显示列表只会重复一遍全部图元
+    if (auto* render = GetRender()) {
+        render->SetRenderCacheEnabled(false);
+    }
+}
+
+rendering::Size DrawingHost::OnMeasure(const rendering::Size& availableSize) {
+    (void)availableSize;
+    m_measuredContent = GetContentExtent();
+
+    rendering::Size size = m_measuredContent;
+    if (auto* layout = GetLayout()) {
+        if (layout->GetWidth() > 0) size.width = layout->GetWidth();
+        if (layout->GetHeight() > 0) size.height = layout->GetHeight();
+    }
+    return size;
+}
+
+void DrawingHost::OnRender(rendering::IRenderContext* context) {
+    if (!context) return;
+
+    auto* render = GetRender();
+    if (!render) return;
+
+    // 只绘制控件范围内、且在本次裁剪区域（脏矩形、滚动视口）内的图元
+    rendering::Rect localRect(0, 0, render->GetRenderRect().width, render->GetRenderRect().height);
+    m_lastStats = m_drawing.Render(context, context->GetClipBounds().Intersect(localRect));
+}
+
+rendering::DrawingGroup::PrimitiveId DrawingHost::HitTestPrimitive(const rendering::Point& localPoint) {
+    return m_drawing.HitTest(localPoint);
+}
+
+rendering::Size DrawingHost::GetContentExtent() const {
+    // 从本地原点到图元最右、最下边缘的范围
+    rendering::Rect content = m_drawing.GetContentBounds();
+    return rendering::Size((std::max)(content.Right(), 0.0f), (std::max)(content.Bottom(), 0.0f));
+}
+
+void DrawingHost::OnDrawingChanged(const rendering::Rect& damage) {
+    // 内容范围与上次测量不同（增长、缩小或图元被移除）时重新测量；显式设置了尺寸的方向不受影响
+    if (auto* layout = GetLayout()) {
+        bool autoWidth = layout->GetWidth() <= 0;
+        bool autoHeight = layout->GetHeight() <= 0;
+        if (autoWidth || autoHeight) {
+            rendering::Size content = GetContentExtent();
+            if ((autoWidth && content.width != m_measuredContent.width) ||
+                (autoHeight && content.height != m_measuredContent.height)) {
+                layout->InvalidateMeasure();
+            }
+        }
+    }
+
+    if (auto* render = GetRender()) {
+        render->InvalidateRegion(damage);
+    }
+}
+
+} // namespace controls
+} // namespace luaui
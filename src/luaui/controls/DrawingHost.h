@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Control.h"
+#include "../core/Components/LayoutComponent.h"
+#include "../core/Components/RenderComponent.h"
+#include "../rendering/DrawingGroup.h"
+#include <string>
+
+namespace luaui {
+namespace controls {
+
+/**
+ * @brief DrawingHost 图元宿主控件
+ *
+ * 一个控件承载一个 DrawingGroup：图表、示意图中的成千上万个矩形、直线、文本和位图
+ * 都是宿主内的图元，而不是各自独立的 Rectangle/Ellipse 控件。
+ *
+ * - 图元坐标为宿主的本地坐标，绘制时只绘制与当前裁剪区域（脏矩形、滚动视口）相交的部分
+ * - 图元变化只把受影响的区域报告给窗口重绘；批量修改使用 DrawingGroup 的数组接口或 UpdateScope
+ * - 未设置 Width/Height 时按图元内容范围测量
+ *
+ * 使用示例：
+ *   auto host = std::make_shared<DrawingHost>();
+ *   auto& drawing = host->GetDrawing();
+ *   auto bar = drawing.AddFillStyle(rendering::Color::Blue());
+ *   drawing.AddRectangles(rects.data(), rects.size(), bar, ids.data());
+ *   ...
+ *   drawing.Offset(ids.data(), ids.size(), 0, -4);   // 一次通知，一次局部重绘
+ */
+class DrawingHost : public luaui::Control {
+public:
+    DrawingHost();
+
+    std::string GetTypeName() const override { return "DrawingHost"; }
+
+    rendering::DrawingGroup& GetDrawing() { return m_drawing; }
+    const rendering::DrawingGroup& GetDrawing() const { return m_drawing; }
+
+    /**
+     * @brief 查找本地坐标处的最上层图元，未命中返回 DrawingGroup::kInvalidId
+     */
+    rendering::DrawingGroup::PrimitiveId HitTestPrimitive(const rendering::Point& localPoint);
+
+    /**
+     * @brief 上一次绘制的统计（绘制、裁剪掉的图元数和绘制调用数）
+     */
+    const rendering::DrawingGroup::RenderStats& GetLastRenderStats() const { return m_lastStats; }
+
+protected:
+    void InitializeComponents() override;
+    rendering::Size OnMeasure(const rendering::Size& availableSize) override;
+    void OnRender(rendering::IRenderContext* context) override;
+
+private:
+    void OnDrawingChanged(const rendering::Rect& damage);
+    rendering::Size GetContentExtent() const;
+
+    rendering::DrawingGroup m_drawing;
+    rendering::DrawingGroup::RenderStats m_lastStats;
+    rendering::Size m_measuredContent;   // 上次按内容测量的尺寸
+};
+
+} // namespace controls
+} // namespace luaui
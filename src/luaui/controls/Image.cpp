@@ -53,17 +53,12 @@ void Image::SetSourcePath(const std::wstring& path) {
     if (m_sourcePath != path) {
         m_sourcePath = path;
         // 路径改变时重新加载
+        // LoadFromFile/Unload 负责重新测量和重绘
         if (!path.empty()) {
             LoadFromFile(path);
         } else {
             Unload();
         }
-        if (auto* layout = GetLayout()) {
-            layout->InvalidateMeasure();
-        }
-        if (auto* render = GetRender()) {
-            render->Invalidate();
-        }
     }
 }
 
@@ -73,19 +68,36 @@ bool Image::LoadFromFile(const std::wstring& filePath) {
     m_isLoaded = false;
     m_loadFailed = false;
     m_bitmap.reset();
+    m_handle.reset();
+    m_pending.reset();
     
     utils::Logger::InfoF("[Image] Set source path: %s", 
         WToUtf8(filePath).c_str());
     
+    // 旧位图已丢弃：重新测量，并让缓存的显示列表失效以便下次渲染发起加载
+    if (auto* layout = GetLayout()) {
+        layout->InvalidateMeasure();
+    }
+    if (auto* render = GetRender()) {
+        render->Invalidate();
+    }
     return true;
 }
 
 void Image::Unload() {
     m_bitmap.reset();
+    m_handle.reset();
+    m_pending.reset();
     m_isLoaded = false;
     m_loadFailed = false;
     m_naturalWidth = 0;
     m_naturalHeight = 0;
+    if (auto* layout = GetLayout()) {
+        layout->InvalidateMeasure();
+    }
+    if (auto* render = GetRender()) {
+        render->Invalidate();
+    }
 }
 
 void Image::UpdateNaturalSize() {
@@ -138,22 +150,11 @@ void Image::OnRender(rendering::IRenderContext* context) {
     
     auto rect = render->GetRenderRect();
     
-    // 尝试加载位图（如果尚未加载）
-    if (!m_isLoaded && !m_loadFailed && !m_sourcePath.empty()) {
-        m_bitmap = context->LoadBitmapFromFile(m_sourcePath);
-        if (m_bitmap) {
-            m_isLoaded = true;
-            UpdateNaturalSize();
-            // 加载成功后重新测量布局
-            if (auto* layout = GetLayout()) {
-                layout->InvalidateMeasure();
-            }
-            utils::Logger::InfoF("[Image] Loaded successfully: %dx%d", 
-                m_bitmap->GetWidth(), m_bitmap->GetHeight());
-        } else {
-            m_loadFailed = true;
-            utils::Logger::WarningF("[Image] Failed to load: %s", 
-                WToUtf8(m_sourcePath).c_str());
+    if (!m_loadFailed && !m_sourcePath.empty()) {
+        if (rendering::BitmapService::Instance().HasDecoder()) {
+            RequestBitmap(context, rect);
+        } else if (!m_isLoaded) {
+            LoadSynchronously(context);
         }
     }
     
@@ -165,6 +166,91 @@ void Image::OnRender(rendering::IRenderContext* context) {
     }
 }
 
+void Image::RequestBitmap(rendering::IRenderContext* context, const rendering::Rect& rect) {
+    // 解码完成（回调之前可能已经被其他控件触发）
+    if (m_pending && m_pending->GetState() != rendering::BitmapEntry::State::Pending) {
+        OnBitmapReady(context);
+    }
+    
+    // Stretch::None 按原尺寸显示，需要完整解码；其余按显示尺寸分档
+    float width = m_stretch == Stretch::None ? 0.0f : rect.width;
+    float height = m_stretch == Stretch::None ? 0.0f : rect.height;
+    if (m_stretch != Stretch::None && (width <= 0 || height <= 0)) return;
+    
+    int wanted = rendering::BitmapService::GetDecodeSize(width, height);
+    auto covers = [wanted](const rendering::BitmapHandle& handle) {
+        int size = handle->GetDecodeSize();
+        return size == 0 || (wanted != 0 && size >= wanted);
+    };
+    
+    // 只向更大的档位升级，缩小时继续使用已解码的位图
+    if (m_handle && covers(m_handle)) return;
+    if (m_pending && covers(m_pending)) return;
+    
+    std::weak_ptr<int> token = m_token;
+    m_pending = rendering::BitmapService::Instance().Request(m_sourcePath, width, height, [this, token]() {
+        if (token.expired()) return;
+        if (auto* render = GetRender()) {
+            render->Invalidate();
+        }
+    });
+    if (m_pending && m_pending->GetState() != rendering::BitmapEntry::State::Pending) {
+        OnBitmapReady(context);
+    }
+}
+
+void Image::OnBitmapReady(rendering::IRenderContext* context) {
+    rendering::BitmapHandle handle = std::move(m_pending);
+    m_pending = nullptr;
+    
+    if (handle->IsFailed()) {
+        // 已有较小档位的位图时继续显示
+        if (!m_handle) {
+            m_loadFailed = true;
+            utils::Logger::WarningF("[Image] Failed to load: %s", 
+                WToUtf8(m_sourcePath).c_str());
+        }
+        return;
+    }
+    
+    auto bitmap = handle->GetBitmap(context);
+    if (!bitmap) return;
+    
+    m_handle = std::move(handle);
+    m_bitmap = std::move(bitmap);
+    m_isLoaded = true;
+    
+    // 自然尺寸取原图尺寸，与解码档位无关
+    float naturalWidth = static_cast<float>(m_handle->GetSourceWidth());
+    float naturalHeight = static_cast<float>(m_handle->GetSourceHeight());
+    if (naturalWidth != m_naturalWidth || naturalHeight != m_naturalHeight) {
+        m_naturalWidth = naturalWidth;
+        m_naturalHeight = naturalHeight;
+        if (auto* layout = GetLayout()) {
+            layout->InvalidateMeasure();
+        }
+    }
+}
+
+void Image::LoadSynchronously(rendering::IRenderContext* context) {
+    // 未安装解码器（自定义渲染引擎）时在渲染线程直接加载
+    m_bitmap = context->LoadBitmapFromFile(m_sourcePath);
+    if (m_bitmap) {
+        m_isLoaded = true;
+        UpdateNaturalSize();
+        // 加载成功后重新测量布局
+        if (auto* layout = GetLayout()) {
+            layout->InvalidateMeasure();
+        }
+        utils::Logger::InfoF("[Image] Loaded successfully: %dx%d", 
+            m_bitmap->GetWidth(), m_bitmap->GetHeight());
+    } else {
+        m_loadFailed = true;
+        utils::Logger::WarningF("[Image] Failed to load: %s", 
+            WToUtf8(m_sourcePath).c_str());
+    }
+}
+
 void Image::DrawBitmap(rendering::IRenderContext* context, const rendering::Rect& rect) {
     if (!m_bitmap) return;
     
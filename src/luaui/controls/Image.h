@@ -5,6 +5,8 @@
 #include "../core/Components/RenderComponent.h"
 #include "../rendering/Types.h"
 #include "../rendering/IBitmap.h"
+#include "../rendering/BitmapService.h"
+#include <memory>
 #include <string>
 
 namespace luaui {
@@ -23,7 +25,8 @@ enum class Stretch {
 /**
  * @brief Image 图像控件（新架构）
  * 
- * 支持从文件加载并渲染图像
+ * 支持从文件加载并渲染图像。图像通过 BitmapService 在后台线程解码，
+ * 解码尺寸按控件显示尺寸选择；解码完成前显示占位符。
  */
 class Image : public luaui::Control {
 public:
@@ -61,6 +64,9 @@ private:
     void DrawPlaceholder(rendering::IRenderContext* context, const rendering::Rect& rect);
     void DrawBitmap(rendering::IRenderContext* context, const rendering::Rect& rect);
     void UpdateNaturalSize();
+    void RequestBitmap(rendering::IRenderContext* context, const rendering::Rect& rect);
+    void OnBitmapReady(rendering::IRenderContext* context);
+    void LoadSynchronously(rendering::IRenderContext* context);
     
     std::wstring m_sourcePath;
     Stretch m_stretch = Stretch::Uniform;
@@ -73,6 +79,11 @@ private:
     // 缓存的位图
     rendering::IBitmapPtr m_bitmap;
     
+    // 异步解码：当前显示的条目和正在解码的（更大档位的）条目
+    rendering::BitmapHandle m_handle;
+    rendering::BitmapHandle m_pending;
+    std::shared_ptr<int> m_token = std::make_shared<int>(0);   // 完成回调检查控件是否仍存活
+    
     // 占位符颜色
     rendering::Color m_placeholderColor = rendering::Color::FromHex(0xE0E0E0);
     rendering::Color m_borderColor = rendering::Color::FromHex(0xAAAAAA);
@@ -279,6 +279,10 @@ void Menu::ApplyTheme() {
 void Menu::InitializeComponents() {
     GetComponents().AddComponent<components::LayoutComponent>(this);
     GetComponents().AddComponent<components::RenderComponent>(this);
+    // 右下角阴影画在渲染矩形之外
+    if (auto* render = GetRender()) {
+        render->SetInkOverflow(rendering::Thickness(0, 0, m_shadowOffset, m_shadowOffset));
+    }
     GetComponents().AddComponent<components::InputComponent>(this);
     
     SetIsVisible(false);
@@ -1047,6 +1051,7 @@ void MenuBar::DrawWindowButtons(rendering::IRenderContext* context, const render
 }
 
 void MenuBar::ExecuteWindowButton(WindowButton btn) {
+#ifdef _WIN32
     auto* wnd = GetWindow();
     if (!wnd) return;
     
@@ -1070,6 +1075,9 @@ void MenuBar::ExecuteWindowButton(WindowButton btn) {
         default:
             break;
     }
+#else
+    (void)btn;   // 离屏窗口没有系统窗口按钮
+#endif
 }
 
 bool MenuBar::IsBlankArea(float x, float y, const rendering::Rect& barRect) const {
@@ -1252,9 +1260,13 @@ void MenuBar::OnKeyDown(KeyEventArgs& args) {
 ContextMenu::ContextMenu() {}
 
 void ContextMenu::ShowAtMouse() {
+#ifdef _WIN32
     POINT pt;
     GetCursorPos(&pt);
     OpenAt(static_cast<float>(pt.x), static_cast<float>(pt.y));
+#else
+    OpenAt(0, 0);   // 离屏窗口没有系统光标
+#endif
 }
 
 void ContextMenu::ShowRelativeTo(Control* control, float offsetX, float offsetY) {
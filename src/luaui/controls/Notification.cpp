@@ -16,6 +16,9 @@ ToastNotification::ToastNotification() {}
 void ToastNotification::InitializeComponents() {
     GetComponents().AddComponent<components::LayoutComponent>(this);
     GetComponents().AddComponent<components::RenderComponent>(this);
+    if (auto* render = GetRender()) {
+        render->SetInkOverflow(rendering::Thickness(0, 0, m_shadowOffset, m_shadowOffset));
+    }
     
     // 默认隐藏
     SetIsVisible(false);
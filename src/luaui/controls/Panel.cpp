@@ -1,7 +1,10 @@
 #include "Panel.h"
 #include "Interfaces/IControl.h"
 #include "IRenderContext.h"
+#include "IRenderEngine.h"
+#include "Window.h"
 #include "Logger.h"
+#include <cmath>
 
 namespace luaui {
 namespace controls {
@@ -18,7 +21,7 @@ void Panel::InitializeComponents() {
     Control::InitializeComponents();
     
     // 添加 Panel 专用布局组件（会测量和排列子控件）
-    // 注意：GetComponent 使用 typeid 查找，所以 AddComponent 和 GetComponent 必须使用相同类型
+    // 与 LayoutComponent 共用布局槽位，GetLayout() 返回的就是它
     auto* layoutComp = GetComponents().AddComponent<PanelLayoutComponent>(this);
     luaui::utils::Logger::TraceF("[Panel] PanelLayoutComponent added: %s", layoutComp ? "yes" : "no");
     
@@ -77,6 +80,11 @@ rendering::Size PanelLayoutComponent::MeasureOverride(const rendering::Size& ava
 }
 
 rendering::Size PanelLayoutComponent::ArrangeOverride(const rendering::Size& finalSize) {
+    // 子控件可能移动或改变大小，图层内容随之过期
+    if (auto* render = dynamic_cast<PanelRenderComponent*>(m_owner ? m_owner->GetRender() : nullptr)) {
+        render->InvalidateLayer();
+    }
+    
     // 让 Panel 排列其子控件
     if (auto* panel = dynamic_cast<Panel*>(m_owner)) {
         return panel->OnArrangeChildren(finalSize);
@@ -98,6 +106,13 @@ void PanelRenderComponent::RenderOverride(rendering::IRenderContext* context) {
 void PanelRenderComponent::RenderOverride(rendering::IRenderContext* context, const rendering::Rect& localRect) {
     if (!m_owner || !context) return;
     
+    if (ShouldUseLayer(localRect) && RenderWithLayer(context, localRect)) {
+        return;
+    }
+    RenderDirect(context, localRect);
+}
+
+void PanelRenderComponent::RenderDirect(rendering::IRenderContext* context, const rendering::Rect& localRect) {
     // 1. 调用基类渲染（背景和 OnRender）- 使用本地坐标
     RenderComponent::RenderOverride(context, localRect);
     
@@ -107,6 +122,144 @@ void PanelRenderComponent::RenderOverride(rendering::IRenderContext* context, co
     }
 }
 
+namespace {
+
+// 统计后代控件数量，达到 limit 即停止
+size_t CountDescendants(const interfaces::IControl* control, size_t limit) {
+    size_t count = 0;
+    size_t childCount = control->GetChildCount();
+    for (size_t i = 0; i < childCount && count < limit; ++i) {
+        if (auto child = control->GetChild(i)) {
+            count += 1 + CountDescendants(child.get(), limit - count - 1);
+        }
+    }
+    return count;
+}
+
+// 移除前使子控件所占区域变脏，否则窗口只会重绘布局发生变化的兄弟控件
+void InvalidateRemovedChild(const std::shared_ptr<interfaces::IControl>& child) {
+    if (auto* render = static_cast<Control*>(child.get())->GetRender()) {
+        render->Invalidate();
+    }
+}
+
+} // anonymous namespace
+
+bool PanelRenderComponent::ShouldUseLayer(const rendering::Rect& localRect) {
+    if (m_layerMode == LayerCacheMode::None || m_layerFailed) return false;
+    if (localRect.width < 1.0f || localRect.height < 1.0f) return false;
+    
+    if (m_layerMode == LayerCacheMode::Auto && !m_layerBitmap) {
+        // 尚未提升：等待子树稳定若干帧（一帧内按脏矩形多次渲染只计一次）
+        if (m_cleanFrames < kAutoLayerCleanFrames) {
+            uint64_t frame = components::RenderComponent::GetFrameIndex();
+            if (frame != m_lastCountedFrame) {
+                m_lastCountedFrame = frame;
+                ++m_cleanFrames;
+            }
+            return false;
+        }
+        if (localRect.width * localRect.height > kAutoLayerMaxPixels) return false;
+        if (CountDescendants(m_owner, kAutoLayerMinDescendants) < kAutoLayerMinDescendants) return false;
+    }
+    return true;
+}
+
+bool PanelRenderComponent::RenderWithLayer(rendering::IRenderContext* context, const rendering::Rect& localRect) {
+    // 图层按当前缩放光栅化，旋转/斜切/翻转时直接绘制
+    rendering::Transform world = context->GetTransform();
+    const float* m = world.GetElements();
+    if (!world.IsAxisAligned() || m[0] <= 0.0f || m[3] <= 0.0f) return false;
+    
+    float scaleX = m[0];
+    float scaleY = m[3];
+    int pixelWidth = static_cast<int>(std::ceil(localRect.width * scaleX));
+    int pixelHeight = static_cast<int>(std::ceil(localRect.height * scaleY));
+    
+    bool sizeChanged = !m_layerTarget ||
+        m_layerTarget->GetWidth() != pixelWidth || m_layerTarget->GetHeight() != pixelHeight;
+    
+    if (m_layerDirty || !m_layerBitmap || sizeChanged ||
+        scaleX != m_layerScaleX || scaleY != m_layerScaleY) {
+        if (sizeChanged) {
+            auto* window = m_owner->GetWindow();
+            auto* engine = window ? window->GetRenderEngine() : nullptr;
+            if (!engine) return false;
+            
+            m_layerBitmap.reset();
+            m_layerTarget = engine->CreateRenderTarget(pixelWidth, pixelHeight, true);
+            if (!m_layerTarget) {
+                m_layerFailed = true;
+                return false;
+            }
+        }
+        
+        if (!m_layerTarget->BeginDraw()) return false;
+        
+        // 先清除标记：绘制期间发生的 Invalidate 会使图层在下一帧重建
+        m_layerDirty = false;
+        m_layerScaleX = scaleX;
+        m_layerScaleY = scaleY;
+        
+        m_layerTarget->Clear(rendering::Color::Transparent());
+        auto* layerContext = m_layerTarget->GetContext();
+        layerContext->SetTransform(rendering::Transform::Scale(scaleX, scaleY));
+        m_renderingLayer = true;
+        {
+            components::RenderComponent::OffscreenScope offscreen;
+            RenderDirect(layerContext, localRect);
+        }
+        m_renderingLayer = false;
+        
+        bool ok = m_layerTarget->EndDraw();
+        m_layerBitmap = ok ? m_layerTarget->ToBitmap() : nullptr;
+        if (!m_layerBitmap) {
+            // 后端不支持位图导出：以后始终直接绘制
+            m_layerFailed = ok;
+            ReleaseLayer();
+            return false;
+        }
+        utils::Logger::TraceF("[Panel] Layer rasterized: %dx%d", pixelWidth, pixelHeight);
+    }
+    
+    context->DrawBitmap(m_layerBitmap.get(), rendering::Rect(0, 0, localRect.width, localRect.height));
+    return true;
+}
+
+void PanelRenderComponent::SetLayerCacheMode(LayerCacheMode mode) {
+    if (m_layerMode == mode) return;
+    m_layerMode = mode;
+    m_layerFailed = false;
+    m_cleanFrames = 0;
+    ReleaseLayer();
+}
+
+void PanelRenderComponent::InvalidateLayer() {
+    m_layerDirty = true;
+    m_cleanFrames = 0;
+    
+    // Auto 模式下内容开始变化：释放图层，待重新稳定后再提升
+    // （正在向图层绘制时不能释放目标，仅标记过期）
+    if (m_layerMode == LayerCacheMode::Auto && !m_renderingLayer) {
+        ReleaseLayer();
+    }
+}
+
+void PanelRenderComponent::Invalidate() {
+    InvalidateLayer();
+    RenderComponent::Invalidate();
+}
+
+void PanelRenderComponent::OnDescendantInvalidated() {
+    InvalidateLayer();
+}
+
+void PanelRenderComponent::ReleaseLayer() {
+    m_layerBitmap.reset();
+    m_layerTarget.reset();
+    m_layerDirty = true;
+}
+
 std::shared_ptr<interfaces::IControl> Panel::GetChild(size_t index) const {
     if (index < m_children.size()) {
         return m_children[index];
@@ -114,6 +267,19 @@ std::shared_ptr<interfaces::IControl> Panel::GetChild(size_t index) const {
     return nullptr;
 }
 
+void Panel::SetLayerCacheMode(LayerCacheMode mode) {
+    if (auto* render = dynamic_cast<PanelRenderComponent*>(GetRender())) {
+        render->SetLayerCacheMode(mode);
+    }
+}
+
+LayerCacheMode Panel::GetLayerCacheMode() const {
+    if (auto* render = dynamic_cast<PanelRenderComponent*>(const_cast<Panel*>(this)->GetRender())) {
+        return render->GetLayerCacheMode();
+    }
+    return LayerCacheMode::None;
+}
+
 void Panel::AddChild(const std::shared_ptr<IControl>& child) {
     if (!child) return;
     
@@ -138,6 +304,7 @@ void Panel::RemoveChild(const std::shared_ptr<IControl>& child) {
     
     auto it = std::find(m_children.begin(), m_children.end(), child);
     if (it != m_children.end()) {
+        InvalidateRemovedChild(*it);
         (*it)->SetParent(nullptr);
         m_children.erase(it);
         
@@ -149,6 +316,7 @@ void Panel::RemoveChild(const std::shared_ptr<IControl>& child) {
 
 void Panel::RemoveChildAt(size_t index) {
     if (index < m_children.size()) {
+        InvalidateRemovedChild(m_children[index]);
         m_children[index]->SetParent(nullptr);
         m_children.erase(m_children.begin() + index);
         
@@ -160,6 +328,7 @@ void Panel::RemoveChildAt(size_t index) {
 
 void Panel::ClearChildren() {
     for (auto& child : m_children) {
+        InvalidateRemovedChild(child);
         child->SetParent(nullptr);
     }
     m_children.clear();
@@ -181,25 +350,31 @@ void Panel::InsertChild(size_t index, const std::shared_ptr<IControl>& child) {
 }
 
 void Panel::OnRenderChildren(rendering::IRenderContext* context) {
+    if (!context) return;
+    
+    // 裁剪区域外的子控件（滚动出视口、不在本次脏矩形内）整棵子树跳过
+    rendering::Rect clip = context->GetClipBounds();
     
-    // 渲染所有子控件
     for (auto& child : m_children) {
-        if (!child->GetIsVisible()) {
-            // luaui::utils::Logger::Debug("[Panel] OnRenderChildren: Child invisible, skipping");
-            continue;
-        }
-        
-        // 尝试转换为可渲染接口
-        auto* control = static_cast<Control*>(child.get());
-        auto* renderable = control->AsRenderable();
-        
-        luaui::utils::Logger::TraceF("[Panel] OnRenderChildren: Child %s, renderable=%p", 
-            child->GetTypeName().c_str(), (void*)renderable);
-        
-        if (renderable) {
-            renderable->Render(context);
-        }
+        if (!child->GetIsVisible()) continue;
+        RenderChildClipped(context, child.get(), clip);
+    }
+}
+
+void Panel::RenderChildClipped(rendering::IRenderContext* context, interfaces::IControl* child,
+                               const rendering::Rect& clip) {
+    auto* control = static_cast<Control*>(child);
+    auto* render = control->GetRender();
+    if (!render) return;
+    
+    // 子控件矩形与父控件处于同一坐标系，可直接与裁剪区域比较；
+    // 按绘制溢出外扩，只覆盖阴影等溢出部分的脏矩形同样需要绘制该子控件
+    rendering::Rect bounds = render->InflateByInk(render->GetRenderRect());
+    if (clip.IsEmpty() || !bounds.Intersects(clip)) {
+        ++components::RenderComponent::GetFrameCounters().culled;
+        return;
     }
+    render->Render(context);
 }
 
 rendering::Size Panel::OnMeasureChildren(const rendering::Size& availableSize) {
@@ -207,6 +382,24 @@ rendering::Size Panel::OnMeasureChildren(const rendering::Size& availableSize) {
     return availableSize;
 }
 
+std::vector<components::LayoutComponent::ChildMeasure> Panel::MeasureVisibleChildren(
+    const rendering::Size& availableSize) {
+    std::vector<components::LayoutComponent::ChildMeasure> batch;
+    batch.reserve(m_children.size());
+    for (auto& child : m_children) {
+        if (!child || !child->GetIsVisible()) continue;
+        // 在调用线程上取布局组件，保证子控件已初始化
+        if (auto* layoutable = child->AsLayoutable()) {
+            components::LayoutComponent::ChildMeasure item;
+            item.layout = layoutable;
+            item.constraint.available = availableSize;
+            batch.push_back(item);
+        }
+    }
+    components::LayoutComponent::MeasureChildren(batch);
+    return batch;
+}
+
 rendering::Size Panel::OnArrangeChildren(const rendering::Size& finalSize) {
     // 默认实现：排列所有子控件为相同大小
     for (auto& child : m_children) {
@@ -5,6 +5,7 @@
 #include "../core/Components/LayoutComponent.h"
 #include "../core/Components/RenderComponent.h"
 #include "../rendering/Types.h"
+#include "../rendering/IRenderTarget.h"
 #include <vector>
 #include <string>
 #include <memory>
@@ -27,16 +28,73 @@ protected:
     rendering::Size ArrangeOverride(const rendering::Size& finalSize) override;
 };
 
+/**
+ * @brief 图层缓存模式
+ *
+ * - None:   不缓存，每帧绘制整个子树
+ * - Always: 始终将子树光栅化到离屏图层，之后以一次 DrawBitmap 合成
+ * - Auto:   子树连续多帧未变化且足够复杂时自动提升为图层，变化后自动降级
+ */
+enum class LayerCacheMode {
+    None,
+    Always,
+    Auto
+};
+
 /**
  * @brief Panel 专用渲染组件 - 会渲染子控件
+ *
+ * 支持"缓存为图层"：整个子树（背景、OnRender 和所有子控件）绘制到离屏
+ * 渲染目标，子树内任一控件 Invalidate 或重新排列之前，后续帧只合成该位图。
  */
 class PanelRenderComponent : public components::RenderComponent {
 public:
     explicit PanelRenderComponent(luaui::Control* owner) : RenderComponent(owner) {}
     
+    // ========== 图层缓存 ==========
+    void SetLayerCacheMode(LayerCacheMode mode);
+    LayerCacheMode GetLayerCacheMode() const { return m_layerMode; }
+    
+    /**
+     * @brief 当前是否持有有效的图层位图（下一帧可直接合成）
+     */
+    bool HasValidLayer() const { return m_layerBitmap && !m_layerDirty; }
+    
+    /**
+     * @brief 使图层失效，下一帧重新光栅化子树
+     */
+    void InvalidateLayer();
+    
+    void Invalidate() override;
+    void OnDescendantInvalidated() override;
+    
+    // Auto 模式：连续多少帧未变化后提升为图层
+    static constexpr int kAutoLayerCleanFrames = 3;
+    // Auto 模式：子树至少包含多少个后代控件才值得缓存
+    static constexpr size_t kAutoLayerMinDescendants = 8;
+    // Auto 模式：单个图层的最大像素数（约 16MB BGRA）
+    static constexpr float kAutoLayerMaxPixels = 4096.0f * 1024.0f;
+    
 protected:
     void RenderOverride(rendering::IRenderContext* context) override;
     void RenderOverride(rendering::IRenderContext* context, const rendering::Rect& localRect) override;
+    
+private:
+    void RenderDirect(rendering::IRenderContext* context, const rendering::Rect& localRect);
+    bool ShouldUseLayer(const rendering::Rect& localRect);
+    bool RenderWithLayer(rendering::IRenderContext* context, const rendering::Rect& localRect);
+    void ReleaseLayer();
+    
+    LayerCacheMode m_layerMode = LayerCacheMode::None;
+    std::unique_ptr<rendering::IRenderTarget> m_layerTarget;
+    rendering::IBitmapPtr m_layerBitmap;
+    float m_layerScaleX = 1.0f;
+    float m_layerScaleY = 1.0f;
+    bool m_layerDirty = true;
+    bool m_layerFailed = false;   // 渲染引擎不支持离屏目标或位图导出
+    bool m_renderingLayer = false;
+    int m_cleanFrames = 0;        // Auto 模式：连续未变化的帧数
+    uint64_t m_lastCountedFrame = 0;  // 最近一次计入 m_cleanFrames 的帧序号
 };
 
 /**
@@ -61,12 +119,29 @@ public:
     virtual void ClearChildren();
     void InsertChild(size_t index, const std::shared_ptr<interfaces::IControl>& child);
 
+    // 图层缓存
+    /**
+     * @brief 设置子树的图层缓存模式（见 LayerCacheMode）
+     *
+     * 适用于内容很少变化但绘制开销较大的子树，如侧边栏、工具栏和静态表单。
+     * 图层按当前缩放光栅化；存在旋转/斜切变换时自动退回直接绘制。
+     */
+    void SetLayerCacheMode(LayerCacheMode mode);
+    LayerCacheMode GetLayerCacheMode() const;
+
 protected:
     void InitializeComponents() override;
     
     // 渲染子控件 - PanelRenderComponent 会调用此方法
     virtual void OnRenderChildren(rendering::IRenderContext* context);
     
+    /**
+     * @brief 渲染单个子控件，与当前裁剪区域不相交时跳过（计入本帧剔除数）
+     * @param clip 当前裁剪区域（本控件坐标系，见 IRenderContext::GetClipBounds）
+     */
+    static void RenderChildClipped(rendering::IRenderContext* context, interfaces::IControl* child,
+                                   const rendering::Rect& clip);
+    
     // 友元 - 组件需要调用 protected 方法
     friend class PanelLayoutComponent;
     friend class PanelRenderComponent;
@@ -77,6 +152,14 @@ protected:
     virtual rendering::Size OnArrangeChildren(const rendering::Size& finalSize);
 
 protected:
+    /**
+     * @brief 以相同的可用尺寸测量所有可见子控件
+     *
+     * 各子控件的约束互不依赖，并行布局启用时并发测量（见 LayoutComponent::MeasureChildren）。
+     * @return 按子控件顺序排列的测量结果
+     */
+    std::vector<components::LayoutComponent::ChildMeasure> MeasureVisibleChildren(const rendering::Size& availableSize);
+
     std::vector<std::shared_ptr<interfaces::IControl>> m_children;
 };
 
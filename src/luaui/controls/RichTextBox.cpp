@@ -4,6 +4,7 @@
 #include "Components/InputComponent.h"
 #include "Interfaces/IRenderable.h"
 #include "IRenderContext.h"
+#include "TextLayoutCache.h"
 #include <Windows.h>
 
 namespace luaui {
@@ -650,8 +651,12 @@ void RichTextBox::OnRender(rendering::IRenderContext* context) {
                                                 textPos, textBrush.get());
                     }
                     
-                    // 估算宽度前进
-                    x += static_cast<float>(text.length()) * fontSize * 0.6f;
+                    // 按实际宽度前进（重复的文本段命中共享测量缓存）
+                    if (textFormat) {
+                        x += rendering::TextLayoutCache::Instance().Measure(textFormat.get(), text).width;
+                    } else {
+                        x += static_cast<float>(text.length()) * fontSize * 0.6f;
+                    }
                 }
             }
             
@@ -3,6 +3,7 @@
 #include "ITextFormat.h"
 #include "ITextLayout.h"
 #include "ResourceCache.h"
+#include "TextLayoutCache.h"
 #include "Window.h"
 #include "Theme.h"
 #include "ThemeKeys.h"
@@ -120,6 +121,13 @@ void TextBlock::OnRender(rendering::IRenderContext* context) {
         // 使用缓存（高性能路径）
         format = cache->GetTextFormat(L"Microsoft YaHei", m_fontSize);
         brush = cache->GetSolidColorBrush(m_foreground);
+        
+        // 上次测量时还没有资源缓存，尺寸只是估算：下一帧按实际字体重新测量
+        if (format && m_textDirty) {
+            if (auto* layout = GetLayout()) {
+                layout->InvalidateMeasure();
+            }
+        }
     } else {
         // 回退：直接创建（低性能，仅用于测试或特殊场景）
         // 注意：这种方式每帧都会创建资源，应避免在生产环境使用
@@ -158,8 +166,22 @@ rendering::Size TextBlock::OnMeasure(const rendering::Size& availableSize) {
         return m_textSize;
     }
     
+    // 窗口资源缓存可用时按实际字体测量（相同文本命中共享测量缓存）
+    if (!m_text.empty()) {
+        if (auto* window = GetWindow()) {
+            if (auto* cache = window->GetResourceCache()) {
+                if (auto* format = cache->GetTextFormat(L"Microsoft YaHei", m_fontSize)) {
+                    m_textSize = rendering::TextLayoutCache::Instance().Measure(format, m_text);
+                    m_textDirty = false;
+                    return m_textSize;
+                }
+            }
+        }
+    }
+    
     // 简化测量：基于字符数估算（中文约1em宽，英文约0.5em宽）
-    // 实际项目应使用文本布局引擎，但这需要访问渲染上下文
+    // 窗口资源缓存尚不可用（未挂到窗口上）时使用；m_textDirty 保持为 true，
+    // 挂到窗口后首次绘制会使测量失效，改用实际字体测量
     float lineHeight = m_fontSize * 1.2f;
     size_t lineCount = 1;
     float maxWidth = 0;
@@ -188,7 +210,7 @@ rendering::Size TextBlock::OnMeasure(const rendering::Size& availableSize) {
     
     m_textSize.width = maxWidth;
     m_textSize.height = static_cast<float>(lineCount) * lineHeight;
-    m_textDirty = false;
+    m_textDirty = !m_text.empty();
     
     return m_textSize;
 }
@@ -2,14 +2,18 @@
 #include "IRenderContext.h"
 #include "ITextFormat.h"
 #include "ResourceCache.h"
+#include "TextLayoutCache.h"
 #include "Window.h"
 #include "Theme.h"
 #include "ThemeKeys.h"
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <cwctype>
 #include <utility>
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
 namespace luaui {
 namespace controls {
@@ -54,6 +58,11 @@ rendering::ISolidColorBrush* AcquireBrush(const TextBox* textBox,
     return owned.get();
 }
 
+uint64_t NowMs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
 } // namespace
 
 TextBox::TextBox() = default;
@@ -325,7 +334,7 @@ void TextBox::OnRender(rendering::IRenderContext* context) {
 
     const std::wstring displayText = GetDisplayText();
     const float lineHeight = format
-        ? std::max(m_fontSize * 1.2f, format->MeasureText(L"Ag", 0.0f).height)
+        ? std::max(m_fontSize * 1.2f, rendering::TextLayoutCache::Instance().Measure(format, L"Ag").height)
         : m_fontSize * 1.2f;
     const float textY = contentRect.y + std::max(0.0f, (contentRect.height - lineHeight) / 2.0f);
     const float textX = contentRect.x + m_padding - m_horizontalScrollOffset;
@@ -759,12 +768,12 @@ float TextBox::MeasureTextWidth(const std::wstring& text, rendering::ITextFormat
     }
 
     if (format) {
-        return format->MeasureText(text, 0.0f).width;
+        return rendering::TextLayoutCache::Instance().Measure(format, text).width;
     }
 
     TextFormatAccess formatAccess = AcquireTextFormat(this, nullptr, m_fontSize);
     if (formatAccess.raw) {
-        return formatAccess.raw->MeasureText(text, 0.0f).width;
+        return rendering::TextLayoutCache::Instance().Measure(formatAccess.raw, text).width;
     }
 
     return EstimateTextWidth(text);
@@ -1064,12 +1073,12 @@ void TextBox::InvalidateTextPresentation() {
 
 void TextBox::UpdateCaretVisible() {
     m_isCaretVisible = true;
-    m_lastCaretBlinkTime = GetTickCount64();
+    m_lastCaretBlinkTime = NowMs();
     InvalidateTextPresentation();
 }
 
 void TextBox::UpdateCaretBlink() {
-    const uint64_t currentTime = GetTickCount64();
+    const uint64_t currentTime = NowMs();
     if (currentTime - m_lastCaretBlinkTime < CARET_BLINK_INTERVAL_MS) {
         return;
     }
@@ -1088,7 +1097,13 @@ std::wstring TextBox::GetDisplayText() const {
 }
 
 bool TextBox::IsModifierPressed(int virtualKey) {
+#ifdef _WIN32
     return (GetKeyState(virtualKey) & 0x8000) != 0;
+#else
+    // 没有全局键盘状态，只使用事件参数中的修饰键
+    (void)virtualKey;
+    return false;
+#endif
 }
 
 bool TextBox::IsWordCharacter(wchar_t ch) {
@@ -1098,6 +1113,10 @@ bool TextBox::IsWordCharacter(wchar_t ch) {
 bool TextBox::ReadClipboardText(std::wstring& text) {
     text.clear();
 
+#ifndef _WIN32
+    return false;   // 离屏环境没有系统剪贴板
+#else
+
     if (!IsClipboardFormatAvailable(CF_UNICODETEXT) || !OpenClipboard(nullptr)) {
         return false;
     }
@@ -1118,9 +1137,14 @@ bool TextBox::ReadClipboardText(std::wstring& text) {
     GlobalUnlock(handle);
     CloseClipboard();
     return true;
+#endif
 }
 
 bool TextBox::WriteClipboardText(const std::wstring& text) {
+#ifndef _WIN32
+    (void)text;
+    return false;
+#else
     if (!OpenClipboard(nullptr)) {
         return false;
     }
@@ -1155,6 +1179,7 @@ bool TextBox::WriteClipboardText(const std::wstring& text) {
 
     CloseClipboard();
     return true;
+#endif
 }
 
 } // namespace controls
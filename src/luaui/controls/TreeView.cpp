@@ -7,7 +7,7 @@
 #include "IRenderContext.h"
 #include "Theme.h"
 #include "Window.h"
-#include <windows.h> // For VK_ constants
+#include "KeyCodes.h"
 
 namespace luaui {
 namespace controls {
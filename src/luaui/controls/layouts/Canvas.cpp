@@ -74,15 +74,7 @@ int Canvas::GetZIndex(const std::shared_ptr<IControl>& control) {
 rendering::Size Canvas::OnMeasureChildren(const rendering::Size& availableSize) {
     (void)availableSize;
     // Canvas gives children infinite space for measurement
-    for (auto& child : m_children) {
-        if (!child->GetIsVisible()) continue;
-        
-        if (auto* layoutable = child->AsLayoutable()) {
-            interfaces::LayoutConstraint constraint;
-            constraint.available = rendering::Size(99999, 99999);
-            layoutable->Measure(constraint);
-        }
-    }
+    MeasureVisibleChildren(rendering::Size(99999, 99999));
     
     // Calculate maximum bounds
     float maxWidth = 0;
@@ -159,11 +151,9 @@ void Canvas::OnRenderChildren(rendering::IRenderContext* context) {
         [](const auto& a, const auto& b) { return a.first < b.first; });
     
     // Render in ZIndex order
+    rendering::Rect clip = context->GetClipBounds();
     for (auto& [zIndex, child] : sortedChildren) {
-        auto* ctrl = static_cast<Control*>(child.get());
-        if (auto* r = ctrl->AsRenderable()) {
-            r->Render(context);
-        }
+        RenderChildClipped(context, child.get(), clip);
     }
 }
 
@@ -8,11 +8,18 @@
 namespace luaui {
 namespace controls {
 
+namespace {
+
+// 与其他面板一致：不小于该值的可用尺寸视为无限
+constexpr float kInfinite = 99999.0f;
+constexpr float kInfiniteThreshold = 99990.0f;
+
+} // anonymous namespace
+
 Grid::Grid() {}
 
 void Grid::AddColumn(const GridLength& width) {
     m_columns.push_back(width);
-    m_columnWidths.push_back(0.0f);
     InvalidateGridLayout();
 }
 
@@ -24,13 +31,11 @@ void Grid::SetColumnDefinition(size_t index, const GridLength& width) {
 
 void Grid::ClearColumns() {
     m_columns.clear();
-    m_columnWidths.clear();
     InvalidateGridLayout();
 }
 
 void Grid::AddRow(const GridLength& height) {
     m_rows.push_back(height);
-    m_rowHeights.push_back(0.0f);
     InvalidateGridLayout();
 }
 
@@ -42,7 +47,6 @@ void Grid::SetRowDefinition(size_t index, const GridLength& height) {
 
 void Grid::ClearRows() {
     m_rows.clear();
-    m_rowHeights.clear();
     InvalidateGridLayout();
 }
 
@@ -94,357 +98,250 @@ int Grid::GetRowSpan(const std::shared_ptr<interfaces::IControl>& control) const
     return it != m_cellInfo.end() ? it->second.rowSpan : 1;
 }
 
-rendering::Size Grid::OnMeasureChildren(const rendering::Size& availableSize) {
-    if (m_columns.empty() && m_rows.empty() && m_cellInfo.empty()) {
-        return Panel::OnMeasureChildren(availableSize);
-    }
-
-    const size_t effectiveColumns = GetEffectiveColumnCount();
-    const size_t effectiveRows = GetEffectiveRowCount();
-
-    m_columnWidths.assign(effectiveColumns, 0.0f);
-    m_rowHeights.assign(effectiveRows, 0.0f);
-
-    for (const auto& child : m_children) {
-        if (!child || !child->GetIsVisible()) continue;
-
-        if (auto* layoutable = child->AsLayoutable()) {
-            interfaces::LayoutConstraint constraint;
-            constraint.available = availableSize;
-            layoutable->Measure(constraint);
-        }
-    }
-
-    CalculateSizes(availableSize);
+float Grid::GetActualColumnWidth(size_t index) const {
+    return index < m_columnAxis.tracks.size() ? m_columnAxis.tracks[index].size : 0.0f;
+}
 
-    float totalWidth = 0.0f;
-    for (float width : m_columnWidths) {
-        totalWidth += width;
-    }
+float Grid::GetActualRowHeight(size_t index) const {
+    return index < m_rowAxis.tracks.size() ? m_rowAxis.tracks[index].size : 0.0f;
+}
 
-    float totalHeight = 0.0f;
-    for (float height : m_rowHeights) {
-        totalHeight += height;
+// ============================================================================
+// 维度求解
+// ============================================================================
+
+void Grid::Axis::Build(const std::vector<GridLength>& definitions, size_t count, const GridLength& fallback) {
+    tracks.resize(count);
+    starPrefix.assign(count + 1, 0);
+    autoPrefix.assign(count + 1, 0);
+    for (size_t i = 0; i < count; ++i) {
+        Track& track = tracks[i];
+        track.length = i < definitions.size() ? definitions[i] : fallback;
+        track.size = track.length.IsPixel() ? track.length.value : 0.0f;
+        starPrefix[i + 1] = starPrefix[i] + (track.length.IsStar() ? 1 : 0);
+        autoPrefix[i + 1] = autoPrefix[i] + (track.length.IsAuto() ? 1 : 0);
     }
+}
 
-    return rendering::Size(totalWidth, totalHeight);
+bool Grid::Axis::IsAutoLike(size_t index) const {
+    const GridLength& length = tracks[index].length;
+    return length.IsAuto() || (length.IsStar() && !starActive);
 }
 
-rendering::Size Grid::OnArrangeChildren(const rendering::Size& finalSize) {
-    if (m_columns.empty() && m_rows.empty() && m_cellInfo.empty()) {
-        return Panel::OnArrangeChildren(finalSize);
+float Grid::Axis::SumSizes(const Range& range) const {
+    float total = 0.0f;
+    for (uint32_t i = range.start; i < range.start + range.span; ++i) {
+        total += tracks[i].size;
     }
+    return total;
+}
 
-    // Recalculate sizes based on actual final size (may differ from measure available size)
-    CalculateSizes(finalSize);
+float Grid::Axis::MeasureConstraint(const Range& range, bool resolved) const {
+    if (resolved) return SumSizes(range);
+    // 只跨越 Pixel 定义时尺寸已确定，否则由内容决定
+    if (CountStars(range) + CountAutos(range) > 0) return kInfinite;
+    return SumSizes(range);
+}
 
-    // Use relative positions (0,0) - the rendering pipeline applies cumulative transforms,
-    // so child positions must be relative to the parent, not absolute screen coordinates
-    std::vector<float> colStarts(m_columnWidths.size(), 0.0f);
-    std::vector<float> rowStarts(m_rowHeights.size(), 0.0f);
+float Grid::Axis::GetTotal() const {
+    float total = 0.0f;
+    for (const auto& track : tracks) total += track.size;
+    return total;
+}
 
-    float x = 0.0f;
-    for (size_t i = 0; i < m_columnWidths.size(); ++i) {
-        colStarts[i] = x;
-        x += m_columnWidths[i];
+bool Grid::IsSpanIndexCurrent() const {
+    if (m_spanIndexDirty || m_spans.size() != m_children.size()) return false;
+    // 子控件可能经任意途径增删或替换，逐个比较指针即可发现，无需查表
+    for (size_t i = 0; i < m_spans.size(); ++i) {
+        if (m_spans[i].control != m_children[i].get()) return false;
     }
+    return true;
+}
 
-    float y = 0.0f;
-    for (size_t i = 0; i < m_rowHeights.size(); ++i) {
-        rowStarts[i] = y;
-        y += m_rowHeights[i];
-    }
+void Grid::BuildSpanIndex() {
+    m_spans.clear();
+    m_spans.reserve(m_children.size());
 
+    // 每个子控件只在索引重建时查一次附加属性；隐藏的子控件仍然占据行列
+    size_t columnCount = m_columns.size();
+    size_t rowCount = m_rows.size();
     for (const auto& child : m_children) {
-        if (!child || !child->GetIsVisible()) continue;
-
-        auto* layoutable = child->AsLayoutable();
-        if (!layoutable) continue;
-
-        const int col = GetColumn(child);
-        const int row = GetRow(child);
-        const int colSpan = std::max(1, GetColumnSpan(child));
-        const int rowSpan = std::max(1, GetRowSpan(child));
-
-        const float childX = (col >= 0 && col < static_cast<int>(colStarts.size())) ? colStarts[col] : 0.0f;
-        const float childY = (row >= 0 && row < static_cast<int>(rowStarts.size())) ? rowStarts[row] : 0.0f;
-
-        float childWidth = 0.0f;
-        for (int c = std::max(0, col); c < col + colSpan && c < static_cast<int>(m_columnWidths.size()); ++c) {
-            childWidth += m_columnWidths[c];
-        }
-
-        float childHeight = 0.0f;
-        for (int r = std::max(0, row); r < row + rowSpan && r < static_cast<int>(m_rowHeights.size()); ++r) {
-            childHeight += m_rowHeights[r];
+        CellInfo cell;
+        if (child) {
+            auto it = m_cellInfo.find(child->GetID());
+            if (it != m_cellInfo.end()) cell = it->second;
         }
 
-        layoutable->Arrange(rendering::Rect(childX, childY, childWidth, childHeight));
+        ChildSpan span;
+        span.control = child.get();
+        span.layout = child ? child->AsLayoutable() : nullptr;
+        span.columns.start = static_cast<uint32_t>(std::max(0, cell.column));
+        span.columns.span = static_cast<uint32_t>(std::max(1, cell.columnSpan));
+        span.rows.start = static_cast<uint32_t>(std::max(0, cell.row));
+        span.rows.span = static_cast<uint32_t>(std::max(1, cell.rowSpan));
+        columnCount = std::max(columnCount, static_cast<size_t>(span.columns.start) + span.columns.span);
+        rowCount = std::max(rowCount, static_cast<size_t>(span.rows.start) + span.rows.span);
+        m_spans.push_back(span);
     }
 
-    return finalSize;
+    m_columnAxis.Build(m_columns, columnCount, GridLength::Star());
+    m_rowAxis.Build(m_rows, rowCount, GridLength::Auto());
+    m_spanIndexDirty = false;
 }
 
-void Grid::CalculateSizes(const rendering::Size& availableSize) {
-    const size_t effectiveColumns = GetEffectiveColumnCount();
-    const size_t effectiveRows = GetEffectiveRowCount();
+void Grid::UpdateActiveSpans() {
+    for (auto& span : m_spans) {
+        span.active = span.layout && span.control->GetIsVisible();
+        if (span.active) span.desired = span.layout->GetDesiredSize();
+    }
+}
 
-    m_columnWidths.assign(effectiveColumns, 0.0f);
-    m_rowHeights.assign(effectiveRows, 0.0f);
+void Grid::MeasureSpans(bool starColumns) {
+    m_measureBatch.clear();
+    m_batchSpans.clear();
+    for (uint32_t i = 0; i < m_spans.size(); ++i) {
+        const ChildSpan& span = m_spans[i];
+        if (!span.active || m_columnAxis.HasActiveStar(span.columns) != starColumns) continue;
+
+        components::LayoutComponent::ChildMeasure item;
+        item.layout = span.layout;
+        item.constraint.available = rendering::Size(
+            m_columnAxis.MeasureConstraint(span.columns, starColumns),
+            m_rowAxis.MeasureConstraint(span.rows, false));
+        m_measureBatch.push_back(item);
+        m_batchSpans.push_back(i);
+    }
 
-    if (effectiveColumns == 0 && effectiveRows == 0) {
-        return;
+    components::LayoutComponent::MeasureChildren(m_measureBatch);
+    for (size_t i = 0; i < m_measureBatch.size(); ++i) {
+        m_spans[m_batchSpans[i]].desired = m_measureBatch[i].desired;
     }
+}
 
-    float fixedWidth = 0.0f;
-    float fixedHeight = 0.0f;
+void Grid::ResolveAxis(Axis& axis, float available, bool columns) {
+    axis.starActive = available < kInfiniteThreshold;
+    for (auto& track : axis.tracks) {
+        track.size = track.length.IsPixel() ? track.length.value : 0.0f;
+    }
 
-    for (size_t i = 0; i < effectiveColumns; ++i) {
-        const GridLength definition = GetColumnDefinitionAt(i);
-        if (definition.IsPixel()) {
-            m_columnWidths[i] = definition.value;
-            fixedWidth += definition.value;
+    // 1. 单个定义内的子控件直接决定 Auto 尺寸；跨越 Star 的子控件不参与
+    axis.multiSpan.clear();
+    for (uint32_t i = 0; i < m_spans.size(); ++i) {
+        const ChildSpan& span = m_spans[i];
+        if (!span.active) continue;
+        const Range& range = columns ? span.columns : span.rows;
+        if (axis.HasActiveStar(range)) continue;
+
+        if (range.span == 1) {
+            if (axis.IsAutoLike(range.start)) {
+                float extent = columns ? span.desired.width : span.desired.height;
+                Track& track = axis.tracks[range.start];
+                track.size = std::max(track.size, extent);
+            }
+        } else if (axis.CountAutos(range) + axis.CountStars(range) > 0) {
+            axis.multiSpan.push_back(i);
         }
     }
 
-    for (size_t i = 0; i < effectiveRows; ++i) {
-        const GridLength definition = GetRowDefinitionAt(i);
-        if (definition.IsPixel()) {
-            m_rowHeights[i] = definition.value;
-            fixedHeight += definition.value;
+    // 2. 跨多个定义的子控件按跨度从小到大处理，超出部分平均分给跨越的 Auto 定义
+    std::stable_sort(axis.multiSpan.begin(), axis.multiSpan.end(), [&](uint32_t a, uint32_t b) {
+        const Range& ra = columns ? m_spans[a].columns : m_spans[a].rows;
+        const Range& rb = columns ? m_spans[b].columns : m_spans[b].rows;
+        return ra.span < rb.span;
+    });
+    for (uint32_t index : axis.multiSpan) {
+        const ChildSpan& span = m_spans[index];
+        const Range& range = columns ? span.columns : span.rows;
+        float extent = columns ? span.desired.width : span.desired.height;
+        float extra = extent - axis.SumSizes(range);
+        if (extra <= 0.0f) continue;
+
+        // 可用空间有限时 Star 不在此处（已跳过），因此 Auto 与 Star 的计数即 Auto 类定义数
+        float share = extra / static_cast<float>(axis.CountAutos(range) + axis.CountStars(range));
+        for (uint32_t t = range.start; t < range.start + range.span; ++t) {
+            if (axis.IsAutoLike(t)) axis.tracks[t].size += share;
         }
     }
 
-    for (const auto& child : m_children) {
-        if (!child || !child->GetIsVisible()) continue;
-
-        auto* layoutable = child->AsLayoutable();
-        if (!layoutable) continue;
-
-        const rendering::Size desired = layoutable->GetDesiredSize();
-        const int col = GetColumn(child);
-        const int row = GetRow(child);
-        const int colSpan = std::max(1, GetColumnSpan(child));
-        const int rowSpan = std::max(1, GetRowSpan(child));
-
-        if (colSpan == 1 && col >= 0 && col < static_cast<int>(effectiveColumns)) {
-            if (GetColumnDefinitionAt(static_cast<size_t>(col)).IsAuto()) {
-                m_columnWidths[col] = std::max(m_columnWidths[col], desired.width);
-            }
-        } else if (colSpan > 1) {
-            int autoColCount = 0;
-            float allocatedWidth = 0.0f;
-            for (int c = std::max(0, col); c < col + colSpan && c < static_cast<int>(effectiveColumns); ++c) {
-                const GridLength definition = GetColumnDefinitionAt(static_cast<size_t>(c));
-                if (definition.IsAuto()) {
-                    ++autoColCount;
-                } else if (definition.IsPixel()) {
-                    allocatedWidth += m_columnWidths[c];
-                }
-            }
-            if (autoColCount > 0) {
-                const float remainingWidth = std::max(0.0f, desired.width - allocatedWidth);
-                const float widthPerAutoCol = remainingWidth / autoColCount;
-                for (int c = std::max(0, col); c < col + colSpan && c < static_cast<int>(effectiveColumns); ++c) {
-                    if (GetColumnDefinitionAt(static_cast<size_t>(c)).IsAuto()) {
-                        m_columnWidths[c] = std::max(m_columnWidths[c], widthPerAutoCol);
-                    }
-                }
+    // 3. 剩余空间按权重分给 Star 定义
+    if (axis.starActive) {
+        float fixed = 0.0f;
+        float totalWeight = 0.0f;
+        for (const auto& track : axis.tracks) {
+            if (track.length.IsStar()) {
+                totalWeight += track.length.value;
+            } else {
+                fixed += track.size;
             }
         }
-
-        if (rowSpan == 1 && row >= 0 && row < static_cast<int>(effectiveRows)) {
-            if (GetRowDefinitionAt(static_cast<size_t>(row)).IsAuto()) {
-                m_rowHeights[row] = std::max(m_rowHeights[row], desired.height);
-            }
-        } else if (rowSpan > 1) {
-            int autoRowCount = 0;
-            float allocatedHeight = 0.0f;
-            for (int r = std::max(0, row); r < row + rowSpan && r < static_cast<int>(effectiveRows); ++r) {
-                const GridLength definition = GetRowDefinitionAt(static_cast<size_t>(r));
-                if (definition.IsAuto()) {
-                    ++autoRowCount;
-                } else if (definition.IsPixel()) {
-                    allocatedHeight += m_rowHeights[r];
-                }
-            }
-            if (autoRowCount > 0) {
-                const float remainingHeight = std::max(0.0f, desired.height - allocatedHeight);
-                const float heightPerAutoRow = remainingHeight / autoRowCount;
-                for (int r = std::max(0, row); r < row + rowSpan && r < static_cast<int>(effectiveRows); ++r) {
-                    if (GetRowDefinitionAt(static_cast<size_t>(r)).IsAuto()) {
-                        m_rowHeights[r] = std::max(m_rowHeights[r], heightPerAutoRow);
-                    }
+        if (totalWeight > 0.0f) {
+            const float remaining = std::max(0.0f, available - fixed);
+            for (auto& track : axis.tracks) {
+                if (track.length.IsStar()) {
+                    track.size = track.length.value / totalWeight * remaining;
                 }
             }
         }
     }
 
-    float autoWidth = 0.0f;
-    for (size_t i = 0; i < effectiveColumns; ++i) {
-        if (GetColumnDefinitionAt(i).IsAuto()) {
-            autoWidth += m_columnWidths[i];
-        }
+    float offset = 0.0f;
+    for (auto& track : axis.tracks) {
+        track.offset = offset;
+        offset += track.size;
     }
+}
 
-    float autoHeight = 0.0f;
-    for (size_t i = 0; i < effectiveRows; ++i) {
-        if (GetRowDefinitionAt(i).IsAuto()) {
-            autoHeight += m_rowHeights[i];
-        }
-    }
+// ============================================================================
+// 布局
+// ============================================================================
 
-    float totalStarWidth = 0.0f;
-    for (size_t i = 0; i < effectiveColumns; ++i) {
-        const GridLength definition = GetColumnDefinitionAt(i);
-        if (definition.IsStar()) {
-            totalStarWidth += definition.value;
-        }
+rendering::Size Grid::OnMeasureChildren(const rendering::Size& availableSize) {
+    if (!UsesDefinitions()) {
+        return Panel::OnMeasureChildren(availableSize);
     }
 
-    float totalStarHeight = 0.0f;
-    for (size_t i = 0; i < effectiveRows; ++i) {
-        const GridLength definition = GetRowDefinitionAt(i);
-        if (definition.IsStar()) {
-            totalStarHeight += definition.value;
-        }
-    }
+    if (!IsSpanIndexCurrent()) BuildSpanIndex();
+    UpdateActiveSpans();
+    m_columnAxis.starActive = availableSize.width < kInfiniteThreshold;
 
-    const bool infiniteWidth = availableSize.width >= 99990.0f;
-    const bool infiniteHeight = availableSize.height >= 99990.0f;
-
-    if (totalStarWidth > 0.0f) {
-        if (infiniteWidth) {
-            // When available width is infinite, Star columns behave like Auto
-            for (const auto& child : m_children) {
-                if (!child || !child->GetIsVisible()) continue;
-                auto* layoutable = child->AsLayoutable();
-                if (!layoutable) continue;
-                const rendering::Size desired = layoutable->GetDesiredSize();
-                const int col = GetColumn(child);
-                const int colSpan = std::max(1, GetColumnSpan(child));
-                if (colSpan == 1 && col >= 0 && col < static_cast<int>(effectiveColumns)) {
-                    if (GetColumnDefinitionAt(static_cast<size_t>(col)).IsStar()) {
-                        m_columnWidths[col] = std::max(m_columnWidths[col], desired.width);
-                    }
-                } else if (colSpan > 1) {
-                    int starColCount = 0;
-                    float allocatedWidth = 0.0f;
-                    for (int c = std::max(0, col); c < col + colSpan && c < static_cast<int>(effectiveColumns); ++c) {
-                        const GridLength definition = GetColumnDefinitionAt(static_cast<size_t>(c));
-                        if (definition.IsStar()) {
-                            ++starColCount;
-                        } else {
-                            allocatedWidth += m_columnWidths[c];
-                        }
-                    }
-                    if (starColCount > 0) {
-                        const float remainingStarWidth = std::max(0.0f, desired.width - allocatedWidth);
-                        const float widthPerStarCol = remainingStarWidth / starColCount;
-                        for (int c = std::max(0, col); c < col + colSpan && c < static_cast<int>(effectiveColumns); ++c) {
-                            if (GetColumnDefinitionAt(static_cast<size_t>(c)).IsStar()) {
-                                m_columnWidths[c] = std::max(m_columnWidths[c], widthPerStarCol);
-                            }
-                        }
-                    }
-                }
-            }
-        } else {
-            const float remainingWidth = std::max(0.0f, availableSize.width - fixedWidth - autoWidth);
-            for (size_t i = 0; i < effectiveColumns; ++i) {
-                const GridLength definition = GetColumnDefinitionAt(i);
-                if (definition.IsStar()) {
-                    m_columnWidths[i] = (definition.value / totalStarWidth) * remainingWidth;
-                }
-            }
-        }
-    }
+    // 列宽只取决于不跨越 Star 列的子控件，先测量它们并求解列宽，
+    // 再以解析后的列宽测量其余子控件；最后由全部子控件求解行高
+    MeasureSpans(false);
+    ResolveAxis(m_columnAxis, availableSize.width, true);
+    MeasureSpans(true);
+    ResolveAxis(m_rowAxis, availableSize.height, false);
 
-    if (totalStarHeight > 0.0f) {
-        if (infiniteHeight) {
-            // When available height is infinite, Star rows behave like Auto
-            for (const auto& child : m_children) {
-                if (!child || !child->GetIsVisible()) continue;
-                auto* layoutable = child->AsLayoutable();
-                if (!layoutable) continue;
-                const rendering::Size desired = layoutable->GetDesiredSize();
-                const int row = GetRow(child);
-                const int rowSpan = std::max(1, GetRowSpan(child));
-                if (rowSpan == 1 && row >= 0 && row < static_cast<int>(effectiveRows)) {
-                    if (GetRowDefinitionAt(static_cast<size_t>(row)).IsStar()) {
-                        m_rowHeights[row] = std::max(m_rowHeights[row], desired.height);
-                    }
-                } else if (rowSpan > 1) {
-                    int starRowCount = 0;
-                    float allocatedHeight = 0.0f;
-                    for (int r = std::max(0, row); r < row + rowSpan && r < static_cast<int>(effectiveRows); ++r) {
-                        const GridLength definition = GetRowDefinitionAt(static_cast<size_t>(r));
-                        if (definition.IsStar()) {
-                            ++starRowCount;
-                        } else {
-                            allocatedHeight += m_rowHeights[r];
-                        }
-                    }
-                    if (starRowCount > 0) {
-                        const float remainingStarHeight = std::max(0.0f, desired.height - allocatedHeight);
-                        const float heightPerStarRow = remainingStarHeight / starRowCount;
-                        for (int r = std::max(0, row); r < row + rowSpan && r < static_cast<int>(effectiveRows); ++r) {
-                            if (GetRowDefinitionAt(static_cast<size_t>(r)).IsStar()) {
-                                m_rowHeights[r] = std::max(m_rowHeights[r], heightPerStarRow);
-                            }
-                        }
-                    }
-                }
-            }
-        } else {
-            const float remainingHeight = std::max(0.0f, availableSize.height - fixedHeight - autoHeight);
-            for (size_t i = 0; i < effectiveRows; ++i) {
-                const GridLength definition = GetRowDefinitionAt(i);
-                if (definition.IsStar()) {
-                    m_rowHeights[i] = (definition.value / totalStarHeight) * remainingHeight;
-                }
-            }
-        }
-    }
+    return rendering::Size(m_columnAxis.GetTotal(), m_rowAxis.GetTotal());
 }
 
-size_t Grid::GetEffectiveColumnCount() const {
-    size_t count = m_columns.size();
-    for (const auto& child : m_children) {
-        if (!child) continue;
-        const int col = std::max(0, GetColumn(child));
-        const int span = std::max(1, GetColumnSpan(child));
-        count = std::max(count, static_cast<size_t>(col + span));
+rendering::Size Grid::OnArrangeChildren(const rendering::Size& finalSize) {
+    if (!UsesDefinitions()) {
+        return Panel::OnArrangeChildren(finalSize);
     }
-    return count;
-}
 
-size_t Grid::GetEffectiveRowCount() const {
-    size_t count = m_rows.size();
-    for (const auto& child : m_children) {
-        if (!child) continue;
-        const int row = std::max(0, GetRow(child));
-        const int span = std::max(1, GetRowSpan(child));
-        count = std::max(count, static_cast<size_t>(row + span));
+    if (!IsSpanIndexCurrent()) {
+        BuildSpanIndex();
+        UpdateActiveSpans();
     }
-    return count;
-}
 
-GridLength Grid::GetColumnDefinitionAt(size_t index) const {
-    if (index < m_columns.size()) {
-        return m_columns[index];
+    // 最终尺寸可能与测量时的可用尺寸不同，以测量得到的期望尺寸重新求解
+    ResolveAxis(m_columnAxis, finalSize.width, true);
+    ResolveAxis(m_rowAxis, finalSize.height, false);
+
+    for (const auto& span : m_spans) {
+        if (!span.active) continue;
+        const Track& column = m_columnAxis.tracks[span.columns.start];
+        const Track& row = m_rowAxis.tracks[span.rows.start];
+        span.layout->Arrange(rendering::Rect(column.offset, row.offset,
+                                             m_columnAxis.SumSizes(span.columns),
+                                             m_rowAxis.SumSizes(span.rows)));
     }
-    return GridLength::Star();
-}
 
-GridLength Grid::GetRowDefinitionAt(size_t index) const {
-    if (index < m_rows.size()) {
-        return m_rows[index];
-    }
-    return GridLength::Auto();
+    return finalSize;
 }
 
 void Grid::InvalidateGridLayout() {
+    m_spanIndexDirty = true;
     if (auto* layout = GetLayout()) {
         layout->InvalidateMeasure();
     }
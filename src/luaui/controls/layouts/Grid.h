@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Panel.h"
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -36,6 +37,18 @@ struct GridLength {
 
 /**
  * @brief Grid - 网格布局面板（新架构）
+ *
+ * 求解顺序（与 WPF 一致）：
+ * 1. 不跨越 Star 列的子控件先测量（Pixel 列给定宽度，含 Auto 列时宽度不限），
+ *    得到 Auto 列宽：先处理单列子控件，再按跨度从小到大把多列子控件超出的部分
+ *    平均分给其跨越的 Auto 列；剩余宽度按权重分给 Star 列。
+ * 2. 跨越 Star 列的子控件再以解析后的列宽测量。
+ * 3. 行高按同样的规则由全部子控件的期望高度求解。
+ * 可用空间无限时 Star 按 Auto 处理。超出定义数的列视为 Star，行视为 Auto。
+ *
+ * 子控件的行列位置解析为跨度索引，并为每个维度预计算各类定义的前缀计数，
+ * 跨度查询为 O(1)。索引只在行列定义、附加属性或子控件变化时重建，
+ * 其余测量不再查表；求解缓冲区在多次布局之间复用。
  */
 class Grid : public Panel {
 public:
@@ -62,6 +75,10 @@ public:
     int GetColumnSpan(const std::shared_ptr<interfaces::IControl>& control) const;
     int GetRowSpan(const std::shared_ptr<interfaces::IControl>& control) const;
 
+    /** @brief 最近一次布局解析出的列宽/行高（测量或排列后有效） */
+    float GetActualColumnWidth(size_t index) const;
+    float GetActualRowHeight(size_t index) const;
+
 protected:
     rendering::Size OnMeasureChildren(const rendering::Size& availableSize) override;
     rendering::Size OnArrangeChildren(const rendering::Size& finalSize) override;
@@ -74,17 +91,65 @@ private:
         int rowSpan = 1;
     };
 
+    // 一个维度（列或行）上的定义及求解结果
+    struct Track {
+        GridLength length;
+        float size = 0.0f;
+        float offset = 0.0f;
+    };
+
+    // 一个维度上的区间 [start, start + span)，已裁剪到有效范围
+    struct Range {
+        uint32_t start = 0;
+        uint32_t span = 1;
+    };
+
+    // 子控件的跨度索引项（与 m_children 一一对应）
+    struct ChildSpan {
+        interfaces::IControl* control = nullptr;
+        interfaces::ILayoutable* layout = nullptr;
+        bool active = false;   // 可见且可布局，本次求解参与
+        rendering::Size desired;
+        Range columns;
+        Range rows;
+    };
+
+    // 一个维度的求解状态（缓冲区在多次布局之间复用）
+    struct Axis {
+        std::vector<Track> tracks;
+        std::vector<uint32_t> starPrefix;    // [i] = 前 i 个定义中 Star 的数量
+        std::vector<uint32_t> autoPrefix;    // [i] = 前 i 个定义中 Auto 的数量
+        std::vector<uint32_t> multiSpan;     // 跨多个定义的子控件（按跨度排序）
+        bool starActive = true;              // 可用空间有限时 Star 按比例分配
+
+        void Build(const std::vector<GridLength>& definitions, size_t count, const GridLength& fallback);
+        uint32_t CountStars(const Range& range) const { return starPrefix[range.start + range.span] - starPrefix[range.start]; }
+        uint32_t CountAutos(const Range& range) const { return autoPrefix[range.start + range.span] - autoPrefix[range.start]; }
+        bool HasActiveStar(const Range& range) const { return starActive && CountStars(range) > 0; }
+        bool IsAutoLike(size_t index) const;   // Auto，或可用空间无限时的 Star
+        float SumSizes(const Range& range) const;
+        float MeasureConstraint(const Range& range, bool resolved) const;
+        float GetTotal() const;
+    };
+
     std::vector<GridLength> m_columns;
     std::vector<GridLength> m_rows;
-    std::vector<float> m_columnWidths;
-    std::vector<float> m_rowHeights;
     std::unordered_map<ControlID, CellInfo> m_cellInfo;
 
-    void CalculateSizes(const rendering::Size& availableSize);
-    size_t GetEffectiveColumnCount() const;
-    size_t GetEffectiveRowCount() const;
-    GridLength GetColumnDefinitionAt(size_t index) const;
-    GridLength GetRowDefinitionAt(size_t index) const;
+    // 求解缓冲区
+    Axis m_columnAxis;
+    Axis m_rowAxis;
+    std::vector<ChildSpan> m_spans;
+    std::vector<components::LayoutComponent::ChildMeasure> m_measureBatch;
+    std::vector<uint32_t> m_batchSpans;   // m_measureBatch[i] 对应的 m_spans 下标
+    bool m_spanIndexDirty = true;         // 行列定义或附加属性已变化
+
+    bool UsesDefinitions() const { return !m_columns.empty() || !m_rows.empty() || !m_cellInfo.empty(); }
+    bool IsSpanIndexCurrent() const;
+    void BuildSpanIndex();
+    void UpdateActiveSpans();
+    void MeasureSpans(bool starColumns);
+    void ResolveAxis(Axis& axis, float available, bool columns);
     void InvalidateGridLayout();
 };
 
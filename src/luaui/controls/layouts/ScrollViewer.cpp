@@ -237,11 +237,11 @@ void ScrollViewer::OnRenderChildren(rendering::IRenderContext* context) {
     // clip to viewport
     context->PushClip(rendering::Rect(0, 0, vpW, vpH));
 
-    // render children
+    // render children; content scrolled out of the viewport is culled
+    rendering::Rect clip = context->GetClipBounds();
     for (size_t i = 0; i < m_children.size(); ++i) {
         if (!m_children[i]->GetIsVisible()) continue;
-        auto* ctrl = static_cast<Control*>(m_children[i].get());
-        if (auto* r = ctrl->AsRenderable()) r->Render(context);
+        RenderChildClipped(context, m_children[i].get(), clip);
     }
 
     context->PopClip();
@@ -253,6 +253,11 @@ void ScrollViewer::OnRenderChildren(rendering::IRenderContext* context) {
     float targetW = (m_sbHovered || m_dragging) ? SB_EXPANDED : SB_COLLAPSED;
     m_currentSbWidth += (targetW - m_currentSbWidth) * 0.3f;
     if (std::abs(m_currentSbWidth - targetW) < 0.5f) m_currentSbWidth = targetW;
+    // keep requesting frames until the bar reaches its target width;
+    // nothing else repaints it once the hover change has been drawn
+    if (m_currentSbWidth != targetW) {
+        if (auto* r = GetRender()) r->Invalidate();
+    }
 
     float sbW = m_currentSbWidth;
     float trackX = vpW - sbW - SB_MARGIN;
@@ -363,6 +368,8 @@ void ScrollViewer::OnMouseUp(controls::MouseEventArgs& args) {
     if (m_dragging) {
         m_dragging = false;
         m_sbPressed = false;
+        // collapse back unless the pointer is still over the track
+        if (auto* r = GetRender()) r->Invalidate();
         args.Handled = true;
     }
 }
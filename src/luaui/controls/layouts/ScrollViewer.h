@@ -39,6 +39,9 @@ public:
     float GetViewportWidth() const { return m_viewportWidth; }
     float GetViewportHeight() const { return m_viewportHeight; }
 
+    /** Current (possibly animating) width of the vertical scrollbar */
+    float GetScrollBarWidth() const { return m_currentSbWidth; }
+
 protected:
     void InitializeComponents() override;
     rendering::Size OnMeasureChildren(const rendering::Size& availableSize) override;
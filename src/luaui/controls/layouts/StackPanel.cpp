@@ -17,21 +17,14 @@ rendering::Size StackPanel::OnMeasureChildren(const rendering::Size& availableSi
     float totalHeight = 0;
     float maxCross = 0;
     
-    for (auto& child : m_children) {
-        if (!child->GetIsVisible()) continue;
-        
-        if (auto* layoutable = child->AsLayoutable()) {
-            interfaces::LayoutConstraint constraint;
-            constraint.available = availableSize;
-            auto measured = layoutable->Measure(constraint);
-            
-            if (isHorizontal) {
-                totalWidth += measured.width;
-                maxCross = std::max(maxCross, measured.height);
-            } else {
-                totalHeight += measured.height;
-                maxCross = std::max(maxCross, measured.width);
-            }
+    for (const auto& child : MeasureVisibleChildren(availableSize)) {
+        const auto& measured = child.desired;
+        if (isHorizontal) {
+            totalWidth += measured.width;
+            maxCross = std::max(maxCross, measured.height);
+        } else {
+            totalHeight += measured.height;
+            maxCross = std::max(maxCross, measured.width);
         }
     }
     
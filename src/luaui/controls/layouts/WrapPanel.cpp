@@ -45,46 +45,39 @@ rendering::Size WrapPanel::OnMeasureChildren(const rendering::Size& availableSiz
     float maxOtherSize = 0;
     bool firstInLine = true;
     
-    for (auto& child : m_children) {
-        if (!child->GetIsVisible()) continue;
+    for (const auto& child : MeasureVisibleChildren(availableSize)) {
+        const auto& desired = child.desired;
         
-        if (auto* layoutable = child->AsLayoutable()) {
-            interfaces::LayoutConstraint constraint;
-            constraint.available = availableSize;
-            layoutable->Measure(constraint);
-            auto desired = layoutable->GetDesiredSize();
-            
-            float childWidth = m_itemWidth > 0 ? m_itemWidth : desired.width;
-            float childHeight = m_itemHeight > 0 ? m_itemHeight : desired.height;
-            
-            // Add spacing between items (not before first item in line)
-            float spacingWidth = firstInLine ? 0 : m_spacing;
-            
-            if (isHorizontal) {
-                if (lineSize + spacingWidth + childWidth > availableSize.width && lineSize > 0) {
-                    // Wrap to new line
-                    lineOffset += maxOtherSize + m_spacing;
-                    maxOtherSize = 0;
-                    lineSize = childWidth;
-                    firstInLine = true;
-                } else {
-                    lineSize += spacingWidth + childWidth;
-                    firstInLine = false;
-                }
-                maxOtherSize = std::max(maxOtherSize, childHeight);
+        float childWidth = m_itemWidth > 0 ? m_itemWidth : desired.width;
+        float childHeight = m_itemHeight > 0 ? m_itemHeight : desired.height;
+        
+        // Add spacing between items (not before first item in line)
+        float spacingWidth = firstInLine ? 0 : m_spacing;
+        
+        if (isHorizontal) {
+            if (lineSize + spacingWidth + childWidth > availableSize.width && lineSize > 0) {
+                // Wrap to new line
+                lineOffset += maxOtherSize + m_spacing;
+                maxOtherSize = 0;
+                lineSize = childWidth;
+                firstInLine = true;
             } else {
-                if (lineSize + spacingWidth + childHeight > availableSize.height && lineSize > 0) {
-                    // Wrap to new column
-                    lineOffset += maxOtherSize + m_spacing;
-                    maxOtherSize = 0;
-                    lineSize = childHeight;
-                    firstInLine = true;
-                } else {
-                    lineSize += spacingWidth + childHeight;
-                    firstInLine = false;
-                }
-                maxOtherSize = std::max(maxOtherSize, childWidth);
+                lineSize += spacingWidth + childWidth;
+                firstInLine = false;
+            }
+            maxOtherSize = std::max(maxOtherSize, childHeight);
+        } else {
+            if (lineSize + spacingWidth + childHeight > availableSize.height && lineSize > 0) {
+                // Wrap to new column
+                lineOffset += maxOtherSize + m_spacing;
+                maxOtherSize = 0;
+                lineSize = childHeight;
+                firstInLine = true;
+            } else {
+                lineSize += spacingWidth + childHeight;
+                firstInLine = false;
             }
+            maxOtherSize = std::max(maxOtherSize, childWidth);
         }
     }
     
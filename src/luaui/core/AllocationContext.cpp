@@ -0,0 +1,107 @@
+#include "AllocationContext.h"
+#include <new>
+
+namespace luaui {
+
+namespace {
+
+thread_local AllocationContext* t_current = nullptr;
+
+} // anonymous namespace
+
+// ==================== Arena ====================
+
+AllocationContext::Arena::Arena(size_t chunkSize)
+    : m_chunkSize(chunkSize < kMaxPooledSize ? kMaxPooledSize : chunkSize) {
+}
+
+AllocationContext::Arena::~Arena() = default;
+
+void* AllocationContext::Arena::Allocate(size_t bytes, size_t alignment) {
+    if (bytes == 0) bytes = 1;
+
+    if (!IsPooled(bytes, alignment)) {
+        void* ptr = ::operator new(bytes, std::align_val_t(alignment));
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.allocations;
+        ++m_stats.liveAllocations;
+        m_stats.bytesAllocated += bytes;
+        m_stats.liveBytes += bytes;
+        return ptr;
+    }
+
+    const size_t sizeClass = SizeClass(bytes);
+    const size_t blockSize = (sizeClass + 1) * kGranularity;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_stats.allocations;
+    ++m_stats.liveAllocations;
+    m_stats.bytesAllocated += blockSize;
+    m_stats.liveBytes += blockSize;
+
+    if (FreeBlock* block = m_freeLists[sizeClass]) {
+        m_freeLists[sizeClass] = block->next;
+        ++m_stats.reusedAllocations;
+        return block;
+    }
+
+    // 当前块剩余空间不足时申请新块，旧块尾部的剩余空间放弃
+    if (static_cast<size_t>(m_end - m_cursor) < blockSize) {
+        // 不清零；new[] 的对齐（__STDCPP_DEFAULT_NEW_ALIGNMENT__）不低于 kGranularity
+        m_chunks.emplace_back(new unsigned char[m_chunkSize]);
+        m_cursor = m_chunks.back().get();
+        m_end = m_cursor + m_chunkSize;
+        ++m_stats.chunkCount;
+        m_stats.reservedBytes += m_chunkSize;
+    }
+    void* ptr = m_cursor;
+    m_cursor += blockSize;
+    return ptr;
+}
+
+void AllocationContext::Arena::Deallocate(void* ptr, size_t bytes, size_t alignment) {
+    if (!ptr) return;
+    if (bytes == 0) bytes = 1;
+
+    if (!IsPooled(bytes, alignment)) {
+        ::operator delete(ptr, std::align_val_t(alignment));
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_stats.liveAllocations;
+        m_stats.liveBytes -= bytes;
+        return;
+    }
+
+    const size_t sizeClass = SizeClass(bytes);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto* block = static_cast<FreeBlock*>(ptr);
+    block->next = m_freeLists[sizeClass];
+    m_freeLists[sizeClass] = block;
+    --m_stats.liveAllocations;
+    m_stats.liveBytes -= (sizeClass + 1) * kGranularity;
+}
+
+AllocationContext::Stats AllocationContext::Arena::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+// ==================== AllocationContext ====================
+
+AllocationContext::AllocationContext(size_t chunkSize)
+    : m_arena(std::make_shared<Arena>(chunkSize)) {
+}
+
+AllocationContext* AllocationContext::GetCurrent() {
+    return t_current;
+}
+
+AllocationContext::Scope::Scope(AllocationContext* context)
+    : m_previous(t_current) {
+    if (context) t_current = context;
+}
+
+AllocationContext::Scope::~Scope() {
+    t_current = m_previous;
+}
+
+} // namespace luaui
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace luaui {
+
+/**
+ * @brief 控件分配上下文（通常每个窗口或每个加载的视图一个）
+ *
+ * 通过 MakeShared 创建的对象（连同 shared_ptr 控制块）从上下文的内存池分配：
+ * 内存按大块向系统申请，块内顺序切分；对象释放后按大小级放入空闲链表供后续复用，
+ * 不逐个归还系统。标准组件已内联在 Control 中，因此一个控件只占一次池分配。
+ *
+ * 内存池由上下文和从中分配的所有对象共同持有：上下文先于控件销毁时内存不会失效，
+ * 最后一个对象释放后所有块一次性归还（整体释放）。
+ *
+ * XmlLoader / MvvmXmlLoader 通过 SetAllocationContext 使用上下文，
+ * 控件工厂通过 MakeControl 使用当前线程上的上下文（见 Scope）。
+ * 分配与释放是线程安全的。
+ */
+class AllocationContext {
+public:
+    struct Stats {
+        size_t allocations = 0;        // 累计分配次数
+        size_t bytesAllocated = 0;     // 累计分配字节数（按大小级取整后）
+        size_t liveAllocations = 0;    // 尚未释放的分配数
+        size_t liveBytes = 0;          // 尚未释放的字节数
+        size_t reusedAllocations = 0;  // 由空闲链表满足的分配数
+        size_t chunkCount = 0;         // 向系统申请的块数
+        size_t reservedBytes = 0;      // 块的总大小
+    };
+
+    static constexpr size_t kDefaultChunkSize = 64 * 1024;
+
+    /**
+     * @brief 内存池：大块顺序切分 + 按大小级的空闲链表
+     *
+     * 超过 kMaxPooledSize 或对齐要求高于 kGranularity 的分配直接使用全局 operator new。
+     */
+    class Arena {
+    public:
+        static constexpr size_t kGranularity = 16;
+        static constexpr size_t kMaxPooledSize = 4096;   // 常见控件（含内联组件）约 1~1.5KB
+
+        explicit Arena(size_t chunkSize);
+        ~Arena();
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        void* Allocate(size_t bytes, size_t alignment);
+        void Deallocate(void* ptr, size_t bytes, size_t alignment);
+
+        Stats GetStats() const;
+
+    private:
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        static constexpr size_t kSizeClassCount = kMaxPooledSize / kGranularity;
+
+        static bool IsPooled(size_t bytes, size_t alignment) {
+            return bytes <= kMaxPooledSize && alignment <= kGranularity;
+        }
+        static size_t SizeClass(size_t bytes) { return (bytes + kGranularity - 1) / kGranularity - 1; }
+
+        mutable std::mutex m_mutex;
+        size_t m_chunkSize;
+        std::vector<std::unique_ptr<unsigned char[]>> m_chunks;
+        unsigned char* m_cursor = nullptr;
+        unsigned char* m_end = nullptr;
+        FreeBlock* m_freeLists[kSizeClassCount] = {};
+        Stats m_stats;
+    };
+
+    /**
+     * @brief 标准库分配器适配（用于 std::allocate_shared）
+     *
+     * 每个副本持有内存池的引用，控制块中保存的副本使内存池存活到对象释放为止。
+     */
+    template<typename T>
+    class Allocator {
+    public:
+        using value_type = T;
+
+        explicit Allocator(std::shared_ptr<Arena> arena) : m_arena(std::move(arena)) {}
+        template<typename U>
+        Allocator(const Allocator<U>& other) : m_arena(other.GetArena()) {}
+
+        T* allocate(size_t n) {
+            return static_cast<T*>(m_arena->Allocate(n * sizeof(T), alignof(T)));
+        }
+        void deallocate(T* ptr, size_t n) {
+            m_arena->Deallocate(ptr, n * sizeof(T), alignof(T));
+        }
+
+        const std::shared_ptr<Arena>& GetArena() const { return m_arena; }
+
+        template<typename U>
+        bool operator==(const Allocator<U>& other) const { return m_arena == other.GetArena(); }
+        template<typename U>
+        bool operator!=(const Allocator<U>& other) const { return m_arena != other.GetArena(); }
+
+    private:
+        std::shared_ptr<Arena> m_arena;
+    };
+
+    explicit AllocationContext(size_t chunkSize = kDefaultChunkSize);
+
+    AllocationContext(const AllocationContext&) = delete;
+    AllocationContext& operator=(const AllocationContext&) = delete;
+
+    /** @brief 在上下文的内存池中创建对象（对象与控制块一次分配） */
+    template<typename T, typename... Args>
+    std::shared_ptr<T> MakeShared(Args&&... args) {
+        return std::allocate_shared<T>(Allocator<T>(m_arena), std::forward<Args>(args)...);
+    }
+
+    /** @brief 分配次数与字节数统计 */
+    Stats GetStats() const { return m_arena->GetStats(); }
+
+    /** @brief 当前线程上生效的上下文（没有时为 nullptr） */
+    static AllocationContext* GetCurrent();
+
+    /**
+     * @brief 分配范围：范围内的 MakeControl 使用指定上下文
+     *
+     * context 为 nullptr 时保持外层范围的上下文不变。
+     */
+    class Scope {
+    public:
+        explicit Scope(AllocationContext* context);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        AllocationContext* m_previous;
+    };
+
+private:
+    std::shared_ptr<Arena> m_arena;
+};
+
+/**
+ * @brief 创建控件：当前线程有分配上下文时从其内存池分配，否则使用 std::make_shared
+ */
+template<typename T, typename... Args>
+std::shared_ptr<T> MakeControl(Args&&... args) {
+    if (auto* context = AllocationContext::GetCurrent()) {
+        return context->MakeShared<T>(std::forward<Args>(args)...);
+    }
+    return std::make_shared<T>(std::forward<Args>(args)...);
+}
+
+} // namespace luaui
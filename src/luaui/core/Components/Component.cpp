@@ -3,16 +3,30 @@
 namespace luaui {
 namespace components {
 
-void ComponentHolder::InitializeAll() {
-    for (auto& [type, component] : m_components) {
-        component->Initialize();
+ComponentHolder::~ComponentHolder() {
+    m_overflow.reset();
+    for (int slot = static_cast<int>(kStandardComponentSlotCount) - 1; slot >= 0; --slot) {
+        DestroySlot(slot);
     }
 }
 
-void ComponentHolder::ShutdownAll() {
-    for (auto& [type, component] : m_components) {
-        component->Shutdown();
+void ComponentHolder::DestroySlot(int slot) {
+    Slot& entry = m_slots[slot];
+    if (!entry.component) return;
+    if (entry.inlined) {
+        entry.component->~Component();
+    } else {
+        delete entry.component;
     }
+    entry = Slot();
+}
+
+void ComponentHolder::InitializeAll() {
+    ForEachComponent([](Component* component) { component->Initialize(); });
+}
+
+void ComponentHolder::ShutdownAll() {
+    ForEachComponent([](Component* component) { component->Shutdown(); });
 }
 
 } // namespace components
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <unordered_map>
+#include <new>
+#include <type_traits>
 #include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
 
 namespace luaui {
 
@@ -34,55 +39,157 @@ protected:
     Control* m_owner;
 };
 
+class LayoutComponent;
+class RenderComponent;
+class InputComponent;
+
+/**
+ * @brief 标准组件的固定槽位（编译期 ID）
+ *
+ * 标准组件类通过静态成员 kComponentSlot 声明自己的槽位，派生类继承同一槽位，
+ * 因此 PanelLayoutComponent 与 LayoutComponent 占用同一个槽位。
+ */
+enum class ComponentSlot : uint8_t {
+    Layout,
+    Render,
+    Input,
+};
+
+constexpr size_t kStandardComponentSlotCount = 3;
+
+// 各槽位内联缓冲区大小（字节），覆盖标准组件及 Panel 的派生组件
+inline constexpr size_t kComponentInlineCapacity[kStandardComponentSlotCount] = { 64, 224, 64 };
+
+constexpr size_t ComponentInlineOffset(size_t slot) {
+    size_t offset = 0;
+    for (size_t i = 0; i < slot; ++i) offset += kComponentInlineCapacity[i];
+    return offset;
+}
+
+static_assert(kComponentInlineCapacity[0] % alignof(std::max_align_t) == 0 &&
+              kComponentInlineCapacity[1] % alignof(std::max_align_t) == 0,
+              "inline slots must stay aligned");
+
+template<ComponentSlot S> struct StandardComponent;
+template<> struct StandardComponent<ComponentSlot::Layout> { using type = LayoutComponent; };
+template<> struct StandardComponent<ComponentSlot::Render> { using type = RenderComponent; };
+template<> struct StandardComponent<ComponentSlot::Input> { using type = InputComponent; };
+
+// T 的槽位下标；不是标准组件时为 -1
+template<typename T, typename = void>
+struct ComponentSlotOf {
+    static constexpr int value = -1;
+};
+
+template<typename T>
+struct ComponentSlotOf<T, std::void_t<decltype(T::kComponentSlot)>> {
+    static constexpr int value = static_cast<int>(T::kComponentSlot);
+};
+
 /**
  * @brief 组件持有者
  * 
- * 管理组件的生命周期和访问
+ * 管理组件的生命周期和访问。
+ *
+ * 标准组件（布局、渲染、输入）直接构造在持有者内部的定长缓冲区中，随 Control 一起分配，
+ * 访问只是一次按槽位下标的读取；超出缓冲区大小的派生组件退回到堆分配，槽位不变。
+ * 其他自定义组件放在按需创建的溢出表中，按 typeid 查找。
+ *
+ * 按标准组件基类获取时返回槽位中的任意派生组件；按派生类型获取时要求类型完全一致。
  */
 class ComponentHolder {
 public:
+    ComponentHolder() = default;
+    ~ComponentHolder();
+
+    ComponentHolder(const ComponentHolder&) = delete;
+    ComponentHolder& operator=(const ComponentHolder&) = delete;
+
     template<typename T, typename... Args>
     T* AddComponent(Args&&... args) {
         static_assert(std::is_base_of_v<Component, T>, "T must derive from Component");
-        auto component = std::make_unique<T>(std::forward<Args>(args)...);
-        T* ptr = component.get();
-        m_components[typeid(T)] = std::move(component);
-        return ptr;
+        constexpr int slot = ComponentSlotOf<T>::value;
+        if constexpr (slot >= 0) {
+            DestroySlot(slot);
+            T* ptr;
+            if constexpr (sizeof(T) <= kComponentInlineCapacity[slot] && alignof(T) <= alignof(std::max_align_t)) {
+                ptr = new (InlineStorage(slot)) T(std::forward<Args>(args)...);
+                m_slots[slot].inlined = true;
+            } else {
+                ptr = new T(std::forward<Args>(args)...);
+                m_slots[slot].inlined = false;
+            }
+            m_slots[slot].component = ptr;
+            m_slots[slot].type = &typeid(T);
+            return ptr;
+        } else {
+            if (!m_overflow) {
+                m_overflow = std::make_unique<OverflowMap>();
+            }
+            auto component = std::make_unique<T>(std::forward<Args>(args)...);
+            T* ptr = component.get();
+            (*m_overflow)[typeid(T)] = std::move(component);
+            return ptr;
+        }
     }
     
     template<typename T>
     T* GetComponent() {
-        auto it = m_components.find(typeid(T));
-        if (it != m_components.end()) {
-            return static_cast<T*>(it->second.get());
-        }
-        return nullptr;
+        return const_cast<T*>(static_cast<const ComponentHolder*>(this)->GetComponent<T>());
     }
     
     template<typename T>
     const T* GetComponent() const {
-        auto it = m_components.find(typeid(T));
-        if (it != m_components.end()) {
-            return static_cast<const T*>(it->second.get());
+        constexpr int slot = ComponentSlotOf<T>::value;
+        if constexpr (slot >= 0) {
+            const Slot& entry = m_slots[slot];
+            using Base = typename StandardComponent<static_cast<ComponentSlot>(slot)>::type;
+            if constexpr (std::is_same_v<T, Base>) {
+                return static_cast<const T*>(entry.component);
+            } else {
+                return entry.type && *entry.type == typeid(T) ? static_cast<const T*>(entry.component) : nullptr;
+            }
+        } else {
+            if (!m_overflow) return nullptr;
+            auto it = m_overflow->find(typeid(T));
+            return it != m_overflow->end() ? static_cast<const T*>(it->second.get()) : nullptr;
         }
-        return nullptr;
     }
     
     template<typename T>
     bool HasComponent() const {
-        return m_components.find(typeid(T)) != m_components.end();
+        return GetComponent<T>() != nullptr;
     }
     
-    // 获取所有组件（用于遍历）
-    const std::unordered_map<std::type_index, std::unique_ptr<Component>>& GetComponents() const {
-        return m_components;
+    // 遍历所有组件：先标准槽位，再溢出表
+    template<typename Fn>
+    void ForEachComponent(Fn&& fn) const {
+        for (const Slot& entry : m_slots) {
+            if (entry.component) fn(entry.component);
+        }
+        if (m_overflow) {
+            for (auto& [type, component] : *m_overflow) fn(component.get());
+        }
     }
     
     void InitializeAll();
     void ShutdownAll();
     
 private:
-    std::unordered_map<std::type_index, std::unique_ptr<Component>> m_components;
+    using OverflowMap = std::unordered_map<std::type_index, std::unique_ptr<Component>>;
+
+    struct Slot {
+        Component* component = nullptr;
+        const std::type_info* type = nullptr;
+        bool inlined = false;
+    };
+
+    void* InlineStorage(int slot) { return m_inline + ComponentInlineOffset(slot); }
+    void DestroySlot(int slot);
+
+    alignas(std::max_align_t) unsigned char m_inline[ComponentInlineOffset(kStandardComponentSlotCount)];
+    Slot m_slots[kStandardComponentSlotCount];
+    std::unique_ptr<OverflowMap> m_overflow;
 };
 
 } // namespace components
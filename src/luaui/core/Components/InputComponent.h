@@ -25,6 +25,8 @@ using namespace luaui::interfaces;
  */
 class InputComponent : public Component, public IInputHandler, public IFocusable {
 public:
+    static constexpr ComponentSlot kComponentSlot = ComponentSlot::Input;
+
     InputComponent(Control* owner);
     
     // ========== IFocusable 实现 ==========
@@ -2,31 +2,195 @@
 #include "Control.h"
 #include "Components/RenderComponent.h"
 #include "Window.h"
+#include "FrameProfiler.h"
+#include "WorkStealingPool.h"
+#include <atomic>
+#include <mutex>
+#include <utility>
 
 namespace luaui {
 namespace components {
 
-LayoutComponent::LayoutComponent(Control* owner) : Component(owner) {}
+namespace {
+
+std::atomic<uint64_t> s_measureCacheHits{0};
+std::atomic<uint64_t> s_measureCacheMisses{0};
+
+// 本线程上 Measure 的调用次数，用于判断一次 MeasureOverride 是否测量过子控件
+thread_local uint64_t t_measureCalls = 0;
+
+// 当前布局阶段使用的线程池（nullptr 为顺序测量）
+std::atomic<WorkStealingPool*> s_parallelPool{nullptr};
+
+// 每个工作线程（含调用线程）分到的块数，块越多窃取越均衡
+constexpr size_t kChunksPerThread = 4;
+
+// 并行测量期间记下的失效，最外层 MeasureChildren 返回 UI 线程后执行
+using DeferredEntry = std::pair<std::weak_ptr<Control>, LayoutComponent::DeferredInvalidation>;
+std::mutex s_deferredMutex;
+std::vector<DeferredEntry> s_deferred;
+
+void FlushDeferredInvalidations() {
+    std::vector<DeferredEntry> pending;
+    {
+        std::lock_guard<std::mutex> lock(s_deferredMutex);
+        pending.swap(s_deferred);
+    }
+    for (auto& entry : pending) {
+        auto control = entry.first.lock();
+        if (!control) continue;
+        switch (entry.second) {
+            case LayoutComponent::DeferredInvalidation::Measure:
+                if (auto* layout = control->GetLayout()) layout->InvalidateMeasure();
+                break;
+            case LayoutComponent::DeferredInvalidation::Arrange:
+                if (auto* layout = control->GetLayout()) layout->InvalidateArrange();
+                break;
+            case LayoutComponent::DeferredInvalidation::Render:
+                if (auto* render = control->GetRender()) render->Invalidate();
+                break;
+        }
+    }
+}
+
+} // anonymous namespace
+
+LayoutComponent::LayoutComponent(Control* owner) : Component(owner) {
+    auto& store = LayoutStore::Shared();
+    uint32_t slot = store.Allocate(this, owner ? owner->GetID() : 0);
+    BindSlot(slot, store.GetChunk(slot));
+}
+
+LayoutComponent::~LayoutComponent() {
+    LayoutStore::Shared().Release(m_slot);
+}
 
 rendering::Size LayoutComponent::Measure(const LayoutConstraint& constraint) {
-    if (!IsMeasureValid() || 
-        constraint.available.width != m_lastAvailableSize.width ||
-        constraint.available.height != m_lastAvailableSize.height) {
-        m_desiredSize = MeasureOverride(constraint.available);
-        m_lastAvailableSize = constraint.available;
-        m_lastConstraint = constraint;
-        m_measureValid = true;
+    ++t_measureCalls;
+    m_chunk->lastConstraint[m_index] = constraint;
+    rendering::Size& desired = m_chunk->desired[m_index];
+    
+    if (!IsMeasureValid()) {
+        ClearMeasureCache();
+    } else if (auto* entry = FindMeasureCacheEntry(constraint.available)) {
+        s_measureCacheHits.fetch_add(1, std::memory_order_relaxed);
+        desired = entry->desired;
+        return desired;
+    }
+    
+    s_measureCacheMisses.fetch_add(1, std::memory_order_relaxed);
+    MeasureCacheEntry entry;
+    entry.available = constraint.available;
+    {
+        FrameProfiler::ControlScope profile(m_owner, ProfileCost::Measure);
+        uint64_t callsBefore = t_measureCalls;
+        entry.desired = MeasureOverride(constraint.available);
+        entry.dependsOnChildren = t_measureCalls != callsBefore;
     }
-    return m_desiredSize;
+    StoreMeasureCacheEntry(entry);
+    desired = entry.desired;
+    SetFlag(LayoutStore::MeasureValid, true);
+    return desired;
+}
+
+const LayoutComponent::MeasureCacheEntry* LayoutComponent::FindMeasureCacheEntry(
+    const rendering::Size& available) const {
+    const auto& cache = m_chunk->measureCache[m_index];
+    for (int i = 0; i < cache.count; ++i) {
+        const auto& entry = cache.entries[i];
+        if (entry.available.width != available.width || entry.available.height != available.height) continue;
+        // 子控件的 DesiredSize 可能已被其他约束下的测量覆盖
+        if (entry.dependsOnChildren && i != cache.latest) return nullptr;
+        return &entry;
+    }
+    return nullptr;
+}
+
+void LayoutComponent::StoreMeasureCacheEntry(const MeasureCacheEntry& entry) {
+    // 同一约束重新计算（容器的过期条目）时就地替换
+    auto& cache = m_chunk->measureCache[m_index];
+    int slot = -1;
+    for (int i = 0; i < cache.count; ++i) {
+        if (cache.entries[i].available.width == entry.available.width &&
+            cache.entries[i].available.height == entry.available.height) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot < 0) {
+        if (cache.count < kMeasureCacheSize) {
+            slot = cache.count++;
+        } else {
+            slot = cache.next;
+            cache.next = static_cast<uint8_t>((cache.next + 1) % kMeasureCacheSize);
+        }
+    }
+    cache.entries[slot] = entry;
+    cache.latest = static_cast<int8_t>(slot);
+}
+
+void LayoutComponent::MeasureChildren(std::vector<ChildMeasure>& children) {
+    // 子控件可能在其他线程上测量，调用方的缓存条目同样依赖子控件
+    ++t_measureCalls;
+    
+    auto* pool = s_parallelPool.load(std::memory_order_acquire);
+    if (!pool || children.size() < 2) {
+        for (auto& child : children) {
+            child.desired = child.layout->Measure(child.constraint);
+        }
+        return;
+    }
+    
+    pool->ParallelFor(children.size(), (pool->GetWorkerCount() + 1) * kChunksPerThread,
+        [&children](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                children[i].desired = children[i].layout->Measure(children[i].constraint);
+            }
+        });
+    
+    // 嵌套的并行测量仍在池任务内，留给最外层统一执行
+    if (!WorkStealingPool::IsInTask()) {
+        FlushDeferredInvalidations();
+    }
+}
+
+bool LayoutComponent::DeferIfInTask(Control* owner, DeferredInvalidation kind) {
+    if (!owner || !WorkStealingPool::IsInTask()) return false;
+    std::lock_guard<std::mutex> lock(s_deferredMutex);
+    s_deferred.emplace_back(owner->weak_from_this(), kind);
+    return true;
+}
+
+LayoutComponent::ParallelMeasureScope::ParallelMeasureScope(WorkStealingPool* pool)
+    : m_previous(s_parallelPool.exchange(pool, std::memory_order_acq_rel)) {}
+
+LayoutComponent::ParallelMeasureScope::~ParallelMeasureScope() {
+    s_parallelPool.store(m_previous, std::memory_order_release);
+}
+
+LayoutComponent::MeasureCacheStats LayoutComponent::GetMeasureCacheStats() {
+    MeasureCacheStats stats;
+    stats.hits = s_measureCacheHits.load(std::memory_order_relaxed);
+    stats.misses = s_measureCacheMisses.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void LayoutComponent::ResetMeasureCacheStats() {
+    s_measureCacheHits.store(0, std::memory_order_relaxed);
+    s_measureCacheMisses.store(0, std::memory_order_relaxed);
 }
 
 void LayoutComponent::Arrange(const rendering::Rect& finalRect) {
+    m_chunk->lastArrangeRect[m_index] = finalRect;
+    SetFlag(LayoutStore::HasArranged, true);
+    
     // 应用 Margin：调整最终矩形
+    const auto& margin = Margin();
     rendering::Rect contentRect(
-        finalRect.x + m_marginLeft,
-        finalRect.y + m_marginTop,
-        finalRect.width - m_marginLeft - m_marginRight,
-        finalRect.height - m_marginTop - m_marginBottom
+        finalRect.x + margin.left,
+        finalRect.y + margin.top,
+        finalRect.width - margin.left - margin.right,
+        finalRect.height - margin.top - margin.bottom
     );
 
     // 确保大小不为负
@@ -36,100 +200,133 @@ void LayoutComponent::Arrange(const rendering::Rect& finalRect) {
     // 更新渲染矩形（使用调整后的矩形）
     if (m_owner) {
         if (auto* render = m_owner->GetRender()) {
-            render->GetRenderRect() = contentRect;
+            rendering::Rect& renderRect = render->GetRenderRect();
+            bool moved = renderRect.x != contentRect.x || renderRect.y != contentRect.y ||
+                         renderRect.width != contentRect.width || renderRect.height != contentRect.height;
+            renderRect = contentRect;
+            
+            // 位置或尺寸变化：只重绘旧位置和新位置，而不是整个窗口
+            if (moved) {
+                render->InvalidateBounds();
+            }
         }
     }
 
     if (!IsArrangeValid()) {
+        FrameProfiler::ControlScope profile(m_owner, ProfileCost::Arrange);
         ArrangeOverride(rendering::Size(contentRect.width, contentRect.height));
-        m_arrangeValid = true;
+        SetFlag(LayoutStore::ArrangeValid, true);
     }
 }
 
 void LayoutComponent::SetWidth(float width) {
-    m_width = width;
+    Constraints().width = width;
     InvalidateMeasure();
+    InvalidateParentMeasure();
 }
 
 void LayoutComponent::SetHeight(float height) {
-    m_height = height;
+    Constraints().height = height;
     InvalidateMeasure();
+    InvalidateParentMeasure();
 }
 
 void LayoutComponent::SetMargin(float left, float top, float right, float bottom) {
-    m_marginLeft = left;
-    m_marginTop = top;
-    m_marginRight = right;
-    m_marginBottom = bottom;
+    Margin() = LayoutStore::Thickness{left, top, right, bottom};
     InvalidateMeasure();
+    InvalidateParentMeasure();
 }
 
 void LayoutComponent::SetPadding(float left, float top, float right, float bottom) {
-    m_paddingLeft = left;
-    m_paddingTop = top;
-    m_paddingRight = right;
-    m_paddingBottom = bottom;
+    Padding() = LayoutStore::Thickness{left, top, right, bottom};
     InvalidateMeasure();
 }
 
 void LayoutComponent::SetHorizontalAlignment(HorizontalAlignment align) {
-    m_hAlignment = align;
+    m_chunk->alignment[m_index].horizontal = align;
     InvalidateArrange();
+    InvalidateParentArrange();   // 对齐方式由父控件排列时使用
 }
 
 void LayoutComponent::SetVerticalAlignment(VerticalAlignment align) {
-    m_vAlignment = align;
+    m_chunk->alignment[m_index].vertical = align;
     InvalidateArrange();
+    InvalidateParentArrange();   // 对齐方式由父控件排列时使用
 }
 
 void LayoutComponent::InvalidateMeasure() {
-    if (!m_measureValid) return;  // 已经失效，避免重复冒泡
+    if (DeferIfInTask(m_owner, DeferredInvalidation::Measure)) return;
+    if (!IsMeasureValid()) return;  // 已经失效，避免重复冒泡
+    
+    SetFlag(LayoutStore::MeasureValid | LayoutStore::ArrangeValid, false);
+    m_chunk->dirty[m_index] = LayoutDirty::Measure;
+    ClearMeasureCache();
     
-    m_measureValid = false;
-    m_arrangeValid = false;
-    m_dirty = LayoutDirty::Measure;
+    // 布局边界：期望尺寸不变，只需单独重新布局本子树
+    if (EnqueueAsLayoutRoot()) return;
     
     // 冒泡到父控件
-    if (m_owner) {
-        if (auto parent = m_owner->GetParent()) {
-            if (auto* parentLayout = static_cast<Control*>(parent.get())->AsLayoutable()) {
-                parentLayout->InvalidateMeasure();
-            }
-        } else {
-            // 没有父控件，说明是根控件，通知窗口需要重新布局
-            if (auto* window = m_owner->GetWindow()) {
-                window->InvalidateLayout();
-            }
+    InvalidateParentMeasure();
+}
+
+void LayoutComponent::InvalidateParentMeasure() {
+    if (!m_owner) return;
+    if (auto parent = m_owner->GetParent()) {
+        if (auto* parentLayout = static_cast<Control*>(parent.get())->AsLayoutable()) {
+            parentLayout->InvalidateMeasure();
+        }
+    } else {
+        // 没有父控件，说明是根控件，通知窗口需要重新布局
+        if (auto* window = m_owner->GetWindow()) {
+            window->InvalidateLayout();
         }
     }
 }
 
+bool LayoutComponent::EnqueueAsLayoutRoot() {
+    // 根控件和未排列过的控件照常冒泡（没有可复用的约束）
+    if (!m_owner || !HasArranged() || !IsLayoutBoundary() || !m_owner->GetParent()) return false;
+    auto* window = m_owner->GetWindow();
+    if (!window) return false;
+    window->InvalidateLayoutSubtree(m_owner);
+    return true;
+}
+
 void LayoutComponent::InvalidateArrange() {
-    if (!m_arrangeValid) return;  // 已经失效，避免重复冒泡
+    if (DeferIfInTask(m_owner, DeferredInvalidation::Arrange)) return;
+    if (!IsArrangeValid()) return;  // 已经失效，避免重复冒泡
+    
+    SetFlag(LayoutStore::ArrangeValid, false);
+    m_chunk->dirty[m_index] = LayoutDirty::Arrange;
     
-    m_arrangeValid = false;
-    m_dirty = LayoutDirty::Arrange;
+    if (EnqueueAsLayoutRoot()) return;
     
     // 冒泡到父控件
-    if (m_owner) {
-        if (auto parent = m_owner->GetParent()) {
-            if (auto* parentLayout = static_cast<Control*>(parent.get())->AsLayoutable()) {
-                parentLayout->InvalidateArrange();
-            }
-        } else {
-            // 没有父控件，说明是根控件，通知窗口需要重新布局
-            if (auto* window = m_owner->GetWindow()) {
-                window->InvalidateLayout();
-            }
+    InvalidateParentArrange();
+}
+
+void LayoutComponent::InvalidateParentArrange() {
+    if (!m_owner) return;
+    if (auto parent = m_owner->GetParent()) {
+        if (auto* parentLayout = static_cast<Control*>(parent.get())->AsLayoutable()) {
+            parentLayout->InvalidateArrange();
+        }
+    } else {
+        // 没有父控件，说明是根控件，通知窗口需要重新布局
+        if (auto* window = m_owner->GetWindow()) {
+            window->InvalidateLayout();
         }
     }
 }
 
 rendering::Size LayoutComponent::MeasureOverride(const rendering::Size& availableSize) {
+    const auto& margin = Margin();
+    const auto& constraints = Constraints();
+    
     // 从可用空间中减去 Margin
     rendering::Size availableForContent(
-        availableSize.width - m_marginLeft - m_marginRight,
-        availableSize.height - m_marginTop - m_marginBottom
+        availableSize.width - margin.left - margin.right,
+        availableSize.height - margin.top - margin.bottom
     );
 
     // 确保可用空间不为负
@@ -138,31 +335,31 @@ rendering::Size LayoutComponent::MeasureOverride(const rendering::Size& availabl
 
     // 默认实现：返回固定大小或约束大小
     rendering::Size desiredSize(0, 0);
-    if (m_width > 0 && m_height > 0) {
-        desiredSize = rendering::Size(m_width, m_height);
+    if (constraints.width > 0 && constraints.height > 0) {
+        desiredSize = rendering::Size(constraints.width, constraints.height);
     } else if (m_owner) {
         // 尝试调用 Control 的 OnMeasure 方法
         desiredSize = m_owner->OnMeasure(availableForContent);
     }
 
     // 应用 MinWidth/MaxWidth 约束
-    if (m_minWidth > 0.0f) {
-        desiredSize.width = std::max(desiredSize.width, m_minWidth);
+    if (constraints.minWidth > 0.0f) {
+        desiredSize.width = std::max(desiredSize.width, constraints.minWidth);
     }
-    if (m_maxWidth > 0.0f && m_maxWidth < 99990.0f) {
-        desiredSize.width = std::min(desiredSize.width, m_maxWidth);
+    if (constraints.maxWidth > 0.0f && constraints.maxWidth < 99990.0f) {
+        desiredSize.width = std::min(desiredSize.width, constraints.maxWidth);
     }
-    if (m_minHeight > 0.0f) {
-        desiredSize.height = std::max(desiredSize.height, m_minHeight);
+    if (constraints.minHeight > 0.0f) {
+        desiredSize.height = std::max(desiredSize.height, constraints.minHeight);
     }
-    if (m_maxHeight > 0.0f && m_maxHeight < 99990.0f) {
-        desiredSize.height = std::min(desiredSize.height, m_maxHeight);
+    if (constraints.maxHeight > 0.0f && constraints.maxHeight < 99990.0f) {
+        desiredSize.height = std::min(desiredSize.height, constraints.maxHeight);
     }
 
     // 将 Margin 加回到期望大小
     return rendering::Size(
-        desiredSize.width + m_marginLeft + m_marginRight,
-        desiredSize.height + m_marginTop + m_marginBottom
+        desiredSize.width + margin.left + margin.right,
+        desiredSize.height + margin.top + margin.bottom
     );
 }
 
@@ -1,12 +1,16 @@
 #pragma once
 
 #include "Components/Component.h"
+#include "Components/LayoutStore.h"
 #include "Interfaces/ILayoutable.h"
+#include <cstdint>
 #include <limits>
+#include <vector>
 
 namespace luaui {
 
 class Control;
+class WorkStealingPool;
 
 namespace components {
 
@@ -17,50 +21,58 @@ using namespace luaui::interfaces;
  * 
  * 将布局相关状态和行为从 Control 中分离
  * 符合 SRP：只负责布局计算和状态管理
+ *
+ * 状态本身存放在 LayoutStore 的结构数组中，本对象只持有槽位并提供访问接口。
  */
 class LayoutComponent : public Component, public ILayoutable {
 public:
+    static constexpr ComponentSlot kComponentSlot = ComponentSlot::Layout;
+
     LayoutComponent(Control* owner);
+    ~LayoutComponent() override;
+    
+    LayoutComponent(const LayoutComponent&) = delete;
+    LayoutComponent& operator=(const LayoutComponent&) = delete;
     
     // ========== ILayoutable 实现 ==========
     rendering::Size Measure(const LayoutConstraint& constraint) override;
     void Arrange(const rendering::Rect& finalRect) override;
     
-    rendering::Size GetDesiredSize() const override { return m_desiredSize; }
+    rendering::Size GetDesiredSize() const override { return m_chunk->desired[m_index]; }
     
-    float GetWidth() const override { return m_width; }
-    float GetHeight() const override { return m_height; }
+    float GetWidth() const override { return Constraints().width; }
+    float GetHeight() const override { return Constraints().height; }
     void SetWidth(float width) override;
     void SetHeight(float height) override;
     
-    float GetMinWidth() const override { return m_minWidth; }
-    float GetMinHeight() const override { return m_minHeight; }
-    void SetMinWidth(float value) override { m_minWidth = value; }
-    void SetMinHeight(float value) override { m_minHeight = value; }
+    float GetMinWidth() const override { return Constraints().minWidth; }
+    float GetMinHeight() const override { return Constraints().minHeight; }
+    void SetMinWidth(float value) override { Constraints().minWidth = value; }
+    void SetMinHeight(float value) override { Constraints().minHeight = value; }
     
-    float GetMaxWidth() const override { return m_maxWidth; }
-    float GetMaxHeight() const override { return m_maxHeight; }
-    void SetMaxWidth(float value) override { m_maxWidth = value; }
-    void SetMaxHeight(float value) override { m_maxHeight = value; }
+    float GetMaxWidth() const override { return Constraints().maxWidth; }
+    float GetMaxHeight() const override { return Constraints().maxHeight; }
+    void SetMaxWidth(float value) override { Constraints().maxWidth = value; }
+    void SetMaxHeight(float value) override { Constraints().maxHeight = value; }
 
-    float GetMarginLeft() const override { return m_marginLeft; }
-    float GetMarginTop() const override { return m_marginTop; }
-    float GetMarginRight() const override { return m_marginRight; }
-    float GetMarginBottom() const override { return m_marginBottom; }
+    float GetMarginLeft() const override { return Margin().left; }
+    float GetMarginTop() const override { return Margin().top; }
+    float GetMarginRight() const override { return Margin().right; }
+    float GetMarginBottom() const override { return Margin().bottom; }
     void SetMargin(float left, float top, float right, float bottom) override;
     
-    float GetPaddingLeft() const override { return m_paddingLeft; }
-    float GetPaddingTop() const override { return m_paddingTop; }
-    float GetPaddingRight() const override { return m_paddingRight; }
-    float GetPaddingBottom() const override { return m_paddingBottom; }
+    float GetPaddingLeft() const override { return Padding().left; }
+    float GetPaddingTop() const override { return Padding().top; }
+    float GetPaddingRight() const override { return Padding().right; }
+    float GetPaddingBottom() const override { return Padding().bottom; }
     void SetPadding(float left, float top, float right, float bottom) override;
 
-    HorizontalAlignment GetHorizontalAlignment() const override { return m_hAlignment; }
-    VerticalAlignment GetVerticalAlignment() const override { return m_vAlignment; }
+    HorizontalAlignment GetHorizontalAlignment() const override { return m_chunk->alignment[m_index].horizontal; }
+    VerticalAlignment GetVerticalAlignment() const override { return m_chunk->alignment[m_index].vertical; }
     void SetHorizontalAlignment(HorizontalAlignment align) override;
     void SetVerticalAlignment(VerticalAlignment align) override;
 
-    LayoutDirty GetDirtyState() const override { return m_dirty; }
+    LayoutDirty GetDirtyState() const override { return m_chunk->dirty[m_index]; }
     void InvalidateMeasure() override;
     void InvalidateArrange() override;
 
@@ -69,34 +81,146 @@ public:
     virtual rendering::Size ArrangeOverride(const rendering::Size& finalSize);
     
     // ========== 状态查询 ==========
-    bool IsMeasureValid() const { return m_measureValid; }
-    bool IsArrangeValid() const { return m_arrangeValid; }
-    void ClearDirty() { m_dirty = LayoutDirty::None; }
+    bool IsMeasureValid() const { return HasFlag(LayoutStore::MeasureValid); }
+    bool IsArrangeValid() const { return HasFlag(LayoutStore::ArrangeValid); }
+    void ClearDirty() { m_chunk->dirty[m_index] = LayoutDirty::None; }
+    
+    // ========== 布局边界 ==========
+    /**
+     * @brief 标记为布局边界：声明本控件的期望尺寸不随内容变化
+     *
+     * 边界内部的布局失效不再冒泡到父控件，而是由窗口的 LayoutManager 在下一帧
+     * 单独重新布局该子树。同时设置了 Width 和 Height 的控件自动视为边界。
+     */
+    void SetIsLayoutBoundary(bool value) { SetFlag(LayoutStore::LayoutBoundary, value); }
+    bool IsLayoutBoundary() const {
+        return HasFlag(LayoutStore::LayoutBoundary) || (Constraints().width > 0 && Constraints().height > 0);
+    }
+    
+    /** @brief 上一次测量/排列的输入（增量布局时复用） */
+    const LayoutConstraint& GetLastConstraint() const { return m_chunk->lastConstraint[m_index]; }
+    const rendering::Rect& GetLastArrangeRect() const { return m_chunk->lastArrangeRect[m_index]; }
+    bool HasArranged() const { return HasFlag(LayoutStore::HasArranged); }
+    
+    /** @brief 是否已在增量布局队列中（由 LayoutManager 维护，入队时据此去重） */
+    bool IsLayoutQueued() const { return HasFlag(LayoutStore::LayoutQueued); }
+    void SetLayoutQueued(bool value) { SetFlag(LayoutStore::LayoutQueued, value); }
+    
+    /** @brief 在 LayoutStore 中的槽位（深度优先重排后会变化） */
+    uint32_t GetStoreSlot() const { return m_slot; }
+    
+    /** @brief 使父控件（根控件则为整个窗口）的测量失效，用于自身尺寸可能变化时 */
+    void InvalidateParentMeasure();
+    void InvalidateParentArrange();
+    
+    // ========== 测量缓存 ==========
+    /**
+     * @brief 测量缓存统计（进程级，所有控件累计）
+     */
+    struct MeasureCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+    
+    static constexpr size_t kMeasureCacheSize = LayoutStore::kMeasureCacheSize;
+    
+    static MeasureCacheStats GetMeasureCacheStats();
+    static void ResetMeasureCacheStats();
+    
+    /** @brief 当前缓存的约束条目数（测量失效时清空） */
+    size_t GetMeasureCacheCount() const { return m_chunk->measureCache[m_index].count; }
+    
+    // ========== 并行测量 ==========
+    /**
+     * @brief 一个待测量的子控件及其约束
+     */
+    struct ChildMeasure {
+        ILayoutable* layout = nullptr;
+        LayoutConstraint constraint;
+        rendering::Size desired;   // 测量结果
+    };
+    
+    /**
+     * @brief 测量一组约束互不依赖的兄弟子控件
+     *
+     * 处于 ParallelMeasureScope 内时，各子树分块提交到工作窃取线程池并发测量，
+     * 否则按顺序测量。每个子控件的结果只取决于它自己的子树和约束，写回各自的 desired，
+     * 调用方随后按原顺序汇总，因此结果与顺序测量完全一致。
+     *
+     * 并发测量期间 MeasureOverride/OnMeasure 只能读写本控件子树的状态；
+     * 首次初始化、主题读取、文本测量（TextLayoutCache、ResourceCache::GetTextFormat）已是线程安全的。
+     * 子控件对象（AsLayoutable）应在调用线程上获取，保证其已初始化。
+     * 测量期间发生的布局/渲染失效会沿父链写祖先状态并通知窗口，由 DeferIfInTask
+     * 记下，在最外层的并行测量返回 UI 线程后按发生顺序执行。
+     */
+    static void MeasureChildren(std::vector<ChildMeasure>& children);
+    
+    /** @brief 推迟到 UI 线程执行的失效种类 */
+    enum class DeferredInvalidation : uint8_t { Measure, Arrange, Render };
+    
+    /**
+     * @brief 当前线程正在执行池任务（并行测量）时记下控件的失效，稍后在 UI 线程上执行
+     * @return 已推迟时返回 true，调用方应直接返回
+     */
+    static bool DeferIfInTask(Control* owner, DeferredInvalidation kind);
+    
+    /**
+     * @brief 并行测量范围：范围内的 MeasureChildren 使用指定线程池（nullptr 为顺序测量）
+     *
+     * 由窗口在布局阶段设置，只能在 UI 线程上使用。
+     */
+    class ParallelMeasureScope {
+    public:
+        explicit ParallelMeasureScope(WorkStealingPool* pool);
+        ~ParallelMeasureScope();
+        ParallelMeasureScope(const ParallelMeasureScope&) = delete;
+        ParallelMeasureScope& operator=(const ParallelMeasureScope&) = delete;
+    private:
+        WorkStealingPool* m_previous;
+    };
 
 private:
-    // 尺寸约束
-    float m_width = 0;
-    float m_height = 0;
-    float m_minWidth = 0;
-    float m_minHeight = 0;
-    float m_maxWidth = std::numeric_limits<float>::max();
-    float m_maxHeight = std::numeric_limits<float>::max();
-    
-    // 边距
-    float m_marginLeft = 0, m_marginTop = 0, m_marginRight = 0, m_marginBottom = 0;
-    float m_paddingLeft = 0, m_paddingTop = 0, m_paddingRight = 0, m_paddingBottom = 0;
-    
-    // 对齐
-    HorizontalAlignment m_hAlignment = HorizontalAlignment::Stretch;
-    VerticalAlignment m_vAlignment = VerticalAlignment::Stretch;
-    
-    // 布局状态
-    rendering::Size m_desiredSize;
-    rendering::Size m_lastAvailableSize;
-    LayoutConstraint m_lastConstraint;
-    bool m_measureValid = false;
-    bool m_arrangeValid = false;
-    LayoutDirty m_dirty = LayoutDirty::Measure;
+    friend class LayoutStore;
+    
+    /**
+     * @brief 可用尺寸 → 期望尺寸 的缓存条目
+     *
+     * Grid 的 Auto/Star 求解、StackPanel、DataGridRow 会在一次布局中以不同约束
+     * 多次测量同一子控件，单条目缓存会反复失效。
+     *
+     * 容器的期望尺寸依赖子控件在同一次测量中得到的 DesiredSize，而排列时读取的是子控件
+     * 最近一次的结果；因此测量期间嵌套测量过其他控件的条目（dependsOnChildren）
+     * 只有在它是最近一次计算的条目时才能复用，否则重新执行 MeasureOverride
+     * （子控件各自命中缓存）。叶子控件的条目总是可以复用。
+     */
+    using MeasureCacheEntry = LayoutStore::MeasureCacheEntry;
+    
+    const MeasureCacheEntry* FindMeasureCacheEntry(const rendering::Size& available) const;
+    void StoreMeasureCacheEntry(const MeasureCacheEntry& entry);
+    void ClearMeasureCache() { m_chunk->measureCache[m_index].Clear(); }
+    
+    // 槽位字段访问
+    LayoutStore::SizeConstraints& Constraints() const { return m_chunk->constraints[m_index]; }
+    LayoutStore::Thickness& Margin() const { return m_chunk->margin[m_index]; }
+    LayoutStore::Thickness& Padding() const { return m_chunk->padding[m_index]; }
+    bool HasFlag(uint8_t flag) const { return (m_chunk->flags[m_index] & flag) != 0; }
+    void SetFlag(uint8_t flag, bool value) {
+        uint8_t& flags = m_chunk->flags[m_index];
+        flags = value ? static_cast<uint8_t>(flags | flag) : static_cast<uint8_t>(flags & ~flag);
+    }
+    
+    /** @brief 由 LayoutStore 在分配和重排时调用 */
+    void BindSlot(uint32_t slot, LayoutStore::Chunk* chunk) {
+        m_slot = slot;
+        m_chunk = chunk;
+        m_index = LayoutStore::IndexInChunk(slot);
+    }
+    
+    uint32_t m_slot = LayoutStore::kInvalidSlot;
+    LayoutStore::Chunk* m_chunk = nullptr;
+    uint32_t m_index = 0;
+    
+    bool EnqueueAsLayoutRoot();
 };
 
 } // namespace components
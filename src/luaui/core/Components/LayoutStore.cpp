@@ -0,0 +1,187 @@
+#include "Components/LayoutStore.h"
+#include "Components/LayoutComponent.h"
+#include "Control.h"
+#include <algorithm>
+
+namespace luaui {
+namespace components {
+
+struct LayoutStore::Entry {
+    SizeConstraints constraints;
+    Thickness margin;
+    Thickness padding;
+    Alignment alignment;
+    rendering::Size desired;
+    uint8_t flags = 0;
+    LayoutDirty dirty = LayoutDirty::Measure;
+    interfaces::LayoutConstraint lastConstraint;
+    rendering::Rect lastArrangeRect;
+    MeasureCache measureCache;
+    LayoutComponent* owner = nullptr;
+    ControlID id = 0;
+};
+
+LayoutStore& LayoutStore::Shared() {
+    // 不析构：静态对象中的控件可能在退出时晚于存储销毁
+    static LayoutStore* s_store = new LayoutStore();
+    return *s_store;
+}
+
+uint32_t LayoutStore::Allocate(LayoutComponent* owner, ControlID id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    uint32_t slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        slot = m_nextSlot++;
+        if (slot / kChunkSize >= m_chunks.size()) {
+            m_chunks.push_back(std::make_unique<Chunk>());
+        }
+    }
+
+    Reset(slot);
+    Chunk& chunk = *m_chunks[slot / kChunkSize];
+    chunk.owner[IndexInChunk(slot)] = owner;
+    chunk.id[IndexInChunk(slot)] = id;
+    m_slotsById[id] = slot;
+    ++m_structureChanges;
+    return slot;
+}
+
+void LayoutStore::Release(uint32_t slot) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (slot >= m_nextSlot) return;
+
+    Chunk& chunk = *m_chunks[slot / kChunkSize];
+    uint32_t index = IndexInChunk(slot);
+    auto it = m_slotsById.find(chunk.id[index]);
+    if (it != m_slotsById.end() && it->second == slot) {
+        m_slotsById.erase(it);
+    }
+    m_reorders.erase(chunk.id[index]);
+    chunk.owner[index] = nullptr;
+    m_freeSlots.push_back(slot);
+    ++m_structureChanges;
+}
+
+LayoutStore::Chunk* LayoutStore::GetChunk(uint32_t slot) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return slot < m_nextSlot ? m_chunks[slot / kChunkSize].get() : nullptr;
+}
+
+uint32_t LayoutStore::FindSlot(ControlID id) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_slotsById.find(id);
+    return it != m_slotsById.end() ? it->second : kInvalidSlot;
+}
+
+size_t LayoutStore::GetLiveCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_nextSlot - m_freeSlots.size();
+}
+
+size_t LayoutStore::GetCapacity() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_chunks.size() * kChunkSize;
+}
+
+void LayoutStore::NotifyStructureChanged() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_structureChanges;
+}
+
+bool LayoutStore::NeedsReorder(Control* root) const {
+    if (!root) return false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_reorders.find(root->GetID());
+    if (it == m_reorders.end()) return true;
+    return (m_structureChanges - it->second.changes) * 8 >= it->second.size;
+}
+
+void LayoutStore::Reset(uint32_t slot) {
+    Entry defaults;
+    Store(slot, defaults);
+}
+
+LayoutStore::Entry LayoutStore::Load(uint32_t slot) const {
+    const Chunk& chunk = *m_chunks[slot / kChunkSize];
+    uint32_t i = IndexInChunk(slot);
+    Entry entry;
+    entry.constraints = chunk.constraints[i];
+    entry.margin = chunk.margin[i];
+    entry.padding = chunk.padding[i];
+    entry.alignment = chunk.alignment[i];
+    entry.desired = chunk.desired[i];
+    entry.flags = chunk.flags[i];
+    entry.dirty = chunk.dirty[i];
+    entry.lastConstraint = chunk.lastConstraint[i];
+    entry.lastArrangeRect = chunk.lastArrangeRect[i];
+    entry.measureCache = chunk.measureCache[i];
+    entry.owner = chunk.owner[i];
+    entry.id = chunk.id[i];
+    return entry;
+}
+
+void LayoutStore::Store(uint32_t slot, const Entry& entry) {
+    Chunk& chunk = *m_chunks[slot / kChunkSize];
+    uint32_t i = IndexInChunk(slot);
+    chunk.constraints[i] = entry.constraints;
+    chunk.margin[i] = entry.margin;
+    chunk.padding[i] = entry.padding;
+    chunk.alignment[i] = entry.alignment;
+    chunk.desired[i] = entry.desired;
+    chunk.flags[i] = entry.flags;
+    chunk.dirty[i] = entry.dirty;
+    chunk.lastConstraint[i] = entry.lastConstraint;
+    chunk.lastArrangeRect[i] = entry.lastArrangeRect;
+    chunk.measureCache[i] = entry.measureCache;
+    chunk.owner[i] = entry.owner;
+    chunk.id[i] = entry.id;
+}
+
+size_t LayoutStore::ReorderDepthFirst(Control* root) {
+    if (!root) return 0;
+
+    // 先序遍历收集槽位（GetLayout 可能触发初始化，需在加锁前完成）
+    std::vector<LayoutComponent*> order;
+    std::vector<Control*> stack{ root };
+    while (!stack.empty()) {
+        Control* control = stack.back();
+        stack.pop_back();
+        if (auto* layout = control->GetLayout()) {
+            order.push_back(layout);
+        }
+        for (size_t i = control->GetChildCount(); i-- > 0;) {
+            if (auto child = control->GetChild(i)) {
+                stack.push_back(static_cast<Control*>(child.get()));
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<uint32_t> slots;
+    slots.reserve(order.size());
+    for (auto* layout : order) slots.push_back(layout->m_slot);
+    std::vector<Entry> entries;
+    entries.reserve(order.size());
+    for (uint32_t slot : slots) entries.push_back(Load(slot));
+
+    // 树占用的槽位从小到大依次放入先序中的第 i 个控件
+    std::sort(slots.begin(), slots.end());
+    for (size_t i = 0; i < order.size(); ++i) {
+        uint32_t slot = slots[i];
+        Store(slot, entries[i]);
+        m_slotsById[entries[i].id] = slot;
+        order[i]->BindSlot(slot, m_chunks[slot / kChunkSize].get());
+    }
+
+    m_reorders[root->GetID()] = ReorderRecord{ m_structureChanges, order.size() };
+    return order.size();
+}
+
+} // namespace components
+} // namespace luaui
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "Interfaces/ILayoutable.h"
+#include "Interfaces/IControl.h"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace luaui {
+
+class Control;
+
+namespace components {
+
+class LayoutComponent;
+
+/**
+ * @brief 布局状态存储（结构数组）
+ *
+ * 所有 LayoutComponent 的状态（尺寸约束、边距、对齐、期望尺寸、有效标记、测量缓存……）
+ * 不再分散在各自的堆对象里，而是按字段分组存放在连续数组中，以稠密的槽位下标访问；
+ * LayoutComponent 只是槽位上的一层外观。
+ *
+ * 数组按固定大小的块分配：新增控件只追加新块，已有槽位的地址保持不变，
+ * 因此并行测量期间创建控件也不会让其他线程持有的引用失效。
+ *
+ * ReorderDepthFirst 把一棵控件树的槽位重排为深度优先顺序，
+ * 测量/排列遍历时按顺序访问内存。控件创建、销毁、移动后顺序逐渐打乱，
+ * 窗口可按 NeedsReorder 的判断在布局前重新排序（见 Window::SetDepthFirstLayoutStore）。
+ * 重排记录按根控件分别保存，多个窗口各自重排互不影响。
+ *
+ * 槽位的分配与释放是线程安全的；重排只能在 UI 线程上、没有并行测量时进行。
+ */
+class LayoutStore {
+public:
+    using HorizontalAlignment = interfaces::ILayoutable::HorizontalAlignment;
+    using VerticalAlignment = interfaces::ILayoutable::VerticalAlignment;
+    using LayoutDirty = interfaces::ILayoutable::LayoutDirty;
+    using ControlID = interfaces::ControlID;
+
+    static constexpr uint32_t kChunkSize = 256;
+    static constexpr uint32_t kInvalidSlot = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t kMeasureCacheSize = 4;
+
+    // 测量输入：显式尺寸与最小/最大尺寸
+    struct SizeConstraints {
+        float width = 0;
+        float height = 0;
+        float minWidth = 0;
+        float minHeight = 0;
+        float maxWidth = std::numeric_limits<float>::max();
+        float maxHeight = std::numeric_limits<float>::max();
+    };
+
+    struct Thickness {
+        float left = 0, top = 0, right = 0, bottom = 0;
+    };
+
+    struct Alignment {
+        HorizontalAlignment horizontal = HorizontalAlignment::Stretch;
+        VerticalAlignment vertical = VerticalAlignment::Stretch;
+    };
+
+    enum Flags : uint8_t {
+        MeasureValid = 1 << 0,
+        ArrangeValid = 1 << 1,
+        HasArranged = 1 << 2,
+        LayoutBoundary = 1 << 3,
+        LayoutQueued = 1 << 4,     // 已在窗口的增量布局队列中
+    };
+
+    // 可用尺寸 → 期望尺寸 的缓存（语义见 LayoutComponent）
+    struct MeasureCacheEntry {
+        rendering::Size available;
+        rendering::Size desired;
+        bool dependsOnChildren = false;
+    };
+
+    struct MeasureCache {
+        MeasureCacheEntry entries[kMeasureCacheSize];
+        uint8_t count = 0;
+        uint8_t next = 0;      // 缓存满时轮换替换的位置
+        int8_t latest = -1;    // 最近一次执行 MeasureOverride 的条目
+        void Clear() { count = 0; next = 0; latest = -1; }
+    };
+
+    /**
+     * @brief 一个块：kChunkSize 个槽位，每个字段组一个数组
+     *
+     * 测量/排列的热字段（约束、边距、期望尺寸、标记）与冷字段（测量缓存、所有者）分开存放。
+     */
+    struct Chunk {
+        SizeConstraints constraints[kChunkSize];
+        Thickness margin[kChunkSize];
+        Thickness padding[kChunkSize];
+        Alignment alignment[kChunkSize];
+        rendering::Size desired[kChunkSize];
+        uint8_t flags[kChunkSize] = {};
+        LayoutDirty dirty[kChunkSize];
+        interfaces::LayoutConstraint lastConstraint[kChunkSize];
+        rendering::Rect lastArrangeRect[kChunkSize];
+        MeasureCache measureCache[kChunkSize];
+        LayoutComponent* owner[kChunkSize] = {};
+        ControlID id[kChunkSize] = {};
+    };
+
+    /** @brief 进程共享的存储（所有窗口的控件都在这里） */
+    static LayoutStore& Shared();
+
+    LayoutStore() = default;
+    LayoutStore(const LayoutStore&) = delete;
+    LayoutStore& operator=(const LayoutStore&) = delete;
+
+    /** @brief 分配一个槽位并初始化为默认值；返回槽位下标 */
+    uint32_t Allocate(LayoutComponent* owner, ControlID id);
+    void Release(uint32_t slot);
+
+    /** @brief 槽位所在的块（地址在存储的生命周期内不变） */
+    Chunk* GetChunk(uint32_t slot) const;
+    static uint32_t IndexInChunk(uint32_t slot) { return slot % kChunkSize; }
+
+    /** @brief 按控件 ID 查找槽位，不存在时返回 kInvalidSlot */
+    uint32_t FindSlot(ControlID id) const;
+
+    size_t GetLiveCount() const;
+    size_t GetCapacity() const;
+
+    // ========== 深度优先重排 ==========
+    /**
+     * @brief 把以 root 为根的树的槽位按深度优先先序重新排列
+     *
+     * 树占用的槽位集合不变，只在集合内部置换；单窗口时空闲槽位被复用，
+     * 这些槽位基本是连续的。返回参与重排的槽位数。
+     */
+    size_t ReorderDepthFirst(Control* root);
+
+    /** @brief 记录一次树结构变化（控件移动到新父控件） */
+    void NotifyStructureChanged();
+
+    /**
+     * @brief root 自上次重排以来的结构变化（分配、释放、移动）是否足以打乱顺序
+     *
+     * 变化次数达到该树上次重排时控件数的 1/8 时返回 true；从未重排过时总是 true。
+     * 变化不区分所属的树，其他窗口的变化也计入：繁忙的窗口可能让安静的窗口
+     * 提前重排，但不会让任何窗口错过重排。
+     */
+    bool NeedsReorder(Control* root) const;
+
+private:
+    struct Entry;   // 一个槽位全部字段的副本，重排时使用
+
+    Entry Load(uint32_t slot) const;
+    void Store(uint32_t slot, const Entry& entry);
+    void Reset(uint32_t slot);
+
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<Chunk>> m_chunks;
+    std::vector<uint32_t> m_freeSlots;
+    std::unordered_map<ControlID, uint32_t> m_slotsById;
+    uint32_t m_nextSlot = 0;
+    // 每棵重排过的树：重排时的结构变化计数与控件数
+    struct ReorderRecord {
+        size_t changes = 0;
+        size_t size = 0;
+    };
+
+    size_t m_structureChanges = 0;  // 累计的结构变化次数（只增不减）
+    std::unordered_map<ControlID, ReorderRecord> m_reorders;    // 按根控件 ID
+};
+
+} // namespace components
+} // namespace luaui
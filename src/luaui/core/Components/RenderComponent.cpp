@@ -1,17 +1,34 @@
 #include "Components/RenderComponent.h"
+#include "Components/LayoutComponent.h"
 #include "Control.h"
 #include "Window.h"
+#include "FrameProfiler.h"
 #include "IRenderContext.h"
+#include "DisplayList.h"
 #include "Logger.h"
+#include "Theme.h"
 
 namespace luaui {
 namespace components {
 
+int RenderComponent::s_offscreenDepth = 0;
+RenderComponent::FrameCounters RenderComponent::s_frameCounters;
+uint64_t RenderComponent::s_frameIndex = 0;
+
 RenderComponent::RenderComponent(Control* owner) : Component(owner) {}
 
+RenderComponent::~RenderComponent() = default;
+
 void RenderComponent::Render(rendering::IRenderContext* context) {
     if (!m_owner || !context) return;
     
+    // 在其他控件的录制过程中被渲染：父控件的显示列表包含了本控件内容，不能缓存
+    if (auto* recorder = dynamic_cast<rendering::RecordingRenderContext*>(context)) {
+        recorder->MarkUncacheable();
+    }
+    ++s_frameCounters.drawn;
+    FrameProfiler::ControlScope profile(m_owner, ProfileCost::Render);
+    
     utils::Logger::TraceF("[Render] %s RenderRect: %.1f,%.1f %.1fx%.1f", 
         m_owner->GetTypeName().c_str(), m_renderRect.x, m_renderRect.y, m_renderRect.width, m_renderRect.height);
     
@@ -26,7 +43,19 @@ void RenderComponent::Render(rendering::IRenderContext* context) {
     // 执行实际渲染（使用相对于当前变换的本地坐标）
     utils::Logger::Trace("[Render] About to call RenderOverride...");
     rendering::Rect localRect(0, 0, m_renderRect.width, m_renderRect.height);
-    RenderOverride(context, localRect);
+    
+    // 记录实际绘制位置（含滚动等父级变换），失效时用于擦除旧位置
+    if (s_offscreenDepth == 0) {
+        m_lastRenderTransform = context->GetTransform();
+        auto drawn = m_lastRenderTransform.TransformBounds(localRect);
+        profile.SetBounds(drawn);
+        m_lastRenderedBounds = InflateByInk(drawn);
+    }
+    {
+        // OnRender 中直接读取的主题资源同样计入依赖
+        controls::Theme::DependencyScope themeDeps(controls::Theme::GetCurrent(), m_owner->m_themeCbId);
+        RenderOverride(context, localRect);
+    }
     utils::Logger::Trace("[Render] RenderOverride returned");
     
     // 恢复状态
@@ -51,29 +80,108 @@ void RenderComponent::SetRenderTransform(const rendering::Transform& transform)
 }
 
 void RenderComponent::Invalidate() {
-    m_isDirty = true;
+    // 并行测量期间（如 OnMeasure 中改变内容）推迟到 UI 线程，避免并发改写祖先和窗口状态
+    if (LayoutComponent::DeferIfInTask(m_owner, LayoutComponent::DeferredInvalidation::Render)) return;
+    
+    rendering::Rect bounds = MarkInvalidated();
     
     // 通知窗口局部重绘
     if (m_owner) {
-        // 获取控件渲染矩形
-        rendering::Rect bounds = m_renderRect;
-        
-        // 遍历父控件累加偏移
-        auto parent = m_owner->GetParent();
-        while (parent) {
-            if (auto parentControl = std::dynamic_pointer_cast<Control>(parent)) {
-                if (auto* parentRender = parentControl->GetRender()) {
-                    bounds.x += parentRender->GetRenderRect().x;
-                    bounds.y += parentRender->GetRenderRect().y;
-                }
+        ReportDamage(bounds);
+    }
+}
+
+void RenderComponent::InvalidateRegion(const rendering::Rect& localRect) {
+    if (LayoutComponent::DeferIfInTask(m_owner, LayoutComponent::DeferredInvalidation::Render)) return;
+    
+    rendering::Rect bounds = MarkInvalidated();
+    if (!m_owner) return;
+    
+    // 尚未绘制过：不知道实际绘制位置，退回到整个控件
+    if (m_lastRenderedBounds.IsEmpty()) {
+        ReportDamage(bounds);
+        return;
+    }
+    
+    // 按上次绘制时的变换映射（与布局偏移累加的 bounds 不同，包含祖先的变换和缩放）；
+    // 此后控件若被移动，Arrange 已经报告了新旧位置
+    rendering::Rect region = localRect.Intersect(rendering::Rect(0, 0, m_renderRect.width, m_renderRect.height));
+    if (region.IsEmpty()) return;
+    if (auto* window = m_owner->GetWindow()) {
+        window->InvalidateRect(m_lastRenderTransform.TransformBounds(region));
+    }
+}
+
+rendering::Rect RenderComponent::MarkInvalidated() {
+    m_isDirty = true;
+    m_contentDirty = true;
+    
+    // 获取控件渲染矩形
+    rendering::Rect bounds = m_renderRect;
+    if (!m_owner) return bounds;
+    
+    // 遍历父控件累加偏移，同时通知祖先子树内容已变化
+    auto parent = m_owner->GetParent();
+    while (parent) {
+        if (auto parentControl = std::dynamic_pointer_cast<Control>(parent)) {
+            if (auto* parentRender = parentControl->GetRender()) {
+                bounds.x += parentRender->GetRenderRect().x;
+                bounds.y += parentRender->GetRenderRect().y;
+                parentRender->OnDescendantInvalidated();
             }
-            parent = parent->GetParent();
         }
-        
-        // 通知窗口使该区域变脏
-        if (auto* window = m_owner->GetWindow()) {
-            window->InvalidateRect(bounds);
+        parent = parent->GetParent();
+    }
+    return bounds;
+}
+
+void RenderComponent::InvalidateBounds() {
+    if (m_owner) {
+        ReportDamage(ComputeGlobalBounds());
+    }
+}
+
+rendering::Rect RenderComponent::ComputeGlobalBounds() const {
+    rendering::Rect bounds = m_renderRect;
+    if (!m_owner) return bounds;
+    
+    auto parent = m_owner->GetParent();
+    while (parent) {
+        if (auto parentControl = std::dynamic_pointer_cast<Control>(parent)) {
+            if (auto* parentRender = parentControl->GetRender()) {
+                bounds.x += parentRender->GetRenderRect().x;
+                bounds.y += parentRender->GetRenderRect().y;
+            }
         }
+        parent = parent->GetParent();
+    }
+    return bounds;
+}
+
+rendering::Rect RenderComponent::InflateByInk(const rendering::Rect& bounds) const {
+    // 尚未布局的控件不绘制任何内容，阴影也不存在
+    if (bounds.IsEmpty()) return bounds;
+
+    const auto& ink = m_inkOverflow;
+    return rendering::Rect(bounds.x - ink.left, bounds.y - ink.top,
+                           bounds.width + ink.left + ink.right,
+                           bounds.height + ink.top + ink.bottom);
+}
+
+void RenderComponent::ReportDamage(const rendering::Rect& controlBounds) {
+    auto* window = m_owner->GetWindow();
+    if (!window) return;
+    
+    // 新位置（含阴影等溢出部分）
+    rendering::Rect bounds = InflateByInk(controlBounds);
+    window->InvalidateRect(bounds);
+    
+    // 上次实际绘制的位置与当前不同（移动、缩小或处于滚动容器中）时也需要重绘
+    const auto& last = m_lastRenderedBounds;
+    if (last.width > 0 && last.height > 0 &&
+        (last.x != bounds.x || last.y != bounds.y ||
+         last.width != bounds.width || last.height != bounds.height)) {
+        window->InvalidateRect(last);
     }
 }
 
@@ -83,7 +191,43 @@ void RenderComponent::RenderOverride(rendering::IRenderContext* context) {
 }
 
 void RenderComponent::RenderOverride(rendering::IRenderContext* context, const rendering::Rect& localRect) {
-    // 默认实现：绘制背景（使用本地坐标）
+    if (!m_renderCacheEnabled || m_cacheRejected) {
+        RenderContent(context, localRect);
+        return;
+    }
+    
+    // 未失效且尺寸不变：直接重放上次录制的命令
+    if (m_displayList && !m_contentDirty &&
+        m_displayList->GetRecordedSize().width == localRect.width &&
+        m_displayList->GetRecordedSize().height == localRect.height) {
+        m_displayList->Replay(context);
+        return;
+    }
+    
+    // 重新录制（同时绘制到目标上下文）
+    if (!m_displayList) {
+        m_displayList = std::make_unique<rendering::DisplayList>();
+    }
+    m_displayList->Clear();
+    
+    // 先清除标记：OnRender 期间调用的 Invalidate（如光标闪烁）会使下一帧重新录制
+    m_contentDirty = false;
+    
+    rendering::RecordingRenderContext recorder(context, m_displayList.get());
+    RenderContent(&recorder, localRect);
+    
+    if (!recorder.IsCacheable()) {
+        m_cacheRejected = true;
+        m_displayList.reset();
+        return;
+    }
+    // 录制一次、重放多次：合并同画刷的矩形/直线，减少每帧的后端调用
+    m_displayList->Optimize();
+    m_displayList->SetRecordedSize(rendering::Size(localRect.width, localRect.height));
+}
+
+void RenderComponent::RenderContent(rendering::IRenderContext* context, const rendering::Rect& localRect) {
+    // 绘制背景（使用本地坐标）
     if (m_background.a > 0) {
         auto brush = context->CreateSolidColorBrush(m_background);
         if (brush) {
@@ -97,6 +241,15 @@ void RenderComponent::RenderOverride(rendering::IRenderContext* context, const r
     }
 }
 
+void RenderComponent::SetRenderCacheEnabled(bool enabled) {
+    m_renderCacheEnabled = enabled;
+    m_cacheRejected = false;
+    m_contentDirty = true;
+    if (!enabled) {
+        m_displayList.reset();
+    }
+}
+
 void RenderComponent::SetActualSize(float width, float height) {
     m_actualWidth = width;
     m_actualHeight = height;
@@ -2,6 +2,8 @@
 
 #include "Components/Component.h"
 #include "Interfaces/IRenderable.h"
+#include <cstdint>
+#include <memory>
 
 namespace luaui {
 
@@ -9,6 +11,7 @@ class Control;
 
 namespace rendering {
     class IRenderContext;
+    class DisplayList;
 }
 
 namespace components {
@@ -23,7 +26,10 @@ using namespace luaui::interfaces;
  */
 class RenderComponent : public Component, public IRenderable {
 public:
+    static constexpr ComponentSlot kComponentSlot = ComponentSlot::Render;
+
     RenderComponent(Control* owner);
+    ~RenderComponent() override;
     
     // ========== IRenderable 实现 ==========
     void Render(rendering::IRenderContext* context) override;
@@ -44,6 +50,95 @@ public:
     void Invalidate() override;
     void ClearDirtyFlag() override { m_isDirty = false; }
 
+    /**
+     * @brief 子树内某个后代控件调用了 Invalidate
+     *
+     * Invalidate 沿父链向上通知每个祖先，缓存了整棵子树的容器（如图层缓存的 Panel）
+     * 借此得知缓存已过期。默认不做任何处理。
+     */
+    virtual void OnDescendantInvalidated() {}
+
+    // ========== 损坏区域 ==========
+    /**
+     * @brief 仅向窗口报告边界变化造成的损坏区域（旧边界 + 新边界）
+     *
+     * 由布局在 Arrange 改变渲染矩形时调用。与 Invalidate 不同，不会使显示列表失效，
+     * 纯移动的控件下一帧仍直接重放。
+     */
+    void InvalidateBounds();
+
+    /**
+     * @brief 使内容失效，但只向窗口报告控件内的一部分区域（本地坐标）
+     *
+     * 用于内容局部变化的大控件（如 DrawingHost 中少数图元移动）：祖先同样会收到
+     * OnDescendantInvalidated，重绘范围只是变化的区域。区域按上次绘制时的变换映射到窗口坐标
+     * （控件移动时 Arrange 已报告新旧位置）；尚未绘制过时按整个控件报告。
+     */
+    void InvalidateRegion(const rendering::Rect& localRect);
+
+    /**
+     * @brief 按当前布局计算的全局边界（窗口坐标，累加父控件偏移）
+     */
+    rendering::Rect ComputeGlobalBounds() const;
+
+    /**
+     * @brief 上次绘制时的全局边界（窗口坐标），尚未绘制过时为空矩形
+     */
+    const rendering::Rect& GetLastRenderedBounds() const { return m_lastRenderedBounds; }
+
+    /**
+     * @brief 绘制超出渲染矩形的范围（如菜单阴影）
+     *
+     * 报告损坏区域和记录上次绘制边界时按此外扩，保证移动、隐藏时超出部分也被擦除。
+     */
+    void SetInkOverflow(const rendering::Thickness& overflow) { m_inkOverflow = overflow; }
+    const rendering::Thickness& GetInkOverflow() const { return m_inkOverflow; }
+
+    /**
+     * @brief 全局边界按绘制溢出范围外扩后的实际绘制范围
+     */
+    rendering::Rect ComputeInkBounds() const { return InflateByInk(ComputeGlobalBounds()); }
+
+    /**
+     * @brief 按绘制溢出范围外扩控件矩形（任意坐标系；空矩形原样返回）
+     *
+     * 损坏报告和裁剪剔除都用它判断控件实际绘制的范围。
+     */
+    rendering::Rect InflateByInk(const rendering::Rect& bounds) const;
+
+    /**
+     * @brief 离屏绘制作用域
+     *
+     * 作用域内（如绘制图层缓存）上下文变换不是窗口坐标，控件不记录上次绘制边界。
+     */
+    class OffscreenScope {
+    public:
+        OffscreenScope() { ++s_offscreenDepth; }
+        ~OffscreenScope() { --s_offscreenDepth; }
+        OffscreenScope(const OffscreenScope&) = delete;
+        OffscreenScope& operator=(const OffscreenScope&) = delete;
+    };
+
+    /**
+     * @brief 本帧渲染计数（窗口每帧开始时清零，结束后汇总到 FrameStats）
+     */
+    struct FrameCounters {
+        int drawn = 0;    // 实际绘制的控件数
+        int culled = 0;   // 因不在裁剪区域内而跳过的子树数
+    };
+    static FrameCounters& GetFrameCounters() { return s_frameCounters; }
+
+    /**
+     * @brief 开始新的一帧：清零计数并推进帧序号
+     *
+     * 窗口每帧可能按脏矩形多次渲染控件树，需要按帧统计的逻辑以帧序号去重。
+     */
+    static void BeginFrame() {
+        s_frameCounters = FrameCounters();
+        ++s_frameIndex;
+    }
+    static uint64_t GetFrameIndex() { return s_frameIndex; }
+
     // ========== 扩展点 ==========
     virtual void RenderOverride(rendering::IRenderContext* context);
     virtual void RenderOverride(rendering::IRenderContext* context, const rendering::Rect& localRect);
@@ -53,7 +148,28 @@ public:
     float GetActualWidth() const { return m_actualWidth; }
     float GetActualHeight() const { return m_actualHeight; }
 
+    // ========== 显示列表缓存 ==========
+    /**
+     * @brief 启用/禁用绘制命令缓存
+     *
+     * 启用时首次绘制会录制控件自身内容（背景 + OnRender）到显示列表，
+     * 之后在未 Invalidate 且尺寸未变时直接重放，不再执行 OnRender。
+     * 子控件不在列表中，各自独立缓存。
+     */
+    void SetRenderCacheEnabled(bool enabled);
+    bool IsRenderCacheEnabled() const { return m_renderCacheEnabled; }
+
+    /**
+     * @brief 当前缓存的显示列表（未缓存时为 nullptr）
+     */
+    const rendering::DisplayList* GetDisplayList() const { return m_displayList.get(); }
+
 protected:
+    /**
+     * @brief 绘制控件自身内容：背景 + Control::OnRender
+     */
+    void RenderContent(rendering::IRenderContext* context, const rendering::Rect& localRect);
+
     rendering::Rect m_renderRect;
     rendering::Color m_background = rendering::Color::Transparent();
     float m_opacity = 1.0f;
@@ -62,6 +178,28 @@ protected:
     float m_actualWidth = 0;
     float m_actualHeight = 0;
     bool m_isDirty = true;
+
+    // 上次绘制时的全局边界，失效时与新边界一起报告给窗口
+    rendering::Rect m_lastRenderedBounds;
+    // 上次绘制时本地到窗口坐标的变换，用于映射局部失效区域
+    rendering::Transform m_lastRenderTransform;
+    rendering::Thickness m_inkOverflow;
+
+    // 显示列表缓存
+    std::unique_ptr<rendering::DisplayList> m_displayList;
+    bool m_renderCacheEnabled = true;
+    bool m_contentDirty = true;     // 自上次录制后是否失效
+    bool m_cacheRejected = false;   // 内容无法缓存（依赖裁剪或嵌套渲染子控件）
+
+private:
+    void ReportDamage(const rendering::Rect& bounds);
+
+    // 标记失效并通知祖先，返回控件的全局边界
+    rendering::Rect MarkInvalidated();
+
+    static int s_offscreenDepth;
+    static FrameCounters s_frameCounters;
+    static uint64_t s_frameIndex;
 };
 
 } // namespace components
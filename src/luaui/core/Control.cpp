@@ -4,9 +4,19 @@
 #include "Components/InputComponent.h"
 #include "Dispatcher.h"
 #include "Theme.h"
+#include "WorkStealingPool.h"
+#include <mutex>
 
 namespace luaui {
 
+namespace {
+
+// 并行测量时控件可能在工作线程上首次初始化，主题订阅表等共享状态需串行修改
+// （初始化过程中会创建并初始化子控件，因此可重入）
+std::recursive_mutex s_initMutex;
+
+} // anonymous namespace
+
 std::atomic<ControlID> Control::s_idCounter{1};
 
 Control::Control() 
@@ -34,14 +44,21 @@ Control::~Control() {
 
 void Control::EnsureInitialized() {
     if (!m_initialized) {
+        std::unique_lock<std::recursive_mutex> lock(s_initMutex, std::defer_lock);
+        if (WorkStealingPool::IsInTask()) {
+            lock.lock();
+            if (m_initialized) return;
+        }
         m_initialized = true;
         InitializeComponents();
-        ApplyTheme();
+        // 只在本控件读取过的主题资源变化时回调；首次 ApplyTheme 建立依赖
         auto& theme = controls::Theme::GetCurrent();
-        m_themeCbId = theme.AddCallback([this]() {
+        m_themeCbId = theme.AddTrackedCallback([this]() {
             ApplyTheme();
             if (auto* r = GetRender()) r->Invalidate();
         });
+        controls::Theme::DependencyScope themeDeps(theme, m_themeCbId);
+        ApplyTheme();
     }
 }
 
@@ -61,17 +78,27 @@ void Control::SetIsVisible(bool visible) {
             }
         }
         
-        // 如果变为可见，标记需要重绘
-        if (visible) {
-            if (auto* render = GetRender()) {
-                render->Invalidate();
-            }
+        // 标记需要重绘（隐藏时也需要擦除原先占据的区域）
+        if (auto* render = GetRender()) {
+            render->Invalidate();
         }
     }
 }
 
 void Control::SetParent(const std::shared_ptr<IControl>& parent) {
     m_parent = std::weak_ptr<IControl>(parent);
+    // 树结构变化会打乱布局存储的深度优先顺序
+    components::LayoutStore::Shared().NotifyStructureChanged();
+}
+
+Window* Control::GetWindow() const {
+    if (m_window) return m_window;
+    
+    // 运行时添加的子控件没有经过 Window::SetRoot 的递归设置，沿父链查找
+    if (auto parent = std::dynamic_pointer_cast<Control>(m_parent.lock())) {
+        return parent->GetWindow();
+    }
+    return nullptr;
 }
 
 void Control::VerifyUIThread() const {
@@ -82,77 +109,21 @@ void Control::VerifyUIThread() const {
 #endif
 }
 
-// 组件便捷访问 - 带缓存优化
-void Control::InvalidateComponentCache() {
-    m_cachedLayout = nullptr;
-    m_cachedRender = nullptr;
-    m_cachedInput = nullptr;
-}
-
+// 组件便捷访问（派生组件与基类组件共用槽位）
 components::LayoutComponent* Control::GetLayout() {
     // 确保已初始化（延迟初始化）
     EnsureInitialized();
-    
-    // 检查缓存
-    if (m_cachedLayout) {
-        return m_cachedLayout;
-    }
-    
-    // 首先尝试精确匹配
-    if (auto* layout = m_components.GetComponent<components::LayoutComponent>()) {
-        m_cachedLayout = layout;
-        return layout;
-    }
-    
-    // 如果没有找到，尝试查找派生类
-    for (auto& [type, comp] : m_components.GetComponents()) {
-        if (auto* layout = dynamic_cast<components::LayoutComponent*>(comp.get())) {
-            m_cachedLayout = layout;
-            return layout;
-        }
-    }
-    return nullptr;
+    return m_components.GetComponent<components::LayoutComponent>();
 }
 
 components::RenderComponent* Control::GetRender() {
-    // 确保已初始化（延迟初始化）
     EnsureInitialized();
-    
-    // 检查缓存
-    if (m_cachedRender) {
-        return m_cachedRender;
-    }
-    
-    // 首先尝试精确匹配
-    if (auto* render = m_components.GetComponent<components::RenderComponent>()) {
-        m_cachedRender = render;
-        return render;
-    }
-    
-    // 如果没有找到，尝试查找派生类
-    for (auto& [type, comp] : m_components.GetComponents()) {
-        if (auto* render = dynamic_cast<components::RenderComponent*>(comp.get())) {
-            m_cachedRender = render;
-            return render;
-        }
-    }
-    return nullptr;
+    return m_components.GetComponent<components::RenderComponent>();
 }
 
 components::InputComponent* Control::GetInput() {
-    // 确保已初始化（延迟初始化）
     EnsureInitialized();
-    
-    // 检查缓存
-    if (m_cachedInput) {
-        return m_cachedInput;
-    }
-    
-    if (auto* input = m_components.GetComponent<components::InputComponent>()) {
-        m_cachedInput = input;
-        return input;
-    }
-    return nullptr;
+    return m_components.GetComponent<components::InputComponent>();
 }
 
 // 能力接口转换
@@ -82,13 +82,10 @@ public:
     components::ComponentHolder& GetComponents() { return m_components; }
     const components::ComponentHolder& GetComponents() const { return m_components; }
     
-    // 便捷访问 - 带缓存优化
+    // 便捷访问 - 标准组件在固定槽位中，直接按下标读取
     components::LayoutComponent* GetLayout();
     components::RenderComponent* GetRender();
     components::InputComponent* GetInput();
-    
-    // 使组件缓存失效（当组件被添加/移除时调用）
-    void InvalidateComponentCache();
 
     // ========== 线程安全 ==========
     Dispatcher* GetDispatcher() const { return m_dispatcher; }
@@ -96,7 +93,7 @@ public:
     void VerifyUIThread() const;
     
     // ========== 窗口关联 ==========
-    class Window* GetWindow() const { return m_window; }
+    class Window* GetWindow() const;
     void SetWindow(class Window* window) { m_window = window; }
 
     // ========== 能力接口转换 ==========
@@ -144,11 +141,6 @@ protected:
     
     components::ComponentHolder m_components;
     
-    // 组件缓存（提升性能，避免每次遍历查找）
-    mutable components::LayoutComponent* m_cachedLayout = nullptr;
-    mutable components::RenderComponent* m_cachedRender = nullptr;
-    mutable components::InputComponent* m_cachedInput = nullptr;
-    
     // 初始化标志（用于延迟初始化）
     bool m_initialized = false;
     size_t m_themeCbId = 0;
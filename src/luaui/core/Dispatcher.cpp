@@ -13,9 +13,22 @@ Dispatcher::~Dispatcher() {
     Shutdown();
 }
 
+namespace {
+
+uint64_t NowMs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+#ifdef _WIN32
 void Dispatcher::Initialize(HWND hwnd) {
-    m_threadId = GetCurrentThreadId();
     m_messageWindow = hwnd;
+#else
+void Dispatcher::Initialize() {
+#endif
+    m_threadId = std::this_thread::get_id();
     m_running = true;
     s_currentDispatcher = this;
 }
@@ -39,16 +52,19 @@ void Dispatcher::BeginInvoke(Action action, DispatcherPriority priority) {
     Task task{
         std::move(action),
         priority,
-        GetTickCount64()
+        NowMs()
     };
     
+    bool wasEmpty;
     {
         std::lock_guard<std::mutex> lock(m_queueMutex);
+        wasEmpty = m_taskQueue.empty();
         m_taskQueue.push(std::move(task));
     }
     
-    // 通知UI线程
-    if (!CheckAccess()) {
+    // 队列由空变为非空时唤醒UI线程一次（UI线程自己投递的任务同样需要唤醒），
+    // 之后的任务在同一批中处理
+    if (wasEmpty) {
         PostMessageToUIThread();
     }
 }
@@ -75,7 +91,7 @@ bool Dispatcher::Invoke(Action action, DispatcherPriority priority) {
     
     // 等待完成
     while (!completed) {
-        Sleep(1); // 简单自旋等待，生产环境可用条件变量优化
+        std::this_thread::sleep_for(std::chrono::milliseconds(1)); // 简单自旋等待，生产环境可用条件变量优化
     }
     
     if (exception) {
@@ -105,7 +121,7 @@ bool Dispatcher::Invoke(Action action, std::chrono::milliseconds timeout) {
         if (elapsed > timeout) {
             return false; // 超时
         }
-        Sleep(1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
     
     return true;
@@ -130,12 +146,12 @@ bool Dispatcher::ProcessOneTask() {
 size_t Dispatcher::ProcessAllTasks(uint32_t maxTimeMs) {
     VerifyAccess();
     
-    auto start = GetTickCount();
+    auto start = NowMs();
     size_t count = 0;
     
     while (m_running) {
         // 检查时间预算
-        if (GetTickCount() - start > maxTimeMs) break;
+        if (NowMs() - start > maxTimeMs) break;
         
         if (!ProcessOneTask()) break;
         count++;
@@ -144,6 +160,7 @@ size_t Dispatcher::ProcessAllTasks(uint32_t maxTimeMs) {
     return count;
 }
 
+#ifdef _WIN32
 LRESULT Dispatcher::ProcessMessage(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
     if (msg == WM_DISPATCHER_INVOKE) {
         // 处理所有待处理任务
@@ -154,6 +171,7 @@ LRESULT Dispatcher::ProcessMessage(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lP
     }
     return DefWindowProc(hwnd, msg, wParam, lParam);
 }
+#endif
 
 Dispatcher* Dispatcher::Current() {
     return s_currentDispatcher;
@@ -173,13 +191,15 @@ Dispatcher::Stats Dispatcher::GetStats() const {
 }
 
 void Dispatcher::PostMessageToUIThread() {
+#ifdef _WIN32
     if (m_messageWindow && IsWindow(m_messageWindow)) {
         PostMessage(m_messageWindow, WM_DISPATCHER_INVOKE, 0, 0);
     }
+#endif
 }
 
 void Dispatcher::ExecuteTask(const Task& task) {
-    auto queueTime = GetTickCount64() - task.timestamp;
+    auto queueTime = NowMs() - task.timestamp;
     m_totalQueueTime += queueTime * 1000; // 转为微秒
     m_processedCount++;
     
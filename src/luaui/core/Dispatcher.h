@@ -6,7 +6,11 @@
 #include <functional>
 #include <thread>
 #include <atomic>
+#include <chrono>
+#include <stdexcept>
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
 namespace luaui {
 
@@ -17,7 +21,7 @@ namespace luaui {
  * - 所有UI控件操作必须在创建它们的线程（UI线程）执行
  * - 后台线程通过Dispatcher.Invoke/BeginInvoke与UI通信
  * - 支持同步等待和异步投递
- * - 与Windows消息循环集成
+ * - 与Windows消息循环集成（其他平台由宿主在帧循环中调用 ProcessOneTask）
  */
 
 enum class DispatcherPriority {
@@ -47,7 +51,7 @@ public:
 
 private:
     // 线程标识
-    DWORD m_threadId = 0;
+    std::thread::id m_threadId;
     std::atomic<bool> m_running{false};
     
     // 任务队列
@@ -59,9 +63,11 @@ private:
     std::atomic<uint64_t> m_processedCount{0};
     std::atomic<uint64_t> m_totalQueueTime{0}; // 微秒
     
+#ifdef _WIN32
     // 与Windows消息集成
     static constexpr UINT WM_DISPATCHER_INVOKE = WM_USER + 0x1001;
     HWND m_messageWindow = nullptr;  // 用于跨线程唤醒消息循环
+#endif
 
 public:
     Dispatcher();
@@ -71,11 +77,18 @@ public:
     Dispatcher(const Dispatcher&) = delete;
     Dispatcher& operator=(const Dispatcher&) = delete;
 
+#ifdef _WIN32
     /**
      * @brief 初始化调度器（必须在UI线程调用）
      * @param hwnd 关联的窗口句柄，用于跨线程消息通知
      */
     void Initialize(HWND hwnd = nullptr);
+#else
+    /**
+     * @brief 初始化调度器（必须在UI线程调用）
+     */
+    void Initialize();
+#endif
 
     /**
      * @brief 关闭调度器，清空未处理任务
@@ -86,7 +99,7 @@ public:
      * @brief 检查当前是否在UI线程
      */
     bool CheckAccess() const {
-        return GetCurrentThreadId() == m_threadId;
+        return std::this_thread::get_id() == m_threadId;
     }
 
     /**
@@ -132,11 +145,19 @@ public:
      */
     size_t ProcessAllTasks(uint32_t maxTimeMs = 16);
 
+#ifdef _WIN32
+    /**
+     * @brief 是否为调度器的唤醒消息
+     * 窗口可据此将任务处理并入自己的帧调度，而不是调用 ProcessMessage
+     */
+    static bool IsInvokeMessage(UINT msg) { return msg == WM_DISPATCHER_INVOKE; }
+
     /**
      * @brief 与Windows消息循环集成
      * 在WindowProc中调用此函数处理调度任务
      */
     static LRESULT ProcessMessage(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
+#endif
 
     /**
      * @brief 获取当前线程的Dispatcher（线程本地存储）
@@ -0,0 +1,250 @@
+#include "FrameProfiler.h"
+#include "Control.h"
+#include "IRenderContext.h"
+#include "Logger.h"
+#include <algorithm>
+
+namespace luaui {
+
+thread_local FrameProfiler* FrameProfiler::s_active = nullptr;
+
+namespace {
+
+double ElapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // anonymous namespace
+
+double ControlProfile::GetTotalMs() const {
+    double total = 0;
+    for (double ms : selfMs) total += ms;
+    return total;
+}
+
+FrameProfiler::FrameProfiler(size_t history)
+    : m_frames((std::max)(history, size_t(1))) {
+}
+
+FrameProfiler::~FrameProfiler() {
+    if (s_active == this) s_active = nullptr;
+}
+
+void FrameProfiler::SetEnabled(bool enabled) {
+    m_enabled = enabled;
+    if (!enabled) {
+        m_overlayEnabled = false;
+        if (m_inFrame) EndFrame();
+    }
+}
+
+void FrameProfiler::SetOverlayEnabled(bool enabled) {
+    m_overlayEnabled = enabled;
+    if (enabled) m_enabled = true;
+}
+
+// ============================================================================
+// 帧
+// ============================================================================
+
+void FrameProfiler::BeginFrame() {
+    if (!m_enabled || m_inFrame) return;
+
+    m_inFrame = true;
+    m_current.frameIndex = m_frameIndex++;
+    m_frameStart = std::chrono::steady_clock::now();
+    s_active = this;
+}
+
+void FrameProfiler::EndFrame() {
+    if (!m_inFrame) return;
+
+    m_current.totalMs = ElapsedMs(m_frameStart);
+
+    // 控件此时仍然存活，可以输出类型名
+    m_current.thrashCount = 0;
+    for (const auto& entry : m_current.controls) {
+        int measures = entry.GetCount(ProfileCost::Measure);
+        if (measures >= m_thrashThreshold) {
+            ++m_current.thrashCount;
+            utils::Logger::WarningF("[Profiler] Layout thrash: %s measured %d times in frame %llu",
+                entry.control->GetTypeName().c_str(), measures,
+                static_cast<unsigned long long>(m_current.frameIndex));
+        }
+    }
+
+    // 与环形缓冲区中最旧的一帧交换，复用其控件数组的容量
+    std::swap(m_frames[m_head], m_current);
+    m_head = (m_head + 1) % m_frames.size();
+    m_count = (std::min)(m_count + 1, m_frames.size());
+
+    m_current.controls.clear();
+    m_current.totalMs = 0;
+    m_current.thrashCount = 0;
+    std::fill(std::begin(m_current.phaseMs), std::end(m_current.phaseMs), 0.0);
+    m_controlIndex.clear();
+    m_scopeTop = nullptr;
+
+    m_inFrame = false;
+    if (s_active == this) s_active = nullptr;
+}
+
+const FrameProfile* FrameProfiler::GetFrame(size_t age) const {
+    if (age >= m_count) return nullptr;
+    size_t index = (m_head + m_frames.size() - 1 - age) % m_frames.size();
+    return &m_frames[index];
+}
+
+std::vector<const ControlProfile*> FrameProfiler::GetThrashingControls(const FrameProfile& frame) const {
+    std::vector<const ControlProfile*> result;
+    for (const auto& entry : frame.controls) {
+        if (entry.GetCount(ProfileCost::Measure) >= m_thrashThreshold) {
+            result.push_back(&entry);
+        }
+    }
+    return result;
+}
+
+void FrameProfiler::Clear() {
+    for (auto& frame : m_frames) {
+        frame = FrameProfile();
+    }
+    m_head = 0;
+    m_count = 0;
+}
+
+ControlProfile& FrameProfiler::GetControl(Control* control) {
+    auto it = m_controlIndex.find(control);
+    if (it != m_controlIndex.end()) {
+        return m_current.controls[it->second];
+    }
+    m_controlIndex.emplace(control, m_current.controls.size());
+    m_current.controls.emplace_back();
+    m_current.controls.back().control = control;
+    return m_current.controls.back();
+}
+
+// ============================================================================
+// 计时作用域
+// ============================================================================
+
+FrameProfiler::PhaseScope::PhaseScope(ProfilePhase phase)
+    : m_profiler(s_active), m_phase(phase) {
+    if (m_profiler) m_start = std::chrono::steady_clock::now();
+}
+
+void FrameProfiler::PhaseScope::Stop() {
+    if (m_profiler && s_active == m_profiler) {
+        m_profiler->m_current.phaseMs[static_cast<int>(m_phase)] += ElapsedMs(m_start);
+    }
+    m_profiler = nullptr;
+}
+
+FrameProfiler::ControlScope::ControlScope(Control* control, ProfileCost cost)
+    : m_profiler(control ? s_active : nullptr), m_control(control), m_cost(cost) {
+    if (!m_profiler) return;
+    m_parent = m_profiler->m_scopeTop;
+    m_profiler->m_scopeTop = this;
+    m_start = std::chrono::steady_clock::now();
+}
+
+FrameProfiler::ControlScope::~ControlScope() {
+    if (!m_profiler || s_active != m_profiler) return;
+
+    double elapsed = ElapsedMs(m_start);
+    m_profiler->m_scopeTop = m_parent;
+    if (m_parent) {
+        m_parent->m_childMs += elapsed;
+    }
+
+    auto& entry = m_profiler->GetControl(m_control);
+    int index = static_cast<int>(m_cost);
+    entry.selfMs[index] += (std::max)(elapsed - m_childMs, 0.0);
+    ++entry.count[index];
+    if (m_hasBounds) {
+        entry.bounds = m_bounds;
+    }
+}
+
+// ============================================================================
+// 调试叠加层
+// ============================================================================
+
+void FrameProfiler::DrawOverlay(rendering::IRenderContext* context, float width, float height) const {
+    if (!context) return;
+
+    context->PushState();
+    context->SetTransform(rendering::Transform::Identity());
+
+    const FrameProfile* frame = GetFrame(0);
+    if (frame) {
+        double maxMs = 0;
+        for (const auto& entry : frame->controls) {
+            maxMs = (std::max)(maxMs, entry.GetTotalMs());
+        }
+
+        // 热力图：开销越高越红、越不透明
+        if (maxMs > 0) {
+            for (const auto& entry : frame->controls) {
+                if (entry.bounds.IsEmpty()) continue;
+                float heat = static_cast<float>(entry.GetTotalMs() / maxMs);
+                auto brush = context->CreateSolidColorBrush(
+                    rendering::Color(heat, 1.0f - heat, 0.0f, 0.1f + 0.4f * heat));
+                context->FillRectangle(entry.bounds, brush.get());
+            }
+        }
+
+        auto thrash = context->CreateSolidColorBrush(rendering::Color::Red());
+        for (const auto* entry : GetThrashingControls(*frame)) {
+            if (!entry->bounds.IsEmpty()) {
+                context->DrawRectangle(entry->bounds, thrash.get(), 2.0f);
+            }
+        }
+    }
+
+    // 历史帧柱状图（从旧到新，自左向右），满高度为一个 60Hz 帧时间
+    const float graphHeight = 60.0f;
+    const float barWidth = 3.0f;
+    const float scale = graphHeight / static_cast<float>(kBudgetMs);
+    const float baseY = height - 4.0f;
+    const rendering::Color phaseColors[] = {
+        rendering::Color(0.3f, 0.5f, 1.0f, 0.8f),   // Layout
+        rendering::Color(0.2f, 0.9f, 0.3f, 0.8f),   // Render
+        rendering::Color(1.0f, 0.6f, 0.1f, 0.8f),   // Present
+    };
+    static_assert(sizeof(phaseColors) / sizeof(phaseColors[0]) == static_cast<size_t>(ProfilePhase::Count),
+                  "one color per phase");
+
+    const size_t slots = (std::min)(m_frames.size(),
+                                    static_cast<size_t>((std::max)((width - 8.0f) / barWidth, 0.0f)));
+    if (slots == 0) {
+        context->PopState();
+        return;
+    }
+
+    auto background = context->CreateSolidColorBrush(rendering::Color(0, 0, 0, 0.5f));
+    context->FillRectangle(rendering::Rect(4.0f, baseY - graphHeight,
+                                           slots * barWidth, graphHeight), background.get());
+
+    std::vector<rendering::Rect> bars[static_cast<int>(ProfilePhase::Count)];
+    for (size_t age = 0; age < (std::min)(m_count, slots); ++age) {
+        const auto* history = GetFrame(age);
+        float x = 4.0f + (slots - 1 - age) * barWidth;
+        float y = baseY;
+        for (int phase = 0; phase < static_cast<int>(ProfilePhase::Count); ++phase) {
+            float h = (std::min)(static_cast<float>(history->phaseMs[phase]) * scale, y - (baseY - graphHeight));
+            if (h <= 0) continue;
+            y -= h;
+            bars[phase].emplace_back(x, y, barWidth - 1.0f, h);
+        }
+    }
+    for (int phase = 0; phase < static_cast<int>(ProfilePhase::Count); ++phase) {
+        if (bars[phase].empty()) continue;
+        auto brush = context->CreateSolidColorBrush(phaseColors[phase]);
+        context->FillRectangles(bars[phase].data(), bars[phase].size(), brush.get());
+    }
+
+    context->PopState();
+}
+
+} // namespace luaui
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "Types.h"
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace luaui {
+
+class Control;
+
+namespace rendering {
+    class IRenderContext;
+}
+
+/**
+ * @brief 帧阶段
+ */
+enum class ProfilePhase {
+    Layout,    // Window::UpdateLayout（Measure + Arrange）
+    Render,    // 遍历控件树并提交绘制命令
+    Present,   // 呈现（含等待 GPU）
+    Count
+};
+
+/**
+ * @brief 控件开销类别
+ */
+enum class ProfileCost {
+    Measure,   // 实际执行的 MeasureOverride（命中缓存的调用不计）
+    Arrange,   // 实际执行的 ArrangeOverride
+    Render,    // RenderComponent::Render
+    Count
+};
+
+/**
+ * @brief 单个控件在一帧内的开销
+ *
+ * 时间为自身耗时（不含嵌套执行的子控件），按类别分别累计。
+ * control 只用作标识：帧结束后控件可能已被销毁，不能解引用历史帧中的指针。
+ */
+struct ControlProfile {
+    Control* control = nullptr;
+    double selfMs[static_cast<int>(ProfileCost::Count)] = {};
+    int count[static_cast<int>(ProfileCost::Count)] = {};
+    rendering::Rect bounds;   // 本帧绘制时的窗口坐标边界，未绘制时为空
+
+    double GetTotalMs() const;
+    double GetMs(ProfileCost cost) const { return selfMs[static_cast<int>(cost)]; }
+    int GetCount(ProfileCost cost) const { return count[static_cast<int>(cost)]; }
+};
+
+/**
+ * @brief 一帧的分析结果
+ */
+struct FrameProfile {
+    uint64_t frameIndex = 0;
+    double totalMs = 0;
+    double phaseMs[static_cast<int>(ProfilePhase::Count)] = {};
+    std::vector<ControlProfile> controls;   // 按首次出现顺序
+    int thrashCount = 0;                    // 被判定为布局抖动的控件数
+
+    double GetPhaseMs(ProfilePhase phase) const { return phaseMs[static_cast<int>(phase)]; }
+};
+
+/**
+ * @brief 帧分析器
+ *
+ * 记录每帧各阶段耗时，以及每个控件的 Measure/Arrange/Render 自身耗时和调用次数，
+ * 保存在最近 N 帧的环形缓冲区中。一帧内被 Measure 次数达到阈值的控件视为布局抖动。
+ *
+ * 分析器只在 BeginFrame 到 EndFrame 之间处于活动状态；未启用或不在帧内时，
+ * 各处的计时作用域只读取一次静态指针，不产生其他开销。
+ *
+ * 调试叠加层按开销把控件绘制成热力图（绿 → 红），布局抖动的控件加红框，
+ * 左下角为历史帧的分阶段耗时柱状图。
+ */
+class FrameProfiler {
+public:
+    static constexpr size_t kDefaultHistory = 120;
+    static constexpr int kDefaultThrashThreshold = 3;
+    static constexpr double kBudgetMs = 1000.0 / 60.0;   // 柱状图满高度对应的帧时间
+
+    explicit FrameProfiler(size_t history = kDefaultHistory);
+    ~FrameProfiler();
+
+    FrameProfiler(const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+    // ========== 配置 ==========
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const { return m_enabled; }
+
+    /** @brief 调试叠加层（开启时同时启用分析） */
+    void SetOverlayEnabled(bool enabled);
+    bool IsOverlayEnabled() const { return m_overlayEnabled; }
+
+    /** @brief 一帧内 Measure 次数达到该值即判定为布局抖动 */
+    void SetThrashThreshold(int threshold) { m_thrashThreshold = threshold; }
+    int GetThrashThreshold() const { return m_thrashThreshold; }
+
+    // ========== 帧 ==========
+    /** @brief 开始一帧（已在帧内时忽略） */
+    void BeginFrame();
+    /** @brief 结束当前帧并写入环形缓冲区 */
+    void EndFrame();
+    bool IsInFrame() const { return m_inFrame; }
+
+    // ========== 结果 ==========
+    /** @brief 已保存的帧数（不超过历史容量） */
+    size_t GetFrameCount() const { return m_count; }
+    size_t GetCapacity() const { return m_frames.size(); }
+
+    /**
+     * @brief 获取历史帧
+     * @param age 0 为最近完成的一帧，1 为上一帧，依此类推
+     * @return 超出已保存范围时返回 nullptr
+     */
+    const FrameProfile* GetFrame(size_t age = 0) const;
+
+    /** @brief 指定帧中布局抖动的控件 */
+    std::vector<const ControlProfile*> GetThrashingControls(const FrameProfile& frame) const;
+
+    void Clear();
+
+    // ========== 调试叠加层 ==========
+    /**
+     * @brief 在窗口坐标系中绘制最近一帧的热力图和历史柱状图
+     */
+    void DrawOverlay(rendering::IRenderContext* context, float width, float height) const;
+
+    // ========== 计时作用域 ==========
+    /** @brief 当前处于帧内的分析器（未启用或不在帧内时为 nullptr） */
+    static FrameProfiler* GetActive() { return s_active; }
+
+    /**
+     * @brief 帧阶段计时
+     */
+    class PhaseScope {
+    public:
+        explicit PhaseScope(ProfilePhase phase);
+        ~PhaseScope() { Stop(); }
+        PhaseScope(const PhaseScope&) = delete;
+        PhaseScope& operator=(const PhaseScope&) = delete;
+
+        /** @brief 提前结束计时（之后析构不再计时） */
+        void Stop();
+
+    private:
+        FrameProfiler* m_profiler;
+        ProfilePhase m_phase;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    /**
+     * @brief 控件开销计时（嵌套作用域的耗时从外层扣除，得到自身耗时）
+     */
+    class ControlScope {
+    public:
+        ControlScope(Control* control, ProfileCost cost);
+        ~ControlScope();
+        ControlScope(const ControlScope&) = delete;
+        ControlScope& operator=(const ControlScope&) = delete;
+
+        /** @brief 记录控件本次绘制的窗口坐标边界 */
+        void SetBounds(const rendering::Rect& bounds) { m_bounds = bounds; m_hasBounds = true; }
+
+    private:
+        FrameProfiler* m_profiler;
+        Control* m_control;
+        ProfileCost m_cost;
+        std::chrono::steady_clock::time_point m_start;
+        double m_childMs = 0;              // 嵌套作用域的总耗时
+        ControlScope* m_parent = nullptr;
+        rendering::Rect m_bounds;
+        bool m_hasBounds = false;
+    };
+
+private:
+    ControlProfile& GetControl(Control* control);
+
+    std::vector<FrameProfile> m_frames;   // 环形缓冲区
+    size_t m_head = 0;                    // 下一帧写入位置
+    size_t m_count = 0;
+    uint64_t m_frameIndex = 0;
+
+    bool m_enabled = false;
+    bool m_overlayEnabled = false;
+    bool m_inFrame = false;
+    int m_thrashThreshold = kDefaultThrashThreshold;
+
+    // 当前帧
+    FrameProfile m_current;
+    std::unordered_map<Control*, size_t> m_controlIndex;
+    std::chrono::steady_clock::time_point m_frameStart;
+    ControlScope* m_scopeTop = nullptr;
+
+    // 只对调用 BeginFrame 的线程可见：并行测量的工作线程不计时，
+    // 其耗时计入发起并行测量的父控件
+    static thread_local FrameProfiler* s_active;
+};
+
+} // namespace luaui
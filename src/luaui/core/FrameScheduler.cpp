@@ -0,0 +1,138 @@
+#include "FrameScheduler.h"
+#include <algorithm>
+
+namespace luaui {
+
+FrameScheduler::FrameScheduler(std::unique_ptr<IFrameClock> clock)
+    : m_clock(std::move(clock)) {
+    if (!m_clock) {
+        m_clock = std::make_unique<SteadyFrameClock>();
+    }
+}
+
+void FrameScheduler::RequestLayout() {
+    Request(kPendingLayout | kPendingRender);
+}
+
+void FrameScheduler::RequestRender() {
+    Request(kPendingRender);
+}
+
+void FrameScheduler::RequestTasks() {
+    Request(kPendingTasks);
+}
+
+void FrameScheduler::RequestAnimation() {
+    ++m_stats.requests;
+    if (!m_animating) {
+        m_animating = true;
+        m_lastAnimTime = m_clock->Now();
+    }
+    if (m_inFrame) return;
+    ScheduleWake();
+}
+
+void FrameScheduler::Request(uint32_t flags) {
+    ++m_stats.requests;
+    m_pending |= flags;
+
+    // 帧内产生的请求在帧结束时统一安排
+    if (m_inFrame) return;
+    ScheduleWake();
+}
+
+void FrameScheduler::ScheduleWake() {
+    if (m_wakePending) {
+        ++m_stats.coalescedRequests;
+        return;
+    }
+    m_wakePending = true;
+    if (m_wake) {
+        m_wake(GetTimeUntilNextFrame());
+    }
+}
+
+double FrameScheduler::GetTimeUntilNextFrame() const {
+    if (!m_hasFrame) return 0;
+    return (std::max)(m_lastFrameStart + m_frameInterval - m_clock->Now(), 0.0);
+}
+
+bool FrameScheduler::RunFrame() {
+    // 阶段回调中不允许重入
+    if (m_inFrame) return false;
+
+    m_wakePending = false;
+    if (!HasPendingWork()) return false;
+
+    const double frameStart = m_clock->Now();
+    m_inFrame = true;
+    m_hasFrame = true;
+    m_lastFrameStart = frameStart;
+
+    // 1. 任务：为布局和渲染预留上一帧实际用掉的时间
+    double phaseStart = frameStart;
+    if (m_pending & kPendingTasks) {
+        m_pending &= ~kPendingTasks;
+        double reserve = m_stats.lastLayoutMs + m_stats.lastRenderMs;
+        RunTasks((std::max)(m_frameBudget - reserve, kMinTaskSlice));
+    }
+    double now = m_clock->Now();
+    m_stats.lastTaskMs = now - phaseStart;
+
+    // 2. 动画：按两次更新之间的实际时间推进
+    phaseStart = now;
+    if (m_animating) {
+        double delta = now - m_lastAnimTime;
+        m_lastAnimTime = now;
+        m_animating = m_pipeline.update ? m_pipeline.update(delta) : false;
+    }
+    now = m_clock->Now();
+    m_stats.lastUpdateMs = now - phaseStart;
+
+    // 3. 布局：任务和动画产生的布局失效在这里一并处理
+    phaseStart = now;
+    if (m_pending & kPendingLayout) {
+        m_pending &= ~kPendingLayout;
+        if (m_pipeline.layout) m_pipeline.layout();
+    }
+    now = m_clock->Now();
+    m_stats.lastLayoutMs = now - phaseStart;
+
+    // 4. 渲染：渲染期间的新失效留到下一帧
+    phaseStart = now;
+    if (m_pending & kPendingRender) {
+        m_pending &= ~kPendingRender;
+        if (m_pipeline.render) m_pipeline.render();
+        ++m_stats.frames;
+    }
+    now = m_clock->Now();
+    m_stats.lastRenderMs = now - phaseStart;
+
+    m_inFrame = false;
+    m_stats.lastFrameMs = now - frameStart;
+    if (m_stats.lastFrameMs > m_frameBudget) {
+        ++m_stats.overBudgetFrames;
+    }
+
+    if (HasPendingWork()) {
+        ScheduleWake();
+    }
+    return true;
+}
+
+void FrameScheduler::RunTasks(double budget) {
+    if (!m_pipeline.runTask) return;
+
+    const double start = m_clock->Now();
+    while (true) {
+        if (m_clock->Now() - start >= budget) {
+            m_pending |= kPendingTasks;
+            ++m_stats.deferredTaskFrames;
+            return;
+        }
+        if (!m_pipeline.runTask()) return;
+        ++m_stats.tasksRun;
+    }
+}
+
+} // namespace luaui
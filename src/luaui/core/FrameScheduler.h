@@ -0,0 +1,178 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace luaui {
+
+/**
+ * @brief 帧时钟接口（毫秒）
+ *
+ * 调度器只通过时钟读取时间，测试中可替换为手动推进的时钟以获得确定的帧序列。
+ */
+class IFrameClock {
+public:
+    virtual ~IFrameClock() = default;
+    virtual double Now() const = 0;
+};
+
+/**
+ * @brief 基于 std::chrono::steady_clock 的真实时钟
+ */
+class SteadyFrameClock : public IFrameClock {
+public:
+    double Now() const override {
+        auto elapsed = std::chrono::steady_clock::now() - m_origin;
+        return std::chrono::duration<double, std::milli>(elapsed).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_origin = std::chrono::steady_clock::now();
+};
+
+/**
+ * @brief 手动推进的时钟（用于测试）
+ */
+class ManualFrameClock : public IFrameClock {
+public:
+    double Now() const override { return m_now; }
+    void Advance(double ms) { m_now += ms; }
+    void Set(double ms) { m_now = ms; }
+
+private:
+    double m_now = 0;
+};
+
+/**
+ * @brief 帧调度器
+ *
+ * 将一段时间内的所有失效请求（布局、重绘、动画、调度器任务）合并为一帧，
+ * 每帧按固定顺序执行：任务 → 动画更新 → 布局 → 渲染/呈现。
+ *
+ * - 请求只设置标记，并在第一次请求时通过唤醒回调通知宿主（例如投递窗口消息），
+ *   同一帧之前的后续请求不会产生额外的唤醒或帧
+ * - 两帧之间至少间隔一个帧间隔，连续的属性变化最多每个间隔产生一帧
+ * - 帧内执行期间产生的请求：尚未执行到的阶段在本帧处理，已执行过的阶段留到下一帧
+ * - 任务阶段受帧预算限制：预算扣除上一帧布局和渲染的耗时，超出部分留到下一帧
+ *
+ * 调度器本身不依赖平台，宿主负责在唤醒回调给出的延迟之后调用 RunFrame。
+ */
+class FrameScheduler {
+public:
+    static constexpr double kDefaultFrameInterval = 1000.0 / 60.0;
+    static constexpr double kMinTaskSlice = 1.0;   // 每帧任务阶段的最少时间（毫秒）
+
+    /**
+     * @brief 帧管线的各个阶段（由宿主提供，未设置的阶段被跳过）
+     */
+    struct Pipeline {
+        std::function<bool()> runTask;             // 执行一个待处理任务，队列为空时返回 false
+        std::function<bool(double)> update;        // 按经过的毫秒数推进动画，返回是否仍有活跃动画
+        std::function<void()> layout;              // 更新布局
+        std::function<void()> render;              // 绘制并呈现
+    };
+
+    /** @brief 唤醒回调：宿主应在 delayMs 毫秒后调用 RunFrame */
+    using WakeHandler = std::function<void(double delayMs)>;
+
+    /**
+     * @brief 帧统计
+     */
+    struct Stats {
+        uint64_t frames = 0;              // 执行渲染阶段的帧数
+        uint64_t requests = 0;            // 收到的请求总数
+        uint64_t coalescedRequests = 0;   // 并入已安排帧的请求数
+        uint64_t tasksRun = 0;            // 帧内执行的任务数
+        uint64_t deferredTaskFrames = 0;  // 任务因预算不足留到下一帧的次数
+        uint64_t overBudgetFrames = 0;    // 总耗时超出帧预算的帧数
+        double lastFrameMs = 0;           // 上一帧总耗时
+        double lastTaskMs = 0;
+        double lastUpdateMs = 0;
+        double lastLayoutMs = 0;
+        double lastRenderMs = 0;
+    };
+
+    /**
+     * @param clock 帧时钟，为空时使用 SteadyFrameClock
+     */
+    explicit FrameScheduler(std::unique_ptr<IFrameClock> clock = nullptr);
+
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+    void SetPipeline(Pipeline pipeline) { m_pipeline = std::move(pipeline); }
+    void SetWakeHandler(WakeHandler handler) { m_wake = std::move(handler); }
+
+    /** @brief 两帧之间的最小间隔（毫秒） */
+    void SetFrameInterval(double ms) { m_frameInterval = ms; }
+    double GetFrameInterval() const { return m_frameInterval; }
+
+    /** @brief 每帧的时间预算（毫秒），默认等于帧间隔 */
+    void SetFrameBudget(double ms) { m_frameBudget = ms; }
+    double GetFrameBudget() const { return m_frameBudget; }
+
+    // ========== 请求 ==========
+    /** @brief 请求布局（布局之后总会渲染） */
+    void RequestLayout();
+    /** @brief 请求重绘 */
+    void RequestRender();
+    /** @brief 请求执行待处理的调度器任务 */
+    void RequestTasks();
+    /** @brief 开始逐帧推进动画，直到 update 回调返回 false */
+    void RequestAnimation();
+
+    /**
+     * @brief 执行一帧（任务 → 动画 → 布局 → 渲染）
+     * @return 是否执行了任何阶段
+     */
+    bool RunFrame();
+
+    /** @brief 是否有等待下一帧处理的工作 */
+    bool HasPendingWork() const { return m_pending != 0 || m_animating; }
+
+    bool IsAnimating() const { return m_animating; }
+    bool IsInFrame() const { return m_inFrame; }
+
+    /** @brief 距离允许执行下一帧还需等待的毫秒数 */
+    double GetTimeUntilNextFrame() const;
+
+    const Stats& GetStats() const { return m_stats; }
+    void ResetStats() { m_stats = Stats(); }
+
+    IFrameClock* GetClock() const { return m_clock.get(); }
+
+private:
+    enum PendingFlags : uint32_t {
+        kPendingTasks = 1u << 0,
+        kPendingLayout = 1u << 1,
+        kPendingRender = 1u << 2,
+    };
+
+    void Request(uint32_t flags);
+    void ScheduleWake();
+
+    // 在剩余预算内执行任务
+    void RunTasks(double budget);
+
+    std::unique_ptr<IFrameClock> m_clock;
+    Pipeline m_pipeline;
+    WakeHandler m_wake;
+
+    double m_frameInterval = kDefaultFrameInterval;
+    double m_frameBudget = kDefaultFrameInterval;
+
+    uint32_t m_pending = 0;
+    bool m_animating = false;
+    bool m_inFrame = false;
+    bool m_wakePending = false;
+
+    double m_lastFrameStart = 0;
+    bool m_hasFrame = false;
+    double m_lastAnimTime = 0;
+
+    Stats m_stats;
+};
+
+} // namespace luaui
@@ -0,0 +1,87 @@
+#include "LayoutManager.h"
+#include "Control.h"
+#include "Components/LayoutComponent.h"
+#include <algorithm>
+
+namespace luaui {
+
+LayoutManager::~LayoutManager() {
+    Clear();
+}
+
+void LayoutManager::Enqueue(Control* root) {
+    auto* layout = root ? root->GetLayout() : nullptr;
+    if (!layout || layout->IsLayoutQueued()) return;
+    layout->SetLayoutQueued(true);
+    m_queue.push_back(root->weak_from_this());
+}
+
+void LayoutManager::Clear() {
+    for (const auto& weak : m_queue) {
+        if (auto control = weak.lock()) {
+            control->GetLayout()->SetLayoutQueued(false);
+        }
+    }
+    m_queue.clear();
+}
+
+int LayoutManager::GetDepth(const Control* control) {
+    int depth = 0;
+    for (auto parent = control ? control->GetParent() : nullptr; parent; parent = parent->GetParent()) {
+        ++depth;
+    }
+    return depth;
+}
+
+size_t LayoutManager::Process(std::vector<std::weak_ptr<Control>>* relaid) {
+    size_t processed = 0;
+
+    // 处理过程中父控件失效可能把更浅的边界加入队列，循环直到队列清空
+    while (!m_queue.empty()) {
+        std::vector<std::pair<int, std::shared_ptr<Control>>> batch;
+        batch.reserve(m_queue.size());
+        for (const auto& weak : m_queue) {
+            if (auto control = weak.lock()) {
+                // 出队后子树内的新失效可以再次入队
+                control->GetLayout()->SetLayoutQueued(false);
+                batch.emplace_back(GetDepth(control.get()), std::move(control));
+            }
+        }
+        m_queue.clear();
+
+        // 由浅到深：外层子树重新布局时已经顺带处理了嵌套在其中的边界
+        std::stable_sort(batch.begin(), batch.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (auto& item : batch) {
+            auto* layout = item.second->GetLayout();
+            if (!layout || (layout->IsMeasureValid() && layout->IsArrangeValid())) continue;
+            if (Relayout(item.second.get()) && relaid) {
+                relaid->push_back(item.second);
+            }
+            ++processed;
+        }
+    }
+    return processed;
+}
+
+bool LayoutManager::Relayout(Control* root) {
+    auto* layout = root->GetLayout();
+
+    // 从未参与过布局：没有可复用的约束和矩形
+    if (!layout->HasArranged()) {
+        layout->InvalidateParentMeasure();
+        return false;
+    }
+
+    rendering::Size previous = layout->GetDesiredSize();
+    rendering::Size desired = layout->Measure(layout->GetLastConstraint());
+    if (desired.width != previous.width || desired.height != previous.height) {
+        layout->InvalidateParentMeasure();
+        return false;
+    }
+
+    layout->Arrange(layout->GetLastArrangeRect());
+    return true;
+}
+
+} // namespace luaui
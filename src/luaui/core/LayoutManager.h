@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace luaui {
+
+class Control;
+
+/**
+ * @brief 增量布局队列
+ *
+ * 布局边界（固定宽高或显式标记的控件）的尺寸不随内容变化，其子树内的布局失效
+ * 不再冒泡到根控件，而是把边界控件加入本队列。下一帧布局阶段按深度从浅到深，
+ * 以上次的约束重新测量、以上次的矩形重新排列各个失效子树，不触碰窗口其余部分。
+ *
+ * 若重新测量后边界的期望尺寸发生变化（例如固定尺寸的面板在无限可用空间中被内容撑大），
+ * 则使其父控件的测量失效，由上一层边界或整窗布局继续处理。
+ *
+ * 队列只保存弱引用，入队后被销毁的控件直接跳过。已入队的控件在布局存储的标记位中
+ * 记录（LayoutStore::LayoutQueued），重复入队的判断是 O(1) 的。
+ */
+class LayoutManager {
+public:
+    LayoutManager() = default;
+    ~LayoutManager();
+    LayoutManager(const LayoutManager&) = delete;
+    LayoutManager& operator=(const LayoutManager&) = delete;
+
+    /**
+     * @brief 加入一个失效子树的根（重复加入只保留一次）
+     */
+    void Enqueue(Control* root);
+
+    /**
+     * @brief 按深度顺序处理队列中的子树
+     * @param relaid 非空时追加就地完成布局的子树根（尺寸变化而交给上一层处理的不在其中）
+     * @return 本次重新布局的子树数量
+     */
+    size_t Process(std::vector<std::weak_ptr<Control>>* relaid = nullptr);
+
+    void Clear();
+    bool IsEmpty() const { return m_queue.empty(); }
+    size_t GetPendingCount() const { return m_queue.size(); }
+
+    /**
+     * @brief 控件在树中的深度（根控件为 0）
+     */
+    static int GetDepth(const Control* control);
+
+private:
+    /**
+     * @brief 重新布局一个子树
+     * @return 子树已就地完成布局；尺寸变化或从未布局过时返回 false（已使父控件失效）
+     */
+    static bool Relayout(Control* root);
+
+    std::vector<std::weak_ptr<Control>> m_queue;
+};
+
+} // namespace luaui
@@ -0,0 +1,247 @@
+#include "SpatialIndex.h"
+#include "Control.h"
+#include "../controls/Panel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace luaui {
+
+namespace {
+
+// 图层根控件不受任何祖先裁剪
+const rendering::Rect kUnbounded(-1.0e7f, -1.0e7f, 2.0e7f, 2.0e7f);
+
+} // anonymous namespace
+
+void SpatialIndex::Build(const std::vector<Control*>& layers) {
+    m_entries.clear();
+    for (auto* layer : layers) {
+        Collect(m_entries, layer, 0, 0, kUnbounded);
+    }
+    BuildGrid();
+}
+
+void SpatialIndex::Clear() {
+    m_entries.clear();
+    m_patched.clear();
+    m_isPatched.clear();
+    m_cellStart.clear();
+    m_cellItems.clear();
+    m_extent = rendering::Rect();
+    m_cols = 0;
+    m_rows = 0;
+}
+
+void SpatialIndex::Collect(std::vector<Entry>& out, Control* control, float offsetX, float offsetY,
+                           const rendering::Rect& clip) {
+    if (!control || !control->GetIsVisible()) return;
+
+    auto* render = control->GetRender();
+    if (!render) return;
+
+    const auto& rect = render->GetRenderRect();
+    rendering::Rect global(rect.x + offsetX, rect.y + offsetY, rect.width, rect.height);
+
+    // 点必须同时落在所有祖先内，命中区域为空时整个子树都不可能被命中
+    rendering::Rect hit = global.Intersect(clip);
+    if (hit.IsEmpty()) return;
+
+    size_t index = out.size();
+    out.push_back({control, hit, 0});
+
+    if (auto* panel = dynamic_cast<controls::Panel*>(control)) {
+        for (const auto& child : panel->GetChildren()) {
+            Collect(out, static_cast<Control*>(child.get()), global.x, global.y, hit);
+        }
+    }
+    out[index].end = static_cast<uint32_t>(out.size());
+}
+
+bool SpatialIndex::FindEntry(Control* control, uint32_t& index, uint32_t& parent) const {
+    // 从图层根到目标控件的祖先链
+    std::vector<Control*> path;
+    for (Control* node = control; node;
+         node = std::dynamic_pointer_cast<Control>(node->GetParent()).get()) {
+        path.push_back(node);
+    }
+
+    // 图层根条目依次相接
+    const uint32_t count = static_cast<uint32_t>(m_entries.size());
+    uint32_t current = 0;
+    while (current < count && m_entries[current].control != path.back()) {
+        current = m_entries[current].end;
+    }
+    if (current >= count) return false;
+
+    // 逐层在父条目的子树区间内查找，跳过兄弟控件的整个子树
+    parent = count;
+    for (size_t level = path.size() - 1; level > 0; --level) {
+        Control* next = path[level - 1];
+        uint32_t child = current + 1;
+        while (child < m_entries[current].end && m_entries[child].control != next) {
+            child = m_entries[child].end;
+        }
+        if (child >= m_entries[current].end) return false;
+        parent = current;
+        current = child;
+    }
+    index = current;
+    return true;
+}
+
+bool SpatialIndex::Update(Control* subtree) {
+    uint32_t index = 0, parent = 0;
+    if (!subtree || !FindEntry(subtree, index, parent)) return false;
+
+    // 子树根的全局偏移来自父控件，裁剪区域为父条目的命中区域
+    float offsetX = 0, offsetY = 0;
+    rendering::Rect clip = kUnbounded;
+    if (parent < m_entries.size()) {
+        auto owner = std::dynamic_pointer_cast<Control>(subtree->GetParent());
+        auto* render = owner ? owner->GetRender() : nullptr;
+        if (!render) return false;
+        rendering::Rect origin = render->ComputeGlobalBounds();
+        offsetX = origin.x;
+        offsetY = origin.y;
+        clip = m_entries[parent].bounds;
+    }
+
+    std::vector<Entry> fresh;
+    Collect(fresh, subtree, offsetX, offsetY, clip);
+
+    // 条目数或控件顺序变化（子控件增删、显隐、被裁剪出视口）：区间无法原位替换
+    const uint32_t end = m_entries[index].end;
+    if (fresh.size() != end - index) return false;
+    for (size_t i = 0; i < fresh.size(); ++i) {
+        const auto& entry = m_entries[index + i];
+        if (entry.control != fresh[i].control || entry.end != fresh[i].end + index) return false;
+    }
+
+    for (size_t i = 0; i < fresh.size(); ++i) {
+        auto& bounds = m_entries[index + i].bounds;
+        const auto& updated = fresh[i].bounds;
+        if (bounds.x != updated.x || bounds.y != updated.y ||
+            bounds.width != updated.width || bounds.height != updated.height) {
+            bounds = updated;
+            MarkPatched(static_cast<uint32_t>(index + i));
+        }
+    }
+
+    // 补丁过多时命中测试退化为线性扫描，按当前条目重建网格
+    if (m_patched.size() > (std::max)(kMinPatchRebuild, m_entries.size() / 8)) {
+        BuildGrid();
+    }
+    return true;
+}
+
+void SpatialIndex::MarkPatched(uint32_t index) {
+    if (m_isPatched.size() < m_entries.size()) {
+        m_isPatched.resize(m_entries.size(), 0);
+    }
+    if (m_isPatched[index]) return;
+    m_isPatched[index] = 1;
+    m_patched.push_back(index);
+}
+
+void SpatialIndex::BuildGrid() {
+    m_patched.clear();
+    m_isPatched.clear();
+    m_cellStart.clear();
+    m_cellItems.clear();
+    m_cols = 0;
+    m_rows = 0;
+    if (m_entries.empty()) {
+        m_extent = rendering::Rect();
+        return;
+    }
+
+    float left = m_entries[0].bounds.Left();
+    float top = m_entries[0].bounds.Top();
+    float right = m_entries[0].bounds.Right();
+    float bottom = m_entries[0].bounds.Bottom();
+    for (const auto& entry : m_entries) {
+        left = (std::min)(left, entry.bounds.Left());
+        top = (std::min)(top, entry.bounds.Top());
+        right = (std::max)(right, entry.bounds.Right());
+        bottom = (std::max)(bottom, entry.bounds.Bottom());
+    }
+    m_extent = rendering::Rect(left, top, right - left, bottom - top);
+
+    // 单元大小按平均每单元约一个条目选取，并限制网格规模
+    float cellSize = std::sqrt(m_extent.width * m_extent.height / static_cast<float>(m_entries.size()));
+    cellSize = (std::max)(cellSize, m_extent.width / kMaxCells);
+    cellSize = (std::max)(cellSize, m_extent.height / kMaxCells);
+    m_cellSize = (std::min)((std::max)(cellSize, kMinCellSize), kMaxCellSize);
+
+    m_cols = (std::min)((std::max)(static_cast<int>(std::ceil(m_extent.width / m_cellSize)), 1), kMaxCells);
+    m_rows = (std::min)((std::max)(static_cast<int>(std::ceil(m_extent.height / m_cellSize)), 1), kMaxCells);
+
+    // 两遍计数排序：先统计每个单元的条目数，再按绘制顺序填入
+    const size_t cellCount = static_cast<size_t>(m_cols) * m_rows;
+    m_cellStart.assign(cellCount + 1, 0);
+    for (const auto& entry : m_entries) {
+        int x0 = CellX(entry.bounds.Left()), x1 = CellX(entry.bounds.Right());
+        int y0 = CellY(entry.bounds.Top()), y1 = CellY(entry.bounds.Bottom());
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                ++m_cellStart[static_cast<size_t>(cy) * m_cols + cx + 1];
+            }
+        }
+    }
+    for (size_t i = 1; i <= cellCount; ++i) {
+        m_cellStart[i] += m_cellStart[i - 1];
+    }
+
+    m_cellItems.resize(m_cellStart[cellCount]);
+    std::vector<uint32_t> cursor(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        const auto& bounds = m_entries[i].bounds;
+        int x0 = CellX(bounds.Left()), x1 = CellX(bounds.Right());
+        int y0 = CellY(bounds.Top()), y1 = CellY(bounds.Bottom());
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                m_cellItems[cursor[static_cast<size_t>(cy) * m_cols + cx]++] = static_cast<uint32_t>(i);
+            }
+        }
+    }
+}
+
+int SpatialIndex::CellX(float x) const {
+    int cell = static_cast<int>(std::floor((x - m_extent.x) / m_cellSize));
+    return (std::min)((std::max)(cell, 0), m_cols - 1);
+}
+
+int SpatialIndex::CellY(float y) const {
+    int cell = static_cast<int>(std::floor((y - m_extent.y) / m_cellSize));
+    return (std::min)((std::max)(cell, 0), m_rows - 1);
+}
+
+Control* SpatialIndex::HitTest(float x, float y) const {
+    rendering::Point point(x, y);
+    uint32_t best = 0;
+    bool found = false;
+
+    // 单元内条目按绘制顺序升序，从后向前找到的第一个即网格中的最上层
+    if (m_cols > 0 && m_extent.Contains(point)) {
+        size_t cell = static_cast<size_t>(CellY(y)) * m_cols + CellX(x);
+        for (uint32_t i = m_cellStart[cell + 1]; i > m_cellStart[cell]; --i) {
+            uint32_t item = m_cellItems[i - 1];
+            if (m_entries[item].bounds.Contains(point)) {
+                best = item;
+                found = true;
+                break;
+            }
+        }
+    }
+
+    // 建立网格后移动过的条目可能已不在所在单元中，逐个检查并按绘制顺序取最上层
+    for (uint32_t item : m_patched) {
+        if ((!found || item > best) && m_entries[item].bounds.Contains(point)) {
+            best = item;
+            found = true;
+        }
+    }
+    return found ? m_entries[best].control : nullptr;
+}
+
+} // namespace luaui
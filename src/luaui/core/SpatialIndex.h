@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Types.h"
+#include <cstdint>
+#include <vector>
+
+namespace luaui {
+
+class Control;
+
+/**
+ * @brief 控件空间索引（均匀网格）
+ *
+ * 将控件树按绘制顺序展平为 (控件, 全局命中区域) 列表，并按全局坐标分桶到均匀网格中。
+ * 命中测试只需检查点所在网格单元中的少量条目，而无需逐层遍历控件树、
+ * 也不再有逐节点的 dynamic_cast 和 shared_ptr 拷贝。
+ *
+ * 语义与 Window::HitTestControl 一致：
+ * - 只有 Panel 的子控件参与递归，不可见控件及其子树被忽略
+ * - 命中区域为控件全局矩形与所有祖先矩形的交集（点必须落在每一层祖先内）
+ * - 多个条目命中时取绘制顺序最靠后者（后添加的子控件在上，子控件在父控件之上）
+ *
+ * 每个图层（主控件树、各弹出层）依次叠加在前一个图层之上。
+ * 索引只保存裸指针，控件树结构变化后必须重建。
+ *
+ * 布局边界内的子树就地重新布局后，可用 Update 只刷新该子树的条目：子树在条目数组中
+ * 占据连续区间，结构未变时原位改写命中区域，移动过的条目记入补丁列表，
+ * 命中测试时与网格结果按绘制顺序合并；补丁过多时只从条目数组重建网格，不再遍历控件树。
+ */
+class SpatialIndex {
+public:
+    static constexpr float kMinCellSize = 32.0f;
+    static constexpr float kMaxCellSize = 512.0f;
+    static constexpr int kMaxCells = 256;   // 每个方向最多单元数
+
+    SpatialIndex() = default;
+
+    /**
+     * @brief 重建索引
+     * @param layers 各图层根控件，按从下到上的顺序（主控件树在前，弹出层在后）
+     */
+    void Build(const std::vector<Control*>& layers);
+
+    /**
+     * @brief 刷新一个已重新布局的子树的条目
+     *
+     * 子树的根自身矩形必须未变（布局边界就地重新排列），子树的结构（可见控件及其顺序）
+     * 也必须与建立索引时一致。
+     * @return 成功刷新返回 true；子树不在索引中或结构已变化时返回 false，调用方应重建索引
+     */
+    bool Update(Control* subtree);
+
+    /**
+     * @brief 清空索引
+     */
+    void Clear();
+
+    /**
+     * @brief 查找包含指定点的最上层控件
+     * @param x 全局 X 坐标
+     * @param y 全局 Y 坐标
+     * @return 命中的控件，未命中返回 nullptr
+     */
+    Control* HitTest(float x, float y) const;
+
+    /**
+     * @brief 已索引的控件数量
+     */
+    size_t GetCount() const { return m_entries.size(); }
+
+    bool IsEmpty() const { return m_entries.empty(); }
+
+private:
+    struct Entry {
+        Control* control;
+        rendering::Rect bounds;   // 全局命中区域（已按祖先裁剪）
+        uint32_t end;             // 子树条目区间的结束位置（不含）
+    };
+
+    // 按绘制顺序把子树展开到 out 末尾
+    static void Collect(std::vector<Entry>& out, Control* control, float offsetX, float offsetY,
+                        const rendering::Rect& clip);
+
+    // 查找控件的条目下标（沿祖先链逐层在子树区间内查找），不在索引中返回 false
+    bool FindEntry(Control* control, uint32_t& index, uint32_t& parent) const;
+
+    // 标记条目的命中区域已变化（网格中的单元可能已过期）
+    void MarkPatched(uint32_t index);
+
+    // 按条目分布构建网格
+    void BuildGrid();
+
+    // 像素坐标到网格单元（已限制在网格范围内）
+    int CellX(float x) const;
+    int CellY(float y) const;
+
+    std::vector<Entry> m_entries;   // 绘制顺序
+
+    // 建立网格后命中区域变化过的条目：命中测试时逐个检查，数量超过阈值时重建网格
+    static constexpr size_t kMinPatchRebuild = 64;
+    std::vector<uint32_t> m_patched;
+    std::vector<uint8_t> m_isPatched;
+
+    // 网格：单元 i 的条目下标为 m_cellItems[m_cellStart[i] .. m_cellStart[i + 1])，按绘制顺序升序
+    std::vector<uint32_t> m_cellStart;
+    std::vector<uint32_t> m_cellItems;
+    rendering::Rect m_extent;
+    float m_cellSize = kMinCellSize;
+    int m_cols = 0;
+    int m_rows = 0;
+};
+
+} // namespace luaui
@@ -1,21 +1,34 @@
 #include "Window.h"
+#ifdef _WIN32
 #include "../rendering/d2d/D2DRenderEngine.h"
+#endif
 #include "../rendering/d2d/D2DAnimation.h"
+#include "../rendering/BitmapService.h"
 #include "../controls/Control.h"
 #include "../controls/Panel.h"
 #include "../controls/Menu.h"
 #include "Components/InputComponent.h"
+#include "Components/RenderComponent.h"
+#include "Components/LayoutComponent.h"
+#include "WorkStealingPool.h"
 #include "../utils/Logger.h"
 #include "../style/Theme.h"
 #include "../style/ThemeKeys.h"
+#ifdef _WIN32
 #include <objbase.h>
 #include <windowsx.h>
 #include <dwmapi.h>
 #pragma comment(lib, "dwmapi.lib")
+#endif
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 
 using namespace luaui::utils;
 
 namespace luaui {
+
+#ifdef _WIN32
 namespace {
 
 BYTE ToColorByte(float channel) {
@@ -32,6 +45,7 @@ COLORREF ToColorRef(const rendering::Color& color) {
 
 const wchar_t* Window::s_className = L"LuaUI_WindowClass";
 bool Window::s_classRegistered = false;
+#endif
 
 // ============================================================================
 // 构造/析构
@@ -40,16 +54,20 @@ bool Window::s_classRegistered = false;
 Window::Window() = default;
 
 Window::~Window() {
+    rendering::BitmapService::Instance().ClearWakeHandler(this);
     if (m_dispatcher) m_dispatcher->Shutdown();
     if (m_renderer) m_renderer->Shutdown();
+#ifdef _WIN32
     if (m_hWnd) DestroyWindow(m_hWnd);
     CoUninitialize();
+#endif
 }
 
 // ============================================================================
 // 窗口创建与管理
 // ============================================================================
 
+#ifdef _WIN32
 bool Window::Create(HINSTANCE hInstance, const wchar_t* title, int width, int height) {
     HRESULT hr = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED);
     if (FAILED(hr)) return false;
@@ -94,21 +112,16 @@ bool Window::Create(HINSTANCE hInstance, const wchar_t* title, int width, int he
     m_width = static_cast<float>(rc.right - rc.left);
     m_height = static_cast<float>(rc.bottom - rc.top);
     
-    // 初始化调度器
-    m_dispatcher = std::make_unique<Dispatcher>();
+    InitializeFrameState();
     
-    // 初始化动画 Timeline
-    m_timeline = rendering::CreateAnimationTimeline();
-    QueryPerformanceCounter(&m_lastAnimTick);
+    // 图片在工作线程解码，完成后投递消息回到 UI 线程
+    HWND hwnd = m_hWnd;
+    rendering::BitmapService::Instance().SetWakeHandler([hwnd]() {
+        ::PostMessage(hwnd, WM_LUAUI_BITMAPS_READY, 0, 0);
+    }, this);
     
     utils::Logger::Info("Window created successfully");
 
-    // 注册主题回调：主题切换时同步更新标题栏 + 全屏重绘
-    m_themeCallbackId = controls::Theme::GetCurrent().AddCallback([this]() {
-        UpdateTitleBarTheme();
-        InvalidateRender();
-    });
-
     // 初始设置标题栏主题
     UpdateTitleBarTheme();
 
@@ -122,7 +135,7 @@ void Window::Show(int nCmdShow) {
         
         // 确保立即进行首次渲染，避免控件延迟显示
         InvalidateRender();
-        Render();
+        m_scheduler.RunFrame();
         
         UpdateWindow(m_hWnd);
         SetForegroundWindow(m_hWnd);  // 强制激活窗口
@@ -142,6 +155,63 @@ int Window::Run() {
 void Window::Close() {
     if (m_hWnd) PostMessage(m_hWnd, WM_CLOSE, 0, 0);
 }
+#endif
+
+bool Window::CreateHeadless(int width, int height, rendering::IRenderEnginePtr engine) {
+    m_renderer = engine ? std::move(engine) : rendering::CreateSoftwareRenderEngine();
+    if (!m_renderer || !m_renderer->Initialize(rendering::RenderAPI::Software)) return false;
+    
+    rendering::RenderTargetDesc desc;
+    desc.type = rendering::RenderTargetType::Bitmap;
+    desc.width = width;
+    desc.height = height;
+    if (!m_renderer->CreateRenderTarget(desc)) return false;
+    
+    m_width = static_cast<float>(width);
+    m_height = static_cast<float>(height);
+    
+    InitializeFrameState();
+    
+    OnLoaded();
+    return true;
+}
+
+void Window::InitializeFrameState() {
+    // 资源缓存在首次布局之前创建：文本测量从第一次布局起就使用实际字体
+    if (auto* context = m_renderer->GetContext()) {
+        m_resourceCache = std::make_unique<rendering::ResourceCache>(context);
+    }
+    
+    // 初始化调度器（原生窗口上跨线程投递通过窗口消息唤醒 UI 线程）
+    m_dispatcher = std::make_unique<Dispatcher>();
+#ifdef _WIN32
+    m_dispatcher->Initialize(m_hWnd);
+#else
+    m_dispatcher->Initialize();
+#endif
+    
+    // 初始化动画 Timeline
+    m_timeline = rendering::CreateAnimationTimeline();
+    
+    SetupFrameScheduler();
+    
+    // 注册主题回调：主题切换时同步更新标题栏 + 全屏重绘
+    m_themeCallbackId = controls::Theme::GetCurrent().AddCallback([this]() {
+        UpdateTitleBarTheme();
+        InvalidateRender();
+    });
+}
+
+void Window::Resize(int width, int height) {
+    m_width = static_cast<float>(width);
+    m_height = static_cast<float>(height);
+    if (m_renderer) {
+        m_renderer->ResizeRenderTarget(width, height);
+    }
+    m_needsFullRepaint = true;
+    InvalidateLayout();
+    InvalidateRender();
+}
 
 // ============================================================================
 // 内容管理
@@ -158,6 +228,14 @@ void Window::SetRoot(const std::shared_ptr<Control>& root) {
         }
     }
     InvalidateLayout();
+    InvalidateRender();
+}
+
+const std::shared_ptr<AllocationContext>& Window::GetAllocationContext() {
+    if (!m_allocationContext) {
+        m_allocationContext = std::make_shared<AllocationContext>();
+    }
+    return m_allocationContext;
 }
 
 void Window::SetWindowForControlTree(Control* control, Window* window) {
@@ -179,9 +257,20 @@ void Window::SetWindowForControlTree(Control* control, Window* window) {
 // 布局管理
 // ============================================================================
 
+void Window::VerifyNotInLayoutTask() const {
+#ifdef _DEBUG
+    // 并行测量的池任务中产生的失效应由 LayoutComponent::DeferIfInTask 推迟到 UI 线程
+    if (WorkStealingPool::IsInTask()) {
+        throw std::runtime_error("Window invalidated from a parallel layout task!");
+    }
+#endif
+}
+
 void Window::InvalidateLayout() {
+    VerifyNotInLayoutTask();
     Logger::Debug("[Window] InvalidateLayout called");
     m_layoutDirty = true;
+    m_spatialIndexDirty = true;
     
     // 使根控件的布局失效，确保 Measure 和 Arrange 会被重新执行
     if (m_root) {
@@ -191,27 +280,40 @@ void Window::InvalidateLayout() {
         }
     }
     
-    // 使用全局作用符调用 Windows API
-    ::InvalidateRect(m_hWnd, nullptr, FALSE);
+    m_scheduler.RequestLayout();
+}
+
+void Window::InvalidateLayoutSubtree(Control* root) {
+    VerifyNotInLayoutTask();
+    // 空间索引在子树重新布局后只刷新该子树（见 EnsureSpatialIndex）
+    m_layoutManager.Enqueue(root);
+    m_scheduler.RequestLayout();
 }
 
 void Window::InvalidateRender() {
     // 全屏变脏
     m_dirtyRegion.InvalidateAll(m_width, m_height);
-    ::InvalidateRect(m_hWnd, nullptr, FALSE);
+    m_scheduler.RequestRender();
+}
+
+void Window::InvalidateControl(Control* control) {
+    if (!control) return;
+    if (auto* render = control->GetRender()) {
+        render->Invalidate();
+    }
 }
 
 void Window::InvalidateRect(const rendering::Rect& rect) {
+    VerifyNotInLayoutTask();
+    
     // 添加到脏矩形区域
     m_dirtyRegion.AddRect(rect);
     
-    // 转换为 Windows RECT 触发系统重绘
-    RECT rc;
-    rc.left = static_cast<LONG>(rect.x);
-    rc.top = static_cast<LONG>(rect.y);
-    rc.right = static_cast<LONG>(rect.x + rect.width);
-    rc.bottom = static_cast<LONG>(rect.y + rect.height);
-    ::InvalidateRect(m_hWnd, &rc, FALSE);
+    // 布局阶段产生的损坏在本帧内直接绘制，无需再请求一帧
+    if (m_inLayoutPass) return;
+    
+    // 同一帧之前的多次失效只产生一次重绘
+    m_scheduler.RequestRender();
 }
 
 bool Window::NeedsRedraw(const rendering::Rect& bounds) const {
@@ -221,7 +323,7 @@ bool Window::NeedsRedraw(const rendering::Rect& bounds) const {
 void Window::UpdateLayout() {
     Logger::DebugF("[Window] UpdateLayout called, m_layoutDirty=%s", m_layoutDirty ? "true" : "false");
     
-    if (!m_root || !m_layoutDirty) {
+    if (!m_root || (!m_layoutDirty && m_layoutManager.IsEmpty())) {
         Logger::Debug("[Window] UpdateLayout: skipped (no root or not dirty)");
         return;
     }
@@ -232,6 +334,26 @@ void Window::UpdateLayout() {
         return;
     }
     
+    FrameProfiler::PhaseScope profile(ProfilePhase::Layout);
+    if (m_depthFirstLayoutStore && components::LayoutStore::Shared().NeedsReorder(m_root.get())) {
+        components::LayoutStore::Shared().ReorderDepthFirst(m_root.get());
+    }
+    components::LayoutComponent::ParallelMeasureScope parallel(
+        m_parallelLayout ? &WorkStealingPool::Shared() : nullptr);
+    
+    // 只有布局边界内的子树失效：逐个重新布局，不做整窗测量
+    if (!m_layoutDirty) {
+        size_t count = m_layoutManager.Process(&m_relaidSubtrees);
+        // 长时间没有命中测试时不再累积，下一次直接重建
+        if (m_relaidSubtrees.size() > kMaxRelaidSubtrees) {
+            m_relaidSubtrees.clear();
+            m_spatialIndexDirty = true;
+        }
+        Logger::DebugF("[Window] Incremental layout: %zu subtree(s)", count);
+        // 边界尺寸变化时会一路失效到根控件，此时继续整窗布局
+        if (!m_layoutDirty) return;
+    }
+    
     interfaces::LayoutConstraint constraint;
     constraint.available = rendering::Size(m_width, m_height);
     
@@ -244,6 +366,8 @@ void Window::UpdateLayout() {
     layoutable->Arrange(rendering::Rect(0, 0, m_width, m_height));
     
     m_layoutDirty = false;
+    m_spatialIndexDirty = true;
+    m_layoutManager.Clear();   // 整窗布局已覆盖所有排队的子树
     
     Logger::DebugF("[Window] Layout updated: %.0fx%.0f", m_width, m_height);
 }
@@ -253,36 +377,63 @@ void Window::UpdateLayout() {
 // ============================================================================
 
 void Window::OnRender() {
-    if (!m_renderer || !m_renderer->BeginFrame()) {
+    if (!m_renderer) {
+        m_profiler.EndFrame();
         return;
     }
     
-    auto* context = m_renderer->GetContext();
-    if (!context) {
-        m_renderer->Present();
-        return;
-    }
+    // 帧调度器的布局阶段可能已经开始了这一帧
+    m_profiler.BeginFrame();
     
-    // 确保资源缓存已创建
+    // 兜底：Create 中未能创建资源缓存时在首帧补建
     if (!m_resourceCache) {
-        m_resourceCache = std::make_unique<rendering::ResourceCache>(context);
+        if (auto* context = m_renderer->GetContext()) {
+            m_resourceCache = std::make_unique<rendering::ResourceCache>(context);
+        }
     }
     
     // 更新布局（如果需要）
-    if (m_layoutDirty) {
+    // Arrange 会把位置/尺寸发生变化的控件的旧边界和新边界报告为脏区域
+    if (m_layoutDirty || !m_layoutManager.IsEmpty()) {
+        m_inLayoutPass = true;
         UpdateLayout();
-        // 布局变更使全屏变脏
+        m_inLayoutPass = false;
+    }
+    
+    // 叠加层覆盖整个窗口，每帧全屏重绘；
+    // 首帧、尺寸变化和 WM_PAINT 暴露的内容同样需要整窗重绘
+    if (m_profiler.IsOverlayEnabled() || m_needsFullRepaint) {
         m_dirtyRegion.InvalidateAll(m_width, m_height);
     }
     
-    // 检查是否有脏矩形需要重绘（首次渲染或布局后确保有脏区域）
+    // 没有损坏（例如控件都没有移动的重新布局）：跳过本帧，不绘制也不呈现
     if (m_dirtyRegion.IsEmpty()) {
-        // 如果没有指定脏区域，默认全屏渲染（首次渲染场景）
-        m_dirtyRegion.InvalidateAll(m_width, m_height);
+        m_frameStats = rendering::FrameStats();
+        m_profiler.EndFrame();
+        return;
+    }
+    
+    if (!m_renderer->BeginFrame()) {
+        m_profiler.EndFrame();
+        return;
+    }
+    
+    auto* context = m_renderer->GetContext();
+    if (!context) {
+        m_renderer->Present();
+        m_profiler.EndFrame();
+        return;
     }
+    m_needsFullRepaint = false;
     
-    // 获取脏矩形区域列表
-    const auto& dirtyRects = m_dirtyRegion.GetRects();
+    components::RenderComponent::BeginFrame();
+    auto& counters = components::RenderComponent::GetFrameCounters();
+    
+    // 取出本帧的脏矩形（按后端开销模型决定分块绘制还是合并为包围盒）；
+    // 绘制期间新产生的失效留到下一帧
+    std::vector<rendering::Rect> dirtyRects = m_dirtyRegion.GetRenderRects(
+        rendering::RegionCostModel::ForAPI(m_renderer->GetAPI()));
+    m_dirtyRegion.Clear();
     
     // 如果脏区域接近全屏，直接全屏渲染
     bool fullScreenRender = false;
@@ -295,8 +446,11 @@ void Window::OnRender() {
         }
     }
     
+    FrameProfiler::PhaseScope renderPhase(ProfilePhase::Render);
+    
     // 获取主题背景色用于清屏
-    auto windowBgColor = controls::Theme::GetCurrent().GetColor(theme::kBackgroundPrimary);
+    static controls::CachedThemeColor s_windowBgColor(theme::kBackgroundPrimary);
+    auto windowBgColor = s_windowBgColor.Get(controls::Theme::GetCurrent());
 
     if (fullScreenRender) {
         // 全屏渲染（传统方式）
@@ -307,6 +461,7 @@ void Window::OnRender() {
                 renderable->Render(context);
             }
         }
+        RenderPopups(context, rendering::Rect(0, 0, m_width, m_height));
     } else {
         // 局部渲染：对每个脏矩形区域进行裁剪渲染
         for (const auto& dirtyRect : dirtyRects) {
@@ -323,36 +478,51 @@ void Window::OnRender() {
                 RenderWithClipping(m_root.get(), context, dirtyRect);
             }
             
+            // 弹出层同样只在脏矩形内重绘：未清除的像素上重复叠加半透明阴影会越画越深
+            RenderPopups(context, dirtyRect);
+            
             // 恢复裁剪
             context->PopClip();
         }
     }
     
-    // 清除脏矩形区域
-    m_dirtyRegion.Clear();
+    renderPhase.Stop();
     
-    // 渲染弹出层控件（如 Menu）——在所有其他控件之后渲染，确保在最上层
-    for (auto& weak : m_popups) {
-        if (auto popup = weak.lock()) {
-            if (popup->GetIsVisible()) {
-                if (auto* renderable = popup->AsRenderable()) {
-                    renderable->Render(context);
-                }
-            }
-        }
+    // 调试叠加层显示上一个完整帧（含呈现耗时）
+    if (m_profiler.IsOverlayEnabled()) {
+        m_profiler.DrawOverlay(context, m_width, m_height);
     }
     
-    m_renderer->Present();
+    {
+        FrameProfiler::PhaseScope presentPhase(ProfilePhase::Present);
+        m_renderer->Present();
+    }
+    m_profiler.EndFrame();
+    
+    // 资源缓存按帧老化：淘汰长期未用的画刷/文本格式，并保持在字节预算以内
+    m_resourceCache->EndFrame();
+    
+    m_frameStats = m_renderer->GetStats();
+    m_frameStats.controlsDrawn = counters.drawn;
+    m_frameStats.controlsCulled = counters.culled;
+    m_frameStats.dirtyRectCount = static_cast<int>(dirtyRects.size());
+    if (m_profiler.IsEnabled()) {
+        if (const auto* profile = m_profiler.GetFrame()) {
+            m_frameStats.layoutTime = static_cast<float>(profile->GetPhaseMs(ProfilePhase::Layout));
+            m_frameStats.renderTime = static_cast<float>(profile->GetPhaseMs(ProfilePhase::Render));
+            m_frameStats.presentTime = static_cast<float>(profile->GetPhaseMs(ProfilePhase::Present));
+        }
+    }
 }
 
 void Window::RenderWithClipping(Control* control, rendering::IRenderContext* context, 
                                  const rendering::Rect& clipRect) {
     if (!control) return;
     
-    // 获取控件渲染矩形
+    // 获取控件渲染矩形（含阴影等绘制溢出）
     rendering::Rect bounds;
     if (auto* render = control->GetRender()) {
-        bounds = render->GetRenderRect();
+        bounds = render->InflateByInk(render->GetRenderRect());
     }
     
     // 检查是否与裁剪矩形相交
@@ -379,6 +549,20 @@ void Window::RenderWithClipping(Control* control, rendering::IRenderContext* con
     }
 }
 
+void Window::RenderPopups(rendering::IRenderContext* context, const rendering::Rect& clipRect) {
+    // 弹出层控件（如 Menu）在所有其他控件之后渲染，确保在最上层
+    for (auto& weak : m_popups) {
+        auto popup = weak.lock();
+        if (!popup || !popup->GetIsVisible()) continue;
+        auto* render = popup->GetRender();
+        if (!render) continue;
+        
+        if (render->ComputeInkBounds().Intersects(clipRect)) {
+            render->Render(context);
+        }
+    }
+}
+
 void Window::Render() {
     OnRender();
 }
@@ -392,10 +576,13 @@ void Window::RegisterPopup(const std::shared_ptr<Control>& popup) {
         }
     }
     m_popups.push_back(popup);
+    m_spatialIndexDirty = true;
 }
 
 void Window::UnregisterPopup(const std::shared_ptr<Control>& popup) {
     if (!popup) return;
+    // 擦除弹出层原先占据的区域
+    InvalidateControl(popup.get());
     m_popups.erase(
         std::remove_if(m_popups.begin(), m_popups.end(),
             [&popup](const std::weak_ptr<Control>& weak) {
@@ -403,6 +590,7 @@ void Window::UnregisterPopup(const std::shared_ptr<Control>& popup) {
                 return !existing || existing.get() == popup.get();
             }),
         m_popups.end());
+    m_spatialIndexDirty = true;
 }
 
 // ============================================================================
@@ -422,6 +610,7 @@ void Window::UpdateFocus(Control* newFocus) {
             inputComp->KillFocus();
             inputComp->RaiseLostFocus();
         }
+        InvalidateControl(m_focusedControl);
     }
     
     // 设置新焦点
@@ -433,9 +622,8 @@ void Window::UpdateFocus(Control* newFocus) {
                 inputComp->RaiseGotFocus();
             }
         }
+        InvalidateControl(m_focusedControl);
     }
-    
-    InvalidateRender();
 }
 
 void Window::ClearFocus() {
@@ -447,6 +635,11 @@ void Window::ClearFocus() {
 // ============================================================================
 
 Control* Window::HitTest(Control* root, float x, float y, float offsetX, float offsetY) {
+    // 常规路径：查询空间索引，弹出层是索引中的最上层图层
+    if (root == m_root.get() && offsetX == 0 && offsetY == 0 && EnsureSpatialIndex()) {
+        return m_spatialIndex.HitTest(x, y);
+    }
+    
     // 先检查弹出层控件（它们在最上层）
     for (auto it = m_popups.rbegin(); it != m_popups.rend(); ++it) {
         if (auto popup = it->lock()) {
@@ -507,6 +700,49 @@ Control* Window::HitTestControl(Control* root, float x, float y, float offsetX,
     return nullptr;
 }
 
+bool Window::EnsureSpatialIndex() {
+    // 布局尚未完成时控件树可能已增删，索引中的指针不可靠，退回逐层遍历
+    if (m_layoutDirty || !m_layoutManager.IsEmpty()) return false;
+    
+    // 弹出层的显示/隐藏和定位不经过窗口布局，按图层快照判断是否需要重建
+    std::vector<Control*> layers;
+    std::vector<rendering::Rect> layerRects;
+    layers.reserve(m_popups.size() + 1);
+    layerRects.reserve(m_popups.size() + 1);
+    layers.push_back(m_root.get());
+    layerRects.push_back(m_root && m_root->GetRender() ? m_root->GetRender()->GetRenderRect() : rendering::Rect());
+    for (auto& weak : m_popups) {
+        if (auto popup = weak.lock()) {
+            if (popup->GetIsVisible()) {
+                layers.push_back(popup.get());
+                layerRects.push_back(popup->GetRender() ? popup->GetRender()->GetRenderRect() : rendering::Rect());
+            }
+        }
+    }
+    
+    bool changed = m_spatialIndexDirty || layers != m_indexedLayers;
+    for (size_t i = 0; !changed && i < layerRects.size(); ++i) {
+        const auto& a = layerRects[i];
+        const auto& b = m_indexedLayerRects[i];
+        changed = a.x != b.x || a.y != b.y || a.width != b.width || a.height != b.height;
+    }
+    
+    // 只有边界内的子树就地重新布局：原位刷新这些子树的条目，结构变化时退回重建
+    for (size_t i = 0; !changed && i < m_relaidSubtrees.size(); ++i) {
+        auto subtree = m_relaidSubtrees[i].lock();
+        changed = !subtree || !m_spatialIndex.Update(subtree.get());
+    }
+    m_relaidSubtrees.clear();
+    
+    if (changed) {
+        m_spatialIndex.Build(layers);
+        m_indexedLayers = std::move(layers);
+        m_indexedLayerRects = std::move(layerRects);
+        m_spatialIndexDirty = false;
+    }
+    return true;
+}
+
 // ============================================================================
 // 输入处理
 // ============================================================================
@@ -519,7 +755,8 @@ void Window::HandleMouseMove(float x, float y) {
         } else {
             m_capturedControl->OnMouseMove(args);
         }
-        InvalidateRender();
+        // 拖动中（滑块、选区、分隔条等）只重绘捕获鼠标的控件
+        InvalidateControl(m_capturedControl);
         return;
     }
 
@@ -560,6 +797,7 @@ void Window::HandleMouseMove(float x, float y) {
             if (auto* inputComp = m_lastMouseOver->GetInput()) {
                 inputComp->RaiseMouseLeave();
             }
+            InvalidateControl(m_lastMouseOver);
         }
     }
 
@@ -568,6 +806,7 @@ void Window::HandleMouseMove(float x, float y) {
         if (auto* inputComp = control->GetInput()) {
             if (m_lastMouseOver != control) {
                 inputComp->RaiseMouseEnter();
+                InvalidateControl(control);
             }
             controls::MouseEventArgs args{x, y, 0, false};
             inputComp->RaiseMouseMove(args);
@@ -587,8 +826,8 @@ void Window::HandleMouseMove(float x, float y) {
         }
     }
 
+    // 鼠标在同一控件内移动不重绘；控件内部的悬停变化（列表项、菜单项等）由控件自行 Invalidate
     m_lastMouseOver = control;
-    InvalidateRender();
 }
 
 void Window::HandleMouseDown(float x, float y, int button) {
@@ -625,7 +864,9 @@ void Window::HandleMouseDown(float x, float y, int button) {
     
     if (control) {
         m_capturedControl = control;
+#ifdef _WIN32
         SetCapture(m_hWnd);
+#endif
 
         controls::MouseEventArgs args{x, y, button, false};
 
@@ -648,13 +889,19 @@ void Window::HandleMouseDown(float x, float y, int button) {
         if (args.Handled && current && current != m_capturedControl) {
             m_capturedControl = current;
         }
+        
+        // 按下状态只影响命中的控件和处理事件的控件
+        InvalidateControl(control);
+        if (m_capturedControl != control) {
+            InvalidateControl(m_capturedControl);
+        }
     }
-    
-    InvalidateRender();
 }
 
 void Window::HandleMouseUp(float x, float y, int button) {
+#ifdef _WIN32
     ReleaseCapture();
+#endif
     
     utils::Logger::DebugF("[Window] MouseUp at (%.1f,%.1f), captured=%s", 
         x, y, m_capturedControl ? m_capturedControl->GetTypeName().c_str() : "null");
@@ -676,6 +923,7 @@ void Window::HandleMouseUp(float x, float y, int button) {
                 }
             }
         }
+        InvalidateControl(m_capturedControl);
         m_capturedControl = nullptr;
     } else {
         auto* control = HitTest(m_root.get(), x, y, 0, 0);
@@ -685,10 +933,9 @@ void Window::HandleMouseUp(float x, float y, int button) {
                 inputComp->RaiseMouseUp(args);
                 inputComp->RaiseClick();
             }
+            InvalidateControl(control);
         }
     }
-    
-    InvalidateRender();
 }
 
 void Window::HandleMouseDoubleClick(float x, float y, int button) {
@@ -702,7 +949,9 @@ void Window::HandleMouseDoubleClick(float x, float y, int button) {
 
         // 从命中的控件开始，向上冒泡直到有人处理
         Control* current = control;
+        Control* handler = control;
         while (current && !args.Handled) {
+            handler = current;
             if (auto* inputComp = current->GetInput()) {
                 inputComp->RaiseMouseDoubleClick(args);
             } else {
@@ -712,9 +961,8 @@ void Window::HandleMouseDoubleClick(float x, float y, int button) {
             auto parent = current->GetParent();
             current = parent ? static_cast<Control*>(parent.get()) : nullptr;
         }
+        InvalidateControl(handler);
     }
-    
-    InvalidateRender();
 }
 
 void Window::HandleMouseWheel(float x, float y, int delta) {
@@ -725,7 +973,9 @@ void Window::HandleMouseWheel(float x, float y, int delta) {
 
         // 从命中的控件开始，向上冒泡直到有人处理
         Control* current = control;
+        Control* handler = control;
         while (current && !args.Handled) {
+            handler = current;
             // 先尝试通过 InputComponent（Button, TextBox 等控件）
             if (auto* inputComp = current->GetInput()) {
                 inputComp->RaiseMouseWheel(args);
@@ -737,9 +987,9 @@ void Window::HandleMouseWheel(float x, float y, int delta) {
             auto parent = current->GetParent();
             current = parent ? static_cast<Control*>(parent.get()) : nullptr;
         }
+        // 滚动偏移变化经布局报告损坏区域，这里只处理处理者自身的视觉状态
+        InvalidateControl(handler);
     }
-
-    InvalidateRender();
 }
 
 void Window::HandleKeyDown(int keyCode) {
@@ -752,8 +1002,8 @@ void Window::HandleKeyDown(int keyCode) {
             controls::KeyEventArgs args{keyCode, false, false, false, false, false};
             inputComp->RaiseKeyDown(args);
         }
+        InvalidateControl(m_focusedControl);
     }
-    InvalidateRender();
 }
 
 void Window::HandleKeyUp(int keyCode) {
@@ -764,8 +1014,8 @@ void Window::HandleKeyUp(int keyCode) {
             controls::KeyEventArgs args{keyCode, false, false, false, false, false};
             inputComp->RaiseKeyUp(args);
         }
+        InvalidateControl(m_focusedControl);
     }
-    InvalidateRender();
 }
 
 void Window::HandleChar(wchar_t ch) {
@@ -775,51 +1025,63 @@ void Window::HandleChar(wchar_t ch) {
         if (auto* inputComp = m_focusedControl->GetInput()) {
             inputComp->RaiseChar(ch);
         }
+        InvalidateControl(m_focusedControl);
     }
-    InvalidateRender();
 }
 
 // ============================================================================
-// 动画帧驱动
+// 帧调度
 // ============================================================================
 
-void Window::StartAnimTimer() {
-    if (m_animTimerRunning || !m_hWnd) return;
-    ::SetTimer(m_hWnd, ANIM_TIMER_ID, ANIM_INTERVAL_MS, nullptr);
-    m_animTimerRunning = true;
-    QueryPerformanceCounter(&m_lastAnimTick);
+void Window::SetupFrameScheduler() {
+    FrameScheduler::Pipeline pipeline;
+    pipeline.runTask = [this]() {
+        return m_dispatcher && m_dispatcher->ProcessOneTask();
+    };
+    pipeline.update = [this](double deltaMs) {
+        // 动画通过控件属性的 setter 驱动，由被修改的控件自行 Invalidate，
+        // 产生的重绘在本帧的渲染阶段一并完成
+        if (!m_timeline) return false;
+        m_timeline->Update(static_cast<float>(deltaMs));
+        return m_timeline->HasActiveAnimations();
+    };
+    pipeline.layout = [this]() {
+        // 布局与随后的渲染计入同一个分析帧
+        m_profiler.BeginFrame();
+        
+        // Arrange 报告的脏区域在本帧内绘制
+        m_inLayoutPass = true;
+        UpdateLayout();
+        m_inLayoutPass = false;
+    };
+    pipeline.render = [this]() {
+        Render();
+    };
+    m_scheduler.SetPipeline(std::move(pipeline));
+    m_scheduler.SetWakeHandler([this](double delayMs) {
+        WakeForFrame(delayMs);
+    });
 }
 
-void Window::StopAnimTimer() {
-    if (!m_animTimerRunning || !m_hWnd) return;
-    ::KillTimer(m_hWnd, ANIM_TIMER_ID);
-    m_animTimerRunning = false;
+void Window::WakeForFrame(double delayMs) {
+#ifdef _WIN32
+    if (!m_hWnd) return;
+    
+    // 距上一帧不足一个帧间隔时用一次性定时器等待，否则直接投递消息
+    if (delayMs < 1.0) {
+        ::PostMessage(m_hWnd, WM_LUAUI_FRAME, 0, 0);
+    } else {
+        ::SetTimer(m_hWnd, FRAME_TIMER_ID, static_cast<UINT>(std::ceil(delayMs)), nullptr);
+    }
+#else
+    // 离屏窗口没有消息循环，由宿主调用 RunFrame 推进帧
+    (void)delayMs;
+#endif
 }
 
-void Window::OnAnimTimerTick() {
+void Window::RequestAnimationFrames() {
     if (!m_timeline) return;
-
-    LARGE_INTEGER now;
-    QueryPerformanceCounter(&now);
-
-    LARGE_INTEGER freq;
-    QueryPerformanceFrequency(&freq);
-
-    float deltaMs = 0.0f;
-    if (freq.QuadPart > 0 && m_lastAnimTick.QuadPart > 0) {
-        deltaMs = static_cast<float>(
-            (now.QuadPart - m_lastAnimTick.QuadPart) * 1000.0 / freq.QuadPart);
-    }
-    m_lastAnimTick = now;
-
-    m_timeline->Update(deltaMs);
-
-    // 没有活跃动画时自动停止 Timer，节省 CPU
-    if (!m_timeline->HasActiveAnimations()) {
-        StopAnimTimer();
-    }
-
-    InvalidateRender();
+    m_scheduler.RequestAnimation();
 }
 
 // ============================================================================
@@ -827,6 +1089,7 @@ void Window::OnAnimTimerTick() {
 // ============================================================================
 
 void Window::UpdateTitleBarTheme() {
+#ifdef _WIN32
     if (!m_hWnd) return;
 
     const auto& currentTheme = controls::Theme::GetCurrent();
@@ -853,10 +1116,12 @@ void Window::UpdateTitleBarTheme() {
 
     SetWindowPos(m_hWnd, nullptr, 0, 0, 0, 0,
                  SWP_NOACTIVATE | SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER | SWP_FRAMECHANGED);
+#endif
 }
 
 void Window::SetExtendFrameIntoClientArea(bool enable) {
     m_extendFrame = enable;
+#ifdef _WIN32
     if (!m_hWnd) return;
 
     if (enable) {
@@ -880,12 +1145,14 @@ void Window::SetExtendFrameIntoClientArea(bool enable) {
     }
 
     UpdateTitleBarTheme();
+#endif
 }
 
 // ============================================================================
 // 窗口过程
 // ============================================================================
 
+#ifdef _WIN32
 LRESULT CALLBACK Window::StaticWndProc(HWND hWnd, UINT msg, WPARAM wP, LPARAM lP) {
     Window* wnd = nullptr;
     if (msg == WM_NCCREATE) {
@@ -899,6 +1166,12 @@ LRESULT CALLBACK Window::StaticWndProc(HWND hWnd, UINT msg, WPARAM wP, LPARAM lP
 }
 
 LRESULT Window::WndProc(UINT msg, WPARAM wP, LPARAM lP) {
+    // 调度器任务在下一帧的任务阶段执行，与布局和渲染合并
+    if (Dispatcher::IsInvokeMessage(msg)) {
+        m_scheduler.RequestTasks();
+        return 0;
+    }
+    
     switch (msg) {
         case WM_NCCALCSIZE: {
             if (!m_extendFrame) {
@@ -925,17 +1198,29 @@ LRESULT Window::WndProc(UINT msg, WPARAM wP, LPARAM lP) {
 
         // ========== 渲染 ==========
         case WM_PAINT: {
+            // 系统要求的重绘（窗口暴露、调整大小）立即完成，不等待下一帧
             PAINTSTRUCT ps;
             BeginPaint(m_hWnd, &ps);
-            Render();
+            m_needsFullRepaint = true;
+            m_scheduler.RequestRender();
+            m_scheduler.RunFrame();
             EndPaint(m_hWnd, &ps);
             return 0;
         }
         
-        // ========== 动画帧驱动 ==========
+        // ========== 帧调度 ==========
+        case WM_LUAUI_FRAME:
+            m_scheduler.RunFrame();
+            return 0;
+        
+        case WM_LUAUI_BITMAPS_READY:
+            rendering::BitmapService::Instance().DispatchCompletions();
+            return 0;
+        
         case WM_TIMER: {
-            if (wP == ANIM_TIMER_ID) {
-                OnAnimTimerTick();
+            if (wP == FRAME_TIMER_ID) {
+                ::KillTimer(m_hWnd, FRAME_TIMER_ID);
+                m_scheduler.RunFrame();
                 return 0;
             }
             break;
@@ -943,12 +1228,7 @@ LRESULT Window::WndProc(UINT msg, WPARAM wP, LPARAM lP) {
         
         // ========== 窗口大小变化 ==========
         case WM_SIZE: {
-            m_width = static_cast<float>(LOWORD(lP));
-            m_height = static_cast<float>(HIWORD(lP));
-            if (m_renderer) {
-                m_renderer->ResizeRenderTarget(static_cast<int>(m_width), static_cast<int>(m_height));
-            }
-            InvalidateLayout();
+            Resize(LOWORD(lP), HIWORD(lP));
             return 0;
         }
         
@@ -1112,6 +1392,8 @@ LRESULT Window::WndProc(UINT msg, WPARAM wP, LPARAM lP) {
             return 0;
             
         case WM_DESTROY:
+            ::KillTimer(m_hWnd, FRAME_TIMER_ID);
+            rendering::BitmapService::Instance().ClearWakeHandler(this);
             OnClosed();
             PostQuitMessage(0);
             return 0;
@@ -1119,6 +1401,7 @@ LRESULT Window::WndProc(UINT msg, WPARAM wP, LPARAM lP) {
     
     return DefWindowProc(m_hWnd, msg, wP, lP);
 }
+#endif
 
 // ============================================================================
 // 可重写的虚拟函数（默认实现）
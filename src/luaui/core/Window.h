@@ -1,14 +1,22 @@
 #pragma once
 
 #include "Control.h"
+#include "AllocationContext.h"
 #include "IRenderEngine.h"
 #include "Types.h"
 #include "Dispatcher.h"
 #include "Logger.h"
 #include "DirtyRegion.h"
 #include "ResourceCache.h"
+#include "SpatialIndex.h"
+#include "FrameScheduler.h"
+#include "LayoutManager.h"
+#include "FrameProfiler.h"
 #include "IAnimation.h"
+#include "KeyCodes.h"
+#ifdef _WIN32
 #include <windows.h>
+#endif
 #include <memory>
 #include <functional>
 
@@ -37,21 +45,62 @@ public:
     virtual ~Window();
 
     // ========== 窗口生命周期 ==========
+#ifdef _WIN32
     bool Create(HINSTANCE hInstance, const wchar_t* title, int width, int height);
     int Run();
     void Close();
     
     HWND GetHandle() const { return m_hWnd; }
     void Show(int nCmdShow = SW_SHOW);
+#endif
+    
+    /**
+     * @brief 创建无原生窗口的离屏窗口（测试、基准、CI）
+     * @param engine 渲染引擎，为空时使用软件渲染引擎
+     *
+     * 不创建消息循环：宿主通过 GetFrameScheduler().RunFrame() 推进帧。
+     */
+    bool CreateHeadless(int width, int height, rendering::IRenderEnginePtr engine = nullptr);
+    
+    /** @brief 调整客户区尺寸（原生窗口由 WM_SIZE 调用） */
+    void Resize(int width, int height);
     
     // ========== 内容管理 ==========
     void SetRoot(const std::shared_ptr<Control>& root);
     std::shared_ptr<Control> GetRoot() const { return m_root; }
     
+    /**
+     * @brief 本窗口的控件分配上下文（首次调用时创建）
+     *
+     * 交给 XmlLoader / MvvmXmlLoader 的 SetAllocationContext，窗口内容从同一内存池分配，
+     * 窗口和其中的控件都释放后内存整体归还。
+     */
+    const std::shared_ptr<AllocationContext>& GetAllocationContext();
+    
     // ========== 布局管理 ==========
     void InvalidateLayout();
+    /** @brief 只重新布局以 root 为根的子树（root 为布局边界，期望尺寸不变） */
+    void InvalidateLayoutSubtree(Control* root);
     void InvalidateRender();
     
+    /**
+     * @brief 启用并行布局：面板的兄弟子树在共享的工作窃取线程池上并发测量
+     *
+     * 结果与顺序布局一致；要求控件的测量只访问自身子树（见 LayoutComponent::MeasureChildren）。
+     * 默认关闭。
+     */
+    void SetParallelLayout(bool enabled) { m_parallelLayout = enabled; }
+    bool IsParallelLayoutEnabled() const { return m_parallelLayout; }
+    
+    /**
+     * @brief 布局前按需把控件树在 LayoutStore 中的槽位重排为深度优先顺序
+     *
+     * 控件数很多（数万以上）时测量/排列按顺序访问布局状态，减少缓存未命中；
+     * 只有自上次重排后树结构变化足够多时才重排（见 LayoutStore::NeedsReorder）。默认关闭。
+     */
+    void SetDepthFirstLayoutStore(bool enabled) { m_depthFirstLayoutStore = enabled; }
+    bool IsDepthFirstLayoutStoreEnabled() const { return m_depthFirstLayoutStore; }
+    
     // ========== 脏矩形优化 ==========
     /**
      * @brief 使指定区域变脏，触发局部重绘
@@ -69,11 +118,26 @@ public:
      */
     bool NeedsRedraw(const rendering::Rect& bounds) const;
     
+    /**
+     * @brief 获取渲染引擎（用于创建离屏渲染目标等）
+     */
+    rendering::IRenderEngine* GetRenderEngine() const { return m_renderer.get(); }
+    
     /**
      * @brief 获取资源缓存
      */
     rendering::ResourceCache* GetResourceCache() const { return m_resourceCache.get(); }
     
+    /**
+     * @brief 上一帧的渲染统计（含绘制/剔除的控件数）
+     */
+    const rendering::FrameStats& GetFrameStats() const { return m_frameStats; }
+    
+    /**
+     * @brief 帧分析器（分阶段耗时、控件开销、布局抖动；可开启调试叠加层）
+     */
+    FrameProfiler& GetProfiler() { return m_profiler; }
+    
     // ========== 弹出层管理 ==========
     /** @brief 注册弹出层控件（如 Menu），在最上层渲染 */
     void RegisterPopup(const std::shared_ptr<Control>& popup);
@@ -87,14 +151,14 @@ public:
     // ========== 调度器 ==========
     Dispatcher* GetDispatcher() const { return m_dispatcher.get(); }
 
+    /** @brief 帧调度器：合并布局、重绘、动画和调度器任务，每帧执行一次 */
+    FrameScheduler& GetFrameScheduler() { return m_scheduler; }
+
     // ========== 动画系统 ==========
     rendering::IAnimationTimeline* GetTimeline() const { return m_timeline.get(); }
 
-    /** @brief 启动动画定时器（有活跃动画时自动调用） */
-    void StartAnimTimer();
-
-    /** @brief 停止动画定时器（无活跃动画时自动调用以节省 CPU） */
-    void StopAnimTimer();
+    /** @brief 请求逐帧推进动画（Timeline 无活跃动画后自动停止） */
+    void RequestAnimationFrames();
 
     // ========== 无框窗口 ==========
     /** @brief 将窗口框架扩展到客户区，隐藏系统标题栏 */
@@ -119,16 +183,24 @@ protected:
     virtual void OnChar(wchar_t ch);
 
 private:
+#ifdef _WIN32
     // ========== 窗口过程 ==========
     static LRESULT CALLBACK StaticWndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam);
     LRESULT WndProc(UINT message, WPARAM wParam, LPARAM lParam);
+#endif
+    
+    /** @brief 渲染引擎就绪后的公共初始化（资源缓存、调度器、动画、帧调度） */
+    void InitializeFrameState();
 
     // ========== 渲染 ==========
     void Render();
     void UpdateLayout();
     
-    // ========== 动画帧驱动 ==========
-    void OnAnimTimerTick();
+    // ========== 帧调度 ==========
+    /** @brief 将布局、动画和渲染接入帧调度器 */
+    void SetupFrameScheduler();
+    /** @brief 按调度器给出的延迟唤醒消息循环执行下一帧 */
+    void WakeForFrame(double delayMs);
 
     // ========== 标题栏主题 ==========
     void UpdateTitleBarTheme();
@@ -147,9 +219,21 @@ private:
     Control* HitTest(Control* root, float x, float y, float offsetX = 0, float offsetY = 0);
     Control* HitTestControl(Control* root, float x, float y, float offsetX, float offsetY);
     
+    /** @brief 调试版本中检查失效不是从并行测量的池任务中发出的 */
+    void VerifyNotInLayoutTask() const;
+    
+    /** @brief 确保空间索引与当前控件树一致（必要时重建），布局未完成时返回 false */
+    bool EnsureSpatialIndex();
+    
     // ========== 带裁剪的渲染 ==========
     void RenderWithClipping(Control* control, rendering::IRenderContext* context, 
                             const rendering::Rect& clipRect);
+    /** @brief 绘制与裁剪矩形相交的可见弹出层 */
+    void RenderPopups(rendering::IRenderContext* context, const rendering::Rect& clipRect);
+    
+    // ========== 局部失效 ==========
+    /** @brief 使单个控件失效（报告其旧边界和新边界），用于输入和焦点变化 */
+    void InvalidateControl(Control* control);
     
     // ========== 递归设置 Window 指针 ==========
     void SetWindowForControlTree(Control* control, Window* window);
@@ -159,29 +243,53 @@ private:
     void ClearFocus();
     
     // ========== 成员变量 ==========
+#ifdef _WIN32
     HWND m_hWnd = nullptr;
     HINSTANCE m_hInstance = nullptr;
+#endif
     std::unique_ptr<rendering::IRenderEngine> m_renderer;
     std::unique_ptr<Dispatcher> m_dispatcher;
+    std::shared_ptr<AllocationContext> m_allocationContext;
     std::shared_ptr<Control> m_root;
     
     // 布局状态
     bool m_layoutDirty = true;
+    LayoutManager m_layoutManager;   // 布局边界内的增量布局队列
+    bool m_parallelLayout = false;
+    bool m_depthFirstLayoutStore = false;
     float m_width = 0;
     float m_height = 0;
     
     // 脏矩形区域（优化渲染）
     rendering::DirtyRegion m_dirtyRegion;
+    bool m_inLayoutPass = false;   // 布局阶段报告的脏区域在本帧内绘制
+    bool m_needsFullRepaint = true;   // 首帧、尺寸变化、WM_PAINT：下一帧整窗重绘（其余只绘制损坏区域）
+    rendering::FrameStats m_frameStats;
+    FrameProfiler m_profiler;
+    
+    // 命中测试空间索引（整窗布局后在下一次命中测试时重建，增量布局只刷新重新布局的子树）
+    SpatialIndex m_spatialIndex;
+    bool m_spatialIndexDirty = true;
+    std::vector<std::weak_ptr<Control>> m_relaidSubtrees;   // 上次建立索引后就地重新布局的子树
+    static constexpr size_t kMaxRelaidSubtrees = 256;
+    std::vector<Control*> m_indexedLayers;             // 建立索引时的图层（根控件 + 可见弹出层）
+    std::vector<rendering::Rect> m_indexedLayerRects;  // 建立索引时各图层根控件的矩形
     
     // 资源缓存（画刷、文本格式等）
     std::unique_ptr<rendering::ResourceCache> m_resourceCache;
     
+#ifdef _WIN32
+    // 帧调度（取代 WM_PAINT 驱动渲染和固定 16ms 动画定时器）
+    static constexpr UINT_PTR FRAME_TIMER_ID = 1;
+    static constexpr UINT WM_LUAUI_FRAME = WM_USER + 0x1002;
+    
+    // 异步位图解码完成（工作线程投递，UI 线程执行完成回调）
+    static constexpr UINT WM_LUAUI_BITMAPS_READY = WM_USER + 0x1003;
+#endif
+    FrameScheduler m_scheduler;
+    
     // 动画系统
-    static constexpr UINT_PTR ANIM_TIMER_ID = 1;
-    static constexpr UINT ANIM_INTERVAL_MS = 16;  // ~60fps
     std::unique_ptr<rendering::IAnimationTimeline> m_timeline;
-    bool m_animTimerRunning = false;
-    LARGE_INTEGER m_lastAnimTick = {};
     
     // 输入状态
     Control* m_capturedControl = nullptr;   // 鼠标捕获的控件
@@ -200,8 +308,10 @@ private:
     // 关闭所有弹出菜单
     void CloseAllPopupMenus();
 
+#ifdef _WIN32
     static const wchar_t* s_className;
     static bool s_classRegistered;
+#endif
     
     // ========== 测试支持 ==========
     // 定义测试友元类，允许自动化测试访问内部方法
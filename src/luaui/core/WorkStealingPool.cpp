@@ -0,0 +1,159 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+
+namespace luaui {
+
+namespace {
+
+// 当前线程所属的池和队列下标（非池线程为空）
+thread_local WorkStealingPool* t_pool = nullptr;
+thread_local size_t t_queueIndex = 0;
+// 当前线程正在执行的任务嵌套深度
+thread_local int t_taskDepth = 0;
+
+} // anonymous namespace
+
+WorkStealingPool::WorkStealingPool(size_t workerCount) {
+    if (workerCount == 0) {
+        unsigned hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 0;
+    }
+
+    m_queues.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        m_queues.push_back(std::make_unique<Queue>());
+    }
+    m_workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back([this, i]() { WorkerLoop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    m_stop = true;
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+WorkStealingPool& WorkStealingPool::Shared() {
+    static WorkStealingPool s_pool;
+    return s_pool;
+}
+
+bool WorkStealingPool::IsInTask() {
+    return t_taskDepth > 0;
+}
+
+void WorkStealingPool::ParallelFor(size_t count, size_t maxChunks, const RangeFn& fn) {
+    if (count == 0) return;
+
+    size_t chunks = (std::min)(count, (std::max)(maxChunks, size_t(1)));
+    if (chunks <= 1 || m_workers.empty()) {
+        fn(0, count);
+        return;
+    }
+
+    Group group;
+    group.pending = chunks;
+
+    // 池线程压入自己的队列，其他线程压入注入队列
+    Queue& own = (t_pool == this) ? *m_queues[t_queueIndex] : m_injection;
+    size_t chunkSize = count / chunks;
+    size_t remainder = count % chunks;
+    size_t firstEnd = chunkSize + (remainder > 0 ? 1 : 0);
+    {
+        std::lock_guard<std::mutex> lock(own.mutex);
+        size_t begin = firstEnd;
+        for (size_t i = 1; i < chunks; ++i) {
+            size_t end = begin + chunkSize + (i < remainder ? 1 : 0);
+            own.tasks.push_back(Task{&fn, begin, end, &group});
+            begin = end;
+        }
+    }
+    m_queued.fetch_add(chunks - 1);
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wake.notify_all();
+
+    // 第一段在调用线程上直接执行，其余段完成前帮忙执行任意任务
+    Execute(Task{&fn, 0, firstEnd, &group});
+    while (group.pending.load(std::memory_order_acquire) > 0) {
+        Task task;
+        if (FindTask(&own, task)) {
+            Execute(task);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    if (group.error) {
+        std::rethrow_exception(group.error);
+    }
+}
+
+void WorkStealingPool::Execute(const Task& task) {
+    ++t_taskDepth;
+    try {
+        (*task.fn)(task.begin, task.end);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(task.group->errorMutex);
+        if (!task.group->error) task.group->error = std::current_exception();
+    }
+    --t_taskDepth;
+    task.group->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+bool WorkStealingPool::TryPop(Queue& queue, Task& task, bool fromBack) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    if (fromBack) {
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+    } else {
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+    }
+    m_queued.fetch_sub(1);
+    return true;
+}
+
+bool WorkStealingPool::FindTask(Queue* own, Task& task) {
+    if (own && TryPop(*own, task, true)) return true;
+    if (own != &m_injection && TryPop(m_injection, task, false)) return true;
+
+    // 从其他工作线程的队列头部窃取，起点错开以分散竞争
+    size_t count = m_queues.size();
+    size_t start = (t_pool == this) ? t_queueIndex + 1 : 0;
+    for (size_t i = 0; i < count; ++i) {
+        Queue& victim = *m_queues[(start + i) % count];
+        if (&victim == own) continue;
+        if (TryPop(victim, task, false)) return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::WorkerLoop(size_t index) {
+    t_pool = this;
+    t_queueIndex = index;
+    Queue& own = *m_queues[index];
+
+    for (;;) {
+        Task task;
+        if (FindTask(&own, task)) {
+            Execute(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this]() { return m_stop.load() || m_queued.load() > 0; });
+        if (m_stop && m_queued.load() == 0) return;
+    }
+}
+
+} // namespace luaui
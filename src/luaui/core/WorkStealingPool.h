@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace luaui {
+
+/**
+ * @brief 工作窃取线程池（fork-join）
+ *
+ * 每个工作线程有自己的任务双端队列：自己从尾部取（后进先出，保持缓存局部性），
+ * 其他线程从头部窃取（先进先出，窃取到的通常是更大的子树）。
+ * 非池线程提交的任务进入共享的注入队列。
+ *
+ * ParallelFor 的调用线程不会阻塞等待，而是在任务完成前持续执行自己的任务或窃取任务，
+ * 因此任务内部可以再次调用 ParallelFor（嵌套并行），不会因线程全部等待而死锁。
+ *
+ * 任务中抛出的第一个异常在 ParallelFor 返回前重新抛出。
+ */
+class WorkStealingPool {
+public:
+    using RangeFn = std::function<void(size_t begin, size_t end)>;
+
+    /**
+     * @param workerCount 工作线程数；0 表示硬件线程数减一（调用线程也参与执行）
+     */
+    explicit WorkStealingPool(size_t workerCount = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * @brief 把 [0, count) 切分为至多 maxChunks 段并行执行，全部完成后返回
+     *
+     * 只有一段或没有工作线程时直接在调用线程上顺序执行。
+     */
+    void ParallelFor(size_t count, size_t maxChunks, const RangeFn& fn);
+
+    size_t GetWorkerCount() const { return m_workers.size(); }
+
+    /**
+     * @brief 当前线程是否正在执行池任务（包括参与执行的调用线程）
+     */
+    static bool IsInTask();
+
+    /**
+     * @brief 进程共享的线程池（首次使用时创建）
+     */
+    static WorkStealingPool& Shared();
+
+private:
+    struct Group {
+        std::atomic<size_t> pending{0};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+
+    struct Task {
+        const RangeFn* fn = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+        Group* group = nullptr;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void WorkerLoop(size_t index);
+    bool TryPop(Queue& queue, Task& task, bool fromBack);
+    bool FindTask(Queue* own, Task& task);
+    static void Execute(const Task& task);
+
+    std::vector<std::unique_ptr<Queue>> m_queues;   // 每个工作线程一个
+    Queue m_injection;                              // 非池线程提交的任务
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::atomic<size_t> m_queued{0};                // 所有队列中尚未取走的任务数
+    std::atomic<bool> m_stop{false};
+};
+
+} // namespace luaui
@@ -108,7 +108,7 @@ public:
     void UnsubscribeCollectionChanged(CollectionChangedHandler handler) override {
         auto it = std::find_if(m_handlers.begin(), m_handlers.end(),
             [&handler](const auto& h) {
-                return h.target<void(const NotifyCollectionChangedEventArgs&)>() == 
+                return h.template target<void(const NotifyCollectionChangedEventArgs&)>() == 
                        handler.target<void(const NotifyCollectionChangedEventArgs&)>();
             });
         if (it != m_handlers.end()) {
@@ -13,13 +13,19 @@
 #include "Panel.h"  // StackPanel, WrapPanel
 
 // Lua binding for collection support
+#ifndef LUAUI_MVVM_NO_LUA
 #include "../lua/LuaObservableCollection.h"
 #include "../lua/LuaAwareMvvmLoader.h"
+#endif
 
 #include <tinyxml2.h>
 #include <sstream>
 #include <algorithm>
 #include <cstring>
+#ifndef _WIN32
+#include <strings.h>
+#define _stricmp strcasecmp
+#endif
 
 namespace luaui {
 namespace mvvm {
@@ -30,6 +36,16 @@ struct DataGridColumnSpec {
     std::string path;
 };
 
+#ifdef LUAUI_MVVM_NO_LUA
+// 无 Lua 的构建中 DataContext 不可能是 Lua ViewModel，Lua 分支全部跳过
+std::shared_ptr<INotifyPropertyChanged> AsLuaViewModel(const std::shared_ptr<INotifyPropertyChanged>&) {
+    return nullptr;
+}
+#else
+std::shared_ptr<lua::LuaPropertyNotifier> AsLuaViewModel(const std::shared_ptr<INotifyPropertyChanged>& dataContext) {
+    return std::dynamic_pointer_cast<lua::LuaPropertyNotifier>(dataContext);
+}
+
 bool PushLuaViewModel(lua_State* L) {
     if (!L) {
         return false;
@@ -218,6 +234,7 @@ std::vector<DataGridColumnSpec> BuildDataGridColumnSpecsFromLuaCollection(
 
     return specs;
 }
+#endif
 
 std::vector<DataGridColumnSpec> BuildDataGridColumnSpecsFromControl(
     const std::shared_ptr<luaui::controls::DataGrid>& dataGrid) {
@@ -246,6 +263,7 @@ std::vector<DataGridColumnSpec> BuildDataGridColumnSpecsFromControl(
     return specs;
 }
 
+#ifndef LUAUI_MVVM_NO_LUA
 std::wstring GetLuaCellText(lua_State* L, int itemIndex, const DataGridColumnSpec& spec) {
     if (!L) {
         return L"";
@@ -264,6 +282,7 @@ std::wstring GetLuaCellText(lua_State* L, int itemIndex, const DataGridColumnSpe
     lua_pop(L, 1);
     return value;
 }
+#endif
 
 bool TryParseGridLengthValue(const std::string& text, luaui::controls::GridLength& out) {
     std::string trimmed = luaui::utils::StringUtils::Trim(text);
@@ -332,6 +351,7 @@ MvvmXmlLoader::MvvmXmlLoader()
 
 std::shared_ptr<luaui::Control> MvvmXmlLoader::Load(const std::string& filePath) {
     utils::Logger::InfoF("[MVVM] Loading XML: %s", filePath.c_str());
+    AllocationContext::Scope allocationScope(m_allocationContext.get());
     
     // 清空之前的待处理绑定
     m_pendingBindings.clear();
@@ -380,6 +400,8 @@ std::shared_ptr<luaui::Control> MvvmXmlLoader::Load(const std::string& filePath)
 }
 
 std::shared_ptr<luaui::Control> MvvmXmlLoader::LoadFromString(const std::string& xmlString) {
+    AllocationContext::Scope allocationScope(m_allocationContext.get());
+    
     // 清空之前的待处理绑定
     m_pendingBindings.clear();
     
@@ -478,6 +500,11 @@ void MvvmXmlLoader::RegisterTextChangedHandler(const std::string& methodName,
     m_baseLoader->RegisterTextChangedHandler(methodName, handler);
 }
 
+void MvvmXmlLoader::SetAllocationContext(std::shared_ptr<AllocationContext> context) {
+    m_allocationContext = context;
+    m_baseLoader->SetAllocationContext(std::move(context));
+}
+
 void MvvmXmlLoader::SetDataContext(std::shared_ptr<INotifyPropertyChanged> context) {
     m_dataContext = context;
     ConnectBindings();
@@ -490,6 +517,7 @@ void MvvmXmlLoader::ConnectBindings() {
     }
     
     utils::Logger::InfoF("[MVVM] Connecting %zu pending bindings", m_pendingBindings.size());
+    AllocationContext::Scope allocationScope(m_allocationContext.get());
     
     for (auto& pending : m_pendingBindings) {
         auto control = pending.control.lock();
@@ -1042,7 +1070,7 @@ void MvvmXmlLoader::BindListBox(std::shared_ptr<luaui::controls::ListBox> listBo
         return;
     }
 
-    auto luaDataContext = std::dynamic_pointer_cast<lua::LuaPropertyNotifier>(dataContext);
+    auto luaDataContext = AsLuaViewModel(dataContext);
     if (!luaDataContext) {
         std::any value = dataContext->GetPropertyValue(expression.path);
         if (value.type() == typeid(std::vector<std::wstring>)) {
@@ -1054,6 +1082,7 @@ void MvvmXmlLoader::BindListBox(std::shared_ptr<luaui::controls::ListBox> listBo
         return;
     }
 
+#ifndef LUAUI_MVVM_NO_LUA
     lua_State* L = luaDataContext->GetLuaState();
     if (!L) {
         utils::Logger::Error("[MVVM] Lua state not available");
@@ -1161,6 +1190,7 @@ void MvvmXmlLoader::BindListBox(std::shared_ptr<luaui::controls::ListBox> listBo
             }
         });
     }
+#endif
 }
 
 // ============================================================================
@@ -1180,12 +1210,13 @@ void MvvmXmlLoader::BindDataGrid(std::shared_ptr<luaui::controls::DataGrid> data
         return;
     }
 
-    auto luaDataContext = std::dynamic_pointer_cast<lua::LuaPropertyNotifier>(dataContext);
+    auto luaDataContext = AsLuaViewModel(dataContext);
     if (!luaDataContext) {
         utils::Logger::Warning("[MVVM] DataGrid.ItemsSource currently requires a Lua ViewModel");
         return;
     }
 
+#ifndef LUAUI_MVVM_NO_LUA
     lua_State* L = luaDataContext->GetLuaState();
     if (!L) {
         utils::Logger::Error("[MVVM] Lua state not available");
@@ -1234,9 +1265,9 @@ void MvvmXmlLoader::BindDataGrid(std::shared_ptr<luaui::controls::DataGrid> data
     for (size_t i = 0; i < count; ++i) {
         lua_rawgeti(L, collectionIndex, static_cast<int>(i) + 1);
 
-        auto row = std::make_shared<luaui::controls::DataGridRow>();
+        auto row = MakeControl<luaui::controls::DataGridRow>();
         for (const auto& spec : columnSpecs) {
-            auto cell = std::make_shared<luaui::controls::DataGridCell>();
+            auto cell = MakeControl<luaui::controls::DataGridCell>();
             cell->SetText(GetLuaCellText(L, -1, spec));
             row->AddCell(cell);
         }
@@ -1264,6 +1295,7 @@ void MvvmXmlLoader::BindDataGrid(std::shared_ptr<luaui::controls::DataGrid> data
             }
         });
     }
+#endif
 }
 
 void MvvmXmlLoader::BindListBoxSelectedItem(
@@ -1280,7 +1312,7 @@ void MvvmXmlLoader::BindListBoxSelectedItem(
         return;
     }
     
-    auto luaDataContext = std::dynamic_pointer_cast<lua::LuaPropertyNotifier>(dataContext);
+    auto luaDataContext = AsLuaViewModel(dataContext);
     if (!luaDataContext) {
         utils::Logger::Warning("[MVVM] SelectedItem binding only supported with Lua ViewModel");
         return;
@@ -1339,7 +1371,7 @@ void MvvmXmlLoader::BindComboBox(std::shared_ptr<luaui::controls::ComboBox> comb
         return;
     }
     
-    auto luaDataContext = std::dynamic_pointer_cast<lua::LuaPropertyNotifier>(dataContext);
+    auto luaDataContext = AsLuaViewModel(dataContext);
     
     if (propertyName == "ItemsSource") {
         //utils::Logger::InfoF("[MVVM] Binding ComboBox.ItemsSource to %s", expression.path.c_str());
@@ -1356,6 +1388,7 @@ void MvvmXmlLoader::BindComboBox(std::shared_ptr<luaui::controls::ComboBox> comb
             return;
         }
         
+#ifndef LUAUI_MVVM_NO_LUA
         // Lua 上下文
         lua_State* L = luaDataContext->GetLuaState();
         if (!L) return;
@@ -1410,6 +1443,7 @@ void MvvmXmlLoader::BindComboBox(std::shared_ptr<luaui::controls::ComboBox> comb
                 }
             });
         }
+#endif
     }
     else if (propertyName == "SelectedItem" || propertyName == "SelectedIndex") {
         utils::Logger::InfoF("[MVVM] Binding ComboBox.SelectedItem to %s", expression.path.c_str());
@@ -1587,27 +1621,29 @@ void MvvmXmlLoader::BindButtonCommand(std::shared_ptr<luaui::controls::Button> b
     }
     
     // 尝试转换为 LuaPropertyNotifier
-    auto luaNotifier = std::dynamic_pointer_cast<lua::LuaPropertyNotifier>(dataContext);
-    if (luaNotifier) {
-        // Lua ViewModel：检查函数是否存在
-        if (!luaNotifier->HasFunction(commandName)) {
-            utils::Logger::Warning("[MVVM] Command '" + commandName + "' not found in Lua ViewModel");
-            return;
-        }
-        
-        // 绑定点击事件到 Lua 函数
-        button->Click.Add([luaNotifier, commandName](luaui::Control*) {
-            utils::Logger::InfoF("[MVVM] Executing Lua command: %s", commandName.c_str());
-            bool result = luaNotifier->CallFunction(commandName);
-            if (!result) {
-                utils::Logger::Warning("[MVVM] Lua command '" + commandName + "' execution failed");
-            }
-        });
-    } else {
+    auto luaNotifier = AsLuaViewModel(dataContext);
+    if (!luaNotifier) {
         // C++ ViewModel：暂不支持，记录警告
         utils::Logger::Warning("[MVVM] Button Command binding only supported with Lua ViewModel");
         return;
     }
+
+#ifndef LUAUI_MVVM_NO_LUA
+    // Lua ViewModel：检查函数是否存在
+    if (!luaNotifier->HasFunction(commandName)) {
+        utils::Logger::Warning("[MVVM] Command '" + commandName + "' not found in Lua ViewModel");
+        return;
+    }
+    
+    // 绑定点击事件到 Lua 函数
+    button->Click.Add([luaNotifier, commandName](luaui::Control*) {
+        utils::Logger::InfoF("[MVVM] Executing Lua command: %s", commandName.c_str());
+        bool result = luaNotifier->CallFunction(commandName);
+        if (!result) {
+            utils::Logger::Warning("[MVVM] Lua command '" + commandName + "' execution failed");
+        }
+    });
+#endif
     
     //utils::Logger::InfoF("[MVVM] Button command '%s' bound successfully", commandName.c_str());
 }
@@ -1627,25 +1663,27 @@ void MvvmXmlLoader::BindMenuItemCommand(std::shared_ptr<luaui::controls::MenuIte
         return;
     }
 
-    auto luaNotifier = std::dynamic_pointer_cast<lua::LuaPropertyNotifier>(dataContext);
-    if (luaNotifier) {
-        if (!luaNotifier->HasFunction(commandName)) {
-            utils::Logger::Warning("[MVVM] Command '" + commandName + "' not found in Lua ViewModel");
-            return;
-        }
-
-        menuItem->Click.Add([luaNotifier, commandName](luaui::controls::MenuItem*) {
-            utils::Logger::InfoF("[MVVM] Executing Lua command (MenuItem): %s", commandName.c_str());
-            bool result = luaNotifier->CallFunction(commandName);
-            if (!result) {
-                utils::Logger::Warning("[MVVM] Lua command '" + commandName + "' execution failed");
-            }
-        });
-    } else {
+    auto luaNotifier = AsLuaViewModel(dataContext);
+    if (!luaNotifier) {
         utils::Logger::Warning("[MVVM] MenuItem Command binding only supported with Lua ViewModel");
         return;
     }
 
+#ifndef LUAUI_MVVM_NO_LUA
+    if (!luaNotifier->HasFunction(commandName)) {
+        utils::Logger::Warning("[MVVM] Command '" + commandName + "' not found in Lua ViewModel");
+        return;
+    }
+
+    menuItem->Click.Add([luaNotifier, commandName](luaui::controls::MenuItem*) {
+        utils::Logger::InfoF("[MVVM] Executing Lua command (MenuItem): %s", commandName.c_str());
+        bool result = luaNotifier->CallFunction(commandName);
+        if (!result) {
+            utils::Logger::Warning("[MVVM] Lua command '" + commandName + "' execution failed");
+        }
+    });
+#endif
+
     //utils::Logger::InfoF("[MVVM] MenuItem command '%s' bound successfully", commandName.c_str());
 }
 
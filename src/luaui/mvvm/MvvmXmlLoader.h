@@ -56,6 +56,9 @@ public:
     void RegisterTextChangedHandler(const std::string& methodName, 
                                     std::function<void(const std::wstring&)> handler) override;
     
+    // 同时用于基础加载器创建的控件和绑定生成的控件（如 DataGrid 行）
+    void SetAllocationContext(std::shared_ptr<AllocationContext> context) override;
+    
     // 获取延迟绑定（实现 IXmlLoader 接口）
     std::vector<xml::DeferredBinding> GetDeferredBindings() const override { return {}; }
     
@@ -80,6 +83,7 @@ private:
     std::vector<PendingBinding> m_pendingBindings;
     std::vector<PendingBindingInfo> m_pendingBindingInfos;
     std::weak_ptr<luaui::Control> m_rootControl;  // 根控件，用于查找命名控件
+    std::shared_ptr<AllocationContext> m_allocationContext;
     std::vector<std::shared_ptr<luaui::lua::ObservableCollectionBinding>> m_collectionBindings;
     
     void ApplyBindings();
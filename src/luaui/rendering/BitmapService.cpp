@@ -0,0 +1,414 @@
+#include "BitmapService.h"
+#include "IRenderContext.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace luaui {
+namespace rendering {
+
+// ============================================================================
+// BitmapEntry
+// ============================================================================
+
+IBitmapPtr BitmapEntry::GetBitmap(IRenderContext* context) {
+    if (!context || !IsReady() || !m_image) return nullptr;
+    if (m_upload && m_uploadContext == context) return m_upload;
+
+    auto bitmap = context->CreateBitmap(m_image->width, m_image->height, PixelFormat::BGRA8);
+    if (!bitmap || !bitmap->CopyFromMemory(m_image->pixels.data(), m_image->width * 4)) {
+        return nullptr;
+    }
+    m_uploadContext = context;
+    m_upload = bitmap;
+    return bitmap;
+}
+
+// ============================================================================
+// BitmapService
+// ============================================================================
+
+BitmapService::BitmapService(int workerCount) {
+    if (workerCount <= 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        workerCount = static_cast<int>((std::max)(1u, (std::min)(4u, hw / 2)));
+    }
+    m_workerCount = workerCount;
+}
+
+BitmapService::~BitmapService() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_queue.clear();
+    }
+    m_workAvailable.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+BitmapService& BitmapService::Instance() {
+    static BitmapService s_instance;
+    return s_instance;
+}
+
+int BitmapService::GetDecodeSize(float displayWidth, float displayHeight) {
+    float longest = (std::max)(displayWidth, displayHeight);
+    if (longest <= 0) return 0;
+
+    // 按 2 的幂分档，相近尺寸的控件共享同一份解码结果
+    int size = kMinDecodeSize;
+    while (size < longest && size < (1 << 20)) {
+        size <<= 1;
+    }
+    return size;
+}
+
+BitmapHandle BitmapService::Request(const std::wstring& path, float displayWidth, float displayHeight,
+                                    std::function<void()> onReady) {
+    if (path.empty()) return nullptr;
+
+    const int decodeSize = GetDecodeSize(displayWidth, displayHeight);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    ++m_stats.requests;
+
+    auto key = std::make_pair(path, decodeSize);
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        ++m_stats.sharedRequests;
+        auto& entry = it->second;
+        entry->m_lastUsed = ++m_tick;
+        if (onReady && entry->GetState() == BitmapEntry::State::Pending) {
+            entry->m_callbacks.push_back(std::move(onReady));
+        }
+        return entry;
+    }
+
+    BitmapHandle entry(new BitmapEntry(path, decodeSize));
+    entry->m_lastUsed = ++m_tick;
+    if (onReady) {
+        entry->m_callbacks.push_back(std::move(onReady));
+    }
+    m_entries.emplace(std::move(key), entry);
+    m_queue.push_back(entry);
+    TrimLocked(m_byteBudget);
+    EnsureWorkers();
+    lock.unlock();
+
+    m_workAvailable.notify_one();
+    return entry;
+}
+
+void BitmapService::EnsureWorkers() {
+    // 首次请求时才创建线程
+    while (static_cast<int>(m_workers.size()) < m_workerCount) {
+        m_workers.emplace_back(&BitmapService::WorkerLoop, this);
+    }
+}
+
+void BitmapService::WorkerLoop() {
+    while (true) {
+        BitmapHandle entry;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workAvailable.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+            if (m_stopping) return;
+            entry = std::move(m_queue.back());
+            m_queue.pop_back();
+            ++m_busy;
+        }
+
+        Decode(entry);
+        entry.reset();   // 空闲前释放引用，使 WaitIdle 之后的引用计数准确
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_busy;
+        }
+        m_idle.notify_all();
+    }
+}
+
+void BitmapService::Decode(const BitmapHandle& entry) {
+    Decoder decoder;
+    FileReader reader;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // 只剩服务表和本任务持有：请求者已经放弃（如滚出可见区域）
+        if (entry.use_count() <= 2) {
+            auto it = m_entries.find(std::make_pair(entry->m_path, entry->m_decodeSize));
+            if (it != m_entries.end() && it->second == entry) {
+                m_entries.erase(it);
+            }
+            entry->m_callbacks.clear();
+            entry->m_state.store(BitmapEntry::State::Failed, std::memory_order_release);
+            ++m_stats.cancelled;
+            return;
+        }
+        decoder = m_decoder;
+        reader = m_reader;
+    }
+
+    std::vector<uint8_t> data;
+    bool read = reader ? reader(entry->m_path, data) : ReadFile(entry->m_path, data);
+    if (!read || data.empty() || !decoder) {
+        Complete(entry, nullptr);
+        return;
+    }
+
+    // 内容相同的文件共享像素
+    const auto contentKey = std::make_pair(HashContent(data.data(), data.size()), entry->m_decodeSize);
+    std::shared_ptr<const DecodedImage> shared;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_content.find(contentKey);
+        if (it != m_content.end() && (shared = it->second.lock())) {
+            ++m_stats.contentShares;
+        }
+    }
+    if (shared) {
+        Complete(entry, std::move(shared));
+        return;
+    }
+
+    DecodedImage image;
+    if (!decoder(data.data(), data.size(), entry->m_decodeSize, image) || image.pixels.empty()) {
+        Complete(entry, nullptr);
+        return;
+    }
+    data.clear();
+    data.shrink_to_fit();
+
+    // 解码器可能忽略了缩小提示
+    Downscale(image, entry->m_decodeSize);
+    auto tracked = Track(std::move(image));
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.decodes;
+        m_content[contentKey] = tracked;
+    }
+    Complete(entry, std::move(tracked));
+}
+
+void BitmapService::Complete(const BitmapHandle& entry, std::shared_ptr<const DecodedImage> image) {
+    std::function<void()> wake;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (image) {
+            entry->m_image = std::move(image);
+            entry->m_state.store(BitmapEntry::State::Ready, std::memory_order_release);
+        } else {
+            ++m_stats.failures;
+            entry->m_state.store(BitmapEntry::State::Failed, std::memory_order_release);
+            // 失败的条目不保留，之后的请求会重试
+            auto it = m_entries.find(std::make_pair(entry->m_path, entry->m_decodeSize));
+            if (it != m_entries.end() && it->second == entry) {
+                m_entries.erase(it);
+            }
+        }
+
+        if (!entry->m_callbacks.empty()) {
+            for (auto& callback : entry->m_callbacks) {
+                m_completed.push_back(std::move(callback));
+            }
+            entry->m_callbacks.clear();
+            wake = m_wake;
+        }
+    }
+    if (wake) {
+        wake();
+    }
+}
+
+std::shared_ptr<const DecodedImage> BitmapService::Track(DecodedImage&& image) {
+    // 计数器与服务分离：像素可能比服务活得更久
+    auto counter = m_decodedBytes;
+    size_t bytes = image.GetBytes();
+    counter->fetch_add(bytes);
+    return std::shared_ptr<const DecodedImage>(new DecodedImage(std::move(image)),
+        [counter, bytes](const DecodedImage* p) {
+            counter->fetch_sub(bytes);
+            delete p;
+        });
+}
+
+size_t BitmapService::DispatchCompletions() {
+    std::vector<std::function<void()>> completed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        completed.swap(m_completed);
+        // 淘汰在 UI 线程进行：条目可能持有只能在 UI 线程释放的已上传位图
+        TrimLocked(m_byteBudget);
+    }
+    for (auto& callback : completed) {
+        callback();
+    }
+    return completed.size();
+}
+
+void BitmapService::WaitIdle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]() { return m_queue.empty() && m_busy == 0; });
+}
+
+// ============================================================================
+// 配置
+// ============================================================================
+
+void BitmapService::SetDecoder(Decoder decoder) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_decoder = std::move(decoder);
+}
+
+bool BitmapService::HasDecoder() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<bool>(m_decoder);
+}
+
+void BitmapService::SetFileReader(FileReader reader) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_reader = std::move(reader);
+}
+
+void BitmapService::SetWakeHandler(std::function<void()> handler, const void* owner) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_wake = std::move(handler);
+    m_wakeOwner = owner;
+}
+
+void BitmapService::ClearWakeHandler(const void* owner) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_wakeOwner == owner) {
+        m_wake = nullptr;
+        m_wakeOwner = nullptr;
+    }
+}
+
+void BitmapService::SetByteBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_byteBudget = bytes;
+    TrimLocked(m_byteBudget);
+}
+
+size_t BitmapService::GetByteBudget() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_byteBudget;
+}
+
+void BitmapService::RemoveContext(IRenderContext* context) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& pair : m_entries) {
+        auto& entry = pair.second;
+        if (entry->m_uploadContext == context) {
+            entry->m_uploadContext = nullptr;
+            entry->m_upload.reset();
+        }
+    }
+}
+
+void BitmapService::Trim() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    TrimLocked(0);
+}
+
+void BitmapService::TrimLocked(size_t budget) {
+    if (m_decodedBytes->load() <= budget) return;
+
+    // 无人持有的已完成条目，最久未请求的先释放
+    std::vector<std::pair<uint64_t, decltype(m_entries)::iterator>> idle;
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (it->second.use_count() == 1 && it->second->GetState() != BitmapEntry::State::Pending) {
+            idle.emplace_back(it->second->m_lastUsed, it);
+        }
+    }
+    std::sort(idle.begin(), idle.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (auto& victim : idle) {
+        if (m_decodedBytes->load() <= budget) break;
+        m_entries.erase(victim.second);
+        ++m_stats.evictions;
+    }
+
+    for (auto it = m_content.begin(); it != m_content.end();) {
+        it = it->second.expired() ? m_content.erase(it) : std::next(it);
+    }
+}
+
+BitmapService::Stats BitmapService::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats stats = m_stats;
+    stats.decodedBytes = m_decodedBytes->load();
+    stats.entries = m_entries.size();
+    return stats;
+}
+
+// ============================================================================
+// 辅助
+// ============================================================================
+
+uint64_t BitmapService::HashContent(const uint8_t* data, size_t size) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash ^ size;
+}
+
+void BitmapService::Downscale(DecodedImage& image, int minShortSide) {
+    if (minShortSide <= 0 || image.width <= 0 || image.height <= 0) return;
+
+    int shortSide = (std::min)(image.width, image.height);
+    if (shortSide <= minShortSide) return;
+
+    // 盒式滤波：较短边缩到 minShortSide，长边按比例
+    const double scale = static_cast<double>(minShortSide) / shortSide;
+    const int dstW = (std::max)(1, static_cast<int>(image.width * scale + 0.5));
+    const int dstH = (std::max)(1, static_cast<int>(image.height * scale + 0.5));
+
+    std::vector<uint32_t> dst(static_cast<size_t>(dstW) * dstH);
+    for (int y = 0; y < dstH; ++y) {
+        const int y0 = static_cast<int>(static_cast<int64_t>(y) * image.height / dstH);
+        const int y1 = (std::max)(y0 + 1, static_cast<int>(static_cast<int64_t>(y + 1) * image.height / dstH));
+        for (int x = 0; x < dstW; ++x) {
+            const int x0 = static_cast<int>(static_cast<int64_t>(x) * image.width / dstW);
+            const int x1 = (std::max)(x0 + 1, static_cast<int>(static_cast<int64_t>(x + 1) * image.width / dstW));
+            uint32_t sum[4] = {};
+            for (int sy = y0; sy < y1; ++sy) {
+                const uint32_t* row = image.pixels.data() + static_cast<size_t>(sy) * image.width;
+                for (int sx = x0; sx < x1; ++sx) {
+                    uint32_t p = row[sx];
+                    sum[0] += p & 0xFF;
+                    sum[1] += (p >> 8) & 0xFF;
+                    sum[2] += (p >> 16) & 0xFF;
+                    sum[3] += p >> 24;
+                }
+            }
+            const uint32_t n = static_cast<uint32_t>((y1 - y0) * (x1 - x0));
+            dst[static_cast<size_t>(y) * dstW + x] =
+                ((sum[3] + n / 2) / n) << 24 | ((sum[2] + n / 2) / n) << 16 |
+                ((sum[1] + n / 2) / n) << 8 | ((sum[0] + n / 2) / n);
+        }
+    }
+    image.pixels.swap(dst);
+    image.width = dstW;
+    image.height = dstH;
+}
+
+bool BitmapService::ReadFile(const std::wstring& path, std::vector<uint8_t>& out) {
+    std::ifstream file;
+#ifdef _WIN32
+    file.open(path, std::ios::binary);
+#else
+    // 非 Windows 构建仅用于无界面测试，路径按 ASCII 处理
+    file.open(std::string(path.begin(), path.end()), std::ios::binary);
+#endif
+    if (!file.is_open()) return false;
+    out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+} // namespace rendering
+} // namespace luaui
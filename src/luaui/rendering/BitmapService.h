@@ -0,0 +1,215 @@
+#pragma once
+
+#include "IBitmap.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace luaui {
+namespace rendering {
+
+class IRenderContext;
+class BitmapService;
+
+/**
+ * @brief 解码后的像素（预乘 BGRA，与 PixelFormat::BGRA8 一致）
+ */
+struct DecodedImage {
+    int width = 0;
+    int height = 0;
+    int sourceWidth = 0;    // 原图尺寸（缩小解码前）
+    int sourceHeight = 0;
+    std::vector<uint32_t> pixels;
+
+    size_t GetBytes() const { return pixels.size() * sizeof(uint32_t); }
+};
+
+/**
+ * @brief 一次位图请求的共享结果
+ *
+ * 由 BitmapService 创建，相同路径和解码尺寸的请求共享同一个实例。
+ * 状态和尺寸可在任意线程读取；GetBitmap 只能在 UI 线程调用。
+ */
+class BitmapEntry {
+public:
+    enum class State {
+        Pending,
+        Ready,
+        Failed
+    };
+
+    State GetState() const { return m_state.load(std::memory_order_acquire); }
+    bool IsReady() const { return GetState() == State::Ready; }
+    bool IsFailed() const { return GetState() == State::Failed; }
+
+    const std::wstring& GetPath() const { return m_path; }
+    int GetDecodeSize() const { return m_decodeSize; }
+
+    // 以下仅在 Ready 状态下有效
+    int GetWidth() const { return m_image ? m_image->width : 0; }
+    int GetHeight() const { return m_image ? m_image->height : 0; }
+    int GetSourceWidth() const { return m_image ? m_image->sourceWidth : 0; }
+    int GetSourceHeight() const { return m_image ? m_image->sourceHeight : 0; }
+
+    /**
+     * @brief 获取上传到指定上下文的位图（首次调用时上传，之后共享）
+     * @return 未就绪或上传失败时返回 nullptr
+     */
+    IBitmapPtr GetBitmap(IRenderContext* context);
+
+private:
+    friend class BitmapService;
+
+    BitmapEntry(std::wstring path, int decodeSize) : m_path(std::move(path)), m_decodeSize(decodeSize) {}
+
+    std::wstring m_path;
+    int m_decodeSize = 0;
+    std::atomic<State> m_state{State::Pending};
+    std::shared_ptr<const DecodedImage> m_image;     // Ready 之后只读
+    std::vector<std::function<void()>> m_callbacks;  // 受服务互斥锁保护
+    uint64_t m_lastUsed = 0;                         // 受服务互斥锁保护
+
+    // UI 线程
+    IRenderContext* m_uploadContext = nullptr;
+    IBitmapPtr m_upload;
+};
+
+using BitmapHandle = std::shared_ptr<BitmapEntry>;
+
+/**
+ * @brief 异步位图解码服务
+ *
+ * - 在工作线程读取和解码，UI 线程只做上传，不会因为大量缩略图卡顿。
+ * - 相同路径、相同解码尺寸的请求共享一个条目；不同路径但内容相同（按内容哈希）
+ *   的文件共享像素。条目通过 BitmapHandle 引用计数，无人持有的条目在超出内存预算时释放。
+ * - 解码时按目标显示尺寸缩小：目标尺寸按 2 的幂取整分档，图像较短边缩到不小于该档位。
+ * - 尚未开始解码的请求如果已无人持有，直接取消。
+ *
+ * 完成回调在 UI 线程的 DispatchCompletions 中执行；工作线程通过唤醒函数通知 UI 线程
+ * （窗口将其设置为向自身投递消息）。
+ */
+class BitmapService {
+public:
+    static constexpr size_t kDefaultByteBudget = 128 * 1024 * 1024;
+    static constexpr int kMinDecodeSize = 32;
+
+    /**
+     * @brief 解码函数
+     * @param minShortSide 大于 0 时允许解码器直接缩小，使较短边不小于该值（可以忽略）
+     * @return 成功时填充 out，包括 sourceWidth/sourceHeight
+     */
+    using Decoder = std::function<bool(const uint8_t* data, size_t size, int minShortSide, DecodedImage& out)>;
+    using FileReader = std::function<bool(const std::wstring& path, std::vector<uint8_t>& out)>;
+
+    struct Stats {
+        uint64_t requests = 0;
+        uint64_t sharedRequests = 0;   // 命中已有条目
+        uint64_t contentShares = 0;    // 不同路径按内容哈希共享像素
+        uint64_t decodes = 0;
+        uint64_t failures = 0;
+        uint64_t cancelled = 0;
+        uint64_t evictions = 0;
+        size_t decodedBytes = 0;
+        size_t entries = 0;
+    };
+
+    explicit BitmapService(int workerCount = 0);
+    ~BitmapService();
+
+    BitmapService(const BitmapService&) = delete;
+    BitmapService& operator=(const BitmapService&) = delete;
+
+    static BitmapService& Instance();
+
+    /**
+     * @brief 请求位图
+     * @param path 文件路径
+     * @param displayWidth/displayHeight 目标显示尺寸（像素），0 表示按原尺寸解码
+     * @param onReady 解码完成（成功或失败）后在 UI 线程回调；请求时已完成则不回调
+     */
+    BitmapHandle Request(const std::wstring& path, float displayWidth = 0, float displayHeight = 0,
+                         std::function<void()> onReady = nullptr);
+
+    /**
+     * @brief 目标显示尺寸对应的解码档位（0 表示原尺寸）
+     */
+    static int GetDecodeSize(float displayWidth, float displayHeight);
+
+    /**
+     * @brief 在 UI 线程执行已完成请求的回调
+     * @return 执行的回调数
+     */
+    size_t DispatchCompletions();
+
+    /**
+     * @brief 等待所有已提交的解码完成（测试和关闭时使用）
+     */
+    void WaitIdle();
+
+    // ========== 配置 ==========
+    void SetDecoder(Decoder decoder);
+    bool HasDecoder() const;
+    void SetFileReader(FileReader reader);
+
+    /** @brief 有请求完成时在工作线程调用（owner 用于之后清除） */
+    void SetWakeHandler(std::function<void()> handler, const void* owner);
+    void ClearWakeHandler(const void* owner);
+
+    void SetByteBudget(size_t bytes);
+    size_t GetByteBudget() const;
+
+    /** @brief 释放上传到指定上下文的位图（上下文关闭前调用） */
+    void RemoveContext(IRenderContext* context);
+
+    /** @brief 释放所有无人持有的条目 */
+    void Trim();
+
+    Stats GetStats() const;
+
+private:
+    void EnsureWorkers();
+    void WorkerLoop();
+    void Decode(const BitmapHandle& entry);
+    void Complete(const BitmapHandle& entry, std::shared_ptr<const DecodedImage> image);
+    void TrimLocked(size_t budget);
+    std::shared_ptr<const DecodedImage> Track(DecodedImage&& image);
+
+    static uint64_t HashContent(const uint8_t* data, size_t size);
+    static void Downscale(DecodedImage& image, int minShortSide);
+    static bool ReadFile(const std::wstring& path, std::vector<uint8_t>& out);
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_idle;
+    std::deque<BitmapHandle> m_queue;   // 后进先出：最近请求的（通常是可见的）先解码
+    std::vector<std::thread> m_workers;
+    int m_workerCount = 0;
+    int m_busy = 0;
+    bool m_stopping = false;
+
+    std::map<std::pair<std::wstring, int>, BitmapHandle> m_entries;
+    std::map<std::pair<uint64_t, int>, std::weak_ptr<const DecodedImage>> m_content;
+    std::vector<std::function<void()>> m_completed;
+    uint64_t m_tick = 0;
+
+    Decoder m_decoder;
+    FileReader m_reader;
+    std::function<void()> m_wake;
+    const void* m_wakeOwner = nullptr;
+
+    size_t m_byteBudget = kDefaultByteBudget;
+    std::shared_ptr<std::atomic<size_t>> m_decodedBytes = std::make_shared<std::atomic<size_t>>(0);
+    Stats m_stats;
+};
+
+} // namespace rendering
+} // namespace luaui
@@ -1,83 +1,365 @@
 #include "DirtyRegion.h"
+#include "IRenderEngine.h"
 #include <cmath>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LUAUI_DIRTYREGION_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace luaui {
 namespace rendering {
 
+namespace {
+
+inline int CountTrailingZeros(uint64_t v) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, v);
+    return static_cast<int>(index);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    if (_BitScanForward(&index, static_cast<unsigned long>(v))) return static_cast<int>(index);
+    _BitScanForward(&index, static_cast<unsigned long>(v >> 32));
+    return static_cast<int>(index) + 32;
+#else
+    return __builtin_ctzll(v);
+#endif
+}
+
+inline int PopCount(uint64_t v) {
+#if defined(_MSC_VER)
+    v = v - ((v >> 1) & 0x5555555555555555ull);
+    v = (v & 0x3333333333333333ull) + ((v >> 2) & 0x3333333333333333ull);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return static_cast<int>((v * 0x0101010101010101ull) >> 56);
+#else
+    return __builtin_popcountll(v);
+#endif
+}
+
+// Bits [from, to) of word `word` set, for a tile column range
+inline uint64_t WordMask(int word, int from, int to) {
+    int lo = (std::max)(from - word * 64, 0);
+    int hi = (std::min)(to - word * 64, 64);
+    if (lo >= hi) return 0;
+    uint64_t upper = hi == 64 ? ~0ull : ((1ull << hi) - 1);
+    return upper & ~((1ull << lo) - 1);
+}
+
+// dst |= src, n words
+void OrWords(uint64_t* dst, const uint64_t* src, size_t n) {
+    size_t i = 0;
+#ifdef LUAUI_DIRTYREGION_SSE2
+    for (; i + 2 <= n; i += 2) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_or_si128(a, b));
+    }
+#endif
+    for (; i < n; ++i) dst[i] |= src[i];
+}
+
+// dst &= src, n words
+void AndWords(uint64_t* dst, const uint64_t* src, size_t n) {
+    size_t i = 0;
+#ifdef LUAUI_DIRTYREGION_SSE2
+    for (; i + 2 <= n; i += 2) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_and_si128(a, b));
+    }
+#endif
+    for (; i < n; ++i) dst[i] &= src[i];
+}
+
+bool AnyBits(const uint64_t* words, size_t n) {
+    size_t i = 0;
+#ifdef LUAUI_DIRTYREGION_SSE2
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 2 <= n; i += 2) {
+        acc = _mm_or_si128(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i)));
+    }
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128())) != 0xFFFF) return true;
+#endif
+    for (; i < n; ++i) {
+        if (words[i]) return true;
+    }
+    return false;
+}
+
+Rect IntersectRects(const Rect& a, const Rect& b) {
+    float left = (std::max)(a.x, b.x);
+    float top = (std::max)(a.y, b.y);
+    float right = (std::min)(a.x + a.width, b.x + b.width);
+    float bottom = (std::min)(a.y + a.height, b.y + b.height);
+    if (right <= left || bottom <= top) return Rect();
+    return Rect(left, top, right - left, bottom - top);
+}
+
+} // anonymous namespace
+
+RegionCostModel RegionCostModel::ForAPI(RenderAPI api) {
+    RegionCostModel model;
+    switch (api) {
+        case RenderAPI::Direct2D:
+            // 填充在 GPU 上很便宜，每次遍历控件树和提交命令是主要开销
+            model.passOverhead = 256.0f * 256.0f;
+            model.pixelCost = 1.0f;
+            break;
+        case RenderAPI::Direct2D_WARP:
+            model.passOverhead = 192.0f * 192.0f;
+            model.pixelCost = 1.0f;
+            break;
+        case RenderAPI::Software:
+            // 逐像素混合为主，多次小面积绘制更划算
+            model.passOverhead = 128.0f * 128.0f;
+            model.pixelCost = 1.0f;
+            break;
+    }
+    return model;
+}
+
 DirtyRegion::DirtyRegion() = default;
 
+bool DirtyRegion::ToTileRange(const Rect& rect, int& x0, int& y0, int& x1, int& y1) {
+    float left = (std::max)(rect.x, 0.0f);
+    float top = (std::max)(rect.y, 0.0f);
+    float right = rect.x + rect.width;
+    float bottom = rect.y + rect.height;
+    if (right <= left || bottom <= top) return false;
+
+    const float maxCoord = static_cast<float>(kMaxTiles * kTileSize);
+    x0 = static_cast<int>((std::min)(left, maxCoord)) / kTileSize;
+    y0 = static_cast<int>((std::min)(top, maxCoord)) / kTileSize;
+    x1 = static_cast<int>(std::ceil((std::min)(right, maxCoord) / kTileSize));
+    y1 = static_cast<int>(std::ceil((std::min)(bottom, maxCoord) / kTileSize));
+    return x1 > x0 && y1 > y0;
+}
+
+void DirtyRegion::EnsureTiles(int cols, int rows) {
+    int words = (cols + 63) / 64;
+    if (words > m_wordsPerRow) {
+        // 行宽变化：重新排布
+        std::vector<uint64_t> tiles(static_cast<size_t>(words) * (std::max)(rows, m_rows), 0);
+        for (int r = 0; r < m_rows; ++r) {
+            std::copy(m_tiles.begin() + static_cast<size_t>(r) * m_wordsPerRow,
+                      m_tiles.begin() + static_cast<size_t>(r + 1) * m_wordsPerRow,
+                      tiles.begin() + static_cast<size_t>(r) * words);
+        }
+        m_tiles.swap(tiles);
+        m_wordsPerRow = words;
+        m_rows = (std::max)(rows, m_rows);
+    } else if (rows > m_rows) {
+        m_tiles.resize(static_cast<size_t>(m_wordsPerRow) * rows, 0);
+        m_rows = rows;
+    }
+}
+
 void DirtyRegion::AddRect(const Rect& rect) {
     // 忽略空矩形
     if (rect.width <= 0 || rect.height <= 0) {
         return;
     }
-    
-    // 添加新矩形
-    m_rects.push_back(rect);
-    
-    // 如果矩形数量过多，进行合并
-    if (m_rects.size() > 10) {
-        MergeRects();
+
+    int x0, y0, x1, y1;
+    if (!ToTileRange(rect, x0, y0, x1, y1)) return;
+
+    EnsureTiles(x1, y1);
+    int firstWord = x0 / 64;
+    int lastWord = (x1 - 1) / 64;
+    for (int r = y0; r < y1; ++r) {
+        uint64_t* row = &m_tiles[static_cast<size_t>(r) * m_wordsPerRow];
+        for (int w = firstWord; w <= lastWord; ++w) {
+            row[w] |= WordMask(w, x0, x1);
+        }
     }
+
+    Rect clipped = IntersectRects(rect, Rect(0, 0, rect.x + rect.width, rect.y + rect.height));
+    m_bounds = m_empty ? clipped : MergeTwoRects(m_bounds, clipped);
+    m_empty = false;
+    m_rectsValid = false;
 }
 
 void DirtyRegion::Clear() {
+    std::fill(m_tiles.begin(), m_tiles.end(), 0);
+    m_bounds = Rect();
+    m_empty = true;
     m_rects.clear();
+    m_rectsValid = true;
 }
 
 void DirtyRegion::InvalidateAll(float width, float height) {
-    m_rects.clear();
-    m_rects.push_back(Rect(0, 0, width, height));
+    Clear();
+    AddRect(Rect(0, 0, width, height));
 }
 
 bool DirtyRegion::Intersects(const Rect& rect) const {
-    for (const auto& dirty : m_rects) {
-        if (RectsIntersect(dirty, rect)) {
-            return true;
+    if (m_empty || !RectsIntersect(m_bounds, rect)) return false;
+
+    int x0, y0, x1, y1;
+    if (!ToTileRange(rect, x0, y0, x1, y1)) return false;
+    y1 = (std::min)(y1, m_rows);
+    x1 = (std::min)(x1, m_wordsPerRow * 64);
+
+    int firstWord = x0 / 64;
+    int lastWord = (x1 - 1) / 64;
+    for (int r = y0; r < y1; ++r) {
+        const uint64_t* row = &m_tiles[static_cast<size_t>(r) * m_wordsPerRow];
+        for (int w = firstWord; w <= lastWord; ++w) {
+            if (row[w] & WordMask(w, x0, x1)) return true;
         }
     }
     return false;
 }
 
-void DirtyRegion::MergeRects() {
-    if (m_rects.size() < 2) return;
-    
-    bool merged = true;
-    while (merged && m_rects.size() > 1) {
-        merged = false;
-        
-        for (size_t i = 0; i < m_rects.size() && !merged; ++i) {
-            for (size_t j = i + 1; j < m_rects.size(); ++j) {
-                // 检查是否可以合并（重叠或相邻）
-                const Rect& a = m_rects[i];
-                const Rect& b = m_rects[j];
-                
-                // 计算合并后的矩形
-                float left = std::min(a.x, b.x);
-                float top = std::min(a.y, b.y);
-                float right = std::max(a.x + a.width, b.x + b.width);
-                float bottom = std::max(a.y + a.height, b.y + b.height);
-                
-                float mergedWidth = right - left;
-                float mergedHeight = bottom - top;
-                
-                // 合并条件：如果合并后的面积小于两个矩形面积之和的 1.5 倍，则合并
-                float areaA = a.width * a.height;
-                float areaB = b.width * b.height;
-                float mergedArea = mergedWidth * mergedHeight;
-                
-                if (mergedArea < (areaA + areaB) * 1.5f) {
-                    // 执行合并
-                    m_rects[i] = Rect(left, top, mergedWidth, mergedHeight);
-                    m_rects.erase(m_rects.begin() + j);
-                    merged = true;
-                    break;
+void DirtyRegion::Union(const DirtyRegion& other) {
+    if (other.m_empty) return;
+
+    EnsureTiles(other.m_wordsPerRow * 64, other.m_rows);
+    if (m_wordsPerRow == other.m_wordsPerRow) {
+        OrWords(m_tiles.data(), other.m_tiles.data(), other.m_tiles.size());
+    } else {
+        for (int r = 0; r < other.m_rows; ++r) {
+            OrWords(&m_tiles[static_cast<size_t>(r) * m_wordsPerRow],
+                    &other.m_tiles[static_cast<size_t>(r) * other.m_wordsPerRow],
+                    static_cast<size_t>(other.m_wordsPerRow));
+        }
+    }
+
+    m_bounds = m_empty ? other.m_bounds : MergeTwoRects(m_bounds, other.m_bounds);
+    m_empty = false;
+    m_rectsValid = false;
+}
+
+void DirtyRegion::Intersect(const DirtyRegion& other) {
+    if (m_empty) return;
+    if (other.m_empty) {
+        Clear();
+        return;
+    }
+
+    int rows = (std::min)(m_rows, other.m_rows);
+    int words = (std::min)(m_wordsPerRow, other.m_wordsPerRow);
+    if (m_wordsPerRow == other.m_wordsPerRow) {
+        AndWords(m_tiles.data(), other.m_tiles.data(), static_cast<size_t>(rows) * words);
+    } else {
+        for (int r = 0; r < rows; ++r) {
+            uint64_t* row = &m_tiles[static_cast<size_t>(r) * m_wordsPerRow];
+            AndWords(row, &other.m_tiles[static_cast<size_t>(r) * other.m_wordsPerRow],
+                     static_cast<size_t>(words));
+            std::fill(row + words, row + m_wordsPerRow, 0);
+        }
+    }
+    // 对方没有的行全部清零
+    std::fill(m_tiles.begin() + static_cast<size_t>(rows) * m_wordsPerRow, m_tiles.end(), 0);
+
+    m_bounds = IntersectRects(m_bounds, other.m_bounds);
+    m_empty = m_bounds.width <= 0 || m_bounds.height <= 0 || !AnyBits(m_tiles.data(), m_tiles.size());
+    if (m_empty) {
+        Clear();
+        return;
+    }
+    m_rectsValid = false;
+}
+
+size_t DirtyRegion::GetTileCount() const {
+    size_t count = 0;
+    for (uint64_t word : m_tiles) {
+        count += static_cast<size_t>(PopCount(word));
+    }
+    return count;
+}
+
+const std::vector<Rect>& DirtyRegion::GetRects() const {
+    if (!m_rectsValid) {
+        ExtractRects();
+        m_rectsValid = true;
+    }
+    return m_rects;
+}
+
+void DirtyRegion::ExtractRects() const {
+    m_rects.clear();
+    if (m_empty) return;
+
+    // 逐行找出连续的置位瓦片（run），与上一行列范围相同的 run 向下延伸
+    struct Span { int x0, x1, y0; };
+    std::vector<Span> open, next;
+    std::vector<std::pair<int, int>> runs;
+
+    auto emit = [this](const Span& s, int y1) {
+        Rect tileRect(static_cast<float>(s.x0 * kTileSize), static_cast<float>(s.y0 * kTileSize),
+                      static_cast<float>((s.x1 - s.x0) * kTileSize), static_cast<float>((y1 - s.y0) * kTileSize));
+        Rect clipped = IntersectRects(tileRect, m_bounds);
+        if (clipped.width > 0 && clipped.height > 0) m_rects.push_back(clipped);
+    };
+
+    for (int r = 0; r <= m_rows; ++r) {
+        runs.clear();
+        if (r < m_rows) {
+            const uint64_t* row = &m_tiles[static_cast<size_t>(r) * m_wordsPerRow];
+            int runStart = -1;
+            for (int w = 0; w < m_wordsPerRow; ++w) {
+                uint64_t bits = row[w];
+                int base = w * 64;
+                // 逐段跳过 0 / 1，而不是逐位扫描
+                int pos = 0;
+                while (pos < 64) {
+                    if (runStart < 0) {
+                        uint64_t rest = bits >> pos;
+                        if (!rest) break;
+                        pos += CountTrailingZeros(rest);
+                        runStart = base + pos;
+                    } else {
+                        uint64_t rest = ~bits >> pos;
+                        if (!rest) break;
+                        pos += CountTrailingZeros(rest);
+                        runs.emplace_back(runStart, base + pos);
+                        runStart = -1;
+                    }
                 }
             }
+            if (runStart >= 0) runs.emplace_back(runStart, m_wordsPerRow * 64);
         }
+
+        // open 和 runs 都按 x 有序，双指针匹配
+        next.clear();
+        size_t i = 0;
+        for (const auto& run : runs) {
+            while (i < open.size() && open[i].x0 < run.first) emit(open[i++], r);
+            if (i < open.size() && open[i].x0 == run.first && open[i].x1 == run.second) {
+                next.push_back(open[i++]);
+            } else {
+                next.push_back(Span{ run.first, run.second, r });
+            }
+        }
+        while (i < open.size()) emit(open[i++], r);
+        open.swap(next);
     }
 }
 
+std::vector<Rect> DirtyRegion::GetRenderRects(const RegionCostModel& cost) const {
+    const auto& rects = GetRects();
+    if (rects.size() <= 1) return rects;
+
+    float area = 0;
+    for (const auto& rect : rects) {
+        area += rect.width * rect.height;
+    }
+    float multiPass = cost.passOverhead * rects.size() + cost.pixelCost * area;
+    float singlePass = cost.passOverhead + cost.pixelCost * m_bounds.width * m_bounds.height;
+
+    if (singlePass <= multiPass) {
+        return std::vector<Rect>{ m_bounds };
+    }
+    return rects;
+}
+
 bool DirtyRegion::RectsIntersect(const Rect& a, const Rect& b) {
     return (a.x < b.x + b.width) &&
            (a.x + a.width > b.x) &&
@@ -90,7 +372,7 @@ Rect DirtyRegion::MergeTwoRects(const Rect& a, const Rect& b) {
     float top = std::min(a.y, b.y);
     float right = std::max(a.x + a.width, b.x + b.width);
     float bottom = std::max(a.y + a.height, b.y + b.height);
-    
+
     return Rect(left, top, right - left, bottom - top);
 }
 
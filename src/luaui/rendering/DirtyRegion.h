@@ -1,50 +1,96 @@
 #pragma once
 
 #include "Types.h"
+#include <cstdint>
 #include <vector>
 #include <algorithm>
 
 namespace luaui {
 namespace rendering {
 
+enum class RenderAPI;
+
+/**
+ * @brief 局部重绘开销模型
+ *
+ * 每次裁剪绘制都要遍历控件树并提交绘制命令（固定开销），绘制面积决定填充开销。
+ * 两者都以"像素当量"表示，用于在"N 次裁剪绘制"和"一次包围盒绘制"之间选择。
+ */
+struct RegionCostModel {
+    float passOverhead = 16384.0f;  // 每次裁剪绘制的固定开销（像素当量）
+    float pixelCost = 1.0f;         // 每像素填充开销
+
+    /**
+     * @brief 按渲染后端返回默认开销模型
+     *
+     * GPU 后端填充便宜、每次遍历提交昂贵；软件光栅化则以逐像素混合为主。
+     */
+    static RegionCostModel ForAPI(RenderAPI api);
+};
+
 /**
  * @brief 脏矩形区域管理器
- * 
- * 管理和合并多个脏矩形区域，优化渲染性能
+ *
+ * 以粗粒度瓦片位图（kTileSize × kTileSize 像素）记录脏区域：
+ * 添加矩形只是置位，与已有矩形数量无关，每帧数百个小矩形（行情单元格、
+ * 闪烁指示灯）也不会产生合并开销。需要时再从位图提取矩形，
+ * 并按 RegionCostModel 决定分块重绘还是合并为一次重绘。
+ *
+ * 提取出的矩形按瓦片对齐，并裁剪到所有添加矩形的精确包围盒内。
  */
 class DirtyRegion {
 public:
+    static constexpr int kTileSize = 32;
+    static constexpr int kMaxTiles = 1024;   // 每个方向最多瓦片数（32768 像素）
+
     DirtyRegion();
-    
+
     /**
      * @brief 添加脏矩形区域
      * @param rect 需要重绘的矩形区域
      */
     void AddRect(const Rect& rect);
-    
+
     /**
-     * @brief 获取所有脏矩形区域（已合并优化）
+     * @brief 获取所有脏矩形区域（由瓦片位图提取，相邻瓦片已合并）
      * @return 脏矩形列表
      */
-    const std::vector<Rect>& GetRects() const { return m_rects; }
-    
+    const std::vector<Rect>& GetRects() const;
+
+    /**
+     * @brief 按开销模型获取本帧实际绘制的矩形
+     *
+     * 当 N 次裁剪绘制的总开销高于一次包围盒绘制时，返回单个包围盒。
+     */
+    std::vector<Rect> GetRenderRects(const RegionCostModel& cost) const;
+
     /**
      * @brief 检查是否需要重绘指定区域
      * @param rect 要检查的区域
      * @return 是否需要重绘
      */
     bool Intersects(const Rect& rect) const;
-    
+
+    /**
+     * @brief 合并另一个区域（按瓦片求并）
+     */
+    void Union(const DirtyRegion& other);
+
+    /**
+     * @brief 与另一个区域求交（按瓦片求交）
+     */
+    void Intersect(const DirtyRegion& other);
+
     /**
      * @brief 清空所有脏矩形
      */
     void Clear();
-    
+
     /**
      * @brief 检查是否有脏矩形
      */
-    bool IsEmpty() const { return m_rects.empty(); }
-    
+    bool IsEmpty() const { return m_empty; }
+
     /**
      * @brief 使整个区域变脏（强制全屏重绘）
      * @param width 区域宽度
@@ -52,15 +98,41 @@ public:
      */
     void InvalidateAll(float width, float height);
 
+    /**
+     * @brief 所有脏区域的精确包围盒
+     */
+    const Rect& GetBounds() const { return m_bounds; }
+
+    /**
+     * @brief 脏瓦片数量
+     */
+    size_t GetTileCount() const;
+
 private:
-    std::vector<Rect> m_rects;
-    
-    // 合并重叠的矩形
-    void MergeRects();
-    
+    // 瓦片位图：每行 m_wordsPerRow 个 64 位字，行连续存放
+    std::vector<uint64_t> m_tiles;
+    int m_rows = 0;
+    int m_wordsPerRow = 0;
+
+    Rect m_bounds;
+    bool m_empty = true;
+
+    // 提取结果缓存
+    mutable std::vector<Rect> m_rects;
+    mutable bool m_rectsValid = true;
+
+    // 扩展位图以容纳指定的瓦片范围
+    void EnsureTiles(int cols, int rows);
+
+    // 将像素矩形转换为瓦片范围 [x0, x1) × [y0, y1)，返回是否非空
+    static bool ToTileRange(const Rect& rect, int& x0, int& y0, int& x1, int& y1);
+
+    // 从位图提取矩形
+    void ExtractRects() const;
+
     // 检查两个矩形是否重叠
     static bool RectsIntersect(const Rect& a, const Rect& b);
-    
+
     // 合并两个矩形
     static Rect MergeTwoRects(const Rect& a, const Rect& b);
 };
@@ -0,0 +1,826 @@
+#include "DisplayList.h"
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <tuple>
+#include <type_traits>
+
+namespace luaui {
+namespace rendering {
+
+enum class DisplayList::Op : uint8_t {
+    Clear,
+    PushState,
+    PopState,
+    ResetState,
+    SetTransform,
+    MultiplyTransform,
+    SetOpacity,
+    SetAntialias,
+    PushClipRect,
+    PushClipGeometry,
+    PopClip,
+    ResetClip,
+    PushLayer,
+    PopLayer,
+    DrawLine,
+    DrawRectangle,
+    FillRectangle,
+    DrawRoundedRectangle,
+    FillRoundedRectangle,
+    DrawEllipse,
+    FillEllipse,
+    DrawGeometry,
+    FillGeometry,
+    DrawBitmap,
+    DrawTextAt,
+    DrawTextInRect,
+    FillRectangles,
+    DrawLines,
+};
+
+namespace {
+
+// ==================== 命令负载（均为可平凡复制类型） ====================
+
+struct StrokeArgs {
+    uint32_t brush;
+    float width;
+    uint32_t style;
+};
+
+struct LineCmd { Point p1; Point p2; StrokeArgs stroke; };
+struct RectCmd { Rect rect; StrokeArgs stroke; };
+struct FillRectCmd { Rect rect; uint32_t brush; };
+struct RoundedRectCmd { Rect rect; CornerRadius radius; StrokeArgs stroke; };
+struct FillRoundedRectCmd { Rect rect; CornerRadius radius; uint32_t brush; };
+struct EllipseCmd { Point center; float rx; float ry; StrokeArgs stroke; };
+struct FillEllipseCmd { Point center; float rx; float ry; uint32_t brush; };
+struct GeometryCmd { uint32_t geometry; StrokeArgs stroke; };
+struct FillGeometryCmd { uint32_t geometry; uint32_t brush; };
+struct BitmapCmd { uint32_t bitmap; Rect destination; Rect source; float opacity; uint32_t hasSource; };
+struct TextCmd { uint32_t text; uint32_t format; Rect rect; uint32_t brush; };
+
+// 批量命令头部，后随 count 个 Rect / count 对 Point
+struct FillRectsHead { uint32_t brush; uint32_t count; };
+struct LinesHead { StrokeArgs stroke; uint32_t count; };
+
+constexpr size_t kMaxBulkRects = (0xFFFF - sizeof(FillRectsHead)) / sizeof(Rect);
+constexpr size_t kMaxBulkSegments = (0xFFFF - sizeof(LinesHead)) / (sizeof(Point) * 2);
+
+// 优化时最多越过多少个批次向前合并
+constexpr size_t kReorderWindow = 16;
+
+struct Header {
+    uint8_t op;
+    uint8_t reserved;
+    uint16_t size;
+};
+
+constexpr size_t Align4(size_t n) { return (n + 3) & ~static_cast<size_t>(3); }
+
+template <typename T>
+T ReadPayload(const uint8_t* p) {
+    T value;
+    std::memcpy(static_cast<void*>(&value), p, sizeof(T));
+    return value;
+}
+
+} // anonymous namespace
+
+// ==================== DisplayList ====================
+
+template <typename T>
+void DisplayList::Write(Op op, const T& payload) {
+    static_assert(std::is_trivially_copyable<T>::value, "display list payloads must be trivially copyable");
+    static_assert(sizeof(T) <= 0xFFFF, "payload too large");
+    Header h{ static_cast<uint8_t>(op), 0, static_cast<uint16_t>(sizeof(T)) };
+    size_t offset = m_commands.size();
+    m_commands.resize(offset + sizeof(Header) + Align4(sizeof(T)));
+    std::memcpy(m_commands.data() + offset, &h, sizeof(Header));
+    std::memcpy(m_commands.data() + offset + sizeof(Header), &payload, sizeof(T));
+    ++m_commandCount;
+}
+
+void DisplayList::Write(Op op) {
+    Header h{ static_cast<uint8_t>(op), 0, 0 };
+    size_t offset = m_commands.size();
+    m_commands.resize(offset + sizeof(Header));
+    std::memcpy(m_commands.data() + offset, &h, sizeof(Header));
+    ++m_commandCount;
+}
+
+void DisplayList::WriteBulk(Op op, const void* head, size_t headSize, const void* items, size_t itemsSize) {
+    Header h{ static_cast<uint8_t>(op), 0, static_cast<uint16_t>(headSize + itemsSize) };
+    size_t offset = m_commands.size();
+    m_commands.resize(offset + sizeof(Header) + Align4(headSize + itemsSize));
+    std::memcpy(m_commands.data() + offset, &h, sizeof(Header));
+    std::memcpy(m_commands.data() + offset + sizeof(Header), head, headSize);
+    std::memcpy(m_commands.data() + offset + sizeof(Header) + headSize, items, itemsSize);
+    ++m_commandCount;
+}
+
+void DisplayList::WriteFillRectangles(uint32_t brush, const Rect* rects, size_t count) {
+    while (count > 0) {
+        size_t n = (std::min)(count, kMaxBulkRects);
+        FillRectsHead head{ brush, static_cast<uint32_t>(n) };
+        WriteBulk(Op::FillRectangles, &head, sizeof(head), rects, n * sizeof(Rect));
+        rects += n;
+        count -= n;
+    }
+}
+
+void DisplayList::WriteDrawLines(uint32_t brush, float strokeWidth, uint32_t style, const Point* points,
+                                 size_t segmentCount) {
+    while (segmentCount > 0) {
+        size_t n = (std::min)(segmentCount, kMaxBulkSegments);
+        LinesHead head{ { brush, strokeWidth, style }, static_cast<uint32_t>(n) };
+        WriteBulk(Op::DrawLines, &head, sizeof(head), points, n * 2 * sizeof(Point));
+        points += n * 2;
+        segmentCount -= n;
+    }
+}
+
+template <typename T>
+uint32_t DisplayList::AddUnique(std::vector<T*>& slots, T* item) {
+    if (!item) return kNoResource;
+    for (size_t i = 0; i < slots.size(); ++i) {
+        if (slots[i] == item) return static_cast<uint32_t>(i);
+    }
+    slots.push_back(item);
+    return static_cast<uint32_t>(slots.size() - 1);
+}
+
+uint32_t DisplayList::AddBrush(IBrush* brush) { return AddUnique(m_brushes, brush); }
+uint32_t DisplayList::AddGeometry(const IGeometry* geometry) { return AddUnique(m_geometries, geometry); }
+uint32_t DisplayList::AddBitmap(IBitmap* bitmap) { return AddUnique(m_bitmaps, bitmap); }
+uint32_t DisplayList::AddTextFormat(ITextFormat* format) { return AddUnique(m_textFormats, format); }
+
+uint32_t DisplayList::AddStrokeStyle(const StrokeStyle* style) {
+    if (!style) return kNoResource;
+    m_strokeStyles.push_back(*style);
+    return static_cast<uint32_t>(m_strokeStyles.size() - 1);
+}
+
+uint32_t DisplayList::AddString(const std::wstring& text) {
+    m_strings.push_back(text);
+    return static_cast<uint32_t>(m_strings.size() - 1);
+}
+
+void DisplayList::Retain(std::shared_ptr<void> resource) {
+    if (resource) m_retained.push_back(std::move(resource));
+}
+
+void DisplayList::Clear() {
+    m_commands.clear();
+    m_commandCount = 0;
+    m_brushes.clear();
+    m_geometries.clear();
+    m_bitmaps.clear();
+    m_textFormats.clear();
+    m_strokeStyles.clear();
+    m_strings.clear();
+    m_retained.clear();
+    m_recordedSize = Size();
+}
+
+void DisplayList::Replay(IRenderContext* context) const {
+    if (!context || m_commands.empty()) return;
+
+    // 相对变换叠加到重放时的当前变换上
+    const Transform base = context->GetTransform();
+
+    auto brush = [this](uint32_t i) { return i == kNoResource ? nullptr : m_brushes[i]; };
+    auto style = [this](uint32_t i) { return i == kNoResource ? nullptr : &m_strokeStyles[i]; };
+
+    const uint8_t* p = m_commands.data();
+    const uint8_t* end = p + m_commands.size();
+    while (p < end) {
+        Header h;
+        std::memcpy(&h, p, sizeof(Header));
+        const uint8_t* data = p + sizeof(Header);
+        p = data + Align4(h.size);
+
+        switch (static_cast<Op>(h.op)) {
+            case Op::Clear:
+                context->Clear(ReadPayload<Color>(data));
+                break;
+            case Op::PushState: context->PushState(); break;
+            case Op::PopState: context->PopState(); break;
+            case Op::ResetState: context->ResetState(); break;
+            case Op::SetTransform:
+                context->SetTransform(ReadPayload<Transform>(data) * base);
+                break;
+            case Op::MultiplyTransform:
+                context->MultiplyTransform(ReadPayload<Transform>(data));
+                break;
+            case Op::SetOpacity: context->SetOpacity(ReadPayload<float>(data)); break;
+            case Op::SetAntialias: context->SetAntialias(ReadPayload<uint32_t>(data) != 0); break;
+            case Op::PushClipRect: context->PushClip(ReadPayload<Rect>(data)); break;
+            case Op::PushClipGeometry:
+                context->PushClip(*m_geometries[ReadPayload<uint32_t>(data)]);
+                break;
+            case Op::PopClip: context->PopClip(); break;
+            case Op::ResetClip: context->ResetClip(); break;
+            case Op::PushLayer: context->PushLayer(ReadPayload<float>(data)); break;
+            case Op::PopLayer: context->PopLayer(); break;
+            case Op::DrawLine: {
+                auto c = ReadPayload<LineCmd>(data);
+                context->DrawLine(c.p1, c.p2, brush(c.stroke.brush), c.stroke.width, style(c.stroke.style));
+                break;
+            }
+            case Op::DrawRectangle: {
+                auto c = ReadPayload<RectCmd>(data);
+                context->DrawRectangle(c.rect, brush(c.stroke.brush), c.stroke.width, style(c.stroke.style));
+                break;
+            }
+            case Op::FillRectangle: {
+                auto c = ReadPayload<FillRectCmd>(data);
+                context->FillRectangle(c.rect, brush(c.brush));
+                break;
+            }
+            case Op::DrawRoundedRectangle: {
+                auto c = ReadPayload<RoundedRectCmd>(data);
+                context->DrawRoundedRectangle(c.rect, c.radius, brush(c.stroke.brush), c.stroke.width,
+                                              style(c.stroke.style));
+                break;
+            }
+            case Op::FillRoundedRectangle: {
+                auto c = ReadPayload<FillRoundedRectCmd>(data);
+                context->FillRoundedRectangle(c.rect, c.radius, brush(c.brush));
+                break;
+            }
+            case Op::DrawEllipse: {
+                auto c = ReadPayload<EllipseCmd>(data);
+                context->DrawEllipse(c.center, c.rx, c.ry, brush(c.stroke.brush), c.stroke.width,
+                                     style(c.stroke.style));
+                break;
+            }
+            case Op::FillEllipse: {
+                auto c = ReadPayload<FillEllipseCmd>(data);
+                context->FillEllipse(c.center, c.rx, c.ry, brush(c.brush));
+                break;
+            }
+            case Op::DrawGeometry: {
+                auto c = ReadPayload<GeometryCmd>(data);
+                context->DrawGeometry(*m_geometries[c.geometry], brush(c.stroke.brush), c.stroke.width,
+                                      style(c.stroke.style));
+                break;
+            }
+            case Op::FillGeometry: {
+                auto c = ReadPayload<FillGeometryCmd>(data);
+                context->FillGeometry(*m_geometries[c.geometry], brush(c.brush));
+                break;
+            }
+            case Op::DrawBitmap: {
+                auto c = ReadPayload<BitmapCmd>(data);
+                if (c.hasSource) {
+                    context->DrawBitmap(m_bitmaps[c.bitmap], c.destination, c.source, c.opacity);
+                } else {
+                    context->DrawBitmap(m_bitmaps[c.bitmap], c.destination, c.opacity);
+                }
+                break;
+            }
+            case Op::DrawTextAt: {
+                auto c = ReadPayload<TextCmd>(data);
+                context->DrawTextString(m_strings[c.text], m_textFormats[c.format],
+                                        Point(c.rect.x, c.rect.y), brush(c.brush));
+                break;
+            }
+            case Op::DrawTextInRect: {
+                auto c = ReadPayload<TextCmd>(data);
+                context->DrawTextString(m_strings[c.text], m_textFormats[c.format], c.rect, brush(c.brush));
+                break;
+            }
+            case Op::FillRectangles: {
+                // 数组紧随头部且 4 字节对齐，直接传给后端
+                auto c = ReadPayload<FillRectsHead>(data);
+                context->FillRectangles(reinterpret_cast<const Rect*>(data + sizeof(FillRectsHead)), c.count,
+                                        brush(c.brush));
+                break;
+            }
+            case Op::DrawLines: {
+                auto c = ReadPayload<LinesHead>(data);
+                context->DrawLines(reinterpret_cast<const Point*>(data + sizeof(LinesHead)), c.count,
+                                   brush(c.stroke.brush), c.stroke.width, style(c.stroke.style));
+                break;
+            }
+        }
+    }
+}
+
+// ==================== 命令流优化 ====================
+
+namespace {
+
+// 同一批次内的图元共享画刷（直线还共享线宽和线型），按录制顺序保存
+struct Batch {
+    bool lines = false;
+    uint32_t brush = 0;
+    float width = 0;
+    uint32_t style = 0;
+    std::vector<Rect> rects;
+    std::vector<Point> points;
+    std::vector<Rect> bounds;   // 每个图元的外包框（含抗锯齿余量）
+    Rect extent;                // bounds 的并集
+
+    size_t Size() const { return bounds.size(); }
+
+    bool Matches(bool isLine, uint32_t b, float w, uint32_t s) const {
+        return lines == isLine && brush == b && (!isLine || (width == w && style == s));
+    }
+
+    bool Overlaps(const Rect& r) const {
+        if (!Overlap(extent, r)) return false;
+        for (const auto& item : bounds) {
+            if (Overlap(item, r)) return true;
+        }
+        return false;
+    }
+
+    // 外包框已含余量，仅接触边界的两个图元不会影响同一像素
+    static bool Overlap(const Rect& a, const Rect& b) {
+        return a.x < b.Right() && b.x < a.Right() && a.y < b.Bottom() && b.y < a.Bottom();
+    }
+
+    void AddBounds(const Rect& r) {
+        if (bounds.empty()) {
+            extent = r;
+        } else {
+            float x0 = (std::min)(extent.x, r.x), y0 = (std::min)(extent.y, r.y);
+            float x1 = (std::max)(extent.Right(), r.Right()), y1 = (std::max)(extent.Bottom(), r.Bottom());
+            extent = Rect(x0, y0, x1 - x0, y1 - y0);
+        }
+        bounds.push_back(r);
+    }
+};
+
+// 抗锯齿边缘会影响相邻像素，外包框各向外扩展 1 个单位
+Rect RectBounds(const Rect& r) {
+    float x0 = (std::min)(r.x, r.Right()), y0 = (std::min)(r.y, r.Bottom());
+    float x1 = (std::max)(r.x, r.Right()), y1 = (std::max)(r.y, r.Bottom());
+    return Rect(x0 - 1, y0 - 1, x1 - x0 + 2, y1 - y0 + 2);
+}
+
+Rect LineBounds(const Point& p1, const Point& p2, float width) {
+    // 线宽的一半（方形线帽沿线方向同样延伸）加抗锯齿余量
+    float pad = (std::max)(width, 0.0f) * 0.5f + 1;
+    float x0 = (std::min)(p1.x, p2.x), y0 = (std::min)(p1.y, p2.y);
+    float x1 = (std::max)(p1.x, p2.x), y1 = (std::max)(p1.y, p2.y);
+    return Rect(x0 - pad, y0 - pad, x1 - x0 + pad * 2, y1 - y0 + pad * 2);
+}
+
+} // anonymous namespace
+
+void DisplayList::Optimize() {
+    if (m_commandCount < 2) return;
+
+    // 录制时每次 CreateSolidColorBrush 都是新画刷：颜色相同的纯色画刷归并到同一槽位
+    std::vector<uint32_t> brushKey(m_brushes.size());
+    std::map<std::tuple<float, float, float, float>, uint32_t> solidSlots;
+    for (size_t i = 0; i < m_brushes.size(); ++i) {
+        brushKey[i] = static_cast<uint32_t>(i);
+        if (auto* solid = dynamic_cast<ISolidColorBrush*>(m_brushes[i])) {
+            Color c = solid->GetColor();
+            auto result = solidSlots.emplace(std::make_tuple(c.r, c.g, c.b, c.a), static_cast<uint32_t>(i));
+            brushKey[i] = result.first->second;
+        }
+    }
+    auto key = [&brushKey](uint32_t brush) { return brush == kNoResource ? kNoResource : brushKey[brush]; };
+
+    std::vector<uint8_t> input;
+    input.swap(m_commands);
+    m_commands.reserve(input.size());
+    m_commandCount = 0;
+
+    // 当前段（两次非图元命令之间）的批次
+    std::vector<Batch> batches;
+
+    auto findBatch = [&batches](bool isLine, uint32_t brush, float width, uint32_t style,
+                                const Rect& bounds) -> Batch& {
+        size_t scanned = 0;
+        for (size_t i = batches.size(); i-- > 0 && scanned < kReorderWindow; ++scanned) {
+            if (batches[i].Matches(isLine, brush, width, style)) return batches[i];
+            // 不能越过与之重叠的批次，否则会改变覆盖顺序
+            if (batches[i].Overlaps(bounds)) break;
+        }
+        batches.emplace_back();
+        Batch& b = batches.back();
+        b.lines = isLine;
+        b.brush = brush;
+        b.width = width;
+        b.style = style;
+        return b;
+    };
+    auto addRect = [&](uint32_t brush, const Rect& rect) {
+        Rect bounds = RectBounds(rect);
+        Batch& b = findBatch(false, brush, 0, 0, bounds);
+        b.rects.push_back(rect);
+        b.AddBounds(bounds);
+    };
+    auto addLine = [&](const StrokeArgs& stroke, const Point& p1, const Point& p2) {
+        Rect bounds = LineBounds(p1, p2, stroke.width);
+        Batch& b = findBatch(true, key(stroke.brush), stroke.width, stroke.style, bounds);
+        b.points.push_back(p1);
+        b.points.push_back(p2);
+        b.AddBounds(bounds);
+    };
+    auto flush = [this, &batches]() {
+        for (const auto& b : batches) {
+            if (b.lines) {
+                if (b.Size() == 1) {
+                    Write(Op::DrawLine, LineCmd{ b.points[0], b.points[1], { b.brush, b.width, b.style } });
+                } else {
+                    WriteDrawLines(b.brush, b.width, b.style, b.points.data(), b.Size());
+                }
+            } else if (b.Size() == 1) {
+                Write(Op::FillRectangle, FillRectCmd{ b.rects[0], b.brush });
+            } else {
+                WriteFillRectangles(b.brush, b.rects.data(), b.Size());
+            }
+        }
+        batches.clear();
+    };
+
+    const uint8_t* p = input.data();
+    const uint8_t* end = p + input.size();
+    while (p < end) {
+        Header h;
+        std::memcpy(&h, p, sizeof(Header));
+        const uint8_t* data = p + sizeof(Header);
+        const uint8_t* next = data + Align4(h.size);
+
+        switch (static_cast<Op>(h.op)) {
+            case Op::FillRectangle: {
+                auto c = ReadPayload<FillRectCmd>(data);
+                addRect(key(c.brush), c.rect);
+                break;
+            }
+            case Op::FillRectangles: {
+                auto c = ReadPayload<FillRectsHead>(data);
+                for (uint32_t i = 0; i < c.count; ++i) {
+                    addRect(key(c.brush), ReadPayload<Rect>(data + sizeof(FillRectsHead) + i * sizeof(Rect)));
+                }
+                break;
+            }
+            case Op::DrawLine: {
+                auto c = ReadPayload<LineCmd>(data);
+                addLine(c.stroke, c.p1, c.p2);
+                break;
+            }
+            case Op::DrawLines: {
+                auto c = ReadPayload<LinesHead>(data);
+                const uint8_t* points = data + sizeof(LinesHead);
+                for (uint32_t i = 0; i < c.count; ++i) {
+                    addLine(c.stroke, ReadPayload<Point>(points + i * 2 * sizeof(Point)),
+                            ReadPayload<Point>(points + (i * 2 + 1) * sizeof(Point)));
+                }
+                break;
+            }
+            default:
+                // 状态变化和其他绘制命令是屏障：先输出已收集的批次，再原样复制
+                flush();
+                m_commands.insert(m_commands.end(), p, next);
+                ++m_commandCount;
+                break;
+        }
+        p = next;
+    }
+    flush();
+}
+
+// ==================== RecordingRenderContext ====================
+
+RecordingRenderContext::RecordingRenderContext(IRenderContext* target, DisplayList* list)
+    : m_target(target)
+    , m_list(list)
+    , m_inverseBase(target->GetTransform().Invert()) {
+}
+
+template <typename T>
+std::shared_ptr<T> RecordingRenderContext::Own(std::shared_ptr<T> resource) {
+    if (resource) {
+        m_owned.insert(resource.get());
+        m_list->Retain(resource);
+    }
+    return resource;
+}
+
+uint32_t RecordingRenderContext::BrushSlot(IBrush* brush) {
+    if (!brush) return DisplayList::kNoResource;
+    if (m_owned.count(brush)) return m_list->AddBrush(brush);
+
+    auto it = m_copies.find(brush);
+    if (it != m_copies.end()) return m_list->AddBrush(static_cast<IBrush*>(it->second));
+
+    // 外部纯色画刷（如资源缓存中的实例）可能先于显示列表被释放，复制一份
+    if (auto* solid = dynamic_cast<ISolidColorBrush*>(brush)) {
+        if (auto copy = m_target->CreateSolidColorBrush(solid->GetColor())) {
+            m_list->Retain(copy);
+            m_copies[brush] = static_cast<IBrush*>(copy.get());
+            return m_list->AddBrush(copy.get());
+        }
+    }
+    // 渐变画刷无法读回渐变点，不能复制：重放时可能已被释放
+    m_cacheable = false;
+    return m_list->AddBrush(brush);
+}
+
+uint32_t RecordingRenderContext::TextFormatSlot(ITextFormat* format) {
+    if (!format) return DisplayList::kNoResource;
+    if (m_owned.count(format)) return m_list->AddTextFormat(format);
+
+    auto it = m_copies.find(format);
+    if (it != m_copies.end()) return m_list->AddTextFormat(static_cast<ITextFormat*>(it->second));
+
+    if (auto copy = m_target->CreateTextFormat(format->GetFontFamily(), format->GetFontSize())) {
+        copy->SetFontWeight(format->GetFontWeight());
+        copy->SetFontStyle(format->GetFontStyle());
+        copy->SetTextAlignment(format->GetTextAlignment());
+        copy->SetParagraphAlignment(format->GetParagraphAlignment());
+        copy->SetWordWrapping(format->GetWordWrapping());
+        copy->SetTextTrimming(format->GetTextTrimming());
+        m_list->Retain(copy);
+        m_copies[format] = copy.get();
+        return m_list->AddTextFormat(copy.get());
+    }
+    return m_list->AddTextFormat(format);
+}
+
+uint32_t RecordingRenderContext::GeometrySlot(const IGeometry& geometry) {
+    if (m_owned.count(&geometry)) return m_list->AddGeometry(&geometry);
+
+    auto it = m_copies.find(&geometry);
+    if (it != m_copies.end()) return m_list->AddGeometry(static_cast<IGeometry*>(it->second));
+
+    // 简单几何可按参数重建一份；路径/组合几何无法读回，录制结果不可缓存
+    std::shared_ptr<IGeometry> copy;
+    if (auto* rect = dynamic_cast<const IRectangleGeometry*>(&geometry)) {
+        copy = m_target->CreateRectangleGeometry(rect->GetRect());
+    } else if (auto* rounded = dynamic_cast<const IRoundedRectangleGeometry*>(&geometry)) {
+        copy = m_target->CreateRoundedRectangleGeometry(rounded->GetRect(), rounded->GetCornerRadius());
+    } else if (auto* ellipse = dynamic_cast<const IEllipseGeometry*>(&geometry)) {
+        copy = m_target->CreateEllipseGeometry(ellipse->GetCenter(), ellipse->GetRadiusX(), ellipse->GetRadiusY());
+    }
+    if (copy) {
+        m_list->Retain(copy);
+        m_copies[&geometry] = copy.get();
+        return m_list->AddGeometry(copy.get());
+    }
+    m_cacheable = false;
+    return m_list->AddGeometry(&geometry);
+}
+
+uint32_t RecordingRenderContext::BitmapSlot(IBitmap* bitmap) {
+    if (m_owned.count(bitmap)) return m_list->AddBitmap(bitmap);
+
+    // 外部位图（如 Image 控件持有的位图）只有裸指针，复制像素代价过高：录制结果不可缓存
+    m_cacheable = false;
+    return m_list->AddBitmap(bitmap);
+}
+
+void RecordingRenderContext::Clear(const Color& color) {
+    m_target->Clear(color);
+    m_list->Write(DisplayList::Op::Clear, color);
+}
+
+void RecordingRenderContext::PushState() {
+    m_target->PushState();
+    m_list->Write(DisplayList::Op::PushState);
+}
+
+void RecordingRenderContext::PopState() {
+    m_target->PopState();
+    m_list->Write(DisplayList::Op::PopState);
+}
+
+void RecordingRenderContext::ResetState() {
+    m_target->ResetState();
+    m_list->Write(DisplayList::Op::ResetState);
+}
+
+void RecordingRenderContext::SetTransform(const Transform& transform) {
+    m_target->SetTransform(transform);
+    m_list->Write(DisplayList::Op::SetTransform, transform * m_inverseBase);
+}
+
+void RecordingRenderContext::MultiplyTransform(const Transform& transform) {
+    m_target->MultiplyTransform(transform);
+    m_list->Write(DisplayList::Op::MultiplyTransform, transform);
+}
+
+void RecordingRenderContext::SetOpacity(float opacity) {
+    m_target->SetOpacity(opacity);
+    m_list->Write(DisplayList::Op::SetOpacity, opacity);
+}
+
+void RecordingRenderContext::SetAntialias(bool enabled) {
+    m_target->SetAntialias(enabled);
+    m_list->Write(DisplayList::Op::SetAntialias, static_cast<uint32_t>(enabled ? 1 : 0));
+}
+
+void RecordingRenderContext::PushClip(const Rect& rect) {
+    m_target->PushClip(rect);
+    m_list->Write(DisplayList::Op::PushClipRect, rect);
+}
+
+void RecordingRenderContext::PushClip(const IGeometry& geometry) {
+    m_target->PushClip(geometry);
+    m_list->Write(DisplayList::Op::PushClipGeometry, GeometrySlot(geometry));
+}
+
+void RecordingRenderContext::PopClip() {
+    m_target->PopClip();
+    m_list->Write(DisplayList::Op::PopClip);
+}
+
+void RecordingRenderContext::ResetClip() {
+    m_target->ResetClip();
+    m_list->Write(DisplayList::Op::ResetClip);
+}
+
+Rect RecordingRenderContext::GetClipBounds() const {
+    // 绘制结果依赖裁剪区域（如可视区域剔除），重放时裁剪可能不同
+    const_cast<RecordingRenderContext*>(this)->m_cacheable = false;
+    return m_target->GetClipBounds();
+}
+
+void RecordingRenderContext::DrawLine(const Point& p1, const Point& p2, IBrush* brush, float strokeWidth,
+                                      const StrokeStyle* strokeStyle) {
+    m_target->DrawLine(p1, p2, brush, strokeWidth, strokeStyle);
+    LineCmd c{ p1, p2, { BrushSlot(brush), strokeWidth, m_list->AddStrokeStyle(strokeStyle) } };
+    m_list->Write(DisplayList::Op::DrawLine, c);
+}
+
+void RecordingRenderContext::DrawRectangle(const Rect& rect, IBrush* brush, float strokeWidth,
+                                           const StrokeStyle* strokeStyle) {
+    m_target->DrawRectangle(rect, brush, strokeWidth, strokeStyle);
+    RectCmd c{ rect, { BrushSlot(brush), strokeWidth, m_list->AddStrokeStyle(strokeStyle) } };
+    m_list->Write(DisplayList::Op::DrawRectangle, c);
+}
+
+void RecordingRenderContext::FillRectangle(const Rect& rect, IBrush* brush) {
+    m_target->FillRectangle(rect, brush);
+    m_list->Write(DisplayList::Op::FillRectangle, FillRectCmd{ rect, BrushSlot(brush) });
+}
+
+void RecordingRenderContext::FillRectangles(const Rect* rects, size_t count, IBrush* brush) {
+    m_target->FillRectangles(rects, count, brush);
+    if (!rects || count == 0) return;
+    m_list->WriteFillRectangles(BrushSlot(brush), rects, count);
+}
+
+void RecordingRenderContext::DrawLines(const Point* points, size_t segmentCount, IBrush* brush,
+                                       float strokeWidth, const StrokeStyle* strokeStyle) {
+    m_target->DrawLines(points, segmentCount, brush, strokeWidth, strokeStyle);
+    if (!points || segmentCount == 0) return;
+    m_list->WriteDrawLines(BrushSlot(brush), strokeWidth, m_list->AddStrokeStyle(strokeStyle), points, segmentCount);
+}
+
+void RecordingRenderContext::DrawRoundedRectangle(const Rect& rect, const CornerRadius& radius, IBrush* brush,
+                                                  float strokeWidth, const StrokeStyle* strokeStyle) {
+    m_target->DrawRoundedRectangle(rect, radius, brush, strokeWidth, strokeStyle);
+    RoundedRectCmd c{ rect, radius, { BrushSlot(brush), strokeWidth, m_list->AddStrokeStyle(strokeStyle) } };
+    m_list->Write(DisplayList::Op::DrawRoundedRectangle, c);
+}
+
+void RecordingRenderContext::FillRoundedRectangle(const Rect& rect, const CornerRadius& radius, IBrush* brush) {
+    m_target->FillRoundedRectangle(rect, radius, brush);
+    m_list->Write(DisplayList::Op::FillRoundedRectangle, FillRoundedRectCmd{ rect, radius, BrushSlot(brush) });
+}
+
+void RecordingRenderContext::DrawEllipse(const Point& center, float radiusX, float radiusY, IBrush* brush,
+                                         float strokeWidth, const StrokeStyle* strokeStyle) {
+    m_target->DrawEllipse(center, radiusX, radiusY, brush, strokeWidth, strokeStyle);
+    EllipseCmd c{ center, radiusX, radiusY, { BrushSlot(brush), strokeWidth, m_list->AddStrokeStyle(strokeStyle) } };
+    m_list->Write(DisplayList::Op::DrawEllipse, c);
+}
+
+void RecordingRenderContext::FillEllipse(const Point& center, float radiusX, float radiusY, IBrush* brush) {
+    m_target->FillEllipse(center, radiusX, radiusY, brush);
+    m_list->Write(DisplayList::Op::FillEllipse, FillEllipseCmd{ center, radiusX, radiusY, BrushSlot(brush) });
+}
+
+void RecordingRenderContext::DrawGeometry(const IGeometry& geometry, IBrush* brush, float strokeWidth,
+                                          const StrokeStyle* strokeStyle) {
+    m_target->DrawGeometry(geometry, brush, strokeWidth, strokeStyle);
+    GeometryCmd c{ GeometrySlot(geometry),
+                   { BrushSlot(brush), strokeWidth, m_list->AddStrokeStyle(strokeStyle) } };
+    m_list->Write(DisplayList::Op::DrawGeometry, c);
+}
+
+void RecordingRenderContext::FillGeometry(const IGeometry& geometry, IBrush* brush) {
+    m_target->FillGeometry(geometry, brush);
+    m_list->Write(DisplayList::Op::FillGeometry, FillGeometryCmd{ GeometrySlot(geometry), BrushSlot(brush) });
+}
+
+void RecordingRenderContext::DrawBitmap(IBitmap* bitmap, const Point& destination, float opacity) {
+    if (!bitmap) return;
+    DrawBitmap(bitmap, Rect(destination, bitmap->GetSize()), opacity);
+}
+
+void RecordingRenderContext::DrawBitmap(IBitmap* bitmap, const Rect& destination, float opacity) {
+    m_target->DrawBitmap(bitmap, destination, opacity);
+    if (!bitmap) return;
+    BitmapCmd c{ BitmapSlot(bitmap), destination, Rect(), opacity, 0 };
+    m_list->Write(DisplayList::Op::DrawBitmap, c);
+}
+
+void RecordingRenderContext::DrawBitmap(IBitmap* bitmap, const Rect& destination, const Rect& source,
+                                        float opacity) {
+    m_target->DrawBitmap(bitmap, destination, source, opacity);
+    if (!bitmap) return;
+    BitmapCmd c{ BitmapSlot(bitmap), destination, source, opacity, 1 };
+    m_list->Write(DisplayList::Op::DrawBitmap, c);
+}
+
+void RecordingRenderContext::DrawTextString(const std::wstring& text, ITextFormat* format,
+                                            const Point& position, IBrush* brush) {
+    m_target->DrawTextString(text, format, position, brush);
+    if (!format) return;
+    TextCmd c{ m_list->AddString(text), TextFormatSlot(format), Rect(position.x, position.y, 0, 0), BrushSlot(brush) };
+    m_list->Write(DisplayList::Op::DrawTextAt, c);
+}
+
+void RecordingRenderContext::DrawTextString(const std::wstring& text, ITextFormat* format,
+                                            const Rect& rect, IBrush* brush) {
+    m_target->DrawTextString(text, format, rect, brush);
+    if (!format) return;
+    TextCmd c{ m_list->AddString(text), TextFormatSlot(format), rect, BrushSlot(brush) };
+    m_list->Write(DisplayList::Op::DrawTextInRect, c);
+}
+
+void RecordingRenderContext::PushLayer(float opacity) {
+    m_target->PushLayer(opacity);
+    m_list->Write(DisplayList::Op::PushLayer, opacity);
+}
+
+void RecordingRenderContext::PopLayer() {
+    m_target->PopLayer();
+    m_list->Write(DisplayList::Op::PopLayer);
+}
+
+// ==================== 工厂方法 ====================
+
+ISolidColorBrushPtr RecordingRenderContext::CreateSolidColorBrush(const Color& color) {
+    return Own(m_target->CreateSolidColorBrush(color));
+}
+
+ILinearGradientBrushPtr RecordingRenderContext::CreateLinearGradientBrush(const Point& start, const Point& end,
+                                                                          const std::vector<GradientStop>& stops) {
+    return Own(m_target->CreateLinearGradientBrush(start, end, stops));
+}
+
+IRadialGradientBrushPtr RecordingRenderContext::CreateRadialGradientBrush(const Point& center, float radiusX,
+                                                                          float radiusY,
+                                                                          const std::vector<GradientStop>& stops) {
+    return Own(m_target->CreateRadialGradientBrush(center, radiusX, radiusY, stops));
+}
+
+std::shared_ptr<IRectangleGeometry> RecordingRenderContext::CreateRectangleGeometry(const Rect& rect) {
+    return Own(m_target->CreateRectangleGeometry(rect));
+}
+
+std::shared_ptr<IRoundedRectangleGeometry> RecordingRenderContext::CreateRoundedRectangleGeometry(
+    const Rect& rect, const CornerRadius& radius) {
+    return Own(m_target->CreateRoundedRectangleGeometry(rect, radius));
+}
+
+std::shared_ptr<IEllipseGeometry> RecordingRenderContext::CreateEllipseGeometry(const Point& center, float radiusX,
+                                                                               float radiusY) {
+    return Own(m_target->CreateEllipseGeometry(center, radiusX, radiusY));
+}
+
+std::shared_ptr<IPathGeometry> RecordingRenderContext::CreatePathGeometry() {
+    return Own(m_target->CreatePathGeometry());
+}
+
+std::shared_ptr<ICombinedGeometry> RecordingRenderContext::CreateCombinedGeometry(IGeometry* geometry1,
+                                                                                 IGeometry* geometry2,
+                                                                                 CombineMode mode) {
+    return Own(m_target->CreateCombinedGeometry(geometry1, geometry2, mode));
+}
+
+ITextFormatPtr RecordingRenderContext::CreateTextFormat(const std::wstring& fontFamily, float fontSize) {
+    return Own(m_target->CreateTextFormat(fontFamily, fontSize));
+}
+
+ITextLayoutPtr RecordingRenderContext::CreateTextLayout(const std::wstring& text, ITextFormat* format,
+                                                        const Size& maxSize) {
+    return Own(m_target->CreateTextLayout(text, format, maxSize));
+}
+
+IBitmapPtr RecordingRenderContext::CreateBitmap(int width, int height, PixelFormat format) {
+    return Own(m_target->CreateBitmap(width, height, format));
+}
+
+IBitmapPtr RecordingRenderContext::LoadBitmapFromFile(const std::wstring& filePath) {
+    return Own(m_target->LoadBitmapFromFile(filePath));
+}
+
+IBitmapPtr RecordingRenderContext::LoadBitmapFromMemory(const void* data, size_t size) {
+    return Own(m_target->LoadBitmapFromMemory(data, size));
+}
+
+} // namespace rendering
+} // namespace luaui
@@ -0,0 +1,247 @@
+#pragma once
+
+#include "IRenderContext.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace luaui {
+namespace rendering {
+
+class RecordingRenderContext;
+
+/**
+ * @brief 显示列表（录制的绘制命令缓冲）
+ *
+ * 将一次 OnRender 产生的绘制命令紧凑地编码到一块连续内存中，
+ * 之后可在任意渲染上下文上重放，而无需再次执行控件的绘制代码、
+ * 也无需重新创建画刷和文本格式。
+ *
+ * 变换以录制开始时的变换为基准保存，重放时叠加到目标上下文的当前变换上，
+ * 因此控件移动位置后仍可直接重放。
+ *
+ * 使用示例：
+ *   DisplayList list;
+ *   {
+ *       RecordingRenderContext recorder(context, &list);
+ *       control->OnRender(&recorder);   // 边绘制边录制
+ *   }
+ *   list.Replay(context);               // 后续帧直接重放
+ */
+class DisplayList {
+public:
+    DisplayList() = default;
+
+    // 禁止拷贝（持有资源引用）
+    DisplayList(const DisplayList&) = delete;
+    DisplayList& operator=(const DisplayList&) = delete;
+
+    /**
+     * @brief 在目标上下文上重放所有命令
+     * @param context 目标渲染上下文
+     */
+    void Replay(IRenderContext* context) const;
+
+    /**
+     * @brief 清空命令和资源引用
+     */
+    void Clear();
+
+    /**
+     * @brief 优化命令流
+     *
+     * 将同一画刷的矩形填充、同一画刷和线宽的直线合并为批量命令（FillRectangles / DrawLines），
+     * 并在两次状态变化之间把互不重叠的命令前移，使同画刷命令尽量相邻。
+     * 只移动边界不相交的命令，重放结果与优化前一致。颜色相同的纯色画刷视为同一画刷。
+     */
+    void Optimize();
+
+    bool IsEmpty() const { return m_commandCount == 0; }
+    size_t GetCommandCount() const { return m_commandCount; }
+
+    /**
+     * @brief 命令缓冲占用的字节数（不含资源）
+     */
+    size_t GetByteSize() const { return m_commands.size(); }
+
+    /**
+     * @brief 录制时的绘制区域尺寸，用于判断尺寸变化后是否需要重新录制
+     */
+    const Size& GetRecordedSize() const { return m_recordedSize; }
+    void SetRecordedSize(const Size& size) { m_recordedSize = size; }
+
+private:
+    friend class RecordingRenderContext;
+
+    enum class Op : uint8_t;
+    static constexpr uint32_t kNoResource = 0xFFFFFFFFu;
+
+    template <typename T>
+    void Write(Op op, const T& payload);
+    void Write(Op op);
+
+    // 批量命令：定长头部 + 变长数组，超出单条命令容量时自动拆分
+    void WriteFillRectangles(uint32_t brush, const Rect* rects, size_t count);
+    void WriteDrawLines(uint32_t brush, float strokeWidth, uint32_t style, const Point* points, size_t segmentCount);
+    void WriteBulk(Op op, const void* head, size_t headSize, const void* items, size_t itemsSize);
+
+    uint32_t AddBrush(IBrush* brush);
+    uint32_t AddGeometry(const IGeometry* geometry);
+    uint32_t AddBitmap(IBitmap* bitmap);
+    uint32_t AddTextFormat(ITextFormat* format);
+    uint32_t AddStrokeStyle(const StrokeStyle* style);
+    uint32_t AddString(const std::wstring& text);
+    void Retain(std::shared_ptr<void> resource);
+
+    template <typename T>
+    static uint32_t AddUnique(std::vector<T*>& slots, T* item);
+
+    // 命令流：[Op][pad][uint16 size][payload...]，4 字节对齐
+    std::vector<uint8_t> m_commands;
+    size_t m_commandCount = 0;
+
+    // 命令按下标引用的资源表
+    std::vector<IBrush*> m_brushes;
+    std::vector<const IGeometry*> m_geometries;
+    std::vector<IBitmap*> m_bitmaps;
+    std::vector<ITextFormat*> m_textFormats;
+    std::vector<StrokeStyle> m_strokeStyles;
+    std::vector<std::wstring> m_strings;
+
+    // 录制期间创建的资源由显示列表持有，保证重放时有效
+    std::vector<std::shared_ptr<void>> m_retained;
+
+    Size m_recordedSize;
+};
+
+/**
+ * @brief 录制渲染上下文
+ *
+ * 包装一个真实的渲染上下文：所有调用照常转发给目标（首帧边画边录），
+ * 同时把绘制命令写入 DisplayList。
+ *
+ * 资源生命周期：
+ * - 通过本上下文创建的画刷/几何/文本格式/位图由显示列表持有
+ * - 外部传入的纯色画刷、文本格式和矩形/圆角矩形/椭圆几何会复制一份由显示列表持有
+ *
+ * 以下情况录制结果不可缓存（IsCacheable() 为 false）：
+ * - 绘制代码查询了 GetClipBounds()，结果依赖当前裁剪
+ * - 录制期间嵌套渲染了其他控件（见 MarkUncacheable）
+ * - 使用了无法复制的外部资源（渐变画刷、路径/组合几何、位图），重放时可能已被释放
+ */
+class RecordingRenderContext : public IRenderContext {
+public:
+    RecordingRenderContext(IRenderContext* target, DisplayList* list);
+    ~RecordingRenderContext() override = default;
+
+    IRenderContext* GetTarget() const { return m_target; }
+
+    /**
+     * @brief 标记录制结果不可缓存（如嵌套了子控件的渲染）
+     */
+    void MarkUncacheable() { m_cacheable = false; }
+    bool IsCacheable() const { return m_cacheable; }
+
+    // ========== IRenderContext ==========
+    bool BeginDraw() override { return m_target->BeginDraw(); }
+    bool EndDraw() override { return m_target->EndDraw(); }
+    void Clear(const Color& color) override;
+    void Flush() override { m_target->Flush(); }
+
+    void PushState() override;
+    void PopState() override;
+    void ResetState() override;
+
+    void SetTransform(const Transform& transform) override;
+    void MultiplyTransform(const Transform& transform) override;
+    Transform GetTransform() const override { return m_target->GetTransform(); }
+
+    void SetOpacity(float opacity) override;
+    float GetOpacity() const override { return m_target->GetOpacity(); }
+
+    void SetAntialias(bool enabled) override;
+    bool GetAntialias() const override { return m_target->GetAntialias(); }
+
+    void PushClip(const Rect& rect) override;
+    void PushClip(const IGeometry& geometry) override;
+    void PopClip() override;
+    void ResetClip() override;
+    Rect GetClipBounds() const override;
+
+    void DrawLine(const Point& p1, const Point& p2, IBrush* brush, float strokeWidth = 1.0f,
+                  const StrokeStyle* strokeStyle = nullptr) override;
+    void DrawRectangle(const Rect& rect, IBrush* brush, float strokeWidth = 1.0f,
+                       const StrokeStyle* strokeStyle = nullptr) override;
+    void FillRectangle(const Rect& rect, IBrush* brush) override;
+    void FillRectangles(const Rect* rects, size_t count, IBrush* brush) override;
+    void DrawLines(const Point* points, size_t segmentCount, IBrush* brush, float strokeWidth = 1.0f,
+                   const StrokeStyle* strokeStyle = nullptr) override;
+    void DrawRoundedRectangle(const Rect& rect, const CornerRadius& radius, IBrush* brush,
+                              float strokeWidth = 1.0f, const StrokeStyle* strokeStyle = nullptr) override;
+    void FillRoundedRectangle(const Rect& rect, const CornerRadius& radius, IBrush* brush) override;
+    void DrawEllipse(const Point& center, float radiusX, float radiusY, IBrush* brush,
+                     float strokeWidth = 1.0f, const StrokeStyle* strokeStyle = nullptr) override;
+    void FillEllipse(const Point& center, float radiusX, float radiusY, IBrush* brush) override;
+
+    void DrawGeometry(const IGeometry& geometry, IBrush* brush, float strokeWidth = 1.0f,
+                      const StrokeStyle* strokeStyle = nullptr) override;
+    void FillGeometry(const IGeometry& geometry, IBrush* brush) override;
+
+    void DrawBitmap(IBitmap* bitmap, const Point& destination, float opacity = 1.0f) override;
+    void DrawBitmap(IBitmap* bitmap, const Rect& destination, float opacity = 1.0f) override;
+    void DrawBitmap(IBitmap* bitmap, const Rect& destination, const Rect& source, float opacity = 1.0f) override;
+
+    void DrawTextString(const std::wstring& text, ITextFormat* format, const Point& position, IBrush* brush) override;
+    void DrawTextString(const std::wstring& text, ITextFormat* format, const Rect& rect, IBrush* brush) override;
+
+    void PushLayer(float opacity = 1.0f) override;
+    void PopLayer() override;
+
+    // 工厂方法：转发给目标上下文，结果由显示列表持有
+    ISolidColorBrushPtr CreateSolidColorBrush(const Color& color) override;
+    ILinearGradientBrushPtr CreateLinearGradientBrush(const Point& start, const Point& end,
+                                                       const std::vector<GradientStop>& stops) override;
+    IRadialGradientBrushPtr CreateRadialGradientBrush(const Point& center, float radiusX, float radiusY,
+                                                       const std::vector<GradientStop>& stops) override;
+
+    std::shared_ptr<IRectangleGeometry> CreateRectangleGeometry(const Rect& rect) override;
+    std::shared_ptr<IRoundedRectangleGeometry> CreateRoundedRectangleGeometry(const Rect& rect,
+                                                                               const CornerRadius& radius) override;
+    std::shared_ptr<IEllipseGeometry> CreateEllipseGeometry(const Point& center, float radiusX, float radiusY) override;
+    std::shared_ptr<IPathGeometry> CreatePathGeometry() override;
+    std::shared_ptr<ICombinedGeometry> CreateCombinedGeometry(IGeometry* geometry1, IGeometry* geometry2,
+                                                               CombineMode mode) override;
+
+    ITextFormatPtr CreateTextFormat(const std::wstring& fontFamily, float fontSize) override;
+    ITextLayoutPtr CreateTextLayout(const std::wstring& text, ITextFormat* format, const Size& maxSize) override;
+
+    IBitmapPtr CreateBitmap(int width, int height, PixelFormat format) override;
+    IBitmapPtr LoadBitmapFromFile(const std::wstring& filePath) override;
+    IBitmapPtr LoadBitmapFromMemory(const void* data, size_t size) override;
+
+    ResourceInterner* GetResourceInterner() override { return m_target->GetResourceInterner(); }
+
+private:
+    template <typename T>
+    std::shared_ptr<T> Own(std::shared_ptr<T> resource);
+
+    // 将外部资源映射为显示列表中可安全重放的槽位
+    uint32_t BrushSlot(IBrush* brush);
+    uint32_t TextFormatSlot(ITextFormat* format);
+    uint32_t GeometrySlot(const IGeometry& geometry);
+    uint32_t BitmapSlot(IBitmap* bitmap);
+
+    IRenderContext* m_target;
+    DisplayList* m_list;
+    Transform m_inverseBase;   // 录制开始时变换的逆
+    bool m_cacheable = true;
+
+    std::unordered_set<const void*> m_owned;          // 显示列表持有的资源
+    std::unordered_map<const void*, void*> m_copies;  // 外部资源 -> 持有的副本
+};
+
+} // namespace rendering
+} // namespace luaui
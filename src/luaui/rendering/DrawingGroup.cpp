@@ -0,0 +1,726 @@
+#include "DrawingGroup.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace luaui {
+namespace rendering {
+
+namespace {
+
+// 直线的命中容差（像素），细线也能被点中
+constexpr float kLineHitTolerance = 2.0f;
+
+Rect Union(const Rect& a, const Rect& b) {
+    float left = (std::min)(a.Left(), b.Left());
+    float top = (std::min)(a.Top(), b.Top());
+    float right = (std::max)(a.Right(), b.Right());
+    float bottom = (std::max)(a.Bottom(), b.Bottom());
+    return Rect(left, top, right - left, bottom - top);
+}
+
+Rect Inflate(const Rect& rect, float amount) {
+    return Rect(rect.x - amount, rect.y - amount, rect.width + amount * 2, rect.height + amount * 2);
+}
+
+bool SameColor(const Color& a, const Color& b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+size_t HashFloat(float value, size_t seed) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return seed ^ (bits + 0x9e3779b9u + (seed << 6) + (seed >> 2));
+}
+
+} // anonymous namespace
+
+// ==================== Style ====================
+
+bool DrawingGroup::Style::operator==(const Style& other) const {
+    return SameColor(fill, other.fill) && SameColor(stroke, other.stroke) &&
+           strokeThickness == other.strokeThickness;
+}
+
+size_t DrawingGroup::StyleHash::operator()(const Style& style) const {
+    size_t seed = 0;
+    for (float value : { style.fill.r, style.fill.g, style.fill.b, style.fill.a,
+                         style.stroke.r, style.stroke.g, style.stroke.b, style.stroke.a,
+                         style.strokeThickness }) {
+        seed = HashFloat(value, seed);
+    }
+    return seed;
+}
+
+DrawingGroup::DrawingGroup() = default;
+
+DrawingGroup::StyleId DrawingGroup::AddStyle(const Style& style) {
+    auto it = m_styleLookup.find(style);
+    if (it != m_styleLookup.end()) return it->second;
+
+    StyleId id = static_cast<StyleId>(m_styles.size());
+    m_styles.push_back(style);
+    m_styleLookup.emplace(style, id);
+    return id;
+}
+
+DrawingGroup::StyleId DrawingGroup::AddStrokeStyle(const Color& stroke, float thickness) {
+    Style style;
+    style.stroke = stroke;
+    style.strokeThickness = thickness;
+    return AddStyle(style);
+}
+
+// ==================== 添加 / 删除 ====================
+
+DrawingGroup::PrimitiveId DrawingGroup::Allocate(PrimitiveKind kind, StyleId style,
+                                                 const Rect& geometry, float param) {
+    PrimitiveId id;
+    if (!m_freeIds.empty()) {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    } else {
+        id = static_cast<PrimitiveId>(m_kinds.size());
+        m_kinds.push_back(kind);
+        m_flags.push_back(0);
+        m_styleIds.push_back(style);
+        m_geometry.push_back(geometry);
+        m_bounds.emplace_back();
+        m_params.push_back(param);
+        m_resources.push_back(0);
+    }
+
+    m_kinds[id] = kind;
+    m_flags[id] = Alive | Visible;
+    m_styleIds[id] = style;
+    m_geometry[id] = geometry;
+    m_params[id] = param;
+    m_resources[id] = 0;
+    m_bounds[id] = ComputeBounds(id);
+    AddDamage(m_bounds[id]);
+
+    if (!m_indexDirty) {
+        IndexPrimitive(id);
+    }
+    return id;
+}
+
+DrawingGroup::PrimitiveId DrawingGroup::AddRectangle(const Rect& rect, StyleId style) {
+    PrimitiveId id = Allocate(PrimitiveKind::Rectangle, style, rect, 0);
+    NotifyChanged();
+    return id;
+}
+
+DrawingGroup::PrimitiveId DrawingGroup::AddRoundedRectangle(const Rect& rect, float radius, StyleId style) {
+    PrimitiveId id = Allocate(PrimitiveKind::RoundedRectangle, style, rect, radius);
+    NotifyChanged();
+    return id;
+}
+
+DrawingGroup::PrimitiveId DrawingGroup::AddEllipse(const Rect& bounds, StyleId style) {
+    PrimitiveId id = Allocate(PrimitiveKind::Ellipse, style, bounds, 0);
+    NotifyChanged();
+    return id;
+}
+
+DrawingGroup::PrimitiveId DrawingGroup::AddLine(const Point& p1, const Point& p2, StyleId style) {
+    PrimitiveId id = Allocate(PrimitiveKind::Line, style, Rect(p1.x, p1.y, p2.x - p1.x, p2.y - p1.y), 0);
+    NotifyChanged();
+    return id;
+}
+
+DrawingGroup::PrimitiveId DrawingGroup::AddText(const std::wstring& text, const Rect& rect,
+                                                float fontSize, StyleId style) {
+    PrimitiveId id = Allocate(PrimitiveKind::Text, style, rect, fontSize);
+    uint32_t slot;
+    if (!m_freeTexts.empty()) {
+        slot = m_freeTexts.back();
+        m_freeTexts.pop_back();
+        m_texts[slot] = text;
+    } else {
+        slot = static_cast<uint32_t>(m_texts.size());
+        m_texts.push_back(text);
+    }
+    m_resources[id] = slot;
+    NotifyChanged();
+    return id;
+}
+
+DrawingGroup::PrimitiveId DrawingGroup::AddBitmap(IBitmapPtr bitmap, const Rect& rect, float opacity) {
+    PrimitiveId id = Allocate(PrimitiveKind::Bitmap, 0, rect, opacity);
+    uint32_t slot;
+    if (!m_freeBitmaps.empty()) {
+        slot = m_freeBitmaps.back();
+        m_freeBitmaps.pop_back();
+        m_bitmaps[slot] = std::move(bitmap);
+    } else {
+        slot = static_cast<uint32_t>(m_bitmaps.size());
+        m_bitmaps.push_back(std::move(bitmap));
+    }
+    m_resources[id] = slot;
+    NotifyChanged();
+    return id;
+}
+
+void DrawingGroup::AddRectangles(const Rect* rects, size_t count, StyleId style, PrimitiveId* ids) {
+    for (size_t i = 0; i < count; ++i) {
+        PrimitiveId id = Allocate(PrimitiveKind::Rectangle, style, rects[i], 0);
+        if (ids) ids[i] = id;
+    }
+    NotifyChanged();
+}
+
+void DrawingGroup::AddLines(const Point* points, size_t segmentCount, StyleId style, PrimitiveId* ids) {
+    for (size_t i = 0; i < segmentCount; ++i) {
+        const Point& p1 = points[i * 2];
+        const Point& p2 = points[i * 2 + 1];
+        PrimitiveId id = Allocate(PrimitiveKind::Line, style, Rect(p1.x, p1.y, p2.x - p1.x, p2.y - p1.y), 0);
+        if (ids) ids[i] = id;
+    }
+    NotifyChanged();
+}
+
+void DrawingGroup::Remove(PrimitiveId id) {
+    Remove(&id, 1);
+}
+
+void DrawingGroup::Remove(const PrimitiveId* ids, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        PrimitiveId id = ids[i];
+        if (!IsAlive(id)) continue;
+
+        if (m_flags[id] & Visible) AddDamage(m_bounds[id]);
+        if (m_kinds[id] == PrimitiveKind::Text) {
+            m_texts[m_resources[id]].clear();
+            m_freeTexts.push_back(m_resources[id]);
+        } else if (m_kinds[id] == PrimitiveKind::Bitmap) {
+            m_bitmaps[m_resources[id]].reset();
+            m_freeBitmaps.push_back(m_resources[id]);
+        }
+        if (!m_indexDirty) {
+            UnindexPrimitive(id);
+        }
+        m_flags[id] = 0;
+        m_freeIds.push_back(id);
+    }
+    NotifyChanged();
+}
+
+void DrawingGroup::Clear() {
+    if (!IsEmpty()) AddDamage(GetContentBounds());
+
+    m_kinds.clear();
+    m_flags.clear();
+    m_styleIds.clear();
+    m_geometry.clear();
+    m_bounds.clear();
+    m_params.clear();
+    m_resources.clear();
+    m_freeIds.clear();
+    m_texts.clear();
+    m_freeTexts.clear();
+    m_bitmaps.clear();
+    m_freeBitmaps.clear();
+    m_indexDirty = true;
+    NotifyChanged();
+}
+
+void DrawingGroup::Reserve(size_t count) {
+    m_kinds.reserve(count);
+    m_flags.reserve(count);
+    m_styleIds.reserve(count);
+    m_geometry.reserve(count);
+    m_bounds.reserve(count);
+    m_params.reserve(count);
+    m_resources.reserve(count);
+}
+
+// ==================== 修改 ====================
+
+void DrawingGroup::SetBounds(PrimitiveId id, const Rect& rect) {
+    SetBounds(&id, &rect, 1);
+}
+
+void DrawingGroup::SetBounds(const PrimitiveId* ids, const Rect* rects, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        if (!IsAlive(ids[i])) continue;
+        m_geometry[ids[i]] = rects[i];
+        UpdateBounds(ids[i]);
+    }
+    NotifyChanged();
+}
+
+void DrawingGroup::SetLine(PrimitiveId id, const Point& p1, const Point& p2) {
+    SetBounds(id, Rect(p1.x, p1.y, p2.x - p1.x, p2.y - p1.y));
+}
+
+void DrawingGroup::Offset(const PrimitiveId* ids, size_t count, float dx, float dy) {
+    for (size_t i = 0; i < count; ++i) {
+        if (!IsAlive(ids[i])) continue;
+        Rect& geometry = m_geometry[ids[i]];
+        geometry.x += dx;
+        geometry.y += dy;
+        // 平移不改变包围盒的大小，不必重新计算
+        const Rect& bounds = m_bounds[ids[i]];
+        UpdateBounds(ids[i], Rect(bounds.x + dx, bounds.y + dy, bounds.width, bounds.height));
+    }
+    NotifyChanged();
+}
+
+void DrawingGroup::SetStyle(PrimitiveId id, StyleId style) {
+    SetStyle(&id, 1, style);
+}
+
+void DrawingGroup::SetStyle(const PrimitiveId* ids, size_t count, StyleId style) {
+    for (size_t i = 0; i < count; ++i) {
+        if (!IsAlive(ids[i]) || m_styleIds[ids[i]] == style) continue;
+        m_styleIds[ids[i]] = style;
+        // 线宽可能变化，包围盒随之变化（旧包围盒同样计入损坏区域）
+        UpdateBounds(ids[i]);
+    }
+    NotifyChanged();
+}
+
+void DrawingGroup::SetVisible(PrimitiveId id, bool visible) {
+    if (!IsAlive(id) || ((m_flags[id] & Visible) != 0) == visible) return;
+    if (visible) {
+        m_flags[id] |= Visible;
+    } else {
+        m_flags[id] &= ~Visible;
+    }
+    AddDamage(m_bounds[id]);
+    NotifyChanged();
+}
+
+void DrawingGroup::SetText(PrimitiveId id, const std::wstring& text) {
+    if (!IsAlive(id) || m_kinds[id] != PrimitiveKind::Text) return;
+    m_texts[m_resources[id]] = text;
+    if (m_flags[id] & Visible) AddDamage(m_bounds[id]);
+    NotifyChanged();
+}
+
+void DrawingGroup::EndUpdate() {
+    if (m_updateDepth > 0 && --m_updateDepth == 0) {
+        NotifyChanged();
+    }
+}
+
+void DrawingGroup::UpdateBounds(PrimitiveId id, const Rect& bounds) {
+    const Rect previous = m_bounds[id];
+
+    if (m_flags[id] & Visible) {
+        AddDamage(previous);
+        AddDamage(bounds);
+    }
+
+    // 仍落在原来的单元中时只需更新超出标记，小幅移动不改动单元列表
+    if (!m_indexDirty &&
+        (CellX(previous.Left()) != CellX(bounds.Left()) || CellX(previous.Right()) != CellX(bounds.Right()) ||
+         CellY(previous.Top()) != CellY(bounds.Top()) || CellY(previous.Bottom()) != CellY(bounds.Bottom()) ||
+         ((m_flags[id] & Outside) != 0) != !InsideGrid(bounds))) {
+        UnindexPrimitive(id);
+        m_bounds[id] = bounds;
+        IndexPrimitive(id);
+        return;
+    }
+    m_bounds[id] = bounds;
+}
+
+void DrawingGroup::AddDamage(const Rect& rect) {
+    m_damage = m_hasDamage ? Union(m_damage, rect) : rect;
+    m_hasDamage = true;
+}
+
+void DrawingGroup::NotifyChanged() {
+    if (m_updateDepth > 0 || !m_hasDamage) return;
+
+    Rect damage = m_damage;
+    m_damage = Rect();
+    m_hasDamage = false;
+    if (m_changed) {
+        m_changed(damage);
+    }
+}
+
+// ==================== 查询 ====================
+
+bool DrawingGroup::IsAlive(PrimitiveId id) const {
+    return id < m_flags.size() && (m_flags[id] & Alive) != 0;
+}
+
+Rect DrawingGroup::ComputeBounds(PrimitiveId id) const {
+    const Rect& geometry = m_geometry[id];
+    if (m_kinds[id] == PrimitiveKind::Text || m_kinds[id] == PrimitiveKind::Bitmap) {
+        return geometry;
+    }
+
+    const Style& style = m_styles[m_styleIds[id]];
+    if (m_kinds[id] == PrimitiveKind::Line) {
+        float x1 = geometry.x, x2 = geometry.x + geometry.width;
+        float y1 = geometry.y, y2 = geometry.y + geometry.height;
+        Rect rect((std::min)(x1, x2), (std::min)(y1, y2), std::fabs(geometry.width), std::fabs(geometry.height));
+        return Inflate(rect, (std::max)(style.strokeThickness * 0.5f, kLineHitTolerance));
+    }
+    if (style.stroke.a > 0 && style.strokeThickness > 0) {
+        return Inflate(geometry, style.strokeThickness * 0.5f);
+    }
+    return geometry;
+}
+
+Rect DrawingGroup::GetContentBounds() const {
+    Rect result;
+    bool any = false;
+    for (size_t id = 0; id < m_flags.size(); ++id) {
+        if ((m_flags[id] & (Alive | Visible)) != (Alive | Visible)) continue;
+        result = any ? Union(result, m_bounds[id]) : m_bounds[id];
+        any = true;
+    }
+    return result;
+}
+
+bool DrawingGroup::HitPrimitive(PrimitiveId id, const Point& point) const {
+    const Rect& bounds = m_bounds[id];
+    if (!bounds.Contains(point)) return false;
+
+    switch (m_kinds[id]) {
+    case PrimitiveKind::Ellipse: {
+        float rx = bounds.width * 0.5f;
+        float ry = bounds.height * 0.5f;
+        if (rx <= 0 || ry <= 0) return false;
+        float nx = (point.x - (bounds.x + rx)) / rx;
+        float ny = (point.y - (bounds.y + ry)) / ry;
+        return nx * nx + ny * ny <= 1.0f;
+    }
+    case PrimitiveKind::Line: {
+        const Rect& line = m_geometry[id];
+        float tolerance = (std::max)(m_styles[m_styleIds[id]].strokeThickness * 0.5f, kLineHitTolerance);
+        float lengthSq = line.width * line.width + line.height * line.height;
+        float t = 0;
+        if (lengthSq > 0) {
+            t = ((point.x - line.x) * line.width + (point.y - line.y) * line.height) / lengthSq;
+            t = (std::min)((std::max)(t, 0.0f), 1.0f);
+        }
+        float dx = point.x - (line.x + t * line.width);
+        float dy = point.y - (line.y + t * line.height);
+        return dx * dx + dy * dy <= tolerance * tolerance;
+    }
+    default:
+        return true;
+    }
+}
+
+DrawingGroup::PrimitiveId DrawingGroup::HitTest(const Point& point) {
+    EnsureIndex();
+    if (m_cols == 0) return kInvalidId;
+
+    // 单元内的图元无序，取命中者中槽位最大（最上层）的一个
+    PrimitiveId result = kInvalidId;
+    for (PrimitiveId id : m_cells[static_cast<size_t>(CellY(point.y)) * m_cols + CellX(point.x)]) {
+        if (result != kInvalidId && id < result) continue;
+        if (!(m_flags[id] & Visible) || !HitPrimitive(id, point)) continue;
+        result = id;
+    }
+    return result;
+}
+
+void DrawingGroup::Query(const Rect& rect, std::vector<PrimitiveId>& result) {
+    EnsureIndex();
+    CollectCandidates(rect, m_candidates);
+    for (PrimitiveId id : m_candidates) {
+        if ((m_flags[id] & Visible) && m_bounds[id].Intersects(rect)) {
+            result.push_back(id);
+        }
+    }
+}
+
+// ==================== 空间索引 ====================
+
+void DrawingGroup::EnsureIndex() {
+    // 图元数成倍增长（单元过于拥挤）或大量图元移出网格范围时整体重建
+    const size_t count = GetCount();
+    if (m_indexDirty || count > m_indexedCount * 2 + 64 || m_outsideCount * 8 > count + 64) {
+        BuildIndex();
+        m_indexDirty = false;
+    }
+}
+
+void DrawingGroup::BuildIndex() {
+    m_cols = 0;
+    m_rows = 0;
+    m_extent = Rect();
+    m_outsideCount = 0;
+    m_indexedCount = 0;
+
+    for (size_t id = 0; id < m_flags.size(); ++id) {
+        if (!(m_flags[id] & Alive)) continue;
+        m_flags[id] &= ~Outside;
+        m_extent = m_indexedCount == 0 ? m_bounds[id] : Union(m_extent, m_bounds[id]);
+        ++m_indexedCount;
+    }
+    if (m_indexedCount == 0) {
+        m_cells.clear();
+        return;
+    }
+
+    // 单元大小按平均每单元约一个图元选取，并限制网格规模
+    float cellSize = std::sqrt(m_extent.width * m_extent.height / static_cast<float>(m_indexedCount));
+    cellSize = (std::max)(cellSize, m_extent.width / kMaxCells);
+    cellSize = (std::max)(cellSize, m_extent.height / kMaxCells);
+    m_cellSize = (std::min)((std::max)(cellSize, kMinCellSize), kMaxCellSize);
+    m_inverseCellSize = 1.0f / m_cellSize;
+
+    m_cols = (std::min)((std::max)(static_cast<int>(std::ceil(m_extent.width / m_cellSize)), 1), kMaxCells);
+    m_rows = (std::min)((std::max)(static_cast<int>(std::ceil(m_extent.height / m_cellSize)), 1), kMaxCells);
+
+    // 保留单元列表的容量，反复重建时不再分配
+    const size_t cellCount = static_cast<size_t>(m_cols) * m_rows;
+    if (m_cells.size() > cellCount) m_cells.resize(cellCount);
+    for (auto& cell : m_cells) cell.clear();
+    m_cells.resize(cellCount);
+
+    for (size_t id = 0; id < m_flags.size(); ++id) {
+        if (m_flags[id] & Alive) IndexPrimitive(static_cast<PrimitiveId>(id));
+    }
+}
+
+void DrawingGroup::IndexPrimitive(PrimitiveId id) {
+    if (m_cols == 0) {
+        // 网格为空（此前没有图元）：等下次查询时重建
+        m_indexDirty = true;
+        return;
+    }
+
+    const Rect& bounds = m_bounds[id];
+    if (!InsideGrid(bounds)) {
+        m_flags[id] |= Outside;
+        ++m_outsideCount;
+    }
+    int x0 = CellX(bounds.Left()), x1 = CellX(bounds.Right());
+    int y0 = CellY(bounds.Top()), y1 = CellY(bounds.Bottom());
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            m_cells[static_cast<size_t>(cy) * m_cols + cx].push_back(id);
+        }
+    }
+}
+
+void DrawingGroup::UnindexPrimitive(PrimitiveId id) {
+    if (m_cols == 0) return;
+
+    if (m_flags[id] & Outside) {
+        m_flags[id] &= ~Outside;
+        --m_outsideCount;
+    }
+    const Rect& bounds = m_bounds[id];
+    int x0 = CellX(bounds.Left()), x1 = CellX(bounds.Right());
+    int y0 = CellY(bounds.Top()), y1 = CellY(bounds.Bottom());
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            auto& cell = m_cells[static_cast<size_t>(cy) * m_cols + cx];
+            auto it = std::find(cell.begin(), cell.end(), id);
+            if (it != cell.end()) {
+                *it = cell.back();
+                cell.pop_back();
+            }
+        }
+    }
+}
+
+int DrawingGroup::CellX(float x) const {
+    int cell = static_cast<int>(std::floor((x - m_extent.x) * m_inverseCellSize));
+    return (std::min)((std::max)(cell, 0), m_cols - 1);
+}
+
+int DrawingGroup::CellY(float y) const {
+    int cell = static_cast<int>(std::floor((y - m_extent.y) * m_inverseCellSize));
+    return (std::min)((std::max)(cell, 0), m_rows - 1);
+}
+
+bool DrawingGroup::InsideGrid(const Rect& bounds) const {
+    return bounds.Left() >= m_extent.Left() && bounds.Right() <= m_extent.Right() &&
+           bounds.Top() >= m_extent.Top() && bounds.Bottom() <= m_extent.Bottom();
+}
+
+void DrawingGroup::CollectCandidates(const Rect& rect, std::vector<PrimitiveId>& result) {
+    result.clear();
+    if (m_cols == 0) return;
+    if (m_outsideCount == 0 && !rect.Intersects(m_extent)) return;
+
+    int x0 = CellX(rect.Left()), x1 = CellX(rect.Right());
+    int y0 = CellY(rect.Top()), y1 = CellY(rect.Bottom());
+
+    // 覆盖大半个网格时直接顺序扫描，比逐单元去重再排序更快
+    const size_t cells = static_cast<size_t>(x1 - x0 + 1) * (y1 - y0 + 1);
+    if (cells * 2 >= m_cells.size()) {
+        for (size_t id = 0; id < m_flags.size(); ++id) {
+            if (m_flags[id] & Alive) result.push_back(static_cast<PrimitiveId>(id));
+        }
+        return;
+    }
+
+    // 跨多个单元的图元只收集一次
+    if (m_visitMarks.size() < m_flags.size()) m_visitMarks.resize(m_flags.size(), 0);
+    if (++m_visitEpoch == 0) {
+        std::fill(m_visitMarks.begin(), m_visitMarks.end(), 0);
+        m_visitEpoch = 1;
+    }
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            for (PrimitiveId id : m_cells[static_cast<size_t>(cy) * m_cols + cx]) {
+                if (m_visitMarks[id] == m_visitEpoch) continue;
+                m_visitMarks[id] = m_visitEpoch;
+                result.push_back(id);
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+}
+
+// ==================== 绘制 ====================
+
+DrawingGroup::RenderStats DrawingGroup::Render(IRenderContext* context, const Rect& clip) {
+    RenderStats stats;
+    if (!context || IsEmpty()) return stats;
+    if (clip.IsEmpty()) {
+        stats.culled = GetCount();
+        return stats;
+    }
+
+    EnsureIndex();
+    CollectCandidates(clip, m_candidates);
+
+    // 每个样式的画刷在本次绘制中只创建一次
+    std::vector<ISolidColorBrushPtr> fillBrushes(m_styles.size());
+    std::vector<ISolidColorBrushPtr> strokeBrushes(m_styles.size());
+    auto fillBrush = [&](StyleId style) -> IBrush* {
+        if (m_styles[style].fill.a <= 0) return nullptr;
+        if (!fillBrushes[style]) fillBrushes[style] = context->CreateSolidColorBrush(m_styles[style].fill);
+        return fillBrushes[style].get();
+    };
+    auto strokeBrush = [&](StyleId style) -> IBrush* {
+        const Style& s = m_styles[style];
+        if (s.stroke.a <= 0 || s.strokeThickness <= 0) return nullptr;
+        if (!strokeBrushes[style]) strokeBrushes[style] = context->CreateSolidColorBrush(s.stroke);
+        return strokeBrushes[style].get();
+    };
+    std::vector<std::pair<float, ITextFormatPtr>> textFormats;
+    auto textFormat = [&](float fontSize) -> ITextFormat* {
+        for (auto& entry : textFormats) {
+            if (entry.first == fontSize) return entry.second.get();
+        }
+        textFormats.emplace_back(fontSize, context->CreateTextFormat(L"Microsoft YaHei", fontSize));
+        return textFormats.back().second.get();
+    };
+
+    // 连续的同样式纯填充矩形 / 直线合并为一次批量调用
+    enum class Batch { None, Rectangles, Lines };
+    Batch batch = Batch::None;
+    StyleId batchStyle = 0;
+    m_batchRects.clear();
+    m_batchPoints.clear();
+    auto flush = [&]() {
+        if (batch == Batch::Rectangles && !m_batchRects.empty()) {
+            if (auto* brush = fillBrush(batchStyle)) {
+                context->FillRectangles(m_batchRects.data(), m_batchRects.size(), brush);
+                ++stats.calls;
+            }
+        } else if (batch == Batch::Lines && !m_batchPoints.empty()) {
+            if (auto* brush = strokeBrush(batchStyle)) {
+                context->DrawLines(m_batchPoints.data(), m_batchPoints.size() / 2, brush,
+                                   m_styles[batchStyle].strokeThickness);
+                ++stats.calls;
+            }
+        }
+        m_batchRects.clear();
+        m_batchPoints.clear();
+        batch = Batch::None;
+    };
+    auto beginBatch = [&](Batch kind, StyleId style) {
+        if (batch != kind || batchStyle != style) {
+            flush();
+            batch = kind;
+            batchStyle = style;
+        }
+    };
+
+    for (PrimitiveId id : m_candidates) {
+        if (!(m_flags[id] & Visible) || !m_bounds[id].Intersects(clip)) continue;
+        ++stats.drawn;
+
+        const Rect& geometry = m_geometry[id];
+        const StyleId style = m_styleIds[id];
+        switch (m_kinds[id]) {
+        case PrimitiveKind::Rectangle:
+            if (!strokeBrush(style)) {
+                beginBatch(Batch::Rectangles, style);
+                m_batchRects.push_back(geometry);
+                break;
+            }
+            flush();
+            if (auto* brush = fillBrush(style)) {
+                context->FillRectangle(geometry, brush);
+                ++stats.calls;
+            }
+            context->DrawRectangle(geometry, strokeBrush(style), m_styles[style].strokeThickness);
+            ++stats.calls;
+            break;
+        case PrimitiveKind::Line:
+            beginBatch(Batch::Lines, style);
+            m_batchPoints.emplace_back(geometry.x, geometry.y);
+            m_batchPoints.emplace_back(geometry.x + geometry.width, geometry.y + geometry.height);
+            break;
+        case PrimitiveKind::RoundedRectangle: {
+            flush();
+            CornerRadius radius(m_params[id]);
+            if (auto* brush = fillBrush(style)) {
+                context->FillRoundedRectangle(geometry, radius, brush);
+                ++stats.calls;
+            }
+            if (auto* brush = strokeBrush(style)) {
+                context->DrawRoundedRectangle(geometry, radius, brush, m_styles[style].strokeThickness);
+                ++stats.calls;
+            }
+            break;
+        }
+        case PrimitiveKind::Ellipse: {
+            flush();
+            Point center(geometry.x + geometry.width * 0.5f, geometry.y + geometry.height * 0.5f);
+            float rx = geometry.width * 0.5f;
+            float ry = geometry.height * 0.5f;
+            if (auto* brush = fillBrush(style)) {
+                context->FillEllipse(center, rx, ry, brush);
+                ++stats.calls;
+            }
+            if (auto* brush = strokeBrush(style)) {
+                context->DrawEllipse(center, rx, ry, brush, m_styles[style].strokeThickness);
+                ++stats.calls;
+            }
+            break;
+        }
+        case PrimitiveKind::Text: {
+            flush();
+            auto* brush = fillBrush(style);
+            auto* format = textFormat(m_params[id]);
+            if (brush && format) {
+                context->DrawTextString(m_texts[m_resources[id]], format, geometry, brush);
+                ++stats.calls;
+            }
+            break;
+        }
+        case PrimitiveKind::Bitmap:
+            flush();
+            if (auto& bitmap = m_bitmaps[m_resources[id]]) {
+                context->DrawBitmap(bitmap.get(), geometry, m_params[id]);
+                ++stats.calls;
+            }
+            break;
+        }
+    }
+    flush();
+
+    stats.culled = GetCount() - stats.drawn;
+    return stats;
+}
+
+} // namespace rendering
+} // namespace luaui
@@ -0,0 +1,282 @@
+#pragma once
+
+#include "IRenderContext.h"
+#include "IBitmap.h"
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace luaui {
+namespace rendering {
+
+/**
+ * @brief 轻量绘图图元集合（保留模式）
+ *
+ * 图表、示意图这类由大量简单图形组成的内容，若每个图形都用一个 Rectangle/Ellipse 控件表示，
+ * 每个图元都要承担组件、事件、名称、父指针和主题订阅的开销。DrawingGroup 把图元保存在
+ * 按字段分组的连续数组中（类型、样式、几何、包围盒、标记），文本和位图放在旁路数组里，
+ * 样式（填充、描边、线宽）去重后按下标引用。
+ *
+ * - 图元 ID 即槽位下标，在删除前保持不变；删除后的槽位由后续新增的图元复用
+ * - 绘制顺序为槽位顺序（下标大者在上）：复用的槽位沿用被删除图元的层次
+ * - 自带均匀网格空间索引，绘制时只访问与裁剪区域相交的图元，命中测试只检查一个网格单元；
+ *   图元移动、增删时只更新涉及的单元，图元数量成倍增长或大量图元移出网格范围时才整体重建
+ * - 批量接口（数组形式的 Add/SetBounds/Offset/SetStyle，以及 BeginUpdate/EndUpdate）
+ *   一次调用只通知一次变化
+ * - 绘制时连续的同样式纯填充矩形合并为 FillRectangles，连续的同样式直线合并为 DrawLines
+ *
+ * 所有坐标都是宿主的本地坐标（见 controls::DrawingHost）。非线程安全，只在 UI 线程上使用。
+ */
+class DrawingGroup {
+public:
+    using PrimitiveId = uint32_t;
+    using StyleId = uint32_t;
+    static constexpr PrimitiveId kInvalidId = std::numeric_limits<uint32_t>::max();
+
+    // 网格参数（与控件空间索引相同的分桶方式，单元更小以适应小图元）
+    static constexpr float kMinCellSize = 16.0f;
+    static constexpr float kMaxCellSize = 512.0f;
+    static constexpr int kMaxCells = 256;   // 每个方向最多单元数
+
+    enum class PrimitiveKind : uint8_t {
+        Rectangle,
+        RoundedRectangle,
+        Ellipse,
+        Line,
+        Text,
+        Bitmap
+    };
+
+    /**
+     * @brief 图元样式
+     *
+     * 文本用 fill 作为文字颜色；位图不使用样式。线宽同时用于描边和直线。
+     */
+    struct Style {
+        Color fill = Color::Transparent();
+        Color stroke = Color::Transparent();
+        float strokeThickness = 1.0f;
+
+        bool operator==(const Style& other) const;
+        bool operator!=(const Style& other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief 一次 Render 的统计
+     */
+    struct RenderStats {
+        size_t drawn = 0;     // 实际绘制的图元数
+        size_t culled = 0;    // 未绘制的图元数（不在裁剪区域内或不可见）
+        size_t calls = 0;     // 发出的绘制调用数（批量命令计一次）
+    };
+
+    /**
+     * @brief 变化通知：参数为受影响的区域（旧包围盒 + 新包围盒的并集，本地坐标）
+     */
+    using ChangedHandler = std::function<void(const Rect& damage)>;
+
+    DrawingGroup();
+
+    DrawingGroup(const DrawingGroup&) = delete;
+    DrawingGroup& operator=(const DrawingGroup&) = delete;
+
+    // ========== 样式 ==========
+    /** @brief 注册样式，相同的样式返回同一下标 */
+    StyleId AddStyle(const Style& style);
+    StyleId AddFillStyle(const Color& fill) { Style style; style.fill = fill; return AddStyle(style); }
+    StyleId AddStrokeStyle(const Color& stroke, float thickness = 1.0f);
+    const Style& GetStyle(StyleId style) const { return m_styles[style]; }
+    size_t GetStyleCount() const { return m_styles.size(); }
+
+    // ========== 添加 ==========
+    PrimitiveId AddRectangle(const Rect& rect, StyleId style);
+    PrimitiveId AddRoundedRectangle(const Rect& rect, float radius, StyleId style);
+    PrimitiveId AddEllipse(const Rect& bounds, StyleId style);
+    PrimitiveId AddLine(const Point& p1, const Point& p2, StyleId style);
+    /** @brief 文本：在 rect 内按 fontSize 绘制，颜色取样式的 fill */
+    PrimitiveId AddText(const std::wstring& text, const Rect& rect, float fontSize, StyleId style);
+    /** @brief 位图：由图元持有引用 */
+    PrimitiveId AddBitmap(IBitmapPtr bitmap, const Rect& rect, float opacity = 1.0f);
+
+    /**
+     * @brief 批量添加同样式的矩形
+     * @param ids 可选输出，接收 count 个图元 ID
+     */
+    void AddRectangles(const Rect* rects, size_t count, StyleId style, PrimitiveId* ids = nullptr);
+
+    /**
+     * @brief 批量添加同样式的直线
+     * @param points 端点数组，每两个点构成一条线（共 segmentCount * 2 个点）
+     */
+    void AddLines(const Point* points, size_t segmentCount, StyleId style, PrimitiveId* ids = nullptr);
+
+    // ========== 删除 ==========
+    void Remove(PrimitiveId id);
+    void Remove(const PrimitiveId* ids, size_t count);
+    void Clear();
+
+    /** @brief 预留容量 */
+    void Reserve(size_t count);
+
+    // ========== 修改 ==========
+    /**
+     * @brief 设置几何位置
+     *
+     * 矩形/椭圆/文本/位图为目标矩形；直线为 (x1, y1) 到 (x1 + width, y1 + height)。
+     */
+    void SetBounds(PrimitiveId id, const Rect& rect);
+    void SetBounds(const PrimitiveId* ids, const Rect* rects, size_t count);
+    void SetLine(PrimitiveId id, const Point& p1, const Point& p2);
+
+    /** @brief 批量平移 */
+    void Offset(const PrimitiveId* ids, size_t count, float dx, float dy);
+
+    void SetStyle(PrimitiveId id, StyleId style);
+    void SetStyle(const PrimitiveId* ids, size_t count, StyleId style);
+
+    void SetVisible(PrimitiveId id, bool visible);
+    void SetText(PrimitiveId id, const std::wstring& text);
+
+    /**
+     * @brief 开始批量修改：EndUpdate 之前的变化合并，只在最外层 EndUpdate 时通知一次
+     */
+    void BeginUpdate() { ++m_updateDepth; }
+    void EndUpdate();
+
+    /**
+     * @brief 批量修改范围
+     */
+    class UpdateScope {
+    public:
+        explicit UpdateScope(DrawingGroup& group) : m_group(group) { m_group.BeginUpdate(); }
+        ~UpdateScope() { m_group.EndUpdate(); }
+        UpdateScope(const UpdateScope&) = delete;
+        UpdateScope& operator=(const UpdateScope&) = delete;
+    private:
+        DrawingGroup& m_group;
+    };
+
+    void SetChangedHandler(ChangedHandler handler) { m_changed = std::move(handler); }
+
+    // ========== 查询 ==========
+    bool IsAlive(PrimitiveId id) const;
+    PrimitiveKind GetKind(PrimitiveId id) const { return m_kinds[id]; }
+    StyleId GetStyleId(PrimitiveId id) const { return m_styleIds[id]; }
+    /** @brief 几何位置（语义见 SetBounds） */
+    const Rect& GetGeometry(PrimitiveId id) const { return m_geometry[id]; }
+    /** @brief 包围盒（含描边，直线另含命中容差），用于裁剪与索引 */
+    const Rect& GetBounds(PrimitiveId id) const { return m_bounds[id]; }
+    bool GetVisible(PrimitiveId id) const { return IsAlive(id) && (m_flags[id] & Visible) != 0; }
+
+    /** @brief 存活的图元数 */
+    size_t GetCount() const { return m_kinds.size() - m_freeIds.size(); }
+    bool IsEmpty() const { return GetCount() == 0; }
+
+    /** @brief 所有可见图元包围盒的并集 */
+    Rect GetContentBounds() const;
+
+    /**
+     * @brief 查找包含指定点的最上层可见图元
+     *
+     * 椭圆按椭圆区域、直线按到线段的距离（半线宽，至少 2 像素）判断，其余按包围盒。
+     * @return 图元 ID，未命中返回 kInvalidId
+     */
+    PrimitiveId HitTest(const Point& point);
+
+    /**
+     * @brief 查找包围盒与 rect 相交的可见图元，按绘制顺序追加到 result
+     */
+    void Query(const Rect& rect, std::vector<PrimitiveId>& result);
+
+    // ========== 绘制 ==========
+    /**
+     * @brief 绘制与 clip 相交的可见图元
+     * @param clip 本地坐标中的裁剪区域，为空时不绘制任何内容
+     */
+    RenderStats Render(IRenderContext* context, const Rect& clip);
+
+private:
+    enum Flags : uint8_t {
+        Alive = 1 << 0,
+        Visible = 1 << 1,
+        Outside = 1 << 2,   // 包围盒超出网格范围（存放在边缘单元中）
+    };
+
+    struct StyleHash {
+        size_t operator()(const Style& style) const;
+    };
+
+    PrimitiveId Allocate(PrimitiveKind kind, StyleId style, const Rect& geometry, float param);
+    Rect ComputeBounds(PrimitiveId id) const;
+    bool HitPrimitive(PrimitiveId id, const Point& point) const;
+
+    // 修改图元后更新包围盒，并把图元移到新的网格单元
+    void UpdateBounds(PrimitiveId id) { UpdateBounds(id, ComputeBounds(id)); }
+    void UpdateBounds(PrimitiveId id, const Rect& bounds);
+    void AddDamage(const Rect& rect);
+    void NotifyChanged();
+
+    // 按需重建网格
+    void EnsureIndex();
+    void BuildIndex();
+    // 把图元加入 / 移出其包围盒覆盖的单元（网格已建立时）
+    void IndexPrimitive(PrimitiveId id);
+    void UnindexPrimitive(PrimitiveId id);
+    int CellX(float x) const;
+    int CellY(float y) const;
+    // 包围盒是否完全落在网格范围内（落在外面的部分被钳到边缘单元）
+    bool InsideGrid(const Rect& bounds) const;
+    // 收集与 rect 相交的单元中的图元，去重后按绘制顺序排列
+    void CollectCandidates(const Rect& rect, std::vector<PrimitiveId>& result);
+
+    // 图元字段（按槽位下标）
+    std::vector<PrimitiveKind> m_kinds;
+    std::vector<uint8_t> m_flags;
+    std::vector<StyleId> m_styleIds;
+    std::vector<Rect> m_geometry;
+    std::vector<Rect> m_bounds;
+    std::vector<float> m_params;        // 圆角半径 / 字号 / 位图不透明度
+    std::vector<uint32_t> m_resources;  // 文本、位图在旁路数组中的下标
+    std::vector<PrimitiveId> m_freeIds;
+
+    // 旁路数组（下标由 m_resources 引用，删除的位置复用）
+    std::vector<std::wstring> m_texts;
+    std::vector<uint32_t> m_freeTexts;
+    std::vector<IBitmapPtr> m_bitmaps;
+    std::vector<uint32_t> m_freeBitmaps;
+
+    std::vector<Style> m_styles;
+    std::unordered_map<Style, StyleId, StyleHash> m_styleLookup;
+
+    // 网格：每个单元一个图元列表（无序），单元为 y * m_cols + x
+    std::vector<std::vector<PrimitiveId>> m_cells;
+    Rect m_extent;
+    float m_cellSize = kMinCellSize;
+    float m_inverseCellSize = 1.0f / kMinCellSize;
+    int m_cols = 0;
+    int m_rows = 0;
+    bool m_indexDirty = true;
+    size_t m_indexedCount = 0;    // 上次重建时的图元数
+    size_t m_outsideCount = 0;    // 带 Outside 标记的图元数
+
+    // 查询去重用的访问标记
+    std::vector<uint32_t> m_visitMarks;
+    uint32_t m_visitEpoch = 0;
+    std::vector<PrimitiveId> m_candidates;
+
+    // 绘制时合并的批量命令
+    std::vector<Rect> m_batchRects;
+    std::vector<Point> m_batchPoints;
+
+    // 变化通知
+    ChangedHandler m_changed;
+    Rect m_damage;
+    bool m_hasDamage = false;
+    int m_updateDepth = 0;
+};
+
+} // namespace rendering
+} // namespace luaui
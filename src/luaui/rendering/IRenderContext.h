@@ -11,6 +11,8 @@
 namespace luaui {
 namespace rendering {
 
+class ResourceInterner;
+
 // Rendering state
 struct RenderState {
     Transform transform;
@@ -63,6 +65,19 @@ public:
                                const StrokeStyle* strokeStyle = nullptr) = 0;
     virtual void FillRectangle(const Rect& rect, IBrush* brush) = 0;
     
+    // Bulk primitives: many shapes sharing one brush (gridlines, row backgrounds, separators).
+    // Backends override these to resolve the brush once; the defaults just loop.
+    virtual void FillRectangles(const Rect* rects, size_t count, IBrush* brush) {
+        for (size_t i = 0; i < count; ++i) FillRectangle(rects[i], brush);
+    }
+    // Segments are (points[0], points[1]), (points[2], points[3]), ...; segmentCount = pairs
+    virtual void DrawLines(const Point* points, size_t segmentCount, IBrush* brush, float strokeWidth = 1.0f,
+                           const StrokeStyle* strokeStyle = nullptr) {
+        for (size_t i = 0; i < segmentCount; ++i) {
+            DrawLine(points[i * 2], points[i * 2 + 1], brush, strokeWidth, strokeStyle);
+        }
+    }
+    
     // Rounded rectangles
     virtual void DrawRoundedRectangle(const Rect& rect, const CornerRadius& radius, IBrush* brush,
                                       float strokeWidth = 1.0f, const StrokeStyle* strokeStyle = nullptr) = 0;
@@ -127,6 +142,9 @@ public:
     virtual IBitmapPtr CreateBitmap(int width, int height, PixelFormat format) = 0;
     virtual IBitmapPtr LoadBitmapFromFile(const std::wstring& filePath) = 0;
     virtual IBitmapPtr LoadBitmapFromMemory(const void* data, size_t size) = 0;
+    
+    // Value-interning cache behind the brush/text format factories (nullptr if the backend has none)
+    virtual ResourceInterner* GetResourceInterner() { return nullptr; }
 };
 
 using IRenderContextPtr = std::shared_ptr<IRenderContext>;
@@ -36,6 +36,12 @@ struct FrameStats {
     float frameTime = 0;        // milliseconds
     float cpuTime = 0;          // milliseconds
     float gpuTime = 0;          // milliseconds (if available)
+    int controlsDrawn = 0;      // controls rendered (filled in by the window)
+    int controlsCulled = 0;     // subtrees skipped by clip-bounds culling
+    int dirtyRectCount = 0;     // dirty rects repainted (0 when the frame had no damage)
+    float layoutTime = 0;       // milliseconds (filled in by the window while profiling)
+    float renderTime = 0;       // milliseconds, tree traversal + draw submission
+    float presentTime = 0;      // milliseconds
 };
 
 // Render target type
@@ -122,5 +128,8 @@ using IRenderEnginePtr = std::unique_ptr<IRenderEngine>;
 // Factory function
 IRenderEnginePtr CreateRenderEngine();
 
+// Headless CPU renderer (no window or GPU required)
+IRenderEnginePtr CreateSoftwareRenderEngine();
+
 } // namespace rendering
 } // namespace luaui
@@ -1,4 +1,6 @@
 #include "ResourceCache.h"
+#include <algorithm>
+#include <vector>
 
 namespace luaui {
 namespace rendering {
@@ -12,45 +14,60 @@ ResourceCache::~ResourceCache() {
 }
 
 ISolidColorBrush* ResourceCache::GetSolidColorBrush(const Color& color) {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     if (!m_context) return nullptr;
     
     uint32_t hash = ColorToHash(color);
     
     auto it = m_brushCache.find(hash);
     if (it != m_brushCache.end()) {
-        return it->second.get();
+        ++m_hits;
+        it->second.lastUsedFrame = m_frame;
+        return it->second.resource.get();
     }
     
     // 创建新画刷并缓存
+    ++m_misses;
     auto brush = m_context->CreateSolidColorBrush(color);
     if (!brush) return nullptr;
     
     ISolidColorBrush* ptr = brush.get();
-    m_brushCache[hash] = std::move(brush);
+    m_brushCache[hash] = Entry<ISolidColorBrush>{std::move(brush), kSolidBrushBytes, m_frame};
+    m_bytes += kSolidBrushBytes;
     return ptr;
 }
 
 void ResourceCache::ClearBrushes() {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    for (const auto& pair : m_brushCache) {
+        m_bytes -= pair.second.bytes;
+    }
     m_brushCache.clear();
 }
 
 ITextFormat* ResourceCache::GetTextFormat(const std::wstring& fontFamily, 
                                            float fontSize) {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     if (!m_context) return nullptr;
     
     TextFormatKey key{fontFamily, fontSize};
     
     auto it = m_textFormatCache.find(key);
     if (it != m_textFormatCache.end()) {
-        return it->second.get();
+        ++m_hits;
+        it->second.lastUsedFrame = m_frame;
+        return it->second.resource.get();
     }
     
     // 创建新文本格式并缓存
+    ++m_misses;
     auto format = m_context->CreateTextFormat(fontFamily, fontSize);
     if (!format) return nullptr;
     
     ITextFormat* ptr = format.get();
-    m_textFormatCache[key] = std::move(format);
+    size_t bytes = kTextFormatBytes + fontFamily.size() * sizeof(wchar_t);
+    m_textFormatCache[std::move(key)] = Entry<ITextFormat>{std::move(format), bytes, m_frame};
+    m_bytes += bytes;
     return ptr;
 }
 
@@ -60,6 +77,10 @@ ITextFormat* ResourceCache::GetDefaultTextFormat() {
 }
 
 void ResourceCache::ClearTextFormats() {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    for (const auto& pair : m_textFormatCache) {
+        m_bytes -= pair.second.bytes;
+    }
     m_textFormatCache.clear();
 }
 
@@ -68,6 +89,113 @@ void ResourceCache::ClearAll() {
     ClearTextFormats();
 }
 
+// ============================================================================
+// 淘汰
+// ============================================================================
+
+void ResourceCache::SetByteBudget(size_t bytes) {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    m_byteBudget = bytes;
+    if (m_bytes > m_byteBudget) {
+        Trim();
+    }
+}
+
+void ResourceCache::EndFrame() {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    ++m_frame;
+    if (m_bytes > m_byteBudget || m_frame - m_lastSweepFrame >= kSweepInterval) {
+        Trim();
+    }
+}
+
+size_t ResourceCache::Trim() {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    m_lastSweepFrame = m_frame;
+    size_t evicted = 0;
+
+    // 1. 空闲太久的条目
+    if (m_maxIdleFrames > 0 && m_frame > m_maxIdleFrames) {
+        evicted += EvictThrough(m_frame - m_maxIdleFrames - 1);
+    }
+
+    // 2. 超出预算：从最旧的一代开始整代淘汰
+    uint64_t cutoff = 0;
+    if (m_bytes > m_byteBudget && FindBudgetCutoff(cutoff)) {
+        evicted += EvictThrough(cutoff);
+    }
+    return evicted;
+}
+
+bool ResourceCache::FindBudgetCutoff(uint64_t& cutoff) const {
+    // 当前帧用过的条目不参与淘汰（返回的裸指针在本帧内仍可能被使用）
+    std::vector<std::pair<uint64_t, size_t>> generations;
+    generations.reserve(m_brushCache.size() + m_textFormatCache.size());
+    for (const auto& pair : m_brushCache) {
+        if (pair.second.lastUsedFrame < m_frame) {
+            generations.emplace_back(pair.second.lastUsedFrame, pair.second.bytes);
+        }
+    }
+    for (const auto& pair : m_textFormatCache) {
+        if (pair.second.lastUsedFrame < m_frame) {
+            generations.emplace_back(pair.second.lastUsedFrame, pair.second.bytes);
+        }
+    }
+    if (generations.empty()) return false;
+
+    std::sort(generations.begin(), generations.end());
+    size_t remaining = m_bytes;
+    for (size_t i = 0; i < generations.size(); ++i) {
+        remaining -= generations[i].second;
+        // 同一代的条目一起释放
+        bool generationEnds = i + 1 == generations.size() || generations[i + 1].first != generations[i].first;
+        if (generationEnds && remaining <= m_byteBudget) {
+            cutoff = generations[i].first;
+            return true;
+        }
+    }
+    cutoff = generations.back().first;
+    return true;
+}
+
+size_t ResourceCache::EvictThrough(uint64_t cutoff) {
+    size_t evicted = 0;
+    auto evict = [&](auto& cache) {
+        for (auto it = cache.begin(); it != cache.end();) {
+            if (it->second.lastUsedFrame <= cutoff && it->second.lastUsedFrame < m_frame) {
+                m_bytes -= it->second.bytes;
+                it = cache.erase(it);
+                ++evicted;
+            } else {
+                ++it;
+            }
+        }
+    };
+    evict(m_brushCache);
+    evict(m_textFormatCache);
+    m_evictions += evicted;
+    return evicted;
+}
+
+void ResourceCache::ResetStats() {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    m_hits = m_misses = m_evictions = 0;
+}
+
+ResourceCache::Stats ResourceCache::GetStats() const {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    Stats stats;
+    stats.brushCount = m_brushCache.size();
+    stats.textFormatCount = m_textFormatCache.size();
+    stats.bytes = m_bytes;
+    stats.byteBudget = m_byteBudget;
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    stats.evictions = m_evictions;
+    stats.frame = m_frame;
+    return stats;
+}
+
 uint32_t ResourceCache::ColorToHash(const Color& color) {
     // 将颜色打包为 32 位哈希值 (ARGB)
     uint32_t r = static_cast<uint32_t>(color.r * 255.0f + 0.5f) & 0xFF;
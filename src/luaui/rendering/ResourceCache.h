@@ -2,7 +2,9 @@
 
 #include "IRenderContext.h"
 #include "Types.h"
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <string>
 
@@ -13,6 +15,10 @@ namespace rendering {
  * @brief 资源缓存池
  * 
  * 缓存渲染资源（画刷、文本格式等）以避免重复创建，提升性能
+ *
+ * 每个条目记录估算字节数和最后使用的帧号。EndFrame 推进帧号并按代淘汰：
+ * 超过空闲帧数的条目被释放；总字节数超出预算时，从最久未用的一代开始整代释放，
+ * 直到回到预算以内。当前帧用过的条目不会被淘汰，因此 Get* 返回的指针在本帧内始终有效。
  * 
  * 使用示例：
  *   ResourceCache cache(context);
@@ -22,17 +28,40 @@ namespace rendering {
  */
 class ResourceCache {
 public:
+    static constexpr size_t kDefaultByteBudget = 4 * 1024 * 1024;
+    static constexpr uint32_t kDefaultMaxIdleFrames = 600;   // 60Hz 下约 10 秒
+    static constexpr uint32_t kSweepInterval = 60;           // 空闲条目的扫描间隔（帧）
+
+    // 条目大小估算（包装对象 + 原生对象 + 哈希表节点）
+    static constexpr size_t kSolidBrushBytes = 256;
+    static constexpr size_t kTextFormatBytes = 2048;
+
+    /**
+     * @brief 缓存统计
+     */
+    struct Stats {
+        size_t brushCount = 0;
+        size_t textFormatCount = 0;
+        size_t bytes = 0;           // 当前估算字节数
+        size_t byteBudget = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;     // 累计淘汰条目数
+        uint64_t frame = 0;
+
+        double GetHitRate() const {
+            uint64_t total = hits + misses;
+            return total ? static_cast<double>(hits) / total : 0.0;
+        }
+    };
+
     explicit ResourceCache(IRenderContext* context);
     ~ResourceCache();
 
-    // 禁止拷贝
+    // 禁止拷贝和移动（内部互斥锁）
     ResourceCache(const ResourceCache&) = delete;
     ResourceCache& operator=(const ResourceCache&) = delete;
 
-    // 允许移动
-    ResourceCache(ResourceCache&&) = default;
-    ResourceCache& operator=(ResourceCache&&) = default;
-
     // ========== 画刷缓存 ==========
     
     /**
@@ -75,16 +104,59 @@ public:
      */
     void ClearAll();
 
+    // ========== 淘汰 ==========
+
+    /**
+     * @brief 设置字节预算（超出时立即淘汰）
+     */
+    void SetByteBudget(size_t bytes);
+    size_t GetByteBudget() const { return m_byteBudget; }
+
+    /**
+     * @brief 设置空闲帧数上限（0 表示不按空闲时间淘汰）
+     */
+    void SetMaxIdleFrames(uint32_t frames) { m_maxIdleFrames = frames; }
+    uint32_t GetMaxIdleFrames() const { return m_maxIdleFrames; }
+
+    /**
+     * @brief 结束一帧：推进帧号，超出预算或到达扫描间隔时淘汰
+     */
+    void EndFrame();
+
+    /**
+     * @brief 立即淘汰空闲条目并回到预算以内
+     * @return 淘汰的条目数
+     */
+    size_t Trim();
+
     // ========== 统计信息 ==========
     
     size_t GetBrushCacheSize() const { return m_brushCache.size(); }
     size_t GetTextFormatCacheSize() const { return m_textFormatCache.size(); }
+    size_t GetByteSize() const { return m_bytes; }
+    uint64_t GetFrame() const { return m_frame; }
+
+    Stats GetStats() const;
+    void ResetStats();
 
 private:
+    template <typename T>
+    struct Entry {
+        std::shared_ptr<T> resource;
+        size_t bytes = 0;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    // 淘汰最后使用帧号不大于 cutoff 的条目
+    size_t EvictThrough(uint64_t cutoff);
+    // 满足预算需要淘汰到的代（没有可淘汰条目时返回 false）
+    bool FindBudgetCutoff(uint64_t& cutoff) const;
+
     IRenderContext* m_context;
+    mutable std::recursive_mutex m_mutex;   // Trim 等方法之间会相互调用
     
     // 画刷缓存：颜色哈希 -> 画刷
-    std::unordered_map<uint32_t, ISolidColorBrushPtr> m_brushCache;
+    std::unordered_map<uint32_t, Entry<ISolidColorBrush>> m_brushCache;
     
     // 文本格式缓存：(字体, 大小) -> 文本格式
     struct TextFormatKey {
@@ -105,7 +177,17 @@ private:
         }
     };
     
-    std::unordered_map<TextFormatKey, ITextFormatPtr, TextFormatKeyHash> m_textFormatCache;
+    std::unordered_map<TextFormatKey, Entry<ITextFormat>, TextFormatKeyHash> m_textFormatCache;
+
+    size_t m_bytes = 0;
+    size_t m_byteBudget = kDefaultByteBudget;
+    uint32_t m_maxIdleFrames = kDefaultMaxIdleFrames;
+    uint64_t m_frame = 0;
+    uint64_t m_lastSweepFrame = 0;
+
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
     
     // 颜色转哈希
     static uint32_t ColorToHash(const Color& color);
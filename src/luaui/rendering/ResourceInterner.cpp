@@ -0,0 +1,120 @@
+#include "ResourceInterner.h"
+#include <cstring>
+#include <functional>
+
+namespace luaui {
+namespace rendering {
+
+namespace {
+
+// 按位哈希 float（-0 与 +0 视为不同键，只影响命中率）
+inline void HashCombine(size_t& seed, size_t value) {
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+inline size_t HashFloat(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return std::hash<uint32_t>()(bits);
+}
+
+} // anonymous namespace
+
+ResourceInterner::ResourceInterner() {
+    m_brushes.SetCapacity(kDefaultBrushCapacity);
+    m_textFormats.SetCapacity(kDefaultTextFormatCapacity);
+}
+
+void ResourceInterner::SetCapacity(size_t brushes, size_t textFormats) {
+    m_brushes.SetCapacity(brushes);
+    m_textFormats.SetCapacity(textFormats);
+    m_stats.evictions += m_brushes.Trim();
+    m_stats.evictions += m_textFormats.Trim();
+}
+
+void ResourceInterner::Clear() {
+    m_brushes.Clear();
+    m_textFormats.Clear();
+}
+
+// ============================================================================
+// 键
+// ============================================================================
+
+bool ResourceInterner::BrushKey::operator==(const BrushKey& other) const {
+    return type == other.type &&
+           std::memcmp(params, other.params, sizeof(params)) == 0 &&
+           colors.size() == other.colors.size() &&
+           (colors.empty() || std::memcmp(colors.data(), other.colors.data(), colors.size() * sizeof(float)) == 0);
+}
+
+size_t ResourceInterner::BrushKeyHash::operator()(const BrushKey& key) const {
+    size_t seed = static_cast<size_t>(key.type);
+    for (float p : key.params) HashCombine(seed, HashFloat(p));
+    for (float c : key.colors) HashCombine(seed, HashFloat(c));
+    return seed;
+}
+
+size_t ResourceInterner::TextFormatKeyHash::operator()(const TextFormatKey& key) const {
+    size_t seed = std::hash<std::wstring>()(key.fontFamily);
+    HashCombine(seed, HashFloat(key.fontSize));
+    return seed;
+}
+
+ResourceInterner::BrushKey ResourceInterner::MakeSolidKey(const Color& color) {
+    BrushKey key;
+    key.type = BrushType::Solid;
+    key.colors = { color.r, color.g, color.b, color.a };
+    return key;
+}
+
+ResourceInterner::BrushKey ResourceInterner::MakeGradientKey(BrushType type, float p0, float p1, float p2, float p3,
+                                                            const std::vector<GradientStop>& stops) {
+    BrushKey key;
+    key.type = type;
+    key.params[0] = p0;
+    key.params[1] = p1;
+    key.params[2] = p2;
+    key.params[3] = p3;
+    key.colors.reserve(stops.size() * 5);
+    for (const auto& stop : stops) {
+        key.colors.insert(key.colors.end(),
+                          { stop.position, stop.color.r, stop.color.g, stop.color.b, stop.color.a });
+    }
+    return key;
+}
+
+// ============================================================================
+// 文本格式状态
+// ============================================================================
+
+ResourceInterner::TextFormatState ResourceInterner::TextFormatState::Capture(const ITextFormat& format) {
+    TextFormatState state;
+    state.weight = format.GetFontWeight();
+    state.style = format.GetFontStyle();
+    state.textAlignment = format.GetTextAlignment();
+    state.paragraphAlignment = format.GetParagraphAlignment();
+    state.wordWrapping = format.GetWordWrapping();
+    state.trimming = format.GetTextTrimming();
+    state.lineHeight = format.GetLineHeight();
+    state.baseline = format.GetBaseline();
+    return state;
+}
+
+void ResourceInterner::TextFormatState::Restore(ITextFormat& format, const TextFormatKey& key) const {
+    // 先比较再设置：部分后端修改字体属性需要重建原生对象
+    if (format.GetFontFamily() != key.fontFamily) format.SetFontFamily(key.fontFamily);
+    if (format.GetFontSize() != key.fontSize) format.SetFontSize(key.fontSize);
+    if (format.GetFontWeight() != weight) format.SetFontWeight(weight);
+    if (format.GetFontStyle() != style) format.SetFontStyle(style);
+    if (format.GetTextAlignment() != textAlignment) format.SetTextAlignment(textAlignment);
+    if (format.GetParagraphAlignment() != paragraphAlignment) format.SetParagraphAlignment(paragraphAlignment);
+    if (format.GetWordWrapping() != wordWrapping) format.SetWordWrapping(wordWrapping);
+    if (format.GetTextTrimming() != trimming) format.SetTextTrimming(trimming);
+    if (format.GetLineHeight() != lineHeight || format.GetBaseline() != baseline) {
+        format.SetLineSpacing(lineHeight, baseline);
+    }
+}
+
+} // namespace rendering
+} // namespace luaui
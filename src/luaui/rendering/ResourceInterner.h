@@ -0,0 +1,304 @@
+#pragma once
+
+#include "IBrush.h"
+#include "ITextFormat.h"
+#include "Types.h"
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace luaui {
+namespace rendering {
+
+/**
+ * @brief 渲染上下文内的画刷/文本格式驻留表
+ *
+ * 控件在 OnRender 中按值创建画刷和文本格式（每帧、每个单元格一次）。后端上下文的
+ * Create* 方法先在驻留表中按值（颜色、渐变几何与色标、字体与字号）查找空闲实例，
+ * 命中时直接复用，未命中才真正创建。
+ *
+ * 返回的对象是可变的（SetColor、SetTextAlignment 等），因此只复用"空闲"实例：
+ * 除驻留表外没有其他引用（use_count == 1）。交出前会把调用方可能修改过的属性
+ * 还原为创建时的状态，调用方看到的与新建对象一致。
+ * 渐变色标无法读取，不做还原；修改色标的调用方应自行持有画刷。
+ *
+ * 容量按实例数计，以键为单位做 LRU 淘汰；淘汰只释放驻留表的引用，
+ * 正在使用的实例不受影响。同一个键最多保留 kMaxPerKey 个实例。
+ */
+class ResourceInterner {
+public:
+    static constexpr size_t kDefaultBrushCapacity = 256;
+    static constexpr size_t kDefaultTextFormatCapacity = 64;
+    static constexpr size_t kMaxPerKey = 4;
+
+    /**
+     * @brief 命中统计
+     */
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    ResourceInterner();
+    ResourceInterner(const ResourceInterner&) = delete;
+    ResourceInterner& operator=(const ResourceInterner&) = delete;
+
+    // ========== 查找或创建 ==========
+    template <typename Create>
+    ISolidColorBrushPtr AcquireSolidColorBrush(const Color& color, Create&& create);
+
+    template <typename Create>
+    ILinearGradientBrushPtr AcquireLinearGradientBrush(const Point& start, const Point& end,
+                                                       const std::vector<GradientStop>& stops, Create&& create);
+
+    template <typename Create>
+    IRadialGradientBrushPtr AcquireRadialGradientBrush(const Point& center, float radiusX, float radiusY,
+                                                       const std::vector<GradientStop>& stops, Create&& create);
+
+    template <typename Create>
+    ITextFormatPtr AcquireTextFormat(const std::wstring& fontFamily, float fontSize, Create&& create);
+
+    // ========== 配置与统计 ==========
+    /**
+     * @brief 设置容量（实例数），超出部分立即淘汰
+     */
+    void SetCapacity(size_t brushes, size_t textFormats);
+
+    /**
+     * @brief 释放所有驻留实例（设备或渲染目标重建时调用）
+     */
+    void Clear();
+
+    size_t GetBrushCount() const { return m_brushes.GetSize(); }
+    size_t GetTextFormatCount() const { return m_textFormats.GetSize(); }
+
+    const Stats& GetStats() const { return m_stats; }
+    void ResetStats() { m_stats = Stats(); }
+
+private:
+    // 画刷键：类型 + 几何参数 + 颜色/色标（按位比较）
+    struct BrushKey {
+        BrushType type = BrushType::Solid;
+        float params[4] = {};
+        std::vector<float> colors;   // 纯色为 4 个分量，渐变为每个色标 5 个分量
+
+        bool operator==(const BrushKey& other) const;
+    };
+    struct BrushKeyHash {
+        size_t operator()(const BrushKey& key) const;
+    };
+
+    struct TextFormatKey {
+        std::wstring fontFamily;
+        float fontSize = 0;
+
+        bool operator==(const TextFormatKey& other) const {
+            return fontSize == other.fontSize && fontFamily == other.fontFamily;
+        }
+    };
+    struct TextFormatKeyHash {
+        size_t operator()(const TextFormatKey& key) const;
+    };
+
+    // 文本格式创建时的可变状态，交出前还原
+    struct TextFormatState {
+        FontWeight weight = FontWeight::Regular;
+        FontStyle style = FontStyle::Normal;
+        TextAlignment textAlignment = TextAlignment::Leading;
+        ParagraphAlignment paragraphAlignment = ParagraphAlignment::Near;
+        WordWrapping wordWrapping = WordWrapping::Wrap;
+        TextTrimming trimming = TextTrimming::None;
+        float lineHeight = 0;
+        float baseline = 0;
+
+        static TextFormatState Capture(const ITextFormat& format);
+        void Restore(ITextFormat& format, const TextFormatKey& key) const;
+    };
+
+    /**
+     * @brief 按键分桶、以桶为单位 LRU 的实例池
+     */
+    template <typename Key, typename Hash, typename Value, typename Extra>
+    class Pool {
+    public:
+        struct Item {
+            std::shared_ptr<Value> value;
+            Extra extra;
+        };
+
+        // 查找空闲实例；未找到时返回 nullptr
+        Item* FindFree(const Key& key);
+
+        // 加入新实例，返回淘汰的实例数
+        size_t Insert(const Key& key, std::shared_ptr<Value> value, Extra extra);
+
+        // 淘汰到不超过容量
+        size_t Trim();
+
+        void SetCapacity(size_t capacity) { m_capacity = capacity; }
+        size_t GetSize() const { return m_size; }
+        void Clear() { m_buckets.clear(); m_lru.clear(); m_size = 0; }
+
+    private:
+        struct Bucket {
+            std::vector<Item> items;   // 按最近使用排序，末尾最新
+            typename std::list<Key>::iterator lru;
+        };
+
+        std::unordered_map<Key, Bucket, Hash> m_buckets;
+        std::list<Key> m_lru;   // 前端最近使用
+        size_t m_size = 0;
+        size_t m_capacity = 0;
+    };
+
+    struct NoExtra {};
+
+    static BrushKey MakeSolidKey(const Color& color);
+    static BrushKey MakeGradientKey(BrushType type, float p0, float p1, float p2, float p3,
+                                    const std::vector<GradientStop>& stops);
+
+    template <typename Ptr, typename Reset, typename Create>
+    Ptr AcquireBrush(const BrushKey& key, Reset&& reset, Create&& create);
+
+    Pool<BrushKey, BrushKeyHash, IBrush, NoExtra> m_brushes;
+    Pool<TextFormatKey, TextFormatKeyHash, ITextFormat, TextFormatState> m_textFormats;
+    Stats m_stats;
+};
+
+// ============================================================================
+// 模板实现
+// ============================================================================
+
+template <typename Key, typename Hash, typename Value, typename Extra>
+typename ResourceInterner::Pool<Key, Hash, Value, Extra>::Item*
+ResourceInterner::Pool<Key, Hash, Value, Extra>::FindFree(const Key& key) {
+    auto it = m_buckets.find(key);
+    if (it == m_buckets.end()) return nullptr;
+
+    auto& items = it->second.items;
+    for (size_t i = items.size(); i-- > 0;) {
+        if (items[i].value.use_count() == 1) {
+            // 移到桶尾和 LRU 前端
+            std::rotate(items.begin() + i, items.begin() + i + 1, items.end());
+            m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+            return &items.back();
+        }
+    }
+    return nullptr;
+}
+
+template <typename Key, typename Hash, typename Value, typename Extra>
+size_t ResourceInterner::Pool<Key, Hash, Value, Extra>::Insert(const Key& key, std::shared_ptr<Value> value,
+                                                               Extra extra) {
+    auto it = m_buckets.find(key);
+    if (it == m_buckets.end()) {
+        m_lru.push_front(key);
+        it = m_buckets.emplace(key, Bucket{{}, m_lru.begin()}).first;
+    } else {
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+    }
+
+    // 同一个键的实例都在使用中：放弃最久未用的一个（调用方仍持有，不会被销毁）
+    auto& items = it->second.items;
+    if (items.size() >= kMaxPerKey) {
+        items.erase(items.begin());
+        --m_size;
+    }
+    items.push_back(Item{std::move(value), std::move(extra)});
+    ++m_size;
+    return Trim();
+}
+
+template <typename Key, typename Hash, typename Value, typename Extra>
+size_t ResourceInterner::Pool<Key, Hash, Value, Extra>::Trim() {
+    size_t evicted = 0;
+    while (m_size > m_capacity && !m_lru.empty()) {
+        auto it = m_buckets.find(m_lru.back());
+        evicted += it->second.items.size();
+        m_size -= it->second.items.size();
+        m_buckets.erase(it);
+        m_lru.pop_back();
+    }
+    return evicted;
+}
+
+template <typename Ptr, typename Reset, typename Create>
+Ptr ResourceInterner::AcquireBrush(const BrushKey& key, Reset&& reset, Create&& create) {
+    using T = typename Ptr::element_type;
+    if (auto* item = m_brushes.FindFree(key)) {
+        ++m_stats.hits;
+        auto brush = std::static_pointer_cast<T>(item->value);
+        reset(*brush);
+        return brush;
+    }
+    ++m_stats.misses;
+    Ptr brush = create();
+    if (brush) {
+        m_stats.evictions += m_brushes.Insert(key, brush, NoExtra());
+    }
+    return brush;
+}
+
+template <typename Create>
+ISolidColorBrushPtr ResourceInterner::AcquireSolidColorBrush(const Color& color, Create&& create) {
+    return AcquireBrush<ISolidColorBrushPtr>(MakeSolidKey(color),
+        [&color](ISolidColorBrush& brush) {
+            Color current = brush.GetColor();
+            if (current.r != color.r || current.g != color.g || current.b != color.b || current.a != color.a) {
+                brush.SetColor(color);
+            }
+        },
+        std::forward<Create>(create));
+}
+
+template <typename Create>
+ILinearGradientBrushPtr ResourceInterner::AcquireLinearGradientBrush(const Point& start, const Point& end,
+                                                                     const std::vector<GradientStop>& stops,
+                                                                     Create&& create) {
+    return AcquireBrush<ILinearGradientBrushPtr>(
+        MakeGradientKey(BrushType::LinearGradient, start.x, start.y, end.x, end.y, stops),
+        [&start, &end](ILinearGradientBrush& brush) {
+            brush.SetStartPoint(start);
+            brush.SetEndPoint(end);
+        },
+        std::forward<Create>(create));
+}
+
+template <typename Create>
+IRadialGradientBrushPtr ResourceInterner::AcquireRadialGradientBrush(const Point& center, float radiusX,
+                                                                     float radiusY,
+                                                                     const std::vector<GradientStop>& stops,
+                                                                     Create&& create) {
+    return AcquireBrush<IRadialGradientBrushPtr>(
+        MakeGradientKey(BrushType::RadialGradient, center.x, center.y, radiusX, radiusY, stops),
+        [&center, radiusX, radiusY](IRadialGradientBrush& brush) {
+            brush.SetCenter(center);
+            brush.SetRadius(radiusX, radiusY);
+        },
+        std::forward<Create>(create));
+}
+
+template <typename Create>
+ITextFormatPtr ResourceInterner::AcquireTextFormat(const std::wstring& fontFamily, float fontSize,
+                                                   Create&& create) {
+    TextFormatKey key{fontFamily, fontSize};
+    if (auto* item = m_textFormats.FindFree(key)) {
+        ++m_stats.hits;
+        item->extra.Restore(*item->value, key);
+        return item->value;
+    }
+    ++m_stats.misses;
+    ITextFormatPtr format = create();
+    if (format) {
+        m_stats.evictions += m_textFormats.Insert(key, format, TextFormatState::Capture(*format));
+    }
+    return format;
+}
+
+} // namespace rendering
+} // namespace luaui
@@ -0,0 +1,252 @@
+#include "TextLayoutCache.h"
+#include "IRenderContext.h"
+
+namespace luaui {
+namespace rendering {
+
+namespace {
+
+inline void HashCombine(size_t& seed, size_t value) {
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+} // anonymous namespace
+
+TextLayoutCache& TextLayoutCache::Instance() {
+    static TextLayoutCache s_instance;
+    return s_instance;
+}
+
+// ============================================================================
+// 键
+// ============================================================================
+
+bool TextLayoutCache::Key::operator==(const Key& other) const {
+    return hash == other.hash &&
+           fontSize == other.fontSize &&
+           maxWidth == other.maxWidth &&
+           maxHeight == other.maxHeight &&
+           weight == other.weight &&
+           style == other.style &&
+           wrapping == other.wrapping &&
+           trimming == other.trimming &&
+           textAlignment == other.textAlignment &&
+           paragraphAlignment == other.paragraphAlignment &&
+           context == other.context &&
+           fontFamily == other.fontFamily &&
+           text == other.text;
+}
+
+TextLayoutCache::Key TextLayoutCache::MakeKey(const ITextFormat& format, const std::wstring& text,
+                                              float maxWidth, float maxHeight, IRenderContext* context) {
+    Key key;
+    key.text = text;
+    key.fontFamily = format.GetFontFamily();
+    key.fontSize = format.GetFontSize();
+    key.maxWidth = maxWidth;
+    key.maxHeight = maxHeight;
+    key.weight = format.GetFontWeight();
+    key.style = format.GetFontStyle();
+    key.wrapping = format.GetWordWrapping();
+    key.trimming = format.GetTextTrimming();
+    key.textAlignment = format.GetTextAlignment();
+    key.paragraphAlignment = format.GetParagraphAlignment();
+    key.context = context;
+
+    size_t seed = std::hash<std::wstring>()(key.text);
+    HashCombine(seed, std::hash<std::wstring>()(key.fontFamily));
+    HashCombine(seed, std::hash<float>()(key.fontSize));
+    HashCombine(seed, std::hash<float>()(key.maxWidth));
+    HashCombine(seed, std::hash<float>()(key.maxHeight));
+    HashCombine(seed, static_cast<size_t>(key.weight));
+    HashCombine(seed, static_cast<size_t>(key.style) << 4 | static_cast<size_t>(key.wrapping) << 8 |
+                      static_cast<size_t>(key.trimming) << 12 | static_cast<size_t>(key.textAlignment) << 16 |
+                      static_cast<size_t>(key.paragraphAlignment) << 20);
+    HashCombine(seed, std::hash<const void*>()(key.context));
+    key.hash = seed;
+    return key;
+}
+
+size_t TextLayoutCache::EstimateBytes(const Key& key, bool hasLayout) {
+    size_t bytes = kEntryOverheadBytes + (key.text.size() + key.fontFamily.size()) * sizeof(wchar_t);
+    if (hasLayout) {
+        bytes += kLayoutBytes + key.text.size() * kLayoutBytesPerChar;
+    }
+    return bytes;
+}
+
+void TextLayoutCache::RestoreLayout(ITextLayout& layout, const Key& key) {
+    // 先比较再设置：D2D 布局修改属性需要重新排版
+    if (layout.GetText() != key.text) layout.SetText(key.text);
+    Size maxSize = layout.GetMaxSize();
+    if (maxSize.width != key.maxWidth || maxSize.height != key.maxHeight) {
+        layout.SetMaxSize(Size(key.maxWidth, key.maxHeight));
+    }
+    if (layout.GetFontWeight() != key.weight) layout.SetFontWeight(key.weight);
+    if (layout.GetFontStyle() != key.style) layout.SetFontStyle(key.style);
+    if (layout.GetWordWrapping() != key.wrapping) layout.SetWordWrapping(key.wrapping);
+    if (layout.GetTextTrimming() != key.trimming) layout.SetTextTrimming(key.trimming);
+    if (layout.GetTextAlignment() != key.textAlignment) layout.SetTextAlignment(key.textAlignment);
+    if (layout.GetParagraphAlignment() != key.paragraphAlignment) {
+        layout.SetParagraphAlignment(key.paragraphAlignment);
+    }
+}
+
+// ============================================================================
+// 查询
+// ============================================================================
+
+Size TextLayoutCache::Measure(ITextFormat* format, const std::wstring& text, float maxWidth) {
+    if (!format) return Size();
+    if (text.empty()) return format->MeasureText(text, maxWidth);
+
+    Key key = MakeKey(*format, text, maxWidth, 0, nullptr);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            ++m_stats.measureHits;
+            Touch(it->second);
+            Notify(TextCacheEvent::MeasureHit, text);
+            return it->second.size;
+        }
+    }
+
+    // 排版在锁外进行
+    Size size = format->MeasureText(text, maxWidth);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_stats.measureMisses;
+    Notify(TextCacheEvent::MeasureMiss, text);
+    Entry entry;
+    entry.size = size;
+    entry.bytes = EstimateBytes(key, false);
+    Insert(std::move(key), std::move(entry));
+    return size;
+}
+
+ITextLayoutPtr TextLayoutCache::GetLayout(IRenderContext* context, const std::wstring& text, ITextFormat* format,
+                                          const Size& maxSize) {
+    if (!context || !format) return nullptr;
+
+    Key key = MakeKey(*format, text, maxSize.width, maxSize.height, context);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        // 仍被调用方持有的布局不共享
+        if (it != m_entries.end() && it->second.layout.use_count() == 1) {
+            ++m_stats.layoutHits;
+            Touch(it->second);
+            Notify(TextCacheEvent::LayoutHit, text);
+            RestoreLayout(*it->second.layout, it->first);
+            return it->second.layout;
+        }
+    }
+
+    ITextLayoutPtr layout = context->CreateTextLayout(text, format, maxSize);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_stats.layoutMisses;
+    Notify(TextCacheEvent::LayoutMiss, text);
+    if (layout && m_entries.find(key) == m_entries.end()) {
+        Entry entry;
+        entry.size = layout->GetLayoutSize();
+        entry.layout = layout;
+        entry.bytes = EstimateBytes(key, true);
+        Insert(std::move(key), std::move(entry));
+    }
+    return layout;
+}
+
+// ============================================================================
+// 管理
+// ============================================================================
+
+void TextLayoutCache::SetByteBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_byteBudget = bytes;
+    TrimLocked();
+}
+
+size_t TextLayoutCache::GetByteBudget() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_byteBudget;
+}
+
+void TextLayoutCache::RemoveContext(IRenderContext* context) {
+    if (!context) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->first.context == context) {
+            auto next = std::next(it);
+            Erase(it);
+            it = next;
+        } else {
+            ++it;
+        }
+    }
+}
+
+void TextLayoutCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_lru.clear();
+    m_bytes = 0;
+}
+
+void TextLayoutCache::SetObserver(Observer observer) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_observer = std::move(observer);
+}
+
+TextLayoutCache::Stats TextLayoutCache::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats stats = m_stats;
+    stats.entries = m_entries.size();
+    stats.bytes = m_bytes;
+    return stats;
+}
+
+void TextLayoutCache::ResetStats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats = Stats();
+}
+
+void TextLayoutCache::Insert(Key&& key, Entry&& entry) {
+    auto result = m_entries.emplace(std::move(key), std::move(entry));
+    if (!result.second) return;   // 其他线程已经插入
+
+    auto& inserted = result.first->second;
+    m_lru.push_front(&result.first->first);
+    inserted.lru = m_lru.begin();
+    m_bytes += inserted.bytes;
+    TrimLocked();
+}
+
+void TextLayoutCache::Touch(Entry& entry) {
+    m_lru.splice(m_lru.begin(), m_lru, entry.lru);
+}
+
+void TextLayoutCache::Erase(std::unordered_map<Key, Entry, KeyHash>::iterator it) {
+    m_bytes -= it->second.bytes;
+    m_lru.erase(it->second.lru);
+    m_entries.erase(it);
+}
+
+void TextLayoutCache::TrimLocked() {
+    while (m_bytes > m_byteBudget && !m_lru.empty()) {
+        auto it = m_entries.find(*m_lru.back());
+        Notify(TextCacheEvent::Eviction, it->first.text);
+        Erase(it);
+        ++m_stats.evictions;
+    }
+}
+
+void TextLayoutCache::Notify(TextCacheEvent event, const std::wstring& text) const {
+    if (m_observer) {
+        m_observer(event, text);
+    }
+}
+
+} // namespace rendering
+} // namespace luaui
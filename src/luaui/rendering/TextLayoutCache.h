@@ -0,0 +1,155 @@
+#pragma once
+
+#include "ITextFormat.h"
+#include "Types.h"
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace luaui {
+namespace rendering {
+
+class IRenderContext;
+
+/**
+ * @brief 文本测量/布局缓存事件
+ */
+enum class TextCacheEvent {
+    MeasureHit,
+    MeasureMiss,
+    LayoutHit,
+    LayoutMiss,
+    Eviction
+};
+
+/**
+ * @brief 进程级文本测量与布局缓存
+ *
+ * 以（文本、字体属性、最大尺寸、换行/截断/对齐）为键，缓存 MeasureText 的结果
+ * 和可复用的 ITextLayout。字体按值（字体族、字号、粗细、样式）而非对象地址识别，
+ * 因此不同控件各自创建的相同文本格式共享同一条目；表格中大量重复的状态值、日期
+ * 只在第一次出现时排版。
+ *
+ * 布局对象是可变的，只有缓存外没有其他引用时才会复用，交出前按键还原文本、
+ * 最大尺寸和格式属性。布局与创建它的渲染上下文绑定，上下文关闭时调用 RemoveContext。
+ *
+ * 容量按估算字节数限制，整体 LRU 淘汰。可以设置观察者统计命中率或记录日志。
+ * 所有方法线程安全；未命中时的测量在锁外执行。
+ */
+class TextLayoutCache {
+public:
+    static constexpr size_t kDefaultByteBudget = 4 * 1024 * 1024;
+    static constexpr size_t kEntryOverheadBytes = 160;   // 节点、键和 LRU 链表
+    static constexpr size_t kLayoutBytes = 1024;         // 布局对象的基础开销
+    static constexpr size_t kLayoutBytesPerChar = 16;    // 每个字符的字形/簇信息
+
+    /**
+     * @brief 缓存统计
+     */
+    struct Stats {
+        uint64_t measureHits = 0;
+        uint64_t measureMisses = 0;
+        uint64_t layoutHits = 0;
+        uint64_t layoutMisses = 0;
+        uint64_t evictions = 0;
+        size_t entries = 0;
+        size_t bytes = 0;
+    };
+
+    using Observer = std::function<void(TextCacheEvent event, const std::wstring& text)>;
+
+    TextLayoutCache() = default;
+    TextLayoutCache(const TextLayoutCache&) = delete;
+    TextLayoutCache& operator=(const TextLayoutCache&) = delete;
+
+    /**
+     * @brief 进程级共享实例
+     */
+    static TextLayoutCache& Instance();
+
+    // ========== 查询 ==========
+    /**
+     * @brief 测量文本尺寸（等价于 format->MeasureText(text, maxWidth)）
+     */
+    Size Measure(ITextFormat* format, const std::wstring& text, float maxWidth = 0);
+
+    /**
+     * @brief 获取文本布局（等价于 context->CreateTextLayout(text, format, maxSize)）
+     */
+    ITextLayoutPtr GetLayout(IRenderContext* context, const std::wstring& text, ITextFormat* format,
+                             const Size& maxSize);
+
+    // ========== 管理 ==========
+    void SetByteBudget(size_t bytes);
+    size_t GetByteBudget() const;
+
+    /**
+     * @brief 释放与指定上下文绑定的布局（上下文关闭前调用）
+     */
+    void RemoveContext(IRenderContext* context);
+
+    void Clear();
+
+    /**
+     * @brief 设置观察者（命中、未命中、淘汰时回调；回调中不要访问缓存）
+     */
+    void SetObserver(Observer observer);
+
+    Stats GetStats() const;
+    void ResetStats();
+
+private:
+    struct Key {
+        std::wstring text;
+        std::wstring fontFamily;
+        float fontSize = 0;
+        float maxWidth = 0;
+        float maxHeight = 0;
+        FontWeight weight = FontWeight::Regular;
+        FontStyle style = FontStyle::Normal;
+        WordWrapping wrapping = WordWrapping::Wrap;
+        TextTrimming trimming = TextTrimming::None;
+        TextAlignment textAlignment = TextAlignment::Leading;
+        ParagraphAlignment paragraphAlignment = ParagraphAlignment::Near;
+        IRenderContext* context = nullptr;   // 仅布局条目
+        size_t hash = 0;
+
+        bool operator==(const Key& other) const;
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const { return key.hash; }
+    };
+
+    struct Entry {
+        Size size;                 // 测量条目
+        ITextLayoutPtr layout;     // 布局条目
+        size_t bytes = 0;
+        std::list<const Key*>::iterator lru;
+    };
+
+    static Key MakeKey(const ITextFormat& format, const std::wstring& text, float maxWidth, float maxHeight,
+                       IRenderContext* context);
+    static void RestoreLayout(ITextLayout& layout, const Key& key);
+    static size_t EstimateBytes(const Key& key, bool hasLayout);
+
+    // 以下方法要求持有 m_mutex
+    void Insert(Key&& key, Entry&& entry);
+    void Touch(Entry& entry);
+    void Erase(std::unordered_map<Key, Entry, KeyHash>::iterator it);
+    void TrimLocked();
+    void Notify(TextCacheEvent event, const std::wstring& text) const;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<Key, Entry, KeyHash> m_entries;
+    std::list<const Key*> m_lru;   // 前端最近使用
+    size_t m_bytes = 0;
+    size_t m_byteBudget = kDefaultByteBudget;
+    Stats m_stats;
+    Observer m_observer;
+};
+
+} // namespace rendering
+} // namespace luaui
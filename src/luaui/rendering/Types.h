@@ -200,6 +200,52 @@ public:
         return t;
     }
     
+    // Build from raw elements [m11, m12, m21, m22, dx, dy]
+    static Transform Matrix(float m11, float m12, float m21, float m22, float dx, float dy) {
+        Transform t;
+        t.m[0] = m11; t.m[1] = m12;
+        t.m[2] = m21; t.m[3] = m22;
+        t.m[4] = dx;  t.m[5] = dy;
+        return t;
+    }
+
+    bool IsIdentity() const {
+        return m[0] == 1 && m[1] == 0 && m[2] == 0 && m[3] == 1 && m[4] == 0 && m[5] == 0;
+    }
+
+    // True when the transform only scales and translates (no rotation/skew)
+    bool IsAxisAligned() const { return m[1] == 0 && m[2] == 0; }
+
+    float Determinant() const { return m[0] * m[3] - m[1] * m[2]; }
+
+    // Inverse transform; returns identity when the matrix is singular
+    Transform Invert() const {
+        float det = Determinant();
+        if (det == 0) return Transform();
+        float inv = 1.0f / det;
+        Transform t;
+        t.m[0] =  m[3] * inv;
+        t.m[1] = -m[1] * inv;
+        t.m[2] = -m[2] * inv;
+        t.m[3] =  m[0] * inv;
+        t.m[4] = (m[2] * m[5] - m[3] * m[4]) * inv;
+        t.m[5] = (m[1] * m[4] - m[0] * m[5]) * inv;
+        return t;
+    }
+
+    // Axis-aligned bounding box of a transformed rectangle
+    Rect TransformBounds(const Rect& r) const {
+        Point p0 = TransformPoint(Point(r.x, r.y));
+        Point p1 = TransformPoint(Point(r.x + r.width, r.y));
+        Point p2 = TransformPoint(Point(r.x, r.y + r.height));
+        Point p3 = TransformPoint(Point(r.x + r.width, r.y + r.height));
+        float x0 = (std::min)((std::min)(p0.x, p1.x), (std::min)(p2.x, p3.x));
+        float y0 = (std::min)((std::min)(p0.y, p1.y), (std::min)(p2.y, p3.y));
+        float x1 = (std::max)((std::max)(p0.x, p1.x), (std::max)(p2.x, p3.x));
+        float y1 = (std::max)((std::max)(p0.y, p1.y), (std::max)(p2.y, p3.y));
+        return Rect(x0, y0, x1 - x0, y1 - y0);
+    }
+
     Transform operator*(const Transform& other) const {
         Transform result;
         result.m[0] = m[0] * other.m[0] + m[1] * other.m[2];
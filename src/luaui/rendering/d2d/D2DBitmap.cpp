@@ -1,6 +1,7 @@
 #include "D2DBitmap.h"
 #include "D2DRenderContext.h"
 #include <wincodec.h>
+#include <algorithm>
 
 namespace luaui {
 namespace rendering {
@@ -55,6 +56,28 @@ bool D2DBitmap::Initialize(D2DRenderContext* context, int width, int height, Pix
     return false;
 }
 
+bool D2DBitmap::InitializeFromBitmap(ID2D1RenderTarget* renderTarget, ID2D1Bitmap* source) {
+    if (!renderTarget || !source) return false;
+    
+    D2D1_BITMAP_PROPERTIES props;
+    props.pixelFormat = source->GetPixelFormat();
+    source->GetDpi(&props.dpiX, &props.dpiY);
+    
+    ComPtr<ID2D1Bitmap> bitmap;
+    HRESULT hr = renderTarget->CreateBitmap(source->GetPixelSize(), nullptr, 0, &props, &bitmap);
+    if (FAILED(hr)) return false;
+    
+    // GPU-side copy, no readback
+    hr = bitmap->CopyFromBitmap(nullptr, source, nullptr);
+    if (FAILED(hr)) return false;
+    
+    m_bitmap = bitmap;
+    m_format = PixelFormat::BGRA8;
+    m_dpiX = props.dpiX;
+    m_dpiY = props.dpiY;
+    return true;
+}
+
 bool D2DBitmap::LoadFromFile(D2DRenderContext* context, const std::wstring& filePath) {
     ID2D1RenderTarget* rt = context->GetRenderTarget();
     if (!rt) return false;
@@ -175,6 +198,79 @@ bool D2DBitmap::LoadFromMemory(D2DRenderContext* context, const void* data, size
     return SUCCEEDED(hr) && m_bitmap;
 }
 
+bool D2DBitmap::DecodePixels(const void* data, size_t size, int minShortSide, DecodedImage& out) {
+    if (!data || size == 0) return false;
+    
+    // Worker threads join the multithreaded apartment once
+    thread_local bool comInitialized = SUCCEEDED(CoInitializeEx(nullptr, COINIT_MULTITHREADED));
+    (void)comInitialized;
+    
+    IWICImagingFactory* wic = GetWICFactory();
+    if (!wic) return false;
+    
+    ComPtr<IWICStream> stream;
+    HRESULT hr = wic->CreateStream(&stream);
+    if (SUCCEEDED(hr)) {
+        hr = stream->InitializeFromMemory(reinterpret_cast<BYTE*>(const_cast<void*>(data)),
+                                          static_cast<DWORD>(size));
+    }
+    
+    ComPtr<IWICBitmapDecoder> decoder;
+    if (SUCCEEDED(hr)) {
+        hr = wic->CreateDecoderFromStream(stream.Get(), nullptr, WICDecodeMetadataCacheOnDemand, &decoder);
+    }
+    
+    ComPtr<IWICBitmapFrameDecode> frame;
+    if (SUCCEEDED(hr)) hr = decoder->GetFrame(0, &frame);
+    
+    UINT width = 0, height = 0;
+    if (SUCCEEDED(hr)) hr = frame->GetSize(&width, &height);
+    if (FAILED(hr) || width == 0 || height == 0) return false;
+    
+    // Scale during decode (JPEG decoders use DCT scaling), before format conversion
+    ComPtr<IWICBitmapSource> source = frame;
+    UINT dstWidth = width, dstHeight = height;
+    UINT shortSide = (std::min)(width, height);
+    if (minShortSide > 0 && shortSide > static_cast<UINT>(minShortSide)) {
+        double scale = static_cast<double>(minShortSide) / shortSide;
+        dstWidth = (std::max)(1u, static_cast<UINT>(width * scale + 0.5));
+        dstHeight = (std::max)(1u, static_cast<UINT>(height * scale + 0.5));
+        
+        ComPtr<IWICBitmapScaler> scaler;
+        hr = wic->CreateBitmapScaler(&scaler);
+        if (SUCCEEDED(hr)) hr = scaler->Initialize(frame.Get(), dstWidth, dstHeight, WICBitmapInterpolationModeFant);
+        if (FAILED(hr)) return false;
+        source = scaler;
+    }
+    
+    ComPtr<IWICFormatConverter> converter;
+    hr = wic->CreateFormatConverter(&converter);
+    if (SUCCEEDED(hr)) {
+        hr = converter->Initialize(source.Get(), GUID_WICPixelFormat32bppPBGRA, WICBitmapDitherTypeNone,
+                                   nullptr, 0.0, WICBitmapPaletteTypeMedianCut);
+    }
+    if (FAILED(hr)) return false;
+    
+    out.pixels.resize(static_cast<size_t>(dstWidth) * dstHeight);
+    hr = converter->CopyPixels(nullptr, dstWidth * 4, static_cast<UINT>(out.pixels.size() * 4),
+                               reinterpret_cast<BYTE*>(out.pixels.data()));
+    if (FAILED(hr)) return false;
+    
+    out.width = static_cast<int>(dstWidth);
+    out.height = static_cast<int>(dstHeight);
+    out.sourceWidth = static_cast<int>(width);
+    out.sourceHeight = static_cast<int>(height);
+    return true;
+}
+
+void D2DBitmap::InstallDecoder() {
+    // Create the factory here so worker threads never race on its lazy creation
+    if (!GetWICFactory()) return;
+    BitmapService::Instance().SetDecoder([](const uint8_t* data, size_t size, int minShortSide, DecodedImage& out) {
+        return DecodePixels(data, size, minShortSide, out);
+    });
+}
+
 int D2DBitmap::GetWidth() const {
     if (!m_bitmap) return 0;
     D2D1_SIZE_F size = m_bitmap->GetSize();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "IBitmap.h"
+#include "BitmapService.h"
 #include <d2d1.h>
 #include <wrl/client.h>
 
@@ -19,6 +20,14 @@ public:
     bool Initialize(D2DRenderContext* context, int width, int height, PixelFormat format);
     bool LoadFromFile(D2DRenderContext* context, const std::wstring& filePath);
     bool LoadFromMemory(D2DRenderContext* context, const void* data, size_t size);
+    // Snapshot of an existing bitmap (e.g. a bitmap render target's surface)
+    bool InitializeFromBitmap(ID2D1RenderTarget* renderTarget, ID2D1Bitmap* source);
+    
+    // Decode an encoded image to premultiplied BGRA pixels with WIC (thread-safe).
+    // Scales down during decode so the shorter side is no less than minShortSide (0 = full size).
+    static bool DecodePixels(const void* data, size_t size, int minShortSide, DecodedImage& out);
+    // Route BitmapService decoding through WIC; call on the UI thread after COM is initialized
+    static void InstallDecoder();
     
     // IBitmap
     int GetWidth() const override;
@@ -3,6 +3,8 @@
 #include "D2DGeometry.h"
 #include "D2DBitmap.h"
 #include "D2DTextFormat.h"
+#include "TextLayoutCache.h"
+#include "BitmapService.h"
 
 namespace luaui {
 namespace rendering {
@@ -17,12 +19,18 @@ bool D2DRenderContext::Initialize(ID2D1Factory* factory, ID2D1RenderTarget* rt,
     m_renderTarget = rt;
     m_dwriteFactory = dw;
     if (!m_d2dFactory || !m_renderTarget) return false;
+    // Interned brushes belong to the previous render target
+    m_interner.Clear();
     ResetState();
     return true;
 }
 
 void D2DRenderContext::Shutdown() {
+    TextLayoutCache::Instance().RemoveContext(this);
+    BitmapService::Instance().RemoveContext(this);
+    m_interner.Clear();
     m_strokeStyles.clear();
+    m_clipStack.clear();
     while (!m_layerStack.empty()) m_layerStack.pop();
     while (!m_stateStack.empty()) m_stateStack.pop();
     m_renderTarget.Reset();
@@ -92,6 +100,8 @@ bool D2DRenderContext::GetAntialias() const { return m_currentState.antialias; }
 void D2DRenderContext::PushClip(const Rect& rect) {
     if (!m_renderTarget) return;
     m_renderTarget->PushAxisAlignedClip(ToD2DRect(rect), D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
+    Rect device = m_currentState.transform.TransformBounds(rect);
+    m_clipStack.push_back({GetDeviceClipBounds().Intersect(device), false});
 }
 
 void D2DRenderContext::PushClip(const IGeometry& geom) {
@@ -102,25 +112,29 @@ void D2DRenderContext::PushClip(const IGeometry& geom) {
     if (SUCCEEDED(m_renderTarget->CreateLayer(&layer))) {
         m_renderTarget->PushLayer(D2D1::LayerParameters(D2D1::InfiniteRect(), g), layer);
         m_layerStack.push({ComPtr<ID2D1Layer>(layer), 1.0f});
+        Rect device = m_currentState.transform.TransformBounds(geom.GetBounds());
+        m_clipStack.push_back({GetDeviceClipBounds().Intersect(device), true});
     }
 }
 
 void D2DRenderContext::PopClip() {
-    if (!m_renderTarget) return;
-    if (!m_layerStack.empty()) {
+    if (!m_renderTarget || m_clipStack.empty()) return;
+    if (m_clipStack.back().isLayer) {
         m_renderTarget->PopLayer();
         m_layerStack.pop();
     } else {
         m_renderTarget->PopAxisAlignedClip();
     }
+    m_clipStack.pop_back();
 }
 
 void D2DRenderContext::ResetClip() {
     if (!m_renderTarget) return;
-    while (!m_layerStack.empty()) { m_renderTarget->PopLayer(); m_layerStack.pop(); }
+    while (!m_clipStack.empty()) PopClip();
 }
 
-Rect D2DRenderContext::GetClipBounds() const {
+Rect D2DRenderContext::GetDeviceClipBounds() const {
+    if (!m_clipStack.empty()) return m_clipStack.back().bounds;
     if (!m_renderTarget) return Rect();
     D2D1_SIZE_U size = m_renderTarget->GetPixelSize();
     float dpiX, dpiY;
@@ -128,6 +142,12 @@ Rect D2DRenderContext::GetClipBounds() const {
     return Rect(0, 0, size.width * 96.0f / dpiX, size.height * 96.0f / dpiY);
 }
 
+Rect D2DRenderContext::GetClipBounds() const {
+    if (!m_renderTarget) return Rect();
+    // Report in the current local coordinate space
+    return m_currentState.transform.Invert().TransformBounds(GetDeviceClipBounds());
+}
+
 // Type Conversions
 D2D1_COLOR_F D2DRenderContext::ToD2DColor(const Color& c) const {
     Color p = c.Premultiply();
@@ -164,6 +184,28 @@ void D2DRenderContext::FillRectangle(const Rect& r, IBrush* brush) {
     if (b) m_renderTarget->FillRectangle(ToD2DRect(r), b);
 }
 
+void D2DRenderContext::FillRectangles(const Rect* rects, size_t count, IBrush* brush) {
+    if (!m_renderTarget || !brush || !rects) return;
+    // Resolve the native brush once for the whole batch
+    ID2D1Brush* b = static_cast<ID2D1Brush*>(brush->GetNativeBrush(this));
+    if (!b) return;
+    for (size_t i = 0; i < count; ++i) {
+        m_renderTarget->FillRectangle(ToD2DRect(rects[i]), b);
+    }
+}
+
+void D2DRenderContext::DrawLines(const Point* points, size_t segmentCount, IBrush* brush, float sw,
+                                 const StrokeStyle* style) {
+    if (!m_renderTarget || !brush || !points) return;
+    ID2D1Brush* b = static_cast<ID2D1Brush*>(brush->GetNativeBrush(this));
+    if (!b) return;
+    ID2D1StrokeStyle* stroke = GetStrokeStyle(style);
+    float width = sw * m_currentState.opacity;
+    for (size_t i = 0; i < segmentCount; ++i) {
+        m_renderTarget->DrawLine(ToD2DPoint(points[i * 2]), ToD2DPoint(points[i * 2 + 1]), b, width, stroke);
+    }
+}
+
 void D2DRenderContext::DrawRoundedRectangle(const Rect& r, const CornerRadius& cr, IBrush* brush, float sw, const StrokeStyle* style) {
     if (!m_renderTarget || !brush) return;
     ID2D1Brush* b = static_cast<ID2D1Brush*>(brush->GetNativeBrush(this));
@@ -288,19 +330,26 @@ ID2D1StrokeStyle* D2DRenderContext::GetStrokeStyle(const StrokeStyle* s) {
 }
 
 // Factory Methods
+// Brushes and text formats are interned by value; see ResourceInterner
 ISolidColorBrushPtr D2DRenderContext::CreateSolidColorBrush(const Color& c) {
-    auto b = std::make_shared<D2DSolidColorBrush>();
-    return b->Initialize(this, c) ? b : nullptr;
+    return m_interner.AcquireSolidColorBrush(c, [&]() -> ISolidColorBrushPtr {
+        auto b = std::make_shared<D2DSolidColorBrush>();
+        return b->Initialize(this, c) ? b : nullptr;
+    });
 }
 
 ILinearGradientBrushPtr D2DRenderContext::CreateLinearGradientBrush(const Point& s, const Point& e, const std::vector<GradientStop>& stops) {
-    auto b = std::make_shared<D2DLinearGradientBrush>();
-    return b->Initialize(this, s, e, stops) ? b : nullptr;
+    return m_interner.AcquireLinearGradientBrush(s, e, stops, [&]() -> ILinearGradientBrushPtr {
+        auto b = std::make_shared<D2DLinearGradientBrush>();
+        return b->Initialize(this, s, e, stops) ? b : nullptr;
+    });
 }
 
 IRadialGradientBrushPtr D2DRenderContext::CreateRadialGradientBrush(const Point& c, float rx, float ry, const std::vector<GradientStop>& stops) {
-    auto b = std::make_shared<D2DRadialGradientBrush>();
-    return b->Initialize(this, c, rx, ry, stops) ? b : nullptr;
+    return m_interner.AcquireRadialGradientBrush(c, rx, ry, stops, [&]() -> IRadialGradientBrushPtr {
+        auto b = std::make_shared<D2DRadialGradientBrush>();
+        return b->Initialize(this, c, rx, ry, stops) ? b : nullptr;
+    });
 }
 
 std::shared_ptr<IRectangleGeometry> D2DRenderContext::CreateRectangleGeometry(const Rect& r) {
@@ -329,8 +378,10 @@ std::shared_ptr<ICombinedGeometry> D2DRenderContext::CreateCombinedGeometry(IGeo
 }
 
 ITextFormatPtr D2DRenderContext::CreateTextFormat(const std::wstring& family, float size) {
-    auto f = std::make_shared<D2DTextFormat>();
-    return f->Initialize(this, family, size) ? f : nullptr;
+    return m_interner.AcquireTextFormat(family, size, [&]() -> ITextFormatPtr {
+        auto f = std::make_shared<D2DTextFormat>();
+        return f->Initialize(this, family, size) ? f : nullptr;
+    });
 }
 
 ITextLayoutPtr D2DRenderContext::CreateTextLayout(const std::wstring& text, ITextFormat* format, const Size& size) {
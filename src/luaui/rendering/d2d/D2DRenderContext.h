@@ -1,10 +1,12 @@
 #pragma once
 
 #include "IRenderContext.h"
+#include "ResourceInterner.h"
 #include <d2d1.h>
 #include <dwrite.h>
 #include <wrl/client.h>
 #include <stack>
+#include <vector>
 
 namespace luaui {
 namespace rendering {
@@ -53,6 +55,9 @@ public:
     void DrawRectangle(const Rect& rect, IBrush* brush, float strokeWidth = 1.0f,
                        const StrokeStyle* strokeStyle = nullptr) override;
     void FillRectangle(const Rect& rect, IBrush* brush) override;
+    void FillRectangles(const Rect* rects, size_t count, IBrush* brush) override;
+    void DrawLines(const Point* points, size_t segmentCount, IBrush* brush, float strokeWidth = 1.0f,
+                   const StrokeStyle* strokeStyle = nullptr) override;
     
     void DrawRoundedRectangle(const Rect& rect, const CornerRadius& radius, IBrush* brush,
                               float strokeWidth = 1.0f, const StrokeStyle* strokeStyle = nullptr) override;
@@ -103,6 +108,8 @@ public:
     ID2D1RenderTarget* GetRenderTarget() const { return m_renderTarget.Get(); }
     IDWriteFactory* GetDWriteFactory() const { return m_dwriteFactory.Get(); }
     
+    ResourceInterner* GetResourceInterner() override { return &m_interner; }
+    
 private:
     // Convert our types to D2D types
     D2D1_COLOR_F ToD2DColor(const Color& color) const;
@@ -130,6 +137,14 @@ private:
     };
     std::stack<LayerEntry> m_layerStack;
     
+    // Clip stack: device-space bounds of the effective clip, and whether the clip is a layer
+    struct ClipEntry {
+        Rect bounds;
+        bool isLayer;
+    };
+    std::vector<ClipEntry> m_clipStack;
+    Rect GetDeviceClipBounds() const;
+    
     // Direct2D resources
     ComPtr<ID2D1Factory> m_d2dFactory;
     ComPtr<ID2D1RenderTarget> m_renderTarget;
@@ -137,6 +152,9 @@ private:
     
     // Stroke style cache
     std::vector<ComPtr<ID2D1StrokeStyle>> m_strokeStyles;
+    
+    // Interned brushes/text formats (cleared when the render target changes)
+    ResourceInterner m_interner;
 };
 
 } // namespace rendering
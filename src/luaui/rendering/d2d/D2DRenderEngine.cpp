@@ -1,5 +1,6 @@
 #include "D2DRenderEngine.h"
 #include "D2DRenderTarget.h"
+#include "D2DBitmap.h"
 #include "D2DTextLayoutAdvanced.h"
 #include <iostream>
 
@@ -74,6 +75,10 @@ bool D2DRenderEngine::Initialize(RenderAPI api) {
     
     // Create resource cache
     m_resourceCache = std::make_unique<ResourceCache>(m_context.get());
+    m_resourceCache->SetByteBudget(m_maxCacheBytes);
+    
+    // Asynchronous image decoding (Image controls) goes through WIC
+    D2DBitmap::InstallDecoder();
     
     m_initialized = true;
     return true;
@@ -205,6 +210,11 @@ void D2DRenderEngine::Present() {
     
     ValidateRect(m_hwnd, nullptr);
     m_inFrame = false;
+    
+    // Age cached resources; evicts idle entries and enforces the byte budget
+    if (m_resourceCache) {
+        m_resourceCache->EndFrame();
+    }
 }
 
 void D2DRenderEngine::Present(const Rect& dirtyRect) {
@@ -255,12 +265,8 @@ void D2DRenderEngine::EnableStats(bool enable) {
 
 void D2DRenderEngine::SetResourceCacheSize(size_t maxBytes) {
     m_maxCacheBytes = maxBytes;
-    // If current cache exceeds limit, trim it
     if (m_resourceCache) {
-        size_t currentSize = (m_resourceCache->GetBrushCacheSize() + m_resourceCache->GetTextFormatCacheSize()) * 1024;
-        if (currentSize > m_maxCacheBytes) {
-            TrimResourceCache();
-        }
+        m_resourceCache->SetByteBudget(maxBytes);
     }
 }
 
@@ -271,19 +277,8 @@ void D2DRenderEngine::ClearResourceCache() {
 }
 
 void D2DRenderEngine::TrimResourceCache() {
-    if (!m_resourceCache) return;
-    
-    // Simple LRU-like strategy: clear half of the cache when trimming
-    // For now, just clear text formats first (they're cheaper to recreate)
-    size_t textFormatCount = m_resourceCache->GetTextFormatCacheSize();
-    if (textFormatCount > 10) {
-        m_resourceCache->ClearTextFormats();
-    }
-    
-    // If still over limit, clear brushes too
-    size_t brushCount = m_resourceCache->GetBrushCacheSize();
-    if (brushCount > 50) {
-        m_resourceCache->ClearBrushes();
+    if (m_resourceCache) {
+        m_resourceCache->Trim();
     }
 }
 
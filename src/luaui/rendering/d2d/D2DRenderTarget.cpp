@@ -94,49 +94,17 @@ void D2DRenderTarget::Clear(const Color& color) {
 }
 
 IBitmapPtr D2DRenderTarget::ToBitmap() const {
-    if (!m_bitmapTarget) return nullptr;
+    if (!m_bitmapTarget || m_isDrawing) return nullptr;
     
     ComPtr<ID2D1Bitmap> d2dBitmap;
     HRESULT hr = m_bitmapTarget->GetBitmap(&d2dBitmap);
     if (FAILED(hr)) return nullptr;
     
-    // Get bitmap size and properties
-    D2D1_SIZE_U size = d2dBitmap->GetPixelSize();
-    D2D1_BITMAP_PROPERTIES props;
-    d2dBitmap->GetDpi(&props.dpiX, &props.dpiY);
-    
-    // Create WIC bitmap and copy data
-    ComPtr<IWICBitmap> wicBitmap;
-    hr = m_wicFactory->CreateBitmap(
-        size.width,
-        size.height,
-        GUID_WICPixelFormat32bppPBGRA,
-        WICBitmapCacheOnDemand,
-        &wicBitmap
-    );
-    if (FAILED(hr)) return nullptr;
-    
-    // Copy pixels from D2D bitmap
-    ComPtr<IWICBitmapLock> lock;
-    WICRect rect = { 0, 0, static_cast<int>(size.width), static_cast<int>(size.height) };
-    hr = wicBitmap->Lock(&rect, WICBitmapLockWrite, &lock);
-    if (FAILED(hr)) return nullptr;
-    
-    UINT bufferSize = 0;
-    BYTE* buffer = nullptr;
-    UINT stride = 0;
-    lock->GetStride(&stride);
-    lock->GetDataPointer(&bufferSize, &buffer);
-    
-    hr = d2dBitmap->CopyFromMemory(nullptr, buffer, stride);
-    lock.Reset();
-    
-    if (FAILED(hr)) return nullptr;
-    
-    // Create bitmap - need to return as IBitmapPtr
-    // For now, return nullptr as we need to load it from a file/memory
-    // A proper implementation would create a D2DBitmap and copy the pixels
-    return nullptr;
+    // Copy into a standalone bitmap so later draws to this target don't alter it.
+    // The target is compatible with its parent, so the copy can be drawn there directly.
+    auto bitmap = std::make_shared<D2DBitmap>();
+    if (!bitmap->InitializeFromBitmap(m_bitmapTarget.Get(), d2dBitmap.Get())) return nullptr;
+    return bitmap;
 }
 
 bool D2DRenderTarget::SaveToFile(const std::wstring& filePath) const {
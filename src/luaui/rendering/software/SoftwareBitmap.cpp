@@ -0,0 +1,217 @@
+#include "SoftwareBitmap.h"
+#include "SoftwareRasterizer.h"
+#include "BitmapService.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace luaui {
+namespace rendering {
+
+namespace {
+
+#ifndef _WIN32
+// Narrow file names are UTF-8 outside Windows
+std::string ToUtf8Path(const std::wstring& path) {
+    std::string out;
+    for (wchar_t wc : path) {
+        uint32_t c = static_cast<uint32_t>(wc);
+        if (c < 0x80) {
+            out += static_cast<char>(c);
+        } else if (c < 0x800) {
+            out += static_cast<char>(0xC0 | (c >> 6));
+            out += static_cast<char>(0x80 | (c & 0x3F));
+        } else if (c < 0x10000) {
+            out += static_cast<char>(0xE0 | (c >> 12));
+            out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (c & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (c >> 18));
+            out += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (c & 0x3F));
+        }
+    }
+    return out;
+}
+#endif
+
+template <typename Stream>
+bool OpenStream(Stream& s, const std::wstring& path, std::ios::openmode mode) {
+#ifdef _WIN32
+    s.open(path, mode);
+#else
+    s.open(ToUtf8Path(path), mode);
+#endif
+    return s.is_open();
+}
+
+inline uint32_t ReadU32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+inline uint16_t ReadU16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+inline void WriteU32(uint8_t* p, uint32_t v) { p[0] = v & 0xFF; p[1] = (v >> 8) & 0xFF; p[2] = (v >> 16) & 0xFF; p[3] = v >> 24; }
+inline void WriteU16(uint8_t* p, uint16_t v) { p[0] = v & 0xFF; p[1] = v >> 8; }
+
+} // anonymous namespace
+
+bool SoftwareBitmap::Initialize(int width, int height, PixelFormat format) {
+    if (width <= 0 || height <= 0) return false;
+    // Every software bitmap is stored as premultiplied BGRA
+    if (format != PixelFormat::BGRA8 && format != PixelFormat::RGBA8 && format != PixelFormat::Unknown) {
+        return false;
+    }
+    m_width = width;
+    m_height = height;
+    m_pixels.assign(static_cast<size_t>(width) * height, 0);
+    return true;
+}
+
+bool SoftwareBitmap::InitializeFromSurface(const SoftwareSurface& surface) {
+    if (!Initialize(surface.GetWidth(), surface.GetHeight(), PixelFormat::BGRA8)) return false;
+    for (int y = 0; y < m_height; ++y) {
+        std::memcpy(m_pixels.data() + static_cast<size_t>(y) * m_width, surface.GetRow(y),
+                    sizeof(uint32_t) * m_width);
+    }
+    return true;
+}
+
+bool SoftwareBitmap::LoadFromFile(const std::wstring& filePath) {
+    std::ifstream file;
+    if (!OpenStream(file, filePath, std::ios::binary)) return false;
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return LoadFromMemory(data.data(), data.size());
+}
+
+bool SoftwareBitmap::LoadFromMemory(const void* data, size_t size) {
+    if (!data || size < 2) return false;
+    // No codec framework is available headless; uncompressed BMP is decoded natively
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    if (bytes[0] == 'B' && bytes[1] == 'M') return DecodeBmp(bytes, size);
+    return false;
+}
+
+bool SoftwareBitmap::DecodePixels(const uint8_t* data, size_t size, int /*minShortSide*/, DecodedImage& out) {
+    SoftwareBitmap bitmap;
+    if (!bitmap.LoadFromMemory(data, size)) return false;
+    out.width = out.sourceWidth = bitmap.m_width;
+    out.height = out.sourceHeight = bitmap.m_height;
+    out.pixels = std::move(bitmap.m_pixels);
+    return true;
+}
+
+bool SoftwareBitmap::DecodeBmp(const uint8_t* data, size_t size) {
+    if (size < 54) return false;
+    uint32_t pixelOffset = ReadU32(data + 10);
+    uint32_t headerSize = ReadU32(data + 14);
+    int32_t width = static_cast<int32_t>(ReadU32(data + 18));
+    int32_t height = static_cast<int32_t>(ReadU32(data + 22));
+    uint16_t bpp = ReadU16(data + 28);
+    uint32_t compression = ReadU32(data + 30);
+    if (headerSize < 40 || width <= 0 || height == 0) return false;
+    if (bpp != 24 && bpp != 32) return false;
+    if (compression != 0 && !(compression == 3 && bpp == 32)) return false;  // BI_RGB / BI_BITFIELDS
+
+    bool bottomUp = height > 0;
+    int h = bottomUp ? height : -height;
+    size_t rowBytes = ((static_cast<size_t>(width) * bpp / 8) + 3) & ~static_cast<size_t>(3);
+    if (pixelOffset + rowBytes * h > size) return false;
+
+    // 32-bit files carry alpha only with a V4+ header mask; otherwise treat as opaque
+    bool hasAlpha = bpp == 32 && headerSize >= 56 && ReadU32(data + 14 + 40 + 12) != 0;
+
+    if (!Initialize(width, h, PixelFormat::BGRA8)) return false;
+    for (int y = 0; y < h; ++y) {
+        const uint8_t* src = data + pixelOffset + rowBytes * (bottomUp ? (h - 1 - y) : y);
+        uint32_t* dst = m_pixels.data() + static_cast<size_t>(y) * width;
+        for (int x = 0; x < width; ++x) {
+            const uint8_t* p = src + x * (bpp / 8);
+            uint32_t a = hasAlpha ? p[3] : 255;
+            uint32_t pixel = (a << 24) | (p[2] << 16) | (p[1] << 8) | p[0];
+            dst[x] = SoftwareRasterizer::ScalePixel(pixel | 0xFF000000u, a);
+        }
+    }
+    return true;
+}
+
+void* SoftwareBitmap::GetNativeBitmap(IRenderContext* context) {
+    (void)context;
+    return m_pixels.data();
+}
+
+bool SoftwareBitmap::Lock(const Rect* rect, void** pixels, int* pitch) {
+    if (m_locked || m_pixels.empty() || !pixels) return false;
+    int x = 0, y = 0;
+    if (rect) {
+        x = std::clamp(static_cast<int>(rect->x), 0, m_width - 1);
+        y = std::clamp(static_cast<int>(rect->y), 0, m_height - 1);
+    }
+    *pixels = m_pixels.data() + static_cast<size_t>(y) * m_width + x;
+    if (pitch) *pitch = m_width * 4;
+    m_locked = true;
+    return true;
+}
+
+bool SoftwareBitmap::CopyFromMemory(const void* src, int srcPitch) {
+    if (!src || m_pixels.empty()) return false;
+    const uint8_t* bytes = static_cast<const uint8_t*>(src);
+    int pitch = srcPitch > 0 ? srcPitch : m_width * 4;
+    for (int y = 0; y < m_height; ++y) {
+        std::memcpy(m_pixels.data() + static_cast<size_t>(y) * m_width, bytes + static_cast<size_t>(y) * pitch,
+                    sizeof(uint32_t) * m_width);
+    }
+    return true;
+}
+
+bool SoftwareBitmap::SaveBmp(const std::wstring& filePath, const uint32_t* pixels,
+                             int width, int height, int stride) {
+    if (!pixels || width <= 0 || height <= 0) return false;
+
+    // BITMAPFILEHEADER + BITMAPV4HEADER so viewers honour the alpha channel
+    const uint32_t headerSize = 108;
+    const uint32_t pixelOffset = 14 + headerSize;
+    const uint32_t imageSize = static_cast<uint32_t>(width) * height * 4;
+    std::vector<uint8_t> header(pixelOffset, 0);
+    header[0] = 'B'; header[1] = 'M';
+    WriteU32(&header[2], pixelOffset + imageSize);
+    WriteU32(&header[10], pixelOffset);
+    WriteU32(&header[14], headerSize);
+    WriteU32(&header[18], static_cast<uint32_t>(width));
+    WriteU32(&header[22], static_cast<uint32_t>(-height));  // top-down
+    WriteU16(&header[26], 1);
+    WriteU16(&header[28], 32);
+    WriteU32(&header[30], 3);                                // BI_BITFIELDS
+    WriteU32(&header[34], imageSize);
+    WriteU32(&header[38], 3780);                             // 96 DPI
+    WriteU32(&header[42], 3780);
+    WriteU32(&header[54], 0x00FF0000);                       // R mask
+    WriteU32(&header[58], 0x0000FF00);                       // G mask
+    WriteU32(&header[62], 0x000000FF);                       // B mask
+    WriteU32(&header[66], 0xFF000000);                       // A mask
+    WriteU32(&header[70], 0x73524742);                       // 'sRGB'
+
+    std::ofstream file;
+    if (!OpenStream(file, filePath, std::ios::binary | std::ios::trunc)) return false;
+    file.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+    // BMP stores straight alpha
+    std::vector<uint32_t> row(width);
+    for (int y = 0; y < height; ++y) {
+        const uint32_t* src = pixels + static_cast<size_t>(y) * stride;
+        for (int x = 0; x < width; ++x) {
+            uint32_t p = src[x];
+            uint32_t a = p >> 24;
+            if (a == 0) { row[x] = 0; continue; }
+            if (a == 255) { row[x] = p; continue; }
+            uint32_t r = (((p >> 16) & 0xFF) * 255 + a / 2) / a;
+            uint32_t g = (((p >> 8) & 0xFF) * 255 + a / 2) / a;
+            uint32_t b = ((p & 0xFF) * 255 + a / 2) / a;
+            row[x] = (a << 24) | ((std::min)(r, 255u) << 16) | ((std::min)(g, 255u) << 8) | (std::min)(b, 255u);
+        }
+        file.write(reinterpret_cast<const char*>(row.data()), row.size() * sizeof(uint32_t));
+    }
+    return file.good();
+}
+
+} // namespace rendering
+} // namespace luaui
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "IBitmap.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace luaui {
+namespace rendering {
+
+class SoftwareSurface;
+struct DecodedImage;
+
+// CPU bitmap stored as premultiplied BGRA8
+class SoftwareBitmap : public IBitmap {
+public:
+    SoftwareBitmap() = default;
+    ~SoftwareBitmap() override = default;
+
+    // Creation
+    bool Initialize(int width, int height, PixelFormat format);
+    bool InitializeFromSurface(const SoftwareSurface& surface);
+    bool LoadFromFile(const std::wstring& filePath);
+    bool LoadFromMemory(const void* data, size_t size);
+
+    // IBitmap
+    int GetWidth() const override { return m_width; }
+    int GetHeight() const override { return m_height; }
+    Size GetSize() const override { return Size(static_cast<float>(m_width), static_cast<float>(m_height)); }
+    PixelFormat GetPixelFormat() const override { return PixelFormat::BGRA8; }
+    int GetBytesPerPixel() const override { return 4; }
+    float GetDpiX() const override { return m_dpiX; }
+    float GetDpiY() const override { return m_dpiY; }
+    void SetDpi(float dpiX, float dpiY) override { m_dpiX = dpiX; m_dpiY = dpiY; }
+    void* GetNativeBitmap(IRenderContext* context) override;
+    bool Lock(const Rect* rect, void** pixels, int* pitch) override;
+    void Unlock() override { m_locked = false; }
+    bool CopyFromMemory(const void* src, int srcPitch) override;
+
+    // Software specific
+    const uint32_t* GetPixels() const { return m_pixels.data(); }
+    uint32_t GetPixel(int x, int y) const { return m_pixels[static_cast<size_t>(y) * m_width + x]; }
+
+    // BitmapService decoder: decodes uncompressed BMP (minShortSide is ignored)
+    static bool DecodePixels(const uint8_t* data, size_t size, int minShortSide, DecodedImage& out);
+
+    // Write premultiplied BGRA rows as a 32-bit uncompressed BMP file
+    static bool SaveBmp(const std::wstring& filePath, const uint32_t* pixels,
+                        int width, int height, int stride);
+
+private:
+    bool DecodeBmp(const uint8_t* data, size_t size);
+
+    int m_width = 0;
+    int m_height = 0;
+    float m_dpiX = 96.0f;
+    float m_dpiY = 96.0f;
+    bool m_locked = false;
+    std::vector<uint32_t> m_pixels;
+};
+
+} // namespace rendering
+} // namespace luaui
@@ -0,0 +1,144 @@
+#include "SoftwareBrush.h"
+#include "SoftwareRasterizer.h"
+
+namespace luaui {
+namespace rendering {
+
+// ==================== Solid ====================
+
+void* SoftwareSolidColorBrush::GetNativeBrush(IRenderContext* context) {
+    (void)context;
+    return static_cast<ISoftwarePaint*>(this);
+}
+
+void SoftwareSolidColorBrush::ShadeSpan(const Transform& deviceToBrush, int x, int y, int count,
+                                        uint32_t* out) const {
+    (void)deviceToBrush; (void)x; (void)y;
+    SoftwareRasterizer::FillSpan(out, SoftwareRasterizer::PackColor(m_color), count);
+}
+
+// ==================== Gradient ramp ====================
+
+void SoftwareGradientRamp::SetStops(const std::vector<GradientStop>& stops) {
+    m_stops = stops;
+    std::stable_sort(m_stops.begin(), m_stops.end(),
+                     [](const GradientStop& a, const GradientStop& b) { return a.position < b.position; });
+
+    m_opaque = true;
+    for (const auto& s : m_stops) {
+        if (s.color.a < 1.0f) m_opaque = false;
+    }
+
+    if (m_stops.empty()) {
+        m_lut.fill(0);
+        m_opaque = false;
+        return;
+    }
+
+    // Interpolate in straight alpha, store premultiplied
+    size_t seg = 0;
+    for (int i = 0; i < 256; ++i) {
+        float t = i / 255.0f;
+        while (seg + 1 < m_stops.size() && m_stops[seg + 1].position < t) ++seg;
+        Color c;
+        if (t <= m_stops.front().position) {
+            c = m_stops.front().color;
+        } else if (t >= m_stops.back().position) {
+            c = m_stops.back().color;
+        } else {
+            const auto& a = m_stops[seg];
+            const auto& b = m_stops[(std::min)(seg + 1, m_stops.size() - 1)];
+            float span = b.position - a.position;
+            c = span > 0 ? a.color.Lerp(b.color, (t - a.position) / span) : b.color;
+        }
+        m_lut[i] = SoftwareRasterizer::PackColor(c);
+    }
+}
+
+namespace {
+
+Color AverageColor(const std::vector<GradientStop>& stops) {
+    if (stops.empty()) return Color::Transparent();
+    float r = 0, g = 0, b = 0, a = 0;
+    for (const auto& s : stops) { r += s.color.r; g += s.color.g; b += s.color.b; a += s.color.a; }
+    float n = static_cast<float>(stops.size());
+    return Color(r / n, g / n, b / n, a / n);
+}
+
+} // anonymous namespace
+
+// ==================== Linear ====================
+
+SoftwareLinearGradientBrush::SoftwareLinearGradientBrush(const Point& start, const Point& end,
+                                                         const std::vector<GradientStop>& stops)
+    : m_start(start), m_end(end) {
+    m_ramp.SetStops(stops);
+}
+
+void* SoftwareLinearGradientBrush::GetNativeBrush(IRenderContext* context) {
+    (void)context;
+    return static_cast<ISoftwarePaint*>(this);
+}
+
+Color SoftwareLinearGradientBrush::GetSolidColor() const {
+    return AverageColor(m_ramp.GetStops());
+}
+
+void SoftwareLinearGradientBrush::ShadeSpan(const Transform& deviceToBrush, int x, int y, int count,
+                                            uint32_t* out) const {
+    float dx = m_end.x - m_start.x;
+    float dy = m_end.y - m_start.y;
+    float len2 = dx * dx + dy * dy;
+    if (len2 <= 0) {
+        SoftwareRasterizer::FillSpan(out, m_ramp.Sample(0), count);
+        return;
+    }
+    // t is affine in device x, so step it incrementally along the span
+    Point p0 = deviceToBrush.TransformPoint(Point(x + 0.5f, y + 0.5f));
+    Point p1 = deviceToBrush.TransformPoint(Point(x + 1.5f, y + 0.5f));
+    float t = ((p0.x - m_start.x) * dx + (p0.y - m_start.y) * dy) / len2;
+    float dt = ((p1.x - p0.x) * dx + (p1.y - p0.y) * dy) / len2;
+    for (int i = 0; i < count; ++i) {
+        out[i] = m_ramp.Sample(t);
+        t += dt;
+    }
+}
+
+// ==================== Radial ====================
+
+SoftwareRadialGradientBrush::SoftwareRadialGradientBrush(const Point& center, float rx, float ry,
+                                                         const std::vector<GradientStop>& stops)
+    : m_center(center), m_radiusX(rx), m_radiusY(ry) {
+    m_ramp.SetStops(stops);
+}
+
+void* SoftwareRadialGradientBrush::GetNativeBrush(IRenderContext* context) {
+    (void)context;
+    return static_cast<ISoftwarePaint*>(this);
+}
+
+Color SoftwareRadialGradientBrush::GetSolidColor() const {
+    return AverageColor(m_ramp.GetStops());
+}
+
+void SoftwareRadialGradientBrush::ShadeSpan(const Transform& deviceToBrush, int x, int y, int count,
+                                            uint32_t* out) const {
+    if (m_radiusX <= 0 || m_radiusY <= 0) {
+        SoftwareRasterizer::FillSpan(out, m_ramp.Sample(1), count);
+        return;
+    }
+    float irx = 1.0f / m_radiusX;
+    float iry = 1.0f / m_radiusY;
+    Point p = deviceToBrush.TransformPoint(Point(x + 0.5f, y + 0.5f));
+    Point p1 = deviceToBrush.TransformPoint(Point(x + 1.5f, y + 0.5f));
+    float ux = (p.x - m_center.x) * irx, uy = (p.y - m_center.y) * iry;
+    float sx = (p1.x - p.x) * irx, sy = (p1.y - p.y) * iry;
+    for (int i = 0; i < count; ++i) {
+        out[i] = m_ramp.Sample(std::sqrt(ux * ux + uy * uy));
+        ux += sx;
+        uy += sy;
+    }
+}
+
+} // namespace rendering
+} // namespace luaui
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "IBrush.h"
+#include <array>
+#include <cstdint>
+
+namespace luaui {
+namespace rendering {
+
+// Pixel source used by the software rasterizer when filling spans
+class ISoftwarePaint {
+public:
+    virtual ~ISoftwarePaint() = default;
+
+    virtual bool IsSolid() const = 0;
+    virtual Color GetSolidColor() const = 0;
+
+    // Produce `count` premultiplied BGRA pixels for device row `y` starting at `x`.
+    // `deviceToBrush` maps device pixel space into the brush coordinate space.
+    virtual void ShadeSpan(const Transform& deviceToBrush, int x, int y, int count,
+                           uint32_t* out) const = 0;
+};
+
+// Software solid color brush
+class SoftwareSolidColorBrush : public ISolidColorBrush, public ISoftwarePaint {
+public:
+    explicit SoftwareSolidColorBrush(const Color& color) : m_color(color) {}
+
+    // IBrush
+    BrushType GetType() const override { return BrushType::Solid; }
+    void* GetNativeBrush(IRenderContext* context) override;
+
+    // ISolidColorBrush
+    void SetColor(const Color& color) override { m_color = color; }
+    Color GetColor() const override { return m_color; }
+
+    // ISoftwarePaint
+    bool IsSolid() const override { return true; }
+    Color GetSolidColor() const override { return m_color; }
+    void ShadeSpan(const Transform& deviceToBrush, int x, int y, int count,
+                   uint32_t* out) const override;
+
+private:
+    Color m_color;
+};
+
+// Gradient lookup table shared by linear and radial brushes
+class SoftwareGradientRamp {
+public:
+    void SetStops(const std::vector<GradientStop>& stops);
+    const std::vector<GradientStop>& GetStops() const { return m_stops; }
+
+    // t is clamped to [0, 1]
+    uint32_t Sample(float t) const {
+        int i = static_cast<int>(std::clamp(t, 0.0f, 1.0f) * 255.0f + 0.5f);
+        return m_lut[i];
+    }
+    bool IsOpaque() const { return m_opaque; }
+
+private:
+    std::vector<GradientStop> m_stops;
+    std::array<uint32_t, 256> m_lut{};
+    bool m_opaque = true;
+};
+
+// Software linear gradient brush
+class SoftwareLinearGradientBrush : public ILinearGradientBrush, public ISoftwarePaint {
+public:
+    SoftwareLinearGradientBrush(const Point& start, const Point& end,
+                                const std::vector<GradientStop>& stops);
+
+    // IBrush
+    BrushType GetType() const override { return BrushType::LinearGradient; }
+    void* GetNativeBrush(IRenderContext* context) override;
+
+    // ILinearGradientBrush
+    void SetStartPoint(const Point& point) override { m_start = point; }
+    void SetEndPoint(const Point& point) override { m_end = point; }
+    void SetGradientStops(const std::vector<GradientStop>& stops) override { m_ramp.SetStops(stops); }
+    Point GetStartPoint() const override { return m_start; }
+    Point GetEndPoint() const override { return m_end; }
+
+    // ISoftwarePaint
+    bool IsSolid() const override { return false; }
+    Color GetSolidColor() const override;
+    void ShadeSpan(const Transform& deviceToBrush, int x, int y, int count,
+                   uint32_t* out) const override;
+
+private:
+    Point m_start;
+    Point m_end;
+    SoftwareGradientRamp m_ramp;
+};
+
+// Software radial gradient brush
+class SoftwareRadialGradientBrush : public IRadialGradientBrush, public ISoftwarePaint {
+public:
+    SoftwareRadialGradientBrush(const Point& center, float rx, float ry,
+                                const std::vector<GradientStop>& stops);
+
+    // IBrush
+    BrushType GetType() const override { return BrushType::RadialGradient; }
+    void* GetNativeBrush(IRenderContext* context) override;
+
+    // IRadialGradientBrush
+    void SetCenter(const Point& point) override { m_center = point; }
+    void SetRadius(float radiusX, float radiusY) override { m_radiusX = radiusX; m_radiusY = radiusY; }
+    void SetGradientStops(const std::vector<GradientStop>& stops) override { m_ramp.SetStops(stops); }
+    Point GetCenter() const override { return m_center; }
+    float GetRadiusX() const override { return m_radiusX; }
+    float GetRadiusY() const override { return m_radiusY; }
+
+    // ISoftwarePaint
+    bool IsSolid() const override { return false; }
+    Color GetSolidColor() const override;
+    void ShadeSpan(const Transform& deviceToBrush, int x, int y, int count,
+                   uint32_t* out) const override;
+
+private:
+    Point m_center;
+    float m_radiusX;
+    float m_radiusY;
+    SoftwareGradientRamp m_ramp;
+};
+
+} // namespace rendering
+} // namespace luaui
@@ -0,0 +1,234 @@
+#include "SoftwareGeometry.h"
+#include <cmath>
+
+namespace luaui {
+namespace rendering {
+
+namespace {
+
+// Non-zero winding test against filled figures
+bool FiguresContain(const SoftwareFigureList& figures, const Point& p) {
+    int winding = 0;
+    for (const auto& fig : figures) {
+        if (!fig.filled) continue;
+        const auto& pts = fig.points;
+        size_t n = pts.size();
+        if (n < 3) continue;
+        for (size_t i = 0; i < n; ++i) {
+            const Point& a = pts[i];
+            const Point& b = pts[(i + 1) % n];
+            float side = (b.x - a.x) * (p.y - a.y) - (p.x - a.x) * (b.y - a.y);
+            if (a.y <= p.y) {
+                if (b.y > p.y && side > 0) ++winding;
+            } else {
+                if (b.y <= p.y && side < 0) --winding;
+            }
+        }
+    }
+    return winding != 0;
+}
+
+float DistanceToSegment(const Point& p, const Point& a, const Point& b) {
+    float dx = b.x - a.x, dy = b.y - a.y;
+    float len2 = dx * dx + dy * dy;
+    float t = len2 > 0 ? std::clamp(((p.x - a.x) * dx + (p.y - a.y) * dy) / len2, 0.0f, 1.0f) : 0.0f;
+    float ex = a.x + dx * t - p.x, ey = a.y + dy * t - p.y;
+    return std::sqrt(ex * ex + ey * ey);
+}
+
+Rect UnionRect(const Rect& a, const Rect& b) {
+    if (a.IsEmpty()) return b;
+    if (b.IsEmpty()) return a;
+    float x0 = (std::min)(a.x, b.x), y0 = (std::min)(a.y, b.y);
+    float x1 = (std::max)(a.Right(), b.Right()), y1 = (std::max)(a.Bottom(), b.Bottom());
+    return Rect(x0, y0, x1 - x0, y1 - y0);
+}
+
+} // anonymous namespace
+
+// ==================== SoftwareShape ====================
+
+Rect SoftwareShape::GetBounds() const {
+    if (IsCombined()) {
+        Rect a = first->GetBounds();
+        Rect b = second->GetBounds();
+        switch (mode) {
+            case CombineMode::Intersect: return a.Intersect(b);
+            case CombineMode::Exclude: return a;
+            default: return UnionRect(a, b);
+        }
+    }
+    float x0 = 1e30f, y0 = 1e30f, x1 = -1e30f, y1 = -1e30f;
+    for (const auto& fig : figures) {
+        for (const auto& p : fig.points) {
+            x0 = (std::min)(x0, p.x); y0 = (std::min)(y0, p.y);
+            x1 = (std::max)(x1, p.x); y1 = (std::max)(y1, p.y);
+        }
+    }
+    if (x0 > x1) return Rect();
+    return Rect(x0, y0, x1 - x0, y1 - y0);
+}
+
+bool SoftwareShape::FillContains(const Point& point) const {
+    if (IsCombined()) {
+        bool a = first->FillContains(point);
+        bool b = second->FillContains(point);
+        switch (mode) {
+            case CombineMode::Union: return a || b;
+            case CombineMode::Intersect: return a && b;
+            case CombineMode::Xor: return a != b;
+            case CombineMode::Exclude: return a && !b;
+        }
+        return false;
+    }
+    return FiguresContain(figures, point);
+}
+
+bool SoftwareShape::StrokeContains(const Point& point, float strokeWidth) const {
+    if (IsCombined()) {
+        return first->StrokeContains(point, strokeWidth) || second->StrokeContains(point, strokeWidth);
+    }
+    float half = strokeWidth * 0.5f;
+    for (const auto& fig : figures) {
+        const auto& pts = fig.points;
+        size_t n = pts.size();
+        if (n == 0) continue;
+        if (n == 1 && DistanceToSegment(point, pts[0], pts[0]) <= half) return true;
+        size_t segs = fig.closed ? n : n - 1;
+        for (size_t i = 0; i < segs; ++i) {
+            if (DistanceToSegment(point, pts[i], pts[(i + 1) % n]) <= half) return true;
+        }
+    }
+    return false;
+}
+
+// ==================== Simple geometries ====================
+
+void SoftwareRectangleGeometry::SetRect(const Rect& rect) {
+    m_rect = rect;
+    m_shape.figures.clear();
+    SoftwarePathBuilder::AddRect(m_shape.figures, rect);
+}
+
+SoftwareRoundedRectangleGeometry::SoftwareRoundedRectangleGeometry(const Rect& rect,
+                                                                   const CornerRadius& radius)
+    : m_rect(rect), m_radius(radius) {
+    Rebuild();
+}
+
+void SoftwareRoundedRectangleGeometry::Rebuild() {
+    m_shape.figures.clear();
+    SoftwarePathBuilder::AddRoundedRect(m_shape.figures, m_rect, m_radius);
+}
+
+SoftwareEllipseGeometry::SoftwareEllipseGeometry(const Point& center, float rx, float ry)
+    : m_center(center), m_radiusX(rx), m_radiusY(ry) {
+    Rebuild();
+}
+
+void SoftwareEllipseGeometry::Rebuild() {
+    m_shape.figures.clear();
+    SoftwarePathBuilder::AddEllipse(m_shape.figures, m_center, m_radiusX, m_radiusY);
+}
+
+// ==================== Path ====================
+
+SoftwareFigure* SoftwarePathGeometry::CurrentFigure() {
+    if (!m_inFigure || m_shape.figures.empty()) return nullptr;
+    return &m_shape.figures.back();
+}
+
+Point SoftwarePathGeometry::LastPoint() const {
+    if (m_shape.figures.empty() || m_shape.figures.back().points.empty()) return Point();
+    return m_shape.figures.back().points.back();
+}
+
+void SoftwarePathGeometry::BeginFigure(const Point& startPoint, bool filled) {
+    SoftwareFigure fig;
+    fig.points.push_back(startPoint);
+    fig.filled = filled;
+    fig.closed = false;
+    m_shape.figures.push_back(std::move(fig));
+    m_inFigure = true;
+}
+
+void SoftwarePathGeometry::EndFigure(bool closed) {
+    if (auto* fig = CurrentFigure()) fig->closed = closed;
+    m_inFigure = false;
+}
+
+void SoftwarePathGeometry::AddLine(const Point& point) {
+    if (auto* fig = CurrentFigure()) fig->points.push_back(point);
+}
+
+void SoftwarePathGeometry::AddQuadraticBezier(const Point& control, const Point& end) {
+    if (auto* fig = CurrentFigure()) {
+        SoftwarePathBuilder::FlattenQuadratic(fig->points, LastPoint(), control, end);
+    }
+}
+
+void SoftwarePathGeometry::AddCubicBezier(const Point& control1, const Point& control2,
+                                          const Point& end) {
+    if (auto* fig = CurrentFigure()) {
+        SoftwarePathBuilder::FlattenCubic(fig->points, LastPoint(), control1, control2, end);
+    }
+}
+
+void SoftwarePathGeometry::AddArc(const Point& end, const Size& size, float rotation,
+                                  bool isLargeArc, bool sweepClockwise) {
+    if (auto* fig = CurrentFigure()) {
+        SoftwarePathBuilder::FlattenArc(fig->points, LastPoint(), end, size, rotation,
+                                        isLargeArc, sweepClockwise);
+    }
+}
+
+void SoftwarePathGeometry::AddRectangle(const Rect& rect) {
+    bool wasInFigure = m_inFigure;
+    SoftwarePathBuilder::AddRect(m_shape.figures, rect);
+    // Keep appending to the open figure, if any, after the closed shape
+    if (wasInFigure) std::swap(m_shape.figures[m_shape.figures.size() - 1],
+                               m_shape.figures[m_shape.figures.size() - 2]);
+}
+
+void SoftwarePathGeometry::AddRoundedRectangle(const Rect& rect, const CornerRadius& radius) {
+    bool wasInFigure = m_inFigure;
+    SoftwarePathBuilder::AddRoundedRect(m_shape.figures, rect, radius);
+    if (wasInFigure) std::swap(m_shape.figures[m_shape.figures.size() - 1],
+                               m_shape.figures[m_shape.figures.size() - 2]);
+}
+
+void SoftwarePathGeometry::AddEllipse(const Point& center, float rx, float ry) {
+    size_t before = m_shape.figures.size();
+    bool wasInFigure = m_inFigure;
+    SoftwarePathBuilder::AddEllipse(m_shape.figures, center, rx, ry);
+    if (wasInFigure && m_shape.figures.size() > before) {
+        std::swap(m_shape.figures[m_shape.figures.size() - 1],
+                  m_shape.figures[m_shape.figures.size() - 2]);
+    }
+}
+
+void SoftwarePathGeometry::Close() {
+    if (m_inFigure) EndFigure(false);
+}
+
+void SoftwarePathGeometry::Clear() {
+    m_shape.figures.clear();
+    m_inFigure = false;
+}
+
+// ==================== Combined ====================
+
+void SoftwareCombinedGeometry::SetGeometries(IGeometry* geom1, IGeometry* geom2, CombineMode mode) {
+    auto snapshot = [](IGeometry* g) -> std::shared_ptr<const SoftwareShape> {
+        auto* sg = dynamic_cast<ISoftwareGeometry*>(g);
+        if (!sg) return std::make_shared<SoftwareShape>();
+        return std::make_shared<SoftwareShape>(sg->GetShape());
+    };
+    m_shape = SoftwareShape();
+    m_shape.first = snapshot(geom1);
+    m_shape.second = snapshot(geom2);
+    m_shape.mode = mode;
+}
+
+} // namespace rendering
+} // namespace luaui
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "IGeometry.h"
+#include "SoftwareRasterizer.h"
+#include <memory>
+
+namespace luaui {
+namespace rendering {
+
+// Flattened, immutable description of a geometry in its local space.
+// Combined geometries keep snapshots of both operands and are resolved
+// per pixel when rasterized.
+struct SoftwareShape {
+    SoftwareFigureList figures;
+    std::shared_ptr<const SoftwareShape> first;
+    std::shared_ptr<const SoftwareShape> second;
+    CombineMode mode = CombineMode::Union;
+
+    bool IsCombined() const { return first && second; }
+
+    Rect GetBounds() const;
+    bool FillContains(const Point& point) const;
+    bool StrokeContains(const Point& point, float strokeWidth) const;
+};
+
+// Access to the flattened shape of any software geometry
+class ISoftwareGeometry {
+public:
+    virtual ~ISoftwareGeometry() = default;
+    virtual const SoftwareShape& GetShape() const = 0;
+};
+
+// Shared IGeometry plumbing for all software geometry types
+template <typename TInterface>
+class SoftwareGeometryBase : public TInterface, public ISoftwareGeometry {
+public:
+    void* GetNativeGeometry(IRenderContext* context) const override {
+        (void)context;
+        return const_cast<SoftwareShape*>(&GetShape());
+    }
+
+    Rect GetBounds() const override { return GetShape().GetBounds(); }
+
+    Rect GetBoundsWithStroke(const StrokeStyle& stroke) const override {
+        Rect b = GetBounds();
+        float h = stroke.width * 0.5f;
+        return Rect(b.x - h, b.y - h, b.width + stroke.width, b.height + stroke.width);
+    }
+
+    bool FillContains(const Point& point) const override { return GetShape().FillContains(point); }
+
+    bool StrokeContains(const Point& point, const StrokeStyle& stroke) const override {
+        return GetShape().StrokeContains(point, stroke.width);
+    }
+
+    const SoftwareShape& GetShape() const override { return m_shape; }
+
+protected:
+    SoftwareShape m_shape;
+};
+
+// Rectangle
+class SoftwareRectangleGeometry : public SoftwareGeometryBase<IRectangleGeometry> {
+public:
+    explicit SoftwareRectangleGeometry(const Rect& rect) { SetRect(rect); }
+
+    GeometryType GetType() const override { return GeometryType::Rectangle; }
+    void SetRect(const Rect& rect) override;
+    Rect GetRect() const override { return m_rect; }
+
+private:
+    Rect m_rect;
+};
+
+// Rounded rectangle
+class SoftwareRoundedRectangleGeometry : public SoftwareGeometryBase<IRoundedRectangleGeometry> {
+public:
+    SoftwareRoundedRectangleGeometry(const Rect& rect, const CornerRadius& radius);
+
+    GeometryType GetType() const override { return GeometryType::RoundedRectangle; }
+    void SetRect(const Rect& rect) override { m_rect = rect; Rebuild(); }
+    void SetCornerRadius(const CornerRadius& radius) override { m_radius = radius; Rebuild(); }
+    Rect GetRect() const override { return m_rect; }
+    CornerRadius GetCornerRadius() const override { return m_radius; }
+
+private:
+    void Rebuild();
+
+    Rect m_rect;
+    CornerRadius m_radius;
+};
+
+// Ellipse
+class SoftwareEllipseGeometry : public SoftwareGeometryBase<IEllipseGeometry> {
+public:
+    SoftwareEllipseGeometry(const Point& center, float rx, float ry);
+
+    GeometryType GetType() const override { return GeometryType::Ellipse; }
+    void SetCenter(const Point& center) override { m_center = center; Rebuild(); }
+    void SetRadius(float rx, float ry) override { m_radiusX = rx; m_radiusY = ry; Rebuild(); }
+    Point GetCenter() const override { return m_center; }
+    float GetRadiusX() const override { return m_radiusX; }
+    float GetRadiusY() const override { return m_radiusY; }
+
+private:
+    void Rebuild();
+
+    Point m_center;
+    float m_radiusX = 0;
+    float m_radiusY = 0;
+};
+
+// Path: curves are flattened as they are added
+class SoftwarePathGeometry : public SoftwareGeometryBase<IPathGeometry> {
+public:
+    GeometryType GetType() const override { return GeometryType::Path; }
+
+    void BeginFigure(const Point& startPoint, bool filled = true) override;
+    void EndFigure(bool closed = true) override;
+
+    void AddLine(const Point& point) override;
+    void AddQuadraticBezier(const Point& control, const Point& end) override;
+    void AddCubicBezier(const Point& control1, const Point& control2, const Point& end) override;
+    void AddArc(const Point& end, const Size& size, float rotation, bool isLargeArc,
+                bool sweepClockwise) override;
+
+    void AddRectangle(const Rect& rect) override;
+    void AddRoundedRectangle(const Rect& rect, const CornerRadius& radius) override;
+    void AddEllipse(const Point& center, float rx, float ry) override;
+
+    void Close() override;
+    void Clear() override;
+
+private:
+    SoftwareFigure* CurrentFigure();
+    Point LastPoint() const;
+
+    bool m_inFigure = false;
+};
+
+// Combined geometry: snapshots the operand shapes at SetGeometries time
+class SoftwareCombinedGeometry : public SoftwareGeometryBase<ICombinedGeometry> {
+public:
+    GeometryType GetType() const override { return GeometryType::Combined; }
+    void SetGeometries(IGeometry* geom1, IGeometry* geom2, CombineMode mode) override;
+};
+
+} // namespace rendering
+} // namespace luaui
@@ -0,0 +1,596 @@
+#include "SoftwareRasterizer.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LUAUI_SOFTWARE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace luaui {
+namespace rendering {
+
+namespace {
+
+constexpr float kPi = 3.14159265358979f;
+
+// Exact (x * a) / 255 rounded, for 8-bit x and a
+inline uint32_t MulDiv255(uint32_t x, uint32_t a) {
+    uint32_t t = x * a + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+inline Point Normalize(const Point& v) {
+    float len = std::sqrt(v.x * v.x + v.y * v.y);
+    if (len <= 0) return Point(0, 0);
+    return Point(v.x / len, v.y / len);
+}
+
+inline float Cross(const Point& a, const Point& b) { return a.x * b.y - a.y * b.x; }
+
+} // anonymous namespace
+
+// ==================== SoftwareSurface ====================
+
+void SoftwareSurface::Resize(int width, int height) {
+    m_width = (std::max)(0, width);
+    m_height = (std::max)(0, height);
+    m_pixels.assign(static_cast<size_t>(m_width) * m_height, 0);
+}
+
+void SoftwareSurface::Clear(uint32_t pixel) {
+    std::fill(m_pixels.begin(), m_pixels.end(), pixel);
+}
+
+void SoftwareSurface::Fill(const PixelRect& rect, uint32_t pixel) {
+    PixelRect r = rect.Intersect(GetBounds());
+    for (int y = r.y0; y < r.y1; ++y) {
+        SoftwareRasterizer::FillSpan(GetRow(y) + r.x0, pixel, r.Width());
+    }
+}
+
+// ==================== Coverage accumulation ====================
+
+void SoftwareRasterizer::Rasterize(const SoftwarePolygonList& polygons, const PixelRect& clip,
+                                   bool antialias, CoverageMask& out) {
+    out.bounds = PixelRect();
+
+    float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f;
+    for (const auto& poly : polygons) {
+        for (const auto& p : poly) {
+            minX = (std::min)(minX, p.x); maxX = (std::max)(maxX, p.x);
+            minY = (std::min)(minY, p.y); maxY = (std::max)(maxY, p.y);
+        }
+    }
+    if (minX > maxX || !std::isfinite(minX) || !std::isfinite(maxX) ||
+        !std::isfinite(minY) || !std::isfinite(maxY)) {
+        return;
+    }
+
+    PixelRect bounds = PixelRect(static_cast<int>(std::floor(minX)), static_cast<int>(std::floor(minY)),
+                                 static_cast<int>(std::ceil(maxX)), static_cast<int>(std::ceil(maxY)));
+    bounds = bounds.Intersect(clip);
+    if (bounds.IsEmpty()) return;
+
+    const int w = bounds.Width();
+    const int h = bounds.Height();
+    m_width = w + 2;
+    m_height = h;
+    m_accum.assign(static_cast<size_t>(m_width) * h, 0.0f);
+
+    const float ox = static_cast<float>(bounds.x0);
+    const float oy = static_cast<float>(bounds.y0);
+    for (const auto& poly : polygons) {
+        size_t n = poly.size();
+        if (n < 3) continue;
+        for (size_t i = 0; i < n; ++i) {
+            const Point& a = poly[i];
+            const Point& b = poly[(i + 1) % n];
+            AccumulateLine(a.x - ox, a.y - oy, b.x - ox, b.y - oy);
+        }
+    }
+
+    out.bounds = bounds;
+    out.data.resize(static_cast<size_t>(w) * h);
+    for (int y = 0; y < h; ++y) {
+        const float* src = m_accum.data() + static_cast<size_t>(y) * m_width;
+        uint8_t* dst = out.data.data() + static_cast<size_t>(y) * w;
+        float acc = 0;
+        if (antialias) {
+            for (int x = 0; x < w; ++x) {
+                acc += src[x];
+                float c = std::fabs(acc);
+                dst[x] = c >= 1.0f ? 255 : static_cast<uint8_t>(c * 255.0f + 0.5f);
+            }
+        } else {
+            for (int x = 0; x < w; ++x) {
+                acc += src[x];
+                dst[x] = std::fabs(acc) >= 0.5f ? 255 : 0;
+            }
+        }
+    }
+}
+
+void SoftwareRasterizer::AccumulateLine(float x0, float y0, float x1, float y1) {
+    if (y0 == y1) return;
+
+    float dir = 1.0f;
+    if (y0 > y1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+        dir = -1.0f;
+    }
+
+    const float w = static_cast<float>(m_width - 2);
+    const float dxdy = (x1 - x0) / (y1 - y0);
+    int yStart = (std::max)(0, static_cast<int>(std::floor(y0)));
+    int yEnd = (std::min)(m_height, static_cast<int>(std::ceil(y1)));
+    float x = x0 + ((std::max)(static_cast<float>(yStart), y0) - y0) * dxdy;
+
+    for (int y = yStart; y < yEnd; ++y) {
+        float* row = m_accum.data() + static_cast<size_t>(y) * m_width;
+        float top = (std::max)(static_cast<float>(y), y0);
+        float bottom = (std::min)(static_cast<float>(y + 1), y1);
+        float dy = bottom - top;
+        float xnext = x + dxdy * dy;
+        float d = dy * dir;
+
+        float xa = std::clamp((std::min)(x, xnext), 0.0f, w);
+        float xb = std::clamp((std::max)(x, xnext), 0.0f, w);
+        float xaFloor = std::floor(xa);
+        int xai = static_cast<int>(xaFloor);
+        int xbi = static_cast<int>(std::ceil(xb));
+
+        if (xbi <= xai + 1) {
+            // Edge stays within one pixel column: split area by the mid x
+            float xmf = 0.5f * (xa + xb) - xaFloor;
+            row[xai] += d - d * xmf;
+            row[xai + 1] += d * xmf;
+        } else {
+            // Edge spans several columns: distribute trapezoid areas
+            float s = 1.0f / (xb - xa);
+            float xaf = xa - xaFloor;
+            float a0 = 0.5f * s * (1.0f - xaf) * (1.0f - xaf);
+            float xbf = xb - static_cast<float>(xbi) + 1.0f;
+            float am = 0.5f * s * xbf * xbf;
+            row[xai] += d * a0;
+            if (xbi == xai + 2) {
+                row[xai + 1] += d * (1.0f - a0 - am);
+            } else {
+                float a1 = s * (1.5f - xaf);
+                row[xai + 1] += d * (a1 - a0);
+                for (int xi = xai + 2; xi < xbi - 1; ++xi) {
+                    row[xi] += d * s;
+                }
+                float a2 = a1 + static_cast<float>(xbi - xai - 3) * s;
+                row[xbi - 1] += d * (1.0f - a2 - am);
+            }
+            row[xbi] += d * am;
+        }
+        x = xnext;
+    }
+}
+
+// ==================== Span operations ====================
+
+uint32_t SoftwareRasterizer::PackColor(const Color& color, float opacity) {
+    float a = std::clamp(color.a * opacity, 0.0f, 1.0f);
+    uint32_t A = static_cast<uint32_t>(a * 255.0f + 0.5f);
+    uint32_t R = static_cast<uint32_t>(color.r * a * 255.0f + 0.5f);
+    uint32_t G = static_cast<uint32_t>(color.g * a * 255.0f + 0.5f);
+    uint32_t B = static_cast<uint32_t>(color.b * a * 255.0f + 0.5f);
+    return (A << 24) | (R << 16) | (G << 8) | B;
+}
+
+uint32_t SoftwareRasterizer::ScalePixel(uint32_t p, uint32_t alpha) {
+    if (alpha >= 255) return p;
+    if (alpha == 0) return 0;
+    return (MulDiv255(p >> 24, alpha) << 24) |
+           (MulDiv255((p >> 16) & 0xFF, alpha) << 16) |
+           (MulDiv255((p >> 8) & 0xFF, alpha) << 8) |
+           MulDiv255(p & 0xFF, alpha);
+}
+
+uint32_t SoftwareRasterizer::BlendPixel(uint32_t dst, uint32_t src) {
+    uint32_t sa = src >> 24;
+    if (sa == 255) return src;
+    if (src == 0) return dst;
+    return src + ScalePixel(dst, 255 - sa);
+}
+
+void SoftwareRasterizer::FillSpan(uint32_t* dst, uint32_t color, int count) {
+    int i = 0;
+#ifdef LUAUI_SOFTWARE_SSE2
+    __m128i c = _mm_set1_epi32(static_cast<int>(color));
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), c);
+    }
+#endif
+    for (; i < count; ++i) dst[i] = color;
+}
+
+void SoftwareRasterizer::BlendSolidSpan(uint32_t* dst, uint32_t color, int count) {
+    uint32_t sa = color >> 24;
+    if (sa == 255) { FillSpan(dst, color, count); return; }
+    if (color == 0) return;
+    uint32_t inv = 255 - sa;
+    int i = 0;
+#ifdef LUAUI_SOFTWARE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src = _mm_set1_epi32(static_cast<int>(color));
+    const __m128i invA = _mm_set1_epi16(static_cast<short>(inv));
+    const __m128i bias = _mm_set1_epi16(128);
+    for (; i + 4 <= count; i += 4) {
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), invA), bias);
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), invA), bias);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        __m128i r = _mm_add_epi8(_mm_packus_epi16(lo, hi), src);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), r);
+    }
+#endif
+    for (; i < count; ++i) dst[i] = color + ScalePixel(dst[i], inv);
+}
+
+void SoftwareRasterizer::BlendSpan(uint32_t* dst, const uint32_t* src, int count) {
+    int i = 0;
+#ifdef LUAUI_SOFTWARE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(255);
+    const __m128i bias = _mm_set1_epi16(128);
+    for (; i + 4 <= count; i += 4) {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        // Broadcast each source alpha to its four channels
+        __m128i sLo = _mm_unpacklo_epi8(s, zero);
+        __m128i sHi = _mm_unpackhi_epi8(s, zero);
+        __m128i aLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sLo, 0xFF), 0xFF);
+        __m128i aHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sHi, 0xFF), 0xFF);
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_sub_epi16(ff, aLo)), bias);
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_sub_epi16(ff, aHi)), bias);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        __m128i r = _mm_add_epi8(_mm_packus_epi16(lo, hi), s);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), r);
+    }
+#endif
+    for (; i < count; ++i) dst[i] = BlendPixel(dst[i], src[i]);
+}
+
+void SoftwareRasterizer::ScaleSpan(uint32_t* pixels, const uint8_t* coverage, int count) {
+    for (int i = 0; i < count; ++i) {
+        pixels[i] = ScalePixel(pixels[i], coverage[i]);
+    }
+}
+
+void SoftwareRasterizer::ScaleSpan(uint32_t* pixels, uint32_t alpha, int count) {
+    if (alpha >= 255) return;
+    int i = 0;
+#ifdef LUAUI_SOFTWARE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i a = _mm_set1_epi16(static_cast<short>(alpha));
+    const __m128i bias = _mm_set1_epi16(128);
+    for (; i + 4 <= count; i += 4) {
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(p, zero), a), bias);
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(p, zero), a), bias);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    for (; i < count; ++i) pixels[i] = ScalePixel(pixels[i], alpha);
+}
+
+// ==================== Path flattening ====================
+
+int SoftwarePathBuilder::SegmentsForRadius(float radius) {
+    if (radius <= kTolerance) return 4;
+    float step = 2.0f * std::acos(1.0f - kTolerance / radius);
+    int n = static_cast<int>(std::ceil(2.0f * kPi / step));
+    return std::clamp(n, 8, 512);
+}
+
+void SoftwarePathBuilder::AddRect(SoftwareFigureList& figures, const Rect& rect) {
+    SoftwareFigure fig;
+    fig.points = {
+        Point(rect.x, rect.y), Point(rect.Right(), rect.y),
+        Point(rect.Right(), rect.Bottom()), Point(rect.x, rect.Bottom())
+    };
+    figures.push_back(std::move(fig));
+}
+
+void SoftwarePathBuilder::AddRoundedRect(SoftwareFigureList& figures, const Rect& rect,
+                                         const CornerRadius& radius, float scale) {
+    float maxR = (std::min)(rect.width, rect.height) * 0.5f;
+    float tl = std::clamp(radius.topLeft, 0.0f, maxR);
+    float tr = std::clamp(radius.topRight, 0.0f, maxR);
+    float br = std::clamp(radius.bottomRight, 0.0f, maxR);
+    float bl = std::clamp(radius.bottomLeft, 0.0f, maxR);
+    if (tl <= 0 && tr <= 0 && br <= 0 && bl <= 0) {
+        AddRect(figures, rect);
+        return;
+    }
+
+    SoftwareFigure fig;
+    auto corner = [&](float cx, float cy, float r, float startAngle) {
+        if (r <= 0) {
+            fig.points.emplace_back(cx, cy);
+            return;
+        }
+        int n = (std::max)(2, SegmentsForRadius(r * scale) / 4);
+        for (int i = 0; i <= n; ++i) {
+            float a = startAngle + (kPi * 0.5f) * i / n;
+            fig.points.emplace_back(cx + std::cos(a) * r, cy + std::sin(a) * r);
+        }
+    };
+    // Clockwise in screen space (y down): top-left -> top-right -> bottom-right -> bottom-left
+    if (tl > 0) corner(rect.x + tl, rect.y + tl, tl, kPi); else corner(rect.x, rect.y, 0, 0);
+    if (tr > 0) corner(rect.Right() - tr, rect.y + tr, tr, kPi * 1.5f); else corner(rect.Right(), rect.y, 0, 0);
+    if (br > 0) corner(rect.Right() - br, rect.Bottom() - br, br, 0); else corner(rect.Right(), rect.Bottom(), 0, 0);
+    if (bl > 0) corner(rect.x + bl, rect.Bottom() - bl, bl, kPi * 0.5f); else corner(rect.x, rect.Bottom(), 0, 0);
+    figures.push_back(std::move(fig));
+}
+
+void SoftwarePathBuilder::AddEllipse(SoftwareFigureList& figures, const Point& center,
+                                     float rx, float ry, float scale) {
+    if (rx <= 0 || ry <= 0) return;
+    int n = SegmentsForRadius((std::max)(rx, ry) * scale);
+    SoftwareFigure fig;
+    fig.points.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        float a = 2.0f * kPi * i / n;
+        fig.points.emplace_back(center.x + std::cos(a) * rx, center.y + std::sin(a) * ry);
+    }
+    figures.push_back(std::move(fig));
+}
+
+void SoftwarePathBuilder::FlattenQuadratic(SoftwarePolygon& out, const Point& p0, const Point& c,
+                                           const Point& p1) {
+    float dd = std::fabs(p0.x - 2 * c.x + p1.x) + std::fabs(p0.y - 2 * c.y + p1.y);
+    int n = std::clamp(static_cast<int>(std::ceil(std::sqrt(dd / (4.0f * kTolerance)))), 1, 256);
+    for (int i = 1; i <= n; ++i) {
+        float t = static_cast<float>(i) / n;
+        float mt = 1 - t;
+        out.emplace_back(mt * mt * p0.x + 2 * mt * t * c.x + t * t * p1.x,
+                         mt * mt * p0.y + 2 * mt * t * c.y + t * t * p1.y);
+    }
+}
+
+void SoftwarePathBuilder::FlattenCubic(SoftwarePolygon& out, const Point& p0, const Point& c1,
+                                       const Point& c2, const Point& p1) {
+    float ddx = (std::max)(std::fabs(p0.x - 2 * c1.x + c2.x), std::fabs(c1.x - 2 * c2.x + p1.x));
+    float ddy = (std::max)(std::fabs(p0.y - 2 * c1.y + c2.y), std::fabs(c1.y - 2 * c2.y + p1.y));
+    float dd = std::sqrt(ddx * ddx + ddy * ddy);
+    int n = std::clamp(static_cast<int>(std::ceil(std::sqrt(0.75f * dd / kTolerance))), 1, 256);
+    for (int i = 1; i <= n; ++i) {
+        float t = static_cast<float>(i) / n;
+        float mt = 1 - t;
+        float a = mt * mt * mt, b = 3 * mt * mt * t, cc = 3 * mt * t * t, d = t * t * t;
+        out.emplace_back(a * p0.x + b * c1.x + cc * c2.x + d * p1.x,
+                         a * p0.y + b * c1.y + cc * c2.y + d * p1.y);
+    }
+}
+
+void SoftwarePathBuilder::FlattenArc(SoftwarePolygon& out, const Point& p0, const Point& p1,
+                                     const Size& size, float rotation, bool isLargeArc,
+                                     bool sweepClockwise) {
+    // SVG endpoint -> center parameterization (SVG 1.1, appendix F.6)
+    float rx = std::fabs(size.width), ry = std::fabs(size.height);
+    if (rx <= 0 || ry <= 0 || (p0.x == p1.x && p0.y == p1.y)) {
+        out.push_back(p1);
+        return;
+    }
+    float phi = rotation * kPi / 180.0f;
+    float cphi = std::cos(phi), sphi = std::sin(phi);
+    float dx = (p0.x - p1.x) * 0.5f, dy = (p0.y - p1.y) * 0.5f;
+    float x1p = cphi * dx + sphi * dy;
+    float y1p = -sphi * dx + cphi * dy;
+
+    float lambda = (x1p * x1p) / (rx * rx) + (y1p * y1p) / (ry * ry);
+    if (lambda > 1) {
+        float s = std::sqrt(lambda);
+        rx *= s; ry *= s;
+    }
+    float num = rx * rx * ry * ry - rx * rx * y1p * y1p - ry * ry * x1p * x1p;
+    float den = rx * rx * y1p * y1p + ry * ry * x1p * x1p;
+    float coef = den > 0 ? std::sqrt((std::max)(0.0f, num / den)) : 0.0f;
+    if (isLargeArc == sweepClockwise) coef = -coef;
+    float cxp = coef * rx * y1p / ry;
+    float cyp = -coef * ry * x1p / rx;
+    float cx = cphi * cxp - sphi * cyp + (p0.x + p1.x) * 0.5f;
+    float cy = sphi * cxp + cphi * cyp + (p0.y + p1.y) * 0.5f;
+
+    auto angle = [](float ux, float uy, float vx, float vy) {
+        return std::atan2(ux * vy - uy * vx, ux * vx + uy * vy);
+    };
+    float theta1 = angle(1, 0, (x1p - cxp) / rx, (y1p - cyp) / ry);
+    float delta = angle((x1p - cxp) / rx, (y1p - cyp) / ry, (-x1p - cxp) / rx, (-y1p - cyp) / ry);
+    if (!sweepClockwise && delta > 0) delta -= 2 * kPi;
+    else if (sweepClockwise && delta < 0) delta += 2 * kPi;
+
+    int full = SegmentsForRadius((std::max)(rx, ry));
+    int n = (std::max)(2, static_cast<int>(std::ceil(full * std::fabs(delta) / (2 * kPi))));
+    for (int i = 1; i <= n; ++i) {
+        float t = theta1 + delta * i / n;
+        float ex = rx * std::cos(t), ey = ry * std::sin(t);
+        out.emplace_back(cphi * ex - sphi * ey + cx, sphi * ex + cphi * ey + cy);
+    }
+    out.back() = p1;
+}
+
+void SoftwarePathBuilder::ToPolygons(const SoftwareFigureList& figures, const Transform& transform,
+                                     SoftwarePolygonList& out, bool filledOnly) {
+    for (const auto& fig : figures) {
+        if (filledOnly && !fig.filled) continue;
+        SoftwarePolygon poly;
+        poly.reserve(fig.points.size());
+        for (const auto& p : fig.points) poly.push_back(transform.TransformPoint(p));
+        out.push_back(std::move(poly));
+    }
+}
+
+float SoftwarePathBuilder::SignedArea(const SoftwarePolygon& polygon) {
+    float area = 0;
+    size_t n = polygon.size();
+    for (size_t i = 0; i < n; ++i) {
+        area += Cross(polygon[i], polygon[(i + 1) % n]);
+    }
+    return area * 0.5f;
+}
+
+// ==================== Stroking ====================
+
+namespace {
+
+// Emit a polygon with positive winding so overlapping stroke pieces saturate
+void EmitOriented(SoftwarePolygonList& out, SoftwarePolygon poly) {
+    if (poly.size() < 3) return;
+    if (SoftwarePathBuilder::SignedArea(poly) < 0) SoftwarePathBuilder::Reverse(poly);
+    out.push_back(std::move(poly));
+}
+
+void EmitDisc(SoftwarePolygonList& out, const Point& c, float r) {
+    SoftwareFigureList tmp;
+    SoftwarePathBuilder::AddEllipse(tmp, c, r, r);
+    if (!tmp.empty()) EmitOriented(out, std::move(tmp[0].points));
+}
+
+void StrokeSegments(const SoftwarePolygon& pts, bool closed, float half,
+                    const StrokeStyle* style, SoftwarePolygonList& out) {
+    size_t n = pts.size();
+    if (n < 2) {
+        if (n == 1 && style && (style->startCap == StrokeStyle::CapStyle::Round)) {
+            EmitDisc(out, pts[0], half);
+        }
+        return;
+    }
+
+    auto startCap = style ? style->startCap : StrokeStyle::CapStyle::Flat;
+    auto endCap = style ? style->endCap : StrokeStyle::CapStyle::Flat;
+    auto join = style ? style->lineJoin : StrokeStyle::LineJoin::Miter;
+    float miterLimit = style ? (std::max)(1.0f, style->miterLimit) : 10.0f;
+
+    size_t segCount = closed ? n : n - 1;
+    for (size_t i = 0; i < segCount; ++i) {
+        Point a = pts[i];
+        Point b = pts[(i + 1) % n];
+        Point d = Normalize(b - a);
+        if (d.x == 0 && d.y == 0) continue;
+        if (!closed && startCap == StrokeStyle::CapStyle::Square && i == 0) a = a - d * half;
+        if (!closed && endCap == StrokeStyle::CapStyle::Square && i == segCount - 1) b = b + d * half;
+        Point nrm(-d.y * half, d.x * half);
+        EmitOriented(out, { a + nrm, b + nrm, b - nrm, a - nrm });
+    }
+
+    // Joins between consecutive segments
+    size_t first = closed ? 0 : 1;
+    size_t last = closed ? n : n - 1;
+    for (size_t i = first; i < last; ++i) {
+        const Point& v = pts[i];
+        Point d0 = Normalize(v - pts[(i + n - 1) % n]);
+        Point d1 = Normalize(pts[(i + 1) % n] - v);
+        if ((d0.x == 0 && d0.y == 0) || (d1.x == 0 && d1.y == 0)) continue;
+        float turn = Cross(d0, d1);
+        if (std::fabs(turn) < 1e-4f && (d0.x * d1.x + d0.y * d1.y) > 0) continue;  // collinear
+
+        if (join == StrokeStyle::LineJoin::Round) {
+            EmitDisc(out, v, half);
+            continue;
+        }
+        // Outer side is opposite to the turning direction
+        float side = turn > 0 ? -1.0f : 1.0f;
+        Point n0(-d0.y * half * side, d0.x * half * side);
+        Point n1(-d1.y * half * side, d1.x * half * side);
+        if (join == StrokeStyle::LineJoin::Miter) {
+            Point bis = Normalize(n0 + n1);
+            float cosHalf = (bis.x * n0.x + bis.y * n0.y) / half;
+            if (cosHalf > 1e-4f && 1.0f / cosHalf <= miterLimit) {
+                Point tip = v + bis * (half / cosHalf);
+                EmitOriented(out, { v, v + n0, tip, v + n1 });
+                continue;
+            }
+        }
+        EmitOriented(out, { v, v + n0, v + n1 });
+    }
+
+    if (!closed) {
+        if (startCap == StrokeStyle::CapStyle::Round) EmitDisc(out, pts.front(), half);
+        if (endCap == StrokeStyle::CapStyle::Round) EmitDisc(out, pts.back(), half);
+    }
+}
+
+} // anonymous namespace
+
+void SoftwarePathBuilder::Stroke(const SoftwarePolygon& points, bool closed, float width,
+                                 const StrokeStyle* style, SoftwarePolygonList& out) {
+    if (width <= 0 || points.empty()) return;
+    float half = width * 0.5f;
+
+    if (!style || style->dashes.empty()) {
+        StrokeSegments(points, closed, half, style, out);
+        return;
+    }
+
+    // Dash lengths are in multiples of the stroke width (Direct2D convention)
+    std::vector<float> dashes;
+    float period = 0;
+    for (float d : style->dashes) {
+        dashes.push_back((std::max)(0.0f, d * width));
+        period += dashes.back();
+    }
+    if (period <= 0) {
+        StrokeSegments(points, closed, half, style, out);
+        return;
+    }
+
+    SoftwarePolygon path = points;
+    if (closed && !path.empty()) path.push_back(path.front());
+
+    size_t dashIndex = 0;
+    float remaining = dashes[0];
+    float offset = std::fmod(style->dashOffset * width, period);
+    if (offset < 0) offset += period;
+    while (offset > 0) {
+        if (offset >= remaining) {
+            offset -= remaining;
+            dashIndex = (dashIndex + 1) % dashes.size();
+            remaining = dashes[dashIndex];
+        } else {
+            remaining -= offset;
+            offset = 0;
+        }
+    }
+
+    SoftwarePolygon current;
+    bool on = (dashIndex % 2) == 0;
+    if (on) current.push_back(path[0]);
+    for (size_t i = 1; i < path.size(); ++i) {
+        Point a = path[i - 1];
+        Point b = path[i];
+        float segLen = std::sqrt((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y));
+        Point dir = segLen > 0 ? (b - a) * (1.0f / segLen) : Point(0, 0);
+        float pos = 0;
+        while (segLen - pos > remaining) {
+            pos += remaining;
+            Point p = a + dir * pos;
+            if (on) {
+                current.push_back(p);
+                StrokeSegments(current, false, half, style, out);
+                current.clear();
+            } else {
+                current.push_back(p);
+            }
+            on = !on;
+            dashIndex = (dashIndex + 1) % dashes.size();
+            remaining = dashes[dashIndex];
+        }
+        remaining -= segLen - pos;
+        if (on) current.push_back(b);
+    }
+    if (on && current.size() >= 2) StrokeSegments(current, false, half, style, out);
+}
+
+} // namespace rendering
+} // namespace luaui
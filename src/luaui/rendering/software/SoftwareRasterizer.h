@@ -0,0 +1,155 @@
+#pragma once
+
+#include "Types.h"
+#include "IGeometry.h"
+#include <cstdint>
+#include <vector>
+
+namespace luaui {
+namespace rendering {
+
+// Integer pixel rectangle [x0, x1) x [y0, y1)
+struct PixelRect {
+    int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+
+    PixelRect() = default;
+    PixelRect(int l, int t, int r, int b) : x0(l), y0(t), x1(r), y1(b) {}
+
+    int Width() const { return x1 - x0; }
+    int Height() const { return y1 - y0; }
+    bool IsEmpty() const { return x1 <= x0 || y1 <= y0; }
+
+    PixelRect Intersect(const PixelRect& o) const {
+        PixelRect r((std::max)(x0, o.x0), (std::max)(y0, o.y0),
+                    (std::min)(x1, o.x1), (std::min)(y1, o.y1));
+        if (r.IsEmpty()) return PixelRect();
+        return r;
+    }
+
+    // Smallest pixel rect containing the float rect
+    static PixelRect Enclosing(const Rect& r) {
+        return PixelRect(static_cast<int>(std::floor(r.x)), static_cast<int>(std::floor(r.y)),
+                         static_cast<int>(std::ceil(r.x + r.width)),
+                         static_cast<int>(std::ceil(r.y + r.height)));
+    }
+};
+
+// 32-bit premultiplied BGRA pixel buffer (byte order B, G, R, A)
+class SoftwareSurface {
+public:
+    SoftwareSurface() = default;
+    SoftwareSurface(int width, int height) { Resize(width, height); }
+
+    void Resize(int width, int height);
+    void Clear(uint32_t pixel);
+    void Fill(const PixelRect& rect, uint32_t pixel);
+
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+    int GetStride() const { return m_width; }  // in pixels
+    PixelRect GetBounds() const { return PixelRect(0, 0, m_width, m_height); }
+
+    uint32_t* GetRow(int y) { return m_pixels.data() + static_cast<size_t>(y) * m_width; }
+    const uint32_t* GetRow(int y) const { return m_pixels.data() + static_cast<size_t>(y) * m_width; }
+    uint32_t* GetPixels() { return m_pixels.data(); }
+    const uint32_t* GetPixels() const { return m_pixels.data(); }
+    uint32_t GetPixel(int x, int y) const { return GetRow(y)[x]; }
+
+    size_t GetByteSize() const { return m_pixels.size() * sizeof(uint32_t); }
+
+private:
+    int m_width = 0;
+    int m_height = 0;
+    std::vector<uint32_t> m_pixels;
+};
+
+// 8-bit coverage values for a pixel rectangle
+struct CoverageMask {
+    PixelRect bounds;
+    std::vector<uint8_t> data;   // bounds.Width() * bounds.Height()
+
+    bool IsEmpty() const { return bounds.IsEmpty(); }
+    const uint8_t* GetRow(int y) const {
+        return data.data() + static_cast<size_t>(y - bounds.y0) * bounds.Width();
+    }
+    uint8_t* GetRow(int y) {
+        return data.data() + static_cast<size_t>(y - bounds.y0) * bounds.Width();
+    }
+};
+
+using SoftwarePolygon = std::vector<Point>;
+using SoftwarePolygonList = std::vector<SoftwarePolygon>;
+
+// Scanline rasterizer producing exact-area (analytic) coverage.
+//
+// Edges deposit signed area into an accumulation buffer; a prefix sum along
+// each row yields per-pixel coverage. Overlapping polygons follow the
+// non-zero rule with saturation, so holes need opposite winding.
+class SoftwareRasterizer {
+public:
+    // Rasterize closed polygons (device space) into `out`, limited to `clip`
+    void Rasterize(const SoftwarePolygonList& polygons, const PixelRect& clip, bool antialias,
+                   CoverageMask& out);
+
+    // ========== Span operations ==========
+    // All colors are premultiplied BGRA. SSE2 is used when available.
+    static void FillSpan(uint32_t* dst, uint32_t color, int count);
+    static void BlendSolidSpan(uint32_t* dst, uint32_t color, int count);
+    static void BlendSpan(uint32_t* dst, const uint32_t* src, int count);
+    static void ScaleSpan(uint32_t* pixels, const uint8_t* coverage, int count);
+    static void ScaleSpan(uint32_t* pixels, uint32_t alpha, int count);
+
+    static uint32_t ScalePixel(uint32_t pixel, uint32_t alpha);
+    static uint32_t BlendPixel(uint32_t dst, uint32_t src);
+    static uint32_t PackColor(const Color& color, float opacity = 1.0f);
+
+private:
+    void AccumulateLine(float x0, float y0, float x1, float y1);
+
+    std::vector<float> m_accum;
+    int m_width = 0;    // accumulation width (mask width + 2 guard cells)
+    int m_height = 0;
+};
+
+// ========== Path flattening and stroking ==========
+
+struct SoftwareFigure {
+    SoftwarePolygon points;
+    bool closed = true;
+    bool filled = true;
+};
+
+using SoftwareFigureList = std::vector<SoftwareFigure>;
+
+class SoftwarePathBuilder {
+public:
+    static constexpr float kTolerance = 0.2f;  // max deviation in pixels
+
+    static int SegmentsForRadius(float radius);
+
+    static void AddRect(SoftwareFigureList& figures, const Rect& rect);
+    static void AddRoundedRect(SoftwareFigureList& figures, const Rect& rect,
+                               const CornerRadius& radius, float scale = 1.0f);
+    static void AddEllipse(SoftwareFigureList& figures, const Point& center,
+                           float rx, float ry, float scale = 1.0f);
+
+    static void FlattenQuadratic(SoftwarePolygon& out, const Point& p0, const Point& c, const Point& p1);
+    static void FlattenCubic(SoftwarePolygon& out, const Point& p0, const Point& c1, const Point& c2,
+                             const Point& p1);
+    static void FlattenArc(SoftwarePolygon& out, const Point& p0, const Point& p1, const Size& size,
+                           float rotation, bool isLargeArc, bool sweepClockwise);
+
+    // Transform every point of the filled figures into device polygons
+    static void ToPolygons(const SoftwareFigureList& figures, const Transform& transform,
+                           SoftwarePolygonList& out, bool filledOnly = true);
+
+    // Expand polylines into fill polygons for the given stroke (device space)
+    static void Stroke(const SoftwarePolygon& points, bool closed, float width,
+                       const StrokeStyle* style, SoftwarePolygonList& out);
+
+    static float SignedArea(const SoftwarePolygon& polygon);
+    static void Reverse(SoftwarePolygon& polygon) { std::reverse(polygon.begin(), polygon.end()); }
+};
+
+} // namespace rendering
+} // namespace luaui
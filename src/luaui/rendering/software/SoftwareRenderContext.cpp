@@ -0,0 +1,918 @@
+#include "SoftwareRenderContext.h"
+#include "SoftwareBrush.h"
+#include "SoftwareGeometry.h"
+#include "SoftwareBitmap.h"
+#include "SoftwareTextFormat.h"
+#include "TextLayoutCache.h"
+#include "BitmapService.h"
+#include <cmath>
+#include <cstring>
+
+namespace luaui {
+namespace rendering {
+
+namespace {
+
+inline float Overlap(float a0, float a1, float b0, float b1) {
+    return (std::max)(0.0f, (std::min)(a1, b1) - (std::max)(a0, b0));
+}
+
+inline uint8_t ToCoverage(float c) {
+    if (c >= 1.0f) return 255;
+    if (c <= 0.0f) return 0;
+    return static_cast<uint8_t>(c * 255.0f + 0.5f);
+}
+
+inline uint8_t MaskAt(const CoverageMask& mask, int x, int y) {
+    if (x < mask.bounds.x0 || x >= mask.bounds.x1 || y < mask.bounds.y0 || y >= mask.bounds.y1) return 0;
+    return mask.GetRow(y)[x - mask.bounds.x0];
+}
+
+inline uint8_t MulCoverage(uint32_t a, uint32_t b) {
+    uint32_t t = a * b + 128;
+    return static_cast<uint8_t>((t + (t >> 8)) >> 8);
+}
+
+SoftwarePolygon TransformRect(const Rect& r, const Transform& t) {
+    return {
+        t.TransformPoint(Point(r.x, r.y)), t.TransformPoint(Point(r.Right(), r.y)),
+        t.TransformPoint(Point(r.Right(), r.Bottom())), t.TransformPoint(Point(r.x, r.Bottom()))
+    };
+}
+
+Rect Normalized(const Rect& r) {
+    float x0 = (std::min)(r.x, r.Right()), x1 = (std::max)(r.x, r.Right());
+    float y0 = (std::min)(r.y, r.Bottom()), y1 = (std::max)(r.y, r.Bottom());
+    return Rect(x0, y0, x1 - x0, y1 - y0);
+}
+
+// Samples a SoftwareBitmap through a device -> source pixel mapping
+class BitmapPaint : public ISoftwarePaint {
+public:
+    BitmapPaint(const SoftwareBitmap* bitmap, const Rect& source, bool smooth)
+        : m_bitmap(bitmap), m_smooth(smooth) {
+        m_x0 = std::clamp(static_cast<int>(std::floor(source.x)), 0, bitmap->GetWidth() - 1);
+        m_y0 = std::clamp(static_cast<int>(std::floor(source.y)), 0, bitmap->GetHeight() - 1);
+        m_x1 = std::clamp(static_cast<int>(std::ceil(source.Right())) - 1, m_x0, bitmap->GetWidth() - 1);
+        m_y1 = std::clamp(static_cast<int>(std::ceil(source.Bottom())) - 1, m_y0, bitmap->GetHeight() - 1);
+    }
+
+    bool IsSolid() const override { return false; }
+    Color GetSolidColor() const override { return Color::Transparent(); }
+
+    void ShadeSpan(const Transform& deviceToSource, int x, int y, int count, uint32_t* out) const override {
+        const float* m = deviceToSource.GetMatrix();
+        Point p = deviceToSource.TransformPoint(Point(x + 0.5f, y + 0.5f));
+
+        // 1:1 integer offset: copy source pixels directly
+        if (m[0] == 1 && m[1] == 0 && m[2] == 0 && m[3] == 1 &&
+            m[4] == std::floor(m[4]) && m[5] == std::floor(m[5])) {
+            int sy = std::clamp(static_cast<int>(std::floor(p.y)), m_y0, m_y1);
+            int sx = static_cast<int>(std::floor(p.x));
+            const uint32_t* row = m_bitmap->GetPixels() + static_cast<size_t>(sy) * m_bitmap->GetWidth();
+            for (int i = 0; i < count; ++i) {
+                out[i] = row[std::clamp(sx + i, m_x0, m_x1)];
+            }
+            return;
+        }
+
+        float u = p.x, v = p.y;
+        const float du = m[0], dv = m[1];
+        for (int i = 0; i < count; ++i, u += du, v += dv) {
+            out[i] = m_smooth ? SampleBilinear(u - 0.5f, v - 0.5f) : SampleNearest(u, v);
+        }
+    }
+
+private:
+    uint32_t Texel(int x, int y) const {
+        return m_bitmap->GetPixel(std::clamp(x, m_x0, m_x1), std::clamp(y, m_y0, m_y1));
+    }
+
+    uint32_t SampleNearest(float u, float v) const {
+        return Texel(static_cast<int>(std::floor(u)), static_cast<int>(std::floor(v)));
+    }
+
+    uint32_t SampleBilinear(float u, float v) const {
+        int x = static_cast<int>(std::floor(u));
+        int y = static_cast<int>(std::floor(v));
+        uint32_t fx = static_cast<uint32_t>((u - x) * 256.0f);
+        uint32_t fy = static_cast<uint32_t>((v - y) * 256.0f);
+        uint32_t p00 = Texel(x, y), p10 = Texel(x + 1, y);
+        uint32_t p01 = Texel(x, y + 1), p11 = Texel(x + 1, y + 1);
+        uint32_t result = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            uint32_t c00 = (p00 >> shift) & 0xFF, c10 = (p10 >> shift) & 0xFF;
+            uint32_t c01 = (p01 >> shift) & 0xFF, c11 = (p11 >> shift) & 0xFF;
+            uint32_t top = c00 * (256 - fx) + c10 * fx;
+            uint32_t bottom = c01 * (256 - fx) + c11 * fx;
+            uint32_t c = (top * (256 - fy) + bottom * fy + 32768) >> 16;
+            result |= (std::min)(c, 255u) << shift;
+        }
+        return result;
+    }
+
+    const SoftwareBitmap* m_bitmap;
+    bool m_smooth;
+    int m_x0, m_y0, m_x1, m_y1;
+};
+
+} // anonymous namespace
+
+// ==================== Lifecycle ====================
+
+SoftwareRenderContext::SoftwareRenderContext() = default;
+SoftwareRenderContext::~SoftwareRenderContext() { Shutdown(); }
+
+bool SoftwareRenderContext::Initialize(SoftwareSurface* surface) {
+    if (!surface) return false;
+    m_baseSurface = surface;
+    m_target = surface;
+    m_clipStack.clear();
+    m_clipStack.push_back(ClipEntry{ surface->GetBounds(), nullptr });
+    ResetState();
+    return true;
+}
+
+void SoftwareRenderContext::Shutdown() {
+    TextLayoutCache::Instance().RemoveContext(this);
+    BitmapService::Instance().RemoveContext(this);
+    m_layerStack.clear();
+    m_layerPool.clear();
+    m_clipStack.clear();
+    while (!m_stateStack.empty()) m_stateStack.pop();
+    m_target = nullptr;
+    m_baseSurface = nullptr;
+}
+
+bool SoftwareRenderContext::BeginDraw() {
+    if (!m_baseSurface) return false;
+    // The surface may have been resized since the last frame
+    m_layerStack.clear();
+    m_target = m_baseSurface;
+    m_clipStack.clear();
+    m_clipStack.push_back(ClipEntry{ m_baseSurface->GetBounds(), nullptr });
+    return true;
+}
+
+bool SoftwareRenderContext::EndDraw() {
+    if (!m_baseSurface) return false;
+    while (!m_layerStack.empty()) PopLayer();
+    return true;
+}
+
+void SoftwareRenderContext::Clear(const Color& color) {
+    if (!m_target || m_clipStack.empty()) return;
+    m_target->Fill(CurrentClip().bounds, SoftwareRasterizer::PackColor(color));
+}
+
+// ==================== State Management ====================
+
+void SoftwareRenderContext::PushState() { m_stateStack.push(m_currentState); }
+
+void SoftwareRenderContext::PopState() {
+    if (m_stateStack.empty()) return;
+    m_currentState = m_stateStack.top();
+    m_stateStack.pop();
+}
+
+void SoftwareRenderContext::ResetState() {
+    m_currentState = State();
+}
+
+void SoftwareRenderContext::MultiplyTransform(const Transform& t) {
+    m_currentState.transform = t * m_currentState.transform;
+}
+
+void SoftwareRenderContext::SetOpacity(float o) {
+    m_currentState.opacity = std::clamp(o, 0.0f, 1.0f);
+}
+
+float SoftwareRenderContext::TransformScale() const {
+    return std::sqrt(std::fabs(m_currentState.transform.Determinant()));
+}
+
+// ==================== Clipping ====================
+
+void SoftwareRenderContext::PushClip(const Rect& rect) {
+    if (m_clipStack.empty()) return;
+    const ClipEntry parent = CurrentClip();
+    const Transform& t = m_currentState.transform;
+
+    if (t.IsAxisAligned()) {
+        // Snap to whole pixels, like an aliased axis-aligned clip
+        Rect r = t.TransformBounds(rect);
+        PixelRect px(static_cast<int>(std::floor(r.x + 0.5f)), static_cast<int>(std::floor(r.y + 0.5f)),
+                     static_cast<int>(std::floor(r.Right() + 0.5f)), static_cast<int>(std::floor(r.Bottom() + 0.5f)));
+        m_clipStack.push_back(ClipEntry{ px.Intersect(parent.bounds), parent.mask });
+        return;
+    }
+
+    SoftwareRectangleGeometry geometry(rect);
+    PushClip(geometry);
+}
+
+void SoftwareRenderContext::PushClip(const IGeometry& geometry) {
+    if (m_clipStack.empty()) return;
+    const ClipEntry parent = CurrentClip();
+
+    auto* sg = dynamic_cast<const ISoftwareGeometry*>(&geometry);
+    if (!sg) {
+        // Foreign geometry: fall back to its bounds
+        Rect b = geometry.GetBounds();
+        PixelRect px = PixelRect::Enclosing(m_currentState.transform.TransformBounds(b));
+        m_clipStack.push_back(ClipEntry{ px.Intersect(parent.bounds), parent.mask });
+        return;
+    }
+
+    auto mask = std::make_shared<CoverageMask>();
+    RasterizeShape(sg->GetShape(), parent.bounds, *mask);
+    if (parent.mask && !mask->IsEmpty()) {
+        for (int y = mask->bounds.y0; y < mask->bounds.y1; ++y) {
+            uint8_t* row = mask->GetRow(y);
+            for (int x = mask->bounds.x0; x < mask->bounds.x1; ++x) {
+                row[x - mask->bounds.x0] = MulCoverage(row[x - mask->bounds.x0], MaskAt(*parent.mask, x, y));
+            }
+        }
+    }
+    PixelRect bounds = mask->bounds;
+    m_clipStack.push_back(ClipEntry{ bounds, std::move(mask) });
+}
+
+void SoftwareRenderContext::PopClip() {
+    if (m_clipStack.size() > 1) m_clipStack.pop_back();
+}
+
+void SoftwareRenderContext::ResetClip() {
+    if (m_clipStack.size() > 1) m_clipStack.resize(1);
+}
+
+Rect SoftwareRenderContext::GetClipBounds() const {
+    if (m_clipStack.empty()) return Rect();
+    const PixelRect& b = CurrentClip().bounds;
+    Rect device(static_cast<float>(b.x0), static_cast<float>(b.y0),
+                static_cast<float>(b.Width()), static_cast<float>(b.Height()));
+    // Report in the current local coordinate space
+    return m_currentState.transform.Invert().TransformBounds(device);
+}
+
+// ==================== Paint resolution ====================
+
+bool SoftwareRenderContext::ResolvePaint(IBrush* brush, Paint& paint) const {
+    if (!brush || !m_target || m_clipStack.empty() || CurrentClip().bounds.IsEmpty()) return false;
+    float opacity = m_currentState.opacity;
+    if (opacity <= 0) return false;
+
+    if (auto* sp = dynamic_cast<ISoftwarePaint*>(brush)) {
+        if (sp->IsSolid()) {
+            paint.color = SoftwareRasterizer::PackColor(sp->GetSolidColor(), opacity);
+            return paint.color != 0;
+        }
+        paint.shader = sp;
+        paint.alpha = static_cast<uint32_t>(opacity * 255.0f + 0.5f);
+        paint.deviceToBrush = m_currentState.transform.Invert();
+        return true;
+    }
+    // Brushes created by another backend: solid colors still work
+    if (auto* solid = dynamic_cast<ISolidColorBrush*>(brush)) {
+        paint.color = SoftwareRasterizer::PackColor(solid->GetColor(), opacity);
+        return paint.color != 0;
+    }
+    return false;
+}
+
+// ==================== Compositing ====================
+
+void SoftwareRenderContext::CompositeRow(int y, int x, int count, const uint8_t* coverage,
+                                         const Paint& paint) {
+    if (count <= 0) return;
+    const ClipEntry& clip = CurrentClip();
+    if (clip.mask) {
+        m_scratchCoverage.resize(count);
+        const CoverageMask& mask = *clip.mask;
+        for (int i = 0; i < count; ++i) {
+            uint8_t m = MaskAt(mask, x + i, y);
+            m_scratchCoverage[i] = coverage ? MulCoverage(coverage[i], m) : m;
+        }
+        coverage = m_scratchCoverage.data();
+    }
+
+    uint32_t* dst = m_target->GetRow(y) + x;
+    if (!paint.shader) {
+        if (!coverage) {
+            SoftwareRasterizer::BlendSolidSpan(dst, paint.color, count);
+            return;
+        }
+        int i = 0;
+        while (i < count) {
+            uint8_t c = coverage[i];
+            if (c == 0) {
+                ++i;
+            } else if (c == 255) {
+                int j = i + 1;
+                while (j < count && coverage[j] == 255) ++j;
+                SoftwareRasterizer::BlendSolidSpan(dst + i, paint.color, j - i);
+                i = j;
+            } else {
+                dst[i] = SoftwareRasterizer::BlendPixel(dst[i], SoftwareRasterizer::ScalePixel(paint.color, c));
+                ++i;
+            }
+        }
+        return;
+    }
+
+    m_scratchPixels.resize(count);
+    uint32_t* src = m_scratchPixels.data();
+    paint.shader->ShadeSpan(paint.deviceToBrush, x, y, count, src);
+    SoftwareRasterizer::ScaleSpan(src, paint.alpha, count);
+    if (coverage) SoftwareRasterizer::ScaleSpan(src, coverage, count);
+    SoftwareRasterizer::BlendSpan(dst, src, count);
+}
+
+void SoftwareRenderContext::FillMask(const CoverageMask& mask, const Paint& paint) {
+    PixelRect r = mask.bounds.Intersect(CurrentClip().bounds);
+    for (int y = r.y0; y < r.y1; ++y) {
+        CompositeRow(y, r.x0, r.Width(), mask.GetRow(y) + (r.x0 - mask.bounds.x0), paint);
+    }
+}
+
+void SoftwareRenderContext::FillPolygons(const SoftwarePolygonList& polygons, const Paint& paint) {
+    m_rasterizer.Rasterize(polygons, CurrentClip().bounds, m_currentState.antialias, m_scratchMask);
+    if (!m_scratchMask.IsEmpty()) FillMask(m_scratchMask, paint);
+}
+
+void SoftwareRenderContext::FillAlignedRect(const Rect& outerRect, const Rect* innerRect, const Paint& paint) {
+    Rect outer = Normalized(outerRect);
+    Rect inner = innerRect ? Normalized(*innerRect) : Rect();
+    if (!m_currentState.antialias) {
+        auto snap = [](const Rect& r) {
+            float x0 = std::floor(r.x + 0.5f), y0 = std::floor(r.y + 0.5f);
+            return Rect(x0, y0, std::floor(r.Right() + 0.5f) - x0, std::floor(r.Bottom() + 0.5f) - y0);
+        };
+        outer = snap(outer);
+        inner = snap(inner);
+    }
+    bool hasInner = !inner.IsEmpty();
+
+    PixelRect bounds = PixelRect::Enclosing(outer).Intersect(CurrentClip().bounds);
+    if (bounds.IsEmpty()) return;
+    const int w = bounds.Width();
+
+    m_columnOuter.resize(w);
+    m_columnInner.resize(w);
+    for (int i = 0; i < w; ++i) {
+        float px = static_cast<float>(bounds.x0 + i);
+        m_columnOuter[i] = Overlap(px, px + 1, outer.x, outer.Right());
+        m_columnInner[i] = hasInner ? Overlap(px, px + 1, inner.x, inner.Right()) : 0.0f;
+    }
+
+    // Coverage of an interior row (outer fully covers it vertically, no hole)
+    std::vector<uint8_t>& row = m_scratchRow;
+    row.resize(static_cast<size_t>(w) * 2);
+    uint8_t* fullRow = row.data();
+    uint8_t* partialRow = row.data() + w;
+    bool fullRowSolid = true;
+    for (int i = 0; i < w; ++i) {
+        fullRow[i] = ToCoverage(m_columnOuter[i]);
+        fullRowSolid = fullRowSolid && fullRow[i] == 255;
+    }
+
+    for (int y = bounds.y0; y < bounds.y1; ++y) {
+        float fy = static_cast<float>(y);
+        float rowOuter = Overlap(fy, fy + 1, outer.y, outer.Bottom());
+        float rowInner = hasInner ? Overlap(fy, fy + 1, inner.y, inner.Bottom()) : 0.0f;
+        if (rowOuter <= 0) continue;
+
+        if (rowOuter >= 1.0f && rowInner <= 0) {
+            CompositeRow(y, bounds.x0, w, fullRowSolid ? nullptr : fullRow, paint);
+            continue;
+        }
+        bool solid = true;
+        for (int i = 0; i < w; ++i) {
+            partialRow[i] = ToCoverage(m_columnOuter[i] * rowOuter - m_columnInner[i] * rowInner);
+            solid = solid && partialRow[i] == 255;
+        }
+        CompositeRow(y, bounds.x0, w, solid ? nullptr : partialRow, paint);
+    }
+}
+
+void SoftwareRenderContext::RasterizeShape(const SoftwareShape& shape, const PixelRect& clip, CoverageMask& out) {
+    const Transform& t = m_currentState.transform;
+    bool aa = m_currentState.antialias;
+    if (!shape.IsCombined()) {
+        SoftwarePolygonList polygons;
+        SoftwarePathBuilder::ToPolygons(shape.figures, t, polygons);
+        m_rasterizer.Rasterize(polygons, clip, aa, out);
+        return;
+    }
+
+    CoverageMask a, b;
+    RasterizeShape(*shape.first, clip, a);
+    RasterizeShape(*shape.second, clip, b);
+
+    PixelRect bounds;
+    switch (shape.mode) {
+        case CombineMode::Intersect: bounds = a.bounds.Intersect(b.bounds); break;
+        case CombineMode::Exclude: bounds = a.bounds; break;
+        default:
+            if (a.IsEmpty()) bounds = b.bounds;
+            else if (b.IsEmpty()) bounds = a.bounds;
+            else bounds = PixelRect((std::min)(a.bounds.x0, b.bounds.x0), (std::min)(a.bounds.y0, b.bounds.y0),
+                                    (std::max)(a.bounds.x1, b.bounds.x1), (std::max)(a.bounds.y1, b.bounds.y1));
+            break;
+    }
+    out.bounds = bounds;
+    out.data.assign(static_cast<size_t>((std::max)(0, bounds.Width())) * (std::max)(0, bounds.Height()), 0);
+    for (int y = bounds.y0; y < bounds.y1; ++y) {
+        uint8_t* row = out.GetRow(y);
+        for (int x = bounds.x0; x < bounds.x1; ++x) {
+            uint32_t va = MaskAt(a, x, y), vb = MaskAt(b, x, y);
+            uint32_t v = 0;
+            switch (shape.mode) {
+                case CombineMode::Union: v = va + vb - MulCoverage(va, vb); break;
+                case CombineMode::Intersect: v = MulCoverage(va, vb); break;
+                case CombineMode::Xor: v = va + vb - 2u * MulCoverage(va, vb); break;
+                case CombineMode::Exclude: v = MulCoverage(va, 255 - vb); break;
+            }
+            row[x - bounds.x0] = static_cast<uint8_t>((std::min)(v, 255u));
+        }
+    }
+}
+
+void SoftwareRenderContext::FillShape(const SoftwareShape& shape, const Paint& paint) {
+    if (!shape.IsCombined()) {
+        SoftwarePolygonList polygons;
+        SoftwarePathBuilder::ToPolygons(shape.figures, m_currentState.transform, polygons);
+        FillPolygons(polygons, paint);
+        return;
+    }
+    CoverageMask mask;
+    RasterizeShape(shape, CurrentClip().bounds, mask);
+    if (!mask.IsEmpty()) FillMask(mask, paint);
+}
+
+void SoftwareRenderContext::StrokeFigures(const SoftwareFigureList& figures, const Paint& paint,
+                                          float strokeWidth, const StrokeStyle* strokeStyle) {
+    const Transform& t = m_currentState.transform;
+    float width = strokeWidth * TransformScale();
+    SoftwarePolygonList polygons;
+    SoftwarePolygon device;
+    for (const auto& fig : figures) {
+        device.clear();
+        for (const auto& p : fig.points) device.push_back(t.TransformPoint(p));
+        SoftwarePathBuilder::Stroke(device, fig.closed, width, strokeStyle, polygons);
+    }
+    FillPolygons(polygons, paint);
+}
+
+// ==================== Primitive Drawing ====================
+
+void SoftwareRenderContext::DrawLine(const Point& p1, const Point& p2, IBrush* brush, float sw,
+                                     const StrokeStyle* style) {
+    Paint paint;
+    if (!ResolvePaint(brush, paint)) return;
+    ++m_drawCalls;
+    StrokeLine(p1, p2, paint, sw, style);
+}
+
+void SoftwareRenderContext::DrawLines(const Point* points, size_t segmentCount, IBrush* brush, float sw,
+                                      const StrokeStyle* style) {
+    Paint paint;
+    if (!points || segmentCount == 0 || !ResolvePaint(brush, paint)) return;
+    ++m_drawCalls;
+    for (size_t i = 0; i < segmentCount; ++i) {
+        StrokeLine(points[i * 2], points[i * 2 + 1], paint, sw, style);
+    }
+}
+
+void SoftwareRenderContext::StrokeLine(const Point& p1, const Point& p2, const Paint& paint, float sw,
+                                       const StrokeStyle* style) {
+    const Transform& t = m_currentState.transform;
+
+    // Axis-aligned lines without caps are plain rectangles
+    bool plainCaps = !style || (style->dashes.empty() && style->startCap == StrokeStyle::CapStyle::Flat &&
+                                style->endCap == StrokeStyle::CapStyle::Flat);
+    if (plainCaps && t.IsAxisAligned() && (p1.x == p2.x || p1.y == p2.y)) {
+        float h = sw * 0.5f;
+        Rect r = p1.x == p2.x
+            ? Rect(p1.x - h, (std::min)(p1.y, p2.y), sw, std::fabs(p2.y - p1.y))
+            : Rect((std::min)(p1.x, p2.x), p1.y - h, std::fabs(p2.x - p1.x), sw);
+        FillAlignedRect(t.TransformBounds(r), nullptr, paint);
+        return;
+    }
+
+    SoftwareFigureList figures(1);
+    figures[0].points = { p1, p2 };
+    figures[0].closed = false;
+    StrokeFigures(figures, paint, sw, style);
+}
+
+void SoftwareRenderContext::DrawRectangle(const Rect& rect, IBrush* brush, float sw, const StrokeStyle* style) {
+    Paint paint;
+    if (!ResolvePaint(brush, paint) || sw <= 0) return;
+    ++m_drawCalls;
+    const Transform& t = m_currentState.transform;
+    bool simpleStroke = !style || (style->dashes.empty() && style->lineJoin == StrokeStyle::LineJoin::Miter);
+
+    if (simpleStroke) {
+        // Outer rectangle minus inner rectangle gives exact mitered corners
+        Rect r = Normalized(rect);
+        float h = sw * 0.5f;
+        Rect outer(r.x - h, r.y - h, r.width + sw, r.height + sw);
+        Rect inner(r.x + h, r.y + h, r.width - sw, r.height - sw);
+        if (t.IsAxisAligned()) {
+            Rect innerDevice = t.TransformBounds(inner);
+            FillAlignedRect(t.TransformBounds(outer), inner.IsEmpty() ? nullptr : &innerDevice, paint);
+            return;
+        }
+        SoftwarePolygonList polygons;
+        polygons.push_back(TransformRect(outer, t));
+        if (!inner.IsEmpty()) {
+            polygons.push_back(TransformRect(inner, t));
+            SoftwarePathBuilder::Reverse(polygons.back());
+        }
+        FillPolygons(polygons, paint);
+        return;
+    }
+
+    SoftwareFigureList figures;
+    SoftwarePathBuilder::AddRect(figures, rect);
+    StrokeFigures(figures, paint, sw, style);
+}
+
+void SoftwareRenderContext::FillRectangle(const Rect& rect, IBrush* brush) {
+    Paint paint;
+    if (!ResolvePaint(brush, paint)) return;
+    ++m_drawCalls;
+    FillRectWithPaint(rect, paint);
+}
+
+void SoftwareRenderContext::FillRectangles(const Rect* rects, size_t count, IBrush* brush) {
+    Paint paint;
+    if (!rects || count == 0 || !ResolvePaint(brush, paint)) return;
+    ++m_drawCalls;
+    // Filled one by one so overlapping translucent rects blend exactly as separate calls would
+    for (size_t i = 0; i < count; ++i) {
+        FillRectWithPaint(rects[i], paint);
+    }
+}
+
+void SoftwareRenderContext::FillRectWithPaint(const Rect& rect, const Paint& paint) {
+    const Transform& t = m_currentState.transform;
+    if (t.IsAxisAligned()) {
+        FillAlignedRect(t.TransformBounds(rect), nullptr, paint);
+        return;
+    }
+    FillPolygons({ TransformRect(rect, t) }, paint);
+}
+
+void SoftwareRenderContext::DrawRoundedRectangle(const Rect& rect, const CornerRadius& radius, IBrush* brush,
+                                                 float sw, const StrokeStyle* style) {
+    Paint paint;
+    if (!ResolvePaint(brush, paint) || sw <= 0) return;
+    ++m_drawCalls;
+    float scale = TransformScale();
+
+    if (!style || style->dashes.empty()) {
+        // Ring between the outset and inset outlines
+        float h = sw * 0.5f;
+        Rect r = Normalized(rect);
+        SoftwareFigureList figures;
+        SoftwarePathBuilder::AddRoundedRect(figures, Rect(r.x - h, r.y - h, r.width + sw, r.height + sw),
+            CornerRadius(radius.topLeft + h, radius.topRight + h, radius.bottomRight + h, radius.bottomLeft + h),
+            scale);
+        Rect inner(r.x + h, r.y + h, r.width - sw, r.height - sw);
+        if (!inner.IsEmpty()) {
+            SoftwarePathBuilder::AddRoundedRect(figures, inner,
+                CornerRadius((std::max)(0.0f, radius.topLeft - h), (std::max)(0.0f, radius.topRight - h),
+                             (std::max)(0.0f, radius.bottomRight - h), (std::max)(0.0f, radius.bottomLeft - h)),
+                scale);
+            SoftwarePathBuilder::Reverse(figures.back().points);
+        }
+        SoftwarePolygonList polygons;
+        SoftwarePathBuilder::ToPolygons(figures, m_currentState.transform, polygons);
+        FillPolygons(polygons, paint);
+        return;
+    }
+
+    SoftwareFigureList figures;
+    SoftwarePathBuilder::AddRoundedRect(figures, rect, radius, scale);
+    StrokeFigures(figures, paint, sw, style);
+}
+
+void SoftwareRenderContext::FillRoundedRectangle(const Rect& rect, const CornerRadius& radius, IBrush* brush) {
+    if (radius.topLeft <= 0 && radius.topRight <= 0 && radius.bottomRight <= 0 && radius.bottomLeft <= 0) {
+        FillRectangle(rect, brush);
+        return;
+    }
+    Paint paint;
+    if (!ResolvePaint(brush, paint)) return;
+    ++m_drawCalls;
+    SoftwareFigureList figures;
+    SoftwarePathBuilder::AddRoundedRect(figures, Normalized(rect), radius, TransformScale());
+    SoftwarePolygonList polygons;
+    SoftwarePathBuilder::ToPolygons(figures, m_currentState.transform, polygons);
+    FillPolygons(polygons, paint);
+}
+
+void SoftwareRenderContext::DrawEllipse(const Point& c, float rx, float ry, IBrush* brush, float sw,
+                                        const StrokeStyle* style) {
+    Paint paint;
+    if (!ResolvePaint(brush, paint) || sw <= 0) return;
+    ++m_drawCalls;
+    float scale = TransformScale();
+    rx = std::fabs(rx);
+    ry = std::fabs(ry);
+
+    if (!style || style->dashes.empty()) {
+        float h = sw * 0.5f;
+        SoftwareFigureList figures;
+        SoftwarePathBuilder::AddEllipse(figures, c, rx + h, ry + h, scale);
+        if (rx > h && ry > h) {
+            SoftwarePathBuilder::AddEllipse(figures, c, rx - h, ry - h, scale);
+            SoftwarePathBuilder::Reverse(figures.back().points);
+        }
+        SoftwarePolygonList polygons;
+        SoftwarePathBuilder::ToPolygons(figures, m_currentState.transform, polygons);
+        FillPolygons(polygons, paint);
+        return;
+    }
+
+    SoftwareFigureList figures;
+    SoftwarePathBuilder::AddEllipse(figures, c, rx, ry, scale);
+    StrokeFigures(figures, paint, sw, style);
+}
+
+void SoftwareRenderContext::FillEllipse(const Point& c, float rx, float ry, IBrush* brush) {
+    Paint paint;
+    if (!ResolvePaint(brush, paint)) return;
+    ++m_drawCalls;
+    SoftwareFigureList figures;
+    SoftwarePathBuilder::AddEllipse(figures, c, std::fabs(rx), std::fabs(ry), TransformScale());
+    SoftwarePolygonList polygons;
+    SoftwarePathBuilder::ToPolygons(figures, m_currentState.transform, polygons);
+    FillPolygons(polygons, paint);
+}
+
+// ==================== Geometry Drawing ====================
+
+void SoftwareRenderContext::DrawGeometry(const IGeometry& g, IBrush* brush, float sw, const StrokeStyle* style) {
+    auto* sg = dynamic_cast<const ISoftwareGeometry*>(&g);
+    Paint paint;
+    if (!sg || !ResolvePaint(brush, paint) || sw <= 0) return;
+    ++m_drawCalls;
+    const SoftwareShape& shape = sg->GetShape();
+    if (shape.IsCombined()) {
+        // Outline of both operands (boolean outlines are not computed)
+        StrokeFigures(shape.first->figures, paint, sw, style);
+        StrokeFigures(shape.second->figures, paint, sw, style);
+        return;
+    }
+    StrokeFigures(shape.figures, paint, sw, style);
+}
+
+void SoftwareRenderContext::FillGeometry(const IGeometry& g, IBrush* brush) {
+    auto* sg = dynamic_cast<const ISoftwareGeometry*>(&g);
+    Paint paint;
+    if (!sg || !ResolvePaint(brush, paint)) return;
+    ++m_drawCalls;
+    FillShape(sg->GetShape(), paint);
+}
+
+// ==================== Bitmap Drawing ====================
+
+void SoftwareRenderContext::DrawBitmap(IBitmap* bitmap, const Point& destination, float opacity) {
+    if (!bitmap) return;
+    DrawBitmap(bitmap, Rect(destination, bitmap->GetSize()), opacity);
+}
+
+void SoftwareRenderContext::DrawBitmap(IBitmap* bitmap, const Rect& destination, float opacity) {
+    if (!bitmap) return;
+    DrawBitmap(bitmap, destination, Rect(Point(0, 0), bitmap->GetSize()), opacity);
+}
+
+void SoftwareRenderContext::DrawBitmap(IBitmap* bitmap, const Rect& destination, const Rect& source, float opacity) {
+    auto* sb = dynamic_cast<SoftwareBitmap*>(bitmap);
+    if (!sb || sb->GetWidth() <= 0 || !m_target || m_clipStack.empty()) return;
+    if (destination.width == 0 || destination.height == 0 || source.IsEmpty()) return;
+    float alpha = std::clamp(opacity, 0.0f, 1.0f) * m_currentState.opacity;
+    if (alpha <= 0) return;
+    ++m_drawCalls;
+
+    const Transform& t = m_currentState.transform;
+    BitmapPaint shader(sb, source, m_currentState.antialias);
+    Paint paint;
+    paint.shader = &shader;
+    paint.alpha = static_cast<uint32_t>(alpha * 255.0f + 0.5f);
+    paint.deviceToBrush = t.Invert() *
+                          Transform::Translation(-destination.x, -destination.y) *
+                          Transform::Scale(source.width / destination.width, source.height / destination.height) *
+                          Transform::Translation(source.x, source.y);
+
+    if (t.IsAxisAligned()) {
+        FillAlignedRect(t.TransformBounds(destination), nullptr, paint);
+    } else {
+        FillPolygons({ TransformRect(destination, t) }, paint);
+    }
+}
+
+// ==================== Text Drawing ====================
+
+void SoftwareRenderContext::DrawTextString(const std::wstring& text, ITextFormat* format,
+                                           const Point& position, IBrush* brush) {
+    DrawTextLines(text, format, Rect(position.x, position.y, 0, 0), false, brush);
+}
+
+void SoftwareRenderContext::DrawTextString(const std::wstring& text, ITextFormat* format,
+                                           const Rect& rect, IBrush* brush) {
+    DrawTextLines(text, format, rect, true, brush);
+}
+
+void SoftwareRenderContext::DrawTextLines(const std::wstring& text, ITextFormat* format, const Rect& rect,
+                                          bool useRectWidth, IBrush* brush) {
+    Paint paint;
+    if (text.empty() || !format || !ResolvePaint(brush, paint)) return;
+    ++m_drawCalls;
+
+    std::unique_ptr<SoftwareTextFormat> foreign;
+    auto* fmt = dynamic_cast<SoftwareTextFormat*>(format);
+    if (!fmt) {
+        foreign = std::make_unique<SoftwareTextFormat>(format->GetFontFamily(), format->GetFontSize());
+        foreign->SetFontWeight(format->GetFontWeight());
+        foreign->SetTextAlignment(format->GetTextAlignment());
+        foreign->SetParagraphAlignment(format->GetParagraphAlignment());
+        foreign->SetWordWrapping(format->GetWordWrapping());
+        foreign->SetTextTrimming(format->GetTextTrimming());
+        fmt = foreign.get();
+    }
+
+    const float size = fmt->GetFontSize();
+    const float lineHeight = fmt->GetLineHeight();
+    const float baselineOffset = fmt->GetBaseline() - (fmt->GetBaseline() - size * 0.8f) * 0.5f;
+    auto lines = fmt->BreakLines(text, useRectWidth ? rect.width : 0);
+
+    float y = rect.y;
+    if (useRectWidth) {
+        float total = lineHeight * lines.size();
+        if (fmt->GetParagraphAlignment() == ParagraphAlignment::Center) y += (rect.height - total) * 0.5f;
+        else if (fmt->GetParagraphAlignment() == ParagraphAlignment::Far) y += rect.height - total;
+    }
+    bool trim = useRectWidth && fmt->GetTextTrimming() != TextTrimming::None;
+
+    // Glyphs are drawn as boxes sized by character class
+    const Transform& t = m_currentState.transform;
+    SoftwarePolygonList polygons;
+    for (const auto& line : lines) {
+        float x = rect.x;
+        if (useRectWidth) {
+            if (fmt->GetTextAlignment() == TextAlignment::Trailing) x += rect.width - line.width;
+            else if (fmt->GetTextAlignment() == TextAlignment::Center) x += (rect.width - line.width) * 0.5f;
+        }
+        float baseline = y + baselineOffset;
+        for (size_t i = 0; i < line.length; ++i) {
+            wchar_t ch = text[line.start + i];
+            float adv = fmt->GetAdvance(ch);
+            if (trim && x + adv > rect.Right() + 0.01f) break;
+            if (ch > L' ') {
+                float top, bottom = baseline;
+                if (ch >= 0x1100) {
+                    top = baseline - size * 0.8f;
+                    bottom = baseline + size * 0.08f;
+                } else if ((ch >= L'A' && ch <= L'Z') || (ch >= L'0' && ch <= L'9') || std::wcschr(L"bdfhklt", ch)) {
+                    top = baseline - size * 0.72f;
+                } else {
+                    top = baseline - size * 0.52f;
+                }
+                if (std::wcschr(L"gjpqy", ch)) bottom = baseline + size * 0.2f;
+                Rect glyph(x + adv * 0.12f, top, adv * 0.76f, bottom - top);
+                polygons.push_back(TransformRect(glyph, t));
+            }
+            x += adv;
+        }
+        y += lineHeight;
+    }
+    if (!polygons.empty()) FillPolygons(polygons, paint);
+}
+
+// ==================== Layers ====================
+
+std::unique_ptr<SoftwareSurface> SoftwareRenderContext::AcquireLayerSurface() {
+    int w = m_baseSurface->GetWidth(), h = m_baseSurface->GetHeight();
+    for (auto it = m_layerPool.begin(); it != m_layerPool.end(); ++it) {
+        if ((*it)->GetWidth() == w && (*it)->GetHeight() == h) {
+            auto surface = std::move(*it);
+            m_layerPool.erase(it);
+            return surface;
+        }
+    }
+    m_layerPool.clear();  // stale sizes
+    return std::make_unique<SoftwareSurface>(w, h);
+}
+
+void SoftwareRenderContext::PushLayer(float opacity) {
+    if (!m_baseSurface || m_clipStack.empty()) return;
+    LayerEntry entry;
+    entry.parent = m_target;
+    entry.surface = AcquireLayerSurface();
+    entry.bounds = CurrentClip().bounds;
+    entry.opacity = std::clamp(opacity, 0.0f, 1.0f);
+    entry.clipDepth = m_clipStack.size();
+    entry.surface->Fill(entry.bounds, 0);
+    m_target = entry.surface.get();
+    m_layerStack.push_back(std::move(entry));
+}
+
+void SoftwareRenderContext::PopLayer() {
+    if (m_layerStack.empty()) return;
+    LayerEntry entry = std::move(m_layerStack.back());
+    m_layerStack.pop_back();
+    m_target = entry.parent;
+    if (m_clipStack.size() > entry.clipDepth) m_clipStack.resize(entry.clipDepth);
+
+    uint32_t alpha = static_cast<uint32_t>(entry.opacity * 255.0f + 0.5f);
+    if (alpha > 0) {
+        const PixelRect& b = entry.bounds;
+        m_scratchPixels.resize((std::max)(0, b.Width()));
+        for (int y = b.y0; y < b.y1; ++y) {
+            std::memcpy(m_scratchPixels.data(), entry.surface->GetRow(y) + b.x0, sizeof(uint32_t) * b.Width());
+            SoftwareRasterizer::ScaleSpan(m_scratchPixels.data(), alpha, b.Width());
+            SoftwareRasterizer::BlendSpan(m_target->GetRow(y) + b.x0, m_scratchPixels.data(), b.Width());
+        }
+    }
+    m_layerPool.push_back(std::move(entry.surface));
+}
+
+// ==================== Factory Methods ====================
+
+// Brushes and text formats are interned by value; see ResourceInterner
+ISolidColorBrushPtr SoftwareRenderContext::CreateSolidColorBrush(const Color& color) {
+    return m_interner.AcquireSolidColorBrush(color, [&]() {
+        return std::make_shared<SoftwareSolidColorBrush>(color);
+    });
+}
+
+ILinearGradientBrushPtr SoftwareRenderContext::CreateLinearGradientBrush(const Point& start, const Point& end,
+                                                                         const std::vector<GradientStop>& stops) {
+    return m_interner.AcquireLinearGradientBrush(start, end, stops, [&]() {
+        return std::make_shared<SoftwareLinearGradientBrush>(start, end, stops);
+    });
+}
+
+IRadialGradientBrushPtr SoftwareRenderContext::CreateRadialGradientBrush(const Point& center, float rx, float ry,
+                                                                         const std::vector<GradientStop>& stops) {
+    return m_interner.AcquireRadialGradientBrush(center, rx, ry, stops, [&]() {
+        return std::make_shared<SoftwareRadialGradientBrush>(center, rx, ry, stops);
+    });
+}
+
+std::shared_ptr<IRectangleGeometry> SoftwareRenderContext::CreateRectangleGeometry(const Rect& rect) {
+    return std::make_shared<SoftwareRectangleGeometry>(rect);
+}
+
+std::shared_ptr<IRoundedRectangleGeometry> SoftwareRenderContext::CreateRoundedRectangleGeometry(
+    const Rect& rect, const CornerRadius& radius) {
+    return std::make_shared<SoftwareRoundedRectangleGeometry>(rect, radius);
+}
+
+std::shared_ptr<IEllipseGeometry> SoftwareRenderContext::CreateEllipseGeometry(const Point& center, float rx, float ry) {
+    return std::make_shared<SoftwareEllipseGeometry>(center, rx, ry);
+}
+
+std::shared_ptr<IPathGeometry> SoftwareRenderContext::CreatePathGeometry() {
+    return std::make_shared<SoftwarePathGeometry>();
+}
+
+std::shared_ptr<ICombinedGeometry> SoftwareRenderContext::CreateCombinedGeometry(IGeometry* g1, IGeometry* g2,
+                                                                                 CombineMode mode) {
+    auto g = std::make_shared<SoftwareCombinedGeometry>();
+    g->SetGeometries(g1, g2, mode);
+    return g;
+}
+
+ITextFormatPtr SoftwareRenderContext::CreateTextFormat(const std::wstring& fontFamily, float fontSize) {
+    return m_interner.AcquireTextFormat(fontFamily, fontSize, [&]() {
+        return std::make_shared<SoftwareTextFormat>(fontFamily, fontSize);
+    });
+}
+
+ITextLayoutPtr SoftwareRenderContext::CreateTextLayout(const std::wstring& text, ITextFormat* format,
+                                                       const Size& maxSize) {
+    return std::make_shared<SoftwareTextLayout>(text, format, maxSize);
+}
+
+IBitmapPtr SoftwareRenderContext::CreateBitmap(int width, int height, PixelFormat format) {
+    auto b = std::make_shared<SoftwareBitmap>();
+    return b->Initialize(width, height, format) ? b : nullptr;
+}
+
+IBitmapPtr SoftwareRenderContext::LoadBitmapFromFile(const std::wstring& filePath) {
+    auto b = std::make_shared<SoftwareBitmap>();
+    return b->LoadFromFile(filePath) ? b : nullptr;
+}
+
+IBitmapPtr SoftwareRenderContext::LoadBitmapFromMemory(const void* data, size_t size) {
+    auto b = std::make_shared<SoftwareBitmap>();
+    return b->LoadFromMemory(data, size) ? b : nullptr;
+}
+
+} // namespace rendering
+} // namespace luaui
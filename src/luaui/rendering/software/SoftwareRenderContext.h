@@ -0,0 +1,190 @@
+#pragma once
+
+#include "IRenderContext.h"
+#include "ResourceInterner.h"
+#include "SoftwareRasterizer.h"
+#include <memory>
+#include <stack>
+#include <vector>
+
+namespace luaui {
+namespace rendering {
+
+class ISoftwarePaint;
+class SoftwareTextFormat;
+struct SoftwareShape;
+
+// CPU implementation of the render context.
+//
+// Draws into a SoftwareSurface owned by the engine or an offscreen target.
+// Geometry is flattened to polygons in device space and rasterized with
+// exact-area coverage; spans are composited with SSE2 when available.
+class SoftwareRenderContext : public IRenderContext {
+public:
+    SoftwareRenderContext();
+    ~SoftwareRenderContext() override;
+
+    // Bind to a target surface (not owned)
+    bool Initialize(SoftwareSurface* surface);
+    void Shutdown();
+    SoftwareSurface* GetSurface() const { return m_baseSurface; }
+
+    // Draw calls issued since the last ResetDrawCallCount()
+    int GetDrawCallCount() const { return m_drawCalls; }
+    void ResetDrawCallCount() { m_drawCalls = 0; }
+
+    // IRenderContext implementation
+    bool BeginDraw() override;
+    bool EndDraw() override;
+    void Clear(const Color& color) override;
+    void Flush() override {}
+
+    void PushState() override;
+    void PopState() override;
+    void ResetState() override;
+
+    void SetTransform(const Transform& transform) override { m_currentState.transform = transform; }
+    void MultiplyTransform(const Transform& transform) override;
+    Transform GetTransform() const override { return m_currentState.transform; }
+
+    void SetOpacity(float opacity) override;
+    float GetOpacity() const override { return m_currentState.opacity; }
+
+    void SetAntialias(bool enabled) override { m_currentState.antialias = enabled; }
+    bool GetAntialias() const override { return m_currentState.antialias; }
+
+    void PushClip(const Rect& rect) override;
+    void PushClip(const IGeometry& geometry) override;
+    void PopClip() override;
+    void ResetClip() override;
+    Rect GetClipBounds() const override;
+
+    void DrawLine(const Point& p1, const Point& p2, IBrush* brush, float strokeWidth = 1.0f,
+                  const StrokeStyle* strokeStyle = nullptr) override;
+
+    void DrawRectangle(const Rect& rect, IBrush* brush, float strokeWidth = 1.0f,
+                       const StrokeStyle* strokeStyle = nullptr) override;
+    void FillRectangle(const Rect& rect, IBrush* brush) override;
+    void FillRectangles(const Rect* rects, size_t count, IBrush* brush) override;
+    void DrawLines(const Point* points, size_t segmentCount, IBrush* brush, float strokeWidth = 1.0f,
+                   const StrokeStyle* strokeStyle = nullptr) override;
+
+    void DrawRoundedRectangle(const Rect& rect, const CornerRadius& radius, IBrush* brush,
+                              float strokeWidth = 1.0f, const StrokeStyle* strokeStyle = nullptr) override;
+    void FillRoundedRectangle(const Rect& rect, const CornerRadius& radius, IBrush* brush) override;
+
+    void DrawEllipse(const Point& center, float radiusX, float radiusY, IBrush* brush,
+                     float strokeWidth = 1.0f, const StrokeStyle* strokeStyle = nullptr) override;
+    void FillEllipse(const Point& center, float radiusX, float radiusY, IBrush* brush) override;
+
+    void DrawGeometry(const IGeometry& geometry, IBrush* brush, float strokeWidth = 1.0f,
+                      const StrokeStyle* strokeStyle = nullptr) override;
+    void FillGeometry(const IGeometry& geometry, IBrush* brush) override;
+
+    void DrawBitmap(IBitmap* bitmap, const Point& destination, float opacity = 1.0f) override;
+    void DrawBitmap(IBitmap* bitmap, const Rect& destination, float opacity = 1.0f) override;
+    void DrawBitmap(IBitmap* bitmap, const Rect& destination, const Rect& source, float opacity = 1.0f) override;
+
+    void DrawTextString(const std::wstring& text, ITextFormat* format, const Point& position, IBrush* brush) override;
+    void DrawTextString(const std::wstring& text, ITextFormat* format, const Rect& rect, IBrush* brush) override;
+
+    void PushLayer(float opacity = 1.0f) override;
+    void PopLayer() override;
+
+    // Factory methods
+    ISolidColorBrushPtr CreateSolidColorBrush(const Color& color) override;
+    ILinearGradientBrushPtr CreateLinearGradientBrush(const Point& start, const Point& end,
+                                                       const std::vector<GradientStop>& stops) override;
+    IRadialGradientBrushPtr CreateRadialGradientBrush(const Point& center, float rx, float ry,
+                                                       const std::vector<GradientStop>& stops) override;
+
+    std::shared_ptr<IRectangleGeometry> CreateRectangleGeometry(const Rect& rect) override;
+    std::shared_ptr<IRoundedRectangleGeometry> CreateRoundedRectangleGeometry(const Rect& rect,
+                                                                               const CornerRadius& radius) override;
+    std::shared_ptr<IEllipseGeometry> CreateEllipseGeometry(const Point& center, float rx, float ry) override;
+    std::shared_ptr<IPathGeometry> CreatePathGeometry() override;
+    std::shared_ptr<ICombinedGeometry> CreateCombinedGeometry(IGeometry* g1, IGeometry* g2,
+                                                               CombineMode mode) override;
+
+    ITextFormatPtr CreateTextFormat(const std::wstring& fontFamily, float fontSize) override;
+    ITextLayoutPtr CreateTextLayout(const std::wstring& text, ITextFormat* format, const Size& maxSize) override;
+
+    IBitmapPtr CreateBitmap(int width, int height, PixelFormat format) override;
+    IBitmapPtr LoadBitmapFromFile(const std::wstring& filePath) override;
+    IBitmapPtr LoadBitmapFromMemory(const void* data, size_t size) override;
+
+    ResourceInterner* GetResourceInterner() override { return &m_interner; }
+
+private:
+    // Resolved pixel source for one draw call
+    struct Paint {
+        const ISoftwarePaint* shader = nullptr;  // null => solid `color`
+        uint32_t color = 0;                      // premultiplied, opacity applied
+        uint32_t alpha = 255;                    // opacity for shaded paints
+        Transform deviceToBrush;
+    };
+
+    struct State {
+        Transform transform;
+        float opacity = 1.0f;
+        bool antialias = true;
+    };
+
+    struct ClipEntry {
+        PixelRect bounds;                          // device-space clip bounds
+        std::shared_ptr<const CoverageMask> mask;  // optional soft mask covering bounds
+    };
+
+    struct LayerEntry {
+        SoftwareSurface* parent = nullptr;
+        std::unique_ptr<SoftwareSurface> surface;
+        PixelRect bounds;
+        float opacity = 1.0f;
+        size_t clipDepth = 0;
+    };
+
+    bool ResolvePaint(IBrush* brush, Paint& paint) const;
+    const ClipEntry& CurrentClip() const { return m_clipStack.back(); }
+    float TransformScale() const;
+
+    // Core compositing
+    void FillPolygons(const SoftwarePolygonList& polygons, const Paint& paint);
+    void FillShape(const SoftwareShape& shape, const Paint& paint);
+    void FillMask(const CoverageMask& mask, const Paint& paint);
+    void FillAlignedRect(const Rect& outer, const Rect* inner, const Paint& paint);
+    void FillRectWithPaint(const Rect& rect, const Paint& paint);
+    void StrokeLine(const Point& p1, const Point& p2, const Paint& paint, float strokeWidth,
+                    const StrokeStyle* strokeStyle);
+    void CompositeRow(int y, int x, int count, const uint8_t* coverage, const Paint& paint);
+    void StrokeFigures(const SoftwareFigureList& figures, const Paint& paint, float strokeWidth,
+                       const StrokeStyle* strokeStyle);
+    void RasterizeShape(const SoftwareShape& shape, const PixelRect& clip, CoverageMask& out);
+    void DrawTextLines(const std::wstring& text, ITextFormat* format, const Rect& rect,
+                       bool useRectWidth, IBrush* brush);
+
+    std::unique_ptr<SoftwareSurface> AcquireLayerSurface();
+
+    SoftwareSurface* m_target = nullptr;   // current draw target (base surface or layer)
+    SoftwareSurface* m_baseSurface = nullptr;
+
+    State m_currentState;
+    std::stack<State> m_stateStack;
+    std::vector<ClipEntry> m_clipStack;    // [0] is the whole surface
+    std::vector<LayerEntry> m_layerStack;
+    std::vector<std::unique_ptr<SoftwareSurface>> m_layerPool;
+
+    SoftwareRasterizer m_rasterizer;
+    CoverageMask m_scratchMask;
+    std::vector<uint32_t> m_scratchPixels;
+    std::vector<uint8_t> m_scratchCoverage;
+    std::vector<uint8_t> m_scratchRow;
+    std::vector<float> m_columnOuter;
+    std::vector<float> m_columnInner;
+
+    int m_drawCalls = 0;
+
+    ResourceInterner m_interner;
+};
+
+} // namespace rendering
+} // namespace luaui
@@ -0,0 +1,251 @@
+#include "SoftwareRenderEngine.h"
+#include "SoftwareRenderTarget.h"
+#include "ITextLayout.h"
+#include "SoftwareBitmap.h"
+#include "BitmapService.h"
+#include <chrono>
+
+namespace luaui {
+namespace rendering {
+
+namespace {
+
+int64_t NowMicroseconds() {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+} // anonymous namespace
+
+SoftwareRenderEngine::SoftwareRenderEngine() = default;
+
+SoftwareRenderEngine::~SoftwareRenderEngine() {
+    Shutdown();
+}
+
+bool SoftwareRenderEngine::Initialize(RenderAPI api) {
+    (void)api;  // always the software rasterizer
+    if (m_initialized) return true;
+
+    m_context = std::make_unique<SoftwareRenderContext>();
+    m_resourceCache = std::make_unique<ResourceCache>(m_context.get());
+    m_resourceCache->SetByteBudget(m_maxCacheBytes);
+
+    // Headless builds decode images (uncompressed BMP) with the software codec
+    if (!BitmapService::Instance().HasDecoder()) {
+        BitmapService::Instance().SetDecoder(&SoftwareBitmap::DecodePixels);
+    }
+
+    m_initialized = true;
+    return true;
+}
+
+void SoftwareRenderEngine::Shutdown() {
+    // Clear resource cache before context
+    if (m_resourceCache) {
+        m_resourceCache->ClearAll();
+        m_resourceCache.reset();
+    }
+    m_context.reset();
+    m_surface.Resize(0, 0);
+    m_width = 0;
+    m_height = 0;
+    m_inFrame = false;
+    m_initialized = false;
+}
+
+bool SoftwareRenderEngine::IsInitialized() const {
+    return m_initialized;
+}
+
+bool SoftwareRenderEngine::CreateRenderTarget(const RenderTargetDesc& desc) {
+    if (!m_initialized) return false;
+    // The native handle is ignored: output always goes to the in-memory surface
+    if (desc.width <= 0 || desc.height <= 0) return false;
+
+    m_width = desc.width;
+    m_height = desc.height;
+    m_dpiX = desc.dpiX;
+    m_dpiY = desc.dpiY;
+    m_surface.Resize(m_width, m_height);
+    return m_context->Initialize(&m_surface);
+}
+
+void SoftwareRenderEngine::DestroyRenderTarget() {
+    if (m_context) m_context->Shutdown();
+    m_surface.Resize(0, 0);
+    m_width = 0;
+    m_height = 0;
+}
+
+bool SoftwareRenderEngine::ResizeRenderTarget(int width, int height) {
+    if (!m_context || !m_context->GetSurface() || width <= 0 || height <= 0) return false;
+
+    m_width = width;
+    m_height = height;
+    m_surface.Resize(width, height);
+    return true;
+}
+
+int SoftwareRenderEngine::GetWidth() const {
+    return m_width;
+}
+
+int SoftwareRenderEngine::GetHeight() const {
+    return m_height;
+}
+
+Size SoftwareRenderEngine::GetSize() const {
+    return Size(static_cast<float>(m_width), static_cast<float>(m_height));
+}
+
+float SoftwareRenderEngine::GetDpiX() const {
+    return m_dpiX;
+}
+
+float SoftwareRenderEngine::GetDpiY() const {
+    return m_dpiY;
+}
+
+void SoftwareRenderEngine::SetDpi(float dpiX, float dpiY) {
+    m_dpiX = dpiX;
+    m_dpiY = dpiY;
+}
+
+IRenderContext* SoftwareRenderEngine::GetContext() {
+    return m_context.get();
+}
+
+const IRenderContext* SoftwareRenderEngine::GetContext() const {
+    return m_context.get();
+}
+
+bool SoftwareRenderEngine::BeginFrame() {
+    if (!m_context || !m_context->GetSurface()) return false;
+    if (m_inFrame) return true;
+
+    m_frameStartUs = NowMicroseconds();
+    m_context->ResetDrawCallCount();
+    m_context->BeginDraw();
+    m_context->Clear(Color(1, 1, 1, 1)); // Clear to white
+
+    m_inFrame = true;
+    return true;
+}
+
+void SoftwareRenderEngine::Present() {
+    if (!m_inFrame) return;
+
+    m_context->EndDraw();
+    m_inFrame = false;
+    if (m_resourceCache) {
+        m_resourceCache->EndFrame();
+    }
+
+    m_stats.drawCallCount = m_context->GetDrawCallCount();
+    if (m_statsEnabled) {
+        float ms = (NowMicroseconds() - m_frameStartUs) / 1000.0f;
+        m_stats.frameTime = ms;
+        m_stats.cpuTime = ms;
+    }
+}
+
+void SoftwareRenderEngine::Present(const Rect& dirtyRect) {
+    (void)dirtyRect;
+    // Nothing to copy to a window; the surface already holds the frame
+    Present();
+}
+
+RenderCapabilities SoftwareRenderEngine::GetCapabilities() const {
+    RenderCapabilities caps;
+    caps.hardwareAcceleration = false;
+    caps.supportsEffects = false;
+    caps.supportsGeometryRealization = false;
+    caps.supportsSpriteBatch = false;
+    caps.maxTextureSize = 16384;
+    caps.maxTextureUnits = 1;
+    return caps;
+}
+
+RenderAPI SoftwareRenderEngine::GetAPI() const {
+    return RenderAPI::Software;
+}
+
+std::string SoftwareRenderEngine::GetAPIName() const {
+    return "Software";
+}
+
+std::string SoftwareRenderEngine::GetGPUName() const {
+    return "CPU";
+}
+
+FrameStats SoftwareRenderEngine::GetStats() const {
+    return m_stats;
+}
+
+void SoftwareRenderEngine::ResetStats() {
+    m_stats = FrameStats();
+}
+
+void SoftwareRenderEngine::EnableStats(bool enable) {
+    m_statsEnabled = enable;
+}
+
+void SoftwareRenderEngine::SetResourceCacheSize(size_t maxBytes) {
+    m_maxCacheBytes = maxBytes;
+    if (m_resourceCache) {
+        m_resourceCache->SetByteBudget(maxBytes);
+    }
+}
+
+void SoftwareRenderEngine::ClearResourceCache() {
+    if (m_resourceCache) {
+        m_resourceCache->ClearAll();
+    }
+}
+
+void SoftwareRenderEngine::TrimResourceCache() {
+    if (m_resourceCache) {
+        m_resourceCache->Trim();
+    }
+}
+
+bool SoftwareRenderEngine::IsDeviceLost() const {
+    return false;  // system memory is never lost
+}
+
+bool SoftwareRenderEngine::RecoverDevice() {
+    return true;
+}
+
+void SoftwareRenderEngine::OnDeviceLost(std::function<void()> callback) {
+    (void)callback;
+}
+
+void SoftwareRenderEngine::OnDeviceRestored(std::function<void()> callback) {
+    (void)callback;
+}
+
+// Advanced features
+std::unique_ptr<IRenderTarget> SoftwareRenderEngine::CreateRenderTarget(int width, int height, bool useAlpha) {
+    if (!m_initialized || width <= 0 || height <= 0) return nullptr;
+    return std::make_unique<SoftwareRenderTarget>(width, height, useAlpha);
+}
+
+std::unique_ptr<ITextLayoutAdvanced> SoftwareRenderEngine::CreateTextLayoutAdvanced() {
+    // Advanced layout needs DirectWrite shaping
+    return nullptr;
+}
+
+bool SoftwareRenderEngine::SaveToFile(const std::wstring& filePath) const {
+    return SoftwareBitmap::SaveBmp(filePath, m_surface.GetPixels(), m_surface.GetWidth(),
+                                   m_surface.GetHeight(), m_surface.GetStride());
+}
+
+// Factory function
+IRenderEnginePtr CreateSoftwareRenderEngine() {
+    return std::make_unique<SoftwareRenderEngine>();
+}
+
+} // namespace rendering
+} // namespace luaui
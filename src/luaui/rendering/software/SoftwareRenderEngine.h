@@ -0,0 +1,97 @@
+#pragma once
+
+#include "IRenderEngine.h"
+#include "SoftwareRenderContext.h"
+#include "ResourceCache.h"
+#include <vector>
+
+namespace luaui {
+namespace rendering {
+
+// Headless render engine backed by the CPU rasterizer.
+//
+// Renders into an in-memory BGRA surface instead of a window, so frames can be
+// produced without a GPU or display (benchmarks, CI, golden-image tests).
+// Present() only finishes the frame; read the result via GetSurface() or
+// SaveToFile().
+class SoftwareRenderEngine : public IRenderEngine {
+public:
+    SoftwareRenderEngine();
+    ~SoftwareRenderEngine() override;
+
+    // IRenderEngine
+    bool Initialize(RenderAPI api = RenderAPI::Software) override;
+    void Shutdown() override;
+    bool IsInitialized() const override;
+
+    bool CreateRenderTarget(const RenderTargetDesc& desc) override;
+    void DestroyRenderTarget() override;
+    bool ResizeRenderTarget(int width, int height) override;
+
+    int GetWidth() const override;
+    int GetHeight() const override;
+    Size GetSize() const override;
+    float GetDpiX() const override;
+    float GetDpiY() const override;
+    void SetDpi(float dpiX, float dpiY) override;
+
+    IRenderContext* GetContext() override;
+    const IRenderContext* GetContext() const override;
+
+    bool BeginFrame() override;
+    void Present() override;
+    void Present(const Rect& dirtyRect) override;
+
+    RenderCapabilities GetCapabilities() const override;
+    RenderAPI GetAPI() const override;
+    std::string GetAPIName() const override;
+    std::string GetGPUName() const override;
+
+    FrameStats GetStats() const override;
+    void ResetStats() override;
+    void EnableStats(bool enable) override;
+
+    void SetResourceCacheSize(size_t maxBytes) override;
+    void ClearResourceCache() override;
+    void TrimResourceCache() override;
+
+    bool IsDeviceLost() const override;
+    bool RecoverDevice() override;
+    void OnDeviceLost(std::function<void()> callback) override;
+    void OnDeviceRestored(std::function<void()> callback) override;
+
+    // Advanced features
+    std::unique_ptr<IRenderTarget> CreateRenderTarget(int width, int height,
+                                                       bool useAlpha = true) override;
+    std::unique_ptr<ITextLayoutAdvanced> CreateTextLayoutAdvanced() override;
+
+    // Software specific
+    const SoftwareSurface& GetSurface() const { return m_surface; }
+    bool SaveToFile(const std::wstring& filePath) const;
+
+private:
+    // State
+    bool m_initialized = false;
+    bool m_inFrame = false;
+    bool m_statsEnabled = false;
+
+    // Render target info
+    int m_width = 0;
+    int m_height = 0;
+    float m_dpiX = 96.0f;
+    float m_dpiY = 96.0f;
+
+    SoftwareSurface m_surface;
+    std::unique_ptr<SoftwareRenderContext> m_context;
+
+    // Resource cache
+    std::unique_ptr<ResourceCache> m_resourceCache;
+    size_t m_maxCacheBytes = 64 * 1024 * 1024; // 64MB default
+
+    // Stats
+    FrameStats m_stats;
+    int64_t m_frameStartUs = 0;
+};
+
+} // namespace rendering
+} // namespace luaui
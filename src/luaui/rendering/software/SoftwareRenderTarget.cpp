@@ -0,0 +1,56 @@
+#include "SoftwareRenderTarget.h"
+#include "SoftwareBitmap.h"
+
+namespace luaui {
+namespace rendering {
+
+SoftwareRenderTarget::SoftwareRenderTarget(int width, int height, bool useAlpha)
+    : m_surface(width, height)
+    , m_useAlpha(useAlpha) {
+    m_context.Initialize(&m_surface);
+    // Opaque targets start black, like an alpha-ignoring D2D target
+    if (!m_useAlpha) m_surface.Clear(0xFF000000u);
+}
+
+SoftwareRenderTarget::~SoftwareRenderTarget() {
+    m_context.Shutdown();
+}
+
+bool SoftwareRenderTarget::BeginDraw() {
+    if (m_isDrawing) return false;
+    m_isDrawing = m_context.BeginDraw();
+    return m_isDrawing;
+}
+
+bool SoftwareRenderTarget::EndDraw() {
+    if (!m_isDrawing) return false;
+    m_isDrawing = false;
+    return m_context.EndDraw();
+}
+
+void SoftwareRenderTarget::Clear(const Color& color) {
+    Color c = color;
+    if (!m_useAlpha) c.a = 1.0f;
+    m_context.Clear(c);
+}
+
+IBitmapPtr SoftwareRenderTarget::ToBitmap() const {
+    auto bitmap = std::make_shared<SoftwareBitmap>();
+    if (!bitmap->InitializeFromSurface(m_surface)) return nullptr;
+    return bitmap;
+}
+
+bool SoftwareRenderTarget::SaveToFile(const std::wstring& filePath) const {
+    return SoftwareBitmap::SaveBmp(filePath, m_surface.GetPixels(), m_surface.GetWidth(),
+                                   m_surface.GetHeight(), m_surface.GetStride());
+}
+
+bool SoftwareRenderTarget::Resize(int width, int height) {
+    if (width <= 0 || height <= 0 || m_isDrawing) return false;
+    m_surface.Resize(width, height);
+    if (!m_useAlpha) m_surface.Clear(0xFF000000u);
+    return m_context.Initialize(&m_surface);
+}
+
+} // namespace rendering
+} // namespace luaui
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "IRenderTarget.h"
+#include "SoftwareRenderContext.h"
+
+namespace luaui {
+namespace rendering {
+
+// CPU off-screen render target: owns its surface and a context bound to it
+class SoftwareRenderTarget : public IRenderTarget {
+public:
+    SoftwareRenderTarget(int width, int height, bool useAlpha);
+    ~SoftwareRenderTarget() override;
+
+    // IRenderTarget implementation
+    int GetWidth() const override { return m_surface.GetWidth(); }
+    int GetHeight() const override { return m_surface.GetHeight(); }
+    Size GetSize() const override {
+        return Size(static_cast<float>(m_surface.GetWidth()), static_cast<float>(m_surface.GetHeight()));
+    }
+    PixelFormat GetFormat() const override { return PixelFormat::BGRA8; }
+
+    IRenderContext* GetContext() override { return &m_context; }
+    const IRenderContext* GetContext() const override { return &m_context; }
+
+    bool BeginDraw() override;
+    bool EndDraw() override;
+    void Clear(const Color& color) override;
+
+    IBitmapPtr ToBitmap() const override;
+    bool SaveToFile(const std::wstring& filePath) const override;
+    bool Resize(int width, int height) override;
+
+    void* GetNativeTarget() const override { return const_cast<SoftwareSurface*>(&m_surface); }
+
+    // Software specific
+    const SoftwareSurface& GetSurface() const { return m_surface; }
+
+private:
+    SoftwareSurface m_surface;
+    SoftwareRenderContext m_context;
+    bool m_useAlpha = true;
+    bool m_isDrawing = false;
+};
+
+} // namespace rendering
+} // namespace luaui
@@ -0,0 +1,175 @@
+#include "SoftwareTextFormat.h"
+#include <cmath>
+#include <cwchar>
+
+namespace luaui {
+namespace rendering {
+
+namespace {
+
+bool IsWide(wchar_t ch) {
+    // CJK, Hangul, fullwidth forms and similar East Asian wide ranges
+    return (ch >= 0x1100 && ch <= 0x115F) || (ch >= 0x2E80 && ch <= 0xA4CF) ||
+           (ch >= 0xAC00 && ch <= 0xD7A3) || (ch >= 0xF900 && ch <= 0xFAFF) ||
+           (ch >= 0xFE30 && ch <= 0xFE4F) || (ch >= 0xFF00 && ch <= 0xFF60) ||
+           (ch >= 0xFFE0 && ch <= 0xFFE6);
+}
+
+bool IsBreakable(wchar_t ch) {
+    return ch == L' ' || ch == L'\t' || IsWide(ch);
+}
+
+} // anonymous namespace
+
+// ==================== SoftwareTextFormat ====================
+
+SoftwareTextFormat::SoftwareTextFormat(const std::wstring& fontFamily, float fontSize)
+    : m_fontFamily(fontFamily), m_fontSize(fontSize > 0 ? fontSize : 12.0f) {
+}
+
+void SoftwareTextFormat::SetLineSpacing(float lineHeight, float baseline) {
+    m_lineHeight = lineHeight;
+    m_baseline = baseline;
+}
+
+float SoftwareTextFormat::GetLineHeight() const {
+    return m_lineHeight > 0 ? m_lineHeight : std::ceil(m_fontSize * 1.25f);
+}
+
+float SoftwareTextFormat::GetBaseline() const {
+    return m_baseline > 0 ? m_baseline : m_fontSize * 0.95f;
+}
+
+float SoftwareTextFormat::GetAdvance(wchar_t ch) const {
+    float em;
+    if (ch == L'\t') {
+        em = 1.6f;
+    } else if (ch == L' ') {
+        em = 0.28f;
+    } else if (IsWide(ch)) {
+        em = 1.0f;
+    } else if (std::wcschr(L"iljtfrI!.,;:'|()[]`", ch)) {
+        em = 0.3f;
+    } else if (std::wcschr(L"mwMW@%", ch)) {
+        em = 0.85f;
+    } else if ((ch >= L'A' && ch <= L'Z') || (ch >= L'0' && ch <= L'9')) {
+        em = 0.62f;
+    } else {
+        em = 0.52f;
+    }
+    float weightScale = static_cast<int>(m_weight) >= static_cast<int>(FontWeight::SemiBold) ? 1.06f : 1.0f;
+    return em * m_fontSize * weightScale;
+}
+
+std::vector<SoftwareTextFormat::Line> SoftwareTextFormat::BreakLines(const std::wstring& text,
+                                                                    float maxWidth) const {
+    std::vector<Line> lines;
+    bool wrap = maxWidth > 0 && m_wordWrapping != WordWrapping::NoWrap;
+
+    Line line;
+    size_t lastBreak = std::wstring::npos;   // index after which the line may break
+    float widthAtBreak = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        wchar_t ch = text[i];
+        if (ch == L'\n') {
+            line.length = i - line.start;
+            lines.push_back(line);
+            line = Line();
+            line.start = i + 1;
+            lastBreak = std::wstring::npos;
+            continue;
+        }
+        if (ch == L'\r') continue;
+
+        float adv = GetAdvance(ch);
+        if (wrap && line.width + adv > maxWidth && i > line.start) {
+            if (lastBreak != std::wstring::npos && m_wordWrapping != WordWrapping::EmergencyBreak) {
+                // Break after the last space/wide character
+                Line out = line;
+                out.length = lastBreak + 1 - line.start;
+                out.width = widthAtBreak;
+                lines.push_back(out);
+                line.start = lastBreak + 1;
+                line.width -= widthAtBreak;
+            } else {
+                // Character break when a single word does not fit
+                line.length = i - line.start;
+                lines.push_back(line);
+                line.start = i;
+                line.width = 0;
+            }
+            lastBreak = std::wstring::npos;
+        }
+        line.width += adv;
+        if (IsBreakable(ch)) {
+            lastBreak = i;
+            widthAtBreak = line.width;
+        }
+    }
+    line.length = text.size() - line.start;
+    lines.push_back(line);
+
+    // Trailing spaces do not count toward the line width
+    for (auto& l : lines) {
+        size_t end = l.start + l.length;
+        while (end > l.start && (text[end - 1] == L' ' || text[end - 1] == L'\r')) {
+            if (text[end - 1] == L' ') l.width -= GetAdvance(L' ');
+            --end;
+        }
+        l.width = (std::max)(0.0f, l.width);
+    }
+    return lines;
+}
+
+Size SoftwareTextFormat::MeasureText(const std::wstring& text, float maxWidth) {
+    if (text.empty()) return Size(0, GetLineHeight());
+    auto lines = BreakLines(text, maxWidth);
+    float width = 0;
+    for (const auto& l : lines) width = (std::max)(width, l.width);
+    return Size(width, GetLineHeight() * lines.size());
+}
+
+int SoftwareTextFormat::HitTest(const std::wstring& text, const Point& point) {
+    auto lines = BreakLines(text, 0);
+    if (lines.empty()) return 0;
+    int lineIndex = std::clamp(static_cast<int>(point.y / GetLineHeight()), 0,
+                               static_cast<int>(lines.size()) - 1);
+    const Line& line = lines[lineIndex];
+    float x = 0;
+    for (size_t i = 0; i < line.length; ++i) {
+        float adv = GetAdvance(text[line.start + i]);
+        if (point.x < x + adv * 0.5f) return static_cast<int>(line.start + i);
+        x += adv;
+    }
+    return static_cast<int>(line.start + line.length);
+}
+
+// ==================== SoftwareTextLayout ====================
+
+SoftwareTextLayout::SoftwareTextLayout(const std::wstring& text, ITextFormat* format, const Size& maxSize)
+    : m_format(format ? format->GetFontFamily() : L"", format ? format->GetFontSize() : 12.0f)
+    , m_text(text)
+    , m_maxSize(maxSize) {
+    if (format) {
+        m_format.SetFontWeight(format->GetFontWeight());
+        m_format.SetFontStyle(format->GetFontStyle());
+        m_format.SetTextAlignment(format->GetTextAlignment());
+        m_format.SetParagraphAlignment(format->GetParagraphAlignment());
+        m_format.SetWordWrapping(format->GetWordWrapping());
+        m_format.SetTextTrimming(format->GetTextTrimming());
+    }
+}
+
+Size SoftwareTextLayout::GetLayoutSize() const {
+    auto lines = m_format.BreakLines(m_text, m_maxSize.width);
+    float width = 0;
+    for (const auto& l : lines) width = (std::max)(width, l.width);
+    return Size(width, m_format.GetLineHeight() * lines.size());
+}
+
+int SoftwareTextLayout::GetLineCount() const {
+    return static_cast<int>(m_format.BreakLines(m_text, m_maxSize.width).size());
+}
+
+} // namespace rendering
+} // namespace luaui
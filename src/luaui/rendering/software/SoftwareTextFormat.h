@@ -0,0 +1,116 @@
+#pragma once
+
+#include "ITextFormat.h"
+#include <vector>
+
+namespace luaui {
+namespace rendering {
+
+// Text format with font-independent approximate metrics.
+//
+// There is no font rasterizer in the headless backend: advances come from a
+// per-character width class, and glyphs are drawn as boxes ("greeked") so
+// layout, wrapping and alignment match real text closely enough for
+// benchmarks and layout screenshots.
+class SoftwareTextFormat : public ITextFormat {
+public:
+    struct Line {
+        size_t start = 0;
+        size_t length = 0;
+        float width = 0;
+    };
+
+    SoftwareTextFormat(const std::wstring& fontFamily, float fontSize);
+
+    // ITextFormat
+    void SetFontFamily(const std::wstring& family) override { m_fontFamily = family; }
+    void SetFontSize(float size) override { m_fontSize = size > 0 ? size : m_fontSize; }
+    void SetFontWeight(FontWeight weight) override { m_weight = weight; }
+    void SetFontStyle(FontStyle style) override { m_style = style; }
+    std::wstring GetFontFamily() const override { return m_fontFamily; }
+    float GetFontSize() const override { return m_fontSize; }
+    FontWeight GetFontWeight() const override { return m_weight; }
+    FontStyle GetFontStyle() const override { return m_style; }
+
+    void SetTextAlignment(TextAlignment align) override { m_textAlignment = align; }
+    void SetParagraphAlignment(ParagraphAlignment align) override { m_paragraphAlignment = align; }
+    void SetWordWrapping(WordWrapping wrapping) override { m_wordWrapping = wrapping; }
+    void SetTextTrimming(TextTrimming trimming) override { m_trimming = trimming; }
+    TextAlignment GetTextAlignment() const override { return m_textAlignment; }
+    ParagraphAlignment GetParagraphAlignment() const override { return m_paragraphAlignment; }
+    WordWrapping GetWordWrapping() const override { return m_wordWrapping; }
+    TextTrimming GetTextTrimming() const override { return m_trimming; }
+
+    void SetLineSpacing(float lineHeight, float baseline) override;
+    float GetLineHeight() const override;
+    float GetBaseline() const override;
+
+    void* GetNativeFormat(IRenderContext* context) override { (void)context; return this; }
+
+    Size MeasureText(const std::wstring& text, float maxWidth = 0) override;
+    int HitTest(const std::wstring& text, const Point& point) override;
+
+    // Software specific
+    float GetAdvance(wchar_t ch) const;
+    std::vector<Line> BreakLines(const std::wstring& text, float maxWidth) const;
+
+private:
+    std::wstring m_fontFamily;
+    float m_fontSize = 12.0f;
+    FontWeight m_weight = FontWeight::Regular;
+    FontStyle m_style = FontStyle::Normal;
+    TextAlignment m_textAlignment = TextAlignment::Leading;
+    ParagraphAlignment m_paragraphAlignment = ParagraphAlignment::Near;
+    WordWrapping m_wordWrapping = WordWrapping::Wrap;
+    TextTrimming m_trimming = TextTrimming::None;
+    float m_lineHeight = 0;   // 0 = derived from font size
+    float m_baseline = 0;
+};
+
+// Text layout: a text format bound to a string and a layout box
+class SoftwareTextLayout : public ITextLayout {
+public:
+    SoftwareTextLayout(const std::wstring& text, ITextFormat* format, const Size& maxSize);
+
+    // ITextFormat (forwarded to the owned format)
+    void SetFontFamily(const std::wstring& family) override { m_format.SetFontFamily(family); }
+    void SetFontSize(float size) override { m_format.SetFontSize(size); }
+    void SetFontWeight(FontWeight weight) override { m_format.SetFontWeight(weight); }
+    void SetFontStyle(FontStyle style) override { m_format.SetFontStyle(style); }
+    std::wstring GetFontFamily() const override { return m_format.GetFontFamily(); }
+    float GetFontSize() const override { return m_format.GetFontSize(); }
+    FontWeight GetFontWeight() const override { return m_format.GetFontWeight(); }
+    FontStyle GetFontStyle() const override { return m_format.GetFontStyle(); }
+    void SetTextAlignment(TextAlignment align) override { m_format.SetTextAlignment(align); }
+    void SetParagraphAlignment(ParagraphAlignment align) override { m_format.SetParagraphAlignment(align); }
+    void SetWordWrapping(WordWrapping wrapping) override { m_format.SetWordWrapping(wrapping); }
+    void SetTextTrimming(TextTrimming trimming) override { m_format.SetTextTrimming(trimming); }
+    TextAlignment GetTextAlignment() const override { return m_format.GetTextAlignment(); }
+    ParagraphAlignment GetParagraphAlignment() const override { return m_format.GetParagraphAlignment(); }
+    WordWrapping GetWordWrapping() const override { return m_format.GetWordWrapping(); }
+    TextTrimming GetTextTrimming() const override { return m_format.GetTextTrimming(); }
+    void SetLineSpacing(float lineHeight, float baseline) override { m_format.SetLineSpacing(lineHeight, baseline); }
+    float GetLineHeight() const override { return m_format.GetLineHeight(); }
+    float GetBaseline() const override { return m_format.GetBaseline(); }
+    void* GetNativeFormat(IRenderContext* context) override { return m_format.GetNativeFormat(context); }
+    Size MeasureText(const std::wstring& text, float maxWidth = 0) override { return m_format.MeasureText(text, maxWidth); }
+    int HitTest(const std::wstring& text, const Point& point) override { return m_format.HitTest(text, point); }
+
+    // ITextLayout
+    void SetText(const std::wstring& text) override { m_text = text; }
+    void SetMaxSize(const Size& size) override { m_maxSize = size; }
+    std::wstring GetText() const override { return m_text; }
+    Size GetMaxSize() const override { return m_maxSize; }
+
+    Size GetLayoutSize() const override;
+    int GetLineCount() const override;
+    float GetLayoutHeight() const override { return GetLayoutSize().height; }
+
+private:
+    SoftwareTextFormat m_format;
+    std::wstring m_text;
+    Size m_maxSize;
+};
+
+} // namespace rendering
+} // namespace luaui
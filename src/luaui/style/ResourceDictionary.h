@@ -2,10 +2,17 @@
 
 #include "../rendering/Types.h"
 #include "Style.h"
+#include "ThemeKey.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+#include <cstdint>
 #include <unordered_map>
 #include <string>
 #include <memory>
 #include <functional>
+#include <vector>
 
 namespace luaui {
 namespace controls {
@@ -14,12 +21,20 @@ class Control;
 
 using ThemeCallback = std::function<void()>;
 
+/**
+ * @brief 主题资源字典
+ *
+ * 颜色、浮点、边距和圆角按 ThemeKey ID 存放在平坦数组中，查找只是下标访问。
+ * 每次修改都会从全局计数器取得新的版本号，控件可以缓存解析结果，
+ * 版本号不变时跳过查找（见 CachedThemeValue）。
+ */
 class ResourceDictionary {
 public:
     using Ptr = std::shared_ptr<ResourceDictionary>;
 
     void AddStyle(const std::string& key, Style::Ptr style) {
         m_styles[key] = style;
+        Touch();
     }
 
     Style::Ptr GetStyle(const std::string& key) const {
@@ -27,65 +42,147 @@ public:
         return (it != m_styles.end()) ? it->second : nullptr;
     }
 
-    void AddColor(const std::string& key, const rendering::Color& color) {
-        m_colors[key] = color;
+    void AddColor(ThemeKey key, const rendering::Color& color) {
+        if (m_colors.Set(key, color)) Touch();
     }
 
-    rendering::Color GetColor(const std::string& key) const {
-        auto it = m_colors.find(key);
-        return (it != m_colors.end()) ? it->second : rendering::Color::Transparent();
+    rendering::Color GetColor(ThemeKey key) const {
+        return m_colors.Get(key, rendering::Color::Transparent());
     }
 
-    bool HasColor(const std::string& key) const {
-        return m_colors.find(key) != m_colors.end();
+    bool HasColor(ThemeKey key) const {
+        return m_colors.Has(key);
     }
 
-    void AddFloat(const std::string& key, float value) {
-        m_floats[key] = value;
+    void AddFloat(ThemeKey key, float value) {
+        if (m_floats.Set(key, value)) Touch();
     }
 
-    float GetFloat(const std::string& key, float fallback = 0.0f) const {
-        auto it = m_floats.find(key);
-        return (it != m_floats.end()) ? it->second : fallback;
+    float GetFloat(ThemeKey key, float fallback = 0.0f) const {
+        return m_floats.Get(key, fallback);
     }
 
-    bool HasFloat(const std::string& key) const {
-        return m_floats.find(key) != m_floats.end();
+    bool HasFloat(ThemeKey key) const {
+        return m_floats.Has(key);
     }
 
-    void AddThickness(const std::string& key, const rendering::Thickness& value) {
-        m_thickness[key] = value;
+    void AddThickness(ThemeKey key, const rendering::Thickness& value) {
+        if (m_thickness.Set(key, value)) Touch();
     }
 
-    rendering::Thickness GetThickness(const std::string& key) const {
-        auto it = m_thickness.find(key);
-        return (it != m_thickness.end()) ? it->second : rendering::Thickness(0);
+    rendering::Thickness GetThickness(ThemeKey key) const {
+        return m_thickness.Get(key, rendering::Thickness(0));
     }
 
-    void AddCornerRadius(const std::string& key, const rendering::CornerRadius& value) {
-        m_corners[key] = value;
+    void AddCornerRadius(ThemeKey key, const rendering::CornerRadius& value) {
+        if (m_corners.Set(key, value)) Touch();
     }
 
-    rendering::CornerRadius GetCornerRadius(const std::string& key) const {
-        auto it = m_corners.find(key);
-        return (it != m_corners.end()) ? it->second : rendering::CornerRadius(0);
+    rendering::CornerRadius GetCornerRadius(ThemeKey key) const {
+        return m_corners.Get(key, rendering::CornerRadius(0));
     }
 
     /** @brief 合并另一个字典（other 覆盖 this） */
     void Merge(const ResourceDictionary& other) {
         for (auto& [k, v] : other.m_styles) m_styles[k] = v;
-        for (auto& [k, v] : other.m_colors) m_colors[k] = v;
-        for (auto& [k, v] : other.m_floats) m_floats[k] = v;
-        for (auto& [k, v] : other.m_thickness) m_thickness[k] = v;
-        for (auto& [k, v] : other.m_corners) m_corners[k] = v;
+        m_colors.Merge(other.m_colors);
+        m_floats.Merge(other.m_floats);
+        m_thickness.Merge(other.m_thickness);
+        m_corners.Merge(other.m_corners);
+        Touch();
     }
 
+    /**
+     * @brief 比较两个字典，将取值不同（含新增、删除）的键 ID 在 changed 中置位
+     * @return 样式表有变化时返回 true（样式无法按键区分影响范围）
+     */
+    static bool CollectChanges(const ResourceDictionary& before, const ResourceDictionary& after,
+                               std::vector<bool>& changed) {
+        before.m_colors.Diff(after.m_colors, changed);
+        before.m_floats.Diff(after.m_floats, changed);
+        before.m_thickness.Diff(after.m_thickness, changed);
+        before.m_corners.Diff(after.m_corners, changed);
+        if (before.m_styles.size() != after.m_styles.size()) return true;
+        for (auto& [k, v] : before.m_styles) {
+            auto it = after.m_styles.find(k);
+            if (it == after.m_styles.end() || it->second != v) return true;
+        }
+        return false;
+    }
+
+    /** @brief 内容版本号（任何修改后改变；复制的字典版本号相同） */
+    uint64_t GetVersion() const { return m_version; }
+
 private:
+    /** @brief 按键 ID 索引的资源数组 */
+    template<typename T>
+    class SlotArray {
+    public:
+        bool Set(ThemeKey key, const T& value) {
+            if (!key.IsValid()) return false;
+            size_t index = key.GetId();
+            if (index >= m_values.size()) {
+                m_values.resize(index + 1);
+                m_present.resize(index + 1, false);
+            }
+            m_values[index] = value;
+            m_present[index] = true;
+            return true;
+        }
+
+        T Get(ThemeKey key, const T& fallback) const {
+            size_t index = key.GetId();
+            return (index < m_present.size() && m_present[index]) ? m_values[index] : fallback;
+        }
+
+        bool Has(ThemeKey key) const {
+            size_t index = key.GetId();
+            return index < m_present.size() && m_present[index];
+        }
+
+        void Merge(const SlotArray& other) {
+            if (other.m_values.size() > m_values.size()) {
+                m_values.resize(other.m_values.size());
+                m_present.resize(other.m_values.size(), false);
+            }
+            for (size_t i = 0; i < other.m_values.size(); ++i) {
+                if (other.m_present[i]) {
+                    m_values[i] = other.m_values[i];
+                    m_present[i] = true;
+                }
+            }
+        }
+
+        void Diff(const SlotArray& other, std::vector<bool>& changed) const {
+            static_assert(std::is_trivially_copyable<T>::value, "slot values are compared bytewise");
+            size_t count = (std::max)(m_values.size(), other.m_values.size());
+            if (changed.size() < count) changed.resize(count, false);
+            for (size_t i = 0; i < count; ++i) {
+                bool mine = i < m_present.size() && m_present[i];
+                bool theirs = i < other.m_present.size() && other.m_present[i];
+                if (mine != theirs ||
+                    (mine && std::memcmp(&m_values[i], &other.m_values[i], sizeof(T)) != 0)) {
+                    changed[i] = true;
+                }
+            }
+        }
+
+    private:
+        std::vector<T> m_values;
+        std::vector<bool> m_present;
+    };
+
+    void Touch() {
+        static std::atomic<uint64_t> s_nextVersion{1};
+        m_version = s_nextVersion.fetch_add(1, std::memory_order_relaxed);
+    }
+
     std::unordered_map<std::string, Style::Ptr> m_styles;
-    std::unordered_map<std::string, rendering::Color> m_colors;
-    std::unordered_map<std::string, float> m_floats;
-    std::unordered_map<std::string, rendering::Thickness> m_thickness;
-    std::unordered_map<std::string, rendering::CornerRadius> m_corners;
+    SlotArray<rendering::Color> m_colors;
+    SlotArray<float> m_floats;
+    SlotArray<rendering::Thickness> m_thickness;
+    SlotArray<rendering::CornerRadius> m_corners;
+    uint64_t m_version = 0;
 };
 
 struct ResourceReference {
@@ -1,10 +1,13 @@
 #include "Theme.h"
 #include "ThemeKeys.h"
 #include "ThemeLoader.h"
+#include <algorithm>
 
 namespace luaui {
 namespace controls {
 
+thread_local Theme::Recording Theme::s_recording;
+
 Theme& Theme::GetCurrent() {
     static Theme instance;
     static bool initialized = false;
@@ -42,5 +45,110 @@ void Theme::ApplyThemeFromFile(const std::string& filePath) {
     ReplaceResources(dict);
 }
 
+// ============================================================================
+// 订阅与依赖
+// ============================================================================
+
+size_t Theme::AddCallback(ThemeCallback cb) {
+    size_t id = m_nextCbId++;
+    m_cbs[id].callback = std::move(cb);
+    return id;
+}
+
+size_t Theme::AddTrackedCallback(ThemeCallback cb) {
+    size_t id = m_nextCbId++;
+    auto& sub = m_cbs[id];
+    sub.callback = std::move(cb);
+    sub.tracked = true;
+    return id;
+}
+
+void Theme::RemoveCallback(size_t id) {
+    m_cbs.erase(id);
+}
+
+size_t Theme::GetDependencyCount(size_t id) const {
+    auto it = m_cbs.find(id);
+    return (it != m_cbs.end() && it->second.tracked) ? it->second.dependencies.size() : 0;
+}
+
+void Theme::RecordDependency(ThemeKey::Id id) const {
+    auto it = m_cbs.find(s_recording.id);
+    if (it == m_cbs.end() || !it->second.tracked) return;
+
+    // 依赖只增不减：读取集合随控件状态变化，保留并集保证不漏通知
+    auto& deps = it->second.dependencies;
+    auto pos = std::lower_bound(deps.begin(), deps.end(), id);
+    if (pos == deps.end() || *pos != id) {
+        deps.insert(pos, id);
+    }
+}
+
+// ============================================================================
+// 资源变更
+// ============================================================================
+
+void Theme::ApplyResources(const ResourceDictionary& newRes) {
+    ResourceDictionary merged = m_res;
+    merged.Merge(newRes);
+    SetResources(std::move(merged));
+}
+
+void Theme::ReplaceResources(const ResourceDictionary& newRes) {
+    SetResources(ResourceDictionary(newRes));
+}
+
+void Theme::SetResources(ResourceDictionary&& next) {
+    if (ResourceDictionary::CollectChanges(m_res, next, m_changedKeys)) {
+        m_allChanged = true;
+    }
+    m_hasChanges = true;
+    m_res = std::move(next);
+    if (m_updateDepth == 0) {
+        NotifyChanges();
+    }
+}
+
+void Theme::EndUpdate() {
+    if (m_updateDepth > 0 && --m_updateDepth == 0 && m_hasChanges) {
+        NotifyChanges();
+    }
+}
+
+void Theme::NotifyChanges() {
+    std::vector<bool> changed;
+    changed.swap(m_changedKeys);
+    bool all = m_allChanged;
+    m_hasChanges = false;
+    m_allChanged = false;
+
+    // 先确定通知对象：回调中可能创建或销毁控件（增删订阅）
+    std::vector<size_t> targets;
+    targets.reserve(m_cbs.size());
+    for (auto& [id, sub] : m_cbs) {
+        bool affected = all || !sub.tracked;
+        for (size_t i = 0; !affected && i < sub.dependencies.size(); ++i) {
+            ThemeKey::Id key = sub.dependencies[i];
+            affected = key < changed.size() && changed[key];
+        }
+        if (affected) targets.push_back(id);
+    }
+
+    m_lastNotifyCount = 0;
+    for (size_t id : targets) {
+        auto it = m_cbs.find(id);
+        if (it == m_cbs.end() || !it->second.callback) continue;
+        // 复制回调：回调可能注销自身
+        ThemeCallback callback = it->second.callback;
+        if (it->second.tracked) {
+            DependencyScope scope(*this, id);
+            callback();
+        } else {
+            callback();
+        }
+        ++m_lastNotifyCount;
+    }
+}
+
 } // namespace controls
 } // namespace luaui
@@ -12,50 +12,103 @@ class Control;
 
 using ThemeCallback = std::function<void()>;
 
+/**
+ * @brief 主题
+ *
+ * 控件通过 AddTrackedCallback 订阅主题变更：回调执行期间（以及 DependencyScope 范围内）
+ * 经 GetColor/GetFloat 读取的键记录为该订阅的依赖。资源变化时只通知依赖了
+ * 变化键的订阅；AddCallback 注册的订阅不跟踪依赖，每次变化都会收到通知。
+ *
+ * BeginUpdate/EndUpdate（或 UpdateScope）之间的多次资源修改合并为一次通知；
+ * 回调只标记失效，实际的布局和绘制由窗口的帧调度合并到下一帧完成。
+ */
 class Theme {
 public:
     using Ptr = std::shared_ptr<Theme>;
 
-    /** @brief 获取资源字典 */
+    /** @brief 获取资源字典（直接修改不会通知订阅者，也不记录依赖） */
     ResourceDictionary& GetResources() { return m_res; }
     const ResourceDictionary& GetResources() const { return m_res; }
 
-    /** @brief 便捷方法：获取主题颜色 */
-    rendering::Color GetColor(const std::string& key) const {
+    /** @brief 便捷方法：获取主题颜色（ThemeKeys.h 常量为数组访问，字符串需先查注册表） */
+    rendering::Color GetColor(ThemeKey key) const {
+        RecordRead(key);
         return m_res.GetColor(key);
     }
 
     /** @brief 便捷方法：获取主题浮点值 */
-    float GetFloat(const std::string& key, float fb = 0.0f) const {
+    float GetFloat(ThemeKey key, float fb = 0.0f) const {
+        RecordRead(key);
         return m_res.GetFloat(key, fb);
     }
 
-    /** @brief 注册 Theme 变更回调（控件在析构前必须注销） */
-    size_t AddCallback(ThemeCallback cb) {
-        size_t id = m_nextCbId++;
-        m_cbs[id] = std::move(cb);
-        return id;
-    }
-
-    void RemoveCallback(size_t id) {
-        m_cbs.erase(id);
-    }
-
-    /** @brief 合并主题资源并通知所有控件（Merge：other 覆盖 this 中同名键） */
-    void ApplyResources(const ResourceDictionary& newRes) {
-        m_res.Merge(newRes);
-        for (auto& [id, cb] : m_cbs) {
-            if (cb) cb();
+    /** @brief 资源版本号（主题切换或资源修改后改变，用于缓存解析结果） */
+    uint64_t GetVersion() const { return m_res.GetVersion(); }
+
+    /** @brief 注册 Theme 变更回调，任何资源变化都会通知（窗口等全局订阅者使用） */
+    size_t AddCallback(ThemeCallback cb);
+
+    /**
+     * @brief 注册按依赖通知的回调（控件在析构前必须注销）
+     *
+     * 注册后应在 DependencyScope 内读取一次资源以建立初始依赖。
+     */
+    size_t AddTrackedCallback(ThemeCallback cb);
+
+    void RemoveCallback(size_t id);
+
+    /** @brief 合并主题资源并通知受影响的控件（Merge：other 覆盖 this 中同名键） */
+    void ApplyResources(const ResourceDictionary& newRes);
+
+    /** @brief 替换主题资源并通知受影响的控件（Replace：完全替换为 newRes） */
+    void ReplaceResources(const ResourceDictionary& newRes);
+
+    /** @brief 开始批量修改：EndUpdate 之前的资源变化只在最外层 EndUpdate 时通知一次 */
+    void BeginUpdate() { ++m_updateDepth; }
+    void EndUpdate();
+
+    /**
+     * @brief 批量修改范围
+     */
+    class UpdateScope {
+    public:
+        explicit UpdateScope(Theme& theme) : m_theme(theme) { m_theme.BeginUpdate(); }
+        ~UpdateScope() { m_theme.EndUpdate(); }
+        UpdateScope(const UpdateScope&) = delete;
+        UpdateScope& operator=(const UpdateScope&) = delete;
+    private:
+        Theme& m_theme;
+    };
+
+    /**
+     * @brief 依赖记录范围：范围内读取的键追加到指定订阅的依赖（可嵌套）
+     *
+     * 控件在绘制时使用，使 OnRender 中直接读取的主题资源同样被跟踪。
+     * 记录状态按线程保存：并行测量的其他线程读取主题时不会记到本范围的订阅上。
+     */
+    class DependencyScope {
+    public:
+        DependencyScope(const Theme& theme, size_t subscriptionId)
+            : m_previousTheme(s_recording.theme), m_previousId(s_recording.id) {
+            s_recording.theme = &theme;
+            s_recording.id = subscriptionId;
         }
-    }
-
-    /** @brief 替换主题资源并通知所有控件（Replace：完全替换为 newRes） */
-    void ReplaceResources(const ResourceDictionary& newRes) {
-        m_res = newRes;
-        for (auto& [id, cb] : m_cbs) {
-            if (cb) cb();
+        ~DependencyScope() {
+            s_recording.theme = m_previousTheme;
+            s_recording.id = m_previousId;
         }
-    }
+        DependencyScope(const DependencyScope&) = delete;
+        DependencyScope& operator=(const DependencyScope&) = delete;
+    private:
+        const Theme* m_previousTheme;
+        size_t m_previousId;
+    };
+
+    /** @brief 订阅当前的依赖键数量（未跟踪或不存在时返回 0） */
+    size_t GetDependencyCount(size_t id) const;
+
+    /** @brief 最近一次变更通知的回调数量 */
+    size_t GetLastNotifyCount() const { return m_lastNotifyCount; }
 
     /** @brief 按名称应用内置主题 ("Light"/"Dark")，优先从 XML 文件加载 */
     void ApplyThemeByName(const std::string& name);
@@ -70,11 +123,68 @@ public:
     static Theme& GetCurrent();
 
 private:
+    struct Subscription {
+        ThemeCallback callback;
+        bool tracked = false;
+        std::vector<ThemeKey::Id> dependencies;   // 有序、去重
+    };
+
+    // 当前线程正在记录依赖的主题和订阅 ID（0 表示不记录）
+    struct Recording {
+        const Theme* theme = nullptr;
+        size_t id = 0;
+    };
+    static thread_local Recording s_recording;
+
+    void RecordRead(ThemeKey key) const {
+        if (s_recording.theme == this && s_recording.id != 0 && key.IsValid()) RecordDependency(key.GetId());
+    }
+    void RecordDependency(ThemeKey::Id id) const;
+    void SetResources(ResourceDictionary&& next);
+    void NotifyChanges();
+
     ResourceDictionary m_res;
-    std::unordered_map<size_t, ThemeCallback> m_cbs;
+    mutable std::unordered_map<size_t, Subscription> m_cbs;
     size_t m_nextCbId = 1;
+
+    // 尚未通知的变化
+    int m_updateDepth = 0;
+    std::vector<bool> m_changedKeys;       // 按键 ID 索引
+    bool m_hasChanges = false;
+    bool m_allChanged = false;             // 样式等无法按键比较的变化
+    size_t m_lastNotifyCount = 0;
+
     std::string m_currentThemeName = "Light";
 };
 
+/**
+ * @brief 缓存的主题资源值
+ *
+ * 记录解析时的主题版本号，版本不变时直接返回缓存值；用于每帧都要读取的资源。
+ */
+template<typename T, T (Theme::*Getter)(ThemeKey) const>
+class CachedThemeValue {
+public:
+    explicit CachedThemeValue(ThemeKey key) : m_key(key) {}
+
+    const T& Get(const Theme& theme) {
+        uint64_t version = theme.GetVersion();
+        if (!m_resolved || version != m_version) {
+            m_value = (theme.*Getter)(m_key);
+            m_version = version;
+            m_resolved = true;
+        }
+        return m_value;
+    }
+
+private:
+    ThemeKey m_key;
+    uint64_t m_version = 0;
+    bool m_resolved = false;
+    T m_value{};
+};
+
+using CachedThemeColor = CachedThemeValue<rendering::Color, &Theme::GetColor>;
+
 } // namespace controls
 } // namespace luaui
@@ -0,0 +1,70 @@
+#include "ThemeKey.h"
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace luaui {
+namespace controls {
+
+namespace {
+
+// 键名注册表（函数内静态对象，避免与 ThemeKeys.h 常量的静态初始化顺序问题）
+struct KeyRegistry {
+    std::mutex mutex;
+    std::unordered_map<std::string, ThemeKey::Id> ids;
+    std::deque<std::string> names;   // names[id - 1]；deque 保证返回的引用不失效
+
+    static KeyRegistry& Get() {
+        static KeyRegistry s_registry;
+        return s_registry;
+    }
+};
+
+} // anonymous namespace
+
+ThemeKey::ThemeKey(const char* name)
+    : m_id(name ? Intern(name) : kInvalidId) {}
+
+ThemeKey::ThemeKey(const std::string& name)
+    : m_id(Intern(name)) {}
+
+ThemeKey::Id ThemeKey::Intern(const std::string& name) {
+    if (name.empty()) return kInvalidId;
+
+    auto& registry = KeyRegistry::Get();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.ids.find(name);
+    if (it != registry.ids.end()) return it->second;
+
+    registry.names.push_back(name);
+    Id id = static_cast<Id>(registry.names.size());
+    registry.ids.emplace(name, id);
+    return id;
+}
+
+ThemeKey ThemeKey::Find(const std::string& name) {
+    auto& registry = KeyRegistry::Get();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    ThemeKey key;
+    auto it = registry.ids.find(name);
+    if (it != registry.ids.end()) key.m_id = it->second;
+    return key;
+}
+
+size_t ThemeKey::GetRegisteredCount() {
+    auto& registry = KeyRegistry::Get();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.names.size();
+}
+
+const std::string& ThemeKey::GetName() const {
+    static const std::string s_empty;
+    if (m_id == kInvalidId) return s_empty;
+
+    auto& registry = KeyRegistry::Get();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return m_id <= registry.names.size() ? registry.names[m_id - 1] : s_empty;
+}
+
+} // namespace controls
+} // namespace luaui
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace luaui {
+namespace controls {
+
+/**
+ * @brief 驻留的主题资源键
+ *
+ * 键名在首次构造时注册到进程级表中，得到从 1 开始连续分配的整数 ID；
+ * ResourceDictionary 以 ID 为下标存取资源，查找时不再哈希字符串。
+ * ThemeKeys.h 中的常量在静态初始化时完成注册，控件使用这些常量时只是数组访问。
+ *
+ * 可从字符串隐式构造（每次构造都要查注册表），便于 XML/Lua 按名称访问。
+ * ID 0 表示无效键（默认构造，或静态初始化完成前被零初始化的常量）。
+ */
+class ThemeKey {
+public:
+    using Id = uint32_t;
+    static constexpr Id kInvalidId = 0;
+
+    constexpr ThemeKey() = default;
+    ThemeKey(const char* name);
+    ThemeKey(const std::string& name);
+
+    /**
+     * @brief 查找已注册的键，不存在时返回无效键（不注册）
+     */
+    static ThemeKey Find(const std::string& name);
+
+    /**
+     * @brief 已注册键的数量（最大 ID）
+     */
+    static size_t GetRegisteredCount();
+
+    Id GetId() const { return m_id; }
+    bool IsValid() const { return m_id != kInvalidId; }
+    const std::string& GetName() const;
+
+    bool operator==(const ThemeKey& other) const { return m_id == other.m_id; }
+    bool operator!=(const ThemeKey& other) const { return m_id != other.m_id; }
+
+private:
+    static Id Intern(const std::string& name);
+
+    Id m_id = kInvalidId;
+};
+
+} // namespace controls
+} // namespace luaui
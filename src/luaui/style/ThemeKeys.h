@@ -1,157 +1,162 @@
 #pragma once
 
+#include "ThemeKey.h"
+
 namespace luaui {
 namespace theme {
 
+// 主题资源键在静态初始化时注册为连续 ID，控件查找主题资源时只做数组访问
+using controls::ThemeKey;
+
 // ============================================================================
 // 全局通用
 // ============================================================================
-inline constexpr const char* kAccentColor       = "AccentColor";
-inline constexpr const char* kBackgroundPrimary  = "BackgroundPrimary";
-inline constexpr const char* kBackgroundSecondary= "BackgroundSecondary";
-inline constexpr const char* kTextPrimary        = "TextPrimary";
-inline constexpr const char* kTextSecondary      = "TextSecondary";
-inline constexpr const char* kTextDisabled       = "TextDisabled";
-inline constexpr const char* kBorderNormal       = "BorderNormal";
-inline constexpr const char* kBorderFocused      = "BorderFocused";
-inline constexpr const char* kFocusVisual        = "FocusVisual";
+inline const ThemeKey kAccentColor       = "AccentColor";
+inline const ThemeKey kBackgroundPrimary  = "BackgroundPrimary";
+inline const ThemeKey kBackgroundSecondary= "BackgroundSecondary";
+inline const ThemeKey kTextPrimary        = "TextPrimary";
+inline const ThemeKey kTextSecondary      = "TextSecondary";
+inline const ThemeKey kTextDisabled       = "TextDisabled";
+inline const ThemeKey kBorderNormal       = "BorderNormal";
+inline const ThemeKey kBorderFocused      = "BorderFocused";
+inline const ThemeKey kFocusVisual        = "FocusVisual";
 
 // ============================================================================
 // Button
 // ============================================================================
-inline constexpr const char* kButtonNormalBg     = "ButtonNormalBg";
-inline constexpr const char* kButtonHoverBg      = "ButtonHoverBg";
-inline constexpr const char* kButtonPressedBg    = "ButtonPressedBg";
-inline constexpr const char* kButtonDisabledBg   = "ButtonDisabledBg";
-inline constexpr const char* kButtonDisabledFg   = "ButtonDisabledFg";
-inline constexpr const char* kButtonDisabledBorder= "ButtonDisabledBorder";
-inline constexpr const char* kButtonBorder       = "ButtonBorder";
-inline constexpr const char* kButtonForeground   = "ButtonForeground";
-inline constexpr const char* kButtonNormalBorder = "ButtonNormalBorder";
-inline constexpr const char* kButtonHoverBorder  = "ButtonHoverBorder";
-inline constexpr const char* kButtonPressedBorder= "ButtonPressedBorder";
+inline const ThemeKey kButtonNormalBg     = "ButtonNormalBg";
+inline const ThemeKey kButtonHoverBg      = "ButtonHoverBg";
+inline const ThemeKey kButtonPressedBg    = "ButtonPressedBg";
+inline const ThemeKey kButtonDisabledBg   = "ButtonDisabledBg";
+inline const ThemeKey kButtonDisabledFg   = "ButtonDisabledFg";
+inline const ThemeKey kButtonDisabledBorder= "ButtonDisabledBorder";
+inline const ThemeKey kButtonBorder       = "ButtonBorder";
+inline const ThemeKey kButtonForeground   = "ButtonForeground";
+inline const ThemeKey kButtonNormalBorder = "ButtonNormalBorder";
+inline const ThemeKey kButtonHoverBorder  = "ButtonHoverBorder";
+inline const ThemeKey kButtonPressedBorder= "ButtonPressedBorder";
 
 // ============================================================================
 // CheckBox / RadioButton
 // ============================================================================
-inline constexpr const char* kCheckNormalBorder  = "CheckNormalBorder";
-inline constexpr const char* kCheckHoverBorder   = "CheckHoverBorder";
-inline constexpr const char* kCheckPressedBorder = "CheckPressedBorder";
-inline constexpr const char* kCheckMark          = "CheckMark";
-inline constexpr const char* kCheckBackground    = "CheckBackground";
-inline constexpr const char* kCheckDisabledBorder= "CheckDisabledBorder";
-inline constexpr const char* kCheckDisabledMark  = "CheckDisabledMark";
-inline constexpr const char* kCheckDisabledText  = "CheckDisabledText";
+inline const ThemeKey kCheckNormalBorder  = "CheckNormalBorder";
+inline const ThemeKey kCheckHoverBorder   = "CheckHoverBorder";
+inline const ThemeKey kCheckPressedBorder = "CheckPressedBorder";
+inline const ThemeKey kCheckMark          = "CheckMark";
+inline const ThemeKey kCheckBackground    = "CheckBackground";
+inline const ThemeKey kCheckDisabledBorder= "CheckDisabledBorder";
+inline const ThemeKey kCheckDisabledMark  = "CheckDisabledMark";
+inline const ThemeKey kCheckDisabledText  = "CheckDisabledText";
 
 // ============================================================================
 // Slider
 // ============================================================================
-inline constexpr const char* kSliderTrack        = "SliderTrack";
-inline constexpr const char* kSliderProgress     = "SliderProgress";
-inline constexpr const char* kSliderThumbBg      = "SliderThumbBg";
-inline constexpr const char* kSliderThumbBorder  = "SliderThumbBorder";
-inline constexpr const char* kSliderThumb        = "SliderThumb";
+inline const ThemeKey kSliderTrack        = "SliderTrack";
+inline const ThemeKey kSliderProgress     = "SliderProgress";
+inline const ThemeKey kSliderThumbBg      = "SliderThumbBg";
+inline const ThemeKey kSliderThumbBorder  = "SliderThumbBorder";
+inline const ThemeKey kSliderThumb        = "SliderThumb";
 
 // ============================================================================
 // TextBox
 // ============================================================================
-inline constexpr const char* kTextBoxBackground  = "TextBoxBackground";
-inline constexpr const char* kTextBoxBorder      = "TextBoxBorder";
-inline constexpr const char* kTextBoxFocusedBorder= "TextBoxFocusedBorder";
-inline constexpr const char* kTextBoxSelection   = "TextBoxSelection";
-inline constexpr const char* kTextBoxInactiveSel = "TextBoxInactiveSelection";
-inline constexpr const char* kTextBoxPlaceholder = "TextBoxPlaceholder";
-inline constexpr const char* kTextBoxReadOnlyBg  = "TextBoxReadOnlyBg";
+inline const ThemeKey kTextBoxBackground  = "TextBoxBackground";
+inline const ThemeKey kTextBoxBorder      = "TextBoxBorder";
+inline const ThemeKey kTextBoxFocusedBorder= "TextBoxFocusedBorder";
+inline const ThemeKey kTextBoxSelection   = "TextBoxSelection";
+inline const ThemeKey kTextBoxInactiveSel = "TextBoxInactiveSelection";
+inline const ThemeKey kTextBoxPlaceholder = "TextBoxPlaceholder";
+inline const ThemeKey kTextBoxReadOnlyBg  = "TextBoxReadOnlyBg";
 
 // ============================================================================
 // ProgressBar
 // ============================================================================
-inline constexpr const char* kProgressBackground = "ProgressBackground";
-inline constexpr const char* kProgressForeground = "ProgressForeground";
-inline constexpr const char* kProgressBorder     = "ProgressBorder";
+inline const ThemeKey kProgressBackground = "ProgressBackground";
+inline const ThemeKey kProgressForeground = "ProgressForeground";
+inline const ThemeKey kProgressBorder     = "ProgressBorder";
 
 // ============================================================================
 // TabControl
 // ============================================================================
-inline constexpr const char* kTabStripBg         = "TabStripBg";
-inline constexpr const char* kTabSelectedBg      = "TabSelectedBg";
-inline constexpr const char* kTabHoverBg         = "TabHoverBg";
-inline constexpr const char* kTabBorder          = "TabBorder";
-inline constexpr const char* kTabContentBg       = "TabContentBg";
-inline constexpr const char* kTabItemText        = "TabItemText";
-inline constexpr const char* kTabItemSelectedText= "TabItemSelectedText";
-inline constexpr const char* kTabItemCloseBtn    = "TabItemCloseBtn";
-inline constexpr const char* kTabItemCloseBtnHover = "TabItemCloseBtnHover";
+inline const ThemeKey kTabStripBg         = "TabStripBg";
+inline const ThemeKey kTabSelectedBg      = "TabSelectedBg";
+inline const ThemeKey kTabHoverBg         = "TabHoverBg";
+inline const ThemeKey kTabBorder          = "TabBorder";
+inline const ThemeKey kTabContentBg       = "TabContentBg";
+inline const ThemeKey kTabItemText        = "TabItemText";
+inline const ThemeKey kTabItemSelectedText= "TabItemSelectedText";
+inline const ThemeKey kTabItemCloseBtn    = "TabItemCloseBtn";
+inline const ThemeKey kTabItemCloseBtnHover = "TabItemCloseBtnHover";
 
 // ============================================================================
 // ScrollBar / ScrollViewer
 // ============================================================================
-inline constexpr const char* kScrollBarTrack     = "ScrollBarTrack";
-inline constexpr const char* kScrollBarThumb     = "ScrollBarThumb";
-inline constexpr const char* kScrollBarThumbHover= "ScrollBarThumbHover";
+inline const ThemeKey kScrollBarTrack     = "ScrollBarTrack";
+inline const ThemeKey kScrollBarThumb     = "ScrollBarThumb";
+inline const ThemeKey kScrollBarThumbHover= "ScrollBarThumbHover";
 
 // ============================================================================
 // Menu / MenuBar / MenuItem
 // ============================================================================
-inline constexpr const char* kMenuBarBg          = "MenuBarBg";
-inline constexpr const char* kMenuBarHoverBg     = "MenuBarHoverBg";
-inline constexpr const char* kMenuBarOpenBg      = "MenuBarOpenBg";
-inline constexpr const char* kMenuBarText        = "MenuBarText";
-inline constexpr const char* kMenuBg             = "MenuBg";
-inline constexpr const char* kMenuBorder         = "MenuBorder";
-inline constexpr const char* kMenuItemHoverBg    = "MenuItemHoverBg";
-inline constexpr const char* kMenuItemText       = "MenuItemText";
-inline constexpr const char* kMenuItemDisabledText= "MenuItemDisabledText";
-inline constexpr const char* kMenuItemSeparator  = "MenuItemSeparator";
-inline constexpr const char* kMenuItemCheckMark  = "MenuItemCheckMark";
-inline constexpr const char* kMenuItemArrow      = "MenuItemArrow";
+inline const ThemeKey kMenuBarBg          = "MenuBarBg";
+inline const ThemeKey kMenuBarHoverBg     = "MenuBarHoverBg";
+inline const ThemeKey kMenuBarOpenBg      = "MenuBarOpenBg";
+inline const ThemeKey kMenuBarText        = "MenuBarText";
+inline const ThemeKey kMenuBg             = "MenuBg";
+inline const ThemeKey kMenuBorder         = "MenuBorder";
+inline const ThemeKey kMenuItemHoverBg    = "MenuItemHoverBg";
+inline const ThemeKey kMenuItemText       = "MenuItemText";
+inline const ThemeKey kMenuItemDisabledText= "MenuItemDisabledText";
+inline const ThemeKey kMenuItemSeparator  = "MenuItemSeparator";
+inline const ThemeKey kMenuItemCheckMark  = "MenuItemCheckMark";
+inline const ThemeKey kMenuItemArrow      = "MenuItemArrow";
 
 // ============================================================================
 // Toolbar / ToolbarItem
 // ============================================================================
-inline constexpr const char* kToolbarBg          = "ToolbarBg";
-inline constexpr const char* kToolbarBorder      = "ToolbarBorder";
-inline constexpr const char* kToolbarItemHoverBg = "ToolbarItemHoverBg";
-inline constexpr const char* kToolbarItemPressedBg = "ToolbarItemPressedBg";
-inline constexpr const char* kToolbarItemCheckedBg = "ToolbarItemCheckedBg";
-inline constexpr const char* kToolbarItemText    = "ToolbarItemText";
-inline constexpr const char* kToolbarItemDisabledText = "ToolbarItemDisabledText";
-inline constexpr const char* kToolbarSeparatorLine= "ToolbarSeparatorLine";
+inline const ThemeKey kToolbarBg          = "ToolbarBg";
+inline const ThemeKey kToolbarBorder      = "ToolbarBorder";
+inline const ThemeKey kToolbarItemHoverBg = "ToolbarItemHoverBg";
+inline const ThemeKey kToolbarItemPressedBg = "ToolbarItemPressedBg";
+inline const ThemeKey kToolbarItemCheckedBg = "ToolbarItemCheckedBg";
+inline const ThemeKey kToolbarItemText    = "ToolbarItemText";
+inline const ThemeKey kToolbarItemDisabledText = "ToolbarItemDisabledText";
+inline const ThemeKey kToolbarSeparatorLine= "ToolbarSeparatorLine";
 
 // ============================================================================
 // StatusBar
 // ============================================================================
-inline constexpr const char* kStatusBarBg        = "StatusBarBg";
-inline constexpr const char* kStatusBarBorder    = "StatusBarBorder";
-inline constexpr const char* kStatusBarGrip      = "StatusBarGrip";
-inline constexpr const char* kStatusBarItemText  = "StatusBarItemText";
+inline const ThemeKey kStatusBarBg        = "StatusBarBg";
+inline const ThemeKey kStatusBarBorder    = "StatusBarBorder";
+inline const ThemeKey kStatusBarGrip      = "StatusBarGrip";
+inline const ThemeKey kStatusBarItemText  = "StatusBarItemText";
 
 // ============================================================================
 // TreeView
 // ============================================================================
-inline constexpr const char* kTreeViewItemHoverBg    = "TreeViewItemHoverBg";
-inline constexpr const char* kTreeViewItemSelectedBg = "TreeViewItemSelectedBg";
-inline constexpr const char* kTreeViewItemText       = "TreeViewItemText";
-inline constexpr const char* kTreeViewItemSelectedText= "TreeViewItemSelectedText";
-inline constexpr const char* kTreeViewExpandBtn      = "TreeViewExpandBtn";
+inline const ThemeKey kTreeViewItemHoverBg    = "TreeViewItemHoverBg";
+inline const ThemeKey kTreeViewItemSelectedBg = "TreeViewItemSelectedBg";
+inline const ThemeKey kTreeViewItemText       = "TreeViewItemText";
+inline const ThemeKey kTreeViewItemSelectedText= "TreeViewItemSelectedText";
+inline const ThemeKey kTreeViewExpandBtn      = "TreeViewExpandBtn";
 
 // ============================================================================
 // SideBar
 // ============================================================================
-inline constexpr const char* kSideBarBg           = "SideBarBg";
-inline constexpr const char* kSideBarBorder       = "SideBarBorder";
-inline constexpr const char* kSideBarHeaderBg     = "SideBarHeaderBg";
-inline constexpr const char* kSideBarHeaderText   = "SideBarHeaderText";
-inline constexpr const char* kSideBarCollapseBtn  = "SideBarCollapseBtn";
-inline constexpr const char* kSideBarCollapseBtnHover = "SideBarCollapseBtnHover";
+inline const ThemeKey kSideBarBg           = "SideBarBg";
+inline const ThemeKey kSideBarBorder       = "SideBarBorder";
+inline const ThemeKey kSideBarHeaderBg     = "SideBarHeaderBg";
+inline const ThemeKey kSideBarHeaderText   = "SideBarHeaderText";
+inline const ThemeKey kSideBarCollapseBtn  = "SideBarCollapseBtn";
+inline const ThemeKey kSideBarCollapseBtnHover = "SideBarCollapseBtnHover";
 
 // ============================================================================
 // Splitter
 // ============================================================================
-inline constexpr const char* kSplitterBg          = "SplitterBg";
-inline constexpr const char* kSplitterHoverBg     = "SplitterHoverBg";
-inline constexpr const char* kSplitterActiveBg    = "SplitterActiveBg";
-inline constexpr const char* kSplitterGrip        = "SplitterGrip";
+inline const ThemeKey kSplitterBg          = "SplitterBg";
+inline const ThemeKey kSplitterHoverBg     = "SplitterHoverBg";
+inline const ThemeKey kSplitterActiveBg    = "SplitterActiveBg";
+inline const ThemeKey kSplitterGrip        = "SplitterGrip";
 
 } // namespace theme
 } // namespace luaui
@@ -3,7 +3,11 @@
 #include "Logger.h"
 #include "tinyxml2.h"
 #include <sstream>
+#ifdef _WIN32
 #include <windows.h>
+#else
+#include <unistd.h>
+#endif
 
 namespace luaui {
 namespace controls {
@@ -148,6 +152,7 @@ ResourceDictionary ThemeLoader::LoadFromString(const std::string& xmlContent) {
 
 std::string ThemeLoader::GetDefaultThemesDir() {
     // 获取可执行文件所在目录，拼接 themes/
+#ifdef _WIN32
     char path[MAX_PATH] = {0};
     GetModuleFileNameA(nullptr, path, MAX_PATH);
     std::string exePath(path);
@@ -156,6 +161,16 @@ std::string ThemeLoader::GetDefaultThemesDir() {
         return exePath.substr(0, pos + 1) + "themes\\";
     }
     return "themes\\";
+#else
+    char path[4096] = {0};
+    ssize_t len = readlink("/proc/self/exe", path, sizeof(path) - 1);
+    std::string exePath(path, len > 0 ? static_cast<size_t>(len) : 0);
+    auto pos = exePath.find_last_of('/');
+    if (pos != std::string::npos) {
+        return exePath.substr(0, pos + 1) + "themes/";
+    }
+    return "themes/";
+#endif
 }
 
 ResourceDictionary ThemeLoader::LoadBuiltinTheme(const std::string& name) {
@@ -1,5 +1,6 @@
 #include "StringUtils.h"
 #include <sstream>
+#include <cstdint>
 
 namespace luaui {
 namespace utils {
@@ -9,6 +10,7 @@ std::wstring StringUtils::Utf8ToWString(const char* utf8Str) {
         return std::wstring();
     }
     
+#ifdef _WIN32
     int len = MultiByteToWideChar(CP_UTF8, 0, utf8Str, -1, nullptr, 0);
     if (len <= 0) {
         return std::wstring();
@@ -17,6 +19,52 @@ std::wstring StringUtils::Utf8ToWString(const char* utf8Str) {
     std::wstring result(len - 1, 0);
     MultiByteToWideChar(CP_UTF8, 0, utf8Str, -1, &result[0], len);
     return result;
+#else
+    // wchar_t 为 UTF-32：逐个解码码点。与 MultiByteToWideChar 一致，非法序列（孤立的续字节、
+    // C0/C1/F5-FF 前导字节、过长编码、代理区、超过 U+10FFFF）的最大非法前缀替换为一个 U+FFFD
+    std::wstring result;
+    const auto* p = reinterpret_cast<const unsigned char*>(utf8Str);
+    while (*p) {
+        uint32_t cp = *p++;
+        if (cp < 0x80) {
+            result.push_back(static_cast<wchar_t>(cp));
+            continue;
+        }
+        
+        // 第二个字节的合法范围随前导字节收窄，排除过长编码、代理区和超范围码点
+        int extra = 0;
+        unsigned char lo = 0x80, hi = 0xBF;
+        if (cp >= 0xC2 && cp <= 0xDF) {
+            extra = 1;
+            cp &= 0x1F;
+        } else if (cp >= 0xE0 && cp <= 0xEF) {
+            extra = 2;
+            if (cp == 0xE0) lo = 0xA0;
+            if (cp == 0xED) hi = 0x9F;
+            cp &= 0x0F;
+        } else if (cp >= 0xF0 && cp <= 0xF4) {
+            extra = 3;
+            if (cp == 0xF0) lo = 0x90;
+            if (cp == 0xF4) hi = 0x8F;
+            cp &= 0x07;
+        } else {
+            result.push_back(0xFFFD);
+            continue;
+        }
+        
+        for (int i = 0; i < extra; ++i) {
+            if (*p < lo || *p > hi) {
+                cp = 0xFFFD;   // 不消耗该字节，从它开始重新解码
+                break;
+            }
+            cp = (cp << 6) | (*p++ & 0x3F);
+            lo = 0x80;
+            hi = 0xBF;
+        }
+        result.push_back(static_cast<wchar_t>(cp));
+    }
+    return result;
+#endif
 }
 
 std::wstring StringUtils::Utf8ToWString(const std::string& utf8Str) {
@@ -28,6 +76,7 @@ std::string StringUtils::WStringToUtf8(const wchar_t* wstr) {
         return std::string();
     }
     
+#ifdef _WIN32
     int len = WideCharToMultiByte(CP_UTF8, 0, wstr, -1, nullptr, 0, nullptr, nullptr);
     if (len <= 0) {
         return std::string();
@@ -36,6 +85,32 @@ std::string StringUtils::WStringToUtf8(const wchar_t* wstr) {
     std::string result(len - 1, 0);
     WideCharToMultiByte(CP_UTF8, 0, wstr, -1, &result[0], len, nullptr, nullptr);
     return result;
+#else
+    std::string result;
+    for (; *wstr; ++wstr) {
+        uint32_t cp = static_cast<uint32_t>(*wstr);
+        // 代理区和超过 U+10FFFF 的值不是合法码点，与 WideCharToMultiByte 一样替换为 U+FFFD
+        if ((cp >= 0xD800 && cp <= 0xDFFF) || cp > 0x10FFFF) {
+            cp = 0xFFFD;
+        }
+        if (cp < 0x80) {
+            result.push_back(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+            result.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            result.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            result.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            result.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else {
+            result.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            result.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+    return result;
+#endif
 }
 
 std::string StringUtils::WStringToUtf8(const std::wstring& wstr) {
@@ -2,7 +2,9 @@
 
 #include <string>
 #include <vector>
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 
 namespace luaui {
 namespace utils {
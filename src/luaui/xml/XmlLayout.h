@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Controls.h"
+#include "AllocationContext.h"
 #include <string>
 #include <memory>
 #include <functional>
@@ -46,6 +47,9 @@ public:
     virtual void RegisterElement(const std::string& tagName, 
                                   std::function<std::shared_ptr<Control>()> factory) = 0;
     
+    // 设置控件分配上下文：加载期间创建的控件从该上下文的内存池分配（nullptr 为默认堆分配）
+    virtual void SetAllocationContext(std::shared_ptr<AllocationContext> context) = 0;
+    
     // ========== 声明式事件绑定 ==========
     
     // 注册 Click 事件处理器（通过方法名）
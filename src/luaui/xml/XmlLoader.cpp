@@ -26,6 +26,10 @@
 #include <cctype>
 #include <cstring>
 #include <sstream>
+#ifndef _WIN32
+#include <strings.h>
+#define _stricmp strcasecmp
+#endif
 
 namespace luaui {
 namespace xml {
@@ -139,6 +143,7 @@ public:
         if (doc.Parse(content.c_str()) != tinyxml2::XML_SUCCESS) {
             throw XmlLayoutException("Failed to parse XML file: " + filePath);
         }
+        AllocationContext::Scope allocationScope(m_allocationContext.get());
         return LoadElement(doc.RootElement());
     }
     
@@ -150,6 +155,7 @@ public:
         if (doc.Parse(xmlString.c_str()) != tinyxml2::XML_SUCCESS) {
             throw XmlLayoutException("Failed to parse XML string");
         }
+        AllocationContext::Scope allocationScope(m_allocationContext.get());
         return LoadElement(doc.RootElement());
     }
     
@@ -158,6 +164,10 @@ public:
         m_factories[tagName] = factory;
     }
     
+    void SetAllocationContext(std::shared_ptr<AllocationContext> context) override {
+        m_allocationContext = std::move(context);
+    }
+    
     // ========== 事件处理器注册 ==========
     
     void RegisterClickHandler(const std::string& methodName, ClickHandler handler) override {
@@ -189,64 +199,65 @@ private:
     std::unordered_map<std::string, ClickHandler> m_clickHandlers;
     std::unordered_map<std::string, ValueChangedHandler> m_valueChangedHandlers;
     std::unordered_map<std::string, TextChangedHandler> m_textChangedHandlers;
+    std::shared_ptr<AllocationContext> m_allocationContext;
     
     // MVVM 延迟绑定列表
     std::vector<DeferredBinding> m_deferredBindings;
     
     void RegisterDefaultElements() {
-        RegisterElement("StackPanel", []() { return std::make_shared<StackPanel>(); });
-        RegisterElement("Panel", []() { return std::make_shared<Panel>(); });
-        RegisterElement("Grid", []() { return std::make_shared<Grid>(); });
-        RegisterElement("Button", []() { return std::make_shared<Button>(); });
-        RegisterElement("TextBlock", []() { return std::make_shared<TextBlock>(); });
-        RegisterElement("TextBox", []() { return std::make_shared<TextBox>(); });
-        RegisterElement("Border", []() { return std::make_shared<Border>(); });
-        RegisterElement("CheckBox", []() { return std::make_shared<CheckBox>(); });
-        RegisterElement("RadioButton", []() { return std::make_shared<RadioButton>(); });
-        RegisterElement("Slider", []() { return std::make_shared<Slider>(); });
-        RegisterElement("ProgressBar", []() { return std::make_shared<ProgressBar>(); });
-        RegisterElement("ListBox", []() { return std::make_shared<ListBox>(); });
-        RegisterElement("ListBoxItem", []() { return std::make_shared<ListBoxItem>(); });
-        RegisterElement("DataGrid", []() { return std::make_shared<DataGrid>(); });
-        RegisterElement("ScrollViewer", []() { return std::make_shared<ScrollViewer>(); });
-        RegisterElement("Image", []() { return std::make_shared<Image>(); });
-        RegisterElement("Rectangle", []() { return std::make_shared<Rectangle>(); });
-        RegisterElement("Ellipse", []() { return std::make_shared<Ellipse>(); });
+        RegisterElement("StackPanel", []() { return MakeControl<StackPanel>(); });
+        RegisterElement("Panel", []() { return MakeControl<Panel>(); });
+        RegisterElement("Grid", []() { return MakeControl<Grid>(); });
+        RegisterElement("Button", []() { return MakeControl<Button>(); });
+        RegisterElement("TextBlock", []() { return MakeControl<TextBlock>(); });
+        RegisterElement("TextBox", []() { return MakeControl<TextBox>(); });
+        RegisterElement("Border", []() { return MakeControl<Border>(); });
+        RegisterElement("CheckBox", []() { return MakeControl<CheckBox>(); });
+        RegisterElement("RadioButton", []() { return MakeControl<RadioButton>(); });
+        RegisterElement("Slider", []() { return MakeControl<Slider>(); });
+        RegisterElement("ProgressBar", []() { return MakeControl<ProgressBar>(); });
+        RegisterElement("ListBox", []() { return MakeControl<ListBox>(); });
+        RegisterElement("ListBoxItem", []() { return MakeControl<ListBoxItem>(); });
+        RegisterElement("DataGrid", []() { return MakeControl<DataGrid>(); });
+        RegisterElement("ScrollViewer", []() { return MakeControl<ScrollViewer>(); });
+        RegisterElement("Image", []() { return MakeControl<Image>(); });
+        RegisterElement("Rectangle", []() { return MakeControl<Rectangle>(); });
+        RegisterElement("Ellipse", []() { return MakeControl<Ellipse>(); });
 
         // Menu system
-        RegisterElement("MenuBar", []() { return std::make_shared<MenuBar>(); });
-        RegisterElement("Menu", []() { return std::make_shared<Menu>(); });
-        RegisterElement("MenuItem", []() { return std::make_shared<MenuItem>(); });
-        RegisterElement("ContextMenu", []() { return std::make_shared<ContextMenu>(); });
+        RegisterElement("MenuBar", []() { return MakeControl<MenuBar>(); });
+        RegisterElement("Menu", []() { return MakeControl<Menu>(); });
+        RegisterElement("MenuItem", []() { return MakeControl<MenuItem>(); });
+        RegisterElement("ContextMenu", []() { return MakeControl<ContextMenu>(); });
         RegisterElement("Separator", []() {
-            auto item = std::make_shared<MenuItem>();
+            auto item = MakeControl<MenuItem>();
             item->SetItemType(MenuItem::ItemType::Separator);
             return item;
         });
 
         // SideBar
-        RegisterElement("SideBar", []() { return std::make_shared<SideBar>(); });
+        RegisterElement("SideBar", []() { return MakeControl<SideBar>(); });
 
         // StatusBar
-        RegisterElement("StatusBar", []() { return std::make_shared<StatusBar>(); });
-        RegisterElement("StatusBarItem", []() { return std::make_shared<StatusBarItem>(); });
+        RegisterElement("StatusBar", []() { return MakeControl<StatusBar>(); });
+        RegisterElement("StatusBarItem", []() { return MakeControl<StatusBarItem>(); });
 
         // DockPanel
-        RegisterElement("DockPanel", []() { return std::make_shared<DockPanel>(); });
+        RegisterElement("DockPanel", []() { return MakeControl<DockPanel>(); });
         
         // Canvas
-        RegisterElement("Canvas", []() { return std::make_shared<Canvas>(); });
+        RegisterElement("Canvas", []() { return MakeControl<Canvas>(); });
         
         // WrapPanel
-        RegisterElement("WrapPanel", []() { return std::make_shared<WrapPanel>(); });
+        RegisterElement("WrapPanel", []() { return MakeControl<WrapPanel>(); });
         
         // Viewbox
-        RegisterElement("Viewbox", []() { return std::make_shared<Viewbox>(); });
+        RegisterElement("Viewbox", []() { return MakeControl<Viewbox>(); });
 
         // Docking system
-        RegisterElement("DockContainer", []() { return std::make_shared<DockContainer>(); });
-        RegisterElement("DockTabGroup", []() { return std::make_shared<DockTabGroup>(); });
-        RegisterElement("TabItem", []() { return std::make_shared<TabItem>(); });
+        RegisterElement("DockContainer", []() { return MakeControl<DockContainer>(); });
+        RegisterElement("DockTabGroup", []() { return MakeControl<DockTabGroup>(); });
+        RegisterElement("TabItem", []() { return MakeControl<TabItem>(); });
     }
     
     std::shared_ptr<luaui::Control> LoadElement(const tinyxml2::XMLElement* element) {
@@ -1134,7 +1145,7 @@ private:
                  childElem = childElem->NextSiblingElement()) {
                 std::string tag = childElem->Name();
                 if (tag == "Menu") {
-                    auto menu = std::make_shared<Menu>();
+                    auto menu = MakeControl<Menu>();
                     ApplyAttributes(menu, childElem);
                     LoadMenuItems(menu, childElem);
                     std::wstring header;
@@ -1174,7 +1185,7 @@ private:
                  childElem = childElem->NextSiblingElement()) {
                 std::string tag = childElem->Name();
                 if (tag == "StatusBarItem") {
-                    auto item = std::make_shared<StatusBarItem>();
+                    auto item = MakeControl<StatusBarItem>();
                     ApplyAttributes(item, childElem);
                     statusBar->AddItem(item);
                 }
@@ -1188,7 +1199,7 @@ private:
                  childElem = childElem->NextSiblingElement()) {
                 std::string tag = childElem->Name();
                 if (tag == "TabItem") {
-                    auto item = std::make_shared<TabItem>();
+                    auto item = MakeControl<TabItem>();
                     ApplyAttributes(item, childElem);
                     // TabItem 的第一个子元素作为内容
                     if (const auto* contentElem = childElem->FirstChildElement()) {
@@ -1224,17 +1235,17 @@ private:
             std::string tag = childElem->Name();
 
             if (tag == "Separator") {
-                auto item = std::make_shared<MenuItem>();
+                auto item = MakeControl<MenuItem>();
                 item->SetItemType(MenuItem::ItemType::Separator);
                 menu->AddItem(item);
             }
             else if (tag == "MenuItem") {
-                auto item = std::make_shared<MenuItem>();
+                auto item = MakeControl<MenuItem>();
                 ApplyAttributes(item, childElem);
 
                 // 检查是否有子 Menu（子菜单）
                 if (const auto* subMenuElem = childElem->FirstChildElement("Menu")) {
-                    auto subMenu = std::make_shared<Menu>();
+                    auto subMenu = MakeControl<Menu>();
                     ApplyAttributes(subMenu, subMenuElem);
                     LoadMenuItems(subMenu, subMenuElem);
                     item->SetSubmenu(subMenu);
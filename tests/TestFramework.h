@@ -7,6 +7,7 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <memory>
 #include <exception>
 #include <sstream>
 #include <chrono>
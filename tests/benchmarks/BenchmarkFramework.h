@@ -0,0 +1,363 @@
+// LuaUI Benchmark Framework
+// A small header-only benchmark harness (same registration style as TestFramework.h)
+//
+//   BENCHMARK(Layout_WideStack) {
+//       auto tree = MakeTree();            // setup is not timed
+//       while (state.KeepRunning()) {      // timed loop
+//           ...
+//       }
+//   }
+//
+// Runner options:
+//   --filter=<substring>    only run benchmarks whose name contains the substring
+//   --min-time=<ms>         minimum duration of one sample (default 100)
+//   --repetitions=<n>       samples per benchmark, the median is reported (default 5)
+//   --json=<path>           write results as JSON
+//   --baseline=<path>       compare against a JSON file written by --json
+//   --threshold=<percent>   slowdown that counts as a regression (default 15)
+// Comparisons use the fastest sample of each side, which is far less sensitive to
+// scheduler noise than the median; baselines are only meaningful on the machine
+// (and build type) that recorded them.
+//   --list                  print benchmark names and exit
+// The exit code is 1 when any benchmark regresses against the baseline.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace luaui {
+namespace bench {
+
+// Per-run state handed to a benchmark body
+class State {
+public:
+    explicit State(size_t iterations) : m_remaining(iterations), m_iterations(iterations) {}
+
+    // Returns true while iterations remain; the first call starts the timer
+    bool KeepRunning() {
+        if (!m_started) {
+            m_started = true;
+            m_start = Clock::now();
+        }
+        if (m_remaining == 0) {
+            if (!m_paused) m_elapsed += Clock::now() - m_start;
+            m_paused = true;
+            return false;
+        }
+        --m_remaining;
+        return true;
+    }
+
+    // Excludes per-iteration bookkeeping (e.g. invalidation) from the measurement
+    void PauseTiming() {
+        if (m_paused) return;
+        m_elapsed += Clock::now() - m_start;
+        m_paused = true;
+    }
+    void ResumeTiming() {
+        if (!m_paused) return;
+        m_start = Clock::now();
+        m_paused = false;
+    }
+
+    // Index of the current iteration (0-based), useful to vary inputs
+    size_t Iteration() const { return m_iterations - m_remaining - 1; }
+    size_t Iterations() const { return m_iterations; }
+
+    // Work items per iteration (rects, handlers, controls...), reported as ns/item
+    void SetItemsPerIteration(size_t items) { m_items = items; }
+    size_t GetItemsPerIteration() const { return m_items; }
+
+    double ElapsedNs() const {
+        return std::chrono::duration<double, std::nano>(m_elapsed).count();
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    size_t m_remaining;
+    size_t m_iterations;
+    size_t m_items = 1;
+    bool m_started = false;
+    bool m_paused = false;
+    Clock::time_point m_start;
+    Clock::duration m_elapsed{0};
+};
+
+using BenchmarkFn = std::function<void(State&)>;
+
+struct BenchmarkCase {
+    std::string name;
+    BenchmarkFn fn;
+};
+
+struct BenchmarkResult {
+    std::string name;
+    size_t iterations = 0;
+    size_t itemsPerIteration = 1;
+    double nsPerOp = 0;       // median of the samples
+    double minNsPerOp = 0;
+};
+
+// Benchmark registry
+class BenchmarkRegistry {
+public:
+    static BenchmarkRegistry& Instance() {
+        static BenchmarkRegistry instance;
+        return instance;
+    }
+
+    void Register(const std::string& name, BenchmarkFn fn) {
+        m_cases.push_back({name, std::move(fn)});
+    }
+
+    const std::vector<BenchmarkCase>& GetCases() const { return m_cases; }
+
+private:
+    std::vector<BenchmarkCase> m_cases;
+};
+
+class BenchmarkRegistrar {
+public:
+    BenchmarkRegistrar(const std::string& name, BenchmarkFn fn) {
+        BenchmarkRegistry::Instance().Register(name, std::move(fn));
+    }
+};
+
+struct RunOptions {
+    std::string filter;
+    std::string jsonPath;
+    std::string baselinePath;
+    double minTimeMs = 100.0;
+    int repetitions = 5;
+    double thresholdPercent = 15.0;
+    bool listOnly = false;
+};
+
+// Reads name -> min_ns_per_op from a file written by WriteJson (not a general JSON parser)
+inline std::map<std::string, double> ReadBaseline(const std::string& path) {
+    std::map<std::string, double> baseline;
+    std::ifstream file(path);
+    if (!file) return baseline;
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string text = buffer.str();
+
+    const std::string nameKey = "\"name\": \"";
+    const std::string valueKey = "\"min_ns_per_op\": ";
+    size_t pos = 0;
+    while ((pos = text.find(nameKey, pos)) != std::string::npos) {
+        size_t nameStart = pos + nameKey.size();
+        size_t nameEnd = text.find('"', nameStart);
+        size_t objectEnd = text.find('}', nameStart);
+        size_t valuePos = text.find(valueKey, nameStart);
+        if (nameEnd == std::string::npos || valuePos == std::string::npos || valuePos > objectEnd) {
+            pos = nameStart;
+            continue;
+        }
+        baseline[text.substr(nameStart, nameEnd - nameStart)] =
+            std::strtod(text.c_str() + valuePos + valueKey.size(), nullptr);
+        pos = objectEnd;
+    }
+    return baseline;
+}
+
+inline bool WriteJson(const std::string& path, const RunOptions& options,
+                      const std::vector<BenchmarkResult>& results) {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    char timestamp[32] = {};
+    std::time_t now = std::time(nullptr);
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+#ifdef NDEBUG
+    const char* buildType = "release";
+#else
+    const char* buildType = "debug";
+#endif
+#if defined(__clang__)
+    const std::string compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+    const std::string compiler = "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    const std::string compiler = "msvc " + std::to_string(_MSC_VER);
+#else
+    const std::string compiler = "unknown";
+#endif
+
+    out << "{\n";
+    out << "  \"context\": {\n";
+    out << "    \"timestamp\": \"" << timestamp << "\",\n";
+    out << "    \"build_type\": \"" << buildType << "\",\n";
+    out << "    \"compiler\": \"" << compiler << "\",\n";
+    out << "    \"min_time_ms\": " << options.minTimeMs << ",\n";
+    out << "    \"repetitions\": " << options.repetitions << "\n";
+    out << "  },\n";
+    out << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        char line[512];
+        std::snprintf(line, sizeof(line),
+                      "    { \"name\": \"%s\", \"iterations\": %zu, \"items_per_op\": %zu, "
+                      "\"ns_per_op\": %.1f, \"min_ns_per_op\": %.1f }%s\n",
+                      r.name.c_str(), r.iterations, r.itemsPerIteration,
+                      r.nsPerOp, r.minNsPerOp, i + 1 < results.size() ? "," : "");
+        out << line;
+    }
+    out << "  ]\n";
+    out << "}\n";
+    return static_cast<bool>(out);
+}
+
+// Benchmark runner
+class BenchmarkRunner {
+public:
+    static RunOptions ParseOptions(int argc, char** argv) {
+        RunOptions options;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&](const char* prefix) -> const char* {
+                size_t length = std::strlen(prefix);
+                return arg.compare(0, length, prefix) == 0 ? arg.c_str() + length : nullptr;
+            };
+            if (const char* v = value("--filter=")) options.filter = v;
+            else if (const char* v = value("--json=")) options.jsonPath = v;
+            else if (const char* v = value("--baseline=")) options.baselinePath = v;
+            else if (const char* v = value("--min-time=")) options.minTimeMs = std::atof(v);
+            else if (const char* v = value("--repetitions=")) options.repetitions = (std::max)(1, std::atoi(v));
+            else if (const char* v = value("--threshold=")) options.thresholdPercent = std::atof(v);
+            else if (arg == "--list") options.listOnly = true;
+            else std::cerr << "Unknown option: " << arg << std::endl;
+        }
+        return options;
+    }
+
+    static BenchmarkResult Run(const BenchmarkCase& benchmark, const RunOptions& options) {
+        // Grow the iteration count until one sample takes at least min-time
+        const double minTimeNs = options.minTimeMs * 1e6;
+        size_t iterations = 1;
+        double elapsedNs = 0;
+        size_t items = 1;
+        for (;;) {
+            State state(iterations);
+            benchmark.fn(state);
+            elapsedNs = state.ElapsedNs();
+            items = state.GetItemsPerIteration();
+            if (elapsedNs >= minTimeNs || iterations >= 1000000000) break;
+            double factor = elapsedNs > 0 ? minTimeNs * 1.2 / elapsedNs : 10.0;
+            factor = (std::min)(10.0, (std::max)(2.0, factor));
+            iterations = static_cast<size_t>(iterations * factor);
+        }
+
+        std::vector<double> samples;
+        samples.push_back(elapsedNs / iterations);
+        for (int i = 1; i < options.repetitions; ++i) {
+            State state(iterations);
+            benchmark.fn(state);
+            samples.push_back(state.ElapsedNs() / iterations);
+        }
+        std::sort(samples.begin(), samples.end());
+
+        BenchmarkResult result;
+        result.name = benchmark.name;
+        result.iterations = iterations;
+        result.itemsPerIteration = items;
+        result.nsPerOp = samples[samples.size() / 2];
+        result.minNsPerOp = samples.front();
+        return result;
+    }
+
+    static int RunAll(int argc, char** argv) {
+        RunOptions options = ParseOptions(argc, argv);
+        const auto& cases = BenchmarkRegistry::Instance().GetCases();
+
+        if (options.listOnly) {
+            for (const auto& c : cases) std::cout << c.name << std::endl;
+            return 0;
+        }
+
+        std::map<std::string, double> baseline;
+        if (!options.baselinePath.empty()) {
+            baseline = ReadBaseline(options.baselinePath);
+            if (baseline.empty()) {
+                std::cerr << "Baseline not found or empty: " << options.baselinePath
+                          << " (record one on this machine with --json)" << std::endl;
+            }
+        }
+
+        std::printf("%-44s %14s %12s %12s %10s\n", "benchmark", "ns/op", "ns/item", "iterations", "baseline");
+        std::vector<BenchmarkResult> results;
+        int regressions = 0;
+        for (const auto& c : cases) {
+            if (!options.filter.empty() && c.name.find(options.filter) == std::string::npos) continue;
+
+            BenchmarkResult result = Run(c, options);
+            results.push_back(result);
+
+            std::string verdict = "-";
+            auto it = baseline.find(result.name);
+            if (it != baseline.end() && it->second > 0) {
+                double change = (result.minNsPerOp / it->second - 1.0) * 100.0;
+                char buffer[32];
+                std::snprintf(buffer, sizeof(buffer), "%+.1f%%", change);
+                verdict = buffer;
+                if (change > options.thresholdPercent) {
+                    verdict += " REGRESSED";
+                    ++regressions;
+                }
+            } else if (!baseline.empty()) {
+                verdict = "new";
+            }
+            std::printf("%-44s %14.1f %12.1f %12zu %10s\n", result.name.c_str(), result.nsPerOp,
+                        result.nsPerOp / result.itemsPerIteration, result.iterations, verdict.c_str());
+            std::fflush(stdout);
+        }
+
+        if (!options.jsonPath.empty() && !WriteJson(options.jsonPath, options, results)) {
+            std::cerr << "Failed to write " << options.jsonPath << std::endl;
+            return 2;
+        }
+        if (regressions > 0) {
+            std::printf("%d benchmark(s) regressed by more than %.1f%%\n", regressions, options.thresholdPercent);
+            return 1;
+        }
+        return 0;
+    }
+};
+
+// Keeps the optimizer from discarding a computed value
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+} // namespace bench
+} // namespace luaui
+
+// ==================== Public API Macros ====================
+
+// Define a benchmark; the body receives `luaui::bench::State& state`
+#define BENCHMARK(name) \
+    static void bench_##name(luaui::bench::State& state); \
+    static luaui::bench::BenchmarkRegistrar bench_registrar_##name(#name, bench_##name); \
+    static void bench_##name(luaui::bench::State& state)
+
+// Run all registered benchmarks with command-line options
+#define RUN_ALL_BENCHMARKS(argc, argv) luaui::bench::BenchmarkRunner::RunAll(argc, argv)
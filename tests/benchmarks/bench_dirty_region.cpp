@@ -0,0 +1,118 @@
+// DirtyRegion benchmark: hundreds of small damage rects per frame
+// (ticker cells, blinking indicators) against the previous pairwise-merge region.
+#include "DirtyRegion.h"
+#include "IRenderEngine.h"
+#include "Types.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace luaui::rendering;
+
+namespace {
+
+// Previous implementation: O(n^2) pairwise merge, restarted after every merge,
+// triggered whenever more than 10 rects are pending.
+class LegacyDirtyRegion {
+public:
+    void AddRect(const Rect& rect) {
+        if (rect.width <= 0 || rect.height <= 0) return;
+        m_rects.push_back(rect);
+        if (m_rects.size() > 10) MergeRects();
+    }
+    const std::vector<Rect>& GetRects() const { return m_rects; }
+    void Clear() { m_rects.clear(); }
+
+private:
+    void MergeRects() {
+        bool merged = true;
+        while (merged && m_rects.size() > 1) {
+            merged = false;
+            for (size_t i = 0; i < m_rects.size() && !merged; ++i) {
+                for (size_t j = i + 1; j < m_rects.size(); ++j) {
+                    const Rect& a = m_rects[i];
+                    const Rect& b = m_rects[j];
+                    float left = std::min(a.x, b.x);
+                    float top = std::min(a.y, b.y);
+                    float right = std::max(a.x + a.width, b.x + b.width);
+                    float bottom = std::max(a.y + a.height, b.y + b.height);
+                    float mergedArea = (right - left) * (bottom - top);
+                    if (mergedArea < (a.width * a.height + b.width * b.height) * 1.5f) {
+                        m_rects[i] = Rect(left, top, right - left, bottom - top);
+                        m_rects.erase(m_rects.begin() + j);
+                        merged = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<Rect> m_rects;
+};
+
+// A 1920x1080 dashboard of 80x24 ticker cells; each frame a random subset changes
+std::vector<std::vector<Rect>> MakeFrames(size_t rectsPerFrame, size_t frameCount) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> col(0, 1920 / 80 - 1);
+    std::uniform_int_distribution<int> row(0, 1080 / 24 - 1);
+    std::vector<std::vector<Rect>> frames(frameCount);
+    for (auto& frame : frames) {
+        frame.reserve(rectsPerFrame);
+        for (size_t i = 0; i < rectsPerFrame; ++i) {
+            frame.emplace_back(col(rng) * 80.0f + 2.0f, row(rng) * 24.0f + 2.0f, 76.0f, 20.0f);
+        }
+    }
+    return frames;
+}
+
+template <typename Fn>
+double MeasureMicros(Fn&& fn, size_t frameCount) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / frameCount;
+}
+
+} // anonymous namespace
+
+int main() {
+    const size_t frameCount = 200;
+    const RegionCostModel d2d = RegionCostModel::ForAPI(RenderAPI::Direct2D);
+    const RegionCostModel software = RegionCostModel::ForAPI(RenderAPI::Software);
+
+    std::printf("%-8s %14s %14s %10s %10s %10s\n",
+                "rects", "legacy us/fr", "tiled us/fr", "legacy n", "d2d n", "sw n");
+
+    for (size_t rectsPerFrame : { 10u, 50u, 200u, 500u, 1000u }) {
+        auto frames = MakeFrames(rectsPerFrame, frameCount);
+
+        size_t legacyCount = 0;
+        LegacyDirtyRegion legacy;
+        double legacyUs = MeasureMicros([&] {
+            for (const auto& frame : frames) {
+                for (const auto& rect : frame) legacy.AddRect(rect);
+                legacyCount += legacy.GetRects().size();
+                legacy.Clear();
+            }
+        }, frameCount);
+
+        size_t d2dCount = 0;
+        size_t softwareCount = 0;
+        DirtyRegion tiled;
+        double tiledUs = MeasureMicros([&] {
+            for (const auto& frame : frames) {
+                for (const auto& rect : frame) tiled.AddRect(rect);
+                d2dCount += tiled.GetRenderRects(d2d).size();
+                softwareCount += tiled.GetRenderRects(software).size();
+                tiled.Clear();
+            }
+        }, frameCount);
+
+        std::printf("%-8zu %14.2f %14.2f %10zu %10zu %10zu\n", rectsPerFrame, legacyUs, tiledUs,
+                    legacyCount / frameCount, d2dCount / frameCount, softwareCount / frameCount);
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+// Grid solver benchmark: form-like grids (auto labels, pixel gutters, star content,
+// column and row spans) of growing size; only the grid itself is re-measured.
+#include "layouts/Grid.h"
+#include "Control.h"
+#include "Components/LayoutComponent.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+
+using namespace luaui;
+using namespace luaui::controls;
+using namespace luaui::rendering;
+
+namespace {
+
+// Fixed content size so the timings isolate the grid solver
+class Cell : public luaui::Control {
+public:
+    Cell(float width, float height) : m_size(width, height) {}
+    std::string GetTypeName() const override { return "Cell"; }
+
+protected:
+    void InitializeComponents() override {
+        GetComponents().AddComponent<components::LayoutComponent>(this);
+    }
+    Size OnMeasure(const Size&) override { return m_size; }
+
+private:
+    Size m_size;
+};
+
+// columns repeat (Auto, Pixel, Star); every 7th cell spans two columns, every 11th two rows
+std::shared_ptr<Grid> MakeGrid(int columns, int rows) {
+    auto grid = std::make_shared<Grid>();
+    for (int c = 0; c < columns; ++c) {
+        switch (c % 3) {
+            case 0: grid->AddColumn(GridLength::Auto()); break;
+            case 1: grid->AddColumn(GridLength::Pixel(8.0f)); break;
+            default: grid->AddColumn(GridLength::Star(1.0f + c % 2)); break;
+        }
+    }
+    for (int r = 0; r < rows; ++r) {
+        grid->AddRow(r % 4 == 3 ? GridLength::Star(1.0f) : GridLength::Auto());
+    }
+
+    int index = 0;
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < columns; ++c, ++index) {
+            auto cell = std::make_shared<Cell>(20.0f + index % 37, 14.0f + index % 5);
+            grid->AddChild(cell);
+            grid->SetColumn(cell, c);
+            grid->SetRow(cell, r);
+            if (index % 7 == 0 && c + 1 < columns) grid->SetColumnSpan(cell, 2);
+            if (index % 11 == 0 && r + 1 < rows) grid->SetRowSpan(cell, 2);
+        }
+    }
+    return grid;
+}
+
+// Average microseconds per measure + arrange of the grid (children stay cached)
+double MeasureLayoutUs(Grid& grid, int iterations) {
+    components::LayoutConstraint constraint;
+    constraint.available = Size(3840.0f, 2160.0f);
+
+    auto* layout = grid.GetLayout();
+    layout->Measure(constraint);   // warm-up and initialization
+
+    double totalUs = 0;
+    for (int i = 0; i < iterations; ++i) {
+        layout->InvalidateMeasure();
+        auto start = std::chrono::steady_clock::now();
+        layout->Measure(constraint);
+        layout->Arrange(Rect(0, 0, constraint.available.width, constraint.available.height));
+        totalUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+    return totalUs / iterations;
+}
+
+} // anonymous namespace
+
+int main() {
+    const int iterations = 50;
+    std::printf("%-10s %10s %12s %12s\n", "cells", "grid", "us/layout", "ns/cell");
+
+    const int shapes[][2] = { { 20, 50 }, { 50, 200 }, { 100, 400 } };
+    for (const auto& shape : shapes) {
+        auto grid = MakeGrid(shape[0], shape[1]);
+        int cells = shape[0] * shape[1];
+        double us = MeasureLayoutUs(*grid, iterations);
+        char size[32];
+        std::snprintf(size, sizeof(size), "%dx%d", shape[0], shape[1]);
+        std::printf("%-10d %10s %12.1f %12.1f\n", cells, size, us, us * 1000.0 / cells);
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+// Parallel layout benchmark: a wide monitoring dashboard (many independent panels
+// of text cells) measured sequentially and on work-stealing pools of growing size.
+#include "Panel.h"
+#include "layouts/Grid.h"
+#include "Control.h"
+#include "Components/LayoutComponent.h"
+#include "SoftwareTextFormat.h"
+#include "WorkStealingPool.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace luaui;
+using namespace luaui::controls;
+using namespace luaui::rendering;
+
+namespace {
+
+// Text cell measured through the software text path (pure and thread-safe)
+class TextCell : public luaui::Control {
+public:
+    explicit TextCell(std::wstring text) : m_text(std::move(text)) {}
+    std::string GetTypeName() const override { return "TextCell"; }
+
+    void Touch() {
+        if (auto* layout = GetLayout()) layout->InvalidateMeasure();
+    }
+
+protected:
+    void InitializeComponents() override {
+        GetComponents().AddComponent<components::LayoutComponent>(this);
+    }
+    Size OnMeasure(const Size& availableSize) override {
+        SoftwareTextFormat format(L"Segoe UI", 13.0f);
+        return format.MeasureText(m_text, availableSize.width);
+    }
+
+private:
+    std::wstring m_text;
+};
+
+struct Dashboard {
+    std::shared_ptr<Grid> root;
+    std::vector<std::shared_ptr<TextCell>> cells;
+};
+
+// columns x rows grid of panels, each a vertical stack of text cells
+Dashboard MakeDashboard(int columns, int rows, int cellsPerPanel) {
+    Dashboard board;
+    board.root = std::make_shared<Grid>();
+    for (int c = 0; c < columns; ++c) board.root->AddColumn(GridLength::Star(1.0f));
+    for (int r = 0; r < rows; ++r) board.root->AddRow(GridLength::Star(1.0f));
+
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < columns; ++c) {
+            auto panel = std::make_shared<StackPanel>();
+            for (int i = 0; i < cellsPerPanel; ++i) {
+                std::wstring text = L"Sensor " + std::to_wstring(r * columns + c) +
+                                    L" channel " + std::to_wstring(i) +
+                                    L": 1234.56 kPa nominal, trend stable over the last interval";
+                auto cell = std::make_shared<TextCell>(std::move(text));
+                board.cells.push_back(cell);
+                panel->AddChild(cell);
+            }
+            board.root->AddChild(panel);
+            board.root->SetColumn(panel, c);
+            board.root->SetRow(panel, r);
+        }
+    }
+    return board;
+}
+
+// Average milliseconds per full relayout (every cell invalidated, as on resize)
+double MeasureLayoutMs(Dashboard& board, WorkStealingPool* pool, int iterations) {
+    components::LayoutComponent::ParallelMeasureScope scope(pool);
+    components::LayoutConstraint constraint;
+    constraint.available = Size(3840.0f, 2160.0f);
+
+    auto* layout = board.root->GetLayout();
+    layout->Measure(constraint);   // warm-up and initialization
+
+    double totalMs = 0;
+    for (int i = 0; i < iterations; ++i) {
+        for (auto& cell : board.cells) cell->Touch();
+        auto start = std::chrono::steady_clock::now();
+        layout->Measure(constraint);
+        layout->Arrange(Rect(0, 0, constraint.available.width, constraint.available.height));
+        totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    return totalMs / iterations;
+}
+
+} // anonymous namespace
+
+int main() {
+    const int iterations = 20;
+    auto board = MakeDashboard(8, 4, 60);
+    std::printf("dashboard: %zu text cells in 32 panels\n", board.cells.size());
+
+    double sequentialMs = MeasureLayoutMs(board, nullptr, iterations);
+    Size reference = board.root->GetLayout()->GetDesiredSize();
+    std::printf("%-10s %12s %10s\n", "threads", "ms/layout", "speedup");
+    std::printf("%-10s %12.3f %10.2f\n", "seq", sequentialMs, 1.0);
+
+    unsigned hardware = std::thread::hardware_concurrency();
+    for (unsigned threads : { 2u, 4u, 8u, 16u }) {
+        if (threads > hardware && threads != 2u) break;
+        WorkStealingPool pool(threads - 1);   // the calling thread also runs tasks
+        double ms = MeasureLayoutMs(board, &pool, iterations);
+        Size desired = board.root->GetLayout()->GetDesiredSize();
+        bool same = desired.width == reference.width && desired.height == reference.height;
+        std::printf("%-10u %12.3f %10.2f%s\n", threads, ms, sequentialMs / ms, same ? "" : "  MISMATCH");
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+// Core benchmarks: DirtyRegion merging, Delegate dispatch and control components
+#include "BenchmarkFramework.h"
+#include "Delegate.h"
+#include "DirtyRegion.h"
+#include "IRenderEngine.h"
+#include "Types.h"
+#include "Button.h"
+#include "Components/LayoutComponent.h"
+#include "Components/RenderComponent.h"
+#include "Components/InputComponent.h"
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace luaui;
+using namespace luaui::rendering;
+
+namespace {
+
+// Frames of 80x24 ticker-cell damage on a 1920x1080 surface
+std::vector<std::vector<Rect>> MakeDamageFrames(size_t rectsPerFrame, size_t frameCount) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> col(0, 1920 / 80 - 1);
+    std::uniform_int_distribution<int> row(0, 1080 / 24 - 1);
+    std::vector<std::vector<Rect>> frames(frameCount);
+    for (auto& frame : frames) {
+        for (size_t i = 0; i < rectsPerFrame; ++i) {
+            frame.emplace_back(col(rng) * 80.0f + 2.0f, row(rng) * 24.0f + 2.0f, 76.0f, 20.0f);
+        }
+    }
+    return frames;
+}
+
+void RunDirtyRegion(bench::State& state, size_t rectsPerFrame) {
+    const auto frames = MakeDamageFrames(rectsPerFrame, 64);
+    const RegionCostModel cost = RegionCostModel::ForAPI(RenderAPI::Software);
+    state.SetItemsPerIteration(rectsPerFrame);
+
+    DirtyRegion region;
+    while (state.KeepRunning()) {
+        for (const auto& rect : frames[state.Iteration() % frames.size()]) region.AddRect(rect);
+        auto rects = region.GetRenderRects(cost);
+        bench::DoNotOptimize(rects.size());
+        region.Clear();
+    }
+}
+
+struct Counter {
+    int value = 0;
+    void OnEvent(int delta) { value += delta; }
+};
+
+void RunDelegateInvoke(bench::State& state, size_t handlerCount) {
+    Delegate<int> event;
+    std::vector<Counter> counters(handlerCount);
+    for (auto& counter : counters) event.Add(&counter, &Counter::OnEvent);
+    state.SetItemsPerIteration(handlerCount);
+
+    while (state.KeepRunning()) {
+        event.Invoke(1);
+    }
+    bench::DoNotOptimize(counters.front().value);
+}
+
+} // anonymous namespace
+
+BENCHMARK(DirtyRegion_Merge_20) {
+    RunDirtyRegion(state, 20);
+}
+
+BENCHMARK(DirtyRegion_Merge_200) {
+    RunDirtyRegion(state, 200);
+}
+
+BENCHMARK(DirtyRegion_Merge_1000) {
+    RunDirtyRegion(state, 1000);
+}
+
+BENCHMARK(Delegate_Invoke_1) {
+    RunDelegateInvoke(state, 1);
+}
+
+BENCHMARK(Delegate_Invoke_64) {
+    RunDelegateInvoke(state, 64);
+}
+
+BENCHMARK(Delegate_InvokeLambda_8) {
+    Delegate<int> event;
+    int total = 0;
+    for (int i = 0; i < 8; ++i) event.Add([&total, i](int delta) { total += delta * i; });
+    state.SetItemsPerIteration(8);
+
+    while (state.KeepRunning()) {
+        event.Invoke(1);
+    }
+    bench::DoNotOptimize(total);
+}
+
+BENCHMARK(Delegate_AddRemove) {
+    Delegate<int> event;
+    Counter counter;
+    while (state.KeepRunning()) {
+        auto id = event.Add(&counter, &Counter::OnEvent);
+        event.Remove(id);
+    }
+}
+
+// Create and initialize a Button (layout, render and input components), then destroy it
+BENCHMARK(Control_CreateButton_1000) {
+    state.SetItemsPerIteration(1000);
+    std::vector<std::shared_ptr<controls::Button>> buttons;
+    buttons.reserve(1000);
+    while (state.KeepRunning()) {
+        for (int i = 0; i < 1000; ++i) {
+            buttons.push_back(std::make_shared<controls::Button>());
+            buttons.back()->EnsureInitialized();
+        }
+        buttons.clear();
+    }
+}
+
+// Component lookups through the Control convenience accessors, as done per control per pass
+BENCHMARK(Control_ComponentAccess_1000) {
+    std::vector<std::shared_ptr<controls::Button>> buttons;
+    for (int i = 0; i < 1000; ++i) buttons.push_back(std::make_shared<controls::Button>());
+    state.SetItemsPerIteration(3000);
+
+    while (state.KeepRunning()) {
+        size_t found = 0;
+        for (auto& button : buttons) {
+            found += button->GetLayout() != nullptr;
+            found += button->GetRender() != nullptr;
+            found += button->GetComponents().GetComponent<components::InputComponent>() != nullptr;
+        }
+        bench::DoNotOptimize(found);
+    }
+}
@@ -0,0 +1,158 @@
+// Drawing benchmarks: DrawingGroup primitives versus one Shapes control per primitive
+#include "BenchmarkFramework.h"
+#include "Panel.h"
+#include "Shapes.h"
+#include "DrawingHost.h"
+#include "DrawingGroup.h"
+#include "Components/RenderComponent.h"
+#include "software/SoftwareRenderTarget.h"
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace luaui;
+using namespace luaui::controls;
+using namespace luaui::rendering;
+
+namespace {
+
+constexpr int kSurfaceWidth = 1920;
+constexpr int kSurfaceHeight = 1080;
+
+// Heat-map style chart: columns x rows cells filling the surface, one colour per column band
+std::shared_ptr<DrawingHost> MakeChart(int columns, int rows, std::vector<DrawingGroup::PrimitiveId>& ids) {
+    auto host = std::make_shared<DrawingHost>();
+    host->GetRender()->GetRenderRect() = Rect(0, 0, kSurfaceWidth, kSurfaceHeight);
+    auto& drawing = host->GetDrawing();
+
+    const float cellWidth = static_cast<float>(kSurfaceWidth) / columns;
+    const float cellHeight = static_cast<float>(kSurfaceHeight) / rows;
+    std::vector<Rect> rects;
+    ids.resize(static_cast<size_t>(columns) * rows);
+    drawing.Reserve(ids.size());
+    for (int band = 0; band < 8; ++band) {
+        rects.clear();
+        for (int col = band * columns / 8; col < (band + 1) * columns / 8; ++col) {
+            for (int row = 0; row < rows; ++row) {
+                rects.emplace_back(col * cellWidth, row * cellHeight, cellWidth - 1, cellHeight - 1);
+            }
+        }
+        auto style = drawing.AddFillStyle(Color(band / 8.0f, 0.4f, 1.0f - band / 8.0f));
+        drawing.AddRectangles(rects.data(), rects.size(), style,
+                              ids.data() + static_cast<size_t>(band * columns / 8) * rows);
+    }
+    return host;
+}
+
+void RenderFrame(SoftwareRenderTarget& target, Control* control, const Rect& clip) {
+    auto* context = target.GetContext();
+    target.BeginDraw();
+    context->PushClip(clip);
+    control->GetRender()->Render(context);
+    context->PopClip();
+    target.EndDraw();
+}
+
+void RunDrawingRender(bench::State& state, const Rect& clip) {
+    std::vector<DrawingGroup::PrimitiveId> ids;
+    auto host = MakeChart(500, 200, ids);
+    SoftwareRenderTarget target(kSurfaceWidth, kSurfaceHeight, false);
+    RenderFrame(target, host.get(), clip);   // builds the spatial index
+    state.SetItemsPerIteration(host->GetLastRenderStats().drawn);
+
+    while (state.KeepRunning()) {
+        RenderFrame(target, host.get(), clip);
+    }
+    bench::DoNotOptimize(host->GetLastRenderStats().calls);
+}
+
+} // anonymous namespace
+
+// 100k cells, whole surface repainted
+BENCHMARK(Drawing_100kPrimitives_Render) {
+    RunDrawingRender(state, Rect(0, 0, kSurfaceWidth, kSurfaceHeight));
+}
+
+// 100k cells, 400x300 damage rect: the grid index skips everything outside it
+BENCHMARK(Drawing_100kPrimitives_RenderDirtyRect) {
+    RunDrawingRender(state, Rect(700, 400, 400, 300));
+}
+
+// Every cell nudged up and down by half a pixel (animated chart), then repainted
+BENCHMARK(Drawing_100kPrimitives_UpdateAllAndRender) {
+    std::vector<DrawingGroup::PrimitiveId> ids;
+    auto host = MakeChart(500, 200, ids);
+    SoftwareRenderTarget target(kSurfaceWidth, kSurfaceHeight, false);
+    const Rect clip(0, 0, kSurfaceWidth, kSurfaceHeight);
+    state.SetItemsPerIteration(ids.size());
+
+    while (state.KeepRunning()) {
+        float dy = state.Iteration() % 2 == 0 ? 0.5f : -0.5f;
+        host->GetDrawing().Offset(ids.data(), ids.size(), 0, dy);
+        RenderFrame(target, host.get(), clip);
+    }
+}
+
+// 1k random cells moved to random positions, then the index answers 1k hit tests
+BENCHMARK(Drawing_100kPrimitives_Move1kAndHitTest) {
+    std::vector<DrawingGroup::PrimitiveId> ids;
+    auto host = MakeChart(500, 200, ids);
+    auto& drawing = host->GetDrawing();
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<size_t> pick(0, ids.size() - 1);
+    std::uniform_real_distribution<float> x(0, kSurfaceWidth - 4.0f);
+    std::uniform_real_distribution<float> y(0, kSurfaceHeight - 4.0f);
+    std::vector<DrawingGroup::PrimitiveId> moved(1000);
+    std::vector<Rect> targets(1000);
+    state.SetItemsPerIteration(2000);
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < moved.size(); ++i) {
+            moved[i] = ids[pick(rng)];
+            targets[i] = Rect(x(rng), y(rng), 3.0f, 4.0f);
+        }
+        drawing.SetBounds(moved.data(), targets.data(), moved.size());
+        size_t hits = 0;
+        for (const auto& rect : targets) {
+            hits += drawing.HitTest(Point(rect.x + 1, rect.y + 1)) != DrawingGroup::kInvalidId;
+        }
+        bench::DoNotOptimize(hits);
+    }
+}
+
+// Same 10k-cell chart as Rectangle controls in a Panel versus primitives in one DrawingHost
+BENCHMARK(Drawing_10kRectangleControls_Render) {
+    auto panel = std::make_shared<Panel>();
+    panel->GetRender()->GetRenderRect() = Rect(0, 0, kSurfaceWidth, kSurfaceHeight);
+    const float cellWidth = kSurfaceWidth / 100.0f, cellHeight = kSurfaceHeight / 100.0f;
+    for (int col = 0; col < 100; ++col) {
+        for (int row = 0; row < 100; ++row) {
+            auto rect = std::make_shared<controls::Rectangle>();
+            int band = col * 8 / 100;
+            rect->SetFill(Color(band / 8.0f, 0.4f, 1.0f - band / 8.0f));
+            rect->GetRender()->GetRenderRect() = Rect(col * cellWidth, row * cellHeight, cellWidth - 1, cellHeight - 1);
+            panel->AddChild(rect);
+        }
+    }
+    SoftwareRenderTarget target(kSurfaceWidth, kSurfaceHeight, false);
+    const Rect clip(0, 0, kSurfaceWidth, kSurfaceHeight);
+    RenderFrame(target, panel.get(), clip);   // records each control's display list
+    state.SetItemsPerIteration(10000);
+
+    while (state.KeepRunning()) {
+        RenderFrame(target, panel.get(), clip);
+    }
+}
+
+BENCHMARK(Drawing_10kPrimitives_Render) {
+    std::vector<DrawingGroup::PrimitiveId> ids;
+    auto host = MakeChart(100, 100, ids);
+    SoftwareRenderTarget target(kSurfaceWidth, kSurfaceHeight, false);
+    const Rect clip(0, 0, kSurfaceWidth, kSurfaceHeight);
+    RenderFrame(target, host.get(), clip);
+    state.SetItemsPerIteration(10000);
+
+    while (state.KeepRunning()) {
+        RenderFrame(target, host.get(), clip);
+    }
+}
@@ -0,0 +1,191 @@
+// Layout benchmarks: measure + arrange of synthetic trees
+#include "BenchmarkFramework.h"
+#include "Panel.h"
+#include "layouts/Grid.h"
+#include "Control.h"
+#include "Components/LayoutComponent.h"
+#include "Components/LayoutStore.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace luaui;
+using namespace luaui::controls;
+using namespace luaui::rendering;
+
+namespace {
+
+// Fixed-size leaf so the timings isolate the layout pass
+class Leaf : public luaui::Control {
+public:
+    Leaf(float width, float height) : m_size(width, height) {}
+    std::string GetTypeName() const override { return "Leaf"; }
+
+protected:
+    void InitializeComponents() override {
+        GetComponents().AddComponent<components::LayoutComponent>(this);
+    }
+    Size OnMeasure(const Size&) override { return m_size; }
+
+private:
+    Size m_size;
+};
+
+std::shared_ptr<Leaf> MakeLeaf(size_t index) {
+    return std::make_shared<Leaf>(40.0f + index % 23, 16.0f + index % 5);
+}
+
+std::shared_ptr<StackPanel> MakeStack(StackPanel::Orientation orientation) {
+    auto panel = std::make_shared<StackPanel>();
+    panel->SetOrientation(orientation);
+    return panel;
+}
+
+// Nested panels `depth` levels deep, each level also holding one leaf
+std::shared_ptr<Panel> MakeDeepTree(int depth) {
+    auto root = MakeStack(StackPanel::Orientation::Vertical);
+    auto current = root;
+    for (int i = 0; i < depth; ++i) {
+        current->AddChild(MakeLeaf(i));
+        auto next = MakeStack(i % 2 ? StackPanel::Orientation::Vertical : StackPanel::Orientation::Horizontal);
+        current->AddChild(next);
+        current = next;
+    }
+    return root;
+}
+
+// One panel with `count` leaves
+std::shared_ptr<Panel> MakeWideTree(size_t count) {
+    auto root = MakeStack(StackPanel::Orientation::Vertical);
+    for (size_t i = 0; i < count; ++i) root->AddChild(MakeLeaf(i));
+    return root;
+}
+
+// Grid of `outer` x `outer` cells, each a form-like grid (Auto label, Star field)
+std::shared_ptr<Panel> MakeGridTree(int outer, int rowsPerCell) {
+    auto root = std::make_shared<Grid>();
+    for (int i = 0; i < outer; ++i) {
+        root->AddColumn(GridLength::Star(1.0f));
+        root->AddRow(GridLength::Auto());
+    }
+    size_t index = 0;
+    for (int r = 0; r < outer; ++r) {
+        for (int c = 0; c < outer; ++c) {
+            auto form = std::make_shared<Grid>();
+            form->AddColumn(GridLength::Auto());
+            form->AddColumn(GridLength::Pixel(8.0f));
+            form->AddColumn(GridLength::Star(1.0f));
+            for (int row = 0; row < rowsPerCell; ++row) {
+                form->AddRow(GridLength::Auto());
+                auto label = MakeLeaf(index++);
+                auto field = MakeLeaf(index++);
+                form->AddChild(label);
+                form->AddChild(field);
+                form->SetRow(label, row);
+                form->SetRow(field, row);
+                form->SetColumn(field, 2);
+            }
+            root->AddChild(form);
+            root->SetRow(form, r);
+            root->SetColumn(form, c);
+        }
+    }
+    return root;
+}
+
+// `rows` horizontal rows of `columns` leaves: rows * (columns + 1) + 1 controls
+std::shared_ptr<Panel> MakeLargeTree(size_t rows, size_t columns, std::vector<std::shared_ptr<Leaf>>* leaves) {
+    auto root = MakeStack(StackPanel::Orientation::Vertical);
+    size_t index = 0;
+    for (size_t r = 0; r < rows; ++r) {
+        auto row = MakeStack(StackPanel::Orientation::Horizontal);
+        for (size_t c = 0; c < columns; ++c) {
+            auto leaf = MakeLeaf(index++);
+            if (leaves) leaves->push_back(leaf);
+            row->AddChild(leaf);
+        }
+        root->AddChild(row);
+    }
+    return root;
+}
+
+// Same tree, but the leaves' layout slots are allocated in random order, as after
+// long-lived churn; with `reorder` the store is then restored to depth-first order
+std::shared_ptr<Panel> MakeScatteredTree(size_t rows, size_t columns, bool reorder) {
+    std::vector<std::shared_ptr<Leaf>> leaves;
+    auto root = MakeLargeTree(rows, columns, &leaves);
+    std::shuffle(leaves.begin(), leaves.end(), std::mt19937(42));
+    for (auto& leaf : leaves) leaf->GetLayout();
+    root->GetLayout();
+    for (size_t i = 0; i < root->GetChildCount(); ++i) {
+        static_cast<Control*>(root->GetChild(i).get())->GetLayout();
+    }
+    if (reorder) components::LayoutStore::Shared().ReorderDepthFirst(root.get());
+    return root;
+}
+
+size_t CountControls(const std::shared_ptr<interfaces::IControl>& control) {
+    size_t count = 1;
+    for (size_t i = 0; i < control->GetChildCount(); ++i) count += CountControls(control->GetChild(i));
+    return count;
+}
+
+// Full measure + arrange at a width that changes every iteration (window resize);
+// the width cycles through more values than the measure cache holds
+void RunResizeLayout(bench::State& state, const std::shared_ptr<Panel>& root) {
+    state.SetItemsPerIteration(CountControls(root));
+    auto* layout = root->GetLayout();
+    components::LayoutConstraint constraint;
+    constraint.available = Size(1600.0f, 1200.0f);
+    layout->Measure(constraint);
+
+    while (state.KeepRunning()) {
+        constraint.available.width = 1600.0f + static_cast<float>(state.Iteration() % 61);
+        layout->Measure(constraint);
+        layout->Arrange(Rect(0, 0, constraint.available.width, constraint.available.height));
+    }
+}
+
+} // anonymous namespace
+
+BENCHMARK(Layout_Deep_200) {
+    RunResizeLayout(state, MakeDeepTree(200));
+}
+
+BENCHMARK(Layout_Wide_10k) {
+    RunResizeLayout(state, MakeWideTree(10000));
+}
+
+BENCHMARK(Layout_GridHeavy_20x20x8) {
+    RunResizeLayout(state, MakeGridTree(20, 8));
+}
+
+BENCHMARK(Layout_100kControls_Resize) {
+    RunResizeLayout(state, MakeLargeTree(1000, 100, nullptr));
+}
+
+BENCHMARK(Layout_100kControls_Resize_Scattered) {
+    RunResizeLayout(state, MakeScatteredTree(1000, 100, false));
+}
+
+BENCHMARK(Layout_100kControls_Resize_DepthFirst) {
+    RunResizeLayout(state, MakeScatteredTree(1000, 100, true));
+}
+
+// One leaf changes size; only its ancestors are re-measured, siblings hit the cache
+BENCHMARK(Layout_100kControls_SingleLeafChange) {
+    std::vector<std::shared_ptr<Leaf>> leaves;
+    auto root = MakeLargeTree(1000, 100, &leaves);
+    auto* layout = root->GetLayout();
+    components::LayoutConstraint constraint;
+    constraint.available = Size(1600.0f, 1200.0f);
+    layout->Measure(constraint);
+    layout->Arrange(Rect(0, 0, 1600.0f, 1200.0f));
+
+    while (state.KeepRunning()) {
+        leaves[(state.Iteration() * 7919) % leaves.size()]->GetLayout()->InvalidateMeasure();
+        layout->Measure(constraint);
+        layout->Arrange(Rect(0, 0, 1600.0f, 1200.0f));
+    }
+}
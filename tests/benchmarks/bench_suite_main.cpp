@@ -0,0 +1,10 @@
+// LuaUI benchmark suite entry point (see BenchmarkFramework.h for options)
+#include "BenchmarkFramework.h"
+#include "Logger.h"
+
+int main(int argc, char** argv) {
+    // Debug logging from controls and loaders would dominate the timings
+    luaui::utils::Logger::SetConsoleLevel(luaui::utils::LogLevel::Error);
+    luaui::utils::Logger::EnableFile(false);
+    return RUN_ALL_BENCHMARKS(argc, argv);
+}
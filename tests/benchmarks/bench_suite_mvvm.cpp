@@ -0,0 +1,94 @@
+// MVVM benchmarks: binding propagation from a ViewModelBase to bound controls
+#include "BenchmarkFramework.h"
+#include "mvvm/BindingEngine.h"
+#include "mvvm/ViewModelBase.h"
+#include "TextBlock.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace luaui;
+using namespace luaui::mvvm;
+using namespace luaui::controls;
+
+namespace {
+
+class TickerViewModel : public ViewModelBase {
+public:
+    const std::string& GetPrice() const { return m_price; }
+    void SetPrice(const std::string& price) {
+        if (m_price != price) {
+            m_price = price;
+            NotifyPropertyChanged("Price");
+        }
+    }
+
+    void SetVolume(int volume) {
+        if (m_volume != volume) {
+            m_volume = volume;
+            NotifyPropertyChanged("Volume");
+        }
+    }
+
+    std::any GetPropertyValue(const std::string& name) const override {
+        if (name == "Price") return m_price;
+        if (name == "Volume") return m_volume;
+        return std::any();
+    }
+
+private:
+    std::string m_price = "0.00";
+    int m_volume = 0;
+};
+
+struct BoundView {
+    std::shared_ptr<TickerViewModel> viewModel = std::make_shared<TickerViewModel>();
+    std::vector<std::shared_ptr<TextBlock>> targets;
+    std::vector<std::shared_ptr<IBinding>> bindings;
+};
+
+// `count` TextBlocks bound one-way to ViewModel.Price
+BoundView MakeBoundView(size_t count) {
+    BoundView view;
+    auto& engine = BindingEngine::Instance();
+    auto expression = engine.ParseExpression("{Binding Price}");
+    TickerViewModel* viewModel = view.viewModel.get();
+    for (size_t i = 0; i < count; ++i) {
+        auto text = std::make_shared<TextBlock>();
+        TextBlock* target = text.get();
+        view.bindings.push_back(engine.CreateBinding(
+            view.viewModel, text, expression,
+            [target]() -> std::any { return target->GetText(); },
+            // PropertyBinding does not resolve source values yet; read the view model directly
+            [target, viewModel](const std::any&) {
+                const std::string& price = viewModel->GetPrice();
+                target->SetText(std::wstring(price.begin(), price.end()));
+            }));
+        view.targets.push_back(text);
+    }
+    return view;
+}
+
+} // anonymous namespace
+
+BENCHMARK(Binding_Propagate_1000) {
+    auto view = MakeBoundView(1000);
+    state.SetItemsPerIteration(view.targets.size());
+    const std::string prices[] = { "101.25", "101.50" };
+
+    while (state.KeepRunning()) {
+        view.viewModel->SetPrice(prices[state.Iteration() % 2]);
+    }
+    BindingEngine::Instance().ClearBindings();
+}
+
+// Changes to an unbound property still reach every subscriber and are filtered by path
+BENCHMARK(Binding_UnrelatedProperty_1000) {
+    auto view = MakeBoundView(1000);
+    state.SetItemsPerIteration(view.targets.size());
+
+    while (state.KeepRunning()) {
+        view.viewModel->SetVolume(static_cast<int>(state.Iteration()));
+    }
+    BindingEngine::Instance().ClearBindings();
+}
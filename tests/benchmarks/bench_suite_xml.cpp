@@ -0,0 +1,108 @@
+// XML benchmarks: loading the tests/fixtures layouts, and load/unload of a 10k-control view
+#include "BenchmarkFramework.h"
+#include "xml/XmlLayout.h"
+#include "AllocationContext.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifndef LUAUI_FIXTURES_DIR
+#define LUAUI_FIXTURES_DIR "tests/fixtures"
+#endif
+
+using namespace luaui;
+
+namespace {
+
+std::string ReadFixture(const char* name) {
+    std::ifstream file(std::string(LUAUI_FIXTURES_DIR) + "/" + name);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+// Parses and builds the control tree; the file is read once up front so disk I/O is not timed
+void RunLoadFixture(bench::State& state, const char* name) {
+    const std::string xml = ReadFixture(name);
+    if (xml.empty()) {
+        std::fprintf(stderr, "Fixture not found: %s/%s\n", LUAUI_FIXTURES_DIR, name);
+        while (state.KeepRunning()) {}
+        return;
+    }
+
+    auto loader = xml::CreateXmlLoader();
+    while (state.KeepRunning()) {
+        auto root = loader->LoadFromString(xml);
+        bench::DoNotOptimize(root.get());
+    }
+}
+
+// 100 rows of 99 alternating TextBlock/Button cells: 100 * 100 + 1 controls
+std::string MakeLargeView() {
+    std::string xml = "<StackPanel>";
+    for (int row = 0; row < 100; ++row) {
+        xml += "<StackPanel Orientation=\"Horizontal\">";
+        for (int cell = 0; cell < 99; ++cell) {
+            xml += cell % 2 ? "<Button Text=\"Go\"/>" : "<TextBlock Text=\"Cell\"/>";
+        }
+        xml += "</StackPanel>";
+    }
+    return xml + "</StackPanel>";
+}
+
+constexpr size_t kLargeViewControls = 100 * 100 + 1;
+
+// Times either the load or the unload (destruction) of the view; with `pooled` every
+// view gets its own AllocationContext, released together with the view
+void RunLargeView(bench::State& state, bool pooled, bool timeUnload) {
+    const std::string xml = MakeLargeView();
+    auto loader = xml::CreateXmlLoader();
+    state.SetItemsPerIteration(kLargeViewControls);
+
+    while (state.KeepRunning()) {
+        if (timeUnload) state.PauseTiming();
+        auto context = pooled ? std::make_shared<AllocationContext>() : nullptr;
+        loader->SetAllocationContext(context);
+        auto root = loader->LoadFromString(xml);
+        loader->SetAllocationContext(nullptr);
+        context.reset();
+        bench::DoNotOptimize(root.get());
+        if (timeUnload) state.ResumeTiming(); else state.PauseTiming();
+        root.reset();
+        if (!timeUnload) state.ResumeTiming();
+    }
+}
+
+} // anonymous namespace
+
+BENCHMARK(Xml_Load_SimpleButton) {
+    RunLoadFixture(state, "simple_button.xml");
+}
+
+BENCHMARK(Xml_Load_LoginForm) {
+    RunLoadFixture(state, "login_form.xml");
+}
+
+BENCHMARK(Xml_Load_Dashboard) {
+    RunLoadFixture(state, "dashboard.xml");
+}
+
+BENCHMARK(Xml_Load_MvvmBinding) {
+    RunLoadFixture(state, "mvvm_binding.xml");
+}
+
+BENCHMARK(Xml_Load_10kControls) {
+    RunLargeView(state, false, false);
+}
+
+BENCHMARK(Xml_Load_10kControls_Pooled) {
+    RunLargeView(state, true, false);
+}
+
+BENCHMARK(Xml_Unload_10kControls) {
+    RunLargeView(state, false, true);
+}
+
+BENCHMARK(Xml_Unload_10kControls_Pooled) {
+    RunLargeView(state, true, true);
+}
@@ -312,6 +312,26 @@ TEST(Image_SourcePath) {
     ASSERT_FALSE(image->IsLoaded());
 }
 
+TEST(Image_LoadAndUnloadInvalidate) {
+    auto image = std::make_shared<Image>();
+    auto* layout = image->AsLayoutable();
+    interfaces::LayoutConstraint constraint;
+    constraint.available = rendering::Size(100, 100);
+    
+    // 直接调用 LoadFromFile/Unload 也要重新测量并重绘，与 SetSourcePath 一致
+    layout->Measure(constraint);
+    image->GetRender()->ClearDirtyFlag();
+    image->LoadFromFile(L"C:/test/image.png");
+    ASSERT_FALSE(image->GetLayout()->IsMeasureValid());
+    ASSERT_TRUE(image->GetRender()->IsDirty());
+    
+    layout->Measure(constraint);
+    image->GetRender()->ClearDirtyFlag();
+    image->Unload();
+    ASSERT_FALSE(image->GetLayout()->IsMeasureValid());
+    ASSERT_TRUE(image->GetRender()->IsDirty());
+}
+
 // ==================== Multiple Instances Tests ====================
 TEST(Slider_MultipleInstances) {
     auto slider1 = std::make_shared<Slider>();
@@ -3,6 +3,16 @@
 #include "Button.h"
 #include "TextBlock.h"
 #include "CheckBox.h"
+#include "Panel.h"
+#include "SpatialIndex.h"
+#include "FrameProfiler.h"
+#include "software/SoftwareRenderTarget.h"
+#include "Components/InputComponent.h"
+#include "AllocationContext.h"
+#include "DrawingHost.h"
+#include "Menu.h"
+#include "Window.h"
+#include "layouts/ScrollViewer.h"
 
 using namespace luaui;
 using namespace luaui::controls;
@@ -108,6 +118,713 @@ TEST(CheckBox_MultipleInstances) {
     ASSERT_FALSE(check2->GetIsChecked());
 }
 
+// ==================== Panel Layer Cache Tests ====================
+TEST(Panel_LayerCacheMode) {
+    auto panel = std::make_shared<Panel>();
+    ASSERT_TRUE(panel->GetLayerCacheMode() == LayerCacheMode::None);
+    
+    panel->SetLayerCacheMode(LayerCacheMode::Auto);
+    ASSERT_TRUE(panel->GetLayerCacheMode() == LayerCacheMode::Auto);
+    
+    panel->SetLayerCacheMode(LayerCacheMode::Always);
+    ASSERT_TRUE(panel->GetLayerCacheMode() == LayerCacheMode::Always);
+}
+
+TEST(Panel_LayerInvalidatedByDescendant) {
+    auto panel = std::make_shared<Panel>();
+    auto inner = std::make_shared<Panel>();
+    auto button = std::make_shared<Button>();
+    panel->AddChild(inner);
+    inner->AddChild(button);
+    panel->SetLayerCacheMode(LayerCacheMode::Always);
+    
+    auto* layer = dynamic_cast<PanelRenderComponent*>(panel->GetRender());
+    ASSERT_TRUE(layer != nullptr);
+    
+    // 无窗口（无渲染引擎）时不会创建图层
+    ASSERT_FALSE(layer->HasValidLayer());
+    
+    // 深层后代失效会逐级通知祖先
+    button->GetRender()->Invalidate();
+    ASSERT_FALSE(layer->HasValidLayer());
+}
+
+// ==================== Spatial Index Tests ====================
+namespace {
+void SetRect(Control* control, float x, float y, float w, float h) {
+    control->GetRender()->GetRenderRect() = rendering::Rect(x, y, w, h);
+}
+}
+
+TEST(SpatialIndex_HitTestFollowsTreeOrder) {
+    auto root = std::make_shared<Panel>();
+    auto inner = std::make_shared<Panel>();
+    auto nested = std::make_shared<Button>();
+    auto overflow = std::make_shared<Button>();
+    auto top = std::make_shared<Button>();
+    auto hidden = std::make_shared<Button>();
+    root->AddChild(inner);
+    inner->AddChild(nested);
+    inner->AddChild(overflow);
+    root->AddChild(top);
+    root->AddChild(hidden);
+    hidden->SetIsVisible(false);
+    
+    SetRect(root.get(), 0, 0, 200, 200);
+    SetRect(inner.get(), 10, 10, 100, 100);     // 子控件坐标相对父控件
+    SetRect(nested.get(), 0, 0, 20, 20);        // 全局 (10,10)-(30,30)
+    SetRect(overflow.get(), 150, 0, 50, 50);    // 超出 inner，不可命中
+    SetRect(top.get(), 50, 50, 100, 100);       // 后添加，覆盖 inner 的右下部分
+    SetRect(hidden.get(), 0, 0, 200, 200);
+    
+    SpatialIndex index;
+    index.Build({root.get()});
+    ASSERT_EQ(4u, index.GetCount());
+    
+    ASSERT_TRUE(index.HitTest(15, 15) == nested.get());
+    ASSERT_TRUE(index.HitTest(40, 40) == inner.get());
+    ASSERT_TRUE(index.HitTest(60, 60) == top.get());
+    ASSERT_TRUE(index.HitTest(170, 20) == root.get());
+    ASSERT_TRUE(index.HitTest(250, 20) == nullptr);
+    
+    // 后面的图层（弹出层）在最上层
+    auto popup = std::make_shared<Button>();
+    SetRect(popup.get(), 0, 0, 40, 40);
+    index.Build({root.get(), popup.get()});
+    ASSERT_TRUE(index.HitTest(15, 15) == popup.get());
+    ASSERT_TRUE(index.HitTest(60, 60) == top.get());
+}
+
+TEST(SpatialIndex_UpdateRefreshesRelaidSubtree) {
+    auto root = std::make_shared<Panel>();
+    auto inner = std::make_shared<Panel>();
+    auto button = std::make_shared<Button>();
+    auto sibling = std::make_shared<Button>();
+    root->AddChild(inner);
+    inner->AddChild(button);
+    root->AddChild(sibling);
+    SetRect(root.get(), 0, 0, 400, 400);
+    SetRect(inner.get(), 100, 100, 200, 200);
+    SetRect(button.get(), 0, 0, 20, 20);        // 全局 (100,100)-(120,120)
+    SetRect(sibling.get(), 350, 0, 50, 50);
+    
+    SpatialIndex index;
+    index.Build({root.get()});
+    ASSERT_TRUE(index.HitTest(110, 110) == button.get());
+    
+    // 子树内移动：只刷新 inner 的条目
+    SetRect(button.get(), 150, 150, 20, 20);    // 全局 (250,250)-(270,270)
+    ASSERT_TRUE(index.Update(inner.get()));
+    ASSERT_TRUE(index.HitTest(110, 110) == inner.get());
+    ASSERT_TRUE(index.HitTest(260, 260) == button.get());
+    ASSERT_TRUE(index.HitTest(360, 10) == sibling.get());
+    
+    // 部分移出父控件：命中区域按父控件裁剪
+    SetRect(button.get(), 190, 190, 20, 20);
+    ASSERT_TRUE(index.Update(inner.get()));
+    ASSERT_TRUE(index.HitTest(295, 295) == button.get());
+    ASSERT_TRUE(index.HitTest(305, 305) == root.get());
+    
+    // 结构变化需要调用方重建
+    auto added = std::make_shared<Button>();
+    SetRect(added.get(), 0, 0, 10, 10);
+    inner->AddChild(added);
+    ASSERT_FALSE(index.Update(inner.get()));
+    ASSERT_FALSE(index.Update(std::make_shared<Panel>().get()));
+}
+
+TEST(SpatialIndex_ManyControls) {
+    auto root = std::make_shared<Panel>();
+    SetRect(root.get(), 0, 0, 2000, 1000);
+    std::vector<std::shared_ptr<Button>> cells;
+    for (int row = 0; row < 100; ++row) {
+        for (int col = 0; col < 200; ++col) {
+            auto cell = std::make_shared<Button>();
+            SetRect(cell.get(), col * 10.0f, row * 10.0f, 10, 10);
+            root->AddChild(cell);
+            cells.push_back(cell);
+        }
+    }
+    
+    SpatialIndex index;
+    index.Build({root.get()});
+    ASSERT_EQ(20001u, index.GetCount());
+    ASSERT_TRUE(index.HitTest(0, 0) == cells[0].get());
+    ASSERT_TRUE(index.HitTest(1234.5f, 567.5f) == cells[56 * 200 + 123].get());
+    ASSERT_TRUE(index.HitTest(1999.5f, 999.5f) == cells.back().get());
+}
+
+// ==================== Clip Culling Tests ====================
+TEST(Panel_CullsChildrenOutsideClip) {
+    auto panel = std::make_shared<Panel>();
+    SetRect(panel.get(), 0, 0, 100, 1000);
+    for (int i = 0; i < 100; ++i) {
+        auto row = std::make_shared<Panel>();
+        SetRect(row.get(), 0, i * 10.0f, 100, 10);
+        panel->AddChild(row);
+    }
+    
+    rendering::SoftwareRenderTarget target(100, 100, false);
+    auto* context = target.GetContext();
+    target.BeginDraw();
+    context->PushClip(rendering::Rect(0, 0, 100, 45));
+    
+    auto& counters = components::RenderComponent::GetFrameCounters();
+    counters = components::RenderComponent::FrameCounters();
+    panel->GetRender()->Render(context);
+    
+    ASSERT_EQ(1 + 5, counters.drawn);     // 面板 + 与裁剪区域相交的 5 行
+    ASSERT_EQ(95, counters.culled);
+    
+    context->PopClip();
+    target.EndDraw();
+}
+
+TEST(Panel_DrawsChildWhenClipCoversOnlyInkOverflow) {
+    auto panel = std::make_shared<Panel>();
+    auto child = std::make_shared<Panel>();
+    SetRect(panel.get(), 0, 0, 100, 100);
+    SetRect(child.get(), 10, 10, 50, 50);
+    child->GetRender()->SetInkOverflow(rendering::Thickness(0, 0, 4, 4));   // 右下阴影到 (64,64)
+    panel->AddChild(child);
+    
+    rendering::SoftwareRenderTarget target(100, 100, false);
+    auto* context = target.GetContext();
+    target.BeginDraw();
+    context->PushClip(rendering::Rect(61, 20, 3, 20));   // 只与阴影带相交
+    
+    auto& counters = components::RenderComponent::GetFrameCounters();
+    counters = components::RenderComponent::FrameCounters();
+    panel->GetRender()->Render(context);
+    
+    ASSERT_EQ(2, counters.drawn);
+    ASSERT_EQ(0, counters.culled);
+    
+    context->PopClip();
+    target.EndDraw();
+}
+
+// ==================== Damage Tracking Tests ====================
+TEST(Damage_InvalidateReportsOnlyControlBounds) {
+    Window window;
+    auto root = std::make_shared<Panel>();
+    auto button = std::make_shared<Button>();
+    root->AddChild(button);
+    root->SetWindow(&window);
+    SetRect(root.get(), 10, 20, 200, 200);
+    SetRect(button.get(), 30, 40, 50, 25);
+    
+    button->GetRender()->Invalidate();
+    const auto& bounds = window.GetDirtyRegion().GetBounds();
+    ASSERT_EQ(40.0f, bounds.x);           // 累加父控件偏移后的全局位置
+    ASSERT_EQ(60.0f, bounds.y);
+    ASSERT_EQ(50.0f, bounds.width);
+    ASSERT_EQ(25.0f, bounds.height);
+    ASSERT_FALSE(window.NeedsRedraw(rendering::Rect(150, 150, 10, 10)));
+}
+
+TEST(Damage_NoOpRelayoutRendersNoDirtyRects) {
+    Window window;
+    ASSERT_TRUE(window.CreateHeadless(200, 200));
+    auto root = std::make_shared<Panel>();
+    auto button = std::make_shared<Button>();
+    button->GetLayout()->SetWidth(50);
+    button->GetLayout()->SetHeight(25);
+    root->AddChild(button);
+    window.SetRoot(root);
+    
+    window.GetFrameScheduler().RunFrame();
+    ASSERT_TRUE(window.GetFrameStats().dirtyRectCount > 0);    // 首帧整窗绘制
+    
+    // 重新布局但没有控件移动：不产生损坏，也不绘制
+    window.InvalidateLayout();
+    window.GetFrameScheduler().RunFrame();
+    ASSERT_EQ(0, window.GetFrameStats().dirtyRectCount);
+    ASSERT_EQ(0, window.GetFrameStats().controlsDrawn);
+    
+    // 尺寸变化仍然整窗重绘
+    window.Resize(300, 200);
+    window.GetFrameScheduler().RunFrame();
+    ASSERT_TRUE(window.GetFrameStats().dirtyRectCount > 0);
+}
+
+TEST(Panel_AutoLayerCountsFramesNotDirtyRects) {
+    Window window;
+    ASSERT_TRUE(window.CreateHeadless(600, 600));
+    auto root = std::make_shared<Panel>();
+    for (int i = 0; i < 8; ++i) {
+        root->AddChild(std::make_shared<Button>());
+    }
+    root->SetLayerCacheMode(LayerCacheMode::Auto);
+    window.SetRoot(root);
+    auto* layer = dynamic_cast<PanelRenderComponent*>(root->GetRender());
+    ASSERT_TRUE(layer != nullptr);
+    
+    window.GetFrameScheduler().RunFrame();
+    
+    // 一帧内多个互不相邻的脏矩形：面板被渲染多次，但只算一帧
+    window.InvalidateRect(rendering::Rect(0, 0, 10, 10));
+    window.InvalidateRect(rendering::Rect(580, 0, 10, 10));
+    window.InvalidateRect(rendering::Rect(0, 580, 10, 10));
+    window.InvalidateRect(rendering::Rect(580, 580, 10, 10));
+    window.GetFrameScheduler().RunFrame();
+    ASSERT_TRUE(window.GetFrameStats().dirtyRectCount >= 3);
+    ASSERT_FALSE(layer->HasValidLayer());
+    
+    // 连续稳定足够帧后才提升为图层
+    for (int i = 0; i < PanelRenderComponent::kAutoLayerCleanFrames; ++i) {
+        window.InvalidateRect(rendering::Rect(0, 0, 10, 10));
+        window.GetFrameScheduler().RunFrame();
+    }
+    ASSERT_TRUE(layer->HasValidLayer());
+}
+
+TEST(Damage_IncludesInkOverflowOfPopupShadow) {
+    Window window;
+    auto menu = std::make_shared<Menu>();
+    menu->SetWindow(&window);
+    SetRect(menu.get(), 100, 100, 80, 60);
+    
+    menu->GetRender()->Invalidate();
+    const auto& bounds = window.GetDirtyRegion().GetBounds();
+    ASSERT_EQ(100.0f, bounds.x);
+    ASSERT_EQ(184.0f, bounds.Right());    // 右下角阴影画在渲染矩形之外
+    ASSERT_EQ(164.0f, bounds.Bottom());
+}
+
+namespace {
+class TestableScrollViewer : public ScrollViewer {
+public:
+    using ScrollViewer::OnMouseMove;
+};
+}
+
+TEST(ScrollViewer_HoverDrivesScrollBarToFinalWidth) {
+    Window window;
+    auto viewer = std::make_shared<TestableScrollViewer>();
+    auto content = std::make_shared<Panel>();
+    content->GetLayout()->SetHeight(1000);
+    viewer->AddChild(content);
+    viewer->SetWindow(&window);
+    
+    auto* layout = viewer->AsLayoutable();
+    interfaces::LayoutConstraint constraint;
+    constraint.available = rendering::Size(100, 100);
+    layout->Measure(constraint);
+    layout->Arrange(rendering::Rect(0, 0, 100, 100));
+    float collapsed = viewer->GetScrollBarWidth();
+    
+    // 鼠标移到滚动条轨道上：只产生一次失效
+    MouseEventArgs move;
+    move.x = 94;
+    move.y = 50;
+    viewer->OnMouseMove(move);
+    
+    // 只要上一帧又请求了重绘就继续绘制下一帧，直到宽度过渡结束
+    rendering::SoftwareRenderTarget target(100, 100, false);
+    const auto& stats = window.GetFrameScheduler().GetStats();
+    int frames = 0;
+    uint64_t requests = 0;
+    do {
+        requests = stats.requests;
+        target.BeginDraw();
+        viewer->GetRender()->Render(target.GetContext());
+        target.EndDraw();
+        ++frames;
+    } while (stats.requests != requests && frames < 60);
+    
+    ASSERT_TRUE(frames > 1);
+    ASSERT_TRUE(frames < 60);
+    ASSERT_TRUE(viewer->GetScrollBarWidth() > collapsed);
+    ASSERT_EQ(12.0f, viewer->GetScrollBarWidth());
+}
+
+// ==================== Drawing Primitive Tests ====================
+TEST(DrawingGroup_HitTestQueryAndStyles) {
+    rendering::DrawingGroup group;
+    auto red = group.AddFillStyle(rendering::Color::Red());
+    auto blue = group.AddFillStyle(rendering::Color::Blue());
+    ASSERT_EQ(red, group.AddFillStyle(rendering::Color::Red()));   // styles are deduplicated
+    ASSERT_TRUE(red != blue);
+    
+    // 100 x 100 cells of 10 x 10, then an ellipse and a thin line on top
+    std::vector<rendering::Rect> rects;
+    for (int row = 0; row < 100; ++row) {
+        for (int col = 0; col < 100; ++col) {
+            rects.emplace_back(col * 10.0f, row * 10.0f, 10.0f, 10.0f);
+        }
+    }
+    std::vector<rendering::DrawingGroup::PrimitiveId> ids(rects.size());
+    group.AddRectangles(rects.data(), rects.size(), red, ids.data());
+    auto ellipse = group.AddEllipse(rendering::Rect(0, 0, 40, 40), blue);
+    auto line = group.AddLine(rendering::Point(0, 500), rendering::Point(1000, 500),
+                              group.AddStrokeStyle(rendering::Color::Black(), 1.0f));
+    ASSERT_EQ((size_t)10002, group.GetCount());
+    
+    ASSERT_EQ(ellipse, group.HitTest(rendering::Point(20, 20)));
+    ASSERT_EQ(ids[0], group.HitTest(rendering::Point(1, 1)));          // outside the ellipse curve
+    ASSERT_EQ(ids[33 * 100 + 55], group.HitTest(rendering::Point(555, 333)));
+    ASSERT_EQ(line, group.HitTest(rendering::Point(300, 501)));        // within the hit tolerance
+    ASSERT_EQ(rendering::DrawingGroup::kInvalidId, group.HitTest(rendering::Point(2000, 2000)));
+    
+    std::vector<rendering::DrawingGroup::PrimitiveId> found;
+    group.Query(rendering::Rect(101, 101, 13, 13), found);
+    ASSERT_EQ((size_t)4, found.size());
+    ASSERT_EQ(ids[10 * 100 + 10], found[0]);                           // draw order
+    ASSERT_EQ(ids[11 * 100 + 11], found[3]);
+    
+    group.SetVisible(ellipse, false);
+    ASSERT_EQ(ids[2 * 100 + 2], group.HitTest(rendering::Point(20, 20)));
+    
+    // Removed slots are reused by the next primitive
+    group.Remove(ids[0]);
+    ASSERT_FALSE(group.IsAlive(ids[0]));
+    ASSERT_EQ(rendering::DrawingGroup::kInvalidId, group.HitTest(rendering::Point(1, 1)));
+    ASSERT_EQ(ids[0], group.AddRectangle(rendering::Rect(0, 0, 10, 10), blue));
+    
+    // A primitive moved outside the indexed extent is still found (kept in an edge cell)
+    group.SetBounds(ids[1], rendering::Rect(2000, 2000, 10, 10));
+    ASSERT_EQ(ids[1], group.HitTest(rendering::Point(2005, 2005)));
+    ASSERT_EQ(ids[2], group.HitTest(rendering::Point(25, 5)));
+}
+
+TEST(DrawingGroup_BulkUpdatesNotifyOnce) {
+    rendering::DrawingGroup group;
+    int notifications = 0;
+    rendering::Rect damage;
+    group.SetChangedHandler([&](const rendering::Rect& rect) {
+        ++notifications;
+        damage = rect;
+    });
+    
+    auto fill = group.AddFillStyle(rendering::Color::Green());
+    std::vector<rendering::Rect> rects;
+    for (int i = 0; i < 1000; ++i) rects.emplace_back(i * 2.0f, 0.0f, 2.0f, 2.0f);
+    std::vector<rendering::DrawingGroup::PrimitiveId> ids(rects.size());
+    group.AddRectangles(rects.data(), rects.size(), fill, ids.data());
+    ASSERT_EQ(1, notifications);
+    
+    group.Offset(ids.data(), 10, 0, 100);
+    ASSERT_EQ(2, notifications);
+    ASSERT_EQ(0.0f, damage.y);            // old and new positions
+    ASSERT_EQ(102.0f, damage.Bottom());
+    ASSERT_EQ(20.0f, damage.Right());     // only the moved primitives
+    
+    {
+        rendering::DrawingGroup::UpdateScope update(group);
+        for (int i = 0; i < 10; ++i) group.SetBounds(ids[i], rendering::Rect(i * 2.0f, 0.0f, 2.0f, 2.0f));
+        group.Remove(ids[999]);
+        ASSERT_EQ(2, notifications);
+    }
+    ASSERT_EQ(3, notifications);
+    ASSERT_EQ(2000.0f, damage.Right());
+    
+    group.SetStyle(ids.data(), 10, fill);  // unchanged
+    ASSERT_EQ(3, notifications);
+}
+
+TEST(DrawingHost_RendersOnlyPrimitivesInClip) {
+    auto host = std::make_shared<DrawingHost>();
+    SetRect(host.get(), 0, 0, 100, 1000);
+    auto& drawing = host->GetDrawing();
+    auto fill = drawing.AddFillStyle(rendering::Color::Red());
+    for (int i = 0; i < 100; ++i) {
+        drawing.AddRectangle(rendering::Rect(0, i * 10.0f, 100, 10), fill);
+    }
+    
+    rendering::SoftwareRenderTarget target(100, 100, false);
+    auto* context = target.GetContext();
+    target.BeginDraw();
+    auto before = target.GetSurface().GetPixel(50, 20);
+    context->PushClip(rendering::Rect(0, 0, 100, 45));
+    host->GetRender()->Render(context);
+    context->PopClip();
+    target.EndDraw();
+    
+    const auto& stats = host->GetLastRenderStats();
+    ASSERT_EQ((size_t)5, stats.drawn);    // rows intersecting the clip
+    ASSERT_EQ((size_t)95, stats.culled);
+    ASSERT_EQ((size_t)1, stats.calls);    // same-style rectangles go out as one FillRectangles
+    ASSERT_TRUE(target.GetSurface().GetPixel(50, 20) != before);
+    ASSERT_EQ(rendering::DrawingGroup::kInvalidId, host->HitTestPrimitive(rendering::Point(50, 2000)));
+}
+
+TEST(DrawingHost_PartialDamageFollowsAncestorTransform) {
+    auto host = std::make_shared<DrawingHost>();
+    SetRect(host.get(), 10, 20, 100, 100);
+    auto& drawing = host->GetDrawing();
+    auto fill = drawing.AddFillStyle(rendering::Color::Red());
+    auto first = drawing.AddRectangle(rendering::Rect(0, 0, 10, 10), fill);
+    drawing.AddRectangle(rendering::Rect(50, 50, 10, 10), fill);
+    
+    // 祖先以 2 倍缩放绘制：控件实际位于窗口 (20,40)-(220,240)
+    rendering::SoftwareRenderTarget target(300, 300, false);
+    target.BeginDraw();
+    target.GetContext()->SetTransform(rendering::Transform::Scale(2.0f, 2.0f));
+    host->GetRender()->Render(target.GetContext());
+    target.EndDraw();
+    
+    Window window;
+    host->SetWindow(&window);
+    drawing.SetBounds(first, rendering::Rect(0, 0, 10, 5));
+    const auto& bounds = window.GetDirtyRegion().GetBounds();
+    ASSERT_EQ(20.0f, bounds.x);           // 只有变化的图元，按上次绘制的变换映射
+    ASSERT_EQ(40.0f, bounds.y);
+    ASSERT_EQ(20.0f, bounds.width);
+    ASSERT_EQ(20.0f, bounds.height);
+}
+
+TEST(DrawingHost_RemeasuresWhenContentShrinks) {
+    auto host = std::make_shared<DrawingHost>();
+    auto& drawing = host->GetDrawing();
+    auto fill = drawing.AddFillStyle(rendering::Color::Red());
+    drawing.AddRectangle(rendering::Rect(0, 0, 50, 40), fill);
+    auto far = drawing.AddRectangle(rendering::Rect(100, 80, 100, 20), fill);
+    
+    auto* layout = host->AsLayoutable();
+    interfaces::LayoutConstraint constraint;
+    constraint.available = rendering::Size(1000, 1000);
+    layout->Measure(constraint);
+    ASSERT_EQ(200.0f, layout->GetDesiredSize().width);
+    ASSERT_EQ(100.0f, layout->GetDesiredSize().height);
+    
+    // 移除最远的图元：内容范围缩小，需要重新测量
+    drawing.Remove(far);
+    ASSERT_FALSE(host->GetLayout()->IsMeasureValid());
+    layout->Measure(constraint);
+    ASSERT_EQ(50.0f, layout->GetDesiredSize().width);
+    ASSERT_EQ(40.0f, layout->GetDesiredSize().height);
+    
+    // 范围内的变化不影响测量；固定了尺寸的方向不跟随内容
+    drawing.AddRectangle(rendering::Rect(10, 10, 5, 5), fill);
+    ASSERT_TRUE(host->GetLayout()->IsMeasureValid());
+    host->GetLayout()->SetWidth(300);
+    layout->Measure(constraint);
+    drawing.AddRectangle(rendering::Rect(0, 0, 400, 40), fill);
+    ASSERT_TRUE(host->GetLayout()->IsMeasureValid());
+}
+
+// ==================== Frame Profiler Tests ====================
+TEST(FrameProfiler_RecordsControlCostsAndThrash) {
+    auto panel = std::make_shared<Panel>();
+    std::vector<std::shared_ptr<Button>> buttons;
+    for (int i = 0; i < 3; ++i) {
+        buttons.push_back(std::make_shared<Button>());
+        panel->AddChild(buttons.back());
+    }
+    
+    FrameProfiler profiler(4);
+    profiler.SetEnabled(true);
+    profiler.SetThrashThreshold(2);
+    
+    rendering::SoftwareRenderTarget target(100, 100, false);
+    target.BeginDraw();
+    profiler.BeginFrame();
+    ASSERT_TRUE(FrameProfiler::GetActive() == &profiler);
+    
+    auto* layout = panel->AsLayoutable();
+    interfaces::LayoutConstraint constraint;
+    constraint.available = rendering::Size(200, 100);
+    layout->Measure(constraint);
+    layout->Measure(constraint);                          // 命中缓存，不计次数
+    constraint.available = rendering::Size(100, 100);
+    layout->Measure(constraint);                          // 可用尺寸变化，重新测量
+    layout->Arrange(rendering::Rect(0, 0, 100, 100));
+    {
+        FrameProfiler::PhaseScope phase(ProfilePhase::Render);
+        panel->GetRender()->Render(target.GetContext());
+    }
+    profiler.EndFrame();
+    ASSERT_TRUE(FrameProfiler::GetActive() == nullptr);
+    
+    const auto* frame = profiler.GetFrame();
+    ASSERT_TRUE(frame != nullptr);
+    ASSERT_EQ(4u, frame->controls.size());
+    const auto& entry = frame->controls[0];
+    ASSERT_TRUE(entry.control == panel.get());
+    ASSERT_EQ(2, entry.GetCount(ProfileCost::Measure));
+    ASSERT_EQ(1, entry.GetCount(ProfileCost::Arrange));
+    ASSERT_EQ(1, entry.GetCount(ProfileCost::Render));
+    ASSERT_FALSE(entry.bounds.IsEmpty());
+    ASSERT_TRUE(frame->GetPhaseMs(ProfilePhase::Render) > 0);
+    ASSERT_EQ(frame->thrashCount, static_cast<int>(profiler.GetThrashingControls(*frame).size()));
+    ASSERT_TRUE(frame->thrashCount >= 1);
+    
+    // 调试叠加层：左下角绘制历史柱状图
+    auto before = target.GetSurface().GetPixel(6, 90);
+    profiler.DrawOverlay(target.GetContext(), 100, 100);
+    target.EndDraw();
+    ASSERT_TRUE(target.GetSurface().GetPixel(6, 90) != before);
+    
+    // 环形缓冲区只保留最近 4 帧
+    for (int i = 0; i < 5; ++i) {
+        profiler.BeginFrame();
+        profiler.EndFrame();
+    }
+    ASSERT_EQ(4u, profiler.GetFrameCount());
+    ASSERT_EQ(5u, profiler.GetFrame()->frameIndex);
+    ASSERT_TRUE(profiler.GetFrame()->controls.empty());
+    ASSERT_TRUE(profiler.GetFrame(4) == nullptr);
+    
+    // 未启用时不进入帧
+    profiler.SetEnabled(false);
+    profiler.BeginFrame();
+    ASSERT_FALSE(profiler.IsInFrame());
+    ASSERT_TRUE(FrameProfiler::GetActive() == nullptr);
+}
+
+// ==================== Component Storage Tests ====================
+namespace {
+
+struct ComponentCounters {
+    int initialized = 0;
+    int shutdown = 0;
+    int destroyed = 0;
+};
+
+// Custom (non-standard) component, stored in the overflow table
+class TagComponent : public components::Component {
+public:
+    TagComponent(Control* owner, ComponentCounters* counters) : Component(owner), m_counters(counters) {}
+    ~TagComponent() override { ++m_counters->destroyed; }
+    void Initialize() override { ++m_counters->initialized; }
+    void Shutdown() override { ++m_counters->shutdown; }
+
+private:
+    ComponentCounters* m_counters;
+};
+
+// Input component counting its own destruction, to observe slot replacement
+class TrackedInputComponent : public components::InputComponent {
+public:
+    TrackedInputComponent(Control* owner, ComponentCounters* counters) : InputComponent(owner), m_counters(counters) {}
+    ~TrackedInputComponent() override { ++m_counters->destroyed; }
+
+private:
+    ComponentCounters* m_counters;
+};
+
+bool IsInside(const void* ptr, const void* object, size_t size) {
+    auto* p = static_cast<const char*>(ptr);
+    auto* begin = static_cast<const char*>(object);
+    return p >= begin && p < begin + size;
+}
+
+} // anonymous namespace
+
+TEST(ComponentHolder_StandardComponentsLiveInsideControl) {
+    auto panel = std::make_shared<Panel>();
+    auto* layout = panel->GetLayout();
+    auto* render = panel->GetRender();
+    ASSERT_TRUE(layout != nullptr);
+    ASSERT_TRUE(render != nullptr);
+    
+    // Derived components share the base slot and are reachable through both types
+    auto& holder = panel->GetComponents();
+    ASSERT_TRUE(holder.GetComponent<PanelLayoutComponent>() == layout);
+    ASSERT_TRUE(holder.GetComponent<components::LayoutComponent>() == layout);
+    ASSERT_TRUE(holder.GetComponent<PanelRenderComponent>() == render);
+    ASSERT_TRUE(holder.GetComponent<components::InputComponent>() == nullptr);
+    
+    // No separate allocation: the components sit in the control's own storage
+    ASSERT_TRUE(IsInside(layout, panel.get(), sizeof(Panel)));
+    ASSERT_TRUE(IsInside(render, panel.get(), sizeof(Panel)));
+    
+    // A plain TextBlock has a base LayoutComponent, which is not a PanelLayoutComponent
+    auto text = std::make_shared<TextBlock>();
+    ASSERT_TRUE(text->GetLayout() != nullptr);
+    ASSERT_TRUE(text->GetComponents().GetComponent<PanelLayoutComponent>() == nullptr);
+}
+
+TEST(ComponentHolder_CustomComponentsAndReplacement) {
+    ComponentCounters tag;
+    ComponentCounters input;
+    {
+        auto button = std::make_shared<Button>();
+        button->EnsureInitialized();
+        auto& holder = button->GetComponents();
+        ASSERT_FALSE(holder.HasComponent<TagComponent>());
+        
+        auto* custom = holder.AddComponent<TagComponent>(button.get(), &tag);
+        ASSERT_TRUE(holder.GetComponent<TagComponent>() == custom);
+        
+        // Replacing a standard component destroys the previous one in place
+        holder.AddComponent<TrackedInputComponent>(button.get(), &input);
+        auto* replacement = holder.AddComponent<TrackedInputComponent>(button.get(), &input);
+        ASSERT_EQ(1, input.destroyed);
+        ASSERT_TRUE(button->GetInput() == replacement);
+        
+        size_t count = 0;
+        holder.ForEachComponent([&](components::Component*) { ++count; });
+        ASSERT_EQ((size_t)4, count);   // layout, render, input, tag
+        
+        holder.InitializeAll();
+        ASSERT_EQ(1, tag.initialized);
+    }
+    ASSERT_EQ(1, tag.shutdown);
+    ASSERT_EQ(1, tag.destroyed);
+    ASSERT_EQ(2, input.destroyed);
+}
+
+// ==================== Allocation Context Tests ====================
+TEST(AllocationContext_PoolsControlsAndReusesFreedBlocks) {
+    AllocationContext context;
+    std::vector<std::shared_ptr<Button>> buttons;
+    {
+        AllocationContext::Scope scope(&context);
+        for (int i = 0; i < 100; ++i) buttons.push_back(MakeControl<Button>());
+    }
+    
+    auto stats = context.GetStats();
+    ASSERT_EQ((size_t)100, stats.allocations);
+    ASSERT_EQ((size_t)100, stats.liveAllocations);
+    ASSERT_TRUE(stats.chunkCount >= 1);
+    ASSERT_TRUE(stats.reservedBytes >= stats.liveBytes);
+    
+    // Components are inline, so a button is a single pooled block
+    buttons[0]->EnsureInitialized();
+    ASSERT_EQ((size_t)100, context.GetStats().allocations);
+    
+    buttons.clear();
+    stats = context.GetStats();
+    ASSERT_EQ((size_t)0, stats.liveAllocations);
+    ASSERT_EQ((size_t)0, stats.liveBytes);
+    
+    // A second view of the same shape reuses the freed blocks without new chunks
+    size_t chunks = stats.chunkCount;
+    {
+        AllocationContext::Scope scope(&context);
+        for (int i = 0; i < 100; ++i) buttons.push_back(MakeControl<Button>());
+    }
+    stats = context.GetStats();
+    ASSERT_EQ((size_t)100, stats.reusedAllocations);
+    ASSERT_EQ(chunks, stats.chunkCount);
+}
+
+TEST(AllocationContext_ScopesAndLifetime) {
+    ASSERT_TRUE(AllocationContext::GetCurrent() == nullptr);
+    
+    auto context = std::make_unique<AllocationContext>();
+    std::shared_ptr<Panel> panel;
+    {
+        AllocationContext::Scope outer(context.get());
+        // A null scope keeps the enclosing context
+        AllocationContext::Scope inner(nullptr);
+        ASSERT_TRUE(AllocationContext::GetCurrent() == context.get());
+        panel = MakeControl<Panel>();
+    }
+    ASSERT_TRUE(AllocationContext::GetCurrent() == nullptr);
+    ASSERT_EQ((size_t)1, context->GetStats().liveAllocations);
+    
+    // Controls keep the pool alive after the context itself is gone
+    context.reset();
+    panel->AddChild(MakeControl<Button>());   // no context: plain heap allocation
+    panel->SetName("still valid");
+    ASSERT_TRUE(panel->GetLayout() != nullptr);
+    ASSERT_EQ((size_t)1, panel->GetChildCount());
+    panel.reset();
+}
+
 // ==================== Performance Tests ====================
 TEST(Control_CreateManyButtons) {
     const int count = 1000;
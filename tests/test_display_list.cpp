@@ -0,0 +1,283 @@
+// Rendering Module - DisplayList record/replay tests (software backend)
+#include "TestFramework.h"
+#include "DisplayList.h"
+#include "software/SoftwareRenderTarget.h"
+
+using namespace luaui::rendering;
+
+namespace {
+
+std::unique_ptr<SoftwareRenderTarget> MakeTarget() {
+    auto target = std::make_unique<SoftwareRenderTarget>(32, 32, true);
+    target->BeginDraw();
+    target->Clear(Color::Transparent());
+    return target;
+}
+
+bool SamePixels(const SoftwareSurface& a, const SoftwareSurface& b) {
+    if (a.GetWidth() != b.GetWidth() || a.GetHeight() != b.GetHeight()) return false;
+    for (int y = 0; y < a.GetHeight(); ++y)
+        for (int x = 0; x < a.GetWidth(); ++x)
+            if (a.GetPixel(x, y) != b.GetPixel(x, y)) return false;
+    return true;
+}
+
+// Typical OnRender: brushes/formats created per call and dropped afterwards
+void DrawSample(IRenderContext* ctx) {
+    auto fill = ctx->CreateSolidColorBrush(Color::Blue());
+    auto stroke = ctx->CreateSolidColorBrush(Color::Red());
+    ctx->FillRoundedRectangle(Rect(2, 2, 20, 12), CornerRadius(3), fill.get());
+    ctx->DrawLine(Point(0, 20), Point(30, 28), stroke.get(), 2.0f);
+    ctx->PushState();
+    ctx->MultiplyTransform(Transform::Translation(4, 0));
+    ctx->FillEllipse(Point(16, 24), 4, 4, fill.get());
+    ctx->PopState();
+    auto format = ctx->CreateTextFormat(L"Segoe UI", 8.0f);
+    ctx->DrawTextString(L"ab", format.get(), Point(2, 2), stroke.get());
+}
+
+} // anonymous namespace
+
+TEST(DisplayList_ReplayMatchesDirectDraw) {
+    auto direct = MakeTarget();
+    DrawSample(direct->GetContext());
+    direct->EndDraw();
+
+    DisplayList list;
+    auto recorded = MakeTarget();
+    {
+        RecordingRenderContext recorder(recorded->GetContext(), &list);
+        DrawSample(&recorder);
+        ASSERT_TRUE(recorder.IsCacheable());
+    }
+    recorded->EndDraw();
+    ASSERT_TRUE(SamePixels(direct->GetSurface(), recorded->GetSurface()));   // draws while recording
+    ASSERT_EQ(7u, list.GetCommandCount());
+
+    // Brushes created during recording are owned by the list and outlive OnRender
+    auto replayed = MakeTarget();
+    list.Replay(replayed->GetContext());
+    replayed->EndDraw();
+    ASSERT_TRUE(SamePixels(direct->GetSurface(), replayed->GetSurface()));
+}
+
+TEST(DisplayList_ReplayFollowsCurrentTransform) {
+    DisplayList list;
+    auto recorded = MakeTarget();
+    {
+        RecordingRenderContext recorder(recorded->GetContext(), &list);
+        auto brush = recorder.CreateSolidColorBrush(Color::White());
+        recorder.SetTransform(Transform::Translation(2, 2));   // absolute, relative to recording base
+        recorder.FillRectangle(Rect(0, 0, 4, 4), brush.get());
+    }
+
+    auto replayed = MakeTarget();
+    auto* ctx = replayed->GetContext();
+    ctx->SetTransform(Transform::Translation(10, 10));
+    list.Replay(ctx);
+    replayed->EndDraw();
+
+    const auto& s = replayed->GetSurface();
+    ASSERT_EQ(0xFFFFFFFFu, s.GetPixel(12, 12));
+    ASSERT_EQ(0u, s.GetPixel(2, 2));
+}
+
+TEST(DisplayList_ExternalSolidBrushIsCopied) {
+    auto target = MakeTarget();
+    DisplayList list;
+    {
+        auto external = target->GetContext()->CreateSolidColorBrush(Color::Green());
+        RecordingRenderContext recorder(target->GetContext(), &list);
+        recorder.FillRectangle(Rect(0, 0, 8, 8), external.get());
+    }   // external brush released here
+
+    auto replayed = MakeTarget();
+    list.Replay(replayed->GetContext());
+    replayed->EndDraw();
+    ASSERT_EQ(0xFF00FF00u, replayed->GetSurface().GetPixel(4, 4));
+}
+
+TEST(DisplayList_ExternalGeometryIsCopied) {
+    auto target = MakeTarget();
+    DisplayList list;
+    {
+        auto* ctx = target->GetContext();
+        auto geometry = ctx->CreateRectangleGeometry(Rect(0, 0, 8, 8));
+        auto brush = ctx->CreateSolidColorBrush(Color::Green());
+        RecordingRenderContext recorder(ctx, &list);
+        recorder.FillGeometry(*geometry, brush.get());
+        ASSERT_TRUE(recorder.IsCacheable());
+    }   // external geometry released here
+
+    auto replayed = MakeTarget();
+    list.Replay(replayed->GetContext());
+    replayed->EndDraw();
+    ASSERT_EQ(0xFF00FF00u, replayed->GetSurface().GetPixel(4, 4));
+}
+
+TEST(DisplayList_UncopyableExternalResourceIsNotCacheable) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    auto solid = ctx->CreateSolidColorBrush(Color::Green());
+
+    // Bitmaps, gradient brushes and path geometries are only referenced by pointer
+    auto bitmap = ctx->CreateBitmap(4, 4, PixelFormat::BGRA8);
+    ASSERT_TRUE(bitmap != nullptr);
+    DisplayList bitmapList;
+    RecordingRenderContext bitmapRecorder(ctx, &bitmapList);
+    bitmapRecorder.DrawBitmap(bitmap.get(), Point(0, 0));
+    ASSERT_FALSE(bitmapRecorder.IsCacheable());
+
+    auto gradient = ctx->CreateLinearGradientBrush(Point(0, 0), Point(8, 0),
+        { GradientStop(Color::Red(), 0.0f), GradientStop(Color::Blue(), 1.0f) });
+    DisplayList gradientList;
+    RecordingRenderContext gradientRecorder(ctx, &gradientList);
+    gradientRecorder.FillRectangle(Rect(0, 0, 8, 8), gradient.get());
+    ASSERT_FALSE(gradientRecorder.IsCacheable());
+
+    auto path = ctx->CreatePathGeometry();
+    path->BeginFigure(Point(0, 0));
+    path->AddLine(Point(8, 0));
+    path->AddLine(Point(0, 8));
+    path->EndFigure();
+    DisplayList pathList;
+    RecordingRenderContext pathRecorder(ctx, &pathList);
+    pathRecorder.FillGeometry(*path, solid.get());
+    ASSERT_FALSE(pathRecorder.IsCacheable());
+
+    // Created through the recorder: owned by the list, still cacheable
+    DisplayList ownedList;
+    RecordingRenderContext ownedRecorder(ctx, &ownedList);
+    auto ownedBitmap = ownedRecorder.CreateBitmap(4, 4, PixelFormat::BGRA8);
+    ownedRecorder.DrawBitmap(ownedBitmap.get(), Point(0, 0));
+    auto ownedGradient = ownedRecorder.CreateLinearGradientBrush(Point(0, 0), Point(8, 0),
+        { GradientStop(Color::Red(), 0.0f), GradientStop(Color::Blue(), 1.0f) });
+    ownedRecorder.FillRectangle(Rect(0, 0, 8, 8), ownedGradient.get());
+    ASSERT_TRUE(ownedRecorder.IsCacheable());
+}
+
+TEST(DisplayList_ClipQueryIsNotCacheable) {
+    auto target = MakeTarget();
+    DisplayList list;
+    RecordingRenderContext recorder(target->GetContext(), &list);
+    ASSERT_TRUE(recorder.IsCacheable());
+    recorder.GetClipBounds();
+    ASSERT_FALSE(recorder.IsCacheable());
+}
+
+TEST(DisplayList_Clear) {
+    auto target = MakeTarget();
+    DisplayList list;
+    {
+        RecordingRenderContext recorder(target->GetContext(), &list);
+        recorder.PushClip(Rect(0, 0, 8, 8));
+        recorder.PopClip();
+    }
+    ASSERT_EQ(2u, list.GetCommandCount());
+    ASSERT_TRUE(list.GetByteSize() > 0);
+    list.Clear();
+    ASSERT_TRUE(list.IsEmpty());
+    ASSERT_EQ(0u, list.GetByteSize());
+}
+
+namespace {
+
+// Table-like OnRender: a fresh brush per call, alternating colors, no overlap between cells
+void DrawTable(IRenderContext* ctx) {
+    for (int row = 0; row < 4; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            auto fill = ctx->CreateSolidColorBrush((row + col) % 2 ? Color::Blue() : Color::Green());
+            ctx->FillRectangle(Rect(col * 8.0f, row * 8.0f, 6, 6), fill.get());
+        }
+    }
+    for (int row = 0; row < 4; ++row) {
+        auto line = ctx->CreateSolidColorBrush(Color::Red());
+        ctx->DrawLine(Point(0, row * 8.0f + 7), Point(32, row * 8.0f + 7), line.get(), 1.0f);
+    }
+}
+
+} // anonymous namespace
+
+TEST(DisplayList_OptimizeMergesSameBrush) {
+    auto direct = MakeTarget();
+    DrawTable(direct->GetContext());
+    direct->EndDraw();
+
+    DisplayList list;
+    auto recorded = MakeTarget();
+    {
+        RecordingRenderContext recorder(recorded->GetContext(), &list);
+        DrawTable(&recorder);
+    }
+    recorded->EndDraw();
+    ASSERT_EQ(20u, list.GetCommandCount());
+
+    list.Optimize();
+    ASSERT_EQ(3u, list.GetCommandCount());   // two fill colors + one line batch
+
+    auto replayed = MakeTarget();
+    list.Replay(replayed->GetContext());
+    replayed->EndDraw();
+    ASSERT_TRUE(SamePixels(direct->GetSurface(), replayed->GetSurface()));
+}
+
+TEST(DisplayList_OptimizeKeepsOverlapOrder) {
+    auto draw = [](IRenderContext* ctx) {
+        auto red = ctx->CreateSolidColorBrush(Color::Red());
+        auto blue = ctx->CreateSolidColorBrush(Color::Blue());
+        ctx->FillRectangle(Rect(0, 0, 10, 10), red.get());
+        ctx->FillRectangle(Rect(5, 5, 10, 10), blue.get());
+        ctx->FillRectangle(Rect(10, 10, 10, 10), red.get());   // covers blue, must stay after it
+        ctx->FillRectangle(Rect(25, 0, 4, 4), blue.get());     // disjoint, joins the blue batch
+    };
+    auto direct = MakeTarget();
+    draw(direct->GetContext());
+    direct->EndDraw();
+
+    DisplayList list;
+    auto recorded = MakeTarget();
+    {
+        RecordingRenderContext recorder(recorded->GetContext(), &list);
+        draw(&recorder);
+    }
+    recorded->EndDraw();
+    list.Optimize();
+    ASSERT_EQ(3u, list.GetCommandCount());
+
+    auto replayed = MakeTarget();
+    list.Replay(replayed->GetContext());
+    replayed->EndDraw();
+    ASSERT_TRUE(SamePixels(direct->GetSurface(), replayed->GetSurface()));
+    ASSERT_EQ(0xFFFF0000u, replayed->GetSurface().GetPixel(12, 12));
+}
+
+TEST(DisplayList_BulkDrawIsOneBackendCall) {
+    std::vector<Rect> rects;
+    std::vector<Point> points;
+    for (int i = 0; i < 8; ++i) {
+        rects.emplace_back(i * 4.0f, 0.0f, 3.0f, 3.0f);
+        points.emplace_back(0.0f, 10.0f + i * 2);
+        points.emplace_back(30.0f, 10.0f + i * 2);
+    }
+
+    auto looped = MakeTarget();
+    auto* ctx = looped->GetContext();
+    auto brush = ctx->CreateSolidColorBrush(Color::White());
+    for (const auto& r : rects) ctx->FillRectangle(r, brush.get());
+    for (size_t i = 0; i < points.size(); i += 2) ctx->DrawLine(points[i], points[i + 1], brush.get());
+    looped->EndDraw();
+
+    auto bulk = MakeTarget();
+    auto* software = static_cast<SoftwareRenderContext*>(bulk->GetContext());
+    software->ResetDrawCallCount();
+    software->FillRectangles(rects.data(), rects.size(), brush.get());
+    software->DrawLines(points.data(), points.size() / 2, brush.get());
+    ASSERT_EQ(2, software->GetDrawCallCount());
+    bulk->EndDraw();
+    ASSERT_TRUE(SamePixels(looped->GetSurface(), bulk->GetSurface()));
+}
+
+// ==================== Main ====================
+int main() {
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,180 @@
+// Core Module - FrameScheduler tests (manual clock)
+#include "TestFramework.h"
+#include "FrameScheduler.h"
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace luaui;
+
+namespace {
+
+// Scheduler wired to a manual clock and a recording pipeline
+struct Harness {
+    ManualFrameClock* clock = nullptr;
+    FrameScheduler scheduler;
+    std::vector<std::string> log;
+    std::vector<double> wakes;
+    std::deque<std::function<void()>> tasks;
+    double taskCost = 0;      // ms each task advances the clock
+    double renderCost = 0;
+    int animationFrames = 0;  // update() reports active until this reaches 0
+
+    Harness() : scheduler(MakeClock(clock)) {
+        FrameScheduler::Pipeline pipeline;
+        pipeline.runTask = [this]() {
+            if (tasks.empty()) return false;
+            auto task = std::move(tasks.front());
+            tasks.pop_front();
+            log.push_back("task");
+            clock->Advance(taskCost);
+            task();
+            return true;
+        };
+        pipeline.update = [this](double delta) {
+            log.push_back("update:" + std::to_string(static_cast<int>(delta)));
+            return --animationFrames > 0;
+        };
+        pipeline.layout = [this]() { log.push_back("layout"); };
+        pipeline.render = [this]() {
+            log.push_back("render");
+            clock->Advance(renderCost);
+        };
+        scheduler.SetPipeline(std::move(pipeline));
+        scheduler.SetWakeHandler([this](double delay) { wakes.push_back(delay); });
+    }
+
+    static std::unique_ptr<IFrameClock> MakeClock(ManualFrameClock*& out) {
+        auto clock = std::make_unique<ManualFrameClock>();
+        out = clock.get();
+        return clock;
+    }
+};
+
+} // anonymous namespace
+
+TEST(FrameScheduler_BurstProducesOneFrame) {
+    Harness h;
+    for (int i = 0; i < 100; ++i) {
+        h.scheduler.RequestRender();
+        if (i % 10 == 0) h.scheduler.RequestLayout();
+    }
+    ASSERT_EQ(1u, h.wakes.size());
+    ASSERT_EQ(0.0, h.wakes[0]);
+
+    ASSERT_TRUE(h.scheduler.RunFrame());
+    ASSERT_EQ(2u, h.log.size());
+    ASSERT_EQ(std::string("layout"), h.log[0]);
+    ASSERT_EQ(std::string("render"), h.log[1]);
+    ASSERT_EQ(1u, h.scheduler.GetStats().frames);
+    ASSERT_EQ(109u, h.scheduler.GetStats().coalescedRequests);
+
+    // Nothing pending: a stale wake-up does no work
+    ASSERT_FALSE(h.scheduler.RunFrame());
+    ASSERT_EQ(1u, h.wakes.size());
+}
+
+TEST(FrameScheduler_PacesFramesToInterval) {
+    Harness h;
+    h.scheduler.SetFrameInterval(16.0);
+    h.scheduler.RequestRender();
+    h.scheduler.RunFrame();
+
+    h.clock->Advance(4.0);
+    h.scheduler.RequestRender();
+    ASSERT_EQ(2u, h.wakes.size());
+    ASSERT_EQ(12.0, h.wakes[1]);   // next frame no earlier than one interval after the last
+
+    h.clock->Advance(20.0);
+    h.scheduler.RunFrame();
+    h.scheduler.RequestRender();
+    ASSERT_EQ(16.0, h.wakes[2]);
+}
+
+TEST(FrameScheduler_TaskInvalidationsJoinSameFrame) {
+    Harness h;
+    h.tasks.push_back([&h]() { h.scheduler.RequestLayout(); });
+    h.tasks.push_back([&h]() { h.scheduler.RequestRender(); });
+    h.scheduler.RequestTasks();
+    ASSERT_EQ(1u, h.wakes.size());
+
+    h.scheduler.RunFrame();
+    ASSERT_EQ(4u, h.log.size());
+    ASSERT_EQ(std::string("task"), h.log[0]);
+    ASSERT_EQ(std::string("task"), h.log[1]);
+    ASSERT_EQ(std::string("layout"), h.log[2]);
+    ASSERT_EQ(std::string("render"), h.log[3]);
+    ASSERT_FALSE(h.scheduler.HasPendingWork());
+    ASSERT_EQ(1u, h.wakes.size());   // handled in-frame, no extra wake-up
+}
+
+TEST(FrameScheduler_RenderInvalidationGoesToNextFrame) {
+    Harness h;
+    h.scheduler.SetPipeline([&h]() {
+        FrameScheduler::Pipeline p;
+        p.render = [&h]() {
+            h.log.push_back("render");
+            if (h.log.size() == 1) h.scheduler.RequestRender();
+        };
+        return p;
+    }());
+    h.scheduler.RequestRender();
+    h.scheduler.RunFrame();
+    ASSERT_EQ(1u, h.log.size());
+    ASSERT_TRUE(h.scheduler.HasPendingWork());
+    ASSERT_EQ(2u, h.wakes.size());
+
+    h.clock->Advance(20.0);
+    h.scheduler.RunFrame();
+    ASSERT_EQ(2u, h.log.size());
+    ASSERT_FALSE(h.scheduler.HasPendingWork());
+}
+
+TEST(FrameScheduler_TasksRespectBudget) {
+    Harness h;
+    h.scheduler.SetFrameBudget(10.0);
+    h.taskCost = 3.0;
+    for (int i = 0; i < 10; ++i) h.tasks.push_back([]() {});
+    h.scheduler.RequestTasks();
+
+    h.scheduler.RunFrame();
+    ASSERT_EQ(4u, h.scheduler.GetStats().tasksRun);   // 0, 3, 6, 9 ms < 10
+    ASSERT_EQ(6u, h.tasks.size());
+    ASSERT_EQ(1u, h.scheduler.GetStats().deferredTaskFrames);
+    ASSERT_TRUE(h.scheduler.HasPendingWork());
+    ASSERT_EQ(2u, h.wakes.size());
+
+    // Render cost from the previous frame is reserved out of the task budget
+    h.renderCost = 4.0;
+    h.scheduler.RequestRender();
+    h.clock->Advance(20.0);
+    h.scheduler.RunFrame();
+    ASSERT_EQ(8u, h.scheduler.GetStats().tasksRun);
+
+    h.clock->Advance(20.0);
+    h.scheduler.RunFrame();   // budget 10 - 4 = 6 ms
+    ASSERT_EQ(10u, h.scheduler.GetStats().tasksRun);
+    ASSERT_TRUE(h.tasks.empty());
+}
+
+TEST(FrameScheduler_AnimationTicksUntilIdle) {
+    Harness h;
+    h.animationFrames = 3;
+    h.scheduler.RequestAnimation();
+    for (int frame = 0; frame < 5; ++frame) {
+        h.clock->Advance(16.0);
+        h.scheduler.RunFrame();
+    }
+    ASSERT_EQ(3u, h.log.size());
+    ASSERT_EQ(std::string("update:16"), h.log[0]);
+    ASSERT_EQ(std::string("update:16"), h.log[2]);
+    ASSERT_FALSE(h.scheduler.IsAnimating());
+    ASSERT_EQ(0u, h.scheduler.GetStats().frames);   // animations invalidate controls themselves
+    ASSERT_EQ(3u, h.wakes.size());                  // one per active frame, none once idle
+}
+
+// ==================== Main ====================
+int main() {
+    return RUN_ALL_TESTS();
+}
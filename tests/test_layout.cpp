@@ -10,7 +10,12 @@
 #include "Button.h"
 #include "../core/Control.h"
 #include "../core/Components/LayoutComponent.h"
+#include "../core/Components/LayoutStore.h"
+#include "../core/LayoutManager.h"
+#include "../core/WorkStealingPool.h"
 #include "../rendering/Types.h"
+#include <atomic>
+#include <stdexcept>
 
 using namespace luaui;
 using namespace luaui::controls;
@@ -354,6 +359,420 @@ TEST(Layout_ManyChildren) {
     ASSERT_EQ(panel->GetChildCount(), 1000u);
 }
 
+// ==================== Incremental Layout Tests ====================
+namespace {
+
+// Content-sized control that counts how often it is measured
+class CountingControl : public Control {
+public:
+    explicit CountingControl(Size size) : size(size) {}
+    std::string GetTypeName() const override { return "CountingControl"; }
+    
+    Size size;
+    int measureCount = 0;
+    
+protected:
+    void InitializeComponents() override {
+        GetComponents().AddComponent<components::LayoutComponent>(this);
+    }
+    Size OnMeasure(const Size&) override {
+        ++measureCount;
+        return size;
+    }
+};
+
+void LayoutRoot(Control& root, float width, float height) {
+    LayoutConstraint constraint;
+    constraint.available = Size(width, height);
+    root.GetLayout()->Measure(constraint);
+    root.GetLayout()->Arrange(Rect(0.0f, 0.0f, width, height));
+}
+
+} // namespace
+
+TEST(LayoutBoundary_FixedSizeOrExplicit) {
+    auto fixed = std::make_shared<TestControl>(100.0f, 50.0f);
+    fixed->EnsureInitialized();
+    ASSERT_TRUE(fixed->GetLayout()->IsLayoutBoundary());
+    
+    auto content = std::make_shared<CountingControl>(Size(10.0f, 10.0f));
+    content->EnsureInitialized();
+    ASSERT_FALSE(content->GetLayout()->IsLayoutBoundary());
+    content->GetLayout()->SetIsLayoutBoundary(true);
+    ASSERT_TRUE(content->GetLayout()->IsLayoutBoundary());
+}
+
+TEST(LayoutManager_RelayoutsOnlyQueuedSubtree) {
+    auto root = std::make_shared<StackPanel>();
+    auto sibling = std::make_shared<CountingControl>(Size(200.0f, 30.0f));
+    auto card = std::make_shared<StackPanel>();
+    card->GetLayout()->SetWidth(300.0f);
+    card->GetLayout()->SetHeight(100.0f);
+    auto label = std::make_shared<CountingControl>(Size(40.0f, 20.0f));
+    card->AddChild(label);
+    root->AddChild(sibling);
+    root->AddChild(card);
+    LayoutRoot(*root, 800.0f, 600.0f);
+    ASSERT_TRUE(card->GetLayout()->IsLayoutBoundary());
+    ASSERT_EQ(1, LayoutManager::GetDepth(card.get()));
+    ASSERT_EQ(2, LayoutManager::GetDepth(label.get()));
+    
+    int siblingMeasures = sibling->measureCount;
+    int labelMeasures = label->measureCount;
+    label->size = Size(120.0f, 20.0f);
+    label->GetLayout()->InvalidateMeasure();
+    
+    LayoutManager manager;
+    manager.Enqueue(card.get());
+    manager.Enqueue(card.get());
+    ASSERT_EQ(1u, manager.GetPendingCount());
+    ASSERT_TRUE(card->GetLayout()->IsLayoutQueued());
+    ASSERT_EQ(1u, manager.Process());
+    ASSERT_TRUE(manager.IsEmpty());
+    ASSERT_FALSE(card->GetLayout()->IsLayoutQueued());
+    
+    ASSERT_TRUE(card->GetLayout()->IsMeasureValid());
+    ASSERT_TRUE(card->GetLayout()->IsArrangeValid());
+    ASSERT_NEAR(120.0f, label->GetLayout()->GetDesiredSize().width, 0.001f);
+    ASSERT_EQ(labelMeasures + 1, label->measureCount);
+    ASSERT_EQ(siblingMeasures, sibling->measureCount);
+    
+    // Processed and cleared roots can be queued again
+    manager.Enqueue(card.get());
+    ASSERT_EQ(1u, manager.GetPendingCount());
+    manager.Clear();
+    ASSERT_FALSE(card->GetLayout()->IsLayoutQueued());
+    manager.Enqueue(card.get());
+    ASSERT_EQ(1u, manager.GetPendingCount());
+}
+
+TEST(LayoutManager_ProcessesShallowRootsFirst) {
+    auto root = std::make_shared<StackPanel>();
+    auto outer = std::make_shared<StackPanel>();
+    outer->GetLayout()->SetWidth(300.0f);
+    outer->GetLayout()->SetHeight(200.0f);
+    auto inner = std::make_shared<StackPanel>();
+    inner->GetLayout()->SetWidth(100.0f);
+    inner->GetLayout()->SetHeight(50.0f);
+    auto leaf = std::make_shared<CountingControl>(Size(10.0f, 10.0f));
+    inner->AddChild(leaf);
+    outer->AddChild(inner);
+    root->AddChild(outer);
+    LayoutRoot(*root, 800.0f, 600.0f);
+    
+    leaf->GetLayout()->InvalidateMeasure();
+    
+    // The outer subtree covers the inner one, which is then skipped
+    LayoutManager manager;
+    manager.Enqueue(inner.get());
+    manager.Enqueue(outer.get());
+    ASSERT_EQ(1u, manager.Process());
+    ASSERT_TRUE(inner->GetLayout()->IsMeasureValid());
+    ASSERT_TRUE(leaf->GetLayout()->IsArrangeValid());
+    
+    // Destroyed controls are dropped from the queue
+    auto orphan = std::make_shared<CountingControl>(Size(10.0f, 10.0f));
+    manager.Enqueue(orphan.get());
+    orphan.reset();
+    ASSERT_EQ(0u, manager.Process());
+}
+
+// ==================== Measure Cache Tests ====================
+namespace {
+
+Size MeasureAt(Control& control, float width, float height) {
+    LayoutConstraint constraint;
+    constraint.available = Size(width, height);
+    return control.GetLayout()->Measure(constraint);
+}
+
+} // namespace
+
+TEST(MeasureCache_ReusesEntriesPerConstraint) {
+    auto label = std::make_shared<CountingControl>(Size(40.0f, 20.0f));
+    label->EnsureInitialized();
+    components::LayoutComponent::ResetMeasureCacheStats();
+    
+    MeasureAt(*label, 100.0f, 50.0f);
+    MeasureAt(*label, 200.0f, 50.0f);
+    MeasureAt(*label, 300.0f, 50.0f);
+    ASSERT_EQ(3, label->measureCount);
+    
+    // Earlier constraints are still cached
+    MeasureAt(*label, 100.0f, 50.0f);
+    MeasureAt(*label, 200.0f, 50.0f);
+    MeasureAt(*label, 300.0f, 50.0f);
+    ASSERT_EQ(3, label->measureCount);
+    
+    auto stats = components::LayoutComponent::GetMeasureCacheStats();
+    ASSERT_EQ(3u, stats.hits);
+    ASSERT_EQ(3u, stats.misses);
+    ASSERT_EQ(3u, label->GetLayout()->GetMeasureCacheCount());
+    
+    // Fifth distinct constraint replaces an entry
+    MeasureAt(*label, 400.0f, 50.0f);
+    MeasureAt(*label, 500.0f, 50.0f);
+    ASSERT_EQ(components::LayoutComponent::kMeasureCacheSize, label->GetLayout()->GetMeasureCacheCount());
+    
+    // Invalidation clears every entry
+    label->GetLayout()->InvalidateMeasure();
+    ASSERT_EQ(0u, label->GetLayout()->GetMeasureCacheCount());
+    MeasureAt(*label, 200.0f, 50.0f);
+    ASSERT_EQ(6, label->measureCount);
+}
+
+TEST(MeasureCache_ContainerRemeasuresChildrenForOlderConstraint) {
+    auto panel = std::make_shared<StackPanel>();
+    panel->SetOrientation(StackPanel::Orientation::Horizontal);
+    auto label = std::make_shared<CountingControl>(Size(40.0f, 20.0f));
+    panel->AddChild(label);
+    
+    MeasureAt(*panel, 100.0f, 50.0f);
+    MeasureAt(*panel, 200.0f, 80.0f);
+    ASSERT_EQ(2, label->measureCount);
+    
+    // The panel re-runs its measure so the child's DesiredSize matches,
+    // but the child itself answers from its cache
+    Size desired = MeasureAt(*panel, 100.0f, 50.0f);
+    ASSERT_NEAR(40.0f, desired.width, 0.001f);
+    ASSERT_EQ(2, label->measureCount);
+    
+    // Repeating the latest constraint is a plain hit
+    components::LayoutComponent::ResetMeasureCacheStats();
+    MeasureAt(*panel, 100.0f, 50.0f);
+    auto stats = components::LayoutComponent::GetMeasureCacheStats();
+    ASSERT_EQ(1u, stats.hits);
+    ASSERT_EQ(0u, stats.misses);
+}
+
+// ==================== Parallel Layout Tests ====================
+TEST(WorkStealingPool_NestedParallelFor) {
+    WorkStealingPool pool(3);
+    std::vector<int> hits(64 * 16, 0);
+    pool.ParallelFor(64, 16, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            ASSERT_TRUE(WorkStealingPool::IsInTask());
+            pool.ParallelFor(16, 4, [&](size_t b, size_t e) {
+                for (size_t j = b; j < e; ++j) ++hits[i * 16 + j];
+            });
+        }
+    });
+    for (int value : hits) ASSERT_EQ(1, value);
+    ASSERT_FALSE(WorkStealingPool::IsInTask());
+    
+    bool thrown = false;
+    try {
+        pool.ParallelFor(8, 8, [](size_t begin, size_t) {
+            if (begin == 5) throw std::runtime_error("task failed");
+        });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    ASSERT_TRUE(thrown);
+}
+
+namespace {
+
+std::shared_ptr<StackPanel> MakeWideTree(std::vector<std::shared_ptr<CountingControl>>& leaves) {
+    auto root = std::make_shared<StackPanel>();
+    root->SetOrientation(StackPanel::Orientation::Horizontal);
+    for (int column = 0; column < 8; ++column) {
+        auto panel = std::make_shared<StackPanel>();
+        for (int row = 0; row < 20; ++row) {
+            auto leaf = std::make_shared<CountingControl>(
+                Size(10.0f + column * 3 + row, 12.0f + (row % 3)));
+            leaves.push_back(leaf);
+            panel->AddChild(leaf);
+        }
+        root->AddChild(panel);
+    }
+    return root;
+}
+
+} // namespace
+
+TEST(ParallelLayout_MatchesSequentialResult) {
+    std::vector<std::shared_ptr<CountingControl>> sequentialLeaves;
+    auto sequential = MakeWideTree(sequentialLeaves);
+    LayoutRoot(*sequential, 1920.0f, 1080.0f);
+    
+    std::vector<std::shared_ptr<CountingControl>> parallelLeaves;
+    auto parallel = MakeWideTree(parallelLeaves);
+    WorkStealingPool pool(4);
+    {
+        components::LayoutComponent::ParallelMeasureScope scope(&pool);
+        LayoutRoot(*parallel, 1920.0f, 1080.0f);
+    }
+    
+    Size a = sequential->GetLayout()->GetDesiredSize();
+    Size b = parallel->GetLayout()->GetDesiredSize();
+    ASSERT_NEAR(a.width, b.width, 0.0f);
+    ASSERT_NEAR(a.height, b.height, 0.0f);
+    ASSERT_EQ(sequentialLeaves.size(), parallelLeaves.size());
+    for (size_t i = 0; i < parallelLeaves.size(); ++i) {
+        ASSERT_EQ(1, parallelLeaves[i]->measureCount);
+        Rect expected = sequentialLeaves[i]->GetLayout()->GetLastArrangeRect();
+        Rect actual = parallelLeaves[i]->GetLayout()->GetLastArrangeRect();
+        ASSERT_NEAR(expected.x, actual.x, 0.0f);
+        ASSERT_NEAR(expected.y, actual.y, 0.0f);
+        ASSERT_NEAR(expected.width, actual.width, 0.0f);
+    }
+}
+
+namespace {
+
+// Invalidates another control's layout from inside its own measure pass
+class InvalidatingControl : public CountingControl {
+public:
+    InvalidatingControl(Size size, Control* observer) : CountingControl(size), observer(observer) {}
+    
+    Control* observer;
+    std::atomic<int> deferredInTask{0};
+    
+protected:
+    Size OnMeasure(const Size& available) override {
+        observer->GetLayout()->InvalidateMeasure();
+        if (WorkStealingPool::IsInTask() && observer->GetLayout()->IsMeasureValid()) {
+            ++deferredInTask;
+        }
+        return CountingControl::OnMeasure(available);
+    }
+};
+
+} // namespace
+
+TEST(ParallelLayout_DefersInvalidationsToCallingThread) {
+    auto observer = std::make_shared<CountingControl>(Size(10.0f, 10.0f));
+    LayoutRoot(*observer, 10.0f, 10.0f);
+    
+    auto root = std::make_shared<StackPanel>();
+    root->SetOrientation(StackPanel::Orientation::Horizontal);
+    std::vector<std::shared_ptr<InvalidatingControl>> leaves;
+    for (int column = 0; column < 8; ++column) {
+        auto panel = std::make_shared<StackPanel>();
+        leaves.push_back(std::make_shared<InvalidatingControl>(Size(20.0f, 20.0f), observer.get()));
+        panel->AddChild(leaves.back());
+        root->AddChild(panel);
+    }
+    
+    WorkStealingPool pool(4);
+    {
+        components::LayoutComponent::ParallelMeasureScope scope(&pool);
+        LayoutRoot(*root, 800.0f, 600.0f);
+    }
+    
+    // Inside the pool tasks the observer was untouched; the calling thread applied it afterwards
+    int deferred = 0;
+    for (auto& leaf : leaves) deferred += leaf->deferredInTask.load();
+    ASSERT_EQ(8, deferred);
+    ASSERT_FALSE(observer->GetLayout()->IsMeasureValid());
+    ASSERT_TRUE(root->GetLayout()->IsMeasureValid());
+}
+
+// ==================== Layout Store Tests ====================
+TEST(LayoutStore_ReleasesAndReusesSlots) {
+    auto& store = components::LayoutStore::Shared();
+    size_t liveBefore = store.GetLiveCount();
+    
+    auto label = std::make_shared<CountingControl>(Size(40.0f, 20.0f));
+    label->EnsureInitialized();
+    uint32_t slot = label->GetLayout()->GetStoreSlot();
+    ASSERT_EQ(slot, store.FindSlot(label->GetID()));
+    ASSERT_EQ(liveBefore + 1, store.GetLiveCount());
+    
+    ControlID id = label->GetID();
+    label.reset();
+    ASSERT_EQ(liveBefore, store.GetLiveCount());
+    ASSERT_EQ(components::LayoutStore::kInvalidSlot, store.FindSlot(id));
+    
+    // The freed slot is handed out again with default state
+    auto next = std::make_shared<CountingControl>(Size(10.0f, 10.0f));
+    next->EnsureInitialized();
+    ASSERT_EQ(slot, next->GetLayout()->GetStoreSlot());
+    ASSERT_NEAR(0.0f, next->GetLayout()->GetMarginLeft(), 0.0f);
+    ASSERT_FALSE(next->GetLayout()->IsMeasureValid());
+}
+
+TEST(LayoutStore_ReorderKeepsStateInDepthFirstOrder) {
+    // Children created before their parents and interleaved with other allocations
+    std::vector<std::shared_ptr<CountingControl>> leaves;
+    std::vector<std::shared_ptr<CountingControl>> unrelated;
+    for (int i = 0; i < 6; ++i) {
+        leaves.push_back(std::make_shared<CountingControl>(Size(10.0f + i, 5.0f)));
+        leaves.back()->EnsureInitialized();
+        unrelated.push_back(std::make_shared<CountingControl>(Size(1.0f, 1.0f)));
+        unrelated.back()->EnsureInitialized();
+    }
+    auto root = std::make_shared<StackPanel>();
+    auto left = std::make_shared<StackPanel>();
+    auto right = std::make_shared<StackPanel>();
+    root->AddChild(left);
+    root->AddChild(right);
+    for (int i = 0; i < 6; ++i) {
+        (i < 3 ? left : right)->AddChild(leaves[5 - i]);
+    }
+    leaves[2]->GetLayout()->SetMargin(1.0f, 2.0f, 3.0f, 4.0f);
+    LayoutRoot(*root, 300.0f, 200.0f);
+    Rect before = leaves[2]->GetLayout()->GetLastArrangeRect();
+    int measuresBefore = leaves[2]->measureCount;
+    
+    auto& store = components::LayoutStore::Shared();
+    ASSERT_EQ(9u, store.ReorderDepthFirst(root.get()));
+    
+    // Pre-order: root, left, leaves 5,4,3, right, leaves 2,1,0
+    std::vector<Control*> preorder = { root.get(), left.get(), leaves[5].get(), leaves[4].get(),
+                                       leaves[3].get(), right.get(), leaves[2].get(),
+                                       leaves[1].get(), leaves[0].get() };
+    for (size_t i = 1; i < preorder.size(); ++i) {
+        ASSERT_TRUE(preorder[i - 1]->GetLayout()->GetStoreSlot() < preorder[i]->GetLayout()->GetStoreSlot());
+    }
+    for (auto* control : preorder) {
+        ASSERT_EQ(control->GetLayout()->GetStoreSlot(), store.FindSlot(control->GetID()));
+    }
+    
+    // State moved with the control, including the measure cache
+    auto* layout = leaves[2]->GetLayout();
+    ASSERT_NEAR(2.0f, layout->GetMarginTop(), 0.0f);
+    ASSERT_NEAR(before.y, layout->GetLastArrangeRect().y, 0.0f);
+    ASSERT_TRUE(layout->IsMeasureValid());
+    LayoutRoot(*root, 300.0f, 200.0f);
+    ASSERT_EQ(measuresBefore, leaves[2]->measureCount);
+    ASSERT_NEAR(1.0f, unrelated[3]->GetLayout()->GetDesiredSize().width + 1.0f, 1.0f);
+}
+
+TEST(LayoutStore_TracksReorderPerRoot) {
+    // Two windows' trees share the store
+    auto first = std::make_shared<StackPanel>();
+    auto second = std::make_shared<StackPanel>();
+    for (auto& root : { first, second }) {
+        root->EnsureInitialized();
+        for (int i = 0; i < 16; ++i) {
+            auto child = std::make_shared<CountingControl>(Size(10.0f, 10.0f));
+            child->EnsureInitialized();
+            root->AddChild(child);
+        }
+    }
+
+    auto& store = components::LayoutStore::Shared();
+    ASSERT_EQ(17u, store.ReorderDepthFirst(first.get()));
+    ASSERT_FALSE(store.NeedsReorder(first.get()));
+    ASSERT_TRUE(store.NeedsReorder(second.get()));     // Not reset by the other tree's reorder
+
+    ASSERT_EQ(17u, store.ReorderDepthFirst(second.get()));
+    ASSERT_FALSE(store.NeedsReorder(first.get()));
+    ASSERT_FALSE(store.NeedsReorder(second.get()));
+
+    // Moving a few controls churns the order again
+    for (int i = 0; i < 3; ++i) {
+        auto child = std::static_pointer_cast<Control>(first->GetChild(0));
+        first->RemoveChild(child);
+        first->AddChild(child);
+    }
+    ASSERT_TRUE(store.NeedsReorder(first.get()));
+    store.ReorderDepthFirst(first.get());
+    ASSERT_FALSE(store.NeedsReorder(first.get()));
+}
+
 // ==================== Main ====================
 int main() {
     return RUN_ALL_TESTS();
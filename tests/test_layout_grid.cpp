@@ -3,6 +3,7 @@
 #include "layouts/Grid.h"
 #include "Button.h"
 #include "TextBlock.h"
+#include "Components/LayoutComponent.h"
 
 using namespace luaui;
 using namespace luaui::controls;
@@ -399,6 +400,142 @@ TEST(Grid_ControlDestruction) {
     ASSERT_EQ(grid.GetColumnCount(), 0u);
 }
 
+// ==================== Solver Tests ====================
+namespace {
+
+// Content-sized control that records the constraint it was measured with
+class SizedControl : public luaui::Control {
+public:
+    SizedControl(float width, float height) : size(width, height) {}
+    std::string GetTypeName() const override { return "SizedControl"; }
+    
+    rendering::Size size;
+    rendering::Size lastAvailable;
+    int measureCount = 0;
+    
+protected:
+    void InitializeComponents() override {
+        GetComponents().AddComponent<components::LayoutComponent>(this);
+    }
+    rendering::Size OnMeasure(const rendering::Size& availableSize) override {
+        ++measureCount;
+        lastAvailable = availableSize;
+        return size;
+    }
+};
+
+std::shared_ptr<SizedControl> Place(Grid& grid, float width, float height,
+                                    int column, int row, int columnSpan = 1, int rowSpan = 1) {
+    auto control = std::make_shared<SizedControl>(width, height);
+    grid.SetColumn(control, column);
+    grid.SetRow(control, row);
+    grid.SetColumnSpan(control, columnSpan);
+    grid.SetRowSpan(control, rowSpan);
+    grid.AddChild(control);
+    return control;
+}
+
+void LayoutGrid(Grid& grid, float width, float height) {
+    interfaces::LayoutConstraint constraint;
+    constraint.available = rendering::Size(width, height);
+    grid.GetLayout()->Measure(constraint);
+    grid.GetLayout()->Arrange(rendering::Rect(0, 0, width, height));
+}
+
+} // namespace
+
+TEST(Grid_ResolvesAutoPixelAndStar) {
+    auto grid = std::make_shared<Grid>();
+    grid->AddColumn(GridLength::Auto());
+    grid->AddColumn(GridLength::Pixel(100.0f));
+    grid->AddColumn(GridLength::Star(1.0f));
+    grid->AddColumn(GridLength::Star(3.0f));
+    grid->AddRow(GridLength::Auto());
+    grid->AddRow(GridLength::Star(1.0f));
+    
+    auto label = Place(*grid, 50.0f, 20.0f, 0, 0);
+    auto fixed = Place(*grid, 500.0f, 10.0f, 1, 0);
+    auto content = Place(*grid, 10.0f, 10.0f, 3, 1);
+    LayoutGrid(*grid, 650.0f, 400.0f);
+    
+    ASSERT_NEAR(50.0f, grid->GetActualColumnWidth(0), 0.001f);
+    ASSERT_NEAR(100.0f, grid->GetActualColumnWidth(1), 0.001f);
+    ASSERT_NEAR(125.0f, grid->GetActualColumnWidth(2), 0.001f);
+    ASSERT_NEAR(375.0f, grid->GetActualColumnWidth(3), 0.001f);
+    ASSERT_NEAR(20.0f, grid->GetActualRowHeight(0), 0.001f);
+    ASSERT_NEAR(380.0f, grid->GetActualRowHeight(1), 0.001f);
+    
+    // Pixel columns constrain their content; star cells see the resolved width
+    ASSERT_NEAR(100.0f, fixed->lastAvailable.width, 0.001f);
+    ASSERT_NEAR(375.0f, content->lastAvailable.width, 0.001f);
+    ASSERT_EQ(1, label->measureCount);
+    ASSERT_EQ(1, content->measureCount);
+    
+    auto rect = content->GetLayout()->GetLastArrangeRect();
+    ASSERT_NEAR(275.0f, rect.x, 0.001f);
+    ASSERT_NEAR(20.0f, rect.y, 0.001f);
+    ASSERT_NEAR(375.0f, rect.width, 0.001f);
+}
+
+TEST(Grid_SpansResolveAfterSingleCells) {
+    auto grid = std::make_shared<Grid>();
+    for (int i = 0; i < 3; ++i) grid->AddColumn(GridLength::Auto());
+    
+    // The widest span is added first but must be resolved last
+    Place(*grid, 150.0f, 10.0f, 0, 0, 3);
+    Place(*grid, 100.0f, 10.0f, 0, 1, 2);
+    Place(*grid, 30.0f, 10.0f, 0, 2);
+    LayoutGrid(*grid, 800.0f, 600.0f);
+    
+    // 30 from the single cell, the two-column span adds 35 to each,
+    // and the three-column span adds the remaining 50 evenly
+    ASSERT_NEAR(65.0f + 50.0f / 3.0f, grid->GetActualColumnWidth(0), 0.001f);
+    ASSERT_NEAR(35.0f + 50.0f / 3.0f, grid->GetActualColumnWidth(1), 0.001f);
+    ASSERT_NEAR(50.0f / 3.0f, grid->GetActualColumnWidth(2), 0.001f);
+}
+
+TEST(Grid_StarActsAsAutoWhenUnbounded) {
+    auto grid = std::make_shared<Grid>();
+    grid->AddColumn(GridLength::Star(1.0f));
+    grid->AddColumn(GridLength::Star(1.0f));
+    Place(*grid, 40.0f, 10.0f, 0, 0);
+    Place(*grid, 70.0f, 10.0f, 1, 0);
+    
+    interfaces::LayoutConstraint constraint;
+    constraint.available = rendering::Size(99999.0f, 99999.0f);
+    auto desired = grid->GetLayout()->Measure(constraint);
+    ASSERT_NEAR(110.0f, desired.width, 0.001f);
+    ASSERT_NEAR(10.0f, desired.height, 0.001f);
+}
+
+TEST(Grid_SpanIndexFollowsChildChanges) {
+    auto grid = std::make_shared<Grid>();
+    grid->AddColumn(GridLength::Auto());
+    grid->AddColumn(GridLength::Auto());
+    auto narrow = Place(*grid, 50.0f, 10.0f, 0, 0);
+    auto wide = Place(*grid, 80.0f, 10.0f, 0, 0);
+    wide->SetIsVisible(false);
+    LayoutGrid(*grid, 400.0f, 300.0f);
+    ASSERT_NEAR(50.0f, grid->GetActualColumnWidth(0), 0.001f);
+    
+    wide->SetIsVisible(true);
+    grid->GetLayout()->InvalidateMeasure();
+    LayoutGrid(*grid, 400.0f, 300.0f);
+    ASSERT_NEAR(80.0f, grid->GetActualColumnWidth(0), 0.001f);
+    
+    grid->SetColumn(wide, 1);
+    LayoutGrid(*grid, 400.0f, 300.0f);
+    ASSERT_NEAR(50.0f, grid->GetActualColumnWidth(0), 0.001f);
+    ASSERT_NEAR(80.0f, grid->GetActualColumnWidth(1), 0.001f);
+    
+    grid->RemoveChildAt(1);
+    grid->InsertChild(0, wide);
+    grid->RemoveChild(narrow);
+    LayoutGrid(*grid, 400.0f, 300.0f);
+    ASSERT_NEAR(0.0f, grid->GetActualColumnWidth(0), 0.001f);
+    ASSERT_NEAR(80.0f, grid->GetActualColumnWidth(1), 0.001f);
+}
+
 // ==================== Main ====================
 int main() {
     return RUN_ALL_TESTS();
@@ -1,6 +1,7 @@
 // Logger Module Unit Tests
 #include "TestFramework.h"
 #include "Logger.h"
+#include "StringUtils.h"
 #include <sstream>
 #include <fstream>
 #include <filesystem>
@@ -168,6 +169,30 @@ TEST(MultiLogger_Clear) {
     multi.Log(LogLevel::Info, "Test message");
 }
 
+// ==================== StringUtils Tests ====================
+TEST(StringUtils_Utf8RoundTrip) {
+    std::string utf8 = "A\xC3\xA9\xE2\x82\xAC";    // A, U+00E9, U+20AC
+    std::wstring wide = StringUtils::Utf8ToWString(utf8);
+    ASSERT_TRUE(wide == std::wstring(L"A\u00E9\u20AC"));
+    ASSERT_EQ(utf8, StringUtils::WStringToUtf8(wide));
+}
+
+TEST(StringUtils_InvalidUtf8BecomesReplacementChar) {
+    const std::wstring bad(1, static_cast<wchar_t>(0xFFFD));
+    // C0/C1 and F5+ lead bytes, and a lone continuation byte
+    ASSERT_TRUE(StringUtils::Utf8ToWString("\xC0\xAF") == bad + bad);
+    ASSERT_TRUE(StringUtils::Utf8ToWString("\xF5\x80") == bad + bad);
+    // Overlong form, UTF-16 surrogate, above U+10FFFF
+    ASSERT_TRUE(StringUtils::Utf8ToWString("\xE0\x80\x80") == bad + bad + bad);
+    ASSERT_TRUE(StringUtils::Utf8ToWString("\xED\xA0\x80") == bad + bad + bad);
+    ASSERT_TRUE(StringUtils::Utf8ToWString("\xF4\x90\x80\x80") == bad + bad + bad + bad);
+    // A truncated sequence is one replacement; decoding resumes at the next byte
+    ASSERT_TRUE(StringUtils::Utf8ToWString("\xE2\x82x") == bad + L"x");
+    
+    // Lone surrogates encode as U+FFFD
+    ASSERT_EQ(std::string("\xEF\xBF\xBD"), StringUtils::WStringToUtf8(std::wstring(1, static_cast<wchar_t>(0xD800))));
+}
+
 // ==================== Global Logger Tests ====================
 TEST(GlobalLogger_InitializeWithConsole) {
     Logger::Shutdown();
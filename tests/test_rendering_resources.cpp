@@ -1,7 +1,16 @@
-// Rendering Module - DirtyRegion Tests (API-matched)
+// Rendering Module - DirtyRegion / ResourceCache / TextLayoutCache Tests (API-matched)
 #include "TestFramework.h"
 #include "DirtyRegion.h"
+#include "ResourceCache.h"
+#include "TextLayoutCache.h"
+#include "BitmapService.h"
+#include "software/SoftwareRenderContext.h"
 #include "Types.h"
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
 
 using namespace luaui::rendering;
 
@@ -97,6 +106,84 @@ TEST(DirtyRegion_ClearAndReuse) {
     ASSERT_TRUE(dr.Intersects(Rect(200.0f, 200.0f, 50.0f, 50.0f)));
 }
 
+TEST(DirtyRegion_ContainedRectIgnored) {
+    DirtyRegion dr;
+    
+    // The same control invalidating repeatedly within one frame
+    dr.AddRect(Rect(10.0f, 10.0f, 100.0f, 30.0f));
+    dr.AddRect(Rect(10.0f, 10.0f, 100.0f, 30.0f));
+    dr.AddRect(Rect(20.0f, 15.0f, 10.0f, 10.0f));
+    ASSERT_EQ(dr.GetRects().size(), 1u);
+    
+    // Not contained: tracked separately
+    dr.AddRect(Rect(200.0f, 10.0f, 10.0f, 10.0f));
+    ASSERT_EQ(dr.GetRects().size(), 2u);
+}
+
+TEST(DirtyRegion_TileAlignedExtraction) {
+    DirtyRegion dr;
+    
+    // Two 10x10 cells in the same 32px tile row merge into one horizontal run
+    dr.AddRect(Rect(2.0f, 2.0f, 10.0f, 10.0f));
+    dr.AddRect(Rect(40.0f, 2.0f, 10.0f, 10.0f));
+    ASSERT_EQ(dr.GetRects().size(), 1u);
+    
+    // Result is clipped to the exact bounds of what was added
+    const Rect& r = dr.GetRects()[0];
+    ASSERT_EQ(r.x, 2.0f);
+    ASSERT_EQ(r.y, 2.0f);
+    ASSERT_EQ(r.width, 48.0f);
+    ASSERT_EQ(r.height, 10.0f);
+    
+    // Tiles are conservative: a point in a dirty tile counts as dirty
+    ASSERT_TRUE(dr.Intersects(Rect(20.0f, 5.0f, 2.0f, 2.0f)));
+    ASSERT_FALSE(dr.Intersects(Rect(100.0f, 5.0f, 10.0f, 10.0f)));
+}
+
+TEST(DirtyRegion_UnionAndIntersect) {
+    DirtyRegion a;
+    a.AddRect(Rect(0.0f, 0.0f, 64.0f, 64.0f));
+    
+    DirtyRegion b;
+    b.AddRect(Rect(32.0f, 32.0f, 3000.0f, 64.0f));   // wider grid than a
+    
+    DirtyRegion u;
+    u.Union(a);
+    u.Union(b);
+    ASSERT_EQ(u.GetTileCount(), 4u + 94u * 2u - 1u);
+    ASSERT_TRUE(u.Intersects(Rect(2000.0f, 40.0f, 1.0f, 1.0f)));
+    
+    a.Intersect(b);
+    ASSERT_EQ(a.GetTileCount(), 1u);
+    ASSERT_EQ(a.GetRects().size(), 1u);
+    ASSERT_EQ(a.GetRects()[0].x, 32.0f);
+    ASSERT_EQ(a.GetRects()[0].width, 32.0f);
+    
+    DirtyRegion empty;
+    a.Intersect(empty);
+    ASSERT_TRUE(a.IsEmpty());
+}
+
+TEST(DirtyRegion_CostModelChoosesPasses) {
+    DirtyRegion dr;
+    dr.AddRect(Rect(0.0f, 0.0f, 16.0f, 16.0f));
+    dr.AddRect(Rect(1000.0f, 700.0f, 16.0f, 16.0f));
+    ASSERT_EQ(dr.GetRects().size(), 2u);
+    
+    // Cheap passes: two small clipped passes beat one huge bounding pass
+    RegionCostModel cheapPass;
+    cheapPass.passOverhead = 100.0f;
+    ASSERT_EQ(dr.GetRenderRects(cheapPass).size(), 2u);
+    
+    // Very expensive passes: a single bounding pass wins
+    RegionCostModel expensivePass;
+    expensivePass.passOverhead = 10000000.0f;
+    auto rects = dr.GetRenderRects(expensivePass);
+    ASSERT_EQ(rects.size(), 1u);
+    ASSERT_EQ(rects[0].width, 1016.0f);
+    ASSERT_EQ(rects[0].height, 716.0f);
+}
+
 // ==================== Rect Operations Tests ====================
 TEST(Rect_IntersectsWith) {
     Rect r1(0.0f, 0.0f, 100.0f, 100.0f);
@@ -159,6 +246,319 @@ TEST(DirtyRegion_OverlappingRects) {
     // Should be merged into one large rect
 }
 
+// ==================== ResourceCache Tests ====================
+TEST(ResourceCache_CountsHitsAndBytes) {
+    SoftwareRenderContext context;
+    ResourceCache cache(&context);
+
+    auto* brush = cache.GetSolidColorBrush(Color::Red());
+    ASSERT_NOT_NULL(brush);
+    ASSERT_TRUE(cache.GetSolidColorBrush(Color::Red()) == brush);
+    ASSERT_NOT_NULL(cache.GetTextFormat(L"Arial", 14.0f));
+
+    auto stats = cache.GetStats();
+    ASSERT_EQ(1u, stats.hits);
+    ASSERT_EQ(2u, stats.misses);
+    ASSERT_EQ(1u, stats.brushCount);
+    ASSERT_EQ(1u, stats.textFormatCount);
+    ASSERT_EQ(ResourceCache::kSolidBrushBytes + ResourceCache::kTextFormatBytes + 5 * sizeof(wchar_t), stats.bytes);
+
+    cache.ClearAll();
+    ASSERT_EQ(0u, cache.GetByteSize());
+}
+
+TEST(ResourceCache_BudgetEvictsOldestGenerations) {
+    SoftwareRenderContext context;
+    ResourceCache cache(&context);
+    cache.SetByteBudget(ResourceCache::kSolidBrushBytes * 4);
+
+    // Animated color: a new brush every frame
+    for (int frame = 0; frame < 100; ++frame) {
+        cache.GetSolidColorBrush(Color(frame / 255.0f, 0, 0, 1));
+        cache.GetSolidColorBrush(Color::Black());
+        cache.EndFrame();
+    }
+    ASSERT_TRUE(cache.GetByteSize() <= cache.GetByteBudget());
+    ASSERT_TRUE(cache.GetStats().evictions >= 90u);
+
+    // Black is used every frame and survives
+    uint64_t misses = cache.GetStats().misses;
+    cache.GetSolidColorBrush(Color::Black());
+    ASSERT_EQ(misses, cache.GetStats().misses);
+}
+
+TEST(ResourceCache_KeepsCurrentFrameEntries) {
+    SoftwareRenderContext context;
+    ResourceCache cache(&context);
+    cache.SetByteBudget(0);
+
+    // Over budget inside a frame: pointers handed out this frame stay valid
+    auto* first = cache.GetSolidColorBrush(Color::Red());
+    cache.GetSolidColorBrush(Color::Green());
+    ASSERT_EQ(0u, cache.Trim());
+    ASSERT_TRUE(cache.GetSolidColorBrush(Color::Red()) == first);
+
+    cache.EndFrame();
+    ASSERT_EQ(0u, cache.GetBrushCacheSize());
+    ASSERT_EQ(2u, cache.GetStats().evictions);
+}
+
+TEST(ResourceCache_EvictsIdleEntries) {
+    SoftwareRenderContext context;
+    ResourceCache cache(&context);
+    cache.SetMaxIdleFrames(10);
+
+    cache.GetTextFormat(L"Arial", 12.0f);
+    for (int frame = 0; frame < 30; ++frame) {
+        cache.GetTextFormat(L"Arial", 14.0f);
+        cache.EndFrame();
+    }
+    ASSERT_EQ(1u, cache.Trim());
+    ASSERT_EQ(1u, cache.GetTextFormatCacheSize());
+}
+
+// ==================== TextLayoutCache Tests ====================
+TEST(TextLayoutCache_MeasureSharedAcrossEqualFormats) {
+    SoftwareRenderContext context;
+    TextLayoutCache cache;
+    auto a = context.CreateTextFormat(L"Arial", 14.0f);
+    auto b = context.CreateTextFormat(L"Arial", 14.0f);
+
+    Size first = cache.Measure(a.get(), L"Pending");
+    Size second = cache.Measure(b.get(), L"Pending");
+    ASSERT_EQ(first.width, second.width);
+    ASSERT_EQ(first.width, a->MeasureText(L"Pending").width);
+    ASSERT_EQ(1u, cache.GetStats().measureHits);
+
+    // Different wrapping or width is a different entry
+    b->SetWordWrapping(WordWrapping::NoWrap);
+    cache.Measure(b.get(), L"Pending");
+    cache.Measure(a.get(), L"Pending", 20.0f);
+    ASSERT_EQ(3u, cache.GetStats().measureMisses);
+}
+
+TEST(TextLayoutCache_ReusesReleasedLayouts) {
+    SoftwareRenderContext context;
+    TextLayoutCache cache;
+    auto format = context.CreateTextFormat(L"Arial", 14.0f);
+
+    auto held = cache.GetLayout(&context, L"2024-01-01", format.get(), Size(100, 20));
+    auto other = cache.GetLayout(&context, L"2024-01-01", format.get(), Size(100, 20));
+    ASSERT_TRUE(held.get() != other.get());
+
+    held->SetMaxSize(Size(10, 10));
+    held->SetTextAlignment(TextAlignment::Center);
+    ITextLayout* raw = held.get();
+    held.reset();
+    other.reset();
+    auto reused = cache.GetLayout(&context, L"2024-01-01", format.get(), Size(100, 20));
+    ASSERT_TRUE(reused.get() == raw);
+    ASSERT_EQ(100.0f, reused->GetMaxSize().width);
+    ASSERT_TRUE(reused->GetTextAlignment() == TextAlignment::Leading);
+    ASSERT_EQ(1u, cache.GetStats().layoutHits);
+
+    reused.reset();
+    cache.RemoveContext(&context);
+    ASSERT_EQ(0u, cache.GetStats().entries);
+}
+
+TEST(TextLayoutCache_BudgetAndObserver) {
+    SoftwareRenderContext context;
+    TextLayoutCache cache;
+    auto format = context.CreateTextFormat(L"Arial", 12.0f);
+    int evictions = 0;
+    cache.SetObserver([&evictions](TextCacheEvent event, const std::wstring&) {
+        if (event == TextCacheEvent::Eviction) ++evictions;
+    });
+    cache.SetByteBudget(TextLayoutCache::kEntryOverheadBytes * 20);
+
+    for (int i = 0; i < 1000; ++i) {
+        cache.Measure(format.get(), L"Row " + std::to_wstring(i));
+    }
+    auto stats = cache.GetStats();
+    ASSERT_TRUE(stats.bytes <= cache.GetByteBudget());
+    ASSERT_TRUE(stats.entries > 0u);
+    ASSERT_EQ(static_cast<uint64_t>(evictions), stats.evictions);
+    ASSERT_EQ(1000u - stats.entries, stats.evictions);
+}
+
+// ==================== BitmapService ====================
+namespace {
+
+// Synthetic "files": 4 bytes width, 4 bytes height, 1 byte gray level
+std::vector<uint8_t> MakeImageFile(uint32_t width, uint32_t height, uint8_t gray) {
+    std::vector<uint8_t> data(9);
+    std::memcpy(data.data(), &width, 4);
+    std::memcpy(data.data() + 4, &height, 4);
+    data[8] = gray;
+    return data;
+}
+
+void InstallFakeCodec(BitmapService& service, std::map<std::wstring, std::vector<uint8_t>> files,
+                      std::atomic<int>* decodes = nullptr) {
+    service.SetFileReader([files](const std::wstring& path, std::vector<uint8_t>& out) {
+        auto it = files.find(path);
+        if (it == files.end()) return false;
+        out = it->second;
+        return true;
+    });
+    service.SetDecoder([decodes](const uint8_t* data, size_t size, int, DecodedImage& out) {
+        if (size != 9) return false;
+        uint32_t width, height;
+        std::memcpy(&width, data, 4);
+        std::memcpy(&height, data + 4, 4);
+        out.width = out.sourceWidth = static_cast<int>(width);
+        out.height = out.sourceHeight = static_cast<int>(height);
+        out.pixels.assign(static_cast<size_t>(width) * height, 0xFF000000u | data[8] * 0x010101u);
+        if (decodes) ++*decodes;
+        return true;
+    });
+}
+
+} // namespace
+
+TEST(BitmapService_SharesRequestsAndDownscales) {
+    BitmapService service(2);
+    std::atomic<int> decodes{0};
+    InstallFakeCodec(service, {}, &decodes);
+    // Hold the read until both requests are in, otherwise the second one may find the entry ready
+    std::mutex gate;
+    auto photo = MakeImageFile(400, 300, 0x80);
+    service.SetFileReader([&gate, photo](const std::wstring& path, std::vector<uint8_t>& out) {
+        std::lock_guard<std::mutex> wait(gate);
+        if (path != L"photo.png") return false;
+        out = photo;
+        return true;
+    });
+
+    ASSERT_EQ(0, BitmapService::GetDecodeSize(0, 0));
+    ASSERT_EQ(64, BitmapService::GetDecodeSize(48, 40));
+    ASSERT_EQ(64, BitmapService::GetDecodeSize(64, 10));
+    ASSERT_EQ(128, BitmapService::GetDecodeSize(65, 10));
+
+    int callbacks = 0;
+    gate.lock();
+    auto a = service.Request(L"photo.png", 60, 45, [&callbacks]() { ++callbacks; });
+    auto b = service.Request(L"photo.png", 50, 40, [&callbacks]() { ++callbacks; });
+    gate.unlock();
+    ASSERT_TRUE(a == b);
+    service.WaitIdle();
+    ASSERT_EQ(2u, service.DispatchCompletions());
+    ASSERT_EQ(2, callbacks);
+    ASSERT_EQ(1, decodes.load());
+
+    // Short side shrinks to the 64 bucket, source size is preserved
+    ASSERT_TRUE(a->IsReady());
+    ASSERT_EQ(64, a->GetHeight());
+    ASSERT_EQ(85, a->GetWidth());
+    ASSERT_EQ(400, a->GetSourceWidth());
+    ASSERT_EQ(300, a->GetSourceHeight());
+
+    SoftwareRenderContext context;
+    auto bitmap = a->GetBitmap(&context);
+    ASSERT_TRUE(bitmap != nullptr);
+    ASSERT_TRUE(bitmap.get() == b->GetBitmap(&context).get());
+    ASSERT_EQ(85, bitmap->GetWidth());
+
+    // Already ready: no callback
+    auto c = service.Request(L"photo.png", 64, 64, [&callbacks]() { ++callbacks; });
+    ASSERT_TRUE(c->IsReady());
+    ASSERT_EQ(0u, service.DispatchCompletions());
+    ASSERT_EQ(2u, service.GetStats().sharedRequests);
+    service.RemoveContext(&context);
+}
+
+TEST(BitmapService_SharesPixelsByContent) {
+    BitmapService service(1);
+    std::atomic<int> decodes{0};
+    auto bytes = MakeImageFile(32, 32, 0x20);
+    InstallFakeCodec(service, { { L"a.png", bytes }, { L"copy of a.png", bytes } }, &decodes);
+
+    auto a = service.Request(L"a.png");
+    service.WaitIdle();
+    auto b = service.Request(L"copy of a.png");
+    service.WaitIdle();
+    ASSERT_TRUE(a != b);
+    ASSERT_TRUE(a->IsReady() && b->IsReady());
+    ASSERT_EQ(1, decodes.load());
+    ASSERT_EQ(1u, service.GetStats().contentShares);
+    ASSERT_EQ(32u * 32u * 4u, service.GetStats().decodedBytes);
+}
+
+TEST(BitmapService_FailuresAreNotCached) {
+    BitmapService service(1);
+    InstallFakeCodec(service, {});
+
+    bool called = false;
+    auto missing = service.Request(L"missing.png", 0, 0, [&called]() { called = true; });
+    service.WaitIdle();
+    service.DispatchCompletions();
+    ASSERT_TRUE(called);
+    ASSERT_TRUE(missing->IsFailed());
+    ASSERT_EQ(1u, service.GetStats().failures);
+    ASSERT_EQ(0u, service.GetStats().entries);
+
+    SoftwareRenderContext context;
+    ASSERT_TRUE(missing->GetBitmap(&context) == nullptr);
+}
+
+TEST(BitmapService_EvictsUnreferencedEntriesOverBudget) {
+    BitmapService service(1);
+    std::map<std::wstring, std::vector<uint8_t>> files;
+    for (int i = 0; i < 8; ++i) {
+        files[L"thumb" + std::to_wstring(i)] = MakeImageFile(64, 64, static_cast<uint8_t>(i));
+    }
+    InstallFakeCodec(service, files);
+    const size_t imageBytes = 64 * 64 * 4;
+    service.SetByteBudget(imageBytes * 3);
+
+    auto kept = service.Request(L"thumb0");
+    service.WaitIdle();
+    for (int i = 1; i < 8; ++i) {
+        auto handle = service.Request(L"thumb" + std::to_wstring(i));
+        service.WaitIdle();
+        handle.reset();
+        service.DispatchCompletions();
+    }
+    auto stats = service.GetStats();
+    ASSERT_TRUE(stats.decodedBytes <= imageBytes * 3);
+    ASSERT_TRUE(stats.evictions > 0u);
+    ASSERT_TRUE(kept->IsReady());
+    ASSERT_EQ(64, kept->GetWidth());
+
+    // Held entries survive a full trim
+    service.Trim();
+    ASSERT_EQ(1u, service.GetStats().entries);
+    ASSERT_EQ(imageBytes, service.GetStats().decodedBytes);
+}
+
+TEST(BitmapService_CancelsAbandonedRequests) {
+    BitmapService service(1);
+    InstallFakeCodec(service, {});
+    std::mutex gate;
+    std::atomic<bool> started{false};
+    service.SetFileReader([&gate, &started](const std::wstring& path, std::vector<uint8_t>& out) {
+        if (path == L"slow.png") {
+            started = true;
+            std::lock_guard<std::mutex> wait(gate);
+        }
+        out = MakeImageFile(8, 8, 0);
+        return true;
+    });
+
+    gate.lock();
+    auto slow = service.Request(L"slow.png");
+    while (!started) std::this_thread::yield();
+    service.Request(L"scrolled-away.png");   // queued behind slow.png, handle dropped
+    gate.unlock();
+    service.WaitIdle();
+
+    ASSERT_TRUE(slow->IsReady());
+    ASSERT_EQ(1u, service.GetStats().cancelled);
+    ASSERT_EQ(1u, service.GetStats().decodes);
+    ASSERT_EQ(1u, service.GetStats().entries);
+}
+
 // ==================== Main ====================
 int main() {
     return RUN_ALL_TESTS();
@@ -0,0 +1,427 @@
+// Rendering Module - Software (headless) renderer tests
+#include "TestFramework.h"
+#include "IRenderEngine.h"
+#include "IRenderTarget.h"
+#include "software/SoftwareRenderEngine.h"
+#include "software/SoftwareRenderTarget.h"
+#include "software/SoftwareBitmap.h"
+#include "ResourceInterner.h"
+
+using namespace luaui::rendering;
+
+namespace {
+
+uint32_t Alpha(uint32_t p) { return p >> 24; }
+uint32_t Red(uint32_t p) { return (p >> 16) & 0xFF; }
+uint32_t Green(uint32_t p) { return (p >> 8) & 0xFF; }
+uint32_t Blue(uint32_t p) { return p & 0xFF; }
+
+// Transparent 32x32 target
+std::unique_ptr<SoftwareRenderTarget> MakeTarget(int w = 32, int h = 32) {
+    auto target = std::make_unique<SoftwareRenderTarget>(w, h, true);
+    target->BeginDraw();
+    target->Clear(Color::Transparent());
+    return target;
+}
+
+} // anonymous namespace
+
+// ==================== Engine ====================
+
+TEST(SoftwareEngine_HeadlessFrame) {
+    auto engine = CreateSoftwareRenderEngine();
+    ASSERT_TRUE(engine->Initialize(RenderAPI::Software));
+
+    RenderTargetDesc desc;
+    desc.type = RenderTargetType::Bitmap;
+    desc.width = 64;
+    desc.height = 48;
+    ASSERT_TRUE(engine->CreateRenderTarget(desc));
+    ASSERT_TRUE(engine->GetAPI() == RenderAPI::Software);
+
+    ASSERT_TRUE(engine->BeginFrame());
+    auto* ctx = engine->GetContext();
+    auto brush = ctx->CreateSolidColorBrush(Color::Red());
+    ctx->FillRectangle(Rect(10, 10, 20, 20), brush.get());
+    engine->Present();
+
+    auto* sw = static_cast<SoftwareRenderEngine*>(engine.get());
+    ASSERT_EQ(0xFFFF0000u, sw->GetSurface().GetPixel(15, 15));
+    ASSERT_EQ(0xFFFFFFFFu, sw->GetSurface().GetPixel(5, 5));    // cleared to white
+    ASSERT_EQ(1, engine->GetStats().drawCallCount);
+}
+
+TEST(SoftwareEngine_RejectsEmptyTarget) {
+    auto engine = CreateSoftwareRenderEngine();
+    ASSERT_TRUE(engine->Initialize());
+    RenderTargetDesc desc;
+    desc.type = RenderTargetType::Window;
+    ASSERT_FALSE(engine->CreateRenderTarget(desc));
+    ASSERT_FALSE(engine->BeginFrame());
+}
+
+// ==================== Fills ====================
+
+TEST(Software_FillRectangle_PixelAligned) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    auto brush = ctx->CreateSolidColorBrush(Color(0, 0, 1, 1));
+    ctx->FillRectangle(Rect(4, 4, 8, 8), brush.get());
+    target->EndDraw();
+
+    const auto& s = target->GetSurface();
+    ASSERT_EQ(0xFF0000FFu, s.GetPixel(4, 4));
+    ASSERT_EQ(0xFF0000FFu, s.GetPixel(11, 11));
+    ASSERT_EQ(0u, s.GetPixel(3, 4));
+    ASSERT_EQ(0u, s.GetPixel(12, 11));
+}
+
+TEST(Software_FillRectangle_AntialiasedEdge) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    auto brush = ctx->CreateSolidColorBrush(Color::White());
+    ctx->FillRectangle(Rect(4.5f, 4, 8, 8), brush.get());
+    target->EndDraw();
+
+    const auto& s = target->GetSurface();
+    ASSERT_NEAR(128.0f, static_cast<float>(Alpha(s.GetPixel(4, 6))), 2.0f);
+    ASSERT_NEAR(128.0f, static_cast<float>(Alpha(s.GetPixel(12, 6))), 2.0f);
+    ASSERT_EQ(255u, Alpha(s.GetPixel(8, 6)));
+}
+
+TEST(Software_FillRectangle_Aliased) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    ctx->SetAntialias(false);
+    auto brush = ctx->CreateSolidColorBrush(Color::White());
+    ctx->FillRectangle(Rect(4.3f, 4, 8, 8), brush.get());
+    target->EndDraw();
+
+    const auto& s = target->GetSurface();
+    ASSERT_EQ(255u, Alpha(s.GetPixel(4, 6)));
+    ASSERT_EQ(0u, Alpha(s.GetPixel(12, 6)));
+}
+
+TEST(Software_Opacity_BlendsOver) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    target->Clear(Color::White());
+    auto brush = ctx->CreateSolidColorBrush(Color::Black());
+    ctx->SetOpacity(0.5f);
+    ctx->FillRectangle(Rect(0, 0, 8, 8), brush.get());
+    target->EndDraw();
+
+    uint32_t p = target->GetSurface().GetPixel(2, 2);
+    ASSERT_EQ(255u, Alpha(p));
+    ASSERT_NEAR(127.0f, static_cast<float>(Red(p)), 2.0f);
+}
+
+TEST(Software_Transform_RotatedRectangle) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    auto brush = ctx->CreateSolidColorBrush(Color::White());
+    ctx->SetTransform(Transform::Rotation(45.0f, 16, 16));
+    ctx->FillRectangle(Rect(10, 10, 12, 12), brush.get());
+    target->EndDraw();
+
+    const auto& s = target->GetSurface();
+    ASSERT_EQ(255u, Alpha(s.GetPixel(16, 16)));
+    ASSERT_EQ(255u, Alpha(s.GetPixel(16, 10)));   // diamond tip reaches up to y~7.5
+    ASSERT_EQ(0u, Alpha(s.GetPixel(10, 10)));     // former corner is now empty
+}
+
+TEST(Software_FillEllipse) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    auto brush = ctx->CreateSolidColorBrush(Color::White());
+    ctx->FillEllipse(Point(16, 16), 10, 10, brush.get());
+    target->EndDraw();
+
+    const auto& s = target->GetSurface();
+    ASSERT_EQ(255u, Alpha(s.GetPixel(16, 16)));
+    ASSERT_EQ(255u, Alpha(s.GetPixel(24, 16)));
+    ASSERT_EQ(0u, Alpha(s.GetPixel(7, 7)));       // outside, near the bounding box corner
+}
+
+TEST(Software_RoundedRectangle_Corners) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    auto brush = ctx->CreateSolidColorBrush(Color::White());
+    ctx->FillRoundedRectangle(Rect(0, 0, 32, 32), CornerRadius(8), brush.get());
+    target->EndDraw();
+
+    const auto& s = target->GetSurface();
+    ASSERT_EQ(0u, Alpha(s.GetPixel(0, 0)));
+    ASSERT_EQ(255u, Alpha(s.GetPixel(16, 0)));
+    ASSERT_EQ(255u, Alpha(s.GetPixel(16, 16)));
+}
+
+TEST(Software_DrawRectangle_HollowInside) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    auto brush = ctx->CreateSolidColorBrush(Color::White());
+    ctx->DrawRectangle(Rect(4, 4, 20, 20), brush.get(), 2.0f);
+    target->EndDraw();
+
+    const auto& s = target->GetSurface();
+    ASSERT_EQ(255u, Alpha(s.GetPixel(4, 10)));    // stroke covers [3,5)
+    ASSERT_EQ(0u, Alpha(s.GetPixel(14, 14)));
+}
+
+TEST(Software_DrawLine_Diagonal) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    auto brush = ctx->CreateSolidColorBrush(Color::White());
+    ctx->DrawLine(Point(2, 2), Point(30, 30), brush.get(), 3.0f);
+    target->EndDraw();
+
+    const auto& s = target->GetSurface();
+    ASSERT_EQ(255u, Alpha(s.GetPixel(16, 16)));
+    ASSERT_EQ(0u, Alpha(s.GetPixel(28, 4)));
+}
+
+// ==================== Paints ====================
+
+TEST(Software_LinearGradient) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    auto brush = ctx->CreateLinearGradientBrush(Point(0, 0), Point(32, 0),
+        { GradientStop(Color::Black(), 0.0f), GradientStop(Color::White(), 1.0f) });
+    ctx->FillRectangle(Rect(0, 0, 32, 32), brush.get());
+    target->EndDraw();
+
+    const auto& s = target->GetSurface();
+    ASSERT_TRUE(Red(s.GetPixel(1, 5)) < 20u);
+    ASSERT_NEAR(128.0f, static_cast<float>(Red(s.GetPixel(16, 5))), 10.0f);
+    ASSERT_TRUE(Red(s.GetPixel(30, 5)) > 235u);
+}
+
+TEST(Software_DrawBitmap_Blit) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    auto bitmap = ctx->CreateBitmap(2, 2, PixelFormat::BGRA8);
+    uint32_t pixels[4] = { 0xFFFF0000u, 0xFF00FF00u, 0xFF0000FFu, 0xFFFFFFFFu };
+    ASSERT_TRUE(bitmap->CopyFromMemory(pixels, 8));
+    ctx->DrawBitmap(bitmap.get(), Point(10, 10));
+    target->EndDraw();
+
+    const auto& s = target->GetSurface();
+    ASSERT_EQ(0xFFFF0000u, s.GetPixel(10, 10));
+    ASSERT_EQ(0xFF00FF00u, s.GetPixel(11, 10));
+    ASSERT_EQ(0xFF0000FFu, s.GetPixel(10, 11));
+    ASSERT_EQ(0u, s.GetPixel(12, 10));
+}
+
+// ==================== Geometry ====================
+
+TEST(Software_PathGeometry_Triangle) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    auto path = ctx->CreatePathGeometry();
+    path->BeginFigure(Point(0, 0), true);
+    path->AddLine(Point(32, 0));
+    path->AddLine(Point(0, 32));
+    path->EndFigure(true);
+    path->Close();
+
+    auto brush = ctx->CreateSolidColorBrush(Color::White());
+    ctx->FillGeometry(*path, brush.get());
+    target->EndDraw();
+
+    const auto& s = target->GetSurface();
+    ASSERT_EQ(255u, Alpha(s.GetPixel(4, 4)));
+    ASSERT_EQ(0u, Alpha(s.GetPixel(28, 28)));
+    ASSERT_TRUE(path->FillContains(Point(4, 4)));
+    ASSERT_FALSE(path->FillContains(Point(28, 28)));
+}
+
+TEST(Software_CombinedGeometry_Exclude) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    auto outer = ctx->CreateRectangleGeometry(Rect(0, 0, 32, 32));
+    auto inner = ctx->CreateEllipseGeometry(Point(16, 16), 8, 8);
+    auto ring = ctx->CreateCombinedGeometry(outer.get(), inner.get(), CombineMode::Exclude);
+
+    auto brush = ctx->CreateSolidColorBrush(Color::White());
+    ctx->FillGeometry(*ring, brush.get());
+    target->EndDraw();
+
+    const auto& s = target->GetSurface();
+    ASSERT_EQ(255u, Alpha(s.GetPixel(2, 2)));
+    ASSERT_EQ(0u, Alpha(s.GetPixel(16, 16)));
+}
+
+// ==================== Clip / Layers ====================
+
+TEST(Software_PushClip_Rect) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    auto brush = ctx->CreateSolidColorBrush(Color::White());
+    ctx->PushClip(Rect(8, 8, 8, 8));
+    ctx->FillRectangle(Rect(0, 0, 32, 32), brush.get());
+    Rect clip = ctx->GetClipBounds();
+    ctx->PopClip();
+    target->EndDraw();
+
+    const auto& s = target->GetSurface();
+    ASSERT_EQ(255u, Alpha(s.GetPixel(8, 8)));
+    ASSERT_EQ(0u, Alpha(s.GetPixel(7, 8)));
+    ASSERT_EQ(0u, Alpha(s.GetPixel(16, 16)));
+    ASSERT_NEAR(8.0f, clip.width, 0.01f);
+}
+
+TEST(Software_PushClip_Geometry) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    auto circle = ctx->CreateEllipseGeometry(Point(16, 16), 8, 8);
+    auto brush = ctx->CreateSolidColorBrush(Color::White());
+    ctx->PushClip(*circle);
+    ctx->FillRectangle(Rect(0, 0, 32, 32), brush.get());
+    ctx->PopClip();
+    target->EndDraw();
+
+    const auto& s = target->GetSurface();
+    ASSERT_EQ(255u, Alpha(s.GetPixel(16, 16)));
+    ASSERT_EQ(0u, Alpha(s.GetPixel(9, 9)));
+}
+
+TEST(Software_Layer_Opacity) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    auto red = ctx->CreateSolidColorBrush(Color::Red());
+    ctx->PushLayer(0.5f);
+    ctx->FillRectangle(Rect(0, 0, 16, 16), red.get());
+    ctx->FillRectangle(Rect(0, 0, 16, 16), red.get());   // overdraw inside the layer stays opaque
+    ctx->PopLayer();
+    target->EndDraw();
+
+    uint32_t p = target->GetSurface().GetPixel(4, 4);
+    ASSERT_NEAR(128.0f, static_cast<float>(Alpha(p)), 2.0f);
+    ASSERT_EQ(Alpha(p), Red(p));
+    ASSERT_EQ(0u, Green(p));
+    ASSERT_EQ(0u, Blue(p));
+}
+
+// ==================== Text / Offscreen ====================
+
+TEST(Software_Text_MeasureAndDraw) {
+    auto target = MakeTarget(128, 32);
+    auto* ctx = target->GetContext();
+    auto format = ctx->CreateTextFormat(L"Segoe UI", 16.0f);
+    Size one = format->MeasureText(L"Hello");
+    Size two = format->MeasureText(L"Hello Hello");
+    ASSERT_TRUE(one.width > 0);
+    ASSERT_TRUE(two.width > one.width * 1.9f);
+    ASSERT_EQ(2.0f * one.height, format->MeasureText(L"Hello\nHello").height);
+
+    auto brush = ctx->CreateSolidColorBrush(Color::Black());
+    ctx->DrawTextString(L"Hello", format.get(), Point(0, 0), brush.get());
+    target->EndDraw();
+
+    int inked = 0;
+    const auto& s = target->GetSurface();
+    for (int y = 0; y < 32; ++y)
+        for (int x = 0; x < 128; ++x)
+            if (Alpha(s.GetPixel(x, y)) > 0) ++inked;
+    ASSERT_TRUE(inked > 0);
+    ASSERT_EQ(0u, Alpha(s.GetPixel(static_cast<int>(one.width) + 4, 8)));
+}
+
+TEST(Software_RenderTarget_ToBitmap) {
+    auto target = MakeTarget(8, 8);
+    auto* ctx = target->GetContext();
+    auto brush = ctx->CreateSolidColorBrush(Color::Green());
+    ctx->FillRectangle(Rect(0, 0, 4, 8), brush.get());
+    target->EndDraw();
+
+    auto bitmap = std::dynamic_pointer_cast<SoftwareBitmap>(target->ToBitmap());
+    ASSERT_NOT_NULL(bitmap.get());
+    ASSERT_EQ(8, bitmap->GetWidth());
+    ASSERT_EQ(target->GetSurface().GetPixel(1, 1), bitmap->GetPixel(1, 1));
+    ASSERT_EQ(0u, bitmap->GetPixel(6, 1));
+}
+
+// ==================== Resource Interning ====================
+
+TEST(Software_Interner_ReusesReleasedBrushes) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    auto* interner = ctx->GetResourceInterner();
+    ASSERT_NOT_NULL(interner);
+
+    IBrush* first = nullptr;
+    for (int frame = 0; frame < 10; ++frame) {
+        auto brush = ctx->CreateSolidColorBrush(Color::Red());
+        if (!first) first = brush.get();
+        ASSERT_TRUE(brush.get() == first);
+    }
+    ASSERT_EQ(1u, interner->GetStats().misses);
+    ASSERT_EQ(9u, interner->GetStats().hits);
+
+    // A mutated brush comes back with the requested color
+    ctx->CreateSolidColorBrush(Color::Red())->SetColor(Color::Blue());
+    auto again = ctx->CreateSolidColorBrush(Color::Red());
+    ASSERT_EQ(1.0f, again->GetColor().r);
+    ASSERT_EQ(0.0f, again->GetColor().b);
+}
+
+TEST(Software_Interner_NeverSharesHeldObjects) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    auto a = ctx->CreateSolidColorBrush(Color::Red());
+    auto b = ctx->CreateSolidColorBrush(Color::Red());
+    ASSERT_TRUE(a.get() != b.get());
+
+    std::vector<GradientStop> stops = { GradientStop(Color::Red(), 0), GradientStop(Color::Blue(), 1) };
+    auto g1 = ctx->CreateLinearGradientBrush(Point(0, 0), Point(10, 0), stops);
+    g1.reset();
+    auto g2 = ctx->CreateLinearGradientBrush(Point(0, 0), Point(10, 0), stops);
+    stops[1].color = Color::Green();
+    auto g3 = ctx->CreateLinearGradientBrush(Point(0, 0), Point(10, 0), stops);
+    ASSERT_TRUE(g2.get() != g3.get());
+    ASSERT_EQ(1u, ctx->GetResourceInterner()->GetStats().hits);
+}
+
+TEST(Software_Interner_RestoresTextFormatState) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    {
+        auto format = ctx->CreateTextFormat(L"Segoe UI", 14.0f);
+        format->SetTextAlignment(TextAlignment::Center);
+        format->SetWordWrapping(WordWrapping::NoWrap);
+        format->SetFontWeight(FontWeight::Bold);
+    }
+    auto format = ctx->CreateTextFormat(L"Segoe UI", 14.0f);
+    ASSERT_EQ(1u, ctx->GetResourceInterner()->GetStats().hits);
+    ASSERT_TRUE(format->GetTextAlignment() == TextAlignment::Leading);
+    ASSERT_TRUE(format->GetWordWrapping() == WordWrapping::Wrap);
+    ASSERT_TRUE(format->GetFontWeight() == FontWeight::Regular);
+
+    auto other = ctx->CreateTextFormat(L"Segoe UI", 12.0f);
+    ASSERT_EQ(2u, ctx->GetResourceInterner()->GetStats().misses);
+}
+
+TEST(Software_Interner_EvictsLeastRecentlyUsed) {
+    auto target = MakeTarget();
+    auto* ctx = target->GetContext();
+    auto* interner = ctx->GetResourceInterner();
+    interner->SetCapacity(2, 2);
+
+    ctx->CreateSolidColorBrush(Color::Red());
+    ctx->CreateSolidColorBrush(Color::Green());
+    ctx->CreateSolidColorBrush(Color::Red());     // Red becomes most recent
+    ctx->CreateSolidColorBrush(Color::Blue());    // evicts Green
+    ASSERT_EQ(2u, interner->GetBrushCount());
+    ASSERT_EQ(1u, interner->GetStats().evictions);
+
+    interner->ResetStats();
+    ctx->CreateSolidColorBrush(Color::Red());
+    ctx->CreateSolidColorBrush(Color::Green());
+    ASSERT_EQ(1u, interner->GetStats().hits);
+    ASSERT_EQ(1u, interner->GetStats().misses);
+}
+
+// ==================== Main ====================
+int main() {
+    return RUN_ALL_TESTS();
+}
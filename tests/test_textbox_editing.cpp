@@ -1,6 +1,6 @@
 #include "TestFramework.h"
 #include "TextBox.h"
-#include <windows.h>
+#include "KeyCodes.h"
 
 using namespace luaui;
 using namespace luaui::controls;
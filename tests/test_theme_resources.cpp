@@ -0,0 +1,152 @@
+// Style Module - interned theme keys and slot-indexed resource dictionary
+#include "TestFramework.h"
+#include "ResourceDictionary.h"
+#include "Theme.h"
+#include "ThemeKeys.h"
+#include <string>
+
+using namespace luaui;
+using namespace luaui::controls;
+
+TEST(ThemeKey_InternsNamesToDenseIds) {
+    ThemeKey a("Test.InternA");
+    ThemeKey b(std::string("Test.InternA"));
+    ThemeKey c("Test.InternC");
+    ASSERT_TRUE(a.IsValid());
+    ASSERT_TRUE(a == b);
+    ASSERT_TRUE(a != c);
+    ASSERT_EQ(a.GetName(), std::string("Test.InternA"));
+    ASSERT_TRUE(c.GetId() <= ThemeKey::GetRegisteredCount());
+
+    // Builtin constants are registered at static initialization
+    ASSERT_TRUE(theme::kAccentColor.IsValid());
+    ASSERT_TRUE(ThemeKey::Find("AccentColor") == theme::kAccentColor);
+    ASSERT_FALSE(ThemeKey::Find("Test.NeverRegistered").IsValid());
+    ASSERT_FALSE(ThemeKey().IsValid());
+    ASSERT_FALSE(ThemeKey("").IsValid());
+}
+
+TEST(ResourceDictionary_LooksUpByKeyOrName) {
+    ResourceDictionary dict;
+    dict.AddColor(theme::kAccentColor, rendering::Color(1, 0, 0, 1));
+    dict.AddFloat("Test.Radius", 4.0f);
+    dict.AddThickness(theme::kButtonBorder, rendering::Thickness(2));
+
+    ASSERT_TRUE(dict.HasColor("AccentColor"));
+    ASSERT_EQ(1.0f, dict.GetColor(theme::kAccentColor).r);
+    ASSERT_FALSE(dict.HasColor(theme::kTextPrimary));
+    ASSERT_EQ(0.0f, dict.GetColor(theme::kTextPrimary).a);
+    ASSERT_EQ(4.0f, dict.GetFloat("Test.Radius"));
+    ASSERT_EQ(7.0f, dict.GetFloat("Test.Missing", 7.0f));
+    ASSERT_EQ(2.0f, dict.GetThickness(theme::kButtonBorder).left);
+    ASSERT_FALSE(dict.HasFloat(ThemeKey()));
+}
+
+TEST(ResourceDictionary_MergeAndVersion) {
+    ResourceDictionary base;
+    base.AddColor(theme::kTextPrimary, rendering::Color(0, 0, 0, 1));
+    base.AddColor(theme::kAccentColor, rendering::Color(0, 0, 1, 1));
+    uint64_t version = base.GetVersion();
+
+    ResourceDictionary overrides;
+    overrides.AddColor(theme::kAccentColor, rendering::Color(0, 1, 0, 1));
+    base.Merge(overrides);
+    ASSERT_TRUE(base.GetVersion() != version);
+    ASSERT_EQ(1.0f, base.GetColor(theme::kAccentColor).g);
+    ASSERT_EQ(1.0f, base.GetColor(theme::kTextPrimary).a);
+
+    ResourceDictionary copy = base;
+    ASSERT_EQ(base.GetVersion(), copy.GetVersion());
+}
+
+TEST(CachedThemeColor_ResolvesOncePerVersion) {
+    Theme theme;
+    ResourceDictionary light;
+    light.AddColor(theme::kBackgroundPrimary, rendering::Color(1, 1, 1, 1));
+    theme.ReplaceResources(light);
+
+    CachedThemeColor background(theme::kBackgroundPrimary);
+    ASSERT_EQ(1.0f, background.Get(theme).r);
+
+    ResourceDictionary dark;
+    dark.AddColor(theme::kBackgroundPrimary, rendering::Color(0.1f, 0.1f, 0.1f, 1));
+    theme.ReplaceResources(dark);
+    ASSERT_EQ(0.1f, background.Get(theme).r);
+}
+
+TEST(Theme_NotifiesOnlyDependentSubscribers) {
+    Theme theme;
+    ResourceDictionary light;
+    light.AddColor(theme::kTextPrimary, rendering::Color(0, 0, 0, 1));
+    light.AddColor(theme::kAccentColor, rendering::Color(0, 0, 1, 1));
+    theme.ReplaceResources(light);
+
+    int textCalls = 0, accentCalls = 0, globalCalls = 0;
+    size_t text = theme.AddTrackedCallback([&]() { ++textCalls; theme.GetColor(theme::kTextPrimary); });
+    size_t accent = theme.AddTrackedCallback([&]() { ++accentCalls; theme.GetColor(theme::kAccentColor); });
+    theme.AddCallback([&]() { ++globalCalls; });
+    {
+        Theme::DependencyScope scope(theme, text);
+        theme.GetColor(theme::kTextPrimary);
+    }
+    {
+        Theme::DependencyScope scope(theme, accent);
+        theme.GetColor(theme::kAccentColor);
+        theme.GetColor(theme::kAccentColor);
+    }
+    ASSERT_EQ(1u, theme.GetDependencyCount(accent));
+
+    // Only the accent color changes
+    ResourceDictionary dark = light;
+    dark.AddColor(theme::kAccentColor, rendering::Color(1, 0, 0, 1));
+    theme.ReplaceResources(dark);
+    ASSERT_EQ(0, textCalls);
+    ASSERT_EQ(1, accentCalls);
+    ASSERT_EQ(1, globalCalls);
+    ASSERT_EQ(2u, theme.GetLastNotifyCount());
+
+    // Identical resources notify only untracked subscribers
+    theme.ReplaceResources(dark);
+    ASSERT_EQ(1, accentCalls);
+    ASSERT_EQ(2, globalCalls);
+
+    // Removing a key counts as a change
+    ResourceDictionary empty;
+    theme.ReplaceResources(empty);
+    ASSERT_EQ(1, textCalls);
+    ASSERT_EQ(2, accentCalls);
+}
+
+TEST(Theme_BatchesUpdatesIntoOneNotification) {
+    Theme theme;
+    int calls = 0;
+    size_t id = theme.AddTrackedCallback([&]() { ++calls; theme.GetColor(theme::kTextPrimary); });
+    {
+        Theme::DependencyScope scope(theme, id);
+        theme.GetColor(theme::kTextPrimary);
+    }
+
+    ResourceDictionary base;
+    base.AddColor(theme::kTextPrimary, rendering::Color(1, 1, 1, 1));
+    ResourceDictionary overrides;
+    overrides.AddColor(theme::kTextPrimary, rendering::Color(0.5f, 0.5f, 0.5f, 1));
+    {
+        Theme::UpdateScope batch(theme);
+        theme.ReplaceResources(base);
+        theme.ApplyResources(overrides);
+        ASSERT_EQ(0, calls);
+    }
+    ASSERT_EQ(1, calls);
+    ASSERT_EQ(0.5f, theme.GetColor(theme::kTextPrimary).r);
+
+    // Removed subscriptions are not notified
+    theme.RemoveCallback(id);
+    theme.ReplaceResources(ResourceDictionary());
+    ASSERT_EQ(1, calls);
+    ASSERT_EQ(0u, theme.GetLastNotifyCount());
+}
+
+// ==================== Main ====================
+int main() {
+    return RUN_ALL_TESTS();
+}
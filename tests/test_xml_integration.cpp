@@ -7,8 +7,10 @@
 #include "mvvm/MvvmXmlLoader.h"
 #include "mvvm/ViewModelBase.h"
 #include "mvvm/BindingEngine.h"
+#ifndef LUAUI_MVVM_NO_LUA
 #include "lua/LuaSandbox.h"
 #include "lua/LuaAwareMvvmLoader.h"
+#endif
 #include "Controls.h"
 #include <memory>
 #include <string>
@@ -18,7 +20,9 @@ using namespace luaui;
 using namespace luaui::xml;
 using namespace luaui::mvvm;
 using namespace luaui::controls;
+#ifndef LUAUI_MVVM_NO_LUA
 using namespace luaui::lua;
+#endif
 
 // Test ViewModel for XML binding tests
 class TestXmlViewModel : public ViewModelBase {
@@ -193,6 +197,37 @@ TEST(XmlLoader_ButtonWithClick) {
     }
 }
 
+TEST(XmlLoader_AllocationContext) {
+    auto loader = CreateXmlLoader();
+    auto context = std::make_shared<AllocationContext>();
+    loader->SetAllocationContext(context);
+    
+    std::string xml = R"(
+        <StackPanel>
+            <TextBlock Text="Name"/>
+            <TextBox/>
+            <Button Content="OK"/>
+        </StackPanel>
+    )";
+    
+    auto panel = loader->LoadFromString(xml);
+    ASSERT_NOT_NULL(panel);
+    ASSERT_TRUE(AllocationContext::GetCurrent() == nullptr);
+    
+    // Every element comes from the context's pool
+    auto stats = context->GetStats();
+    ASSERT_EQ((size_t)4, stats.allocations);
+    ASSERT_EQ((size_t)4, stats.liveAllocations);
+    ASSERT_TRUE(stats.bytesAllocated > 0);
+    
+    // The view outlives the context; releasing it returns every block
+    context.reset();
+    ASSERT_EQ((size_t)3, panel->GetChildCount());
+    std::weak_ptr<luaui::Control> child = std::dynamic_pointer_cast<luaui::Control>(panel->GetChild(0));
+    panel.reset();
+    ASSERT_TRUE(child.expired());
+}
+
 // ==================== MVVM XML Binding Tests ====================
 
 TEST(MvvmXmlLoader_CreateInstance) {
@@ -317,6 +352,7 @@ TEST(BindingExpression_WithConverter) {
     ASSERT_EQ(parsed.path, "Counter");
 }
 
+#ifndef LUAUI_MVVM_NO_LUA
 // ==================== Lua + XML Integration Tests ====================
 
 TEST(LuaXml_CreateButton) {
@@ -399,6 +435,7 @@ TEST(LuaAwareMvvmLoader_CreateInstance) {
     LuaAwareMvvmLoader loader;
     ASSERT_TRUE(true);  // Just verify it can be created
 }
+#endif
 
 // ==================== Event Handler Registration Tests ====================
 